@@ -23,7 +23,8 @@ int main(int argc, char **argv)
 		return 0;
 	}
 
-	DvdAudioInitDecoder();
+	DvdAdpcmState state;
+	DvdAudioInitDecoder(&state);
 
 	while (!feof(adpcmFile))
 	{
@@ -32,7 +33,7 @@ int main(int argc, char **argv)
 
 		fread(adpcmData, 1, 32, adpcmFile);
 
-		DvdAudioDecode(adpcmData, decodedPcmData);
+		DvdAudioDecode(&state, adpcmData, decodedPcmData);
 
 		fwrite(decodedPcmData, 1, sizeof(decodedPcmData), pcmFile);
 	}
@@ -14,6 +14,10 @@ namespace Flipper
 
 	BogusFlipper::BogusFlipper()
 	{
+		// The tests run on the threads of the test runner, so they work with the main instance
+		Instance::Main = new Instance();
+		Instance::Main->mi = new MIControl();
+
 		HWConfig* config = new HWConfig;
 
 		config->ramsize = RAMSIZE;
@@ -26,6 +30,10 @@ namespace Flipper
 	BogusFlipper::~BogusFlipper()
 	{
 		MIClose();
+
+		delete Instance::Main->mi;
+		delete Instance::Main;
+		Instance::Main = nullptr;
 	}
 
 	BogusFlipper BogusHW;
@@ -5,4 +5,5 @@ static void dummy(const char* text, ...) {}
 static void dummy2(DbgChannel chan, const char* text, ...) {}
 void (*DBHalt)(const char* text, ...) = dummy;
 void (*DBReport)(const char* text, ...) = dummy;
-void (*DBReport2)(DbgChannel chan, const char* text, ...) = dummy2;
+void (*DBReport2Proc)(DbgChannel chan, const char* text, ...) = dummy2;
+uint32_t DBChannelMask = 0;
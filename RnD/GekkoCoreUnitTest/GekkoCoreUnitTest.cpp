@@ -1,6 +1,8 @@
 // This module contains only basic tests.
 #include "pch.h"
 #include "CppUnitTest.h"
+#include <chrono>
+#include <vector>
 
 using namespace Microsoft::VisualStudio::CppUnitTestFramework;
 
@@ -120,5 +122,123 @@ namespace GekkoCoreUnitTest
 			fclose(f);
 		}
 
+		// Decoding speed of the analyzer over all text sections of a DOL.
+		// Data\\bench.dol is a copy of pong.dol from the root of the repository, it can be replaced by any other DOL.
+		TEST_METHOD(AnalyzerBenchmark)
+		{
+			FILE* f = nullptr;
+
+			fopen_s(&f, "Data\\bench.dol", "rb");
+			Assert::IsNotNull(f, L"Data\\bench.dol not found (copy the Data folder next to the DLL)");
+
+			fseek(f, 0, SEEK_END);
+			size_t size = ftell(f);
+			fseek(f, 0, SEEK_SET);
+
+			std::vector<uint8_t> dol(size);
+			fread(dol.data(), 1, size, f);
+			fclose(f);
+
+			Assert::IsTrue(size >= 0x100);
+
+			// DOL header (big-endian): offsets of 7 text + 11 data sections, then their addresses, then their sizes
+
+			const uint32_t* header = (const uint32_t*)dol.data();
+			std::vector<uint32_t> code;
+			std::vector<uint32_t> pcs;
+
+			for (int n = 0; n < 7; n++)
+			{
+				uint32_t offset = _byteswap_ulong(header[n]);
+				uint32_t address = _byteswap_ulong(header[18 + n]);
+				uint32_t textSize = _byteswap_ulong(header[36 + n]);
+
+				if (offset == 0 || textSize == 0 || (size_t)offset + textSize > size)
+					continue;
+
+				for (uint32_t i = 0; i < textSize; i += 4)
+				{
+					code.push_back(_byteswap_ulong(*(uint32_t*)&dol[(size_t)offset + i]));
+					pcs.push_back(address + i);
+				}
+			}
+
+			Assert::IsTrue(!code.empty());
+
+			const int passes = 100;
+
+			for (int fast = 0; fast < 2; fast++)
+			{
+				Gekko::AnalyzeInfo info = { 0 };
+				size_t unknown = 0;
+
+				auto start = std::chrono::high_resolution_clock::now();
+
+				for (int pass = 0; pass < passes; pass++)
+				{
+					for (size_t i = 0; i < code.size(); i++)
+					{
+						if (fast)
+							Gekko::Analyzer::AnalyzeFast(pcs[i], code[i], &info);
+						else
+							Gekko::Analyzer::Analyze(pcs[i], code[i], &info);
+
+						if (info.instr == Gekko::Instruction::Unknown)
+							unknown++;
+					}
+				}
+
+				auto stop = std::chrono::high_resolution_clock::now();
+				double seconds = std::chrono::duration<double>(stop - start).count();
+
+				char text[0x100];
+				sprintf_s(text, sizeof(text) - 1, "%s: %zi instructions (%zi unknown), %.1f M instructions/s\n",
+					fast ? "AnalyzeFast" : "Analyze", code.size(), unknown / passes,
+					(double)code.size() * passes / seconds / 1000000.0);
+				Logger::WriteMessage(text);
+			}
+		}
+
+		static int argEvaluated;
+
+		static int CountedArg()
+		{
+			return argEvaluated++;
+		}
+
+		TEST_METHOD(DBReportBenchmark)
+		{
+			const int iterations = 10000000;
+			uint32_t savedMask = DBChannelMask;
+
+			// Disabled channel: the arguments must not be evaluated
+
+			for (int enabled = 0; enabled < 2; enabled++)
+			{
+				DBChannelMask = enabled ? ~0 : 0;
+				argEvaluated = 0;
+
+				auto start = std::chrono::high_resolution_clock::now();
+
+				for (int i = 0; i < iterations; i++)
+				{
+					DBReport2(DbgChannel::CPU, "%i %i\n", i, CountedArg());
+				}
+
+				auto stop = std::chrono::high_resolution_clock::now();
+				double ns = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start).count();
+
+				Assert::IsTrue(argEvaluated == (enabled ? iterations : 0));
+
+				char text[0x100];
+				sprintf_s(text, sizeof(text) - 1, "%s channel: %.2f ns/call\n", enabled ? "Enabled" : "Disabled", ns / iterations);
+				Logger::WriteMessage(text);
+			}
+
+			DBChannelMask = savedMask;
+		}
+
 	};
+
+	int GekkoCoreUnitTest::argEvaluated = 0;
 }
@@ -2,13 +2,13 @@
 
 #include "pch.h"
 
-MIControl mi;
+InstanceRef<MIControl, &Instance::mi> mi;
 
 void __fastcall MIReadByte(uint32_t pa, uint32_t* reg)
 {
     uint8_t* ptr;
 
-    if (mi.ram == nullptr)
+    if (mi->ram == nullptr)
     {
         *reg = 0;
         return;
@@ -16,9 +16,9 @@ void __fastcall MIReadByte(uint32_t pa, uint32_t* reg)
 
     if (pa >= BOOTROM_START_ADDRESS)
     {
-        if (mi.BootromPresent)
+        if (mi->BootromPresent)
         {
-            ptr = &mi.bootrom[pa - BOOTROM_START_ADDRESS];
+            ptr = &mi->bootrom[pa - BOOTROM_START_ADDRESS];
             *reg = (uint32_t)*ptr;
         }
         else
@@ -41,9 +41,9 @@ void __fastcall MIReadByte(uint32_t pa, uint32_t* reg)
     }
 
     // bus load byte
-    if (pa < mi.ramSize)
+    if (pa < mi->ramSize)
     {
-        ptr = &mi.ram[pa];
+        ptr = &mi->ram[pa];
         *reg = (uint32_t)*ptr;
     }
     else
@@ -56,7 +56,7 @@ void __fastcall MIWriteByte(uint32_t pa, uint32_t data)
 {
     uint8_t* ptr;
 
-    if (mi.ram == nullptr)
+    if (mi->ram == nullptr)
     {
         return;
     }
@@ -79,9 +79,9 @@ void __fastcall MIWriteByte(uint32_t pa, uint32_t data)
     }
 
     // bus store byte
-    if (pa < mi.ramSize)
+    if (pa < mi->ramSize)
     {
-        ptr = &mi.ram[pa];
+        ptr = &mi->ram[pa];
         *ptr = (uint8_t)data;
     }
 }
@@ -90,7 +90,7 @@ void __fastcall MIReadHalf(uint32_t pa, uint32_t* reg)
 {
     uint8_t* ptr;
 
-    if (mi.ram == nullptr)
+    if (mi->ram == nullptr)
     {
         *reg = 0;
         return;
@@ -98,9 +98,9 @@ void __fastcall MIReadHalf(uint32_t pa, uint32_t* reg)
 
     if (pa >= BOOTROM_START_ADDRESS)
     {
-        if (mi.BootromPresent)
+        if (mi->BootromPresent)
         {
-            ptr = &mi.bootrom[pa - BOOTROM_START_ADDRESS];
+            ptr = &mi->bootrom[pa - BOOTROM_START_ADDRESS];
             *reg = (uint32_t)_byteswap_ushort(*(uint16_t*)ptr);
         }
         else
@@ -123,9 +123,9 @@ void __fastcall MIReadHalf(uint32_t pa, uint32_t* reg)
     }
 
     // bus load halfword
-    if (pa < mi.ramSize)
+    if (pa < mi->ramSize)
     {
-        ptr = &mi.ram[pa];
+        ptr = &mi->ram[pa];
         *reg = (uint32_t)_byteswap_ushort(*(uint16_t*)ptr);
     }
     else
@@ -138,7 +138,7 @@ void __fastcall MIWriteHalf(uint32_t pa, uint32_t data)
 {
     uint8_t* ptr;
 
-    if (mi.ram == nullptr)
+    if (mi->ram == nullptr)
     {
         return;
     }
@@ -161,9 +161,9 @@ void __fastcall MIWriteHalf(uint32_t pa, uint32_t data)
     }
 
     // bus store halfword
-    if (pa < mi.ramSize)
+    if (pa < mi->ramSize)
     {
-        ptr = &mi.ram[pa];
+        ptr = &mi->ram[pa];
         *(uint16_t*)ptr = _byteswap_ushort((uint16_t)data);
     }
 }
@@ -172,25 +172,25 @@ void __fastcall MIReadWord(uint32_t pa, uint32_t* reg)
 {
     uint8_t* ptr;
 
-    if (mi.ram == nullptr)
+    if (mi->ram == nullptr)
     {
         *reg = 0;
         return;
     }
 
     // bus load word
-    if (pa < mi.ramSize)
+    if (pa < mi->ramSize)
     {
-        ptr = &mi.ram[pa];
+        ptr = &mi->ram[pa];
         *reg = _byteswap_ulong(*(uint32_t*)ptr);
         return;
     }
 
     if (pa >= BOOTROM_START_ADDRESS)
     {
-        if (mi.BootromPresent)
+        if (mi->BootromPresent)
         {
-            ptr = &mi.bootrom[pa - BOOTROM_START_ADDRESS];
+            ptr = &mi->bootrom[pa - BOOTROM_START_ADDRESS];
             *reg = _byteswap_ulong(*(uint32_t*)ptr);
         }
         else
@@ -219,7 +219,7 @@ void __fastcall MIWriteWord(uint32_t pa, uint32_t data)
 {
     uint8_t* ptr;
 
-    if (mi.ram == nullptr)
+    if (mi->ram == nullptr)
     {
         return;
     }
@@ -242,9 +242,9 @@ void __fastcall MIWriteWord(uint32_t pa, uint32_t data)
     }
 
     // bus store word
-    if (pa < mi.ramSize)
+    if (pa < mi->ramSize)
     {
-        ptr = &mi.ram[pa];
+        ptr = &mi->ram[pa];
         *(uint32_t*)ptr = _byteswap_ulong(data);
     }
 }
@@ -261,13 +261,13 @@ void __fastcall MIReadDouble(uint32_t pa, uint64_t* reg)
         assert(true);
     }
 
-    if (pa >= RAMSIZE || mi.ram == nullptr)
+    if (pa >= RAMSIZE || mi->ram == nullptr)
     {
         *reg = 0;
         return;
     }
 
-    uint8_t* buf = &mi.ram[pa];
+    uint8_t* buf = &mi->ram[pa];
 
     // bus load doubleword
     *reg = _byteswap_uint64(*(uint64_t*)buf);
@@ -280,12 +280,12 @@ void __fastcall MIWriteDouble(uint32_t pa, uint64_t* data)
         return;
     }
 
-    if (pa >= RAMSIZE || mi.ram == nullptr)
+    if (pa >= RAMSIZE || mi->ram == nullptr)
     {
         return;
     }
 
-    uint8_t* buf = &mi.ram[pa];
+    uint8_t* buf = &mi->ram[pa];
 
     // bus store doubleword
     *(uint64_t*)buf = _byteswap_uint64(*data);
@@ -304,20 +304,20 @@ void __fastcall MIWriteBurst(uint32_t phys_addr, uint8_t burstData[32])
 
 void MIOpen(HWConfig* config)
 {
-    mi.ramSize = config->ramsize;
-    mi.ram = (uint8_t*)malloc(mi.ramSize);
-    assert(mi.ram);
+    mi->ramSize = config->ramsize;
+    mi->ram = (uint8_t*)malloc(mi->ramSize);
+    assert(mi->ram);
 
-    mi.BootromPresent = false;
+    mi->BootromPresent = false;
 
-    memset(mi.ram, 0, mi.ramSize);
+    memset(mi->ram, 0, mi->ramSize);
 }
 
 void MIClose()
 {
-    if (mi.ram)
+    if (mi->ram)
     {
-        free(mi.ram);
-        mi.ram = nullptr;
+        free(mi->ram);
+        mi->ram = nullptr;
     }
 }
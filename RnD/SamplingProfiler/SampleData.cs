@@ -33,6 +33,14 @@ namespace SamplingProfiler
 
         public void Append(string filename)
         {
+            byte[] data = File.ReadAllBytes(filename);
+
+            if (data.Length >= 8 && Encoding.ASCII.GetString(data, 0, 8) == "DOLWPROF")
+            {
+                AppendBinary(data);
+                return;
+            }
+
             SampleDataObject json = JsonConvert.DeserializeObject<SampleDataObject>(File.ReadAllText(filename, Encoding.UTF8));
 
             UInt64 prevValue = 0;
@@ -58,6 +66,29 @@ namespace SamplingProfiler
             }
         }
 
+        // Sample file of the current profiler (see ProfileHeader in SamplingProfiler.h). Only PC is used, the stack is ignored.
+        void AppendBinary(byte[] data)
+        {
+            const int headerSize = 48;
+            int pos = headerSize;
+
+            while (pos + 12 <= data.Length)
+            {
+                UInt64 time = BitConverter.ToUInt64(data, pos);
+                int depth = (int)BitConverter.ToUInt32(data, pos + 8);
+
+                if (depth == 0 || pos + 12 + 4 * depth > data.Length)
+                    break;
+
+                Sample sample = new Sample();
+                sample.time = time;
+                sample.pc = BitConverter.ToUInt32(data, pos + 12);
+                samples.Add(sample);
+
+                pos += 12 + 4 * depth;
+            }
+        }
+
         public void Clear()
         {
             samples.Clear();
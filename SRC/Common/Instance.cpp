@@ -0,0 +1,4 @@
+#include "pch.h"
+
+Instance* Instance::Main = nullptr;
+thread_local Instance* Instance::Current = nullptr;
@@ -0,0 +1,99 @@
+// Emulated console instance.
+
+// All the state of an emulated console (the core, memory, devices and their threads) is reached through the instance object,
+// so several consoles can run in one process. The code of the emulator still addresses the devices by their old global names (mi, vi, Gekko::Gekko, ...),
+// these are InstanceRef proxies, which resolve to the instance of the calling thread.
+
+#pragma once
+
+#include <memory>
+
+namespace Gekko
+{
+	class GekkoCore;
+}
+
+namespace Flipper
+{
+	class Flipper;
+}
+
+namespace DVD
+{
+	class DduCore;
+}
+
+struct MIControl;
+struct ARControl;
+struct DIControl;
+struct SIControl;
+struct EIControl;
+struct MCControl;
+struct AIControl;
+struct PIControl;
+struct VIControl;
+struct FifoControl;
+struct DVDControl;
+struct HLEControl;
+struct LoaderData;
+struct Emulator;
+class Snapshot;
+
+class Instance
+{
+public:
+	Gekko::GekkoCore* gekko = nullptr;
+	Flipper::Flipper* hw = nullptr;			// Exists while the emulation is started (EMUOpen)
+	DVD::DduCore* ddu = nullptr;
+
+	MIControl* mi = nullptr;
+	ARControl* aram = nullptr;
+	DIControl* di = nullptr;
+	SIControl* si = nullptr;
+	EIControl* exi = nullptr;
+	MCControl* mc = nullptr;
+	AIControl* ai = nullptr;
+	PIControl* pi = nullptr;
+	VIControl* vi = nullptr;
+	FifoControl* fifo = nullptr;
+	DVDControl* dvd = nullptr;
+	HLEControl* hle = nullptr;
+	LoaderData* ldat = nullptr;
+	Emulator* emu = nullptr;
+
+	// The base of the next delta snapshot (see Snapshot::Capture)
+	std::shared_ptr<Snapshot> lastSnapshot;
+
+	// The video backend, pads, sound output, memcards, symbol map, rewind buffer and debugger are process-wide and belong to the main instance.
+	// The other instances are headless: they run without them.
+	bool headless = false;
+
+	// The instance of the main window and debugger
+	static Instance* Main;
+
+	// Set for the threads of the instance (Thread inherits it from the creating thread). Other threads work with the main instance.
+	static thread_local Instance* Current;
+
+	static Instance* Get()
+	{
+		Instance* current = Current;
+		return current != nullptr ? current : Main;
+	}
+};
+
+// Proxy of an instance member, used in place of the former global. Behaves like a pointer to the object.
+template<typename T, T* Instance::*Member>
+class InstanceRef
+{
+public:
+	T* Get() const { return Instance::Get()->*Member; }
+	T* operator->() const { return Get(); }
+	T& operator*() const { return *Get(); }
+	operator T*() const { return Get(); }
+
+	InstanceRef& operator=(T* object)
+	{
+		Instance::Get()->*Member = object;
+		return *this;
+	}
+};
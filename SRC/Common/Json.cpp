@@ -2,93 +2,72 @@
 
 void Json::DestroyValue(Value* value)
 {
-	while (!value->children.empty())
-	{
-		Value* child = value->children.back();
-		value->children.pop_back();
-		DestroyValue(child);
-		delete child;
-	}
+	value->Clear();
+}
+
+#pragma region "Arena"
+
+void* Json::Arena::Alloc(size_t size)
+{
+	size = (size + 7) & ~7;
 
-	if (value->type == ValueType::String)
+	// Large allocations get own block, the current one continues
+	if (size > BlockSize / 4)
 	{
-		if (value->value.AsString)
-		{
-			delete[] value->value.AsString;
-		}
+		uint8_t* block = new uint8_t[size];
+		blocks.push_back(block);
+		return block;
 	}
 
-	if (value->name != nullptr)
+	if (size > left)
 	{
-		delete[] value->name;
+		ptr = new uint8_t[BlockSize];
+		left = BlockSize;
+		blocks.push_back(ptr);
 	}
-}
 
-TCHAR* Json::CloneStr(const TCHAR* str)
-{
-	size_t len = _tcslen(str);
-	TCHAR* clone = new TCHAR[len + 1];
-	_tcscpy_s(clone, len + 1, str);
-	return clone;
+	void* mem = ptr;
+	ptr += size;
+	left -= size;
+	return mem;
 }
 
-TCHAR* Json::CloneAnsiStr(const char* str)
+void Json::Arena::Reset()
 {
-	size_t len = strlen(str);
-	TCHAR* clone = new TCHAR[len + 1];
-	TCHAR* tcharPtr = clone;
-	char* charPtr = (char*)str;
-	while (*charPtr)
+	for (auto block : blocks)
 	{
-		*tcharPtr++ = *charPtr++;
+		delete[] block;
 	}
-	*tcharPtr++ = 0;
-	return clone;
+	blocks.clear();
+	ptr = nullptr;
+	left = 0;
 }
 
-#pragma region "Serialization Related"
-
-void Json::EmitChar(SerializeContext* ctx, uint8_t val, bool sizeOnly)
-{
-	assert(*ctx->actualSize < ctx->maxSize);
+#pragma endregion "Arena"
 
-	if (!sizeOnly)
-	{
-		(*ctx->ptr)[0] = val;
-		(*ctx->ptr)++;
-	}
-	(*ctx->actualSize)++;
-}
+#pragma region "Serialization Related"
 
-void Json::EmitText(SerializeContext* ctx, const char* text, bool sizeOnly)
+void Json::Writer::Text(const char* text)
 {
 	uint8_t* ptr = (uint8_t*)text;
 	while (*ptr)
-		EmitChar(ctx, *ptr++, sizeOnly);
+		Char(*ptr++);
 }
 
-void Json::EmitCodePoint(SerializeContext* ctx, int cp, bool sizeOnly)
+void Json::Writer::CodePoint(int cp)
 {
-	uint8_t c[4] = { 0 };
-	int utf8Size = 0;
-
 	// http://www.zedwood.com/article/cpp-utf8-char-to-codepoint
-	if (cp <= 0x7F) { c[0] = (uint8_t)cp; utf8Size = 1; }
-	else if (cp <= 0x7FF) { c[0] = (cp >> 6) + 192; c[1] = (cp & 63) + 128; utf8Size = 2; }
+	if (cp <= 0x7F) { Char((uint8_t)cp); }
+	else if (cp <= 0x7FF) { Char((cp >> 6) + 192); Char((cp & 63) + 128); }
 	else if (0xd800 <= cp && cp <= 0xdfff) { throw "Invalid block of utf8"; }
-	else if (cp <= 0xFFFF) { c[0] = (cp >> 12) + 224; c[1] = ((cp >> 6) & 63) + 128; c[2] = (cp & 63) + 128; utf8Size = 3; }
-	else if (cp <= 0x10FFFF) { c[0] = (cp >> 18) + 240; c[1] = ((cp >> 12) & 63) + 128; c[2] = ((cp >> 6) & 63) + 128; c[3] = (cp & 63) + 128; utf8Size = 4; }
+	else if (cp <= 0xFFFF) { Char((cp >> 12) + 224); Char(((cp >> 6) & 63) + 128); Char((cp & 63) + 128); }
+	else if (cp <= 0x10FFFF) { Char((cp >> 18) + 240); Char(((cp >> 12) & 63) + 128); Char(((cp >> 6) & 63) + 128); Char((cp & 63) + 128); }
 	else { throw "Unsupported codepoint range"; }
-
-	for (int i = 0; i < utf8Size; i++)
-	{
-		EmitChar(ctx, c[i], sizeOnly);
-	}
 }
 
-void Json::EmitTcharString(SerializeContext* ctx, TCHAR* str, bool sizeOnly)
+void Json::Writer::TcharString(const TCHAR* str)
 {
-	TCHAR* ptr = str;
+	const TCHAR* ptr = str;
 	while (*ptr)
 	{
 		int cp = (int)*ptr;
@@ -98,39 +77,39 @@ void Json::EmitTcharString(SerializeContext* ctx, TCHAR* str, bool sizeOnly)
 		switch (cp)
 		{
 			case '\"':
-				EmitCodePoint(ctx, '\\', sizeOnly);
-				EmitCodePoint(ctx, '\"', sizeOnly);
+				Char('\\');
+				Char('\"');
 				break;
 			case '\\':
-				EmitCodePoint(ctx, '\\', sizeOnly);
-				EmitCodePoint(ctx, '\\', sizeOnly);
+				Char('\\');
+				Char('\\');
 				break;
 			case '/':
-				EmitCodePoint(ctx, '\\', sizeOnly);
-				EmitCodePoint(ctx, '/', sizeOnly);
+				Char('\\');
+				Char('/');
 				break;
 			case '\b':
-				EmitCodePoint(ctx, '\\', sizeOnly);
-				EmitCodePoint(ctx, 'b', sizeOnly);
+				Char('\\');
+				Char('b');
 				break;
 			case '\f':
-				EmitCodePoint(ctx, '\\', sizeOnly);
-				EmitCodePoint(ctx, 'f', sizeOnly);
+				Char('\\');
+				Char('f');
 				break;
 			case '\n':
-				EmitCodePoint(ctx, '\\', sizeOnly);
-				EmitCodePoint(ctx, 'n', sizeOnly);
+				Char('\\');
+				Char('n');
 				break;
 			case '\r':
-				EmitCodePoint(ctx, '\\', sizeOnly);
-				EmitCodePoint(ctx, 'r', sizeOnly);
+				Char('\\');
+				Char('r');
 				break;
 			case '\t':
-				EmitCodePoint(ctx, '\\', sizeOnly);
-				EmitCodePoint(ctx, 't', sizeOnly);
+				Char('\\');
+				Char('t');
 				break;
 			default:
-				EmitCodePoint(ctx, cp, sizeOnly);
+				CodePoint(cp);
 		}
 
 		ptr++;
@@ -139,10 +118,19 @@ void Json::EmitTcharString(SerializeContext* ctx, TCHAR* str, bool sizeOnly)
 
 // Indentation
 
-void Json::Indent(SerializeContext* ctx, int depth, bool sizeOnly)
+void Json::Writer::Indent(int depth)
 {
 	while (depth--)
-		Json::EmitText(ctx, "  ", sizeOnly);
+		Text("  ");
+}
+
+void Json::Writer::Flush()
+{
+	if (sink != nullptr && used != 0)
+	{
+		sink(context, buffer, used);
+	}
+	used = 0;
 }
 
 #pragma endregion "Serialization Related"
@@ -263,7 +251,7 @@ int Json::FetchCodepoint(DeserializeContext* ctx)
 
 bool Json::GetString(DeserializeContext* ctx, Token& token)
 {
-	TCHAR str[MaxStringSize] = { 0, };
+	TCHAR* str = ctx->string;
 	size_t strSize = 0;
 
 	if (ctx->ptr[0] != '\"')
@@ -284,7 +272,7 @@ bool Json::GetString(DeserializeContext* ctx, Token& token)
 		{
 			str[strSize] = 0;
 			token.type = TokenType::String;
-			token.value.AsString = CloneStr(str);
+			token.value.AsString = str;
 			return true;
 		}
 
@@ -475,14 +463,36 @@ void Json::GetToken(Token& token, DeserializeContext* ctx)
 
 #pragma endregion "De-Serialization Related"
 
+// Allocation
+
+void* Json::Value::Alloc(size_t size)
+{
+	return arena ? arena->Alloc(size) : new uint8_t[size];
+}
+
+Json::Value* Json::Value::Create(ValueType _type, const char* keyName)
+{
+	Value* child = arena ? new (arena->Alloc(sizeof(Value))) Value(this) : new Value(this);
+	child->type = _type;
+	child->name = child->CloneName(keyName);
+	return child;
+}
+
+Json::Value* Json::Value::Append(ValueType _type, const char* keyName)
+{
+	Value* child = Create(_type, keyName);
+	children.push_back(child);
+	return child;
+}
+
 char* Json::Value::CloneName(const char* otherName)
 {
 	if (otherName == nullptr)		// Name can be null
 		return nullptr;
 
 	size_t len = strlen(otherName);
-	char* clone = new char[len + 1];
-	strcpy_s(clone, len + 1, otherName);
+	char* clone = (char*)Alloc(len + 1);
+	memcpy(clone, otherName, len + 1);
 	return clone;
 }
 
@@ -492,7 +502,7 @@ char* Json::Value::CloneTcharName(const TCHAR* otherName)
 		return nullptr;
 
 	size_t len = _tcslen(otherName);
-	char* clone = new char[len + 1];
+	char* clone = (char*)Alloc(len + 1);
 
 	for (size_t i = 0; i < len; i++)
 	{
@@ -503,6 +513,111 @@ char* Json::Value::CloneTcharName(const TCHAR* otherName)
 	return clone;
 }
 
+TCHAR* Json::Value::CloneStr(const TCHAR* str)
+{
+	size_t len = _tcslen(str);
+	TCHAR* clone = (TCHAR*)Alloc((len + 1) * sizeof(TCHAR));
+	memcpy(clone, str, (len + 1) * sizeof(TCHAR));
+	return clone;
+}
+
+TCHAR* Json::Value::CloneAnsiStr(const char* str)
+{
+	size_t len = strlen(str);
+	TCHAR* clone = (TCHAR*)Alloc((len + 1) * sizeof(TCHAR));
+	TCHAR* tcharPtr = clone;
+	char* charPtr = (char*)str;
+	while (*charPtr)
+	{
+		*tcharPtr++ = *charPtr++;
+	}
+	*tcharPtr++ = 0;
+	return clone;
+}
+
+// The arena memory is released with the document
+
+void Json::Value::FreeName()
+{
+	if (name != nullptr && arena == nullptr)
+	{
+		delete[] (uint8_t*)name;
+	}
+	name = nullptr;
+}
+
+void Json::Value::FreeString()
+{
+	if (type == ValueType::String)
+	{
+		if (value.AsString != nullptr && arena == nullptr)
+		{
+			delete[] (uint8_t*)value.AsString;
+		}
+		value.AsString = nullptr;
+	}
+}
+
+void Json::Value::SetName(const char* keyName)
+{
+	FreeName();
+	name = CloneName(keyName);
+
+	if (parent != nullptr)
+	{
+		parent->DropIndex();
+	}
+}
+
+// Name index
+
+void Json::Value::UpdateIndex()
+{
+	if (nameIndex == nullptr)
+	{
+		nameIndex = new std::unordered_map<std::string_view, Value*>();
+	}
+
+	// The first member with the same name wins, same as the linear search
+	while (indexed < children.size())
+	{
+		Value* child = children[indexed++];
+		if (child->name != nullptr)
+		{
+			nameIndex->emplace(child->name, child);
+		}
+	}
+}
+
+void Json::Value::DropIndex()
+{
+	delete nameIndex;
+	nameIndex = nullptr;
+	indexed = 0;
+}
+
+// Recursive destruction of the descendants. The values from the arena are only destructed.
+
+void Json::Value::Clear()
+{
+	for (auto child : children)
+	{
+		if (child->arena != nullptr)
+		{
+			child->~Value();
+		}
+		else
+		{
+			delete child;
+		}
+	}
+	children.clear();
+
+	DropIndex();
+	FreeString();
+	FreeName();
+}
+
 void Json::Value::DeserializeObject(DeserializeContext* ctx)
 {
 	Token token, colon, comma;
@@ -526,15 +641,9 @@ void Json::Value::DeserializeObject(DeserializeContext* ctx)
 				Json::GetToken(colon, ctx);
 				assert(colon.type == TokenType::Colon);
 
-				child = new Value(this);
-				children.push_back(child);
+				child = Append(ValueType::Unknown, nullptr);
 				child->Deserialize(ctx, token.value.AsString);
 
-				if (token.value.AsString != nullptr)
-				{
-					delete[] token.value.AsString;
-				}
-
 				counter++;
 
 				Json::GetToken(comma, ctx);
@@ -544,6 +653,10 @@ void Json::Value::DeserializeObject(DeserializeContext* ctx)
 				}
 				else if (comma.type == TokenType::ObjectEnd)
 				{
+					if (children.size() >= NameIndexThreshold)
+					{
+						UpdateIndex();
+					}
 					return;
 				}
 				else
@@ -596,8 +709,7 @@ void Json::Value::DeserializeArray(DeserializeContext* ctx)
 
 		// Array element
 
-		Value* child = new Value(this);
-		children.push_back(child);
+		Value* child = Append(ValueType::Unknown, nullptr);
 		child->Deserialize(ctx, nullptr);
 
 		counter++;
@@ -618,75 +730,75 @@ void Json::Value::DeserializeArray(DeserializeContext* ctx)
 	}
 }
 
-void Json::Value::Serialize(SerializeContext* ctx, int depth, bool sizeOnly)
+void Json::Value::Serialize(Writer& writer, int depth)
 {
-	TCHAR temp[0x100] = { 0, };
+	char temp[0x100] = { 0, };
 
 	assert(depth < MaxDepth);
 
 	switch (type)
 	{
 		case ValueType::Object:
-			Indent(ctx, depth, sizeOnly);
-			Json::EmitText(ctx, "{\r\n", sizeOnly);
+			writer.Indent(depth);
+			writer.Text("{\r\n");
 
 			for (auto it = children.begin(); it != children.end(); ++it)
 			{
 				if (it != children.begin())
 				{
-					Json::EmitText(ctx, ",\r\n", sizeOnly);
+					writer.Text(",\r\n");
 				}
 
 				Value* child = *it;
 
-				Indent(ctx, depth + 1, sizeOnly);
-				Json::EmitChar(ctx, '\"', sizeOnly);
-				Json::EmitText(ctx, child->name, sizeOnly);
-				Json::EmitChar(ctx, '\"', sizeOnly);
-				Json::EmitText(ctx, " : ", sizeOnly);
+				writer.Indent(depth + 1);
+				writer.Char('\"');
+				writer.Text(child->name);
+				writer.Char('\"');
+				writer.Text(" : ");
 
-				child->Serialize(ctx, depth + 1, sizeOnly);
+				child->Serialize(writer, depth + 1);
 			}
 
-			Indent(ctx, depth, sizeOnly);
-			Json::EmitText(ctx, "}\r\n", sizeOnly);
+			writer.Indent(depth);
+			writer.Text("}\r\n");
 			break;
 		case ValueType::Array:
-			Indent(ctx, depth, sizeOnly);
-			Json::EmitText(ctx, "[ ", sizeOnly);
+			writer.Indent(depth);
+			writer.Text("[ ");
 
 			for (auto it = children.begin(); it != children.end(); ++it)
 			{
 				if (it != children.begin())
 				{
-					Json::EmitText(ctx, ", ", sizeOnly);
+					writer.Text(", ");
 				}
 
 				Value* child = *it;
-				child->Serialize(ctx, depth + 1, sizeOnly);
+				child->Serialize(writer, depth + 1);
 			}
 
-			Indent(ctx, depth, sizeOnly);
-			Json::EmitChar(ctx, ']', sizeOnly);
+			writer.Indent(depth);
+			writer.Char(']');
 			break;
 		case ValueType::Null:
-			Json::EmitText(ctx, "null", sizeOnly);
+			writer.Text("null");
 			break;
 		case ValueType::Bool:
-			Json::EmitText(ctx, value.AsBool ? "true" : "false", sizeOnly);
+			writer.Text(value.AsBool ? "true" : "false");
 			break;
 		case ValueType::Int:
-			_stprintf_s(temp, _countof(temp) - 1, _T("%I64u"), value.AsInt);
-			EmitTcharString(ctx, temp, sizeOnly);
+			sprintf_s(temp, sizeof(temp) - 1, "%I64u", value.AsInt);
+			writer.Text(temp);
 			break;
 		case ValueType::Float:
-			_stprintf_s(temp, _countof(temp) - 1, _T("%.4f"), value.AsFloat);
-			EmitTcharString(ctx, temp, sizeOnly);
+			sprintf_s(temp, sizeof(temp) - 1, "%.4f", value.AsFloat);
+			writer.Text(temp);
 			break;
 		case ValueType::String:
-			Json::EmitChar(ctx, '\"', sizeOnly);
-			EmitTcharString(ctx, value.AsString, sizeOnly);
-			Json::EmitChar(ctx, '\"', sizeOnly);
+			writer.Char('\"');
+			writer.TcharString(value.AsString);
+			writer.Char('\"');
 			break;
 		default:
 			throw "Unknown ValueType";
@@ -713,10 +825,6 @@ void Json::Value::Deserialize(DeserializeContext* ctx, TCHAR* keyName)
 		case TokenType::String:
 			type = ValueType::String;
 			value.AsString = CloneStr(token.value.AsString);
-			if (token.value.AsString != nullptr)
-			{
-				delete[] token.value.AsString;
-			}
 			break;
 		case TokenType::Int:
 			type = ValueType::Int;
@@ -748,144 +856,102 @@ void Json::Value::Deserialize(DeserializeContext* ctx, TCHAR* keyName)
 
 Json::Value* Json::Value::AddInt(const char* keyName, int _value)
 {
-	Value* child = new Value(this);
-	child->type = ValueType::Int;
-	child->name = CloneName(keyName);
+	Value* child = Append(ValueType::Int, keyName);
 	child->value.AsInt = _value;
-	children.push_back(child);
 	return child;
 }
 
 Json::Value* Json::Value::AddUInt16(const char* keyName, uint16_t _value)
 {
-	Value* child = new Value(this);
-	child->type = ValueType::Int;
-	child->name = CloneName(keyName);
+	Value* child = Append(ValueType::Int, keyName);
 	child->value.AsInt = 0;
 	child->value.AsUint16 = _value;
-	children.push_back(child);
 	return child;
 }
 
 Json::Value* Json::Value::AddUInt32(const char* keyName, uint32_t _value)
 {
-	Value* child = new Value(this);
-	child->type = ValueType::Int;
-	child->name = CloneName(keyName);
+	Value* child = Append(ValueType::Int, keyName);
 	child->value.AsInt = 0;
 	child->value.AsUint32 = _value;
-	children.push_back(child);
 	return child;
 }
 
 Json::Value* Json::Value::AddUInt64(const char* keyName, uint64_t _value)
 {
-	Value* child = new Value(this);
-	child->type = ValueType::Int;
-	child->name = CloneName(keyName);
+	Value* child = Append(ValueType::Int, keyName);
 	child->value.AsInt = _value;
-	children.push_back(child);
 	return child;
 }
 
 Json::Value* Json::Value::AddFloat(const char* keyName, float _value)
 {
-	Value* child = new Value(this);
-	child->type = ValueType::Float;
-	child->name = CloneName(keyName);
+	Value* child = Append(ValueType::Float, keyName);
 	child->value.AsFloat = _value;
-	children.push_back(child);
 	return child;
 }
 
 Json::Value* Json::Value::AddNull(const char* keyName)
 {
-	Value* child = new Value(this);
-	child->type = ValueType::Null;
-	child->name = CloneName(keyName);
-	children.push_back(child);
-	return child;
+	return Append(ValueType::Null, keyName);
 }
 
 Json::Value* Json::Value::AddBool(const char* keyName, bool _value)
 {
-	Value* child = new Value(this);
-	child->type = ValueType::Bool;
-	child->name = CloneName(keyName);
+	Value* child = Append(ValueType::Bool, keyName);
 	child->value.AsBool = _value;
-	children.push_back(child);
 	return child;
 }
 
 Json::Value* Json::Value::AddString(const char* keyName, const TCHAR* str)
 {
-	Value* child = new Value(this);
-	child->type = ValueType::String;
-	child->name = CloneName(keyName);
-	child->value.AsString = CloneStr(str);
-	children.push_back(child);
+	Value* child = Append(ValueType::String, keyName);
+	child->value.AsString = child->CloneStr(str);
 	return child;
 }
 
 Json::Value* Json::Value::AddAnsiString(const char* keyName, const char* str)
 {
-	Value* child = new Value(this);
-	child->type = ValueType::String;
-	child->name = CloneName(keyName);
-	child->value.AsString = CloneAnsiStr(str);
-	children.push_back(child);
+	Value* child = Append(ValueType::String, keyName);
+	child->value.AsString = child->CloneAnsiStr(str);
 	return child;
 }
 
 Json::Value* Json::Value::ReplaceString(const TCHAR* str)
 {
 	assert(type == ValueType::String);
-	if (value.AsString)
-	{
-		delete[] value.AsString;
-	}
+	FreeString();
 	value.AsString = CloneStr(str);
 	return this;
 }
 
 Json::Value* Json::Value::AddObject(const char* keyName)
 {
-	Value* child = new Value(this);
-	child->type = ValueType::Object;
-	child->name = CloneName(keyName);
-	children.push_back(child);
-	return child;
+	return Append(ValueType::Object, keyName);
 }
 
 Json::Value* Json::Value::AddArray(const char* keyName)
 {
-	Value* child = new Value(this);
-	child->type = ValueType::Array;
-	child->name = CloneName(keyName);
-	children.push_back(child);
-	return child;
+	return Append(ValueType::Array, keyName);
 }
 
+// The value keeps its allocation, it is released with this tree
 Json::Value* Json::Value::AddValue(const char* keyName, Json::Value* value)
 {
-	if (value->name)
-	{
-		delete[] value->name;
-	}
-	value->name = CloneName(keyName);
+	value->SetName(keyName);
+	value->parent = this;
 	children.push_back(value);
 	return value;
 }
 
 Json::Value* Json::Value::Add(Value* _parent, Value* other)
 {
-	Value* child = new Value(_parent);
-	child->type = other->type;
-	child->name = CloneName(other->name);
+	Value* child = _parent->Create(other->type, other->name);
 	switch (other->type)
 	{
 		case ValueType::Array:
 		case ValueType::Object:
+			child->children.reserve(other->children.size());
 			for (auto it = other->children.begin(); it != other->children.end(); ++it)
 			{
 				child->children.push_back(Add(child, *it));
@@ -901,7 +967,7 @@ Json::Value* Json::Value::Add(Value* _parent, Value* other)
 			child->value.AsFloat = other->value.AsFloat;
 			break;
 		case ValueType::String:
-			child->value.AsString = CloneStr(other->value.AsString);
+			child->value.AsString = child->CloneStr(other->value.AsString);
 			break;
 	}
 	return child;
@@ -931,16 +997,13 @@ Json::Value* Json::Value::Replace(Value* _parent, Value* other)
 
 	if (child == nullptr)
 	{
-		child = new Value(parent);
+		child = _parent->Create(other->type, other->name);
 		newChild = true;
 	}
-
-	child->type = other->type;
-	if (child->name)
+	else if (other->name == nullptr || strcmp(child->name, other->name))
 	{
-		delete[] child->name;
+		child->SetName(other->name);
 	}
-	child->name = CloneName(other->name);
 
 	switch (other->type)
 	{
@@ -965,11 +1028,8 @@ Json::Value* Json::Value::Replace(Value* _parent, Value* other)
 			child->value.AsFloat = other->value.AsFloat;
 			break;
 		case ValueType::String:
-			if (child->value.AsString)
-			{
-				delete[] child->value.AsString;
-			}
-			child->value.AsString = CloneStr(other->value.AsString);
+			child->FreeString();
+			child->value.AsString = child->CloneStr(other->value.AsString);
 			break;
 	}
 
@@ -980,6 +1040,13 @@ Json::Value* Json::Value::Replace(Value* _parent, Value* other)
 
 Json::Value* Json::Value::ByName(const char* byName)
 {
+	if (children.size() >= NameIndexThreshold)
+	{
+		UpdateIndex();
+		auto it = nameIndex->find(byName);
+		return it != nameIndex->end() ? it->second : nullptr;
+	}
+
 	for (auto it = children.begin(); it != children.end(); ++it)
 	{
 		Value* child = *it;
@@ -1009,36 +1076,67 @@ Json::Value* Json::Value::ByType(const ValueType byType)
 	return nullptr;
 }
 
-void Json::Serialize(void* text, size_t maxTextSize, size_t& actualTextSize)
-{
-	actualTextSize = 0;
-
-	SerializeContext ctx = { 0 };
-
-	ctx.ptr = (uint8_t**)&text;
-	ctx.maxSize = maxTextSize;
-	ctx.actualSize = &actualTextSize;
+// Serialize
 
+void Json::Serialize(Writer& writer)
+{
 	for (auto it = root.children.begin(); it != root.children.end(); ++it)
 	{
-		(*it)->Serialize(&ctx, 0, false);
+		(*it)->Serialize(writer, 0);
 	}
+	writer.Flush();
 }
 
-void Json::GetSerializedTextSize(void* text, size_t maxTextSize, size_t& actualTextSize)
+template <typename T>
+static void AppendSink(void* context, const uint8_t* data, size_t size)
 {
-	actualTextSize = 0;
+	T* text = (T*)context;
+	text->insert(text->end(), data, data + size);
+}
 
-	SerializeContext ctx = { 0 };
+void Json::Serialize(std::vector<uint8_t>& text)
+{
+	Writer writer(AppendSink<std::vector<uint8_t>>, &text);
+	Serialize(writer);
+}
 
-	ctx.ptr = (uint8_t**)&text;
-	ctx.maxSize = maxTextSize;
-	ctx.actualSize = &actualTextSize;
+void Json::Serialize(std::string& text)
+{
+	Writer writer(AppendSink<std::string>, &text);
+	Serialize(writer);
+}
 
-	for (auto it = root.children.begin(); it != root.children.end(); ++it)
-	{
-		(*it)->Serialize(&ctx, 0, true);
-	}
+struct BufferSinkContext
+{
+	uint8_t* ptr;
+	size_t maxSize;
+	size_t size;
+};
+
+static void BufferSink(void* context, const uint8_t* data, size_t size)
+{
+	BufferSinkContext* ctx = (BufferSinkContext*)context;
+	assert(ctx->size + size <= ctx->maxSize);
+	memcpy(ctx->ptr + ctx->size, data, size);
+	ctx->size += size;
+}
+
+void Json::Serialize(void* text, size_t maxTextSize, size_t& actualTextSize)
+{
+	BufferSinkContext ctx = { (uint8_t*)text, maxTextSize, 0 };
+
+	Writer writer(BufferSink, &ctx);
+	Serialize(writer);
+
+	actualTextSize = writer.Size();
+}
+
+void Json::GetSerializedTextSize(void* text, size_t maxTextSize, size_t& actualTextSize)
+{
+	Writer writer(nullptr, nullptr);
+	Serialize(writer);
+
+	actualTextSize = writer.Size();
 }
 
 void Json::Deserialize(void* text, size_t textSize)
@@ -1059,7 +1157,9 @@ void Json::Deserialize(void* text, size_t textSize)
 void Json::Clone(Json* other)
 {
 	DestroyValue(&root);
+	arena.Reset();
 
+	root.children.reserve(other->root.children.size());
 	for (auto it = other->root.children.begin(); it != other->root.children.end(); ++it)
 	{
 		Value* child = root.Add(&root, *it);
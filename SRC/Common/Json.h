@@ -3,11 +3,17 @@
 // All errors during deserialization are thrown by exceptions.
 // During serializing, in theory, there shouldn't be any mistakes (if we are not enemies to ourselves and have not changed, for example, the Value type to some non-standard one).
 
+// The values of a document, their names and strings are allocated from the arena of the document, and released all at once with the document.
+// The values made by `new Json::Value()` (for example, the output of JDI commands) use the heap, same for their descendants; deleting such value releases the whole tree.
+
 #pragma once
 
 #include <tchar.h>
 #include <list>
 #include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
 #include <cassert>
 
 class Json
@@ -20,40 +26,82 @@ class Json
 public:
 	class Value;
 
-private:
+	// Bump allocator. Memory is released only all at once.
 
-	// Recursive destruction of value and all its descendants
-	void DestroyValue(Value* value);
+	class Arena
+	{
+		static const size_t BlockSize = 0x4000;
 
-	static TCHAR* CloneStr(const TCHAR* str);
-	static TCHAR* CloneAnsiStr(const char* str);
+		std::vector<uint8_t*> blocks;
+		uint8_t* ptr = nullptr;
+		size_t left = 0;
+
+	public:
+		~Arena() { Reset(); }
+
+		void* Alloc(size_t size);
+		void Reset();
+	};
 
 	#pragma region "Serialization Related"
 
-	// Serialize context
+	// Streaming writer. The text is collected in a small buffer and passed to the sink by parts, so large documents don't need a buffer for the whole text.
+	// Without the sink only the size of the text is counted.
 
-	struct SerializeContext
+	class Writer
 	{
-		uint8_t** ptr;
-		size_t* actualSize;
-		size_t maxSize;
-	};
+	public:
+		typedef void (*Sink)(void* context, const uint8_t* data, size_t size);
+
+	private:
+		static const size_t BufferSize = 0x1000;
+
+		Sink sink;
+		void* context;
+		uint8_t buffer[BufferSize];
+		size_t used = 0;
+		size_t total = 0;
+
+	public:
+		Writer(Sink _sink, void* _context)
+		{
+			sink = _sink;
+			context = _context;
+		}
 
-	// Base procedure for generating the text.
-	static void EmitChar(SerializeContext* ctx, uint8_t val, bool sizeOnly);
+		// Base procedure for generating the text.
+		void Char(uint8_t val)
+		{
+			if (used == BufferSize)
+			{
+				Flush();
+			}
+			buffer[used++] = val;
+			total++;
+		}
 
-	static void EmitText(SerializeContext* ctx, const char* text, bool sizeOnly);
+		void Text(const char* text);
 
-	// Simple TCHAR to UTF-8 Converter + Escaping
-	static void EmitCodePoint(SerializeContext* ctx, int cp, bool sizeOnly);
-	static void EmitTcharString(SerializeContext* ctx, TCHAR* str, bool sizeOnly);
+		// Simple TCHAR to UTF-8 Converter + Escaping
+		void CodePoint(int cp);
+		void TcharString(const TCHAR* str);
 
-	// Indentation
+		// Indentation
+		void Indent(int depth);
 
-	static void Indent(SerializeContext* ctx, int depth, bool sizeOnly);
+		// Pass the rest of the text to the sink. Must be called at the end.
+		void Flush();
+
+		size_t Size() { return total; }
+	};
 
 	#pragma endregion "Serialization Related"
 
+private:
+
+	// Recursive destruction of value and all its descendants
+	void DestroyValue(Value* value);
+
 	#pragma region "De-Serialization Related"
 
 	// Deserialize 
@@ -63,6 +111,7 @@ private:
 		uint8_t* ptr;
 		size_t offset;
 		size_t maxSize;
+		TCHAR string[MaxStringSize];		// The last String token
 	};
 
 	static bool IsWhiteSpace(uint8_t value);
@@ -97,7 +146,7 @@ private:
 			uint64_t AsInt;
 			float AsFloat;
 			bool AsBool;
-			TCHAR* AsString = nullptr;
+			TCHAR* AsString = nullptr;		// Points to the DeserializeContext, valid until the next token
 		} value;
 	};
 
@@ -130,13 +179,35 @@ public:
 
 	class Value
 	{
+		friend class Json;
+
+		// Objects with more members get the hash of names for ByName
+		static const size_t NameIndexThreshold = 16;
+
+		std::unordered_map<std::string_view, Value*>* nameIndex = nullptr;
+		size_t indexed = 0;			// Children added to the index
+
+		// Allocated the same way as this value (from the arena or the heap)
+		void* Alloc(size_t size);
+		Value* Create(ValueType _type, const char* keyName);
+		Value* Append(ValueType _type, const char* keyName);
 		char* CloneName(const char* otherName);
 		char* CloneTcharName(const TCHAR* otherName);
+		TCHAR* CloneStr(const TCHAR* str);
+		TCHAR* CloneAnsiStr(const char* str);
+		void FreeName();
+		void FreeString();
+		void SetName(const char* keyName);
+		void UpdateIndex();
+		void DropIndex();
+		void Clear();
+
 		void DeserializeObject(DeserializeContext* ctx);
 		void DeserializeArray(DeserializeContext* ctx);
 
 	public:
 		Value* parent = nullptr;
+		Arena* arena = nullptr;			// nullptr: heap
 		ValueType type = ValueType::Unknown;
 		// Name of object members. 
 		// For simplicity, we do not support Non-Ansi Json value names (although full use of Utf-8 is allowed in the values)
@@ -151,16 +222,22 @@ public:
 			TCHAR* AsString = nullptr;	// Only the String value type requires the release of the stored value.
 			bool AsBool;
 		} value;
-		std::list<Value*> children;
+		std::vector<Value*> children;
 
 		Value() { }
 
 		Value(Value* _parent)
 		{
 			this->parent = _parent;
+			this->arena = _parent ? _parent->arena : nullptr;
 		}
 
-		void Serialize(SerializeContext* ctx, int depth, bool sizeOnly);
+		~Value()
+		{
+			Clear();
+		}
+
+		void Serialize(Writer& writer, int depth);
 		void Deserialize(DeserializeContext* ctx, TCHAR* keyName);
 
 		// Dynamic modification
@@ -183,26 +260,43 @@ public:
 
 		// Access
 
+		// Large objects are looked up by the hash of names, which is built by the first call (or by Deserialize).
+		// So the first lookup in an object made by Add* modifies it, like adding a member.
 		Value* ByName(const char* byName);
 		Value* ByType(const ValueType byType);
 	};
 
+	// Values of the document
+
+	Arena arena;
+
 	// Deserialized root
 
 	Value root;
 
 	// Api
 
+	Json()
+	{
+		root.arena = &arena;
+	}
+
 	~Json()
 	{
 		DestroyValue(&root);
 	}
 
-	// The process of serialization is that we recursively walk through all the values, passing in each "running" context 
-	// which has the pointer to the generated text and the current text size.
+	// The process of serialization is that we recursively walk through all the values, passing in the writer
+	// which sends the generated text to its sink.
 
+	void Serialize(Writer& writer);
+	void Serialize(std::vector<uint8_t>& text);
+	void Serialize(std::string& text);
+
+	// Old interface: size pass and the text to the buffer of the caller
 	void Serialize(void* text, size_t maxTextSize, size_t& actualTextSize);
 	void GetSerializedTextSize(void* text, size_t maxTextSize, size_t& actualTextSize);
+
 	void Deserialize(void* text, size_t textSize);
 
 	// Clone
@@ -0,0 +1,174 @@
+// LZ4 block format compression.
+
+#include "pch.h"
+
+namespace Lz4
+{
+	static const size_t MinMatch = 4;
+	static const size_t LastLiterals = 5;		// The block always ends with at least 5 literals
+	static const size_t MatchFindLimit = 12;	// The last match starts at least 12 bytes before the end
+	static const size_t MaxOffset = 0xffff;
+	static const size_t HashBits = 12;
+
+	static inline uint32_t Read32(const uint8_t* ptr)
+	{
+		uint32_t value;
+		memcpy(&value, ptr, sizeof(value));
+		return value;
+	}
+
+	static inline uint32_t Hash(uint32_t sequence)
+	{
+		return (sequence * 2654435761U) >> (32 - HashBits);
+	}
+
+	static inline uint8_t* WriteLength(uint8_t* op, size_t length)
+	{
+		while (length >= 255)
+		{
+			*op++ = 255;
+			length -= 255;
+		}
+		*op++ = (uint8_t)length;
+		return op;
+	}
+
+	static uint8_t* WriteSequence(uint8_t* op, const uint8_t* literals, size_t literalLength, size_t offset, size_t matchLength)
+	{
+		uint8_t* token = op++;
+		size_t matchCode = matchLength - MinMatch;
+
+		*token = (uint8_t)(((literalLength < 15 ? literalLength : 15) << 4) | (matchCode < 15 ? matchCode : 15));
+
+		if (literalLength >= 15)
+		{
+			op = WriteLength(op, literalLength - 15);
+		}
+		memcpy(op, literals, literalLength);
+		op += literalLength;
+
+		*op++ = (uint8_t)offset;
+		*op++ = (uint8_t)(offset >> 8);
+
+		if (matchCode >= 15)
+		{
+			op = WriteLength(op, matchCode - 15);
+		}
+		return op;
+	}
+
+	size_t Compress(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstCapacity)
+	{
+		if (dstCapacity < CompressBound(srcSize))
+		{
+			return 0;
+		}
+
+		uint32_t table[1 << HashBits] = { 0 };		// Position + 1, 0: empty
+		uint8_t* op = dst;
+		size_t ip = 0;
+		size_t anchor = 0;
+		size_t misses = 0;
+
+		while (ip + MatchFindLimit < srcSize)
+		{
+			uint32_t sequence = Read32(src + ip);
+			uint32_t h = Hash(sequence);
+			size_t ref = table[h];
+			table[h] = (uint32_t)ip + 1;
+
+			if (ref == 0 || ip - (ref - 1) > MaxOffset || Read32(src + ref - 1) != sequence)
+			{
+				ip += 1 + (misses++ >> 6);		// Go faster through incompressible data
+				continue;
+			}
+
+			size_t match = ref - 1;
+			size_t length = MinMatch;
+			while (ip + length < srcSize - LastLiterals && src[ip + length] == src[match + length])
+			{
+				length++;
+			}
+
+			op = WriteSequence(op, src + anchor, ip - anchor, ip - match, length);
+
+			ip += length;
+			anchor = ip;
+			misses = 0;
+		}
+
+		// Last literals
+
+		size_t literalLength = srcSize - anchor;
+		*op++ = (uint8_t)((literalLength < 15 ? literalLength : 15) << 4);
+		if (literalLength >= 15)
+		{
+			op = WriteLength(op, literalLength - 15);
+		}
+		memcpy(op, src + anchor, literalLength);
+		op += literalLength;
+
+		return op - dst;
+	}
+
+	static inline bool ReadLength(const uint8_t* src, size_t srcSize, size_t& ip, size_t& length)
+	{
+		uint8_t b;
+		do
+		{
+			if (ip >= srcSize)
+				return false;
+			b = src[ip++];
+			length += b;
+		} while (b == 255);
+		return true;
+	}
+
+	bool Decompress(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstSize)
+	{
+		size_t ip = 0;
+		size_t op = 0;
+
+		while (ip < srcSize)
+		{
+			uint8_t token = src[ip++];
+
+			size_t literalLength = token >> 4;
+			if (literalLength == 15 && !ReadLength(src, srcSize, ip, literalLength))
+				return false;
+			if (literalLength > srcSize - ip || literalLength > dstSize - op)
+				return false;
+
+			memcpy(dst + op, src + ip, literalLength);
+			ip += literalLength;
+			op += literalLength;
+
+			if (ip == srcSize)
+				break;		// The last sequence has no match
+
+			if (srcSize - ip < 2)
+				return false;
+			size_t offset = src[ip] | ((size_t)src[ip + 1] << 8);
+			ip += 2;
+			if (offset == 0 || offset > op)
+				return false;
+
+			size_t matchLength = token & 15;
+			if (matchLength == 15 && !ReadLength(src, srcSize, ip, matchLength))
+				return false;
+			matchLength += MinMatch;
+			if (matchLength > dstSize - op)
+				return false;
+
+			// The match may overlap the output (offset < length), so it is copied byte by byte
+			const uint8_t* match = dst + op - offset;
+			for (size_t i = 0; i < matchLength; i++)
+			{
+				dst[op + i] = match[i];
+			}
+			op += matchLength;
+		}
+
+		return op == dstSize;
+	}
+}
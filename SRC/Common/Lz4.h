@@ -0,0 +1,20 @@
+// LZ4 block format compression.
+
+// Compatible with the LZ4 block format (https://github.com/lz4/lz4/blob/dev/doc/lz4_Block_format.md), without the frame format.
+// Fast enough to compress the savestate pages on the fly. The decoder checks all bounds, so damaged data is rejected.
+
+#pragma once
+
+#include <cstdint>
+
+namespace Lz4
+{
+	// The maximum compressed size of the data (incompressible data grows a little)
+	inline size_t CompressBound(size_t size) { return size + size / 255 + 16; }
+
+	// Returns the compressed size, or 0 if the destination is smaller than CompressBound
+	size_t Compress(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstCapacity);
+
+	// Returns false if the data is damaged or does not decompress to exactly dstSize bytes
+	bool Decompress(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstSize);
+}
@@ -0,0 +1,208 @@
+// Performance counters.
+
+#include "pch.h"
+
+namespace Debug
+{
+	static const char* PerfCounterNames[] =
+	{
+		"GekkoInterpreterInstructions",
+		"GekkoCachedInstructions",
+		"GekkoJitcInstructions",
+		"GekkoCachedBlocks",
+		"GekkoCachedInvalidations",
+		"JitcCompiles",
+		"JitcCompileTime",
+		"JitcInvalidations",
+		"TlbHits",
+		"TlbMisses",
+
+		"MmioCP",
+		"MmioPE",
+		"MmioVI",
+		"MmioPI",
+		"MmioMI",
+		"MmioDSP",
+		"MmioDI",
+		"MmioSI",
+		"MmioEXI",
+		"MmioAI",
+		"MmioGX",
+		"MmioOther",
+
+		"FifoBytes",
+		"Vertices",
+		"TextureDecodes",
+		"TextureDecodeTime",
+
+		"DspInstructions",
+		"DvdBytes",
+		"AudioUnderruns",
+		"AudioOverflows",
+		"Snapshots",
+		"SnapshotTime",
+	};
+
+	static_assert(_countof(PerfCounterNames) == PerfCounterCount, "PerfCounterNames does not match PerfCounter");
+
+	thread_local PerfCounterBlock* PerfLocal = nullptr;
+
+	std::vector<PerfCounterBlock*> PerfCounters::blocks;
+	uint64_t PerfCounters::base[PerfCounterCount];
+	SpinLock PerfCounters::lock;
+
+	PerfCounterBlock* PerfRegisterThread()
+	{
+		PerfCounterBlock* block = new PerfCounterBlock;
+		for (size_t i = 0; i < PerfCounterCount; i++)
+		{
+			block->value[i] = 0;
+		}
+
+		PerfCounters::lock.Lock();
+		PerfCounters::blocks.push_back(block);
+		PerfCounters::lock.Unlock();
+
+		PerfLocal = block;
+		return block;
+	}
+
+	const char* PerfCounters::GetName(PerfCounter counter)
+	{
+		return (size_t)counter < PerfCounterCount ? PerfCounterNames[(size_t)counter] : "Unknown";
+	}
+
+	void PerfCounters::Snapshot(uint64_t values[PerfCounterCount])
+	{
+		lock.Lock();
+		for (size_t i = 0; i < PerfCounterCount; i++)
+		{
+			uint64_t total = 0;
+			for (auto block : blocks)
+			{
+				total += block->value[i].load(std::memory_order_relaxed);
+			}
+			values[i] = total - base[i];
+		}
+		lock.Unlock();
+	}
+
+	void PerfCounters::Reset()
+	{
+		uint64_t values[PerfCounterCount];
+
+		Snapshot(values);
+
+		lock.Lock();
+		for (size_t i = 0; i < PerfCounterCount; i++)
+		{
+			base[i] += values[i];
+		}
+		lock.Unlock();
+	}
+
+	Json::Value* PerfCounters::ToJson()
+	{
+		uint64_t values[PerfCounterCount];
+
+		Snapshot(values);
+
+		Json::Value* output = new Json::Value();
+		output->type = Json::ValueType::Object;
+
+		for (size_t i = 0; i < PerfCounterCount; i++)
+		{
+			output->AddUInt64(PerfCounterNames[i], values[i]);
+		}
+
+		return output;
+	}
+
+	#pragma region "CSV Dump"
+
+	PerfCsvDump::PerfCsvDump(const char* filename, int intervalMs)
+	{
+		fopen_s(&f, filename, "wt");
+		if (!f)
+		{
+			return;
+		}
+
+		periodMs = max(intervalMs, 1);
+
+		fprintf(f, "TimeMs");
+		for (size_t i = 0; i < PerfCounterCount; i++)
+		{
+			fprintf(f, ",%s", PerfCounterNames[i]);
+		}
+		fprintf(f, "\n");
+
+		PerfCounters::Snapshot(last);
+		started = std::chrono::steady_clock::now();
+
+		thread = new Thread(DumpThreadProc, false, this, "PerfCsvDump");
+	}
+
+	PerfCsvDump::~PerfCsvDump()
+	{
+		if (!f)
+		{
+			return;
+		}
+
+		// The thread finishes by itself, so it is never killed in the middle of a write.
+		stopRequested = true;
+		while (!stopped)
+		{
+			Sleep(1);
+		}
+		delete thread;
+
+		WriteRow();
+		fclose(f);
+	}
+
+	void PerfCsvDump::DumpThreadProc(void* param)
+	{
+		PerfCsvDump* dump = (PerfCsvDump*)param;
+
+		while (!dump->stopRequested)
+		{
+			// Wake up often enough to stop quickly with long periods
+			auto next = std::chrono::steady_clock::now() + std::chrono::milliseconds(dump->periodMs);
+			while (!dump->stopRequested && std::chrono::steady_clock::now() < next)
+			{
+				Sleep(min(dump->periodMs, 50));
+			}
+
+			if (!dump->stopRequested)
+			{
+				dump->WriteRow();
+			}
+		}
+
+		dump->stopped = true;
+	}
+
+	// Each row has the counter increments since the previous row.
+	void PerfCsvDump::WriteRow()
+	{
+		uint64_t values[PerfCounterCount];
+
+		PerfCounters::Snapshot(values);
+
+		auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - started).count();
+		fprintf(f, "%lld", (long long)ms);
+
+		for (size_t i = 0; i < PerfCounterCount; i++)
+		{
+			uint64_t delta = values[i] >= last[i] ? values[i] - last[i] : values[i];		// Reset meanwhile
+			fprintf(f, ",%llu", (unsigned long long)delta);
+			last[i] = values[i];
+		}
+		fprintf(f, "\n");
+		fflush(f);
+	}
+
+	#pragma endregion "CSV Dump"
+}
@@ -0,0 +1,146 @@
+// Performance counters.
+
+// Every thread that counts something gets its own block of counters, so counting is a plain add to thread-local memory,
+// without locks and without interlocked instructions. The blocks are summed up only when somebody asks for the totals.
+// Blocks are never freed: emulator threads may be killed by TerminateThread, and their counts still belong to the totals.
+// The description is in \Docs\EMU\PerfCounters.md
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+#include "Spinlock.h"
+#include "Thread.h"
+#include "Json.h"
+
+namespace Debug
+{
+	// When adding a counter, add its name to PerfCounterNames as well.
+
+	enum class PerfCounter : size_t
+	{
+		// Gekko
+		GekkoInterpreterInstructions = 0,
+		GekkoCachedInstructions,
+		GekkoJitcInstructions,
+		GekkoCachedBlocks,				// Blocks built by the cached interpreter
+		GekkoCachedInvalidations,
+		JitcCompiles,
+		JitcCompileTime,				// ns
+		JitcInvalidations,
+		TlbHits,
+		TlbMisses,
+
+		// MMIO accesses by device
+		MmioCP,
+		MmioPE,
+		MmioVI,
+		MmioPI,
+		MmioMI,
+		MmioDSP,
+		MmioDI,
+		MmioSI,
+		MmioEXI,
+		MmioAI,
+		MmioGX,
+		MmioOther,
+
+		// Graphics
+		FifoBytes,
+		Vertices,
+		TextureDecodes,
+		TextureDecodeTime,				// ns, including the upload
+
+		// Other
+		DspInstructions,
+		DvdBytes,
+		AudioUnderruns,
+		AudioOverflows,
+		Snapshots,
+		SnapshotTime,					// ns, the part paid by the emulation thread (without compression)
+
+		Max,
+	};
+
+	static const size_t PerfCounterCount = (size_t)PerfCounter::Max;
+
+	// The owner thread is the only writer. Atomics with relaxed order only keep the readers from seeing torn values.
+	struct PerfCounterBlock
+	{
+		std::atomic<uint64_t> value[PerfCounterCount];
+	};
+
+	extern thread_local PerfCounterBlock* PerfLocal;
+
+	PerfCounterBlock* PerfRegisterThread();
+
+	inline void PerfAdd(PerfCounter counter, uint64_t n = 1)
+	{
+		PerfCounterBlock* block = PerfLocal;
+		if (block == nullptr)
+		{
+			block = PerfRegisterThread();
+		}
+		std::atomic<uint64_t>& value = block->value[(size_t)counter];
+		value.store(value.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+	}
+
+	// Adds the lifetime of the object (ns) to the counter.
+	class PerfTimer
+	{
+		PerfCounter counter;
+		std::chrono::steady_clock::time_point start;
+
+	public:
+		PerfTimer(PerfCounter _counter) : counter(_counter), start(std::chrono::steady_clock::now()) {}
+		~PerfTimer()
+		{
+			auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+			PerfAdd(counter, (uint64_t)ns);
+		}
+	};
+
+	class PerfCounters
+	{
+		static std::vector<PerfCounterBlock*> blocks;
+		static uint64_t base[PerfCounterCount];			// Totals at the last Reset
+		static SpinLock lock;
+
+		friend PerfCounterBlock* PerfRegisterThread();
+
+	public:
+		static const char* GetName(PerfCounter counter);
+
+		// Totals of all threads since the last Reset.
+		static void Snapshot(uint64_t values[PerfCounterCount]);
+		static void Reset();
+
+		// Object { "CounterName": value, ... }
+		static Json::Value* ToJson();
+	};
+
+	// Appends a row of counter deltas to a CSV file at the specified interval (real time).
+	class PerfCsvDump
+	{
+		FILE* f = nullptr;
+		int periodMs = 1000;
+		uint64_t last[PerfCounterCount] = { 0 };
+		std::chrono::steady_clock::time_point started;
+
+		Thread* thread = nullptr;
+		std::atomic<bool> stopRequested = false;
+		std::atomic<bool> stopped = false;
+
+		static void DumpThreadProc(void* param);
+		void WriteRow();
+
+	public:
+		PerfCsvDump(const char* filename, int intervalMs);
+		~PerfCsvDump();		// Writes the last row and closes the file
+
+		bool IsOpen() { return f != nullptr; }
+	};
+}
@@ -0,0 +1,52 @@
+// Serialization of the emulator state (savestates).
+
+#include "pch.h"
+
+void StateStream::BeginSection(uint32_t id, uint32_t version)
+{
+	uint32_t length = 0;
+
+	if (mode == Mode::Save)
+	{
+		Do(id);
+		Do(version);
+		sections.push_back(data.size());
+		Do(length);		// Updated by EndSection
+	}
+	else
+	{
+		uint32_t savedId = 0, savedVersion = 0;
+
+		Do(savedId);
+		Do(savedVersion);
+		Do(length);
+
+		if (savedId != id || savedVersion != version || length > data.size() - pos)
+		{
+			failed = true;
+		}
+		sections.push_back(pos + length);
+	}
+}
+
+void StateStream::EndSection()
+{
+	if (sections.empty())
+	{
+		failed = true;
+		return;
+	}
+
+	size_t mark = sections.back();
+	sections.pop_back();
+
+	if (mode == Mode::Save)
+	{
+		uint32_t length = (uint32_t)(data.size() - mark - sizeof(uint32_t));
+		memcpy(data.data() + mark, &length, sizeof(length));
+	}
+	else if (pos != mark)
+	{
+		failed = true;		// The section was saved by a different layout
+	}
+}
@@ -0,0 +1,128 @@
+// Serialization of the emulator state (savestates).
+
+// Each component saves and loads its state with the same DoState(StateStream&) function, so the two directions cannot diverge.
+// The state of a component is put in a section (id + length), so that a stream from another build is rejected instead of being misread.
+// Only the emulated state is saved: pointers, threads, host handles and debug settings stay as they are.
+// The description is in \Docs\EMU\SaveStates.md
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <intrin.h>
+#include <vector>
+
+class StateStream
+{
+public:
+	enum class Mode
+	{
+		Save = 0,
+		Load,
+	};
+
+private:
+	Mode mode;
+	std::vector<uint8_t>& data;
+	size_t pos = 0;
+	bool failed = false;
+
+	std::vector<size_t> sections;		// Save: offset of the length field, Load: end of the section
+
+public:
+	StateStream(std::vector<uint8_t>& buffer, Mode _mode) : mode(_mode), data(buffer) {}
+
+	bool IsSaving() { return mode == Mode::Save; }
+	bool IsLoading() { return mode == Mode::Load; }
+
+	// The stream is broken (not enough data or a section mismatch). Further loads do not change anything.
+	bool Failed() { return failed; }
+
+	void Do(void* ptr, size_t size)
+	{
+		if (mode == Mode::Save)
+		{
+			data.insert(data.end(), (uint8_t*)ptr, (uint8_t*)ptr + size);
+		}
+		else
+		{
+			if (failed || pos + size > data.size())
+			{
+				failed = true;
+				return;
+			}
+			memcpy(ptr, data.data() + pos, size);
+			pos += size;
+		}
+	}
+
+	// Plain values and structures without pointers
+	template <typename T>
+	void Do(T& value)
+	{
+		Do((void*)&value, sizeof(T));
+	}
+
+	template <typename T>
+	void Do(std::vector<T>& vec)
+	{
+		uint32_t count = (uint32_t)vec.size();
+		Do(count);
+		if (mode == Mode::Load)
+		{
+			if (failed || (size_t)count * sizeof(T) > data.size() - pos)
+			{
+				failed = true;
+				return;
+			}
+			vec.resize(count);
+		}
+		if (count != 0)
+		{
+			Do(vec.data(), count * sizeof(T));
+		}
+	}
+
+	// The section id is a FourCC, for example 'GEKK'. The version is changed together with the layout of the section.
+	void BeginSection(uint32_t id, uint32_t version);
+	void EndSection();
+};
+
+// Tracks which 4 KB pages of a memory were written since the last snapshot.
+// One byte per page, so marking is a plain store.
+class DirtyPages
+{
+	std::vector<uint8_t> pages;
+
+public:
+	static const size_t PageShift = 12;
+	static const size_t PageSize = (size_t)1 << PageShift;
+
+	void Resize(size_t memorySize) { pages.assign((memorySize + PageSize - 1) >> PageShift, 1); }
+	size_t Count() { return pages.size(); }
+
+	void Mark(size_t offset)
+	{
+		if ((offset >> PageShift) < pages.size())
+			pages[offset >> PageShift] = 1;
+	}
+
+	void Mark(size_t offset, size_t size)
+	{
+		if (size == 0)
+			return;
+		size_t last = (offset + size - 1) >> PageShift;
+		for (size_t page = offset >> PageShift; page <= last && page < pages.size(); page++)
+		{
+			pages[page] = 1;
+		}
+	}
+
+	bool IsDirty(size_t page) { return pages[page] != 0; }
+
+	// Clear the flag before the page is copied: a write during the copy marks it again, and the next snapshot takes it.
+	bool TestAndClear(size_t page) { return _InterlockedExchange8((volatile char*)&pages[page], 0) != 0; }
+	void Clear() { std::fill(pages.begin(), pages.end(), 0); }
+	void SetAll() { std::fill(pages.begin(), pages.end(), 1); }
+};
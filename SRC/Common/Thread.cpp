@@ -4,6 +4,8 @@ DWORD WINAPI Thread::RingleaderThreadProc(LPVOID lpParameter)
 {
 	WrappedContext* wrappedCtx = (WrappedContext*)lpParameter;
 
+	Instance::Current = wrappedCtx->instance;
+
 	if (wrappedCtx->proc)
 	{
 		wrappedCtx->proc(wrappedCtx->context);
@@ -15,11 +17,13 @@ DWORD WINAPI Thread::RingleaderThreadProc(LPVOID lpParameter)
 Thread::Thread(ThreadProc threadProc, bool suspended, void* context, const char* name)
 {
 	running = !suspended;
+	osSuspended = suspended;
 	strcpy_s(threadName, sizeof(threadName) - 1, name);
 
 #ifdef _WINDOWS
 	ctx.context = context;
 	ctx.proc = threadProc;
+	ctx.instance = Instance::Current;
 	threadHandle = CreateThread(NULL, StackSize, RingleaderThreadProc, &ctx, suspended ? CREATE_SUSPENDED : 0, &threadId);
 	assert(threadHandle != INVALID_HANDLE_VALUE);
 #endif
@@ -29,9 +33,10 @@ Thread::Thread(ThreadProc threadProc, bool suspended, void* context, const char*
 
 Thread::~Thread()
 {
-	Suspend();
+	running = false;
 
 #ifdef _WINDOWS
+	SuspendThread(threadHandle);
 	TerminateThread(threadHandle, 0);
 	WaitForSingleObject(threadHandle, 1000);
 #endif
@@ -39,14 +44,30 @@ Thread::~Thread()
 	DBReport("~Thread: %s\n", threadName);
 }
 
+void Thread::Join()
+{
+#ifdef _WINDOWS
+	WaitForSingleObject(threadHandle, INFINITE);
+#endif
+}
+
 void Thread::Resume()
 {
 	resumeLock.Lock();
 	if (!running)
 	{
+		if (stopRequested)
+		{
+			// The thread leaves its park point by itself
+			stopRequested = false;
+		}
+		else
+		{
+			osSuspended = false;
 #ifdef _WINDOWS
-		ResumeThread(threadHandle);
+			ResumeThread(threadHandle);
 #endif
+		}
 		running = true;
 		resumeCounter++;
 		//DBReport("%s Resume\n", threadName);
@@ -56,13 +77,116 @@ void Thread::Resume()
 
 void Thread::Suspend()
 {
-	if (running)
+	bool self = IsCurrent();
+
+	resumeLock.Lock();
+	if (!running)
+	{
+		resumeLock.Unlock();
+		return;
+	}
+	running = false;
+	suspendCounter++;
+	//DBReport("%s Suspend\n", threadName);
+	if (self && !parkOnSuspend)
+	{
+		osSuspended = true;
+	}
+	else
+	{
+		stopRequested = true;
+	}
+	resumeLock.Unlock();
+
+	if (self)
 	{
-		running = false;
-		suspendCounter++;
-		//DBReport("%s Suspend\n", threadName);
+		if (!parkOnSuspend)
+		{
 #ifdef _WINDOWS
-		SuspendThread(threadHandle);
+			SuspendThread(threadHandle);
 #endif
+		}
+		return;
+	}
+
+	// Do not return while the thread is in the middle of its update. The wait ends also if another caller has resumed it.
+	while (stopRequested && !stopped)
+	{
+		Sleep(0);
+	}
+}
+
+bool Thread::IsCurrent()
+{
+#ifdef _WINDOWS
+	return GetCurrentThreadId() == threadId;
+#else
+	return false;
+#endif
+}
+
+void Thread::StartParked()
+{
+	resumeLock.Lock();
+	if (!running && osSuspended)
+	{
+		parkOnSuspend = true;
+		stopRequested = true;
+		osSuspended = false;
+#ifdef _WINDOWS
+		ResumeThread(threadHandle);
+#endif
+	}
+	resumeLock.Unlock();
+}
+
+void Thread::Park()
+{
+	parkRequests++;
+	uint64_t epoch = ++parkEpoch;
+
+	// The thread parks itself when it gets back to its loop
+	if (IsCurrent())
+		return;
+
+	// A thread suspended by itself is at a point of its own choice, a thread stopped by Suspend confirms the park from its park point
+	while (parkedEpoch < epoch && !osSuspended)
+	{
+		Sleep(0);
+	}
+}
+
+void Thread::Unpark()
+{
+	parkRequests--;
+}
+
+bool Thread::Parked()
+{
+	// Cleared before the requests are read, so Suspend cannot see a stale confirmation while the thread leaves
+	stopped = false;
+	uint64_t epoch = parkEpoch;
+	bool stop = stopRequested;
+	if (parkRequests == 0 && !stop)
+	{
+		stopped = false;
+		return false;
+	}
+	parkedEpoch = epoch;
+	stopped = stop;
+	return true;
+}
+
+// A stopped thread may wait for long (debugger), a park is short (savestates)
+void Thread::ParkSleep()
+{
+	Sleep(stopRequested ? 1 : 0);
+}
+
+void Thread::ParkWait()
+{
+	while (Parked())
+	{
+		ParkSleep();
 	}
 }
@@ -6,7 +6,9 @@
 #include <Windows.h>
 #endif
 
+#include <atomic>
 #include "Spinlock.h"
+#include "Instance.h"
 #include "../Debugger/Debugger.h"
 
 typedef void (*ThreadProc)(void* param);
@@ -17,6 +19,7 @@ class Thread
 	{
 		ThreadProc proc;
 		void* context;
+		Instance* instance;		// The thread belongs to the instance of the thread that created it
 	};
 
 	WrappedContext ctx = { 0 };
@@ -26,6 +29,19 @@ class Thread
 	int resumeCounter = 0;
 	int suspendCounter = 0;
 
+	// Suspend from another thread is cooperative: the thread stops at its park point and waits there until resumed.
+	// A thread that suspends itself is suspended by the OS at that point (or was never started), then it is also at a point of its own choice.
+	std::atomic<bool> stopRequested = false;
+	std::atomic<bool> stopped = false;
+	std::atomic<bool> osSuspended = false;
+	bool parkOnSuspend = false;			// Suspend from the thread itself is cooperative too (StartParked)
+
+	// Park requests can overlap (the debugger and the rewind buffer), the thread waits until all are released.
+	// Each request gets a new epoch, the thread confirms it from inside the wait loop.
+	std::atomic<int> parkRequests = 0;
+	std::atomic<uint64_t> parkEpoch = 0;
+	std::atomic<uint64_t> parkedEpoch = 0;
+
 	char threadName[0x100] = { 0 };
 
 #ifdef _WINDOWS
@@ -42,7 +58,39 @@ public:
 	// Join thread
 	~Thread();
 
+	// Wait until the thread procedure returns. The destructor terminates a thread that is still running, so workers are joined first.
+	void Join();
+
 	void Resume();
+	// From another thread waits until the thread is stopped at its park point
 	void Suspend();
 	bool IsRunning() { return running; }
+	bool IsCurrent();
+
+	// Start a thread created suspended, but keep it stopped at its first park point. Such thread never gets suspended by the OS,
+	// it keeps serving requests while stopped (see Parked).
+	void StartParked();
+
+	// Cooperative stop at a point where the state of the thread owner is consistent (savestates).
+	// The thread procedure calls ParkPoint between its updates. Park waits until the thread is there or suspended by itself, it does nothing on the thread itself.
+	void Park();
+	void Unpark();
+	void ParkPoint()
+	{
+		if (ParkPending())
+		{
+			ParkWait();
+		}
+	}
+
+	// For the loops that do something while parked: Parked confirms the park and returns true while the thread must stay there.
+	bool ParkPending()
+	{
+		return parkRequests.load(std::memory_order_relaxed) != 0 || stopRequested.load(std::memory_order_relaxed);
+	}
+	bool Parked();
+	void ParkSleep();
+
+private:
+	void ParkWait();
 };
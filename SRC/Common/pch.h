@@ -7,7 +7,11 @@
 #include <shlobj.h>
 
 #include "Spinlock.h"
+#include "Instance.h"
 #include "Thread.h"
 #include "Json.h"
 #include "Jdi.h"
+#include "PerfCounters.h"
+#include "StateStream.h"
+#include "Lz4.h"
 #include "WinAPI.h"
@@ -0,0 +1,102 @@
+// Fast lookup of breakpoints and memory watches.
+
+// The effective address space is covered by a two-level bitmap: one bit per 4 KB page says there is something on the page,
+// then one bit per word of that page. Pages completely covered by a range watch are marked in a separate bitmap and do not need the second level.
+// The bitmaps are rebuilt under the lock when the set changes and are read without the lock.
+// Each rebuild makes a new table and publishes it. The replaced table may still be read by the emulation thread, it is freed by Reclaim on the Gekko thread, at the top of its loop (safe point).
+// A bitmap hit is confirmed against the exact list of ranges, so the second level may be coarse when the page slots run out.
+
+#pragma once
+
+#include <atomic>
+#include <vector>
+
+namespace Gekko
+{
+	class BreakpointMap
+	{
+		struct Range
+		{
+			uint32_t start;
+			uint32_t size;
+		};
+
+		std::vector<Range> ranges;
+		SpinLock lock;
+
+		static const size_t pageShift = 12;
+		static const size_t numPages = (size_t)1 << (32 - pageShift);
+		static const size_t wordsPerPage = ((size_t)1 << pageShift) / 4;
+		static const size_t numSlots = 256;
+		static const uint32_t emptySlot = 0xffffffff;
+
+		struct PageSlot
+		{
+			uint32_t page;
+			uint64_t words[wordsPerPage / 64];
+		};
+
+		struct Table
+		{
+			uint64_t anyPage[numPages / 64];		// Page has something
+			uint64_t fullPage[numPages / 64];		// Whole page is covered (or did not fit in slots)
+			PageSlot slots[numSlots];			// Word bits, open addressing by page number
+		};
+
+		std::atomic<Table*> current = nullptr;
+		std::vector<Table*> retired;		// Replaced tables, waiting for Reclaim
+
+		static size_t SlotIndex(uint32_t page) { return (page * 0x9E3779B1) >> 24; }
+		static void MarkWords(Table* table, uint32_t page, size_t firstWord, size_t lastWord);
+		void Rebuild();
+
+		bool TestBitmap(uint32_t addr)
+		{
+			Table* table = current.load(std::memory_order_acquire);
+			if (table == nullptr)
+				return false;
+
+			uint32_t page = addr >> pageShift;
+			uint64_t bit = 1ULL << (page & 63);
+			if ((table->anyPage[page >> 6] & bit) == 0)
+				return false;
+			if (table->fullPage[page >> 6] & bit)
+				return true;
+
+			size_t word = (addr >> 2) & (wordsPerPage - 1);
+			for (size_t i = SlotIndex(page), n = 0; n < numSlots; i = (i + 1) & (numSlots - 1), n++)
+			{
+				if (table->slots[i].page == page)
+					return (table->slots[i].words[word >> 6] >> (word & 63)) & 1;
+				if (table->slots[i].page == emptySlot)
+					break;
+			}
+			return false;
+		}
+
+	public:
+		BreakpointMap() {}
+		~BreakpointMap();
+
+		// Returns false if a range with the same start already exists.
+		bool Add(uint32_t addr, uint32_t size = 1);
+		// Remove the range starting at the address. Returns false if there was none.
+		bool Remove(uint32_t addr);
+		void Clear();
+		bool Empty();
+
+		// Free the replaced tables. Call it only on the emulation thread, outside of Test (at the Gekko safe point).
+		void Reclaim();
+
+		// Exact check, under the lock
+		bool Exists(uint32_t addr);
+
+		// Fast path for the emulation thread
+		bool Test(uint32_t addr)
+		{
+			if (!TestBitmap(addr))
+				return false;
+			return Exists(addr);
+		}
+	};
+}
@@ -9,79 +9,246 @@
 
 namespace Gekko
 {
-    void GekkoCore::AddBreakpoint(uint32_t addr)
+    BreakpointMap::~BreakpointMap()
     {
-        breakPointsLock.Lock();
-        bool exists = false;
-        for (auto it = breakPointsExecute.begin(); it != breakPointsExecute.end(); ++it)
+        delete current.load();
+        Reclaim();
+    }
+
+    void BreakpointMap::MarkWords(Table* table, uint32_t page, size_t firstWord, size_t lastWord)
+    {
+        for (size_t i = SlotIndex(page), n = 0; n < numSlots; i = (i + 1) & (numSlots - 1), n++)
         {
-            if (*it == addr)
+            PageSlot* slot = &table->slots[i];
+            if (slot->page == emptySlot)
             {
-                exists = true;
+                slot->page = page;
+            }
+            if (slot->page == page)
+            {
+                for (size_t word = firstWord; word <= lastWord; word++)
+                {
+                    slot->words[word >> 6] |= 1ULL << (word & 63);
+                }
+                return;
+            }
+        }
+
+        // No free slots. Mark the whole page, the exact check will sort it out.
+        table->fullPage[page >> 6] |= 1ULL << (page & 63);
+    }
+
+    // Must be called under the lock
+    void BreakpointMap::Rebuild()
+    {
+        // The old table is not reused, a reader may still hold it
+        Table* old = current.load(std::memory_order_relaxed);
+        if (old != nullptr)
+        {
+            retired.push_back(old);
+        }
+
+        if (ranges.empty())
+        {
+            current.store(nullptr, std::memory_order_release);
+            return;
+        }
+
+        Table* table = new Table;
+        assert(table);
+
+        memset(table->anyPage, 0, sizeof(table->anyPage));
+        memset(table->fullPage, 0, sizeof(table->fullPage));
+        memset(table->slots, 0, sizeof(table->slots));
+        for (size_t i = 0; i < numSlots; i++)
+        {
+            table->slots[i].page = emptySlot;
+        }
+
+        for (auto it = ranges.begin(); it != ranges.end(); ++it)
+        {
+            uint64_t start = it->start;
+            uint64_t end = start + it->size;
+            if (end > 0x100000000)
+            {
+                end = 0x100000000;
+            }
+
+            for (uint64_t page = start >> pageShift; page <= ((end - 1) >> pageShift); page++)
+            {
+                uint64_t pageStart = page << pageShift;
+                uint64_t pageEnd = pageStart + ((uint64_t)1 << pageShift);
+
+                table->anyPage[page >> 6] |= 1ULL << (page & 63);
+
+                if (start <= pageStart && end >= pageEnd)
+                {
+                    table->fullPage[page >> 6] |= 1ULL << (page & 63);
+                }
+                else
+                {
+                    uint64_t first = (start > pageStart ? start : pageStart) - pageStart;
+                    uint64_t last = (end < pageEnd ? end : pageEnd) - 1 - pageStart;
+                    MarkWords(table, (uint32_t)page, (size_t)(first >> 2), (size_t)(last >> 2));
+                }
+            }
+        }
+
+        current.store(table, std::memory_order_release);
+    }
+
+    bool BreakpointMap::Add(uint32_t addr, uint32_t size)
+    {
+        if (size == 0)
+            size = 1;
+
+        lock.Lock();
+        for (auto it = ranges.begin(); it != ranges.end(); ++it)
+        {
+            if (it->start == addr)
+            {
+                lock.Unlock();
+                return false;
+            }
+        }
+        ranges.push_back({ addr, size });
+        Rebuild();
+        lock.Unlock();
+        return true;
+    }
+
+    bool BreakpointMap::Remove(uint32_t addr)
+    {
+        bool removed = false;
+        lock.Lock();
+        for (auto it = ranges.begin(); it != ranges.end(); ++it)
+        {
+            if (it->start == addr)
+            {
+                ranges.erase(it);
+                removed = true;
                 break;
             }
         }
-        if (!exists)
+        if (removed)
         {
-            DBReport2(DbgChannel::CPU, "Breakpoint added: 0x%08X\n", addr);
-            breakPointsExecute.push_back(addr);
-            jitc->Invalidate(addr, 4);
-            EnableTestBreakpoints = true;
+            Rebuild();
         }
-        breakPointsLock.Unlock();
+        lock.Unlock();
+        return removed;
     }
 
-    void GekkoCore::RemoveBreakpoint(uint32_t addr)
+    void BreakpointMap::Clear()
+    {
+        lock.Lock();
+        ranges.clear();
+        Rebuild();
+        lock.Unlock();
+    }
+
+    bool BreakpointMap::Empty()
+    {
+        lock.Lock();
+        bool empty = ranges.empty();
+        lock.Unlock();
+        return empty;
+    }
+
+    void BreakpointMap::Reclaim()
+    {
+        std::vector<Table*> tables;
+
+        lock.Lock();
+        tables.swap(retired);
+        lock.Unlock();
+
+        for (auto it = tables.begin(); it != tables.end(); ++it)
+        {
+            delete *it;
+        }
+    }
+
+    bool BreakpointMap::Exists(uint32_t addr)
     {
-        breakPointsLock.Lock();
         bool exists = false;
-        for (auto it = breakPointsExecute.begin(); it != breakPointsExecute.end(); ++it)
+        lock.Lock();
+        for (auto it = ranges.begin(); it != ranges.end(); ++it)
         {
-            if (*it == addr)
+            if ((addr - it->start) < it->size)
             {
                 exists = true;
                 break;
             }
         }
-        if (exists)
+        lock.Unlock();
+        return exists;
+    }
+
+    void GekkoCore::ReclaimBreakpointsCallback(void* context)
+    {
+        GekkoCore* core = (GekkoCore*)context;
+        assert(core->gekkoThread->IsCurrent());
+        core->breakPointsExecute.Reclaim();
+        core->breakPointsRead.Reclaim();
+        core->breakPointsWrite.Reclaim();
+    }
+
+    void GekkoCore::ReclaimBreakpoints()
+    {
+        if (!gekkoThread->IsCurrent())
+        {
+            RunAtSafePoint(ReclaimBreakpointsCallback, this);
+        }
+    }
+
+    void GekkoCore::AddBreakpoint(uint32_t addr)
+    {
+        if (breakPointsExecute.Add(addr))
+        {
+            DBReport2(DbgChannel::CPU, "Breakpoint added: 0x%08X\n", addr);
+            jitc->Invalidate(addr, 4);
+            EnableTestBreakpoints = true;
+            ReclaimBreakpoints();
+        }
+    }
+
+    void GekkoCore::RemoveBreakpoint(uint32_t addr)
+    {
+        if (breakPointsExecute.Remove(addr))
         {
             DBReport2(DbgChannel::CPU, "Breakpoint removed: 0x%08X\n", addr);
-            breakPointsExecute.remove(addr);
             jitc->Invalidate(addr, 4);
+            ReclaimBreakpoints();
         }
-        if (breakPointsExecute.size() == 0)
+        if (breakPointsExecute.Empty())
         {
             EnableTestBreakpoints = false;
         }
-        breakPointsLock.Unlock();
     }
 
-    void GekkoCore::AddReadBreak(uint32_t addr)
+    void GekkoCore::AddReadBreak(uint32_t addr, uint32_t size)
     {
-        breakPointsLock.Lock();
-        breakPointsRead.push_back(addr);
-        breakPointsLock.Unlock();
+        breakPointsRead.Add(addr, size);
         EnableTestReadBreakpoints = true;
+        ReclaimBreakpoints();
     }
 
-    void GekkoCore::AddWriteBreak(uint32_t addr)
+    void GekkoCore::AddWriteBreak(uint32_t addr, uint32_t size)
     {
-        breakPointsLock.Lock();
-        breakPointsWrite.push_back(addr);
-        breakPointsLock.Unlock();
+        breakPointsWrite.Add(addr, size);
         EnableTestWriteBreakpoints = true;
+        ReclaimBreakpoints();
     }
 
     void GekkoCore::ClearBreakpoints()
     {
-        breakPointsLock.Lock();
-        breakPointsExecute.clear();
-        breakPointsRead.clear();
-        breakPointsWrite.clear();
-        breakPointsLock.Unlock();
+        breakPointsExecute.Clear();
+        breakPointsRead.Clear();
+        breakPointsWrite.Clear();
         EnableTestBreakpoints = false;
         EnableTestReadBreakpoints = false;
         EnableTestWriteBreakpoints = false;
+        ReclaimBreakpoints();
     }
 
     bool GekkoCore::TestBreakpointForJitc(uint32_t addr)
@@ -95,20 +262,7 @@ namespace Gekko
             return true;
         }
 
-        bool exists = false;
-
-        breakPointsLock.Lock();
-        for (auto it = breakPointsExecute.begin(); it != breakPointsExecute.end(); ++it)
-        {
-            if (*it == addr)
-            {
-                exists = true;
-                break;
-            }
-        }
-        breakPointsLock.Unlock();
-
-        return exists;
+        return breakPointsExecute.Test(addr);
     }
 
     void GekkoCore::TestBreakpoints()
@@ -122,22 +276,9 @@ namespace Gekko
             DBHalt("One shot breakpoint\n");
         }
 
-        uint32_t addr = BadAddress;
-
-        breakPointsLock.Lock();
-        for (auto it = breakPointsExecute.begin(); it != breakPointsExecute.end(); ++it)
-        {
-            if (*it == regs.pc)
-            {
-                addr = *it;
-                break;
-            }
-        }
-        breakPointsLock.Unlock();
-
-        if (addr != BadAddress)
+        if (breakPointsExecute.Test(regs.pc))
         {
-            DBHalt("Gekko suspended at addr: 0x%08X\n", addr);
+            DBHalt("Gekko suspended at addr: 0x%08X\n", regs.pc);
         }
     }
 
@@ -146,22 +287,9 @@ namespace Gekko
         if (!EnableTestReadBreakpoints)
             return;
 
-        uint32_t addr = BadAddress;
-
-        breakPointsLock.Lock();
-        for (auto it = breakPointsRead.begin(); it != breakPointsRead.end(); ++it)
-        {
-            if (*it == accessAddress)
-            {
-                addr = *it;
-                break;
-            }
-        }
-        breakPointsLock.Unlock();
-
-        if (addr != BadAddress)
+        if (breakPointsRead.Test(accessAddress))
         {
-            DBHalt("Gekko suspended trying to read: 0x%08X\n", addr);
+            DBHalt("Gekko suspended trying to read: 0x%08X\n", accessAddress);
         }
     }
 
@@ -170,22 +298,9 @@ namespace Gekko
         if (!EnableTestWriteBreakpoints)
             return;
 
-        uint32_t addr = BadAddress;
-
-        breakPointsLock.Lock();
-        for (auto it = breakPointsWrite.begin(); it != breakPointsWrite.end(); ++it)
-        {
-            if (*it == accessAddress)
-            {
-                addr = *it;
-                break;
-            }
-        }
-        breakPointsLock.Unlock();
-
-        if (addr != BadAddress)
+        if (breakPointsWrite.Test(accessAddress))
         {
-            DBHalt("Gekko suspended trying to write: 0x%08X\n", addr);
+            DBHalt("Gekko suspended trying to write: 0x%08X\n", accessAddress);
         }
     }
 
@@ -204,17 +319,6 @@ namespace Gekko
 
     bool GekkoCore::IsBreakpoint(uint32_t addr)
     {
-        bool exists = false;
-        breakPointsLock.Lock();
-        for (auto it = breakPointsExecute.begin(); it != breakPointsExecute.end(); ++it)
-        {
-            if (*it == addr)
-            {
-                exists = true;
-                break;
-            }
-        }
-        breakPointsLock.Unlock();
-        return exists;
+        return breakPointsExecute.Exists(addr);
     }
 }
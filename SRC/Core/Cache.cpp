@@ -5,6 +5,7 @@
 // Emulation of access to the cache is simple - a copy is created for the main memory, same size as the main RAM.
 // If cached access is performed, all reads and writes are made from this buffer, otherwise from RAM.
 // Invalidation causes new data to be loaded from RAM into the cache buffer.
+// The copy is allocated in 4 KB pages, only for the pages that are actually accessed through the cache.
 
 // We do not support scattering for a locked cache and assume that it is locked as a fixed chunk.
 
@@ -14,13 +15,14 @@ namespace Gekko
 {
 	Cache::Cache()
 	{
-		cacheData = new uint8_t[cacheSize];
-		assert(cacheData);
+		cachePages = new uint8_t * [shadowPages];
+		assert(cachePages);
+		memset(cachePages, 0, shadowPages * sizeof(uint8_t*));
 
-		modifiedBlocks = new bool[cacheSize >> 5];
+		modifiedBlocks = new uint64_t[blockWords];
 		assert(modifiedBlocks);
 
-		invalidBlocks = new bool[cacheSize >> 5];
+		invalidBlocks = new uint64_t[blockWords];
 		assert(invalidBlocks);
 
 		LockedCache = new uint8_t[16 * 1024];
@@ -31,7 +33,8 @@ namespace Gekko
 
 	Cache::~Cache()
 	{
-		delete[] cacheData;
+		FreeShadow();
+		delete[] cachePages;
 		delete[] modifiedBlocks;
 		delete[] invalidBlocks;
 	}
@@ -40,10 +43,124 @@ namespace Gekko
 	{
 		DBReport2(DbgChannel::CPU, "Cache::Reset\n");
 
-		for (size_t i = 0; i < (cacheSize >> 5); i++)
+		memset(modifiedBlocks, 0, blockWords * sizeof(uint64_t));
+		memset(invalidBlocks, 0xff, blockWords * sizeof(uint64_t));
+
+		// All blocks are invalid now, the shadow will be casted-in again
+		FreeShadow();
+	}
+
+	// Only the allocated shadow pages are saved. Without them all the blocks are in the reset state.
+	void Cache::DoState(StateStream& state)
+	{
+		uint32_t pages = (uint32_t)cachePagesAllocated;
+
+		state.BeginSection('CACH', 1);
+		state.Do(enabled);
+		state.Do(frozen);
+		state.Do(lcenabled);
+		state.Do(LockedCacheAddr);
+		state.Do(LockedCache, 16 * 1024);
+		state.Do(pages);
+
+		if (state.IsLoading())
+		{
+			Reset();
+		}
+
+		if (pages != 0)
+		{
+			state.Do(modifiedBlocks, blockWords * sizeof(uint64_t));
+			state.Do(invalidBlocks, blockWords * sizeof(uint64_t));
+
+			if (state.IsSaving())
+			{
+				for (uint32_t i = 0; i < shadowPages; i++)
+				{
+					if (cachePages[i])
+					{
+						state.Do(i);
+						state.Do(cachePages[i], shadowPageSize);
+					}
+				}
+			}
+			else
+			{
+				for (uint32_t n = 0; n < pages && !state.Failed(); n++)
+				{
+					uint32_t index = 0;
+					state.Do(index);
+					if (state.Failed() || index >= shadowPages)
+						break;		// The section length check fails the stream
+					state.Do(ShadowPtr(index << shadowPageShift), shadowPageSize);
+				}
+			}
+		}
+
+		state.EndSection();
+	}
+
+	void Cache::FreeShadow()
+	{
+		for (size_t i = 0; i < shadowPages; i++)
+		{
+			if (cachePages[i])
+			{
+				delete[] cachePages[i];
+				cachePages[i] = nullptr;
+			}
+		}
+		cachePagesAllocated = 0;
+	}
+
+	uint8_t* Cache::ShadowPtr(uint32_t pa)
+	{
+		uint8_t*& page = cachePages[pa >> shadowPageShift];
+		if (page == nullptr)
+		{
+			page = new uint8_t[shadowPageSize];
+			assert(page);
+			memset(page, 0, shadowPageSize);
+			cachePagesAllocated++;
+		}
+		return &page[pa & (shadowPageSize - 1)];
+	}
+
+	// Unaligned accesses can cross the shadow page boundary, then they are made byte by byte.
+
+	template <typename T>
+	T Cache::ReadShadow(uint32_t pa)
+	{
+		T value;
+		if ((pa & (shadowPageSize - 1)) + sizeof(T) <= shadowPageSize)
+		{
+			value = *(T*)ShadowPtr(pa);
+		}
+		else
+		{
+			uint8_t* ptr = (uint8_t*)&value;
+			for (size_t i = 0; i < sizeof(T); i++)
+			{
+				ptr[i] = *ShadowPtr(pa + (uint32_t)i);
+			}
+		}
+		return value;
+	}
+
+	template <typename T>
+	void Cache::WriteShadow(uint32_t pa, T value)
+	{
+		if ((pa & (shadowPageSize - 1)) + sizeof(T) <= shadowPageSize)
 		{
-			modifiedBlocks[i] = false;
-			invalidBlocks[i] = true;
+			*(T*)ShadowPtr(pa) = value;
+		}
+		else
+		{
+			uint8_t* ptr = (uint8_t*)&value;
+			for (size_t i = 0; i < sizeof(T); i++)
+			{
+				*ShadowPtr(pa + (uint32_t)i) = ptr[i];
+			}
 		}
 	}
 
@@ -82,20 +199,15 @@ namespace Gekko
 		}
 	}
 
-	bool Cache::IsDirty(uint32_t pa)
-	{
-		size_t blockNum = pa >> 5;
-		return modifiedBlocks[blockNum];
-	}
-
 	void Cache::SetDirty(uint32_t pa, bool dirty)
 	{
 		size_t blockNum = pa >> 5;
+		uint64_t mask = 1ULL << (blockNum & 63);
 
-		if (dirty == modifiedBlocks[blockNum])
+		if (dirty == IsDirty(pa))
 			return;
 
-		modifiedBlocks[blockNum] = dirty;
+		modifiedBlocks[blockNum >> 6] ^= mask;
 
 		if (log >= CacheLogLevel::MemOps && dirty)
 		{
@@ -103,20 +215,15 @@ namespace Gekko
 		}
 	}
 
-	bool Cache::IsInvalid(uint32_t pa)
-	{
-		size_t blockNum = pa >> 5;
-		return invalidBlocks[blockNum];
-	}
-
 	void Cache::SetInvalid(uint32_t pa, bool invalid)
 	{
 		size_t blockNum = pa >> 5;
+		uint64_t mask = 1ULL << (blockNum & 63);
 
-		if (invalid == invalidBlocks[blockNum])
+		if (invalid == IsInvalid(pa))
 			return;
 
-		invalidBlocks[blockNum] = invalid;
+		invalidBlocks[blockNum >> 6] ^= mask;
 
 		if (log >= CacheLogLevel::MemOps && invalid)
 		{
@@ -207,7 +314,7 @@ namespace Gekko
 		if (pa >= cacheSize)
 			return;
 
-		memset(&cacheData[pa & ~0x1f], 0, 32);
+		memset(ShadowPtr(pa & ~0x1f), 0, 32);
 		SetDirty(pa, true);
 		SetInvalid(pa, false);
 
@@ -241,7 +348,7 @@ namespace Gekko
 			DBReport2(DbgChannel::CPU, "Cache::CastIn: 0x%08X\n", pa & ~0x1f);
 		}
 
-		MIReadBurst(pa & ~0x1f, &cacheData[pa & ~0x1f]);
+		MIReadBurst(pa & ~0x1f, ShadowPtr(pa & ~0x1f));
 	}
 
 	void Cache::CastOut(uint32_t pa)
@@ -256,7 +363,7 @@ namespace Gekko
 			DBReport2(DbgChannel::CPU, "Cache::CastOut: 0x%08X\n", pa & ~0x1f);
 		}
 
-		MIWriteBurst(pa & ~0x1f, &cacheData[pa & ~0x1f]);
+		MIWriteBurst(pa & ~0x1f, ShadowPtr(pa & ~0x1f));
 	}
 
 	void Cache::ReadByte(uint32_t addr, uint32_t* reg)
@@ -281,7 +388,7 @@ namespace Gekko
 			SetInvalid(addr, false);
 			SetDirty(addr, false);
 		}
-		*reg = cacheData[addr];
+		*reg = *ShadowPtr(addr);
 
 		if (log >= CacheLogLevel::MemOps)
 		{
@@ -310,7 +417,7 @@ namespace Gekko
 			CastIn(addr);
 			SetInvalid(addr, false);
 		}
-		cacheData[addr] = (uint8_t)data;
+		*ShadowPtr(addr) = (uint8_t)data;
 
 		if (log >= CacheLogLevel::MemOps)
 		{
@@ -357,7 +464,7 @@ namespace Gekko
 			}
 		}
 
-		*reg = _byteswap_ushort(*(uint16_t *)&cacheData[addr]);
+		*reg = _byteswap_ushort(ReadShadow<uint16_t>(addr));
 
 		if (log >= CacheLogLevel::MemOps)
 		{
@@ -403,7 +510,7 @@ namespace Gekko
 			SetDirty(nextCacheLineAddr, true);
 		}
 
-		*(uint16_t*)&cacheData[addr] = _byteswap_ushort((uint16_t)data);
+		WriteShadow<uint16_t>(addr, _byteswap_ushort((uint16_t)data));
 
 		if (log >= CacheLogLevel::MemOps)
 		{
@@ -450,7 +557,7 @@ namespace Gekko
 			}
 		}
 
-		*reg = _byteswap_ulong(*(uint32_t*)&cacheData[addr]);
+		*reg = _byteswap_ulong(ReadShadow<uint32_t>(addr));
 
 		if (log >= CacheLogLevel::MemOps)
 		{
@@ -496,7 +603,7 @@ namespace Gekko
 			SetDirty(nextCacheLineAddr, true);
 		}
 
-		*(uint32_t*)&cacheData[addr] = _byteswap_ulong(data);
+		WriteShadow<uint32_t>(addr, _byteswap_ulong(data));
 
 		if (log >= CacheLogLevel::MemOps)
 		{
@@ -543,7 +650,7 @@ namespace Gekko
 			}
 		}
 
-		*reg = _byteswap_uint64(*(uint64_t*)&cacheData[addr]);
+		*reg = _byteswap_uint64(ReadShadow<uint64_t>(addr));
 
 		if (log >= CacheLogLevel::MemOps)
 		{
@@ -589,7 +696,7 @@ namespace Gekko
 			SetDirty(nextCacheLineAddr, true);
 		}
 
-		*(uint64_t*)&cacheData[addr] = _byteswap_uint64(*data);
+		WriteShadow<uint64_t>(addr, _byteswap_uint64(*data));
 
 		if (log >= CacheLogLevel::MemOps)
 		{
@@ -13,19 +13,41 @@ namespace Gekko
 
 	class Cache
 	{
-		uint8_t* cacheData;
-		const size_t cacheSize = 0x01800000;    // 24 MBytes
+		static const size_t cacheSize = 0x01800000;    // 24 MBytes
+
+		// The cache shadow of RAM is allocated on demand, page by page. Usually only a small part of RAM goes through the cache.
+		static const size_t shadowPageShift = 12;
+		static const size_t shadowPageSize = (size_t)1 << shadowPageShift;
+		static const size_t shadowPages = cacheSize >> shadowPageShift;
+		uint8_t** cachePages = nullptr;
+		size_t cachePagesAllocated = 0;
+
+		uint8_t* ShadowPtr(uint32_t pa);
+		template <typename T> T ReadShadow(uint32_t pa);
+		template <typename T> void WriteShadow(uint32_t pa, T value);
+		void FreeShadow();
+
+		// Cache block state is kept in bitsets, one bit per 32-byte block.
+		static const size_t blockWords = (cacheSize >> 5) / 64;
 
 		// A sign that the cache block is dirty (does not match the value in RAM).
-		bool * modifiedBlocks = nullptr;
+		uint64_t * modifiedBlocks = nullptr;
 
 		// Cache block invalid, must be casted-in before use
-		bool * invalidBlocks = nullptr;
+		uint64_t * invalidBlocks = nullptr;
 
-		bool IsDirty(uint32_t pa);
+		bool IsDirty(uint32_t pa)
+		{
+			size_t blockNum = pa >> 5;
+			return (modifiedBlocks[blockNum >> 6] >> (blockNum & 63)) & 1;
+		}
 		void SetDirty(uint32_t pa, bool dirty);
 
-		bool IsInvalid(uint32_t pa);
+		bool IsInvalid(uint32_t pa)
+		{
+			size_t blockNum = pa >> 5;
+			return (invalidBlocks[blockNum >> 6] >> (blockNum & 63)) & 1;
+		}
 		void SetInvalid(uint32_t pa, bool invalid);
 
 		bool enabled = false;
@@ -50,6 +72,8 @@ namespace Gekko
 
 		void Reset();
 
+		void DoState(StateStream& state);
+
 		void Enable(bool enable);
 		bool IsEnabled() { return enabled; }
 
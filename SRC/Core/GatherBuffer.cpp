@@ -4,9 +4,8 @@ namespace Gekko
 {
 	void GatherBuffer::Reset()
 	{
-		memset(fifo, 0, sizeof(fifo));
-		readPtr = 0;
-		writePtr = 0;
+		burst = nullptr;
+		fill = 0;
 
 		if (log)
 		{
@@ -14,18 +13,62 @@ namespace Gekko
 		}
 	}
 
-	size_t GatherBuffer::GatherSize()
+	// A burst to the GX FIFO is assembled in RAM, so its bytes are saved with the RAM pages
+	void GatherBuffer::DoState(StateStream& state)
 	{
-		if (writePtr >= readPtr)
+		if (state.IsSaving() && fill != 0 && burst != staging)
 		{
-			return writePtr - readPtr;
+			mi->dirty.Mark(burst - mi->ram);
+		}
+
+		state.BeginSection('GATH', 1);
+		state.Do(staging);
+		state.Do(burstAddr);
+		state.Do(fill);
+		state.EndSection();
+
+		if (state.IsLoading())
+		{
+			burst = nullptr;
+			if (fill != 0)
+			{
+				burst = (burstAddr == GX_FIFO) ? GXFifoWritePointer() : staging;
+			}
+		}
+	}
+
+	void GatherBuffer::BeginBurst()
+	{
+		burstAddr = core->regs.spr[(int)SPR::WPAR] & ~0x1f;
+		burst = (burstAddr == GX_FIFO) ? GXFifoWritePointer() : staging;
+	}
+
+	void GatherBuffer::EndBurst()
+	{
+		if (log)
+		{
+			DBReport2(DbgChannel::CPU, "Burst gather buffer: 0x%08X\n", burstAddr);
+		}
+
+		if (burst != staging)
+		{
+			// The program may have moved the FIFO write pointer in the middle of the burst
+			uint8_t* ptr = GXFifoWritePointer();
+			if (ptr != burst)
+			{
+				memmove(ptr, burst, sizeof(staging));
+			}
+			GXFifoCommitBurst();
 		}
 		else
 		{
-			return (sizeof(fifo) - readPtr) + writePtr;
+			MIWriteBurst(burstAddr, staging);
 		}
+
+		fill = 0;
 	}
 
+	// Slow path: logging, or the data crosses the burst boundary
 	void GatherBuffer::WriteBytes(uint8_t* data, size_t size)
 	{
 		if (log)
@@ -42,85 +85,17 @@ namespace Gekko
 			DBReport2(DbgChannel::CPU, "GatherBuffer::WriteBytes: %s", text.c_str());
 		}
 
-		if (size < 4)
-		{
-			for (int i = 0; i < size; i++)
-			{
-				fifo[writePtr] = data[i];
-				writePtr++;
-				if (writePtr >= sizeof(fifo))
-				{
-					writePtr = 0;
-				}
-			}
-		}
-		else
-		{
-			if ((writePtr + size) < sizeof(fifo))
-			{
-				memcpy(&fifo[writePtr], data, size);
-				writePtr += size;
-			}
-			else
-			{
-				size_t part1Size = sizeof(fifo) - writePtr;
-				memcpy(&fifo[writePtr], data, part1Size);
-				writePtr = size - part1Size;
-				memcpy(fifo, data + part1Size, writePtr);
-			}
-		}
-
-		if (GatherSize() >= 32)
+		for (size_t i = 0; i < size; i++)
 		{
-			uint8_t burstData[32];
-
-			for (int i = 0; i < sizeof(burstData); i++)
+			if (fill == 0)
 			{
-				burstData[i] = fifo[readPtr];
-				readPtr++;
-				if (readPtr >= sizeof(fifo))
-				{
-					readPtr = 0;
-				}
+				BeginBurst();
 			}
-
-			if (log)
+			burst[fill++] = data[i];
+			if (fill == sizeof(staging))
 			{
-				DBReport2(DbgChannel::CPU, "Burst gather buffer. Bytes left: %zi\n", GatherSize());
+				EndBurst();
 			}
-
-			MIWriteBurst(Gekko->regs.spr[(int)SPR::WPAR] & ~0x1f, burstData);
 		}
 	}
-
-	void GatherBuffer::Write8(uint8_t value)
-	{
-		WriteBytes(&value, 1);
-	}
-
-	void GatherBuffer::Write16(uint16_t value)
-	{
-		uint8_t data[2];
-		*(uint16_t *)data = _byteswap_ushort(value);
-		WriteBytes(data, 2);
-	}
-
-	void GatherBuffer::Write32(uint32_t value)
-	{
-		uint8_t data[4];
-		*(uint32_t*)data = _byteswap_ulong(value);
-		WriteBytes(data, 4);
-	}
-
-	void GatherBuffer::Write64(uint64_t value)
-	{
-		uint8_t data[8];
-		*(uint64_t*)data = _byteswap_uint64(value);
-		WriteBytes(data, 8);
-	}
-
-	bool GatherBuffer::NotEmpty()
-	{
-		return readPtr != writePtr;
-	}
 }
@@ -1,30 +1,66 @@
 // Gekko Gather Buffer
 
+// Stores to WPAR are collected into 32-byte bursts. When the pipe points to the GX FIFO (the usual case),
+// the burst is assembled directly at the PI FIFO write pointer in RAM, so a store is just a copy and a pointer bump.
+// The FIFO pointers are updated once per burst.
+
 #pragma once
 
 namespace Gekko
 {
+	class GekkoCore;
+
 	class GatherBuffer
 	{
-		uint8_t fifo[32 * 4] = { 0 };
-		size_t readPtr = 0;
-		size_t writePtr = 0;
+		GekkoCore* core;		// Parent core
+
+		uint8_t staging[32] = { 0 };	// Burst for WPAR other than GX FIFO
+		uint8_t* burst = nullptr;		// Where the current burst is assembled
+		uint32_t burstAddr = 0;			// WPAR of the current burst
+		size_t fill = 0;
 
+		void BeginBurst();
+		void EndBurst();
 		void WriteBytes(uint8_t* data, size_t size);
-		size_t GatherSize();
 
 		bool log = false;
 
+		// The value is already in big-endian order
+		template <typename T>
+		void WriteFast(T value)
+		{
+			if (fill + sizeof(T) <= sizeof(staging) && !log)
+			{
+				if (fill == 0)
+				{
+					BeginBurst();
+				}
+				memcpy(burst + fill, &value, sizeof(T));
+				fill += sizeof(T);
+				if (fill == sizeof(staging))
+				{
+					EndBurst();
+				}
+			}
+			else
+			{
+				WriteBytes((uint8_t*)&value, sizeof(T));
+			}
+		}
+
 	public:
+		GatherBuffer(GekkoCore* parent) : core(parent) {}
 
 		void Reset();
 
-		void Write8(uint8_t value);
-		void Write16(uint16_t value);
-		void Write32(uint32_t value);
-		void Write64(uint64_t value);
+		void Write8(uint8_t value) { WriteFast<uint8_t>(value); }
+		void Write16(uint16_t value) { WriteFast<uint16_t>(_byteswap_ushort(value)); }
+		void Write32(uint32_t value) { WriteFast<uint32_t>(_byteswap_ulong(value)); }
+		void Write64(uint64_t value) { WriteFast<uint64_t>(_byteswap_uint64(value)); }
+
+		bool NotEmpty() { return fill != 0; }
 
-		bool NotEmpty();
+		void DoState(StateStream& state);
 
 	};
 }
@@ -3,7 +3,7 @@
 
 namespace Gekko
 {
-    GekkoCore* Gekko;
+    InstanceRef<GekkoCore, &Instance::gekko> Gekko;
 
     void GekkoCore::GekkoThreadProc(void* Parameter)
     {
@@ -11,9 +11,44 @@ namespace Gekko
 
         while (true)
         {
-            core->TestBreakpoints();
+            // The safe point callbacks are run here also while the core is stopped (Suspend is cooperative, the thread waits at this point)
 
-            core->interp->ExecuteOpcode();
+            if (core->safePointCallback.load(std::memory_order_relaxed) != nullptr)
+            {
+                SafePointCallback callback = core->safePointCallback.exchange(nullptr);
+                if (callback)
+                {
+                    callback(core->safePointContext);
+                    core->safePointDone = true;
+                }
+            }
+
+            if (core->gekkoThread->ParkPending() && core->gekkoThread->Parked())
+            {
+                core->gekkoThread->ParkSleep();
+                continue;
+            }
+
+            // Breakpoints are checked per instruction, so the cached interpreter is not used while they are enabled.
+
+            auto ops = core->ops;
+
+            if (core->cachedInterpreter && !core->EnableTestBreakpoints)
+            {
+                core->interp->ExecuteCached();
+                Debug::PerfAdd(Debug::PerfCounter::GekkoCachedInstructions, core->ops - ops);
+            }
+            else
+            {
+                core->TestBreakpoints();
+
+                // Stopped by the breakpoint, the instruction is executed after Run
+                if (!core->IsRunning())
+                    continue;
+
+                core->interp->ExecuteOpcode();
+                Debug::PerfAdd(Debug::PerfCounter::GekkoInterpreterInstructions, core->ops - ops);
+            }
 
             // For debugging purposes, Jitc is not yet turned on when the code is uploaded to master.
 
@@ -21,7 +56,7 @@ namespace Gekko
         }
     }
 
-    GekkoCore::GekkoCore()
+    GekkoCore::GekkoCore() : gatherBuffer(this)
     {
         interp = new Interpreter(this);
         assert(interp);
@@ -29,10 +64,15 @@ namespace Gekko
         jitc = new Jitc(this);
         assert(jitc);
 
-        Debug::Hub.AddNode(GEKKO_CORE_JDI_JSON, gekko_init_handlers);
+        debugNode = !Instance::Get()->headless;
+        if (debugNode)
+        {
+            Debug::Hub.AddNode(GEKKO_CORE_JDI_JSON, gekko_init_handlers);
+        }
 
         gekkoThread = new Thread(GekkoThreadProc, true, this, "GekkoCore");
         assert(gekkoThread);
+        gekkoThread->StartParked();
 
         Reset();
 
@@ -44,7 +84,10 @@ namespace Gekko
         delete gekkoThread;
         delete interp;
         delete jitc;
-        Debug::Hub.RemoveNode(GEKKO_CORE_JDI_JSON);
+        if (debugNode)
+        {
+            Debug::Hub.RemoveNode(GEKKO_CORE_JDI_JSON);
+        }
     }
 
     // Reset processor
@@ -93,9 +136,15 @@ namespace Gekko
         regs.spr[(int)SPR::DEC] = 0;
         regs.spr[(int)SPR::CTR] = 0;
 
+        downcount = downcountStart = 0;
+        ResetIdleStats();
+        if (sampleHook)
+            nextSampleTbr = sampleInterval;
+
         gatherBuffer.Reset();
 
         jitc->Reset();
+        interp->InvalidateCachedAll();
         segmentsExecuted = 0;
 
         dtlb.InvalidateAll();
@@ -103,21 +152,129 @@ namespace Gekko
         cache.Reset();
     }
 
-    // Modify CPU counters
-    void GekkoCore::Tick()
+    void GekkoCore::DoState(StateStream& state)
+    {
+        // Bring TB and DEC up to date, a new slice is started after the load
+        if (state.IsSaving())
+        {
+            SyncTimers();
+        }
+
+        state.BeginSection('GEKK', 1);
+        state.Do(regs);
+        state.Do(decreq);
+        state.Do(intFlag);
+        state.Do(exception);
+        state.Do(MmuLastResult);
+        state.Do(PrCause);
+        state.Do(ops);
+        state.EndSection();
+
+        gatherBuffer.DoState(state);
+        cache.DoState(state);
+
+        if (state.IsLoading())
+        {
+            downcount = downcountStart = 0;
+            if (sampleHook)
+                nextSampleTbr = regs.tb.uval + sampleInterval;
+
+            // The memory has changed under the translations and the compiled code
+            dtlb.InvalidateAll();
+            itlb.InvalidateAll();
+            interp->InvalidateCachedAll();
+            jitc->Reset();
+        }
+    }
+
+    void GekkoCore::RunAtSafePoint(SafePointCallback callback, void* context)
+    {
+        safePointLock.Lock();
+
+        safePointContext = context;
+        safePointDone = false;
+        safePointCallback = callback;
+
+        // The callback is always run by the Gekko thread, also when the core is stopped (it waits at the top of its loop then).
+        // The callback is picked up at the next block, and the caller (the rewind buffer on the HW thread) should not lose a timer slice waiting for it
+        while (!safePointDone)
+        {
+            Sleep(0);
+        }
+
+        safePointLock.Unlock();
+    }
+
+    // Modify CPU counters by the number of instructions executed since the last update and start a new slice.
+    // The slice never goes beyond the next DEC sign change, so the change can only happen at its last instruction
+    // (same as if the counters were updated by each instruction).
+    void GekkoCore::SyncTimers()
     {
-        regs.tb.uval += CounterStep;         // timer
+        int elapsed = downcountStart - downcount;
 
-        uint32_t old = regs.spr[(int)SPR::DEC];
-        regs.spr[(int)SPR::DEC]--;          // decrementer
-        if ((old ^ regs.spr[(int)SPR::DEC]) & 0x80000000)
+        if (elapsed > 0)
         {
-            if (regs.msr & MSR_EE)
+            regs.tb.uval += (uint64_t)elapsed * CounterStep;      // timer
+
+            uint32_t old = regs.spr[(int)SPR::DEC];
+            regs.spr[(int)SPR::DEC] -= elapsed;         // decrementer
+            if ((old ^ regs.spr[(int)SPR::DEC]) & 0x80000000)
             {
-                decreq = 1;
-                DBReport2(DbgChannel::CPU, "decrementer exception (OS alarm), pc:%08X\n", regs.pc);
+                if (regs.msr & MSR_EE)
+                {
+                    decreq = 1;
+                    DBReport2(DbgChannel::CPU, "decrementer exception (OS alarm), pc:%08X\n", regs.pc);
+                }
             }
         }
+
+        if (regs.tb.uval >= nextSampleTbr)
+        {
+            nextSampleTbr = regs.tb.uval + sampleInterval;
+            sampleHook(sampleContext, this);
+        }
+
+        // Decrements left until bit 31 of DEC flips
+        uint32_t decChange = (regs.spr[(int)SPR::DEC] & 0x7fff'ffff) + 1;
+
+        downcount = decChange < (uint32_t)TimerSlice ? (int)decChange : TimerSlice;
+        downcountStart = downcount;
+    }
+
+    // Busy-wait loop went for another iteration. Nothing can change until an interrupt or another device updates the polled state,
+    // so let the time pass instead of spinning.
+    void GekkoCore::SkipIdle()
+    {
+        if ((intFlag || decreq) && (regs.msr & MSR_EE))
+            return;
+
+        SyncTimers();
+
+        uint32_t decChange = (regs.spr[(int)SPR::DEC] & 0x7fff'ffff) + 1;
+        uint32_t skip = decChange < IdleSkipMax ? decChange : IdleSkipMax;
+
+        // Account the skipped instructions as executed
+        downcountStart = (int)skip;
+        downcount = 0;
+        SyncTimers();
+
+        idleSkippedTicks += (int64_t)skip * CounterStep;
+        idleSkipCount++;
+    }
+
+    void GekkoCore::SetSampleHook(SampleHook hook, void* context, uint64_t interval)
+    {
+        if (hook == nullptr)
+        {
+            nextSampleTbr = UINT64_MAX;
+            sampleHook = nullptr;
+            return;
+        }
+
+        sampleHook = hook;
+        sampleContext = context;
+        sampleInterval = interval ? interval : 1;
+        nextSampleTbr = regs.tb.uval + sampleInterval;
     }
 
     int64_t GekkoCore::GetTicks()
@@ -271,6 +428,79 @@ namespace Gekko
         interp->ExecuteOpcodeDirect(pc, instr);
     }
 
+    // The table is changed only when the core is suspended or at a safe point, so the interpreter reads it without locking.
+    uint32_t GekkoCore::AddHleCall(HleCall call)
+    {
+        if (hleCalls.empty())
+        {
+            hleCalls.push_back({ nullptr, 0 });
+        }
+
+        assert(hleCalls.size() < 0x0400'0000);
+        hleCalls.push_back({ call, 0 });
+        return (uint32_t)(hleCalls.size() - 1);
+    }
+
+    void GekkoCore::ClearHleCalls()
+    {
+        hleCalls.clear();
+    }
+
+    // The call may change pc (for example a trap). Otherwise the instruction after the patch is executed, this is blr (or rfi) which returns to the caller.
+    bool GekkoCore::ExecuteHleCall(uint32_t op)
+    {
+        uint32_t index = op & 0x03ff'ffff;
+        if (index == 0 || index >= hleCalls.size())
+            return false;
+
+        HleEntry& entry = hleCalls[index];
+        entry.calls++;
+
+        uint32_t pc = regs.pc;
+        entry.call();
+        if (regs.pc == pc)
+        {
+            regs.pc += 4;
+        }
+        return true;
+    }
+
+    uint64_t GekkoCore::GetHleCallCount(uint32_t op)
+    {
+        uint32_t index = op & 0x03ff'ffff;
+        return index < hleCalls.size() ? hleCalls[index].calls : 0;
+    }
+
+    void GekkoCore::InvalidateCode(uint32_t ea, size_t size)
+    {
+        int WIMG;
+        uint32_t pa = EffectiveToPhysical(ea, MmuAccess::Execute, WIMG);
+        if (pa != BadAddress)
+        {
+            interp->InvalidateCached(pa, size);
+        }
+        jitc->Invalidate(ea, size);
+    }
+
+    struct InvalidateCodeJob
+    {
+        GekkoCore* core;
+        uint32_t ea;
+        size_t size;
+    };
+
+    static void InvalidateCodeCallback(void* context)
+    {
+        InvalidateCodeJob* job = (InvalidateCodeJob*)context;
+        job->core->InvalidateCode(job->ea, job->size);
+    }
+
+    void GekkoCore::InvalidateCodeAtSafePoint(uint32_t ea, size_t size)
+    {
+        InvalidateCodeJob job = { this, ea, size };
+        RunAtSafePoint(InvalidateCodeCallback, &job);
+    }
+
     uint32_t GekkoCore::EffectiveToPhysical(uint32_t ea, MmuAccess type, int& WIMG)
     {
         //return EffectiveToPhysicalNoMmu(ea, type, WIMG);
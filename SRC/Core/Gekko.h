@@ -2,12 +2,17 @@
 
 #pragma once
 
+#include "../Common/Instance.h"
 #include "../Common/Thread.h"
+#include "../Common/StateStream.h"
+#include <atomic>
 #include <list>
 #include <memory>
+#include <vector>
 #include "GekkoDefs.h"
 #include "GekkoAnalyzer.h"
 #include "GatherBuffer.h"
+#include "BreakpointMap.h"
 #include "TLB.h"
 #include "Cache.h"
 
@@ -18,6 +23,13 @@ union FPREG
     uint64_t       uval;
 };
 
+// paired-single register: both lanes side by side, so that a pair can be loaded as one SSE2 vector
+struct alignas(16) PSREG
+{
+    FPREG          ps0;                // also the FPR value for scalar floating point
+    FPREG          ps1;
+};
+
 // time-base
 union TBREG
 {
@@ -33,7 +45,7 @@ union TBREG
 struct GekkoRegs
 {
     uint32_t    gpr[32];            // general purpose regs
-    FPREG       fpr[32], ps1[32];   // floating point regs (fpr=ps0 for paired singles)
+    PSREG       fpr[32];            // floating point regs (ps0 is the FPR for scalar instructions)
     uint32_t    spr[1024];          // special purpose regs
     uint32_t    sr[16];             // segment regs
     uint32_t    cr;                 // condition reg
@@ -91,15 +103,63 @@ namespace Gekko
         // Therefore, we are a little tricky and "slow down" the work of the emulated processor (we make several ticks per 1 instruction).
         static const int CounterStep = 2;
 
+        // The time base and decrementer are not updated by every instruction. Instead, each instruction decrements the downcount,
+        // and TB/DEC are brought up to date when it expires (exactly at the next DEC sign change, or at the end of a short slice,
+        // so that the devices polling GetTicks see a fresh value), or when the program accesses them.
+        static const int TimerSlice = 32;
+        int downcount = 0;                  // Instructions left until the next timer update
+        int downcountStart = 0;             // Budget of the current slice
+
+        // Idle loop skipping. Each iteration of a detected busy-wait loop advances the time by up to IdleSkipMax instructions
+        // (not beyond the next DEC sign change). This is less than one VI line, so the device threads polling GetTicks keep up.
+        static const uint32_t IdleSkipMax = 1000;
+        bool idleSkip = true;
+        int64_t idleSkippedTicks = 0;
+        int64_t idleSkipCount = 0;
+
+    public:
+        typedef void (*SampleHook)(void* context, GekkoCore* core);
+        typedef void (*SafePointCallback)(void* context);
+        typedef void (*HleCall)();
+
+    private:
+        // High level calls. The entry point of a replaced function is patched by an opcode with primary opcode 0 and the index in this table,
+        // so it is recognized by the interpreter (c_HL) and by the recompiler (through the interpreter fallback). Index 0 is not used.
+        struct HleEntry
+        {
+            HleCall call;
+            uint64_t calls;
+        };
+        std::vector<HleEntry> hleCalls;
+
+        // Sampling (profiler). The hook is checked by the timer update, so it costs nothing per instruction.
+        SampleHook sampleHook = nullptr;
+        void* sampleContext = nullptr;
+        uint64_t sampleInterval = 0;
+        uint64_t nextSampleTbr = UINT64_MAX;
+
         Thread* gekkoThread = nullptr;
         static void GekkoThreadProc(void* Parameter);
 
-        std::list<uint32_t> breakPointsExecute;
-        std::list<uint32_t> breakPointsRead;
-        std::list<uint32_t> breakPointsWrite;
-        SpinLock breakPointsLock;
+        bool debugNode = false;     // The JDI commands are registered by the core of the main instance only
+
+        // A callback to run between instructions (savestates, HLE). The Gekko thread clears the pointer and runs the callback.
+        // There is one slot, the callers (debugger, rewind on the HW thread) take turns on the lock.
+        SpinLock safePointLock;
+        std::atomic<SafePointCallback> safePointCallback = nullptr;
+        void* safePointContext = nullptr;
+        std::atomic<bool> safePointDone = false;
+
+        BreakpointMap breakPointsExecute;
+        BreakpointMap breakPointsRead;      // Read watches (ranges)
+        BreakpointMap breakPointsWrite;     // Write watches (ranges)
         uint32_t oneShotBreakpoint = BadAddress;
 
+        // The bitmap tables replaced by the debugger thread are freed by the Gekko thread itself at the safe point, also when the core is stopped.
+        // On the Gekko thread a Test may be up the stack, the tables wait for the next call then.
+        static void ReclaimBreakpointsCallback(void* context);
+        void ReclaimBreakpoints();
+
         bool TestBreakpointForJitc(uint32_t addr);
         void TestBreakpoints();
         void TestReadBreakpoints(uint32_t accessAddress);
@@ -112,6 +172,8 @@ namespace Gekko
         Interpreter* interp;
         Jitc* jitc;
 
+        bool cachedInterpreter = true;      // Execute whole basic blocks decoded in advance (see Interpreter::ExecuteCached)
+
         uint64_t    msec;
         int64_t     one_second;         // one second in timer ticks
         size_t      ops;                // instruction counter (only for debug!)
@@ -155,19 +217,41 @@ namespace Gekko
         GekkoCore();
         ~GekkoCore();
 
+        // Suspend is cooperative: the Gekko thread stops between blocks (instructions), another thread waits until it is there.
         void Run() { gekkoThread->Resume(); }
         bool IsRunning() { return gekkoThread->IsRunning(); }
         void Suspend() { gekkoThread->Suspend(); }
 
         void Reset();
 
-        void Tick();
+        // Registers, timers and the caches. Compiled code is dropped on load.
+        void DoState(StateStream& state);
+
+        // Runs the callback on the Gekko thread between instructions and waits for it. Also when the core is suspended, the stopped thread waits at the same point.
+        // Do not call it on the Gekko thread.
+        void RunAtSafePoint(SafePointCallback callback, void* context);
+
+        void Tick() { if (--downcount <= 0) SyncTimers(); }
+        void SyncTimers();
         int64_t GetTicks();
         int64_t OneSecond();
         int64_t OneMillisecond() { return msec; }
 
+        // The hook is called on the Gekko thread every `interval` ticks of the time base. Pass nullptr to remove it.
+        // Call it on the Gekko thread (from the hook itself or by RunAtSafePoint), the timer update reads the hook without a lock.
+        void SetSampleHook(SampleHook hook, void* context, uint64_t interval);
+
         void Step();
 
+        void EnableCachedInterpreter(bool enable) { cachedInterpreter = enable; }
+
+        void SkipIdle();
+        void EnableIdleSkip(bool enable) { idleSkip = enable; }
+        bool IsIdleSkipEnabled() { return idleSkip; }
+        int64_t GetIdleSkippedTicks() { return idleSkippedTicks; }
+        int64_t GetIdleSkipCount() { return idleSkipCount; }
+        void ResetIdleStats() { idleSkippedTicks = idleSkipCount = 0; }
+
         void AssertInterrupt();
         void ClearInterrupt();
         void Exception(Gekko::Exception code);
@@ -177,6 +261,18 @@ namespace Gekko
 
         void ExecuteOpcodeDebug(uint32_t pc, uint32_t instr);
 
+        // Returns a new high level opcode for the call, with its own counter. The same routine may be added several times (aliases of a function).
+        uint32_t AddHleCall(HleCall call);
+        void ClearHleCalls();
+        bool ExecuteHleCall(uint32_t op);
+        uint64_t GetHleCallCount(uint32_t op);
+
+        // Drop the compiled code of the range (the code was patched). The cached interpreter keeps blocks by physical address, Jitc segments by effective.
+        void InvalidateCode(uint32_t ea, size_t size);
+
+        // Same for the code written by other threads (debugger, loader patches). Not for the safe point callbacks, they call InvalidateCode.
+        void InvalidateCodeAtSafePoint(uint32_t ea, size_t size);
+
 #pragma region "Memory interface"
 
         // Centralized hub for access to the data bus (memory) from CPU side.
@@ -202,8 +298,8 @@ namespace Gekko
 
         void AddBreakpoint(uint32_t addr);
         void RemoveBreakpoint(uint32_t addr);
-        void AddReadBreak(uint32_t addr);
-        void AddWriteBreak(uint32_t addr);
+        void AddReadBreak(uint32_t addr, uint32_t size = 1);
+        void AddWriteBreak(uint32_t addr, uint32_t size = 1);
         void ClearBreakpoints();
 
         void AddOneShotBreakpoint(uint32_t addr);
@@ -215,5 +311,6 @@ namespace Gekko
 
     };
 
-    extern GekkoCore* Gekko;
+    // The core of the current instance (see "Instances" in Core\Readme.md)
+    extern InstanceRef<GekkoCore, &Instance::gekko> Gekko;
 }
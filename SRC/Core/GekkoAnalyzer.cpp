@@ -1,10 +1,12 @@
 /*
 
 PowerPC architecture has a fairly clean instruction format.
-This module in the first half contains a switch-case for the Primary/Secondary instruction code, 
-and in the second half there are parameter parsers.
+This module in the first half contains the decode table, and in the second half there are parameter parsers.
 
-In theory such switch-cases are deeply optimized by the x64 compiler, so there is no need for JumpTables.
+The decode table is described by a list of rules: primary opcode and extended opcode bits -> instruction and operand form.
+At startup the rules are expanded into a dense table, so that any instruction is decoded with a single lookup:
+the primary opcode selects a slice of the table (the slice layout is computed at compile time), and the extended opcode bits select the entry.
+The operand form selects the parameter parser.
 
 The "fast" versions are used for a consumer who knows in advance the number of parameters (for example, an interpreter).
 Thus, we speed up the decoding process.
@@ -33,1074 +35,560 @@ namespace Gekko
 	#define AA          (instr & 2)
 	#define LK          (instr & 1)
 	#define AALK        (instr & 3)
+	#define AABit       2
+	#define AALKBits    3
 	#define Rc          LK
 	#define RcBit       1
 	#define LKBit       1
 	#define DIS_SPR     ((DIS_RB << 5) | DIS_RA)
 	#define DIS_TBR     ((DIS_RB << 5) | DIS_RA)
 
-	void Analyzer::OpMain(uint32_t instr, AnalyzeInfo* info)
-	{
-		switch (instr >> 26)
+	#pragma region "Decode table"
+
+	static const uint8_t DecodeFlow = 1;		// Set AnalyzeInfo::flow
+	static const uint8_t DecodeLZero = 2;		// Valid only if the L bit (lsb of rD) is 0, 32-bit compares
+
+	struct DecodeRule
+	{
+		uint32_t primary;
+		uint32_t mask;			// Bits of (instr & 0x7ff) that take part in the decoding
+		uint32_t match;
+		Instruction instr;
+		AnalyzeForm form;
+		uint8_t flags;
+	};
+
+	// If several rules match the instruction bits, the first one wins.
+
+	static constexpr DecodeRule decodeRules[] = {
+
+		// Primary opcode only
+
+		{ 12, 0, 0, Instruction::addic, AnalyzeForm::DaSimm },
+		{ 13, 0, 0, Instruction::addic_d, AnalyzeForm::DaSimm },
+		{ 14, 0, 0, Instruction::addi, AnalyzeForm::DaSimm },
+		{ 15, 0, 0, Instruction::addis, AnalyzeForm::DaSimm },
+		{ 16, AALKBits, 0, Instruction::bc, AnalyzeForm::BoBiTargetAddr },
+		{ 16, AALKBits, LKBit, Instruction::bcl, AnalyzeForm::BoBiTargetAddr },
+		{ 16, AALKBits, AABit, Instruction::bca, AnalyzeForm::BoBiTargetAddr },
+		{ 16, AALKBits, AABit | LKBit, Instruction::bcla, AnalyzeForm::BoBiTargetAddr },
+		{ 18, AALKBits, 0, Instruction::b, AnalyzeForm::TargetAddr },
+		{ 18, AALKBits, LKBit, Instruction::bl, AnalyzeForm::TargetAddr },
+		{ 18, AALKBits, AABit, Instruction::ba, AnalyzeForm::TargetAddr },
+		{ 18, AALKBits, AABit | LKBit, Instruction::bla, AnalyzeForm::TargetAddr },
+		{ 28, 0, 0, Instruction::andi_d, AnalyzeForm::AsUimm },
+		{ 29, 0, 0, Instruction::andis_d, AnalyzeForm::AsUimm },
+		{ 11, 0, 0, Instruction::cmpi, AnalyzeForm::CrfDaSimm, DecodeLZero },
+		{ 10, 0, 0, Instruction::cmpli, AnalyzeForm::CrfDaUimm, DecodeLZero },
+
+		{ 34, 0, 0, Instruction::lbz, AnalyzeForm::DaOffset },
+		{ 35, 0, 0, Instruction::lbzu, AnalyzeForm::DaOffset },
+		{ 50, 0, 0, Instruction::lfd, AnalyzeForm::FrdaOffset },
+		{ 51, 0, 0, Instruction::lfdu, AnalyzeForm::FrdaOffset },
+		{ 48, 0, 0, Instruction::lfs, AnalyzeForm::FrdaOffset },
+		{ 49, 0, 0, Instruction::lfsu, AnalyzeForm::FrdaOffset },
+		{ 42, 0, 0, Instruction::lha, AnalyzeForm::DaOffset },
+		{ 43, 0, 0, Instruction::lhau, AnalyzeForm::DaOffset },
+		{ 40, 0, 0, Instruction::lhz, AnalyzeForm::DaOffset },
+		{ 41, 0, 0, Instruction::lhzu, AnalyzeForm::DaOffset },
+		{ 46, 0, 0, Instruction::lmw, AnalyzeForm::DaOffset },
+		{ 32, 0, 0, Instruction::lwz, AnalyzeForm::DaOffset },
+		{ 33, 0, 0, Instruction::lwzu, AnalyzeForm::DaOffset },
+
+		{ 7, 0, 0, Instruction::mulli, AnalyzeForm::DaSimm },
+		{ 24, 0, 0, Instruction::ori, AnalyzeForm::AsUimm },
+		{ 25, 0, 0, Instruction::oris, AnalyzeForm::AsUimm },
+
+		{ 56, 0, 0, Instruction::psq_l, AnalyzeForm::FrRegOffsetWi },
+		{ 57, 0, 0, Instruction::psq_lu, AnalyzeForm::FrRegOffsetWi },
+		{ 60, 0, 0, Instruction::psq_st, AnalyzeForm::FrRegOffsetWi },
+		{ 61, 0, 0, Instruction::psq_stu, AnalyzeForm::FrRegOffsetWi },
+
+		{ 20, RcBit, 0, Instruction::rlwimi, AnalyzeForm::AsImm3 },
+		{ 20, RcBit, RcBit, Instruction::rlwimi_d, AnalyzeForm::AsImm3 },
+		{ 21, RcBit, 0, Instruction::rlwinm, AnalyzeForm::AsImm3 },
+		{ 21, RcBit, RcBit, Instruction::rlwinm_d, AnalyzeForm::AsImm3 },
+		{ 23, RcBit, 0, Instruction::rlwnm, AnalyzeForm::AsbImm2 },
+		{ 23, RcBit, RcBit, Instruction::rlwnm_d, AnalyzeForm::AsbImm2 },
+
+		{ 17, AABit, AABit, Instruction::sc, AnalyzeForm::None, DecodeFlow },
+
+		{ 38, 0, 0, Instruction::stb, AnalyzeForm::DaOffset },
+		{ 39, 0, 0, Instruction::stbu, AnalyzeForm::DaOffset },
+		{ 54, 0, 0, Instruction::stfd, AnalyzeForm::FrdaOffset },
+		{ 55, 0, 0, Instruction::stfdu, AnalyzeForm::FrdaOffset },
+		{ 52, 0, 0, Instruction::stfs, AnalyzeForm::FrdaOffset },
+		{ 53, 0, 0, Instruction::stfsu, AnalyzeForm::FrdaOffset },
+		{ 44, 0, 0, Instruction::sth, AnalyzeForm::DaOffset },
+		{ 45, 0, 0, Instruction::sthu, AnalyzeForm::DaOffset },
+		{ 47, 0, 0, Instruction::stmw, AnalyzeForm::DaOffset },
+		{ 36, 0, 0, Instruction::stw, AnalyzeForm::DaOffset },
+		{ 37, 0, 0, Instruction::stwu, AnalyzeForm::DaOffset },
+
+		{ 8, 0, 0, Instruction::subfic, AnalyzeForm::DaSimm },
+
+		{ 3, 0, 0, Instruction::twi, AnalyzeForm::ImmASimm, DecodeFlow },
+
+		{ 26, 0, 0, Instruction::xori, AnalyzeForm::AsUimm },
+		{ 27, 0, 0, Instruction::xoris, AnalyzeForm::AsUimm },
+
+		// Primary 19
+
+		{ 19, 0x7ff, 528 * 2, Instruction::bcctr, AnalyzeForm::BoBi },
+		{ 19, 0x7ff, (528 * 2) | LKBit, Instruction::bcctrl, AnalyzeForm::BoBi },
+
+		{ 19, 0x7ff, 16 * 2, Instruction::bclr, AnalyzeForm::BoBi },
+		{ 19, 0x7ff, (16 * 2) | LKBit, Instruction::bclrl, AnalyzeForm::BoBi },
+
+		{ 19, 0x7ff, 257 * 2, Instruction::crand, AnalyzeForm::CrbDab },
+		{ 19, 0x7ff, 129 * 2, Instruction::crandc, AnalyzeForm::CrbDab },
+		{ 19, 0x7ff, 289 * 2, Instruction::creqv, AnalyzeForm::CrbDab },
+		{ 19, 0x7ff, 225 * 2, Instruction::crnand, AnalyzeForm::CrbDab },
+		{ 19, 0x7ff, 33 * 2, Instruction::crnor, AnalyzeForm::CrbDab },
+		{ 19, 0x7ff, 449 * 2, Instruction::cror, AnalyzeForm::CrbDab },
+		{ 19, 0x7ff, 417 * 2, Instruction::crorc, AnalyzeForm::CrbDab },
+		{ 19, 0x7ff, 193 * 2, Instruction::crxor, AnalyzeForm::CrbDab },
+
+		{ 19, 0x7ff, 150 * 2, Instruction::isync, AnalyzeForm::None },
+
+		{ 19, 0x7ff, 0, Instruction::mcrf, AnalyzeForm::Crfds },
+
+		{ 19, 0x7ff, 50 * 2, Instruction::rfi, AnalyzeForm::None, DecodeFlow },
+
+		// Primary 31
+
+		{ 31, 0x7ff, 266 * 2, Instruction::add, AnalyzeForm::Dab },
+		{ 31, 0x7ff, (266 * 2) | RcBit, Instruction::add_d, AnalyzeForm::Dab },
+		{ 31, 0x7ff, (266 * 2) | OEBit, Instruction::addo, AnalyzeForm::Dab },
+		{ 31, 0x7ff, (266 * 2) | OEBit | RcBit, Instruction::addo_d, AnalyzeForm::Dab },
+
+		{ 31, 0x7ff, 10 * 2, Instruction::addc, AnalyzeForm::Dab },
+		{ 31, 0x7ff, (10 * 2) | RcBit, Instruction::addc_d, AnalyzeForm::Dab },
+		{ 31, 0x7ff, (10 * 2) | OEBit, Instruction::addco, AnalyzeForm::Dab },
+		{ 31, 0x7ff, (10 * 2) | OEBit | RcBit, Instruction::addco_d, AnalyzeForm::Dab },
+
+		{ 31, 0x7ff, 138 * 2, Instruction::adde, AnalyzeForm::Dab },
+		{ 31, 0x7ff, (138 * 2) | RcBit, Instruction::adde_d, AnalyzeForm::Dab },
+		{ 31, 0x7ff, (138 * 2) | OEBit, Instruction::addeo, AnalyzeForm::Dab },
+		{ 31, 0x7ff, (138 * 2) | OEBit | RcBit, Instruction::addeo_d, AnalyzeForm::Dab },
+
+		{ 31, 0x7ff, 234 * 2, Instruction::addme, AnalyzeForm::Da },
+		{ 31, 0x7ff, (234 * 2) | RcBit, Instruction::addme_d, AnalyzeForm::Da },
+		{ 31, 0x7ff, (234 * 2) | OEBit, Instruction::addmeo, AnalyzeForm::Da },
+		{ 31, 0x7ff, (234 * 2) | OEBit | RcBit, Instruction::addmeo_d, AnalyzeForm::Da },
+
+		{ 31, 0x7ff, 202 * 2, Instruction::addze, AnalyzeForm::Da },
+		{ 31, 0x7ff, (202 * 2) | RcBit, Instruction::addze_d, AnalyzeForm::Da },
+		{ 31, 0x7ff, (202 * 2) | OEBit, Instruction::addzeo, AnalyzeForm::Da },
+		{ 31, 0x7ff, (202 * 2) | OEBit | RcBit, Instruction::addzeo_d, AnalyzeForm::Da },
+
+		{ 31, 0x7ff, 28 * 2, Instruction::_and, AnalyzeForm::Asb },
+		{ 31, 0x7ff, (28 * 2) | RcBit, Instruction::and_d, AnalyzeForm::Asb },
+
+		{ 31, 0x7ff, 60 * 2, Instruction::andc, AnalyzeForm::Asb },
+		{ 31, 0x7ff, (60 * 2) | RcBit, Instruction::andc_d, AnalyzeForm::Asb },
+
+		{ 31, 0x7ff, 0, Instruction::cmp, AnalyzeForm::CrfDab, DecodeLZero },
+
+		{ 31, 0x7ff, 32 * 2, Instruction::cmpl, AnalyzeForm::CrfDab, DecodeLZero },
+
+		{ 31, 0x7ff, 26 * 2, Instruction::cntlzw, AnalyzeForm::As },
+		{ 31, 0x7ff, (26 * 2) | RcBit, Instruction::cntlzw_d, AnalyzeForm::As },
+
+		{ 31, 0x7ff, 86 * 2, Instruction::dcbf, AnalyzeForm::Ab },
+		{ 31, 0x7ff, 470 * 2, Instruction::dcbi, AnalyzeForm::Ab },
+		{ 31, 0x7ff, 54 * 2, Instruction::dcbst, AnalyzeForm::Ab },
+		{ 31, 0x7ff, 278 * 2, Instruction::dcbt, AnalyzeForm::Ab },
+		{ 31, 0x7ff, 246 * 2, Instruction::dcbtst, AnalyzeForm::Ab },
+		{ 31, 0x7ff, 1014 * 2, Instruction::dcbz, AnalyzeForm::Ab },
+
+		{ 31, 0x7ff, 491 * 2, Instruction::divw, AnalyzeForm::Dab },
+		{ 31, 0x7ff, (491 * 2) | RcBit, Instruction::divw_d, AnalyzeForm::Dab },
+		{ 31, 0x7ff, (491 * 2) | OEBit, Instruction::divwo, AnalyzeForm::Dab },
+		{ 31, 0x7ff, (491 * 2) | OEBit | RcBit, Instruction::divwo_d, AnalyzeForm::Dab },
+
+		{ 31, 0x7ff, 459 * 2, Instruction::divwu, AnalyzeForm::Dab },
+		{ 31, 0x7ff, (459 * 2) | RcBit, Instruction::divwu_d, AnalyzeForm::Dab },
+		{ 31, 0x7ff, (459 * 2) | OEBit, Instruction::divwuo, AnalyzeForm::Dab },
+		{ 31, 0x7ff, (459 * 2) | OEBit | RcBit, Instruction::divwuo_d, AnalyzeForm::Dab },
+
+		{ 31, 0x7ff, 310 * 2, Instruction::eciwx, AnalyzeForm::Dab },
+		{ 31, 0x7ff, 438 * 2, Instruction::ecowx, AnalyzeForm::Dab },
+
+		{ 31, 0x7ff, 854 * 2, Instruction::eieio, AnalyzeForm::None },
+
+		{ 31, 0x7ff, 284 * 2, Instruction::eqv, AnalyzeForm::Asb },
+		{ 31, 0x7ff, (284 * 2) | RcBit, Instruction::eqv_d, AnalyzeForm::Asb },
+
+		{ 31, 0x7ff, 954 * 2, Instruction::extsb, AnalyzeForm::As },
+		{ 31, 0x7ff, (954 * 2) | RcBit, Instruction::extsb_d, AnalyzeForm::As },
+		{ 31, 0x7ff, 922 * 2, Instruction::extsh, AnalyzeForm::As },
+		{ 31, 0x7ff, (922 * 2) | RcBit, Instruction::extsh_d, AnalyzeForm::As },
+
+		{ 31, 0x7ff, 982 * 2, Instruction::icbi, AnalyzeForm::Ab },
+
+		{ 31, 0x7ff, 119 * 2, Instruction::lbzux, AnalyzeForm::Dab },
+		{ 31, 0x7ff, 87 * 2, Instruction::lbzx, AnalyzeForm::Dab },
+		{ 31, 0x7ff, 631 * 2, Instruction::lfdux, AnalyzeForm::FrDRegAb },
+		{ 31, 0x7ff, 599 * 2, Instruction::lfdx, AnalyzeForm::FrDRegAb },
+		{ 31, 0x7ff, 567 * 2, Instruction::lfsux, AnalyzeForm::FrDRegAb },
+		{ 31, 0x7ff, 535 * 2, Instruction::lfsx, AnalyzeForm::FrDRegAb },
+		{ 31, 0x7ff, 375 * 2, Instruction::lhaux, AnalyzeForm::Dab },
+		{ 31, 0x7ff, 343 * 2, Instruction::lhax, AnalyzeForm::Dab },
+		{ 31, 0x7ff, 790 * 2, Instruction::lhbrx, AnalyzeForm::Dab },
+		{ 31, 0x7ff, 311 * 2, Instruction::lhzux, AnalyzeForm::Dab },
+		{ 31, 0x7ff, 279 * 2, Instruction::lhzx, AnalyzeForm::Dab },
+		{ 31, 0x7ff, 597 * 2, Instruction::lswi, AnalyzeForm::DaNb },
+		{ 31, 0x7ff, 533 * 2, Instruction::lswx, AnalyzeForm::Dab },
+		{ 31, 0x7ff, 20 * 2, Instruction::lwarx, AnalyzeForm::Dab },
+		{ 31, 0x7ff, 534 * 2, Instruction::lwbrx, AnalyzeForm::Dab },
+		{ 31, 0x7ff, 55 * 2, Instruction::lwzux, AnalyzeForm::Dab },
+		{ 31, 0x7ff, 23 * 2, Instruction::lwzx, AnalyzeForm::Dab },
+
+		{ 31, 0x7ff, 512 * 2, Instruction::mcrxr, AnalyzeForm::Crfd },
+		{ 31, 0x7ff, 19 * 2, Instruction::mfcr, AnalyzeForm::D },
+		{ 31, 0x7ff, 83 * 2, Instruction::mfmsr, AnalyzeForm::D },
+		{ 31, 0x7ff, 339 * 2, Instruction::mfspr, AnalyzeForm::DSpr },
+		{ 31, 0x7ff, 595 * 2, Instruction::mfsr, AnalyzeForm::DSr },
+		{ 31, 0x7ff, 659 * 2, Instruction::mfsrin, AnalyzeForm::Db },
+		{ 31, 0x7ff, 371 * 2, Instruction::mftb, AnalyzeForm::DTbr },
+		{ 31, 0x7ff, 144 * 2, Instruction::mtcrf, AnalyzeForm::Crms },
+		{ 31, 0x7ff, 146 * 2, Instruction::mtmsr, AnalyzeForm::D },
+		{ 31, 0x7ff, 467 * 2, Instruction::mtspr, AnalyzeForm::SprS },
+		{ 31, 0x7ff, 210 * 2, Instruction::mtsr, AnalyzeForm::SrS },
+		{ 31, 0x7ff, 242 * 2, Instruction::mtsrin, AnalyzeForm::Db },
+
+		{ 31, 0x7ff, 75 * 2, Instruction::mulhw, AnalyzeForm::Dab },
+		{ 31, 0x7ff, (75 * 2) | RcBit, Instruction::mulhw_d, AnalyzeForm::Dab },
+		{ 31, 0x7ff, 11 * 2, Instruction::mulhwu, AnalyzeForm::Dab },
+		{ 31, 0x7ff, (11 * 2) | RcBit, Instruction::mulhwu_d, AnalyzeForm::Dab },
+
+		{ 31, 0x7ff, 235 * 2, Instruction::mullw, AnalyzeForm::Dab },
+		{ 31, 0x7ff, (235 * 2) | RcBit, Instruction::mullw_d, AnalyzeForm::Dab },
+		{ 31, 0x7ff, (235 * 2) | OEBit, Instruction::mullwo, AnalyzeForm::Dab },
+		{ 31, 0x7ff, (235 * 2) | OEBit | RcBit, Instruction::mullwo_d, AnalyzeForm::Dab },
+
+		{ 31, 0x7ff, 476 * 2, Instruction::nand, AnalyzeForm::Asb },
+		{ 31, 0x7ff, (476 * 2) | RcBit, Instruction::nand_d, AnalyzeForm::Asb },
+		{ 31, 0x7ff, 104 * 2, Instruction::neg, AnalyzeForm::Da },
+		{ 31, 0x7ff, (104 * 2) | RcBit, Instruction::neg_d, AnalyzeForm::Da },
+		{ 31, 0x7ff, (104 * 2) | OEBit, Instruction::nego, AnalyzeForm::Da },
+		{ 31, 0x7ff, (104 * 2) | OEBit | RcBit, Instruction::nego_d, AnalyzeForm::Da },
+		{ 31, 0x7ff, 124 * 2, Instruction::nor, AnalyzeForm::Asb },
+		{ 31, 0x7ff, (124 * 2) | RcBit, Instruction::nor_d, AnalyzeForm::Asb },
+		{ 31, 0x7ff, 444 * 2, Instruction::_or, AnalyzeForm::Asb },
+		{ 31, 0x7ff, (444 * 2) | RcBit, Instruction::or_d, AnalyzeForm::Asb },
+		{ 31, 0x7ff, 412 * 2, Instruction::orc, AnalyzeForm::Asb },
+		{ 31, 0x7ff, (412 * 2) | RcBit, Instruction::orc_d, AnalyzeForm::Asb },
+
+		{ 31, 0x7ff, 24 * 2, Instruction::slw, AnalyzeForm::Asb },
+		{ 31, 0x7ff, (24 * 2) | RcBit, Instruction::slw_d, AnalyzeForm::Asb },
+		{ 31, 0x7ff, 792 * 2, Instruction::sraw, AnalyzeForm::Asb },
+		{ 31, 0x7ff, (792 * 2) | RcBit, Instruction::sraw_d, AnalyzeForm::Asb },
+		{ 31, 0x7ff, 824 * 2, Instruction::srawi, AnalyzeForm::AsImm },
+		{ 31, 0x7ff, (824 * 2) | RcBit, Instruction::srawi_d, AnalyzeForm::AsImm },
+		{ 31, 0x7ff, 536 * 2, Instruction::srw, AnalyzeForm::Asb },
+		{ 31, 0x7ff, (536 * 2) | RcBit, Instruction::srw_d, AnalyzeForm::Asb },
+
+		{ 31, 0x7ff, 247 * 2, Instruction::stbux, AnalyzeForm::Dab },
+		{ 31, 0x7ff, 215 * 2, Instruction::stbx, AnalyzeForm::Dab },
+		{ 31, 0x7ff, 759 * 2, Instruction::stfdux, AnalyzeForm::FrDRegAb },
+		{ 31, 0x7ff, 727 * 2, Instruction::stfdx, AnalyzeForm::FrDRegAb },
+		{ 31, 0x7ff, 983 * 2, Instruction::stfiwx, AnalyzeForm::FrDRegAb },
+		{ 31, 0x7ff, 695 * 2, Instruction::stfsux, AnalyzeForm::FrDRegAb },
+		{ 31, 0x7ff, 663 * 2, Instruction::stfsx, AnalyzeForm::FrDRegAb },
+		{ 31, 0x7ff, 918 * 2, Instruction::sthbrx, AnalyzeForm::Dab },
+		{ 31, 0x7ff, 439 * 2, Instruction::sthux, AnalyzeForm::Dab },
+		{ 31, 0x7ff, 407 * 2, Instruction::sthx, AnalyzeForm::Dab },
+		{ 31, 0x7ff, 725 * 2, Instruction::stswi, AnalyzeForm::SaImm },
+		{ 31, 0x7ff, 661 * 2, Instruction::stswx, AnalyzeForm::Dab },
+		{ 31, 0x7ff, 662 * 2, Instruction::stwbrx, AnalyzeForm::Dab },
+		{ 31, 0x7ff, (150 * 2) | RcBit, Instruction::stwcx_d, AnalyzeForm::Dab },
+		{ 31, 0x7ff, 183 * 2, Instruction::stwux, AnalyzeForm::Dab },
+		{ 31, 0x7ff, 151 * 2, Instruction::stwux, AnalyzeForm::Dab },
+
+		{ 31, 0x7ff, 40 * 2, Instruction::subf, AnalyzeForm::Dab },
+		{ 31, 0x7ff, (40 * 2) | RcBit, Instruction::subf_d, AnalyzeForm::Dab },
+		{ 31, 0x7ff, (40 * 2) | OEBit, Instruction::subfo, AnalyzeForm::Dab },
+		{ 31, 0x7ff, (40 * 2) | OEBit | RcBit, Instruction::subfo_d, AnalyzeForm::Dab },
+		{ 31, 0x7ff, 8 * 2, Instruction::subfc, AnalyzeForm::Dab },
+		{ 31, 0x7ff, (8 * 2) | RcBit, Instruction::subfc_d, AnalyzeForm::Dab },
+		{ 31, 0x7ff, (8 * 2) | OEBit, Instruction::subfco, AnalyzeForm::Dab },
+		{ 31, 0x7ff, (8 * 2) | OEBit | RcBit, Instruction::subfco_d, AnalyzeForm::Dab },
+		{ 31, 0x7ff, 136 * 2, Instruction::subfe, AnalyzeForm::Dab },
+		{ 31, 0x7ff, (136 * 2) | RcBit, Instruction::subfe_d, AnalyzeForm::Dab },
+		{ 31, 0x7ff, (136 * 2) | OEBit, Instruction::subfeo, AnalyzeForm::Dab },
+		{ 31, 0x7ff, (136 * 2) | OEBit | RcBit, Instruction::subfeo_d, AnalyzeForm::Dab },
+
+		{ 31, 0x7ff, 232 * 2, Instruction::subfme, AnalyzeForm::Da },
+		{ 31, 0x7ff, (232 * 2) | RcBit, Instruction::subfme_d, AnalyzeForm::Da },
+		{ 31, 0x7ff, (232 * 2) | OEBit, Instruction::subfmeo, AnalyzeForm::Da },
+		{ 31, 0x7ff, (232 * 2) | OEBit | RcBit, Instruction::subfmeo_d, AnalyzeForm::Da },
+
+		{ 31, 0x7ff, 200 * 2, Instruction::subfze, AnalyzeForm::Da },
+		{ 31, 0x7ff, (200 * 2) | RcBit, Instruction::subfze_d, AnalyzeForm::Da },
+		{ 31, 0x7ff, (200 * 2) | OEBit, Instruction::subfzeo, AnalyzeForm::Da },
+		{ 31, 0x7ff, (200 * 2) | OEBit | RcBit, Instruction::subfzeo_d, AnalyzeForm::Da },
+
+		{ 31, 0x7ff, 598 * 2, Instruction::sync, AnalyzeForm::None },
+		{ 31, 0x7ff, 306 * 2, Instruction::tlbie, AnalyzeForm::B },
+		{ 31, 0x7ff, 566 * 2, Instruction::tlbsync, AnalyzeForm::None },
+		{ 31, 0x7ff, 4 * 2, Instruction::tw, AnalyzeForm::ImmAb, DecodeFlow },
+
+		{ 31, 0x7ff, 316 * 2, Instruction::_xor, AnalyzeForm::Asb },
+		{ 31, 0x7ff, (316 * 2) | RcBit, Instruction::xor_d, AnalyzeForm::Asb },
+
+		// Primary 59
+
+		{ 59, 0x3f, 21 * 2, Instruction::fadds, AnalyzeForm::FrDab },
+		{ 59, 0x3f, (21 * 2) | RcBit, Instruction::fadds_d, AnalyzeForm::FrDab },
+
+		{ 59, 0x3f, 18 * 2, Instruction::fdivs, AnalyzeForm::FrDab },
+		{ 59, 0x3f, (18 * 2) | RcBit, Instruction::fdivs_d, AnalyzeForm::FrDab },
+
+		{ 59, 0x3f, 29 * 2, Instruction::fmadds, AnalyzeForm::FrDacb },
+		{ 59, 0x3f, (29 * 2) | RcBit, Instruction::fmadds_d, AnalyzeForm::FrDacb },
+
+		{ 59, 0x3f, 28 * 2, Instruction::fmsubs, AnalyzeForm::FrDacb },
+		{ 59, 0x3f, (28 * 2) | RcBit, Instruction::fmsubs_d, AnalyzeForm::FrDacb },
+
+		{ 59, 0x3f, 25 * 2, Instruction::fmuls, AnalyzeForm::FrDac },
+		{ 59, 0x3f, (25 * 2) | RcBit, Instruction::fmuls_d, AnalyzeForm::FrDac },
+
+		{ 59, 0x3f, 31 * 2, Instruction::fnmadds, AnalyzeForm::FrDacb },
+		{ 59, 0x3f, (31 * 2) | RcBit, Instruction::fnmadds_d, AnalyzeForm::FrDacb },
+
+		{ 59, 0x3f, 30 * 2, Instruction::fnmsubs, AnalyzeForm::FrDacb },
+		{ 59, 0x3f, (30 * 2) | RcBit, Instruction::fnmsubs_d, AnalyzeForm::FrDacb },
+
+		{ 59, 0x3f, 24 * 2, Instruction::fres, AnalyzeForm::FrDb },
+		{ 59, 0x3f, (24 * 2) | RcBit, Instruction::fres_d, AnalyzeForm::FrDb },
+
+		{ 59, 0x3f, 20 * 2, Instruction::fsubs, AnalyzeForm::FrDab },
+		{ 59, 0x3f, (20 * 2) | RcBit, Instruction::fsubs_d, AnalyzeForm::FrDab },
+
+		// Primary 63
+
+		// A-form (the extended opcode is 5 bits, frC is in the way) comes first
+
+		{ 63, 0x3f, 29 * 2, Instruction::fmadd, AnalyzeForm::FrDacb },
+		{ 63, 0x3f, (29 * 2) | RcBit, Instruction::fmadd_d, AnalyzeForm::FrDacb },
+		{ 63, 0x3f, 28 * 2, Instruction::fmsub, AnalyzeForm::FrDacb },
+		{ 63, 0x3f, (28 * 2) | RcBit, Instruction::fmsub_d, AnalyzeForm::FrDacb },
+		{ 63, 0x3f, 25 * 2, Instruction::fmul, AnalyzeForm::FrDac },
+		{ 63, 0x3f, (25 * 2) | RcBit, Instruction::fmul_d, AnalyzeForm::FrDac },
+		{ 63, 0x3f, 31 * 2, Instruction::fnmadd, AnalyzeForm::FrDacb },
+		{ 63, 0x3f, (31 * 2) | RcBit, Instruction::fnmadd_d, AnalyzeForm::FrDacb },
+		{ 63, 0x3f, 30 * 2, Instruction::fnmsub, AnalyzeForm::FrDacb },
+		{ 63, 0x3f, (30 * 2) | RcBit, Instruction::fnmsub_d, AnalyzeForm::FrDacb },
+		{ 63, 0x3f, 23 * 2, Instruction::fsel, AnalyzeForm::FrDacb },
+		{ 63, 0x3f, (23 * 2) | RcBit, Instruction::fsel_d, AnalyzeForm::FrDacb },
+
+		{ 63, 0x7ff, 264 * 2, Instruction::fabs, AnalyzeForm::FrDb },
+		{ 63, 0x7ff, (264 * 2) | RcBit, Instruction::fabs_d, AnalyzeForm::FrDb },
+
+		{ 63, 0x7ff, 21 * 2, Instruction::fadd, AnalyzeForm::FrDab },
+		{ 63, 0x7ff, (21 * 2) | RcBit, Instruction::fadd_d, AnalyzeForm::FrDab },
+
+		{ 63, 0x7ff, 32 * 2, Instruction::fcmpo, AnalyzeForm::CrfdFrAb },
+		{ 63, 0x7ff, 0, Instruction::fcmpu, AnalyzeForm::CrfdFrAb },
+
+		{ 63, 0x7ff, 14 * 2, Instruction::fctiw, AnalyzeForm::FrDb },
+		{ 63, 0x7ff, (14 * 2) | RcBit, Instruction::fctiw_d, AnalyzeForm::FrDb },
+		{ 63, 0x7ff, 15 * 2, Instruction::fctiwz, AnalyzeForm::FrDb },
+		{ 63, 0x7ff, (15 * 2) | RcBit, Instruction::fctiwz_d, AnalyzeForm::FrDb },
+
+		{ 63, 0x7ff, 18 * 2, Instruction::fdiv, AnalyzeForm::FrDab },
+		{ 63, 0x7ff, (18 * 2) | RcBit, Instruction::fdiv_d, AnalyzeForm::FrDab },
+
+		{ 63, 0x7ff, 72 * 2, Instruction::fmr, AnalyzeForm::FrDb },
+		{ 63, 0x7ff, (72 * 2) | RcBit, Instruction::fmr_d, AnalyzeForm::FrDb },
+
+		{ 63, 0x7ff, 136 * 2, Instruction::fnabs, AnalyzeForm::FrDb },
+		{ 63, 0x7ff, (136 * 2) | RcBit, Instruction::fnabs_d, AnalyzeForm::FrDb },
+
+		{ 63, 0x7ff, 40 * 2, Instruction::fneg, AnalyzeForm::FrDb },
+		{ 63, 0x7ff, (40 * 2) | RcBit, Instruction::fneg_d, AnalyzeForm::FrDb },
+
+		{ 63, 0x7ff, 12 * 2, Instruction::frsp, AnalyzeForm::FrDb },
+		{ 63, 0x7ff, (12 * 2) | RcBit, Instruction::frsp_d, AnalyzeForm::FrDb },
+
+		{ 63, 0x7ff, 26 * 2, Instruction::frsqrte, AnalyzeForm::FrDb },
+		{ 63, 0x7ff, (26 * 2) | RcBit, Instruction::frsqrte_d, AnalyzeForm::FrDb },
+
+		{ 63, 0x7ff, 20 * 2, Instruction::fsub, AnalyzeForm::FrDab },
+		{ 63, 0x7ff, (20 * 2) | RcBit, Instruction::fsub_d, AnalyzeForm::FrDab },
+
+		{ 63, 0x7ff, 64 * 2, Instruction::mcrfs, AnalyzeForm::Crfds },
+
+		{ 63, 0x7ff, 583 * 2, Instruction::mffs, AnalyzeForm::Frd },
+		{ 63, 0x7ff, (583 * 2) | RcBit, Instruction::mffs_d, AnalyzeForm::Frd },
+
+		{ 63, 0x7ff, 70 * 2, Instruction::mtfsb0, AnalyzeForm::Crbd },
+		{ 63, 0x7ff, (70 * 2) | RcBit, Instruction::mtfsb0_d, AnalyzeForm::Crbd },
+		{ 63, 0x7ff, 38 * 2, Instruction::mtfsb1, AnalyzeForm::Crbd },
+		{ 63, 0x7ff, (38 * 2) | RcBit, Instruction::mtfsb1_d, AnalyzeForm::Crbd },
+		{ 63, 0x7ff, 711 * 2, Instruction::mtfsf, AnalyzeForm::FmFrb },
+		{ 63, 0x7ff, (711 * 2) | RcBit, Instruction::mtfsf_d, AnalyzeForm::FmFrb },
+		{ 63, 0x7ff, 134 * 2, Instruction::mtfsfi, AnalyzeForm::CrfdImm },
+		{ 63, 0x7ff, (134 * 2) | RcBit, Instruction::mtfsfi_d, AnalyzeForm::CrfdImm },
+
+		// Primary 4
+
+		// Indexed PS Load/Store first, then A-form, then the rest
+
+		{ 4, 0x7f, 38 * 2, Instruction::psq_lux, AnalyzeForm::FrAbWi },
+		{ 4, 0x7f, 6 * 2, Instruction::psq_lx, AnalyzeForm::FrAbWi },
+		{ 4, 0x7f, 39 * 2, Instruction::psq_stux, AnalyzeForm::FrAbWi },
+		{ 4, 0x7f, 7 * 2, Instruction::psq_stx, AnalyzeForm::FrAbWi },
+
+		{ 4, 0x3f, 29 * 2, Instruction::ps_madd, AnalyzeForm::FrDacb },
+		{ 4, 0x3f, (29 * 2) | RcBit, Instruction::ps_madd_d, AnalyzeForm::FrDacb },
+		{ 4, 0x3f, 14 * 2, Instruction::ps_madds0, AnalyzeForm::FrDacb },
+		{ 4, 0x3f, (14 * 2) | RcBit, Instruction::ps_madds0_d, AnalyzeForm::FrDacb },
+		{ 4, 0x3f, 15 * 2, Instruction::ps_madds1, AnalyzeForm::FrDacb },
+		{ 4, 0x3f, (15 * 2) | RcBit, Instruction::ps_madds1_d, AnalyzeForm::FrDacb },
+		{ 4, 0x3f, 28 * 2, Instruction::ps_msub, AnalyzeForm::FrDacb },
+		{ 4, 0x3f, (28 * 2) | RcBit, Instruction::ps_msub_d, AnalyzeForm::FrDacb },
+		{ 4, 0x3f, 25 * 2, Instruction::ps_mul, AnalyzeForm::FrDac },
+		{ 4, 0x3f, (25 * 2) | RcBit, Instruction::ps_mul_d, AnalyzeForm::FrDac },
+		{ 4, 0x3f, 12 * 2, Instruction::ps_muls0, AnalyzeForm::FrDac },
+		{ 4, 0x3f, (12 * 2) | RcBit, Instruction::ps_muls0_d, AnalyzeForm::FrDac },
+		{ 4, 0x3f, 13 * 2, Instruction::ps_muls1, AnalyzeForm::FrDac },
+		{ 4, 0x3f, (13 * 2) | RcBit, Instruction::ps_muls1_d, AnalyzeForm::FrDac },
+		{ 4, 0x3f, 31 * 2, Instruction::ps_nmadd, AnalyzeForm::FrDacb },
+		{ 4, 0x3f, (31 * 2) | RcBit, Instruction::ps_nmadd_d, AnalyzeForm::FrDacb },
+		{ 4, 0x3f, 30 * 2, Instruction::ps_nmsub, AnalyzeForm::FrDacb },
+		{ 4, 0x3f, (30 * 2) | RcBit, Instruction::ps_nmsub_d, AnalyzeForm::FrDacb },
+		{ 4, 0x3f, 23 * 2, Instruction::ps_sel, AnalyzeForm::FrDacb },
+		{ 4, 0x3f, (23 * 2) | RcBit, Instruction::ps_sel_d, AnalyzeForm::FrDacb },
+		{ 4, 0x3f, 10 * 2, Instruction::ps_sum0, AnalyzeForm::FrDacb },
+		{ 4, 0x3f, (10 * 2) | RcBit, Instruction::ps_sum0_d, AnalyzeForm::FrDacb },
+		{ 4, 0x3f, 11 * 2, Instruction::ps_sum1, AnalyzeForm::FrDacb },
+		{ 4, 0x3f, (11 * 2) | RcBit, Instruction::ps_sum1_d, AnalyzeForm::FrDacb },
+
+		{ 4, 0x7ff, 1014 * 2, Instruction::dcbz_l, AnalyzeForm::Ab },
+
+		{ 4, 0x7ff, 264 * 2, Instruction::ps_abs, AnalyzeForm::FrDb },
+		{ 4, 0x7ff, (264 * 2) | RcBit, Instruction::ps_abs_d, AnalyzeForm::FrDb },
+		{ 4, 0x7ff, 21 * 2, Instruction::ps_add, AnalyzeForm::FrDab },
+		{ 4, 0x7ff, (21 * 2) | RcBit, Instruction::ps_add_d, AnalyzeForm::FrDab },
+		{ 4, 0x7ff, 32 * 2, Instruction::ps_cmpo0, AnalyzeForm::CrfdFrAb },
+		{ 4, 0x7ff, 96 * 2, Instruction::ps_cmpo1, AnalyzeForm::CrfdFrAb },
+		{ 4, 0x7ff, 0, Instruction::ps_cmpu0, AnalyzeForm::CrfdFrAb },
+		{ 4, 0x7ff, 64 * 2, Instruction::ps_cmpu1, AnalyzeForm::CrfdFrAb },
+		{ 4, 0x7ff, 18 * 2, Instruction::ps_div, AnalyzeForm::FrDab },
+		{ 4, 0x7ff, (18 * 2) | RcBit, Instruction::ps_div_d, AnalyzeForm::FrDab },
+		{ 4, 0x7ff, 528 * 2, Instruction::ps_merge00, AnalyzeForm::FrDab },
+		{ 4, 0x7ff, (528 * 2) | RcBit, Instruction::ps_merge00_d, AnalyzeForm::FrDab },
+		{ 4, 0x7ff, 560 * 2, Instruction::ps_merge01, AnalyzeForm::FrDab },
+		{ 4, 0x7ff, (560 * 2) | RcBit, Instruction::ps_merge01_d, AnalyzeForm::FrDab },
+		{ 4, 0x7ff, 592 * 2, Instruction::ps_merge10, AnalyzeForm::FrDab },
+		{ 4, 0x7ff, (592 * 2) | RcBit, Instruction::ps_merge10_d, AnalyzeForm::FrDab },
+		{ 4, 0x7ff, 624 * 2, Instruction::ps_merge11, AnalyzeForm::FrDab },
+		{ 4, 0x7ff, (624 * 2) | RcBit, Instruction::ps_merge11_d, AnalyzeForm::FrDab },
+		{ 4, 0x7ff, 72 * 2, Instruction::ps_mr, AnalyzeForm::FrDb },
+		{ 4, 0x7ff, (72 * 2) | RcBit, Instruction::ps_mr_d, AnalyzeForm::FrDb },
+		{ 4, 0x7ff, 136 * 2, Instruction::ps_nabs, AnalyzeForm::FrDb },
+		{ 4, 0x7ff, (136 * 2) | RcBit, Instruction::ps_nabs_d, AnalyzeForm::FrDb },
+		{ 4, 0x7ff, 40 * 2, Instruction::ps_neg, AnalyzeForm::FrDb },
+		{ 4, 0x7ff, (40 * 2) | RcBit, Instruction::ps_neg_d, AnalyzeForm::FrDb },
+		{ 4, 0x7ff, 24 * 2, Instruction::ps_res, AnalyzeForm::FrDb },
+		{ 4, 0x7ff, (24 * 2) | RcBit, Instruction::ps_res_d, AnalyzeForm::FrDb },
+		{ 4, 0x7ff, 26 * 2, Instruction::ps_rsqrte, AnalyzeForm::FrDb },
+		{ 4, 0x7ff, (26 * 2) | RcBit, Instruction::ps_rsqrte_d, AnalyzeForm::FrDb },
+		{ 4, 0x7ff, 20 * 2, Instruction::ps_sub, AnalyzeForm::FrDab },
+		{ 4, 0x7ff, (20 * 2) | RcBit, Instruction::ps_sub_d, AnalyzeForm::FrDab },
+	};
+
+	struct DecodeSlice
+	{
+		uint32_t base;
+		uint32_t mask;
+	};
+
+	struct DecodeLayout
+	{
+		DecodeSlice slice[64];
+		size_t size;
+	};
+
+	// Each primary opcode gets a slice of mask + 1 entries, where mask is the union of the masks of its rules.
+	// The entry index is base + (instr & mask).
+
+	static constexpr DecodeLayout MakeDecodeLayout()
+	{
+		DecodeLayout layout = {};
+
+		for (const DecodeRule& rule : decodeRules)
 		{
-			case 12: info->instr = Instruction::addic; DaSimm(instr, info); break;
-			case 13: info->instr = Instruction::addic_d; DaSimm(instr, info); break;
-			case 14: info->instr = Instruction::addi; DaSimm(instr, info); break;
-			case 15: info->instr = Instruction::addis; DaSimm(instr, info); break;
-			case 16:
-				switch (instr & 3)
-				{
-					case 0: info->instr = Instruction::bc; break;
-					case 1: info->instr = Instruction::bcl; break;
-					case 2: info->instr = Instruction::bca; break;
-					case 3: info->instr = Instruction::bcla; break;
-				}
-				BoBiTargetAddr(instr, info);
-				break;
-			case 18:
-				switch (instr & 3)
-				{
-					case 0: info->instr = Instruction::b; break;
-					case 1: info->instr = Instruction::bl; break;
-					case 2: info->instr = Instruction::ba; break;
-					case 3: info->instr = Instruction::bla; break;
-				}
-				TargetAddr(instr, info);
-				break;
-			case 28: info->instr = Instruction::andi_d; AsUimm(instr, info); break;
-			case 29: info->instr = Instruction::andis_d; AsUimm(instr, info); break;
-			case 11:
-				if ((DIS_RD & 1) == 0)
-				{
-					info->instr = Instruction::cmpi; CrfDaSimm(instr, info);
-				}
-				break;
-			case 10:
-				if ((DIS_RD & 1) == 0)
-				{
-					info->instr = Instruction::cmpli; CrfDaUimm(instr, info);
-				}
-				break;
-
-			case 34: info->instr = Instruction::lbz; DaOffset(instr, info); break;
-			case 35: info->instr = Instruction::lbzu; DaOffset(instr, info); break;
-			case 50: info->instr = Instruction::lfd; FrdaOffset(instr, info); break;
-			case 51: info->instr = Instruction::lfdu; FrdaOffset(instr, info); break;
-			case 48: info->instr = Instruction::lfs; FrdaOffset(instr, info); break;
-			case 49: info->instr = Instruction::lfsu; FrdaOffset(instr, info); break;
-			case 42: info->instr = Instruction::lha; DaOffset(instr, info); break;
-			case 43: info->instr = Instruction::lhau; DaOffset(instr, info); break;
-			case 40: info->instr = Instruction::lhz; DaOffset(instr, info); break;
-			case 41: info->instr = Instruction::lhzu; DaOffset(instr, info); break;
-			case 46: info->instr = Instruction::lmw; DaOffset(instr, info); break;
-			case 32: info->instr = Instruction::lwz; DaOffset(instr, info); break;
-			case 33: info->instr = Instruction::lwzu; DaOffset(instr, info); break;
-
-			case 7: info->instr = Instruction::mulli; DaSimm(instr, info); break;
-			case 24: info->instr = Instruction::ori; AsUimm(instr, info); break;
-			case 25: info->instr = Instruction::oris; AsUimm(instr, info); break;
-
-			case 56: info->instr = Instruction::psq_l; FrRegOffsetWi(instr, info); break;
-			case 57: info->instr = Instruction::psq_lu; FrRegOffsetWi(instr, info); break;
-			case 60: info->instr = Instruction::psq_st; FrRegOffsetWi(instr, info); break;
-			case 61: info->instr = Instruction::psq_stu; FrRegOffsetWi(instr, info); break;
-
-			case 20:
-				if (Rc) info->instr = Instruction::rlwimi_d;
-				else  info->instr = Instruction::rlwimi;
-				AsImm3(instr, info);
-				break;
-			case 21:
-				if (Rc) info->instr = Instruction::rlwinm_d;
-				else  info->instr = Instruction::rlwinm;
-				AsImm3(instr, info);
-				break;
-			case 23:
-				if (Rc) info->instr = Instruction::rlwnm_d;
-				else  info->instr = Instruction::rlwnm;
-				AsbImm2(instr, info);
-				break;
-
-			case 17:
-				if (instr & 2)
-				{
-					info->instr = Instruction::sc;
-					info->flow = true;
-				}
-				break;
-
-			case 38: info->instr = Instruction::stb; DaOffset(instr, info); break;
-			case 39: info->instr = Instruction::stbu; DaOffset(instr, info); break;
-			case 54: info->instr = Instruction::stfd; FrdaOffset(instr, info); break;
-			case 55: info->instr = Instruction::stfdu; FrdaOffset(instr, info); break;
-			case 52: info->instr = Instruction::stfs; FrdaOffset(instr, info); break;
-			case 53: info->instr = Instruction::stfsu; FrdaOffset(instr, info); break;
-			case 44: info->instr = Instruction::sth; DaOffset(instr, info); break;
-			case 45: info->instr = Instruction::sthu; DaOffset(instr, info); break;
-			case 47: info->instr = Instruction::stmw; DaOffset(instr, info); break;
-			case 36: info->instr = Instruction::stw; DaOffset(instr, info); break;
-			case 37: info->instr = Instruction::stwu; DaOffset(instr, info); break;
-
-			case 8: info->instr = Instruction::subfic; DaSimm(instr, info); break;
-
-			case 3: info->instr = Instruction::twi; ImmASimm(instr, info); info->flow = true; break;
-
-			case 26: info->instr = Instruction::xori; AsUimm(instr, info); break;
-			case 27: info->instr = Instruction::xoris; AsUimm(instr, info); break;
-		}
-	}
-
-	void Analyzer::OpMainFast(uint32_t instr, AnalyzeInfo* info)
-	{
-		switch (instr >> 26)
-		{
-			case 12: info->instr = Instruction::addic; DaSimmFast(instr, info); break;
-			case 13: info->instr = Instruction::addic_d; DaSimmFast(instr, info); break;
-			case 14: info->instr = Instruction::addi; DaSimmFast(instr, info); break;
-			case 15: info->instr = Instruction::addis; DaSimmFast(instr, info); break;
-			case 16:
-				switch (instr & 3)
-				{
-					case 0: info->instr = Instruction::bc; break;
-					case 1: info->instr = Instruction::bcl; break;
-					case 2: info->instr = Instruction::bca; break;
-					case 3: info->instr = Instruction::bcla; break;
-				}
-				BoBiTargetAddrFast(instr, info);
-				break;
-			case 18:
-				switch (instr & 3)
-				{
-					case 0: info->instr = Instruction::b; break;
-					case 1: info->instr = Instruction::bl; break;
-					case 2: info->instr = Instruction::ba; break;
-					case 3: info->instr = Instruction::bla; break;
-				}
-				TargetAddrFast(instr, info);
-				break;
-			case 28: info->instr = Instruction::andi_d; AsUimmFast(instr, info); break;
-			case 29: info->instr = Instruction::andis_d; AsUimmFast(instr, info); break;
-			case 11:
-				if ((DIS_RD & 1) == 0)
-				{
-					info->instr = Instruction::cmpi; CrfDaSimmFast(instr, info);
-				}
-				break;
-			case 10:
-				if ((DIS_RD & 1) == 0)
-				{
-					info->instr = Instruction::cmpli; CrfDaUimmFast(instr, info);
-				}
-				break;
-
-			case 34: info->instr = Instruction::lbz; DaOffsetFast(instr, info); break;
-			case 35: info->instr = Instruction::lbzu; DaOffsetFast(instr, info); break;
-			case 50: info->instr = Instruction::lfd; FrdaOffsetFast(instr, info); break;
-			case 51: info->instr = Instruction::lfdu; FrdaOffsetFast(instr, info); break;
-			case 48: info->instr = Instruction::lfs; FrdaOffsetFast(instr, info); break;
-			case 49: info->instr = Instruction::lfsu; FrdaOffsetFast(instr, info); break;
-			case 42: info->instr = Instruction::lha; DaOffsetFast(instr, info); break;
-			case 43: info->instr = Instruction::lhau; DaOffsetFast(instr, info); break;
-			case 40: info->instr = Instruction::lhz; DaOffsetFast(instr, info); break;
-			case 41: info->instr = Instruction::lhzu; DaOffsetFast(instr, info); break;
-			case 46: info->instr = Instruction::lmw; DaOffsetFast(instr, info); break;
-			case 32: info->instr = Instruction::lwz; DaOffsetFast(instr, info); break;
-			case 33: info->instr = Instruction::lwzu; DaOffsetFast(instr, info); break;
-
-			case 7: info->instr = Instruction::mulli; DaSimmFast(instr, info); break;
-			case 24: info->instr = Instruction::ori; AsUimmFast(instr, info); break;
-			case 25: info->instr = Instruction::oris; AsUimmFast(instr, info); break;
-
-			case 56: info->instr = Instruction::psq_l; FrRegOffsetWiFast(instr, info); break;
-			case 57: info->instr = Instruction::psq_lu; FrRegOffsetWiFast(instr, info); break;
-			case 60: info->instr = Instruction::psq_st; FrRegOffsetWiFast(instr, info); break;
-			case 61: info->instr = Instruction::psq_stu; FrRegOffsetWiFast(instr, info); break;
-
-			case 20:
-				if (Rc) info->instr = Instruction::rlwimi_d;
-				else  info->instr = Instruction::rlwimi;
-				AsImm3Fast(instr, info);
-				break;
-			case 21:
-				if (Rc) info->instr = Instruction::rlwinm_d;
-				else  info->instr = Instruction::rlwinm;
-				AsImm3Fast(instr, info);
-				break;
-			case 23:
-				if (Rc) info->instr = Instruction::rlwnm_d;
-				else  info->instr = Instruction::rlwnm;
-				AsbImm2Fast(instr, info);
-				break;
-
-			case 17:
-				if (instr & 2)
-				{
-					info->instr = Instruction::sc;
-					info->flow = true;
-				}
-				break;
-
-			case 38: info->instr = Instruction::stb; DaOffsetFast(instr, info); break;
-			case 39: info->instr = Instruction::stbu; DaOffsetFast(instr, info); break;
-			case 54: info->instr = Instruction::stfd; FrdaOffsetFast(instr, info); break;
-			case 55: info->instr = Instruction::stfdu; FrdaOffsetFast(instr, info); break;
-			case 52: info->instr = Instruction::stfs; FrdaOffsetFast(instr, info); break;
-			case 53: info->instr = Instruction::stfsu; FrdaOffsetFast(instr, info); break;
-			case 44: info->instr = Instruction::sth; DaOffsetFast(instr, info); break;
-			case 45: info->instr = Instruction::sthu; DaOffsetFast(instr, info); break;
-			case 47: info->instr = Instruction::stmw; DaOffsetFast(instr, info); break;
-			case 36: info->instr = Instruction::stw; DaOffsetFast(instr, info); break;
-			case 37: info->instr = Instruction::stwu; DaOffsetFast(instr, info); break;
-
-			case 8: info->instr = Instruction::subfic; DaSimmFast(instr, info); break;
-
-			case 3: info->instr = Instruction::twi; ImmASimmFast(instr, info); info->flow = true; break;
-
-			case 26: info->instr = Instruction::xori; AsUimmFast(instr, info); break;
-			case 27: info->instr = Instruction::xoris; AsUimmFast(instr, info); break;
+			layout.slice[rule.primary].mask |= rule.mask;
 		}
-	}
 
-	#pragma region "Primary 19"
-
-	void Analyzer::Op19(uint32_t instr, AnalyzeInfo* info)
-	{
-		switch (instr & 0x7ff)
+		for (size_t n = 0; n < 64; n++)
 		{
-			case 528 * 2: info->instr = Instruction::bcctr; BoBi(instr, info); break;
-			case (528 * 2) | LKBit: info->instr = Instruction::bcctrl; BoBi(instr, info); break;
-
-			case 16 * 2: info->instr = Instruction::bclr; BoBi(instr, info); break;
-			case (16 * 2) | LKBit: info->instr = Instruction::bclrl; BoBi(instr, info); break;
-
-			case 257 * 2: info->instr = Instruction::crand; CrbDab(instr, info); break;
-			case 129 * 2: info->instr = Instruction::crandc; CrbDab(instr, info); break;
-			case 289 * 2: info->instr = Instruction::creqv; CrbDab(instr, info); break;
-			case 225 * 2: info->instr = Instruction::crnand; CrbDab(instr, info); break;
-			case 33 * 2: info->instr = Instruction::crnor; CrbDab(instr, info); break;
-			case 449 * 2: info->instr = Instruction::cror; CrbDab(instr, info); break;
-			case 417 * 2: info->instr = Instruction::crorc; CrbDab(instr, info); break;
-			case 193 * 2: info->instr = Instruction::crxor; CrbDab(instr, info); break;
-
-			case 150 * 2: info->instr = Instruction::isync; break;
-
-			case 0: info->instr = Instruction::mcrf; Crfds(instr, info); break;
-
-			case 50 * 2: info->instr = Instruction::rfi; info->flow = true; break;
+			layout.slice[n].base = (uint32_t)layout.size;
+			layout.size += (size_t)layout.slice[n].mask + 1;
 		}
-	}
-
-	void Analyzer::Op19Fast(uint32_t instr, AnalyzeInfo* info)
-	{
-		switch (instr & 0x7ff)
-		{
-			case 528 * 2: info->instr = Instruction::bcctr; BoBiFast(instr, info); break;
-			case (528 * 2) | LKBit: info->instr = Instruction::bcctrl; BoBiFast(instr, info); break;
-
-			case 16 * 2: info->instr = Instruction::bclr; BoBiFast(instr, info); break;
-			case (16 * 2) | LKBit: info->instr = Instruction::bclrl; BoBiFast(instr, info); break;
 
-			case 257 * 2: info->instr = Instruction::crand; CrbDabFast(instr, info); break;
-			case 129 * 2: info->instr = Instruction::crandc; CrbDabFast(instr, info); break;
-			case 289 * 2: info->instr = Instruction::creqv; CrbDabFast(instr, info); break;
-			case 225 * 2: info->instr = Instruction::crnand; CrbDabFast(instr, info); break;
-			case 33 * 2: info->instr = Instruction::crnor; CrbDabFast(instr, info); break;
-			case 449 * 2: info->instr = Instruction::cror; CrbDabFast(instr, info); break;
-			case 417 * 2: info->instr = Instruction::crorc; CrbDabFast(instr, info); break;
-			case 193 * 2: info->instr = Instruction::crxor; CrbDabFast(instr, info); break;
-
-			case 150 * 2: info->instr = Instruction::isync; break;
-
-			case 0: info->instr = Instruction::mcrf; CrfdsFast(instr, info); break;
-
-			case 50 * 2: info->instr = Instruction::rfi; info->flow = true; break;
-		}
+		return layout;
 	}
 
-	#pragma endregion "Primary 19"
+	static constexpr DecodeLayout decodeLayout = MakeDecodeLayout();
 
-	#pragma region "Primary 31"
-
-	void Analyzer::Op31(uint32_t instr, AnalyzeInfo* info)
+	struct DecodeEntry
 	{
-		switch (instr & 0x7ff)
-		{
-			case 266 * 2: info->instr = Instruction::add; Dab(instr, info); break;
-			case (266 * 2) | RcBit: info->instr = Instruction::add_d; Dab(instr, info); break;
-			case (266 * 2) | OEBit: info->instr = Instruction::addo; Dab(instr, info); break;
-			case (266 * 2) | OEBit | RcBit: info->instr = Instruction::addo_d; Dab(instr, info); break;
-
-			case 10 * 2: info->instr = Instruction::addc; Dab(instr, info); break;
-			case (10 * 2) | RcBit: info->instr = Instruction::addc_d; Dab(instr, info); break;
-			case (10 * 2) | OEBit: info->instr = Instruction::addco; Dab(instr, info); break;
-			case (10 * 2) | OEBit | RcBit: info->instr = Instruction::addco_d; Dab(instr, info); break;
-
-			case 138 * 2: info->instr = Instruction::adde; Dab(instr, info); break;
-			case (138 * 2) | RcBit: info->instr = Instruction::adde_d; Dab(instr, info); break;
-			case (138 * 2) | OEBit: info->instr = Instruction::addeo; Dab(instr, info); break;
-			case (138 * 2) | OEBit | RcBit: info->instr = Instruction::addeo_d; Dab(instr, info); break;
-
-			case 234 * 2: info->instr = Instruction::addme; Da(instr, info); break;
-			case (234 * 2) | RcBit: info->instr = Instruction::addme_d; Da(instr, info); break;
-			case (234 * 2) | OEBit: info->instr = Instruction::addmeo; Da(instr, info); break;
-			case (234 * 2) | OEBit | RcBit: info->instr = Instruction::addmeo_d; Da(instr, info); break;
-
-			case 202 * 2: info->instr = Instruction::addze; Da(instr, info); break;
-			case (202 * 2) | RcBit: info->instr = Instruction::addze_d; Da(instr, info); break;
-			case (202 * 2) | OEBit: info->instr = Instruction::addzeo; Da(instr, info); break;
-			case (202 * 2) | OEBit | RcBit: info->instr = Instruction::addzeo_d; Da(instr, info); break;
-
-			case 28 * 2: info->instr = Instruction::_and; Asb(instr, info); break;
-			case (28 * 2) | RcBit: info->instr = Instruction::and_d; Asb(instr, info); break;
-
-			case 60 * 2: info->instr = Instruction::andc; Asb(instr, info); break;
-			case (60 * 2) | RcBit: info->instr = Instruction::andc_d; Asb(instr, info); break;
-
-			case 0: 
-				if ((DIS_RD & 1) == 0)
-				{
-					info->instr = Instruction::cmp; CrfDab(instr, info);
-				}
-				break;
+		int16_t instr;
+		AnalyzeForm form;
+		uint8_t flags;
+	};
 
-			case 32*2:
-				if ((DIS_RD & 1) == 0)
-				{
-					info->instr = Instruction::cmpl; CrfDab(instr, info);
-				}
-				break;
+	static DecodeEntry decodeTable[decodeLayout.size];
 
-			case 26 * 2: info->instr = Instruction::cntlzw; As(instr, info); break;
-			case (26 * 2) | RcBit: info->instr = Instruction::cntlzw_d; As(instr, info); break;
-
-			case 86 * 2: info->instr = Instruction::dcbf; Ab(instr, info); break;
-			case 470 * 2: info->instr = Instruction::dcbi; Ab(instr, info); break;
-			case 54 * 2: info->instr = Instruction::dcbst; Ab(instr, info); break;
-			case 278 * 2: info->instr = Instruction::dcbt; Ab(instr, info); break;
-			case 246 * 2: info->instr = Instruction::dcbtst; Ab(instr, info); break;
-			case 1014 * 2: info->instr = Instruction::dcbz; Ab(instr, info); break;
-
-			case 491 * 2: info->instr = Instruction::divw; Dab(instr, info); break;
-			case (491 * 2) | RcBit: info->instr = Instruction::divw_d; Dab(instr, info); break;
-			case (491 * 2) | OEBit: info->instr = Instruction::divwo; Dab(instr, info); break;
-			case (491 * 2) | OEBit | RcBit: info->instr = Instruction::divwo_d; Dab(instr, info); break;
-
-			case 459 * 2: info->instr = Instruction::divwu; Dab(instr, info); break;
-			case (459 * 2) | RcBit: info->instr = Instruction::divwu_d; Dab(instr, info); break;
-			case (459 * 2) | OEBit: info->instr = Instruction::divwuo; Dab(instr, info); break;
-			case (459 * 2) | OEBit | RcBit: info->instr = Instruction::divwuo_d; Dab(instr, info); break;
-
-			case 310 * 2: info->instr = Instruction::eciwx; Dab(instr, info); break;
-			case 438 * 2: info->instr = Instruction::ecowx; Dab(instr, info); break;
-
-			case 854 * 2: info->instr = Instruction::eieio; break;
-
-			case 284* 2: info->instr = Instruction::eqv; Asb(instr, info); break;
-			case (284 * 2) | RcBit: info->instr = Instruction::eqv_d; Asb(instr, info); break;
-
-			case 954 * 2: info->instr = Instruction::extsb; As(instr, info); break;
-			case (954 * 2) | RcBit: info->instr = Instruction::extsb_d; As(instr, info); break;
-			case 922 * 2: info->instr = Instruction::extsh; As(instr, info); break;
-			case (922 * 2) | RcBit: info->instr = Instruction::extsh_d; As(instr, info); break;
-
-			case 982 * 2: info->instr = Instruction::icbi; Ab(instr, info); break;
-
-			case 119 * 2: info->instr = Instruction::lbzux; Dab(instr, info); break;
-			case 87 * 2: info->instr = Instruction::lbzx; Dab(instr, info); break;
-			case 631 * 2: info->instr = Instruction::lfdux; FrDRegAb(instr, info); break;
-			case 599 * 2: info->instr = Instruction::lfdx; FrDRegAb(instr, info); break;
-			case 567 * 2: info->instr = Instruction::lfsux; FrDRegAb(instr, info); break;
-			case 535 * 2: info->instr = Instruction::lfsx; FrDRegAb(instr, info); break;
-			case 375 * 2: info->instr = Instruction::lhaux; Dab(instr, info); break;
-			case 343 * 2: info->instr = Instruction::lhax; Dab(instr, info); break;
-			case 790 * 2: info->instr = Instruction::lhbrx; Dab(instr, info); break;
-			case 311 * 2: info->instr = Instruction::lhzux; Dab(instr, info); break;
-			case 279 * 2: info->instr = Instruction::lhzx; Dab(instr, info); break;
-			case 597 * 2: info->instr = Instruction::lswi; DaNb(instr, info); break;
-			case 533 * 2: info->instr = Instruction::lswx; Dab(instr, info); break;
-			case 20 * 2: info->instr = Instruction::lwarx; Dab(instr, info); break;
-			case 534 * 2: info->instr = Instruction::lwbrx; Dab(instr, info); break;
-			case 55 * 2: info->instr = Instruction::lwzux; Dab(instr, info); break;
-			case 23 * 2: info->instr = Instruction::lwzx; Dab(instr, info); break;
-
-			case 512 * 2: info->instr = Instruction::mcrxr; Crfd(instr, info); break;
-			case 19 * 2: info->instr = Instruction::mfcr; D(instr, info); break;
-			case 83 * 2: info->instr = Instruction::mfmsr; D(instr, info); break;
-			case 339 * 2: info->instr = Instruction::mfspr; DSpr(instr, info); break;
-			case 595 * 2: info->instr = Instruction::mfsr; DSr(instr, info); break;
-			case 659 * 2: info->instr = Instruction::mfsrin; Db(instr, info); break;
-			case 371 * 2: info->instr = Instruction::mftb; DTbr(instr, info); break;
-			case 144 * 2: info->instr = Instruction::mtcrf; Crms(instr, info); break;
-			case 146 * 2: info->instr = Instruction::mtmsr; D(instr, info); break;
-			case 467 * 2: info->instr = Instruction::mtspr; SprS(instr, info); break;
-			case 210 * 2: info->instr = Instruction::mtsr; SrS(instr, info); break;
-			case 242 * 2: info->instr = Instruction::mtsrin; Db(instr, info); break;
-
-			case 75 * 2: info->instr = Instruction::mulhw; Dab(instr, info); break;
-			case (75 * 2) | RcBit: info->instr = Instruction::mulhw_d; Dab(instr, info); break;
-			case 11 * 2: info->instr = Instruction::mulhwu; Dab(instr, info); break;
-			case (11 * 2) | RcBit: info->instr = Instruction::mulhwu_d; Dab(instr, info); break;
-
-			case 235 * 2: info->instr = Instruction::mullw; Dab(instr, info); break;
-			case (235 * 2) | RcBit: info->instr = Instruction::mullw_d; Dab(instr, info); break;
-			case (235 * 2) | OEBit: info->instr = Instruction::mullwo; Dab(instr, info); break;
-			case (235 * 2) | OEBit | RcBit: info->instr = Instruction::mullwo_d; Dab(instr, info); break;
-
-			case 476 * 2: info->instr = Instruction::nand; Asb(instr, info); break;
-			case (476 * 2) | RcBit: info->instr = Instruction::nand_d; Asb(instr, info); break;
-			case 104 * 2: info->instr = Instruction::neg; Da(instr, info); break;
-			case (104 * 2) | RcBit: info->instr = Instruction::neg_d; Da(instr, info); break;
-			case (104 * 2) | OEBit: info->instr = Instruction::nego; Da(instr, info); break;
-			case (104 * 2) | OEBit | RcBit: info->instr = Instruction::nego_d; Da(instr, info); break;
-			case 124 * 2: info->instr = Instruction::nor; Asb(instr, info); break;
-			case (124 * 2) | RcBit: info->instr = Instruction::nor_d; Asb(instr, info); break;
-			case 444 * 2: info->instr = Instruction::_or; Asb(instr, info); break;
-			case (444 * 2) | RcBit: info->instr = Instruction::or_d; Asb(instr, info); break;
-			case 412 * 2: info->instr = Instruction:: orc; Asb(instr, info); break;
-			case (412 * 2) | RcBit: info->instr = Instruction::orc_d; Asb(instr, info); break;
-
-			case 24 * 2: info->instr = Instruction::slw; Asb(instr, info); break;
-			case (24 * 2) | RcBit: info->instr = Instruction::slw_d; Asb(instr, info); break;
-			case 792 * 2: info->instr = Instruction::sraw; Asb(instr, info); break;
-			case (792 * 2) | RcBit: info->instr = Instruction::sraw_d; Asb(instr, info); break;
-			case 824 * 2: info->instr = Instruction::srawi; AsImm(instr, info); break;
-			case (824 * 2) | RcBit: info->instr = Instruction::srawi_d; AsImm(instr, info); break;
-			case 536 * 2: info->instr = Instruction::srw; Asb(instr, info); break;
-			case (536 * 2) | RcBit: info->instr = Instruction::srw_d; Asb(instr, info); break;
-
-			case 247 * 2: info->instr = Instruction::stbux; Dab(instr, info); break;
-			case 215 * 2: info->instr = Instruction::stbx; Dab(instr, info); break;
-			case 759 * 2: info->instr = Instruction::stfdux; FrDRegAb(instr, info); break;
-			case 727 * 2: info->instr = Instruction::stfdx; FrDRegAb(instr, info); break;
-			case 983 * 2: info->instr = Instruction::stfiwx; FrDRegAb(instr, info); break;
-			case 695 * 2: info->instr = Instruction::stfsux; FrDRegAb(instr, info); break;
-			case 663 * 2: info->instr = Instruction::stfsx; FrDRegAb(instr, info); break;
-			case 918 * 2: info->instr = Instruction::sthbrx; Dab(instr, info); break;
-			case 439 * 2: info->instr = Instruction::sthux; Dab(instr, info); break;
-			case 407 * 2: info->instr = Instruction::sthx; Dab(instr, info); break;
-			case 725 * 2: info->instr = Instruction::stswi; SaImm(instr, info); break;
-			case 661 * 2: info->instr = Instruction::stswx; Dab(instr, info); break;
-			case 662 * 2: info->instr = Instruction::stwbrx; Dab(instr, info); break;
-			case (150 * 2) | RcBit: info->instr = Instruction::stwcx_d; Dab(instr, info); break;
-			case 183 * 2: info->instr = Instruction::stwux; Dab(instr, info); break;
-			case 151 * 2: info->instr = Instruction::stwux; Dab(instr, info); break;
-
-			case 40 * 2: info->instr = Instruction::subf; Dab(instr, info); break;
-			case (40 * 2) | RcBit: info->instr = Instruction::subf_d; Dab(instr, info); break;
-			case (40 * 2) | OEBit: info->instr = Instruction::subfo; Dab(instr, info); break;
-			case (40 * 2) | OEBit | RcBit: info->instr = Instruction::subfo_d; Dab(instr, info); break;
-			case 8 * 2: info->instr = Instruction::subfc; Dab(instr, info); break;
-			case (8 * 2) | RcBit: info->instr = Instruction::subfc_d; Dab(instr, info); break;
-			case (8 * 2) | OEBit: info->instr = Instruction::subfco; Dab(instr, info); break;
-			case (8 * 2) | OEBit | RcBit: info->instr = Instruction::subfco_d; Dab(instr, info); break;
-			case 136 * 2: info->instr = Instruction::subfe; Dab(instr, info); break;
-			case (136 * 2) | RcBit: info->instr = Instruction::subfe_d; Dab(instr, info); break;
-			case (136 * 2) | OEBit: info->instr = Instruction::subfeo; Dab(instr, info); break;
-			case (136 * 2) | OEBit | RcBit: info->instr = Instruction::subfeo_d; Dab(instr, info); break;
-
-			case 232 * 2: info->instr = Instruction::subfme; Da(instr, info); break;
-			case (232 * 2) | RcBit: info->instr = Instruction::subfme_d; Da(instr, info); break;
-			case (232 * 2) | OEBit: info->instr = Instruction::subfmeo; Da(instr, info); break;
-			case (232 * 2) | OEBit | RcBit: info->instr = Instruction::subfmeo_d; Da(instr, info); break;
-
-			case 200 * 2: info->instr = Instruction::subfze; Da(instr, info); break;
-			case (200 * 2) | RcBit: info->instr = Instruction::subfze_d; Da(instr, info); break;
-			case (200 * 2) | OEBit: info->instr = Instruction::subfzeo; Da(instr, info); break;
-			case (200 * 2) | OEBit | RcBit: info->instr = Instruction::subfzeo_d; Da(instr, info); break;
-
-			case 598 * 2: info->instr = Instruction::sync; break;
-			case 306 * 2: info->instr = Instruction::tlbie; B(instr, info); break;
-			case 566 * 2: info->instr = Instruction::tlbsync; break;
-			case 4 * 2: info->instr = Instruction::tw; ImmAb(instr, info); info->flow = true; break;
-
-			case 316 * 2: info->instr = Instruction::_xor; Asb(instr, info); break;
-			case (316 * 2) | RcBit: info->instr = Instruction::xor_d; Asb(instr, info); break;
-		}
-	}
-
-	void Analyzer::Op31Fast(uint32_t instr, AnalyzeInfo* info)
+	static struct DecodeTableBuilder
 	{
-		switch (instr & 0x7ff)
+		DecodeTableBuilder()
 		{
-			case 266 * 2: info->instr = Instruction::add; DabFast(instr, info); break;
-			case (266 * 2) | RcBit: info->instr = Instruction::add_d; DabFast(instr, info); break;
-			case (266 * 2) | OEBit: info->instr = Instruction::addo; DabFast(instr, info); break;
-			case (266 * 2) | OEBit | RcBit: info->instr = Instruction::addo_d; DabFast(instr, info); break;
-
-			case 10 * 2: info->instr = Instruction::addc; DabFast(instr, info); break;
-			case (10 * 2) | RcBit: info->instr = Instruction::addc_d; DabFast(instr, info); break;
-			case (10 * 2) | OEBit: info->instr = Instruction::addco; DabFast(instr, info); break;
-			case (10 * 2) | OEBit | RcBit: info->instr = Instruction::addco_d; DabFast(instr, info); break;
-
-			case 138 * 2: info->instr = Instruction::adde; DabFast(instr, info); break;
-			case (138 * 2) | RcBit: info->instr = Instruction::adde_d; DabFast(instr, info); break;
-			case (138 * 2) | OEBit: info->instr = Instruction::addeo; DabFast(instr, info); break;
-			case (138 * 2) | OEBit | RcBit: info->instr = Instruction::addeo_d; DabFast(instr, info); break;
-
-			case 234 * 2: info->instr = Instruction::addme; DaFast(instr, info); break;
-			case (234 * 2) | RcBit: info->instr = Instruction::addme_d; DaFast(instr, info); break;
-			case (234 * 2) | OEBit: info->instr = Instruction::addmeo; DaFast(instr, info); break;
-			case (234 * 2) | OEBit | RcBit: info->instr = Instruction::addmeo_d; DaFast(instr, info); break;
-
-			case 202 * 2: info->instr = Instruction::addze; DaFast(instr, info); break;
-			case (202 * 2) | RcBit: info->instr = Instruction::addze_d; DaFast(instr, info); break;
-			case (202 * 2) | OEBit: info->instr = Instruction::addzeo; DaFast(instr, info); break;
-			case (202 * 2) | OEBit | RcBit: info->instr = Instruction::addzeo_d; DaFast(instr, info); break;
-
-			case 28 * 2: info->instr = Instruction::_and; AsbFast(instr, info); break;
-			case (28 * 2) | RcBit: info->instr = Instruction::and_d; AsbFast(instr, info); break;
-
-			case 60 * 2: info->instr = Instruction::andc; AsbFast(instr, info); break;
-			case (60 * 2) | RcBit: info->instr = Instruction::andc_d; AsbFast(instr, info); break;
-
-			case 0:
-				if ((DIS_RD & 1) == 0)
+			for (DecodeEntry& entry : decodeTable)
+			{
+				entry.instr = (int16_t)Instruction::Unknown;
+				entry.form = AnalyzeForm::None;
+				entry.flags = 0;
+			}
+
+			for (const DecodeRule& rule : decodeRules)
+			{
+				const DecodeSlice& slice = decodeLayout.slice[rule.primary];
+
+				for (uint32_t bits = 0; bits <= slice.mask; bits++)
 				{
-					info->instr = Instruction::cmp; CrfDabFast(instr, info);
+					DecodeEntry& entry = decodeTable[slice.base + bits];
+
+					if ((bits & rule.mask) == rule.match && entry.instr == (int16_t)Instruction::Unknown)
+					{
+						entry.instr = (int16_t)rule.instr;
+						entry.form = rule.form;
+						entry.flags = rule.flags;
+					}
 				}
-				break;
-
-			case 32 * 2:
-				if ((DIS_RD & 1) == 0)
-				{
-					info->instr = Instruction::cmpl; CrfDabFast(instr, info);
-				}
-				break;
-
-			case 26 * 2: info->instr = Instruction::cntlzw; AsFast(instr, info); break;
-			case (26 * 2) | RcBit: info->instr = Instruction::cntlzw_d; AsFast(instr, info); break;
-
-			case 86 * 2: info->instr = Instruction::dcbf; AbFast(instr, info); break;
-			case 470 * 2: info->instr = Instruction::dcbi; AbFast(instr, info); break;
-			case 54 * 2: info->instr = Instruction::dcbst; AbFast(instr, info); break;
-			case 278 * 2: info->instr = Instruction::dcbt; AbFast(instr, info); break;
-			case 246 * 2: info->instr = Instruction::dcbtst; AbFast(instr, info); break;
-			case 1014 * 2: info->instr = Instruction::dcbz; AbFast(instr, info); break;
-
-			case 491 * 2: info->instr = Instruction::divw; DabFast(instr, info); break;
-			case (491 * 2) | RcBit: info->instr = Instruction::divw_d; DabFast(instr, info); break;
-			case (491 * 2) | OEBit: info->instr = Instruction::divwo; DabFast(instr, info); break;
-			case (491 * 2) | OEBit | RcBit: info->instr = Instruction::divwo_d; DabFast(instr, info); break;
-
-			case 459 * 2: info->instr = Instruction::divwu; DabFast(instr, info); break;
-			case (459 * 2) | RcBit: info->instr = Instruction::divwu_d; DabFast(instr, info); break;
-			case (459 * 2) | OEBit: info->instr = Instruction::divwuo; DabFast(instr, info); break;
-			case (459 * 2) | OEBit | RcBit: info->instr = Instruction::divwuo_d; DabFast(instr, info); break;
-
-			case 310 * 2: info->instr = Instruction::eciwx; DabFast(instr, info); break;
-			case 438 * 2: info->instr = Instruction::ecowx; DabFast(instr, info); break;
-
-			case 854 * 2: info->instr = Instruction::eieio; break;
-
-			case 284 * 2: info->instr = Instruction::eqv; AsbFast(instr, info); break;
-			case (284 * 2) | RcBit: info->instr = Instruction::eqv_d; AsbFast(instr, info); break;
-
-			case 954 * 2: info->instr = Instruction::extsb; AsFast(instr, info); break;
-			case (954 * 2) | RcBit: info->instr = Instruction::extsb_d; AsFast(instr, info); break;
-			case 922 * 2: info->instr = Instruction::extsh; AsFast(instr, info); break;
-			case (922 * 2) | RcBit: info->instr = Instruction::extsh_d; AsFast(instr, info); break;
-
-			case 982 * 2: info->instr = Instruction::icbi; AbFast(instr, info); break;
-
-			case 119 * 2: info->instr = Instruction::lbzux; DabFast(instr, info); break;
-			case 87 * 2: info->instr = Instruction::lbzx; DabFast(instr, info); break;
-			case 631 * 2: info->instr = Instruction::lfdux; FrDRegAbFast(instr, info); break;
-			case 599 * 2: info->instr = Instruction::lfdx; FrDRegAbFast(instr, info); break;
-			case 567 * 2: info->instr = Instruction::lfsux; FrDRegAbFast(instr, info); break;
-			case 535 * 2: info->instr = Instruction::lfsx; FrDRegAbFast(instr, info); break;
-			case 375 * 2: info->instr = Instruction::lhaux; DabFast(instr, info); break;
-			case 343 * 2: info->instr = Instruction::lhax; DabFast(instr, info); break;
-			case 790 * 2: info->instr = Instruction::lhbrx; DabFast(instr, info); break;
-			case 311 * 2: info->instr = Instruction::lhzux; DabFast(instr, info); break;
-			case 279 * 2: info->instr = Instruction::lhzx; DabFast(instr, info); break;
-			case 597 * 2: info->instr = Instruction::lswi; DaNbFast(instr, info); break;
-			case 533 * 2: info->instr = Instruction::lswx; DabFast(instr, info); break;
-			case 20 * 2: info->instr = Instruction::lwarx; DabFast(instr, info); break;
-			case 534 * 2: info->instr = Instruction::lwbrx; DabFast(instr, info); break;
-			case 55 * 2: info->instr = Instruction::lwzux; DabFast(instr, info); break;
-			case 23 * 2: info->instr = Instruction::lwzx; DabFast(instr, info); break;
-
-			case 512 * 2: info->instr = Instruction::mcrxr; CrfdFast(instr, info); break;
-			case 19 * 2: info->instr = Instruction::mfcr; DFast(instr, info); break;
-			case 83 * 2: info->instr = Instruction::mfmsr; DFast(instr, info); break;
-			case 339 * 2: info->instr = Instruction::mfspr; DSprFast(instr, info); break;
-			case 595 * 2: info->instr = Instruction::mfsr; DSrFast(instr, info); break;
-			case 659 * 2: info->instr = Instruction::mfsrin; DbFast(instr, info); break;
-			case 371 * 2: info->instr = Instruction::mftb; DTbrFast(instr, info); break;
-			case 144 * 2: info->instr = Instruction::mtcrf; CrmsFast(instr, info); break;
-			case 146 * 2: info->instr = Instruction::mtmsr; DFast(instr, info); break;
-			case 467 * 2: info->instr = Instruction::mtspr; SprSFast(instr, info); break;
-			case 210 * 2: info->instr = Instruction::mtsr; SrSFast(instr, info); break;
-			case 242 * 2: info->instr = Instruction::mtsrin; DbFast(instr, info); break;
-
-			case 75 * 2: info->instr = Instruction::mulhw; DabFast(instr, info); break;
-			case (75 * 2) | RcBit: info->instr = Instruction::mulhw_d; DabFast(instr, info); break;
-			case 11 * 2: info->instr = Instruction::mulhwu; DabFast(instr, info); break;
-			case (11 * 2) | RcBit: info->instr = Instruction::mulhwu_d; DabFast(instr, info); break;
-
-			case 235 * 2: info->instr = Instruction::mullw; DabFast(instr, info); break;
-			case (235 * 2) | RcBit: info->instr = Instruction::mullw_d; DabFast(instr, info); break;
-			case (235 * 2) | OEBit: info->instr = Instruction::mullwo; DabFast(instr, info); break;
-			case (235 * 2) | OEBit | RcBit: info->instr = Instruction::mullwo_d; DabFast(instr, info); break;
-
-			case 476 * 2: info->instr = Instruction::nand; AsbFast(instr, info); break;
-			case (476 * 2) | RcBit: info->instr = Instruction::nand_d; AsbFast(instr, info); break;
-			case 104 * 2: info->instr = Instruction::neg; DaFast(instr, info); break;
-			case (104 * 2) | RcBit: info->instr = Instruction::neg_d; DaFast(instr, info); break;
-			case (104 * 2) | OEBit: info->instr = Instruction::nego; DaFast(instr, info); break;
-			case (104 * 2) | OEBit | RcBit: info->instr = Instruction::nego_d; DaFast(instr, info); break;
-			case 124 * 2: info->instr = Instruction::nor; AsbFast(instr, info); break;
-			case (124 * 2) | RcBit: info->instr = Instruction::nor_d; AsbFast(instr, info); break;
-			case 444 * 2: info->instr = Instruction::_or ; AsbFast(instr, info); break;
-			case (444 * 2) | RcBit: info->instr = Instruction::or_d; AsbFast(instr, info); break;
-			case 412 * 2: info->instr = Instruction::orc; AsbFast(instr, info); break;
-			case (412 * 2) | RcBit: info->instr = Instruction::orc_d; AsbFast(instr, info); break;
-
-			case 24 * 2: info->instr = Instruction::slw; AsbFast(instr, info); break;
-			case (24 * 2) | RcBit: info->instr = Instruction::slw_d; AsbFast(instr, info); break;
-			case 792 * 2: info->instr = Instruction::sraw; AsbFast(instr, info); break;
-			case (792 * 2) | RcBit: info->instr = Instruction::sraw_d; AsbFast(instr, info); break;
-			case 824 * 2: info->instr = Instruction::srawi; AsImmFast(instr, info); break;
-			case (824 * 2) | RcBit: info->instr = Instruction::srawi_d; AsImmFast(instr, info); break;
-			case 536 * 2: info->instr = Instruction::srw; AsbFast(instr, info); break;
-			case (536 * 2) | RcBit: info->instr = Instruction::srw_d; AsbFast(instr, info); break;
-
-			case 247 * 2: info->instr = Instruction::stbux; DabFast(instr, info); break;
-			case 215 * 2: info->instr = Instruction::stbx; DabFast(instr, info); break;
-			case 759 * 2: info->instr = Instruction::stfdux; FrDRegAbFast(instr, info); break;
-			case 727 * 2: info->instr = Instruction::stfdx; FrDRegAbFast(instr, info); break;
-			case 983 * 2: info->instr = Instruction::stfiwx; FrDRegAbFast(instr, info); break;
-			case 695 * 2: info->instr = Instruction::stfsux; FrDRegAbFast(instr, info); break;
-			case 663 * 2: info->instr = Instruction::stfsx; FrDRegAbFast(instr, info); break;
-			case 918 * 2: info->instr = Instruction::sthbrx; DabFast(instr, info); break;
-			case 439 * 2: info->instr = Instruction::sthux; DabFast(instr, info); break;
-			case 407 * 2: info->instr = Instruction::sthx; DabFast(instr, info); break;
-			case 725 * 2: info->instr = Instruction::stswi; SaImmFast(instr, info); break;
-			case 661 * 2: info->instr = Instruction::stswx; DabFast(instr, info); break;
-			case 662 * 2: info->instr = Instruction::stwbrx; DabFast(instr, info); break;
-			case (150 * 2) | RcBit: info->instr = Instruction::stwcx_d; DabFast(instr, info); break;
-			case 183 * 2: info->instr = Instruction::stwux; DabFast(instr, info); break;
-			case 151 * 2: info->instr = Instruction::stwux; DabFast(instr, info); break;
-
-			case 40 * 2: info->instr = Instruction::subf; DabFast(instr, info); break;
-			case (40 * 2) | RcBit: info->instr = Instruction::subf_d; DabFast(instr, info); break;
-			case (40 * 2) | OEBit: info->instr = Instruction::subfo; DabFast(instr, info); break;
-			case (40 * 2) | OEBit | RcBit: info->instr = Instruction::subfo_d; DabFast(instr, info); break;
-			case 8 * 2: info->instr = Instruction::subfc; DabFast(instr, info); break;
-			case (8 * 2) | RcBit: info->instr = Instruction::subfc_d; DabFast(instr, info); break;
-			case (8 * 2) | OEBit: info->instr = Instruction::subfco; DabFast(instr, info); break;
-			case (8 * 2) | OEBit | RcBit: info->instr = Instruction::subfco_d; DabFast(instr, info); break;
-			case 136 * 2: info->instr = Instruction::subfe; DabFast(instr, info); break;
-			case (136 * 2) | RcBit: info->instr = Instruction::subfe_d; DabFast(instr, info); break;
-			case (136 * 2) | OEBit: info->instr = Instruction::subfeo; DabFast(instr, info); break;
-			case (136 * 2) | OEBit | RcBit: info->instr = Instruction::subfeo_d; DabFast(instr, info); break;
-
-			case 232 * 2: info->instr = Instruction::subfme; DaFast(instr, info); break;
-			case (232 * 2) | RcBit: info->instr = Instruction::subfme_d; DaFast(instr, info); break;
-			case (232 * 2) | OEBit: info->instr = Instruction::subfmeo; DaFast(instr, info); break;
-			case (232 * 2) | OEBit | RcBit: info->instr = Instruction::subfmeo_d; DaFast(instr, info); break;
-
-			case 200 * 2: info->instr = Instruction::subfze; DaFast(instr, info); break;
-			case (200 * 2) | RcBit: info->instr = Instruction::subfze_d; DaFast(instr, info); break;
-			case (200 * 2) | OEBit: info->instr = Instruction::subfzeo; DaFast(instr, info); break;
-			case (200 * 2) | OEBit | RcBit: info->instr = Instruction::subfzeo_d; DaFast(instr, info); break;
-
-			case 598 * 2: info->instr = Instruction::sync; break;
-			case 306 * 2: info->instr = Instruction::tlbie; BFast(instr, info); break;
-			case 566 * 2: info->instr = Instruction::tlbsync; break;
-			case 4 * 2: info->instr = Instruction::tw; ImmAbFast(instr, info); info->flow = true; break;
-
-			case 316 * 2: info->instr = Instruction::_xor; AsbFast(instr, info); break;
-			case (316 * 2) | RcBit: info->instr = Instruction::xor_d; AsbFast(instr, info); break;
+			}
 		}
-	}
-
-	#pragma endregion "Primary 31"
+	} decodeTableBuilder;
 
-	#pragma region "Primary 59"
-
-	void Analyzer::Op59(uint32_t instr, AnalyzeInfo* info)
+	static inline const DecodeEntry& Decode(uint32_t instr)
 	{
-		switch (instr & 0x3f)
-		{
-			case 21 * 2: info->instr = Instruction::fadds; FrDab(instr, info); break;
-			case (21 * 2) | RcBit: info->instr = Instruction::fadds_d; FrDab(instr, info); break;
-
-			case 18 * 2: info->instr = Instruction::fdivs; FrDab(instr, info); break;
-			case (18 * 2) | RcBit: info->instr = Instruction::fdivs_d; FrDab(instr, info); break;
-
-			case 29 * 2: info->instr = Instruction::fmadds; FrDacb(instr, info); break;
-			case (29 * 2) | RcBit: info->instr = Instruction::fmadds_d; FrDacb(instr, info); break;
-
-			case 28 * 2: info->instr = Instruction::fmsubs; FrDacb(instr, info); break;
-			case (28 * 2) | RcBit: info->instr = Instruction::fmsubs_d; FrDacb(instr, info); break;
-
-			case 25 * 2: info->instr = Instruction::fmuls; FrDac(instr, info); break;
-			case (25 * 2) | RcBit: info->instr = Instruction::fmuls_d; FrDac(instr, info); break;
-
-			case 31 * 2: info->instr = Instruction::fnmadds; FrDacb(instr, info); break;
-			case (31 * 2) | RcBit: info->instr = Instruction::fnmadds_d; FrDacb(instr, info); break;
-
-			case 30 * 2: info->instr = Instruction::fnmsubs; FrDacb(instr, info); break;
-			case (30 * 2) | RcBit: info->instr = Instruction::fnmsubs_d; FrDacb(instr, info); break;
-
-			case 24 * 2: info->instr = Instruction::fres; FrDb(instr, info); break;
-			case (24 * 2) | RcBit: info->instr = Instruction::fres_d; FrDb(instr, info); break;
-
-			case 20 * 2: info->instr = Instruction::fsubs; FrDab(instr, info); break;
-			case (20 * 2) | RcBit: info->instr = Instruction::fsubs_d; FrDab(instr, info); break;
-		}
+		const DecodeSlice& slice = decodeLayout.slice[instr >> 26];
+		return decodeTable[slice.base + (instr & slice.mask)];
 	}
 
-	void Analyzer::Op59Fast(uint32_t instr, AnalyzeInfo* info)
-	{
-		switch (instr & 0x3f)
-		{
-			case 21 * 2: info->instr = Instruction::fadds; FrDabFast(instr, info); break;
-			case (21 * 2) | RcBit: info->instr = Instruction::fadds_d; FrDabFast(instr, info); break;
-
-			case 18 * 2: info->instr = Instruction::fdivs; FrDabFast(instr, info); break;
-			case (18 * 2) | RcBit: info->instr = Instruction::fdivs_d; FrDabFast(instr, info); break;
-
-			case 29 * 2: info->instr = Instruction::fmadds; FrDacbFast(instr, info); break;
-			case (29 * 2) | RcBit: info->instr = Instruction::fmadds_d; FrDacbFast(instr, info); break;
-
-			case 28 * 2: info->instr = Instruction::fmsubs; FrDacbFast(instr, info); break;
-			case (28 * 2) | RcBit: info->instr = Instruction::fmsubs_d; FrDacbFast(instr, info); break;
+	#pragma endregion "Decode table"
 
-			case 25 * 2: info->instr = Instruction::fmuls; FrDacFast(instr, info); break;
-			case (25 * 2) | RcBit: info->instr = Instruction::fmuls_d; FrDacFast(instr, info); break;
-
-			case 31 * 2: info->instr = Instruction::fnmadds; FrDacbFast(instr, info); break;
-			case (31 * 2) | RcBit: info->instr = Instruction::fnmadds_d; FrDacbFast(instr, info); break;
-
-			case 30 * 2: info->instr = Instruction::fnmsubs; FrDacbFast(instr, info); break;
-			case (30 * 2) | RcBit: info->instr = Instruction::fnmsubs_d; FrDacbFast(instr, info); break;
-
-			case 24 * 2: info->instr = Instruction::fres; FrDbFast(instr, info); break;
-			case (24 * 2) | RcBit: info->instr = Instruction::fres_d; FrDbFast(instr, info); break;
-
-			case 20 * 2: info->instr = Instruction::fsubs; FrDabFast(instr, info); break;
-			case (20 * 2) | RcBit: info->instr = Instruction::fsubs_d; FrDabFast(instr, info); break;
-		}
-	}
-
-	#pragma endregion "Primary 59"
-
-	#pragma region "Primary 63"
-
-	void Analyzer::Op63(uint32_t instr, AnalyzeInfo* info)
-	{
-		// Check Madd first
-		
-		switch (instr & 0x3f)
-		{
-			case 29 * 2: info->instr = Instruction::fmadd; FrDacb(instr, info); return;
-			case (29 * 2) | RcBit: info->instr = Instruction::fmadd_d; FrDacb(instr, info); return;
-			case 28 * 2: info->instr = Instruction::fmsub; FrDacb(instr, info); return;
-			case (28 * 2) | RcBit: info->instr = Instruction::fmsub_d; FrDacb(instr, info); return;
-			case 25 * 2: info->instr = Instruction::fmul; FrDac(instr, info); return;
-			case (25 * 2) | RcBit: info->instr = Instruction::fmul_d; FrDac(instr, info); return;
-			case 31 * 2: info->instr = Instruction::fnmadd; FrDacb(instr, info); return;
-			case (31 * 2) | RcBit: info->instr = Instruction::fnmadd_d; FrDacb(instr, info); return;
-			case 30 * 2: info->instr = Instruction::fnmsub; FrDacb(instr, info); return;
-			case (30 * 2) | RcBit: info->instr = Instruction::fnmsub_d; FrDacb(instr, info); return;
-			case 23 * 2: info->instr = Instruction::fsel; FrDacb(instr, info); return;
-			case (23 * 2) | RcBit: info->instr = Instruction::fsel_d; FrDacb(instr, info); return;
-		}
-
-		switch (instr & 0x7ff)
-		{
-			case 264 * 2: info->instr = Instruction::fabs; FrDb(instr, info); break;
-			case (264 * 2) | RcBit: info->instr = Instruction::fabs_d; FrDb(instr, info); break;
-
-			case 21 * 2: info->instr = Instruction::fadd; FrDab(instr, info); break;
-			case (21 * 2) | RcBit: info->instr = Instruction::fadd_d; FrDab(instr, info); break;
-
-			case 32 * 2: info->instr = Instruction::fcmpo; CrfdFrAb(instr, info); break;
-			case 0: info->instr = Instruction::fcmpu; CrfdFrAb(instr, info); break;
-
-			case 14 * 2: info->instr = Instruction::fctiw; FrDb(instr, info); break;
-			case (14 * 2) | RcBit: info->instr = Instruction::fctiw_d; FrDb(instr, info); break;
-			case 15 * 2: info->instr = Instruction::fctiwz; FrDb(instr, info); break;
-			case (15 * 2) | RcBit: info->instr = Instruction::fctiwz_d; FrDb(instr, info); break;
-
-			case 18 * 2: info->instr = Instruction::fdiv; FrDab(instr, info); break;
-			case (18 * 2) | RcBit: info->instr = Instruction::fdiv_d; FrDab(instr, info); break;
-
-			case 72 * 2: info->instr = Instruction::fmr; FrDb(instr, info); break;
-			case (72 * 2) | RcBit: info->instr = Instruction::fmr_d; FrDb(instr, info); break;
-
-			case 136 * 2: info->instr = Instruction::fnabs; FrDb(instr, info); break;
-			case (136 * 2) | RcBit: info->instr = Instruction::fnabs_d; FrDb(instr, info); break;
-
-			case 40 * 2: info->instr = Instruction::fneg; FrDb(instr, info); break;
-			case (40 * 2) | RcBit: info->instr = Instruction::fneg_d; FrDb(instr, info); break;
-
-			case 12 * 2: info->instr = Instruction::frsp; FrDb(instr, info); break;
-			case (12 * 2) | RcBit: info->instr = Instruction::frsp_d; FrDb(instr, info); break;
-
-			case 26 * 2: info->instr = Instruction::frsqrte; FrDb(instr, info); break;
-			case (26 * 2) | RcBit: info->instr = Instruction::frsqrte_d; FrDb(instr, info); break;
-
-			case 20 * 2: info->instr = Instruction::fsub; FrDab(instr, info); break;
-			case (20 * 2) | RcBit: info->instr = Instruction::fsub_d; FrDab(instr, info); break;
-
-			case 64 * 2: info->instr = Instruction::mcrfs; Crfds(instr, info); break;
-
-			case 583 * 2: info->instr = Instruction::mffs; Frd(instr, info); break;
-			case (583 * 2) | RcBit: info->instr = Instruction::mffs_d; Frd(instr, info); break;
-
-			case 70 * 2: info->instr = Instruction::mtfsb0; Crbd(instr, info); break;
-			case (70 * 2) | RcBit: info->instr = Instruction::mtfsb0_d; Crbd(instr, info); break;
-			case 38 * 2: info->instr = Instruction::mtfsb1; Crbd(instr, info); break;
-			case (38 * 2) | RcBit: info->instr = Instruction::mtfsb1_d; Crbd(instr, info); break;
-			case 711 * 2: info->instr = Instruction::mtfsf; FmFrb(instr, info); break;
-			case (711 * 2) | RcBit: info->instr = Instruction::mtfsf_d; FmFrb(instr, info); break;
-			case 134 * 2: info->instr = Instruction::mtfsfi; CrfdImm(instr, info); break;
-			case (134 * 2) | RcBit: info->instr = Instruction::mtfsfi_d; CrfdImm(instr, info); break;
-		}
-	}
-
-	void Analyzer::Op63Fast(uint32_t instr, AnalyzeInfo* info)
-	{
-		// Check Madd first
-		
-		switch (instr & 0x3f)
-		{
-			case 29 * 2: info->instr = Instruction::fmadd; FrDacbFast(instr, info); return;
-			case (29 * 2) | RcBit: info->instr = Instruction::fmadd_d; FrDacbFast(instr, info); return;
-			case 28 * 2: info->instr = Instruction::fmsub; FrDacbFast(instr, info); return;
-			case (28 * 2) | RcBit: info->instr = Instruction::fmsub_d; FrDacbFast(instr, info); return;
-			case 25 * 2: info->instr = Instruction::fmul; FrDacFast(instr, info); return;
-			case (25 * 2) | RcBit: info->instr = Instruction::fmul_d; FrDacFast(instr, info); return;
-			case 31 * 2: info->instr = Instruction::fnmadd; FrDacbFast(instr, info); return;
-			case (31 * 2) | RcBit: info->instr = Instruction::fnmadd_d; FrDacbFast(instr, info); return;
-			case 30 * 2: info->instr = Instruction::fnmsub; FrDacbFast(instr, info); return;
-			case (30 * 2) | RcBit: info->instr = Instruction::fnmsub_d; FrDacbFast(instr, info); return;
-			case 23 * 2: info->instr = Instruction::fsel; FrDacbFast(instr, info); return;
-			case (23 * 2) | RcBit: info->instr = Instruction::fsel_d; FrDacbFast(instr, info); return;
-		}
-
-		switch (instr & 0x7ff)
-		{
-			case 264 * 2: info->instr = Instruction::fabs; FrDbFast(instr, info); break;
-			case (264 * 2) | RcBit: info->instr = Instruction::fabs_d; FrDbFast(instr, info); break;
-
-			case 21 * 2: info->instr = Instruction::fadd; FrDabFast(instr, info); break;
-			case (21 * 2) | RcBit: info->instr = Instruction::fadd_d; FrDabFast(instr, info); break;
-
-			case 32 * 2: info->instr = Instruction::fcmpo; CrfdFrAbFast(instr, info); break;
-			case 0: info->instr = Instruction::fcmpu; CrfdFrAbFast(instr, info); break;
-
-			case 14 * 2: info->instr = Instruction::fctiw; FrDbFast(instr, info); break;
-			case (14 * 2) | RcBit: info->instr = Instruction::fctiw_d; FrDbFast(instr, info); break;
-			case 15 * 2: info->instr = Instruction::fctiwz; FrDbFast(instr, info); break;
-			case (15 * 2) | RcBit: info->instr = Instruction::fctiwz_d; FrDbFast(instr, info); break;
-
-			case 18 * 2: info->instr = Instruction::fdiv; FrDabFast(instr, info); break;
-			case (18 * 2) | RcBit: info->instr = Instruction::fdiv_d; FrDabFast(instr, info); break;
-
-			case 72 * 2: info->instr = Instruction::fmr; FrDbFast(instr, info); break;
-			case (72 * 2) | RcBit: info->instr = Instruction::fmr_d; FrDbFast(instr, info); break;
-
-			case 136 * 2: info->instr = Instruction::fnabs; FrDbFast(instr, info); break;
-			case (136 * 2) | RcBit: info->instr = Instruction::fnabs_d; FrDbFast(instr, info); break;
-
-			case 40 * 2: info->instr = Instruction::fneg; FrDbFast(instr, info); break;
-			case (40 * 2) | RcBit: info->instr = Instruction::fneg_d; FrDbFast(instr, info); break;
-
-			case 12 * 2: info->instr = Instruction::frsp; FrDbFast(instr, info); break;
-			case (12 * 2) | RcBit: info->instr = Instruction::frsp_d; FrDbFast(instr, info); break;
-
-			case 26 * 2: info->instr = Instruction::frsqrte; FrDbFast(instr, info); break;
-			case (26 * 2) | RcBit: info->instr = Instruction::frsqrte_d; FrDbFast(instr, info); break;
-
-			case 20 * 2: info->instr = Instruction::fsub; FrDabFast(instr, info); break;
-			case (20 * 2) | RcBit: info->instr = Instruction::fsub_d; FrDabFast(instr, info); break;
-
-			case 64 * 2: info->instr = Instruction::mcrfs; CrfdsFast(instr, info); break;
-
-			case 583 * 2: info->instr = Instruction::mffs; FrdFast(instr, info); break;
-			case (583 * 2) | RcBit: info->instr = Instruction::mffs_d; FrdFast(instr, info); break;
-
-			case 70 * 2: info->instr = Instruction::mtfsb0; CrbdFast(instr, info); break;
-			case (70 * 2) | RcBit: info->instr = Instruction::mtfsb0_d; CrbdFast(instr, info); break;
-			case 38 * 2: info->instr = Instruction::mtfsb1; CrbdFast(instr, info); break;
-			case (38 * 2) | RcBit: info->instr = Instruction::mtfsb1_d; CrbdFast(instr, info); break;
-			case 711 * 2: info->instr = Instruction::mtfsf; FmFrbFast(instr, info); break;
-			case (711 * 2) | RcBit: info->instr = Instruction::mtfsf_d; FmFrbFast(instr, info); break;
-			case 134 * 2: info->instr = Instruction::mtfsfi; CrfdImmFast(instr, info); break;
-			case (134 * 2) | RcBit: info->instr = Instruction::mtfsfi_d; CrfdImmFast(instr, info); break;
-		}
-	}
-
-	#pragma endregion "Primary 63"
-
-	#pragma region "Primary 4"
-
-	void Analyzer::Op4(uint32_t instr, AnalyzeInfo* info)
-	{
-		switch (instr & 0x7f)
-		{
-			case 38 * 2: info->instr = Instruction::psq_lux; FrAbWi(instr, info); return;	// Watch for return
-			case 6 * 2: info->instr = Instruction::psq_lx; FrAbWi(instr, info); return;
-			case 39 * 2: info->instr = Instruction::psq_stux; FrAbWi(instr, info); return;
-			case 7 * 2: info->instr = Instruction::psq_stx; FrAbWi(instr, info); return;
-		}
-
-		// If none of the PS Load/Store instructions fits, continue to check further
-
-		// Check Madd first
-
-		switch (instr & 0x3f)
-		{
-			case 29 * 2: info->instr = Instruction::ps_madd; FrDacb(instr, info); return;
-			case (29 * 2) | RcBit: info->instr = Instruction::ps_madd_d; FrDacb(instr, info); return;
-			case 14 * 2: info->instr = Instruction::ps_madds0; FrDacb(instr, info); return;
-			case (14 * 2) | RcBit: info->instr = Instruction::ps_madds0_d; FrDacb(instr, info); return;
-			case 15 * 2: info->instr = Instruction::ps_madds1; FrDacb(instr, info); return;
-			case (15 * 2) | RcBit: info->instr = Instruction::ps_madds1_d; FrDacb(instr, info); return;
-			case 28 * 2: info->instr = Instruction::ps_msub; FrDacb(instr, info); return;
-			case (28 * 2) | RcBit: info->instr = Instruction::ps_msub_d; FrDacb(instr, info); return;
-			case 25 * 2: info->instr = Instruction::ps_mul; FrDac(instr, info); return;
-			case (25 * 2) | RcBit: info->instr = Instruction::ps_mul_d; FrDac(instr, info); return;
-			case 12 * 2: info->instr = Instruction::ps_muls0; FrDac(instr, info); return;
-			case (12 * 2) | RcBit: info->instr = Instruction::ps_muls0_d; FrDac(instr, info); return;
-			case 13 * 2: info->instr = Instruction::ps_muls1; FrDac(instr, info); return;
-			case (13 * 2) | RcBit: info->instr = Instruction::ps_muls1_d; FrDac(instr, info); return;
-			case 31 * 2: info->instr = Instruction::ps_nmadd; FrDacb(instr, info); return;
-			case (31 * 2) | RcBit: info->instr = Instruction::ps_nmadd_d; FrDacb(instr, info); return;
-			case 30 * 2: info->instr = Instruction::ps_nmsub; FrDacb(instr, info); return;
-			case (30 * 2) | RcBit: info->instr = Instruction::ps_nmsub_d; FrDacb(instr, info); return;
-			case 23 * 2: info->instr = Instruction::ps_sel; FrDacb(instr, info); return;
-			case (23 * 2) | RcBit: info->instr = Instruction::ps_sel_d; FrDacb(instr, info); return;
-			case 10 * 2: info->instr = Instruction::ps_sum0; FrDacb(instr, info); return;
-			case (10 * 2) | RcBit: info->instr = Instruction::ps_sum0_d; FrDacb(instr, info); return;
-			case 11 * 2: info->instr = Instruction::ps_sum1; FrDacb(instr, info); return;
-			case (11 * 2) | RcBit: info->instr = Instruction::ps_sum1_d; FrDacb(instr, info); return;
-		}
-
-		switch (instr & 0x7ff)
-		{
-			case 1014 * 2: info->instr = Instruction::dcbz_l; Ab(instr, info); break;
-
-			case 264 * 2: info->instr = Instruction::ps_abs; FrDb(instr, info); break;
-			case (264 * 2) | RcBit: info->instr = Instruction::ps_abs_d; FrDb(instr, info); break;
-			case 21 * 2: info->instr = Instruction::ps_add; FrDab(instr, info); break;
-			case (21 * 2) | RcBit: info->instr = Instruction::ps_add_d; FrDab(instr, info); break;
-			case 32 * 2: info->instr = Instruction::ps_cmpo0; CrfdFrAb(instr, info); break;
-			case 96 * 2: info->instr = Instruction::ps_cmpo1; CrfdFrAb(instr, info); break;
-			case 0	   : info->instr = Instruction::ps_cmpu0; CrfdFrAb(instr, info); break;
-			case 64 * 2: info->instr = Instruction::ps_cmpu1; CrfdFrAb(instr, info); break;
-			case 18 * 2: info->instr = Instruction::ps_div; FrDab(instr, info); break;
-			case (18 * 2) | RcBit: info->instr = Instruction::ps_div_d; FrDab(instr, info); break;
-			case 528 * 2: info->instr = Instruction::ps_merge00; FrDab(instr, info); break;
-			case (528 * 2) | RcBit: info->instr = Instruction::ps_merge00_d; FrDab(instr, info); break;
-			case 560 * 2: info->instr = Instruction::ps_merge01; FrDab(instr, info); break;
-			case (560 * 2) | RcBit: info->instr = Instruction::ps_merge01_d; FrDab(instr, info); break;
-			case 592 * 2: info->instr = Instruction::ps_merge10; FrDab(instr, info); break;
-			case (592 * 2) | RcBit: info->instr = Instruction::ps_merge10_d; FrDab(instr, info); break;
-			case 624 * 2: info->instr = Instruction::ps_merge11; FrDab(instr, info); break;
-			case (624 * 2) | RcBit: info->instr = Instruction::ps_merge11_d; FrDab(instr, info); break;
-			case 72 * 2: info->instr = Instruction::ps_mr; FrDb(instr, info); break;
-			case (72 * 2) | RcBit: info->instr = Instruction::ps_mr_d; FrDb(instr, info); break;
-			case 136 * 2: info->instr = Instruction::ps_nabs; FrDb(instr, info); break;
-			case (136 * 2) | RcBit: info->instr = Instruction::ps_nabs_d; FrDb(instr, info); break;
-			case 40 * 2: info->instr = Instruction::ps_neg; FrDb(instr, info); break;
-			case (40 * 2) | RcBit: info->instr = Instruction::ps_neg_d; FrDb(instr, info); break;
-			case 24 * 2: info->instr = Instruction::ps_res; FrDb(instr, info); break;
-			case (24 * 2) | RcBit: info->instr = Instruction::ps_res_d; FrDb(instr, info); break;
-			case 26 * 2: info->instr = Instruction::ps_rsqrte; FrDb(instr, info); break;
-			case (26 * 2) | RcBit: info->instr = Instruction::ps_rsqrte_d; FrDb(instr, info); break;
-			case 20 * 2: info->instr = Instruction::ps_sub; FrDab(instr, info); break;
-			case (20 * 2) | RcBit: info->instr = Instruction::ps_sub_d; FrDab(instr, info); break;
-		}
-	}
+	#pragma region "Parameters"
 
-	void Analyzer::Op4Fast(uint32_t instr, AnalyzeInfo* info)
+	void Analyzer::NoParam(uint32_t instr, AnalyzeInfo* info)
 	{
-		switch (instr & 0x7f)
-		{
-			case 38 * 2: info->instr = Instruction::psq_lux; FrAbWiFast(instr, info); return;	// Watch for return
-			case 6 * 2: info->instr = Instruction::psq_lx; FrAbWiFast(instr, info); return;
-			case 39 * 2: info->instr = Instruction::psq_stux; FrAbWiFast(instr, info); return;
-			case 7 * 2: info->instr = Instruction::psq_stx; FrAbWiFast(instr, info); return;
-		}
-
-		// If none of the PS Load/Store instructions fits, continue to check further
-
-		// Check Madd first
-
-		switch (instr & 0x3f)
-		{
-			case 29 * 2: info->instr = Instruction::ps_madd; FrDacbFast(instr, info); return;
-			case (29 * 2) | RcBit: info->instr = Instruction::ps_madd_d; FrDacbFast(instr, info); return;
-			case 14 * 2: info->instr = Instruction::ps_madds0; FrDacbFast(instr, info); return;
-			case (14 * 2) | RcBit: info->instr = Instruction::ps_madds0_d; FrDacbFast(instr, info); return;
-			case 15 * 2: info->instr = Instruction::ps_madds1; FrDacbFast(instr, info); return;
-			case (15 * 2) | RcBit: info->instr = Instruction::ps_madds1_d; FrDacbFast(instr, info); return;
-			case 28 * 2: info->instr = Instruction::ps_msub; FrDacbFast(instr, info); return;
-			case (28 * 2) | RcBit: info->instr = Instruction::ps_msub_d; FrDacbFast(instr, info); return;
-			case 25 * 2: info->instr = Instruction::ps_mul; FrDacFast(instr, info); return;
-			case (25 * 2) | RcBit: info->instr = Instruction::ps_mul_d; FrDacFast(instr, info); return;
-			case 12 * 2: info->instr = Instruction::ps_muls0; FrDacFast(instr, info); return;
-			case (12 * 2) | RcBit: info->instr = Instruction::ps_muls0_d; FrDacFast(instr, info); return;
-			case 13 * 2: info->instr = Instruction::ps_muls1; FrDacFast(instr, info); return;
-			case (13 * 2) | RcBit: info->instr = Instruction::ps_muls1_d; FrDacFast(instr, info); return;
-			case 31 * 2: info->instr = Instruction::ps_nmadd; FrDacbFast(instr, info); return;
-			case (31 * 2) | RcBit: info->instr = Instruction::ps_nmadd_d; FrDacbFast(instr, info); return;
-			case 30 * 2: info->instr = Instruction::ps_nmsub; FrDacbFast(instr, info); return;
-			case (30 * 2) | RcBit: info->instr = Instruction::ps_nmsub_d; FrDacbFast(instr, info); return;
-			case 23 * 2: info->instr = Instruction::ps_sel; FrDacbFast(instr, info); return;
-			case (23 * 2) | RcBit: info->instr = Instruction::ps_sel_d; FrDacbFast(instr, info); return;
-			case 10 * 2: info->instr = Instruction::ps_sum0; FrDacbFast(instr, info); return;
-			case (10 * 2) | RcBit: info->instr = Instruction::ps_sum0_d; FrDacbFast(instr, info); return;
-			case 11 * 2: info->instr = Instruction::ps_sum1; FrDacbFast(instr, info); return;
-			case (11 * 2) | RcBit: info->instr = Instruction::ps_sum1_d; FrDacbFast(instr, info); return;
-		}
-
-		switch (instr & 0x7ff)
-		{
-			case 1014 * 2: info->instr = Instruction::dcbz_l; AbFast(instr, info); break;
-
-			case 264 * 2: info->instr = Instruction::ps_abs; FrDbFast(instr, info); break;
-			case (264 * 2) | RcBit: info->instr = Instruction::ps_abs_d; FrDbFast(instr, info); break;
-			case 21 * 2: info->instr = Instruction::ps_add; FrDabFast(instr, info); break;
-			case (21 * 2) | RcBit: info->instr = Instruction::ps_add_d; FrDabFast(instr, info); break;
-			case 32 * 2: info->instr = Instruction::ps_cmpo0; CrfdFrAbFast(instr, info); break;
-			case 96 * 2: info->instr = Instruction::ps_cmpo1; CrfdFrAbFast(instr, info); break;
-			case 0	   : info->instr = Instruction::ps_cmpu0; CrfdFrAbFast(instr, info); break;
-			case 64 * 2: info->instr = Instruction::ps_cmpu1; CrfdFrAbFast(instr, info); break;
-			case 18 * 2: info->instr = Instruction::ps_div; FrDabFast(instr, info); break;
-			case (18 * 2) | RcBit: info->instr = Instruction::ps_div_d; FrDabFast(instr, info); break;
-			case 528 * 2: info->instr = Instruction::ps_merge00; FrDabFast(instr, info); break;
-			case (528 * 2) | RcBit: info->instr = Instruction::ps_merge00_d; FrDabFast(instr, info); break;
-			case 560 * 2: info->instr = Instruction::ps_merge01; FrDabFast(instr, info); break;
-			case (560 * 2) | RcBit: info->instr = Instruction::ps_merge01_d; FrDabFast(instr, info); break;
-			case 592 * 2: info->instr = Instruction::ps_merge10; FrDabFast(instr, info); break;
-			case (592 * 2) | RcBit: info->instr = Instruction::ps_merge10_d; FrDabFast(instr, info); break;
-			case 624 * 2: info->instr = Instruction::ps_merge11; FrDabFast(instr, info); break;
-			case (624 * 2) | RcBit: info->instr = Instruction::ps_merge11_d; FrDabFast(instr, info); break;
-			case 72 * 2: info->instr = Instruction::ps_mr; FrDbFast(instr, info); break;
-			case (72 * 2) | RcBit: info->instr = Instruction::ps_mr_d; FrDbFast(instr, info); break;
-			case 136 * 2: info->instr = Instruction::ps_nabs; FrDbFast(instr, info); break;
-			case (136 * 2) | RcBit: info->instr = Instruction::ps_nabs_d; FrDbFast(instr, info); break;
-			case 40 * 2: info->instr = Instruction::ps_neg; FrDbFast(instr, info); break;
-			case (40 * 2) | RcBit: info->instr = Instruction::ps_neg_d; FrDbFast(instr, info); break;
-			case 24 * 2: info->instr = Instruction::ps_res; FrDbFast(instr, info); break;
-			case (24 * 2) | RcBit: info->instr = Instruction::ps_res_d; FrDbFast(instr, info); break;
-			case 26 * 2: info->instr = Instruction::ps_rsqrte; FrDbFast(instr, info); break;
-			case (26 * 2) | RcBit: info->instr = Instruction::ps_rsqrte_d; FrDbFast(instr, info); break;
-			case 20 * 2: info->instr = Instruction::ps_sub; FrDabFast(instr, info); break;
-			case (20 * 2) | RcBit: info->instr = Instruction::ps_sub_d; FrDabFast(instr, info); break;
-		}
 	}
 
-	#pragma endregion "Primary 4"
-
-	#pragma region "Parameters"
-
 	void Analyzer::Dab(uint32_t instr, AnalyzeInfo* info)
 	{
 		info->numParam = 3;
@@ -1811,6 +1299,106 @@ namespace Gekko
 		info->Imm.Signed = DIS_SIMM;
 	}
 
+	const Analyzer::ParamParser Analyzer::paramParsers[(size_t)AnalyzeForm::Max] = {
+		NoParam,
+		Dab,
+		FrDRegAb,
+		DaSimm,
+		Da,
+		Asb,
+		AsUimm,
+		TargetAddr,
+		BoBiTargetAddr,
+		BoBi,
+		CrfDab,
+		CrfDaSimm,
+		CrfDaUimm,
+		As,
+		CrbDab,
+		Ab,
+		FrDb,
+		FrDab,
+		CrfdFrAb,
+		FrDacb,
+		FrDac,
+		DaOffset,
+		FrdaOffset,
+		DaNb,
+		Crfds,
+		Crfd,
+		D,
+		B,
+		Frd,
+		DSpr,
+		DSr,
+		Db,
+		DTbr,
+		Crms,
+		Crbd,
+		FmFrb,
+		CrfdImm,
+		SprS,
+		SrS,
+		FrRegOffsetWi,
+		FrAbWi,
+		AsImm3,
+		AsbImm2,
+		AsImm,
+		SaImm,
+		ImmAb,
+		ImmASimm,
+	};
+
+	const Analyzer::ParamParser Analyzer::paramParsersFast[(size_t)AnalyzeForm::Max] = {
+		NoParam,
+		DabFast,
+		FrDRegAbFast,
+		DaSimmFast,
+		DaFast,
+		AsbFast,
+		AsUimmFast,
+		TargetAddrFast,
+		BoBiTargetAddrFast,
+		BoBiFast,
+		CrfDabFast,
+		CrfDaSimmFast,
+		CrfDaUimmFast,
+		AsFast,
+		CrbDabFast,
+		AbFast,
+		FrDbFast,
+		FrDabFast,
+		CrfdFrAbFast,
+		FrDacbFast,
+		FrDacFast,
+		DaOffsetFast,
+		FrdaOffsetFast,
+		DaNbFast,
+		CrfdsFast,
+		CrfdFast,
+		DFast,
+		BFast,
+		FrdFast,
+		DSprFast,
+		DSrFast,
+		DbFast,
+		DTbrFast,
+		CrmsFast,
+		CrbdFast,
+		FmFrbFast,
+		CrfdImmFast,
+		SprSFast,
+		SrSFast,
+		FrRegOffsetWiFast,
+		FrAbWiFast,
+		AsImm3Fast,
+		AsbImm2Fast,
+		AsImmFast,
+		SaImmFast,
+		ImmAbFast,
+		ImmASimmFast,
+	};
+
 	#pragma endregion "Parameters"
 
 	void Analyzer::Analyze(uint32_t pc, uint32_t instr, AnalyzeInfo* info)
@@ -1820,15 +1408,16 @@ namespace Gekko
 		info->pc = pc;
 		info->flow = false;
 
-		switch (instr >> 26)
-		{
-			case 4: Op4(instr, info); break;
-			case 19: Op19(instr, info); break;
-			case 31: Op31(instr, info); break;
-			case 59: Op59(instr, info); break;
-			case 63: Op63(instr, info); break;
-			default: OpMain(instr, info); break;
-		}
+		const DecodeEntry& entry = Decode(instr);
+
+		if ((entry.flags & DecodeLZero) && (DIS_RD & 1))
+			return;
+
+		info->instr = (Instruction)entry.instr;
+		if (entry.form != AnalyzeForm::None)
+			paramParsers[(size_t)entry.form](instr, info);
+		if (entry.flags & DecodeFlow)
+			info->flow = true;
 	}
 
 	void Analyzer::AnalyzeFast(uint32_t pc, uint32_t instr, AnalyzeInfo* info)
@@ -1838,15 +1427,120 @@ namespace Gekko
 		info->pc = pc;
 		info->flow = false;
 
-		switch (instr >> 26)
+		const DecodeEntry& entry = Decode(instr);
+
+		if ((entry.flags & DecodeLZero) && (DIS_RD & 1))
+			return;
+
+		info->instr = (Instruction)entry.instr;
+		if (entry.form != AnalyzeForm::None)
+			paramParsersFast[(size_t)entry.form](instr, info);
+		if (entry.flags & DecodeFlow)
+			info->flow = true;
+	}
+
+	// A busy-wait loop is a straight piece of code that ends with a relative branch back to its start (no link, no CTR update)
+	// and contains only loads, compares and simple register moves. Everything the loop writes must be recomputed by each iteration
+	// (no loop-carried registers), so the only thing that changes between iterations is the polled state and the passed time.
+
+	bool Analyzer::IsIdleLoop(uint32_t pc, const uint32_t* code, size_t count)
+	{
+		AnalyzeInfo info;
+		uint32_t written = 0;		// GPRs written by the loop
+		uint32_t readFirst = 0;		// GPRs read before they are written by the iteration
+
+		if (count == 0)
+			return false;
+
+		for (size_t i = 0; i < count - 1; i++)
 		{
-			case 4: Op4Fast(instr, info); break;
-			case 19: Op19Fast(instr, info); break;
-			case 31: Op31Fast(instr, info); break;
-			case 59: Op59Fast(instr, info); break;
-			case 63: Op63Fast(instr, info); break;
-			default: OpMainFast(instr, info); break;
+			uint32_t instr = code[i];
+			int rd = (instr >> 21) & 0x1f;
+			int ra = (instr >> 16) & 0x1f;
+			int rb = (instr >> 11) & 0x1f;
+			uint32_t reads = 0, writes = 0;
+
+			AnalyzeFast(pc + 4 * (uint32_t)i, instr, &info);
+
+			switch (info.instr)
+			{
+				case Instruction::lbz:
+				case Instruction::lhz:
+				case Instruction::lha:
+				case Instruction::lwz:
+				case Instruction::addi:
+					reads = ra ? (1 << ra) : 0;
+					writes = 1 << rd;
+					break;
+
+				case Instruction::lbzx:
+				case Instruction::lhzx:
+				case Instruction::lhax:
+				case Instruction::lwzx:
+					reads = (ra ? (1 << ra) : 0) | (1 << rb);
+					writes = 1 << rd;
+					break;
+
+				case Instruction::cmpi:
+				case Instruction::cmpli:
+					reads = 1 << ra;
+					break;
+
+				case Instruction::cmp:
+				case Instruction::cmpl:
+					reads = (1 << ra) | (1 << rb);
+					break;
+
+				case Instruction::ori:
+				case Instruction::andi_d:
+				case Instruction::rlwinm:
+				case Instruction::rlwinm_d:
+					reads = 1 << rd;
+					writes = 1 << ra;
+					break;
+
+				case Instruction::mftb:
+					writes = 1 << rd;
+					break;
+
+				default:
+					return false;
+			}
+
+			readFirst |= reads & ~written;
+			written |= writes;
 		}
+
+		if ((readFirst & written) != 0)
+			return false;
+
+		uint32_t branch = code[count - 1];
+		uint32_t branchPc = pc + 4 * (uint32_t)(count - 1);
+		uint32_t target;
+
+		switch (branch >> 26)
+		{
+			case 18:	// b
+				target = branch & 0x03ff'fffc;
+				if (target & 0x0200'0000) target |= 0xfc00'0000;
+				break;
+
+			case 16:	// bc, CTR must not be decremented (BO[2] set)
+				if ((branch & (4 << 21)) == 0)
+					return false;
+				target = branch & 0xfffc;
+				if (target & 0x8000) target |= 0xffff'0000;
+				break;
+
+			default:
+				return false;
+		}
+
+		// AA = 0, LK = 0
+		if ((branch & 3) != 0)
+			return false;
+
+		return branchPc + target == pc;
 	}
 
 }
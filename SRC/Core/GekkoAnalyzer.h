@@ -417,6 +417,59 @@ namespace Gekko
 		Address,
 	};
 
+	// Operand layout of an instruction. Selects the parameter parser of the analyzer.
+	enum class AnalyzeForm : uint8_t
+	{
+		None = 0,
+		Dab,
+		FrDRegAb,
+		DaSimm,
+		Da,
+		Asb,
+		AsUimm,
+		TargetAddr,
+		BoBiTargetAddr,
+		BoBi,
+		CrfDab,
+		CrfDaSimm,
+		CrfDaUimm,
+		As,
+		CrbDab,
+		Ab,
+		FrDb,
+		FrDab,
+		CrfdFrAb,
+		FrDacb,
+		FrDac,
+		DaOffset,
+		FrdaOffset,
+		DaNb,
+		Crfds,
+		Crfd,
+		D,
+		B,
+		Frd,
+		DSpr,
+		DSr,
+		Db,
+		DTbr,
+		Crms,
+		Crbd,
+		FmFrb,
+		CrfdImm,
+		SprS,
+		SrS,
+		FrRegOffsetWi,
+		FrAbWi,
+		AsImm3,
+		AsbImm2,
+		AsImm,
+		SaImm,
+		ImmAb,
+		ImmASimm,
+		Max,
+	};
+
 	struct AnalyzeInfo
 	{
 		uint32_t	instrBits;
@@ -441,20 +494,7 @@ namespace Gekko
 
 	class Analyzer
 	{
-		static void OpMain(uint32_t instr, AnalyzeInfo* info);
-		static void Op19(uint32_t instr, AnalyzeInfo* info);
-		static void Op31(uint32_t instr, AnalyzeInfo* info);
-		static void Op59(uint32_t instr, AnalyzeInfo* info);
-		static void Op63(uint32_t instr, AnalyzeInfo* info);
-		static void Op4(uint32_t instr, AnalyzeInfo* info);
-
-		static void OpMainFast(uint32_t instr, AnalyzeInfo* info);
-		static void Op19Fast(uint32_t instr, AnalyzeInfo* info);
-		static void Op31Fast(uint32_t instr, AnalyzeInfo* info);
-		static void Op59Fast(uint32_t instr, AnalyzeInfo* info);
-		static void Op63Fast(uint32_t instr, AnalyzeInfo* info);
-		static void Op4Fast(uint32_t instr, AnalyzeInfo* info);
-
+		static void NoParam(uint32_t instr, AnalyzeInfo* info);
 		static void Dab(uint32_t instr, AnalyzeInfo* info);
 		static void DabFast(uint32_t instr, AnalyzeInfo* info);
 		static void FrDRegAb(uint32_t instr, AnalyzeInfo* info);
@@ -548,12 +588,21 @@ namespace Gekko
 		static void ImmASimm(uint32_t instr, AnalyzeInfo* info);
 		static void ImmASimmFast(uint32_t instr, AnalyzeInfo* info);
 
+		typedef void (*ParamParser)(uint32_t instr, AnalyzeInfo* info);
+
+		// Indexed by AnalyzeForm
+		static const ParamParser paramParsers[(size_t)AnalyzeForm::Max];
+		static const ParamParser paramParsersFast[(size_t)AnalyzeForm::Max];
+
 	public:
 
 		static void Analyze(uint32_t pc, uint32_t instr, AnalyzeInfo* info);
 
 		// The fast version is used if the user knows the number of parameters.
 		static void AnalyzeFast(uint32_t pc, uint32_t instr, AnalyzeInfo* info);
+
+		// Check if the code at pc is a busy-wait loop that only polls memory, registers or the time base.
+		static bool IsIdleLoop(uint32_t pc, const uint32_t* code, size_t count);
 	};
 
 }
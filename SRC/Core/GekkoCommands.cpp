@@ -332,14 +332,16 @@ namespace Gekko
 	static Json::Value* cmd_br(std::vector<std::string>& args)
 	{
 		uint32_t addr = strtoul(args[1].c_str(), nullptr, 0);
-		Gekko->AddReadBreak(addr);
+		uint32_t size = args.size() > 2 ? strtoul(args[2].c_str(), nullptr, 0) : 1;
+		Gekko->AddReadBreak(addr, size);
 		return nullptr;
 	}
 
 	static Json::Value* cmd_bw(std::vector<std::string>& args)
 	{
 		uint32_t addr = strtoul(args[1].c_str(), nullptr, 0);
-		Gekko->AddWriteBreak(addr);
+		uint32_t size = args.size() > 2 ? strtoul(args[2].c_str(), nullptr, 0) : 1;
+		Gekko->AddWriteBreak(addr, size);
 		return nullptr;
 	}
 
@@ -363,6 +365,37 @@ namespace Gekko
 		return nullptr;
 	}
 
+	static Json::Value* IdleSkip(std::vector<std::string>& args)
+	{
+		bool enable = atoi(args[1].c_str()) ? true : false;
+		Gekko->EnableIdleSkip(enable);
+		return nullptr;
+	}
+
+	static Json::Value* IdleStats(std::vector<std::string>& args)
+	{
+		int64_t skipped = Gekko->GetIdleSkippedTicks();
+
+		DBReport("IdleStats:\n");
+		DBReport("Idle skip: %s\n", Gekko->IsIdleSkipEnabled() ? "enabled" : "disabled");
+		DBReport("Skipped cycles: %I64u (%I64u ms)\n", skipped, skipped / Gekko->OneMillisecond());
+		DBReport("Skips: %I64u\n", Gekko->GetIdleSkipCount());
+
+		Json::Value* output = new Json::Value();
+		output->type = Json::ValueType::Object;
+
+		output->AddUInt64("skippedCycles", skipped);
+		output->AddUInt64("skips", Gekko->GetIdleSkipCount());
+
+		return output;
+	}
+
+	static Json::Value* IdleResetStats(std::vector<std::string>& args)
+	{
+		Gekko->ResetIdleStats();
+		return nullptr;
+	}
+
 	void gekko_init_handlers()
 	{
 		Debug::Hub.AddCmd("run", cmd_run);
@@ -374,5 +407,8 @@ namespace Gekko
 		Debug::Hub.AddCmd("bc", cmd_bc);
 		Debug::Hub.AddCmd("CacheLog", CacheLog);
 		Debug::Hub.AddCmd("CacheDebugDisable", CacheDebugDisable);
+		Debug::Hub.AddCmd("IdleSkip", IdleSkip);
+		Debug::Hub.AddCmd("IdleStats", IdleStats);
+		Debug::Hub.AddCmd("IdleResetStats", IdleResetStats);
 	}
 }
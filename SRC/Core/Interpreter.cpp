@@ -11,11 +11,11 @@ namespace Gekko
 
         // execute one instruction
         // (possible CPU_EXCEPTION_DSI, ISI, ALIGN, PROGRAM, FPUNAVAIL, SYSCALL)
-        //pa = core->EffectiveToPhysical(Gekko->regs.pc, MmuAccess::Execute);
-        pa = core->EffectiveToPhysical(Gekko->regs.pc, MmuAccess::Execute, WIMG);
+        //pa = core->EffectiveToPhysical(core->regs.pc, MmuAccess::Execute);
+        pa = core->EffectiveToPhysical(core->regs.pc, MmuAccess::Execute, WIMG);
         if (pa == Gekko::BadAddress)
         {
-            Gekko->Exception(Exception::ISI);
+            core->Exception(Exception::ISI);
         }
         else
         {
@@ -27,7 +27,7 @@ namespace Gekko
             core->exception = false;
             return;
         }
-        c_1[op >> 26](op);
+        c_1[op >> 26](core, op);
         core->ops++;
         // DSI, ALIGN, PROGRAM, FPUNA, SC
         if (core->exception)
@@ -36,7 +36,7 @@ namespace Gekko
             return;
         }
 
-        Gekko->Tick();
+        core->Tick();
 
         core->exception = false;
     }
@@ -44,8 +44,8 @@ namespace Gekko
     // For testing
     void Interpreter::ExecuteOpcodeDirect(uint32_t pc, uint32_t instr)
     {
-        Gekko->regs.pc = pc;
-        c_1[instr >> 26](instr);
+        core->regs.pc = pc;
+        c_1[instr >> 26](core, instr);
     }
 
     bool Interpreter::ExecuteInterpeterFallback()
@@ -56,17 +56,17 @@ namespace Gekko
         // execute one instruction
         // (possible CPU_EXCEPTION_DSI, ISI, ALIGN, PROGRAM, FPUNAVAIL, SYSCALL)
         //pa = core->EffectiveToPhysical(core->regs.pc, MmuAccess::Execute);
-        pa = core->EffectiveToPhysical(Gekko->regs.pc, MmuAccess::Execute, WIMG);
+        pa = core->EffectiveToPhysical(core->regs.pc, MmuAccess::Execute, WIMG);
         if (pa == Gekko::BadAddress)
         {
-            Gekko->Exception(Exception::ISI);
+            core->Exception(Exception::ISI);
         }
         else
         {
             MIReadWord(pa, &op);
         }
         if (core->exception) goto JumpPC;  // ISI
-        c_1[op >> 26](op); core->ops++;
+        c_1[op >> 26](core, op); core->ops++;
         if (core->exception) goto JumpPC;  // DSI, ALIGN, PROGRAM, FPUNA, SC
 
         core->Tick();
@@ -81,6 +81,205 @@ namespace Gekko
         return false;
     }
 
+#pragma region "Cached interpreter"
+
+    // Get the final handler, bypassing the extension opcode tables switch
+    void (*Interpreter::ResolveHandler(uint32_t op))(GekkoCore* core, uint32_t op)
+    {
+        switch (op >> 26)
+        {
+            case 4: return c_4[op & 0x7ff];
+            case 19: return c_19[op & 0x7ff];
+            case 31: return c_31[op & 0x7ff];
+            case 59: return c_59[op & 0x3f];
+            case 63: return c_63[op & 0x7ff];
+            default: return c_1[op >> 26];
+        }
+    }
+
+    static bool EndsCachedBlock(Instruction instr)
+    {
+        switch (instr)
+        {
+            case Instruction::sc:
+            case Instruction::rfi:
+            case Instruction::mtmsr:
+            case Instruction::mtspr:
+            case Instruction::mtsr:
+            case Instruction::mtsrin:
+            case Instruction::isync:
+            case Instruction::tlbie:
+            case Instruction::tlbsync:
+            case Instruction::icbi:
+            case Instruction::Unknown:
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    Interpreter::CachedBlock* Interpreter::CacheBlock(uint32_t ea, uint32_t pa)
+    {
+        AnalyzeInfo info = { 0 };
+        CachedBlock* block = new CachedBlock();
+        assert(block);
+
+        block->pa = pa;
+        block->idle = false;
+
+        uint32_t startEa = ea;
+        uint32_t addr = pa;
+
+        while (block->instr.size() < cachedBlockMaxInstructions)
+        {
+            uint32_t op;
+            MIReadWord(addr, &op);
+
+            block->instr.push_back({ ResolveHandler(op), op });
+
+            Analyzer::AnalyzeFast(ea, op, &info);
+
+            ea += 4;
+            addr += 4;
+
+            // Stop on program flow change, on instructions that may change the address translation
+            // or invalidate the code (the rest of the block would be stale), and on the page boundary.
+
+            if (info.flow || (addr & 0xfff) == 0 || EndsCachedBlock(info.instr))
+                break;
+        }
+
+        if (block->instr.size() <= idleLoopMaxInstructions)
+        {
+            uint32_t code[idleLoopMaxInstructions];
+
+            for (size_t i = 0; i < block->instr.size(); i++)
+            {
+                code[i] = block->instr[i].op;
+            }
+
+            block->idle = Analyzer::IsIdleLoop(startEa, code, block->instr.size());
+        }
+
+        cachedBlocks[pa] = block;
+        cachedPages[pa >> 12].push_back(pa);
+        Debug::PerfAdd(Debug::PerfCounter::GekkoCachedBlocks);
+
+        return block;
+    }
+
+    void Interpreter::FreeRetiredBlocks()
+    {
+        for (auto it = retiredBlocks.begin(); it != retiredBlocks.end(); ++it)
+        {
+            delete *it;
+        }
+        retiredBlocks.clear();
+    }
+
+    // Execute the basic block at the current PC. Same semantics as ExecuteOpcode in a loop.
+    void Interpreter::ExecuteCached()
+    {
+        int WIMG;
+        uint32_t pc = core->regs.pc;
+        uint32_t startPc = pc;
+
+        if (!retiredBlocks.empty())
+        {
+            FreeRetiredBlocks();
+        }
+
+        uint32_t pa = core->EffectiveToPhysical(pc, MmuAccess::Execute, WIMG);
+        if (pa == Gekko::BadAddress)
+        {
+            core->Exception(Exception::ISI);
+            core->exception = false;
+            return;
+        }
+
+        CachedBlock* block;
+        auto it = cachedBlocks.find(pa);
+        if (it != cachedBlocks.end())
+        {
+            block = it->second;
+        }
+        else
+        {
+            block = CacheBlock(pc, pa);
+        }
+
+        CachedInstr* instr = block->instr.data();
+        CachedInstr* last = instr + block->instr.size();
+
+        while (instr != last)
+        {
+            instr->handler(core, instr->op);
+            core->ops++;
+            // DSI, ALIGN, PROGRAM, FPUNA, SC
+            if (core->exception)
+            {
+                core->exception = false;
+                return;
+            }
+
+            core->Tick();
+
+            // Branch taken, or interrupt/decrementer exception (BranchCheck)
+            pc += 4;
+            if (core->regs.pc != pc)
+                break;
+
+            instr++;
+        }
+
+        // Busy-wait loop went for another iteration
+        if (block->idle && core->regs.pc == startPc && core->idleSkip)
+        {
+            core->SkipIdle();
+        }
+    }
+
+    // Drop all blocks on the pages touched by the physical range
+    void Interpreter::InvalidateCached(uint32_t pa, size_t size)
+    {
+        if (size == 0)
+            return;
+
+        for (uint32_t page = pa >> 12; page <= (uint32_t)((pa + size - 1) >> 12); page++)
+        {
+            auto it = cachedPages.find(page);
+            if (it == cachedPages.end())
+                continue;
+
+            for (auto start = it->second.begin(); start != it->second.end(); ++start)
+            {
+                auto block = cachedBlocks.find(*start);
+                if (block != cachedBlocks.end())
+                {
+                    retiredBlocks.push_back(block->second);
+                    cachedBlocks.erase(block);
+                    Debug::PerfAdd(Debug::PerfCounter::GekkoCachedInvalidations);
+                }
+            }
+
+            cachedPages.erase(it);
+        }
+    }
+
+    void Interpreter::InvalidateCachedAll()
+    {
+        Debug::PerfAdd(Debug::PerfCounter::GekkoCachedInvalidations, cachedBlocks.size());
+
+        for (auto it = cachedBlocks.begin(); it != cachedBlocks.end(); ++it)
+        {
+            retiredBlocks.push_back(it->second);
+        }
+        cachedBlocks.clear();
+        cachedPages.clear();
+    }
+
+#pragma endregion "Cached interpreter"
+
     uint32_t Interpreter::GetRotMask(int mb, int me)
     {
         return rotmask[mb][me];
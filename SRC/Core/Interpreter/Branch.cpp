@@ -5,21 +5,21 @@
 namespace Gekko
 {
 
-    void Interpreter::BranchCheck()
+    void Interpreter::BranchCheck(GekkoCore* core)
     {
-        if (Gekko->intFlag && (Gekko->regs.msr & MSR_EE))
+        if (core->intFlag && (core->regs.msr & MSR_EE))
         {
-            Gekko->Exception(Gekko::Exception::INTERRUPT);
-            Gekko->exception = false;
+            core->Exception(Gekko::Exception::INTERRUPT);
+            core->exception = false;
             return;
         }
 
         // modify CPU counters (possible CPU_EXCEPTION_DECREMENTER)
-        Gekko->Tick();
-        if (Gekko->decreq && (Gekko->regs.msr & MSR_EE))
+        core->Tick();
+        if (core->decreq && (core->regs.msr & MSR_EE))
         {
-            Gekko->decreq = false;
-            Gekko->Exception(Gekko::Exception::DECREMENTER);
+            core->decreq = false;
+            core->Exception(Gekko::Exception::DECREMENTER);
         }
     }
 
@@ -28,7 +28,7 @@ namespace Gekko
     {
         uint32_t target = op & 0x03fffffc;
         if (target & 0x02000000) target |= 0xfc000000;
-        Gekko->regs.pc = Gekko->regs.pc + target;
+        core->regs.pc = core->regs.pc + target;
     }
 
     // PC = EXTS(LI || 0b00)
@@ -36,7 +36,7 @@ namespace Gekko
     {
         uint32_t target = op & 0x03fffffc;
         if (target & 0x02000000) target |= 0xfc000000;
-        Gekko->regs.pc = target;
+        core->regs.pc = target;
     }
 
     // LR = PC + 4, PC = PC + EXTS(LI || 0b00)
@@ -44,8 +44,8 @@ namespace Gekko
     {
         uint32_t target = op & 0x03fffffc;
         if (target & 0x02000000) target |= 0xfc000000;
-        Gekko->regs.spr[(int)SPR::LR] = Gekko->regs.pc + 4;
-        Gekko->regs.pc = Gekko->regs.pc + target;
+        core->regs.spr[(int)SPR::LR] = core->regs.pc + 4;
+        core->regs.pc = core->regs.pc + target;
     }
 
     // LR = PC + 4, PC = EXTS(LI || 0b00)
@@ -53,37 +53,37 @@ namespace Gekko
     {
         uint32_t target = op & 0x03fffffc;
         if (target & 0x02000000) target |= 0xfc000000;
-        Gekko->regs.spr[(int)SPR::LR] = Gekko->regs.pc + 4;
-        Gekko->regs.pc = target;
+        core->regs.spr[(int)SPR::LR] = core->regs.pc + 4;
+        core->regs.pc = target;
     }
 
     OP(BX)
     {
-        bx[op & 3](op);
-        BranchCheck();
+        bx[op & 3](core, op);
+        BranchCheck(core);
     }
 
     // ---------------------------------------------------------------------------
 
     // calculation of conditional branch
-    static bool bc(uint32_t op)
+    static bool bc(GekkoCore* core, uint32_t op)
     {
         bool ctr_ok, cond_ok;
         int bo = RD, bi = BI;
 
         if (BO(2) == 0)
         {
-            Gekko->regs.spr[(int)SPR::CTR]--;
+            core->regs.spr[(int)SPR::CTR]--;
 
-            if (BO(3)) ctr_ok = (Gekko->regs.spr[(int)Gekko::SPR::CTR] == 0);
-            else ctr_ok = (Gekko->regs.spr[(int)Gekko::SPR::CTR] != 0);
+            if (BO(3)) ctr_ok = (core->regs.spr[(int)Gekko::SPR::CTR] == 0);
+            else ctr_ok = (core->regs.spr[(int)Gekko::SPR::CTR] != 0);
         }
         else ctr_ok = true;
 
         if (BO(0) == 0)
         {
-            if (BO(1)) cond_ok = ((Gekko->regs.cr << bi) & 0x80000000) != 0;
-            else cond_ok = ((Gekko->regs.cr << bi) & 0x80000000) == 0;
+            if (BO(1)) cond_ok = ((core->regs.cr << bi) & 0x80000000) != 0;
+            else cond_ok = ((core->regs.cr << bi) & 0x80000000) == 0;
         }
         else cond_ok = true;
 
@@ -101,19 +101,19 @@ namespace Gekko
     //          else PC = PC + EXTS(BD || 0b00)
     OP(BCX)
     {
-        if (bc(op))
+        if (bc(core, op))
         {
-            if (op & 1) Gekko->regs.spr[(int)SPR::LR] = Gekko->regs.pc + 4; // LK
+            if (op & 1) core->regs.spr[(int)SPR::LR] = core->regs.pc + 4; // LK
 
             uint32_t target = op & 0xfffc;
             if (target & 0x8000) target |= 0xffff0000;
-            if (op & 2) Gekko->regs.pc = target; // AA
-            else Gekko->regs.pc += target;
-            BranchCheck();
+            if (op & 2) core->regs.pc = target; // AA
+            else core->regs.pc += target;
+            BranchCheck(core);
         }
         else
         {
-            Gekko->regs.pc += 4;
+            core->regs.pc += 4;
         }
     }
 
@@ -124,14 +124,14 @@ namespace Gekko
     //      PC = LR[0-29] || 0b00
     OP(BCLR)
     {
-        if (bc(op))
+        if (bc(core, op))
         {
-            Gekko->regs.pc = Gekko->regs.spr[(int)SPR::LR] & ~3;
-            BranchCheck();
+            core->regs.pc = core->regs.spr[(int)SPR::LR] & ~3;
+            BranchCheck(core);
         }
         else
         {
-            Gekko->regs.pc += 4;
+            core->regs.pc += 4;
         }
     }
 
@@ -144,31 +144,31 @@ namespace Gekko
     //      LR = NLR
     OP(BCLRL)
     {
-        if (bc(op))
+        if (bc(core, op))
         {
-            uint32_t lr = Gekko->regs.pc + 4;
-            Gekko->regs.pc = Gekko->regs.spr[(int)SPR::LR] & ~3;
-            Gekko->regs.spr[(int)SPR::LR] = lr;
-            BranchCheck();
+            uint32_t lr = core->regs.pc + 4;
+            core->regs.pc = core->regs.spr[(int)SPR::LR] & ~3;
+            core->regs.spr[(int)SPR::LR] = lr;
+            BranchCheck(core);
         }
         else
         {
-            Gekko->regs.pc += 4;
+            core->regs.pc += 4;
         }
     }
 
     // ---------------------------------------------------------------------------
 
     // calculation of conditional to count register branch
-    static bool bctr(uint32_t op)
+    static bool bctr(GekkoCore* core, uint32_t op)
     {
         bool cond_ok;
         int bo = RD, bi = BI;
 
         if (BO(0) == 0)
         {
-            if (BO(1)) cond_ok = ((Gekko->regs.cr << bi) & 0x80000000) != 0;
-            else cond_ok = ((Gekko->regs.cr << bi) & 0x80000000) == 0;
+            if (BO(1)) cond_ok = ((core->regs.cr << bi) & 0x80000000) != 0;
+            else cond_ok = ((core->regs.cr << bi) & 0x80000000) == 0;
         }
         else cond_ok = true;
 
@@ -181,14 +181,14 @@ namespace Gekko
     //              PC = CTR || 0b00
     OP(BCCTR)
     {
-        if (bctr(op))
+        if (bctr(core, op))
         {
-            Gekko->regs.pc = Gekko->regs.spr[(int)SPR::CTR] & ~3;
-            BranchCheck();
+            core->regs.pc = core->regs.spr[(int)SPR::CTR] & ~3;
+            BranchCheck(core);
         }
         else
         {
-            Gekko->regs.pc += 4;
+            core->regs.pc += 4;
         }
     }
 
@@ -199,15 +199,15 @@ namespace Gekko
     //              PC = CTR || 0b00
     OP(BCCTRL)
     {
-        if (bctr(op))
+        if (bctr(core, op))
         {
-            Gekko->regs.spr[(int)SPR::LR] = Gekko->regs.pc + 4;
-            Gekko->regs.pc = Gekko->regs.spr[(int)SPR::CTR] & ~3;
-            BranchCheck();
+            core->regs.spr[(int)SPR::LR] = core->regs.pc + 4;
+            core->regs.pc = core->regs.spr[(int)SPR::CTR] & ~3;
+            BranchCheck(core);
         }
         else
         {
-            Gekko->regs.pc += 4;
+            core->regs.pc += 4;
         }
     }
 }
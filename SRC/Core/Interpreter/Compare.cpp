@@ -21,7 +21,7 @@ namespace Gekko
         if (a > b) SET_CR_GT(crfd); else RESET_CR_GT(crfd);
         if (a == b) SET_CR_EQ(crfd); else RESET_CR_EQ(crfd);
         if (IS_XER_SO) SET_CR_SO(crfd); else RESET_CR_SO(crfd);
-        Gekko->regs.pc += 4;
+        core->regs.pc += 4;
     }
 
     // a = ra (signed)
@@ -40,7 +40,7 @@ namespace Gekko
         if (a > b) SET_CR_GT(crfd); else RESET_CR_GT(crfd);
         if (a == b) SET_CR_EQ(crfd); else RESET_CR_EQ(crfd);
         if (IS_XER_SO) SET_CR_SO(crfd); else RESET_CR_SO(crfd);
-        Gekko->regs.pc += 4;
+        core->regs.pc += 4;
     }
 
     // a = ra (unsigned)
@@ -59,7 +59,7 @@ namespace Gekko
         if (a > b) SET_CR_GT(crfd); else RESET_CR_GT(crfd);
         if (a == b) SET_CR_EQ(crfd); else RESET_CR_EQ(crfd);
         if (IS_XER_SO) SET_CR_SO(crfd); else RESET_CR_SO(crfd);
-        Gekko->regs.pc += 4;
+        core->regs.pc += 4;
     }
 
     // a = ra (unsigned)
@@ -79,7 +79,7 @@ namespace Gekko
         if (a > b) SET_CR_GT(crfd); else RESET_CR_GT(crfd);
         if (a == b) SET_CR_EQ(crfd); else RESET_CR_EQ(crfd);
         if (IS_XER_SO) SET_CR_SO(crfd); else RESET_CR_SO(crfd);
-        Gekko->regs.pc += 4;
+        core->regs.pc += 4;
     }
 
 }
@@ -10,12 +10,12 @@ namespace Gekko
     {
         uint32_t crbd = CRBD, crba = CRBA, crbb = CRBB;
 
-        uint32_t a = (Gekko->regs.cr >> (31 - crba)) & 1;
-        uint32_t b = (Gekko->regs.cr >> (31 - crbb)) & 1;
+        uint32_t a = (core->regs.cr >> (31 - crba)) & 1;
+        uint32_t b = (core->regs.cr >> (31 - crbb)) & 1;
         uint32_t d = (a & b) << (31 - crbd);     // <- crop is here
         uint32_t m = ~(1 << (31 - crbd));
-        Gekko->regs.cr = (Gekko->regs.cr & m) | d;
-        Gekko->regs.pc += 4;
+        core->regs.cr = (core->regs.cr & m) | d;
+        core->regs.pc += 4;
     }
 
     // CR[crbd] = CR[crba] | CR[crbb]
@@ -23,12 +23,12 @@ namespace Gekko
     {
         uint32_t crbd = CRBD, crba = CRBA, crbb = CRBB;
 
-        uint32_t a = (Gekko->regs.cr >> (31 - crba)) & 1;
-        uint32_t b = (Gekko->regs.cr >> (31 - crbb)) & 1;
+        uint32_t a = (core->regs.cr >> (31 - crba)) & 1;
+        uint32_t b = (core->regs.cr >> (31 - crbb)) & 1;
         uint32_t d = (a | b) << (31 - crbd);     // <- crop is here
         uint32_t m = ~(1 << (31 - crbd));
-        Gekko->regs.cr = (Gekko->regs.cr & m) | d;
-        Gekko->regs.pc += 4;
+        core->regs.cr = (core->regs.cr & m) | d;
+        core->regs.pc += 4;
     }
 
     // CR[crbd] = CR[crba] ^ CR[crbb]
@@ -36,12 +36,12 @@ namespace Gekko
     {
         uint32_t crbd = CRBD, crba = CRBA, crbb = CRBB;
 
-        uint32_t a = (Gekko->regs.cr >> (31 - crba)) & 1;
-        uint32_t b = (Gekko->regs.cr >> (31 - crbb)) & 1;
+        uint32_t a = (core->regs.cr >> (31 - crba)) & 1;
+        uint32_t b = (core->regs.cr >> (31 - crbb)) & 1;
         uint32_t d = (a ^ b) << (31 - crbd);     // <- crop is here
         uint32_t m = ~(1 << (31 - crbd));
-        Gekko->regs.cr = (Gekko->regs.cr & m) | d;
-        Gekko->regs.pc += 4;
+        core->regs.cr = (core->regs.cr & m) | d;
+        core->regs.pc += 4;
     }
 
     // CR[crbd] = !(CR[crba] & CR[crbb])
@@ -49,12 +49,12 @@ namespace Gekko
     {
         uint32_t crbd = CRBD, crba = CRBA, crbb = CRBB;
 
-        uint32_t a = (Gekko->regs.cr >> (31 - crba)) & 1;
-        uint32_t b = (Gekko->regs.cr >> (31 - crbb)) & 1;
+        uint32_t a = (core->regs.cr >> (31 - crba)) & 1;
+        uint32_t b = (core->regs.cr >> (31 - crbb)) & 1;
         uint32_t d = (!(a & b)) << (31 - crbd);     // <- crop is here
         uint32_t m = ~(1 << (31 - crbd));
-        Gekko->regs.cr = (Gekko->regs.cr & m) | d;
-        Gekko->regs.pc += 4;
+        core->regs.cr = (core->regs.cr & m) | d;
+        core->regs.pc += 4;
     }
 
     // CR[crbd] = !(CR[crba] | CR[crbb])
@@ -62,12 +62,12 @@ namespace Gekko
     {
         uint32_t crbd = CRBD, crba = CRBA, crbb = CRBB;
 
-        uint32_t a = (Gekko->regs.cr >> (31 - crba)) & 1;
-        uint32_t b = (Gekko->regs.cr >> (31 - crbb)) & 1;
+        uint32_t a = (core->regs.cr >> (31 - crba)) & 1;
+        uint32_t b = (core->regs.cr >> (31 - crbb)) & 1;
         uint32_t d = (!(a | b)) << (31 - crbd);     // <- crop is here
         uint32_t m = ~(1 << (31 - crbd));
-        Gekko->regs.cr = (Gekko->regs.cr & m) | d;
-        Gekko->regs.pc += 4;
+        core->regs.cr = (core->regs.cr & m) | d;
+        core->regs.pc += 4;
     }
 
     // CR[crbd] = CR[crba] EQV CR[crbb]
@@ -75,12 +75,12 @@ namespace Gekko
     {
         uint32_t crbd = CRBD, crba = CRBA, crbb = CRBB;
 
-        uint32_t a = (Gekko->regs.cr >> (31 - crba)) & 1;
-        uint32_t b = (Gekko->regs.cr >> (31 - crbb)) & 1;
+        uint32_t a = (core->regs.cr >> (31 - crba)) & 1;
+        uint32_t b = (core->regs.cr >> (31 - crbb)) & 1;
         uint32_t d = (!(a ^ b)) << (31 - crbd);     // <- crop is here
         uint32_t m = ~(1 << (31 - crbd));
-        Gekko->regs.cr = (Gekko->regs.cr & m) | d;
-        Gekko->regs.pc += 4;
+        core->regs.cr = (core->regs.cr & m) | d;
+        core->regs.pc += 4;
     }
 
     // CR[crbd] = CR[crba] & ~CR[crbb]
@@ -88,12 +88,12 @@ namespace Gekko
     {
         uint32_t crbd = CRBD, crba = CRBA, crbb = CRBB;
 
-        uint32_t a = (Gekko->regs.cr >> (31 - crba)) & 1;
-        uint32_t b = (Gekko->regs.cr >> (31 - crbb)) & 1;
+        uint32_t a = (core->regs.cr >> (31 - crba)) & 1;
+        uint32_t b = (core->regs.cr >> (31 - crbb)) & 1;
         uint32_t d = (a & (~b)) << (31 - crbd);     // <- crop is here
         uint32_t m = ~(1 << (31 - crbd));
-        Gekko->regs.cr = (Gekko->regs.cr & m) | d;
-        Gekko->regs.pc += 4;
+        core->regs.cr = (core->regs.cr & m) | d;
+        core->regs.pc += 4;
     }
 
     // CR[crbd] = CR[crba] | ~CR[crbb]
@@ -101,20 +101,20 @@ namespace Gekko
     {
         uint32_t crbd = CRBD, crba = CRBA, crbb = CRBB;
 
-        uint32_t a = (Gekko->regs.cr >> (31 - crba)) & 1;
-        uint32_t b = (Gekko->regs.cr >> (31 - crbb)) & 1;
+        uint32_t a = (core->regs.cr >> (31 - crba)) & 1;
+        uint32_t b = (core->regs.cr >> (31 - crbb)) & 1;
         uint32_t d = (a | (~b)) << (31 - crbd);     // <- crop is here
         uint32_t m = ~(1 << (31 - crbd));
-        Gekko->regs.cr = (Gekko->regs.cr & m) | d;
-        Gekko->regs.pc += 4;
+        core->regs.cr = (core->regs.cr & m) | d;
+        core->regs.pc += 4;
     }
 
     // CR[4*crfd .. 4*crfd + 3] = CR[4*crfs .. 4*crfs + 3]
     OP(MCRF)
     {
         int32_t crfd = 4 * (7 - CRFD), crfs = 4 * (7 - CRFS);
-        Gekko->regs.cr = (Gekko->regs.cr & (~(0xf << crfd))) | (((Gekko->regs.cr >> crfs) & 0xf) << crfd);
-        Gekko->regs.pc += 4;
+        core->regs.cr = (core->regs.cr & (~(0xf << crfd))) | (((core->regs.cr >> crfs) & 0xf) << crfd);
+        core->regs.pc += 4;
     }
 
 }
@@ -14,20 +14,20 @@ namespace Gekko
     //           fd(ps1) = SINGLE(MEM(ea, 4))
     OP(LFS)
     {
-        if (Gekko->regs.msr & MSR_FP)
+        if (core->regs.msr & MSR_FP)
         {
             float res;
 
-            if (RA) Gekko->ReadWord(RRA + SIMM, (uint32_t*)&res);
-            else Gekko->ReadWord(SIMM, (uint32_t*)&res);
+            if (RA) core->ReadWord(RRA + SIMM, (uint32_t*)&res);
+            else core->ReadWord(SIMM, (uint32_t*)&res);
 
-            if (Gekko->exception) return;
+            if (core->exception) return;
 
-            if (Gekko->regs.spr[(int)SPR::HID2] & HID2_PSE) PS0(RD) = PS1(RD) = (double)res;
+            if (core->regs.spr[(int)SPR::HID2] & HID2_PSE) PS0(RD) = PS1(RD) = (double)res;
             else FPRD(RD) = (double)res;
-            Gekko->regs.pc += 4;
+            core->regs.pc += 4;
         }
-        else Gekko->Exception(Gekko::Exception::FPUNAVAIL);
+        else core->Exception(Gekko::Exception::FPUNAVAIL);
     }
 
     // ea = (ra | 0) + rb
@@ -37,20 +37,20 @@ namespace Gekko
     //           fd(ps1) = SINGLE(MEM(ea, 4))
     OP(LFSX)
     {
-        if (Gekko->regs.msr & MSR_FP)
+        if (core->regs.msr & MSR_FP)
         {
             float res;
 
-            if (RA) Gekko->ReadWord(RRA + RRB, (uint32_t*)&res);
-            else Gekko->ReadWord(RRB, (uint32_t*)&res);
+            if (RA) core->ReadWord(RRA + RRB, (uint32_t*)&res);
+            else core->ReadWord(RRB, (uint32_t*)&res);
 
-            if (Gekko->exception) return;
+            if (core->exception) return;
 
-            if (Gekko->regs.spr[(int)SPR::HID2] & HID2_PSE) PS0(RD) = PS1(RD) = (double)res;
+            if (core->regs.spr[(int)SPR::HID2] & HID2_PSE) PS0(RD) = PS1(RD) = (double)res;
             else FPRD(RD) = (double)res;
-            Gekko->regs.pc += 4;
+            core->regs.pc += 4;
         }
-        else Gekko->Exception(Gekko::Exception::FPUNAVAIL);
+        else core->Exception(Gekko::Exception::FPUNAVAIL);
     }
 
     // ea = ra + SIMM
@@ -61,22 +61,22 @@ namespace Gekko
     // ra = ea
     OP(LFSU)
     {
-        if (Gekko->regs.msr & MSR_FP)
+        if (core->regs.msr & MSR_FP)
         {
             uint32_t ea = RRA + SIMM;
             float res;
 
-            Gekko->ReadWord(ea, (uint32_t*)&res);
+            core->ReadWord(ea, (uint32_t*)&res);
 
-            if (Gekko->exception) return;
+            if (core->exception) return;
 
-            if (Gekko->regs.spr[(int)SPR::HID2] & HID2_PSE) PS0(RD) = PS1(RD) = (double)res;
+            if (core->regs.spr[(int)SPR::HID2] & HID2_PSE) PS0(RD) = PS1(RD) = (double)res;
             else FPRD(RD) = (double)res;
 
             RRA = ea;
-            Gekko->regs.pc += 4;
+            core->regs.pc += 4;
         }
-        else Gekko->Exception(Gekko::Exception::FPUNAVAIL);
+        else core->Exception(Gekko::Exception::FPUNAVAIL);
     }
 
     // ea = ra + rb
@@ -87,50 +87,50 @@ namespace Gekko
     // ra = ea
     OP(LFSUX)
     {
-        if (Gekko->regs.msr & MSR_FP)
+        if (core->regs.msr & MSR_FP)
         {
             uint32_t ea = RRA + RRB;
             float res;
 
-            Gekko->ReadWord(ea, (uint32_t*)&res);
+            core->ReadWord(ea, (uint32_t*)&res);
 
-            if (Gekko->exception) return;
+            if (core->exception) return;
 
-            if (Gekko->regs.spr[(int)SPR::HID2] & HID2_PSE) PS0(RD) = PS1(RD) = (double)res;
+            if (core->regs.spr[(int)SPR::HID2] & HID2_PSE) PS0(RD) = PS1(RD) = (double)res;
             else FPRD(RD) = (double)res;
 
             RRA = ea;
-            Gekko->regs.pc += 4;
+            core->regs.pc += 4;
         }
-        else Gekko->Exception(Gekko::Exception::FPUNAVAIL);
+        else core->Exception(Gekko::Exception::FPUNAVAIL);
     }
 
     // ea = (ra | 0) + SIMM
     // fd = MEM(ea, 8)
     OP(LFD)
     {
-        if (Gekko->regs.msr & MSR_FP)
+        if (core->regs.msr & MSR_FP)
         {
-            if (RA) Gekko->ReadDouble(RRA + SIMM, &FPRU(RD));
-            else Gekko->ReadDouble(SIMM, &FPRU(RD));
-            if (Gekko->exception) return;
-            Gekko->regs.pc += 4;
+            if (RA) core->ReadDouble(RRA + SIMM, &FPRU(RD));
+            else core->ReadDouble(SIMM, &FPRU(RD));
+            if (core->exception) return;
+            core->regs.pc += 4;
         }
-        else Gekko->Exception(Gekko::Exception::FPUNAVAIL);
+        else core->Exception(Gekko::Exception::FPUNAVAIL);
     }
 
     // ea = (ra | 0) + rb
     // fd = MEM(ea, 8)
     OP(LFDX)
     {
-        if (Gekko->regs.msr & MSR_FP)
+        if (core->regs.msr & MSR_FP)
         {
-            if (RA) Gekko->ReadDouble(RRA + RRB, &FPRU(RD));
-            else Gekko->ReadDouble(RRB, &FPRU(RD));
-            if (Gekko->exception) return;
-            Gekko->regs.pc += 4;
+            if (RA) core->ReadDouble(RRA + RRB, &FPRU(RD));
+            else core->ReadDouble(RRB, &FPRU(RD));
+            if (core->exception) return;
+            core->regs.pc += 4;
         }
-        else Gekko->Exception(Gekko::Exception::FPUNAVAIL);
+        else core->Exception(Gekko::Exception::FPUNAVAIL);
     }
 
     // ea = ra + SIMM
@@ -138,15 +138,15 @@ namespace Gekko
     // ra = ea
     OP(LFDU)
     {
-        if (Gekko->regs.msr & MSR_FP)
+        if (core->regs.msr & MSR_FP)
         {
             uint32_t ea = RRA + SIMM;
-            Gekko->ReadDouble(ea, &FPRU(RD));
-            if (Gekko->exception) return;
+            core->ReadDouble(ea, &FPRU(RD));
+            if (core->exception) return;
             RRA = ea;
-            Gekko->regs.pc += 4;
+            core->regs.pc += 4;
         }
-        else Gekko->Exception(Gekko::Exception::FPUNAVAIL);
+        else core->Exception(Gekko::Exception::FPUNAVAIL);
     }
 
     // ea = ra + rb
@@ -154,15 +154,15 @@ namespace Gekko
     // ra = ea
     OP(LFDUX)
     {
-        if (Gekko->regs.msr & MSR_FP)
+        if (core->regs.msr & MSR_FP)
         {
             uint32_t ea = RRA + RRB;
-            Gekko->ReadDouble(ea, &FPRU(RD));
-            if (Gekko->exception) return;
+            core->ReadDouble(ea, &FPRU(RD));
+            if (core->exception) return;
             RRA = ea;
-            Gekko->regs.pc += 4;
+            core->regs.pc += 4;
         }
-        else Gekko->Exception(Gekko::Exception::FPUNAVAIL);
+        else core->Exception(Gekko::Exception::FPUNAVAIL);
     }
 
     // ---------------------------------------------------------------------------
@@ -172,39 +172,39 @@ namespace Gekko
     // MEM(ea, 4) = SINGLE(fs)
     OP(STFS)
     {
-        if (Gekko->regs.msr & MSR_FP)
+        if (core->regs.msr & MSR_FP)
         {
             float data;
 
-            if (Gekko->regs.spr[(int)SPR::HID2] & HID2_PSE) data = (float)PS0(RS);
+            if (core->regs.spr[(int)SPR::HID2] & HID2_PSE) data = (float)PS0(RS);
             else data = (float)FPRD(RS);
 
-            if (RA) Gekko->WriteWord(RRA + SIMM, *(uint32_t*)&data);
-            else Gekko->WriteWord(SIMM, *(uint32_t*)&data);
-            if (Gekko->exception) return;
-            Gekko->regs.pc += 4;
+            if (RA) core->WriteWord(RRA + SIMM, *(uint32_t*)&data);
+            else core->WriteWord(SIMM, *(uint32_t*)&data);
+            if (core->exception) return;
+            core->regs.pc += 4;
         }
-        else Gekko->Exception(Gekko::Exception::FPUNAVAIL);
+        else core->Exception(Gekko::Exception::FPUNAVAIL);
     }
 
     // ea = (ra | 0) + rb
     // MEM(ea, 4) = SINGLE(fs)
     OP(STFSX)
     {
-        if (Gekko->regs.msr & MSR_FP)
+        if (core->regs.msr & MSR_FP)
         {
             float num;
             uint32_t* data = (uint32_t*)&num;
 
-            if (Gekko->regs.spr[(int)SPR::HID2] & HID2_PSE) num = (float)PS0(RS);
+            if (core->regs.spr[(int)SPR::HID2] & HID2_PSE) num = (float)PS0(RS);
             else num = (float)FPRD(RS);
 
-            if (RA) Gekko->WriteWord(RRA + RRB, *data);
-            else Gekko->WriteWord(RRB, *data);
-            if (Gekko->exception) return;
-            Gekko->regs.pc += 4;
+            if (RA) core->WriteWord(RRA + RRB, *data);
+            else core->WriteWord(RRB, *data);
+            if (core->exception) return;
+            core->regs.pc += 4;
         }
-        else Gekko->Exception(Gekko::Exception::FPUNAVAIL);
+        else core->Exception(Gekko::Exception::FPUNAVAIL);
     }
 
     // ea = ra + SIMM
@@ -212,20 +212,20 @@ namespace Gekko
     // ra = ea
     OP(STFSU)
     {
-        if (Gekko->regs.msr & MSR_FP)
+        if (core->regs.msr & MSR_FP)
         {
             float data;
             uint32_t ea = RRA + SIMM;
 
-            if (Gekko->regs.spr[(int)SPR::HID2] & HID2_PSE) data = (float)PS0(RS);
+            if (core->regs.spr[(int)SPR::HID2] & HID2_PSE) data = (float)PS0(RS);
             else data = (float)FPRD(RS);
 
-            Gekko->WriteWord(ea, *(uint32_t*)&data);
-            if (Gekko->exception) return;
+            core->WriteWord(ea, *(uint32_t*)&data);
+            if (core->exception) return;
             RRA = ea;
-            Gekko->regs.pc += 4;
+            core->regs.pc += 4;
         }
-        else Gekko->Exception(Gekko::Exception::FPUNAVAIL);
+        else core->Exception(Gekko::Exception::FPUNAVAIL);
     }
 
     // ea = ra + rb
@@ -233,49 +233,49 @@ namespace Gekko
     // ra = ea
     OP(STFSUX)
     {
-        if (Gekko->regs.msr & MSR_FP)
+        if (core->regs.msr & MSR_FP)
         {
             float num;
             uint32_t* data = (uint32_t*)&num;
             uint32_t ea = RRA + RRB;
 
-            if (Gekko->regs.spr[(int)SPR::HID2] & HID2_PSE) num = (float)PS0(RS);
+            if (core->regs.spr[(int)SPR::HID2] & HID2_PSE) num = (float)PS0(RS);
             else num = (float)FPRD(RS);
 
-            Gekko->WriteWord(ea, *data);
-            if (Gekko->exception) return;
+            core->WriteWord(ea, *data);
+            if (core->exception) return;
             RRA = ea;
-            Gekko->regs.pc += 4;
+            core->regs.pc += 4;
         }
-        else Gekko->Exception(Gekko::Exception::FPUNAVAIL);
+        else core->Exception(Gekko::Exception::FPUNAVAIL);
     }
 
     // ea = (ra | 0) + SIMM
     // MEM(ea, 8) = fs
     OP(STFD)
     {
-        if (Gekko->regs.msr & MSR_FP)
+        if (core->regs.msr & MSR_FP)
         {
-            if (RA) Gekko->WriteDouble(RRA + SIMM, &FPRU(RS));
-            else Gekko->WriteDouble(SIMM, &FPRU(RS));
-            if (Gekko->exception) return;
-            Gekko->regs.pc += 4;
+            if (RA) core->WriteDouble(RRA + SIMM, &FPRU(RS));
+            else core->WriteDouble(SIMM, &FPRU(RS));
+            if (core->exception) return;
+            core->regs.pc += 4;
         }
-        else Gekko->Exception(Gekko::Exception::FPUNAVAIL);
+        else core->Exception(Gekko::Exception::FPUNAVAIL);
     }
 
     // ea = (ra | 0) + rb
     // MEM(ea, 8) = fs
     OP(STFDX)
     {
-        if (Gekko->regs.msr & MSR_FP)
+        if (core->regs.msr & MSR_FP)
         {
-            if (RA) Gekko->WriteDouble(RRA + RRB, &FPRU(RS));
-            else Gekko->WriteDouble(RRB, &FPRU(RS));
-            if (Gekko->exception) return;
-            Gekko->regs.pc += 4;
+            if (RA) core->WriteDouble(RRA + RRB, &FPRU(RS));
+            else core->WriteDouble(RRB, &FPRU(RS));
+            if (core->exception) return;
+            core->regs.pc += 4;
         }
-        else Gekko->Exception(Gekko::Exception::FPUNAVAIL);
+        else core->Exception(Gekko::Exception::FPUNAVAIL);
     }
 
     // ea = ra + SIMM
@@ -283,15 +283,15 @@ namespace Gekko
     // ra = ea
     OP(STFDU)
     {
-        if (Gekko->regs.msr & MSR_FP)
+        if (core->regs.msr & MSR_FP)
         {
             uint32_t ea = RRA + SIMM;
-            Gekko->WriteDouble(ea, &FPRU(RS));
-            if (Gekko->exception) return;
+            core->WriteDouble(ea, &FPRU(RS));
+            if (core->exception) return;
             RRA = ea;
-            Gekko->regs.pc += 4;
+            core->regs.pc += 4;
         }
-        else Gekko->Exception(Gekko::Exception::FPUNAVAIL);
+        else core->Exception(Gekko::Exception::FPUNAVAIL);
     }
 
     // ea = ra + rb
@@ -299,15 +299,15 @@ namespace Gekko
     // ra = ea
     OP(STFDUX)
     {
-        if (Gekko->regs.msr & MSR_FP)
+        if (core->regs.msr & MSR_FP)
         {
             uint32_t ea = RRA + RRB;
-            Gekko->WriteDouble(ea, &FPRU(RS));
-            if (Gekko->exception) return;
+            core->WriteDouble(ea, &FPRU(RS));
+            if (core->exception) return;
             RRA = ea;
-            Gekko->regs.pc += 4;
+            core->regs.pc += 4;
         }
-        else Gekko->Exception(Gekko::Exception::FPUNAVAIL);
+        else core->Exception(Gekko::Exception::FPUNAVAIL);
     }
 
     // ---------------------------------------------------------------------------
@@ -317,15 +317,15 @@ namespace Gekko
     // MEM(ea, 4) = fs[32-63]
     OP(STFIWX)
     {
-        if (Gekko->regs.msr & MSR_FP)
+        if (core->regs.msr & MSR_FP)
         {
             uint32_t val = (uint32_t)(FPRU(RS) & 0x00000000ffffffff);
-            if (RA) Gekko->WriteWord(RRA + RRB, val);
-            else Gekko->WriteWord(RRB, val);
-            if (Gekko->exception) return;
-            Gekko->regs.pc += 4;
+            if (RA) core->WriteWord(RRA + RRB, val);
+            else core->WriteWord(RRB, val);
+            if (core->exception) return;
+            core->regs.pc += 4;
         }
-        else Gekko->Exception(Gekko::Exception::FPUNAVAIL);
+        else core->Exception(Gekko::Exception::FPUNAVAIL);
     }
 
 }
@@ -10,7 +10,7 @@ namespace Gekko
     {
         if (RA) RRD = RRA + SIMM;
         else RRD = SIMM;
-        Gekko->regs.pc += 4;
+        core->regs.pc += 4;
     }
 
     // rd = (ra | 0) + (SIMM || 0x0000)
@@ -18,14 +18,14 @@ namespace Gekko
     {
         if (RA) RRD = RRA + (SIMM << 16);
         else RRD = SIMM << 16;
-        Gekko->regs.pc += 4;
+        core->regs.pc += 4;
     }
 
     // rd = ra + rb
     OP(ADD)
     {
         RRD = RRA + RRB;
-        Gekko->regs.pc += 4;
+        core->regs.pc += 4;
     }
 
     // rd = ra + rb, CR0
@@ -34,7 +34,7 @@ namespace Gekko
         uint32_t res = RRA + RRB;
         RRD = res;
         COMPUTE_CR0(res);
-        Gekko->regs.pc += 4;
+        core->regs.pc += 4;
     }
 
     // rd = ra + rb, XER
@@ -43,8 +43,7 @@ namespace Gekko
         uint32_t a = RRA, b = RRB, res;
         bool ovf = false;
 
-        res = AddOverflow(a, b);
-        ovf = OverflowBit != 0;
+        res = AddOverflow(a, b, ovf);
 
         RRD = res;
         if (ovf)
@@ -53,7 +52,7 @@ namespace Gekko
             SET_XER_SO;
         }
         else RESET_XER_OV;
-        Gekko->regs.pc += 4;
+        core->regs.pc += 4;
     }
 
     // rd = ra + rb, CR0, XER
@@ -62,8 +61,7 @@ namespace Gekko
         uint32_t a = RRA, b = RRB, res;
         bool ovf = false;
 
-        res = AddOverflow(a, b);
-        ovf = OverflowBit != 0;
+        res = AddOverflow(a, b, ovf);
 
         RRD = res;
         if (ovf)
@@ -73,14 +71,14 @@ namespace Gekko
         }
         else RESET_XER_OV;
         COMPUTE_CR0(res);
-        Gekko->regs.pc += 4;
+        core->regs.pc += 4;
     }
 
     // rd = ~ra + rb + 1
     OP(SUBF)
     {
         RRD = ~RRA + RRB + 1;
-        Gekko->regs.pc += 4;
+        core->regs.pc += 4;
     }
 
     // rd = ~ra + rb + 1, CR0
@@ -89,7 +87,7 @@ namespace Gekko
         uint32_t res = ~RRA + RRB + 1;
         RRD = res;
         COMPUTE_CR0(res);
-        Gekko->regs.pc += 4;
+        core->regs.pc += 4;
     }
 
     // rd = ~ra + rb + 1, XER
@@ -110,12 +108,11 @@ namespace Gekko
         uint32_t a = RRA, b = SIMM, res;
         bool carry = false;
 
-        res = AddCarry(a, b);
-        carry = CarryBit != 0;
+        res = AddCarry(a, b, carry);
 
         RRD = res;
         if (carry) SET_XER_CA; else RESET_XER_CA;
-        Gekko->regs.pc += 4;
+        core->regs.pc += 4;
     }
 
     // rd = ra + SIMM, CR0, XER
@@ -124,13 +121,12 @@ namespace Gekko
         uint32_t a = RRA, b = SIMM, res;
         bool carry = false;
 
-        res = AddCarry(a, b);
-        carry = CarryBit != 0;
+        res = AddCarry(a, b, carry);
 
         RRD = res;
         if (carry) SET_XER_CA; else RESET_XER_CA;
         COMPUTE_CR0(res);
-        Gekko->regs.pc += 4;
+        core->regs.pc += 4;
     }
 
     // rd = ~RRA + SIMM + 1, XER
@@ -139,12 +135,11 @@ namespace Gekko
         uint32_t a = ~RRA, b = SIMM + 1, res;
         bool carry = false;
 
-        res = AddCarry(a, b);
-        carry = CarryBit != 0;
+        res = AddCarry(a, b, carry);
 
         RRD = res;
         if (carry) SET_XER_CA; else RESET_XER_CA;
-        Gekko->regs.pc += 4;
+        core->regs.pc += 4;
     }
 
     // rd = ra + rb, XER[CA]
@@ -153,12 +148,11 @@ namespace Gekko
         uint32_t a = RRA, b = RRB, res;
         bool carry = false;
 
-        res = AddCarry(a, b);
-        carry = CarryBit != 0;
+        res = AddCarry(a, b, carry);
 
         RRD = res;
         if (carry) SET_XER_CA; else RESET_XER_CA;
-        Gekko->regs.pc += 4;
+        core->regs.pc += 4;
     }
 
     // rd = ra + rb, XER[CA], CR0
@@ -167,13 +161,12 @@ namespace Gekko
         uint32_t a = RRA, b = RRB, res;
         bool carry = false;
 
-        res = AddCarry(a, b);
-        carry = CarryBit != 0;
+        res = AddCarry(a, b, carry);
 
         RRD = res;
         if (carry) SET_XER_CA; else RESET_XER_CA;
         COMPUTE_CR0(res);
-        Gekko->regs.pc += 4;
+        core->regs.pc += 4;
     }
 
     // rd = ra + rb, XER[CA], XER[OV]
@@ -182,9 +175,7 @@ namespace Gekko
         uint32_t a = RRA, b = RRB, res;
         bool carry = false, ovf = false;
 
-        res = AddCarryOverflow(a, b);
-        carry = CarryBit != 0;
-        ovf = OverflowBit != 0;
+        res = AddCarryOverflow(a, b, carry, ovf);
 
         RRD = res;
         if (carry) SET_XER_CA; else RESET_XER_CA;
@@ -194,7 +185,7 @@ namespace Gekko
             SET_XER_SO;
         }
         else RESET_XER_OV;
-        Gekko->regs.pc += 4;
+        core->regs.pc += 4;
     }
 
     // rd = ra + rb, XER[CA], XER[OV], CR0
@@ -203,9 +194,7 @@ namespace Gekko
         uint32_t a = RRA, b = RRB, res;
         bool carry = false, ovf = false;
 
-        res = AddCarryOverflow(a, b);
-        carry = CarryBit != 0;
-        ovf = OverflowBit != 0;
+        res = AddCarryOverflow(a, b, carry, ovf);
 
         RRD = res;
         if (carry) SET_XER_CA; else RESET_XER_CA;
@@ -216,7 +205,7 @@ namespace Gekko
         }
         else RESET_XER_OV;
         COMPUTE_CR0(res);
-        Gekko->regs.pc += 4;
+        core->regs.pc += 4;
     }
 
     // rd = ~ra + rb + 1, XER[CA]
@@ -225,12 +214,11 @@ namespace Gekko
         uint32_t a = ~RRA, b = RRB + 1, res;
         bool carry = false;
 
-        res = AddCarry(a, b);
-        carry = CarryBit != 0;
+        res = AddCarry(a, b, carry);
 
         if (carry) SET_XER_CA; else RESET_XER_CA;
         RRD = res;
-        Gekko->regs.pc += 4;
+        core->regs.pc += 4;
     }
 
     // rd = ~ra + rb + 1, XER[CA], CR0
@@ -239,67 +227,60 @@ namespace Gekko
         uint32_t a = ~RRA, b = RRB + 1, res;
         bool carry = false;
 
-        res = AddCarry(a, b);
-        carry = CarryBit != 0;
+        res = AddCarry(a, b, carry);
 
         if (carry) SET_XER_CA; else RESET_XER_CA;
         RRD = res;
         COMPUTE_CR0(res);
-        Gekko->regs.pc += 4;
+        core->regs.pc += 4;
     }
 
     // ---------------------------------------------------------------------------
 
-    static void ADDXER(uint32_t a, uint32_t op)
+    static void ADDXER(GekkoCore* core, uint32_t a, uint32_t op)
     {
         uint32_t res;
         uint32_t c = (IS_XER_CA) ? 1 : 0;
         bool carry = false;
 
-        res = AddCarry(a, c);
-        carry = CarryBit != 0;
+        res = AddCarry(a, c, carry);
 
         RRD = res;
         if (carry) SET_XER_CA; else RESET_XER_CA;
     }
 
-    static void ADDXERD(uint32_t a, uint32_t op)
+    static void ADDXERD(GekkoCore* core, uint32_t a, uint32_t op)
     {
         uint32_t res;
         uint32_t c = (IS_XER_CA) ? 1 : 0;
         bool carry = false;
 
-        res = AddCarry(a, c);
-        carry = CarryBit != 0;
+        res = AddCarry(a, c, carry);
 
         RRD = res;
         if (carry) SET_XER_CA; else RESET_XER_CA;
         COMPUTE_CR0(res);
     }
 
-    static void ADDXER2(uint32_t a, uint32_t b, uint32_t op)
+    static void ADDXER2(GekkoCore* core, uint32_t a, uint32_t b, uint32_t op)
     {
         uint32_t res;
         uint32_t c = (IS_XER_CA) ? 1 : 0;
         bool carry = false;
 
-        CarryBit = c;
-        res = AddXer2(a, b);
-        carry = CarryBit != 0;
+        res = AddXer2(a, b, c, carry);
 
         RRD = res;
         if (carry) SET_XER_CA; else RESET_XER_CA;
     }
 
-    static void ADDXER2D(uint32_t a, uint32_t b, uint32_t op)
+    static void ADDXER2D(GekkoCore* core, uint32_t a, uint32_t b, uint32_t op)
     {
         uint32_t res;
         uint32_t c = (IS_XER_CA) ? 1 : 0;
         bool carry = false;
 
-        CarryBit = c;
-        res = AddXer2(a, b);
-        carry = CarryBit != 0;
+        res = AddXer2(a, b, c, carry);
 
         RRD = res;
         if (carry) SET_XER_CA; else RESET_XER_CA;
@@ -309,85 +290,85 @@ namespace Gekko
     // rd = ra + rb + XER[CA], XER
     OP(ADDE)
     {
-        ADDXER2(RRA, RRB, op);
-        Gekko->regs.pc += 4;
+        ADDXER2(core, RRA, RRB, op);
+        core->regs.pc += 4;
     }
 
     // rd = ra + rb + XER[CA], CR0, XER
     OP(ADDED)
     {
-        ADDXER2D(RRA, RRB, op);
-        Gekko->regs.pc += 4;
+        ADDXER2D(core, RRA, RRB, op);
+        core->regs.pc += 4;
     }
 
     // rd = ~ra + rb + XER[CA], XER
     OP(SUBFE)
     {
-        ADDXER2(~RRA, RRB, op);
-        Gekko->regs.pc += 4;
+        ADDXER2(core, ~RRA, RRB, op);
+        core->regs.pc += 4;
     }
 
     // rd = ~ra + rb + XER[CA], CR0, XER
     OP(SUBFED)
     {
-        ADDXER2D(~RRA, RRB, op);
-        Gekko->regs.pc += 4;
+        ADDXER2D(core, ~RRA, RRB, op);
+        core->regs.pc += 4;
     }
 
     // rd = ra + XER[CA] - 1 (0xffffffff), XER
     OP(ADDME)
     {
-        ADDXER(RRA - 1, op);
-        Gekko->regs.pc += 4;
+        ADDXER(core, RRA - 1, op);
+        core->regs.pc += 4;
     }
 
     // rd = ra + XER[CA] - 1 (0xffffffff), CR0, XER
     OP(ADDMED)
     {
-        ADDXERD(RRA - 1, op);
-        Gekko->regs.pc += 4;
+        ADDXERD(core, RRA - 1, op);
+        core->regs.pc += 4;
     }
 
     // rd = ~ra + XER[CA] - 1, XER
     OP(SUBFME)
     {
-        ADDXER(~RRA - 1, op);
-        Gekko->regs.pc += 4;
+        ADDXER(core, ~RRA - 1, op);
+        core->regs.pc += 4;
     }
 
     // rd = ~ra + XER[CA] - 1, CR0, XER
     OP(SUBFMED)
     {
-        ADDXERD(~RRA - 1, op);
-        Gekko->regs.pc += 4;
+        ADDXERD(core, ~RRA - 1, op);
+        core->regs.pc += 4;
     }
 
     // rd = ra + XER[CA], XER
     OP(ADDZE)
     {
-        ADDXER(RRA, op);
-        Gekko->regs.pc += 4;
+        ADDXER(core, RRA, op);
+        core->regs.pc += 4;
     }
 
     // rd = ra + XER[CA], CR0, XER
     OP(ADDZED)
     {
-        ADDXERD(RRA, op);
-        Gekko->regs.pc += 4;
+        ADDXERD(core, RRA, op);
+        core->regs.pc += 4;
     }
 
     // rd = ~ra + XER[CA], XER
     OP(SUBFZE)
     {
-        ADDXER(~RRA, op);
-        Gekko->regs.pc += 4;
+        ADDXER(core, ~RRA, op);
+        core->regs.pc += 4;
     }
 
     // rd = ~ra + XER[CA], CR0, XER
     OP(SUBFZED)
     {
-        ADDXERD(~RRA, op);
-        Gekko->regs.pc += 4;
+        ADDXERD(core, ~RRA, op);
+        core->regs.pc += 4;
     }
 
     // ---------------------------------------------------------------------------
@@ -396,7 +377,7 @@ namespace Gekko
     OP(NEG)
     {
         RRD = ~RRA + 1;
-        Gekko->regs.pc += 4;
+        core->regs.pc += 4;
     }
 
     // rd = ~ra + 1, CR0
@@ -405,7 +386,7 @@ namespace Gekko
         uint32_t res = ~RRA + 1;
         RRD = res;
         COMPUTE_CR0(res);
-        Gekko->regs.pc += 4;
+        core->regs.pc += 4;
     }
 
     // ---------------------------------------------------------------------------
@@ -415,7 +396,7 @@ namespace Gekko
     OP(MULLI)
     {
         RRD = RRA * SIMM;
-        Gekko->regs.pc += 4;
+        core->regs.pc += 4;
     }
 
     // prod[0-48] = ra * rb
@@ -425,7 +406,7 @@ namespace Gekko
         int32_t a = RRA, b = RRB;
         int64_t res = (int64_t)a * (int64_t)b;
         RRD = (int32_t)(res & 0x00000000ffffffff);
-        Gekko->regs.pc += 4;
+        core->regs.pc += 4;
     }
 
     // prod[0-48] = ra * rb
@@ -437,7 +418,7 @@ namespace Gekko
         int64_t res = (int64_t)a * (int64_t)b;
         RRD = (int32_t)(res & 0x00000000ffffffff);
         COMPUTE_CR0(res);
-        Gekko->regs.pc += 4;
+        core->regs.pc += 4;
     }
 
     // prod[0-63] = ra * rb
@@ -447,7 +428,7 @@ namespace Gekko
         int64_t a = (int32_t)RRA, b = (int32_t)RRB, res = a * b;
         res = (res >> 32);
         RRD = (int32_t)res;
-        Gekko->regs.pc += 4;
+        core->regs.pc += 4;
     }
 
     // prod[0-63] = ra * rb
@@ -459,7 +440,7 @@ namespace Gekko
         res = (res >> 32);
         RRD = (int32_t)res;
         COMPUTE_CR0(res);
-        Gekko->regs.pc += 4;
+        core->regs.pc += 4;
     }
 
     // prod[0-63] = ra * rb
@@ -469,7 +450,7 @@ namespace Gekko
         uint64_t a = RRA, b = RRB, res = a * b;
         res = (res >> 32);
         RRD = (uint32_t)res;
-        Gekko->regs.pc += 4;
+        core->regs.pc += 4;
     }
 
     // prod[0-63] = ra * rb
@@ -481,7 +462,7 @@ namespace Gekko
         res = (res >> 32);
         RRD = (uint32_t)res;
         COMPUTE_CR0(res);
-        Gekko->regs.pc += 4;
+        core->regs.pc += 4;
     }
 
     // rd = ra / rb (signed)
@@ -489,7 +470,7 @@ namespace Gekko
     {
         int32_t a = RRA, b = RRB;
         if (b) RRD = a / b;
-        Gekko->regs.pc += 4;
+        core->regs.pc += 4;
     }
 
     // rd = ra / rb (signed), CR0
@@ -502,7 +483,7 @@ namespace Gekko
             RRD = res;
             COMPUTE_CR0(res);
         }
-        Gekko->regs.pc += 4;
+        core->regs.pc += 4;
     }
 
     // rd = ra / rb (unsigned)
@@ -510,7 +491,7 @@ namespace Gekko
     {
         uint32_t a = RRA, b = RRB;
         if (b) RRD = a / b;
-        Gekko->regs.pc += 4;
+        core->regs.pc += 4;
     }
 
     // rd = ra / rb (unsigned), CR0
@@ -523,7 +504,7 @@ namespace Gekko
             RRD = res;
             COMPUTE_CR0(res);
         }
-        Gekko->regs.pc += 4;
+        core->regs.pc += 4;
     }
 
 }
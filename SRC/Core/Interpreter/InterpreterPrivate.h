@@ -2,62 +2,117 @@
 
 #pragma once
 
-#define OP(name) void Interpreter::c_##name(uint32_t op)
+#define OP(name) void Interpreter::c_##name(GekkoCore* core, uint32_t op)
 
 #define COMPUTE_CR0(r)                                                                \
 {                                                                                     \
-    (Gekko::Gekko->regs.cr = (Gekko::Gekko->regs.cr & 0x0fff'ffff)                   |  \
-    ((Gekko::Gekko->regs.spr[(int)Gekko::SPR::XER] & (1 << 31)) ? (0x1000'0000) : (0)) |    \
+    (core->regs.cr = (core->regs.cr & 0x0fff'ffff)                   |  \
+    ((core->regs.spr[(int)Gekko::SPR::XER] & (1 << 31)) ? (0x1000'0000) : (0)) |    \
     (((int32_t)(r) < 0) ? (0x8000'0000) : (((int32_t)(r) > 0) ? (0x4000'0000) : (0x2000'0000))));\
 }
 
 #define COMPUTE_CR1()                                                                 \
 {                                                                                     \
-    Gekko::Gekko->regs.cr = (Gekko::Gekko->regs.cr & 0xf0ff'ffff) | ((Gekko::Gekko->regs.fpscr & 0xf000'0000) >> 4);    \
+    core->regs.cr = (core->regs.cr & 0xf0ff'ffff) | ((core->regs.fpscr & 0xf000'0000) >> 4);    \
 }
 
-#define SET_CR_LT(n)    (Gekko::Gekko->regs.cr |=  (1 << (3 + 4 * (7 - n))))
-#define SET_CR_GT(n)    (Gekko::Gekko->regs.cr |=  (1 << (2 + 4 * (7 - n))))
-#define SET_CR_EQ(n)    (Gekko::Gekko->regs.cr |=  (1 << (1 + 4 * (7 - n))))
-#define SET_CR_SO(n)    (Gekko::Gekko->regs.cr |=  (1 << (    4 * (7 - n))))
-#define RESET_CR_LT(n)  (Gekko::Gekko->regs.cr &= ~(1 << (3 + 4 * (7 - n))))
-#define RESET_CR_GT(n)  (Gekko::Gekko->regs.cr &= ~(1 << (2 + 4 * (7 - n))))
-#define RESET_CR_EQ(n)  (Gekko::Gekko->regs.cr &= ~(1 << (1 + 4 * (7 - n))))
-#define RESET_CR_SO(n)  (Gekko::Gekko->regs.cr &= ~(1 << (    4 * (7 - n))))
-
-#define SET_CR0_LT      (Gekko::Gekko->regs.cr |=  (1 << 31))
-#define SET_CR0_GT      (Gekko::Gekko->regs.cr |=  (1 << 30))
-#define SET_CR0_EQ      (Gekko::Gekko->regs.cr |=  (1 << 29))
-#define SET_CR0_SO      (Gekko::Gekko->regs.cr |=  (1 << 28))
-#define RESET_CR0_LT    (Gekko::Gekko->regs.cr &= ~(1 << 31))
-#define RESET_CR0_GT    (Gekko::Gekko->regs.cr &= ~(1 << 30))
-#define RESET_CR0_EQ    (Gekko::Gekko->regs.cr &= ~(1 << 29))
-#define RESET_CR0_SO    (Gekko::Gekko->regs.cr &= ~(1 << 28))
-
-#define SET_XER_SO      (Gekko::Gekko->regs.spr[(int)Gekko::SPR::XER] |=  (1 << 31))
-#define SET_XER_OV      (Gekko::Gekko->regs.spr[(int)Gekko::SPR::XER] |=  (1 << 30))
-#define SET_XER_CA      (Gekko::Gekko->regs.spr[(int)Gekko::SPR::XER] |=  (1 << 29))
-
-#define RESET_XER_SO    (Gekko::Gekko->regs.spr[(int)Gekko::SPR::XER] &= ~(1 << 31))
-#define RESET_XER_OV    (Gekko::Gekko->regs.spr[(int)Gekko::SPR::XER] &= ~(1 << 30))
-#define RESET_XER_CA    (Gekko::Gekko->regs.spr[(int)Gekko::SPR::XER] &= ~(1 << 29))
-
-#define IS_XER_SO       (Gekko::Gekko->regs.spr[(int)Gekko::SPR::XER] & (1 << 31))
-#define IS_XER_OV       (Gekko::Gekko->regs.spr[(int)Gekko::SPR::XER] & (1 << 30))
-#define IS_XER_CA       (Gekko::Gekko->regs.spr[(int)Gekko::SPR::XER] & (1 << 29))
+#define SET_CR_LT(n)    (core->regs.cr |=  (1 << (3 + 4 * (7 - n))))
+#define SET_CR_GT(n)    (core->regs.cr |=  (1 << (2 + 4 * (7 - n))))
+#define SET_CR_EQ(n)    (core->regs.cr |=  (1 << (1 + 4 * (7 - n))))
+#define SET_CR_SO(n)    (core->regs.cr |=  (1 << (    4 * (7 - n))))
+#define RESET_CR_LT(n)  (core->regs.cr &= ~(1 << (3 + 4 * (7 - n))))
+#define RESET_CR_GT(n)  (core->regs.cr &= ~(1 << (2 + 4 * (7 - n))))
+#define RESET_CR_EQ(n)  (core->regs.cr &= ~(1 << (1 + 4 * (7 - n))))
+#define RESET_CR_SO(n)  (core->regs.cr &= ~(1 << (    4 * (7 - n))))
+
+#define SET_CR0_LT      (core->regs.cr |=  (1 << 31))
+#define SET_CR0_GT      (core->regs.cr |=  (1 << 30))
+#define SET_CR0_EQ      (core->regs.cr |=  (1 << 29))
+#define SET_CR0_SO      (core->regs.cr |=  (1 << 28))
+#define RESET_CR0_LT    (core->regs.cr &= ~(1 << 31))
+#define RESET_CR0_GT    (core->regs.cr &= ~(1 << 30))
+#define RESET_CR0_EQ    (core->regs.cr &= ~(1 << 29))
+#define RESET_CR0_SO    (core->regs.cr &= ~(1 << 28))
+
+#define SET_XER_SO      (core->regs.spr[(int)Gekko::SPR::XER] |=  (1 << 31))
+#define SET_XER_OV      (core->regs.spr[(int)Gekko::SPR::XER] |=  (1 << 30))
+#define SET_XER_CA      (core->regs.spr[(int)Gekko::SPR::XER] |=  (1 << 29))
+
+#define RESET_XER_SO    (core->regs.spr[(int)Gekko::SPR::XER] &= ~(1 << 31))
+#define RESET_XER_OV    (core->regs.spr[(int)Gekko::SPR::XER] &= ~(1 << 30))
+#define RESET_XER_CA    (core->regs.spr[(int)Gekko::SPR::XER] &= ~(1 << 29))
+
+#define IS_XER_SO       (core->regs.spr[(int)Gekko::SPR::XER] & (1 << 31))
+#define IS_XER_OV       (core->regs.spr[(int)Gekko::SPR::XER] & (1 << 30))
+#define IS_XER_CA       (core->regs.spr[(int)Gekko::SPR::XER] & (1 << 29))
 
 #define IS_NAN(n)       (((n) & 0x7ff0000000000000) == 0x7ff0000000000000 && ((n) & 0x000fffffffffffff) != 0)
 #define IS_SNAN(n)      (((n) & 0x7ff0000000000000) == 0x7ff0000000000000 && ((n) & 0x000fffffffffffff) != 0 && ((n) & 0x0008000000000000) == 0)
-#define SET_CRF(n, c)   (Gekko::Gekko->regs.cr = (Gekko::Gekko->regs.cr & (~(0xf0000000 >> (4 * n)))) | (c << (4 * (7 - n))))
+#define SET_CRF(n, c)   (core->regs.cr = (core->regs.cr & (~(0xf0000000 >> (4 * n)))) | (c << (4 * (7 - n))))
 
-extern "C" uint32_t CarryBit;
-extern "C" uint32_t OverflowBit;
+// Host-flag arithmetic helpers. Carry and overflow are returned in registers and the compiler
+// folds them into a single add + setc/seto (or adc for AddXer2).
 
-extern "C" uint32_t __fastcall AddCarry(uint32_t a, uint32_t b);
-extern "C" uint32_t __fastcall AddOverflow(uint32_t a, uint32_t b);
-extern "C" uint32_t __fastcall AddCarryOverflow(uint32_t a, uint32_t b);
-extern "C" uint32_t __fastcall AddXer2(uint32_t a, uint32_t b);
-extern "C" uint32_t __fastcall Rotl32(int sa, uint32_t data);
+#if defined(__GNUC__) || defined(__clang__)
+
+static inline uint32_t AddCarry(uint32_t a, uint32_t b, bool& carry)
+{
+    uint32_t res;
+    carry = __builtin_add_overflow(a, b, &res);
+    return res;
+}
+
+static inline uint32_t AddOverflow(uint32_t a, uint32_t b, bool& ovf)
+{
+    int32_t res;
+    ovf = __builtin_add_overflow((int32_t)a, (int32_t)b, &res);
+    return (uint32_t)res;
+}
+
+static inline uint32_t Rotl32(int sa, uint32_t data)
+{
+    return (data << sa) | (data >> ((32 - sa) & 31));
+}
+
+#else
+
+static inline uint32_t AddCarry(uint32_t a, uint32_t b, bool& carry)
+{
+    uint32_t res;
+    carry = _addcarry_u32(0, a, b, &res) != 0;
+    return res;
+}
+
+static inline uint32_t AddOverflow(uint32_t a, uint32_t b, bool& ovf)
+{
+    uint32_t res = a + b;
+    ovf = (((a ^ res) & (b ^ res)) >> 31) != 0;
+    return res;
+}
+
+static inline uint32_t Rotl32(int sa, uint32_t data)
+{
+    return _rotl(data, sa);
+}
+
+#endif
+
+static inline uint32_t AddCarryOverflow(uint32_t a, uint32_t b, bool& carry, bool& ovf)
+{
+    uint32_t res = AddCarry(a, b, carry);
+    ovf = (((a ^ res) & (b ^ res)) >> 31) != 0;
+    return res;
+}
+
+// a + b + carry-in. The carry out is set if any of the two additions carried.
+static inline uint32_t AddXer2(uint32_t a, uint32_t b, uint32_t c, bool& carry)
+{
+    bool c1, c2;
+    uint32_t res = AddCarry(a, b, c1);
+    res = AddCarry(res, c, c2);
+    carry = c1 || c2;
+    return res;
+}
 
 // ---------------------------------------------------------------------------
 // opcode decoding ("op" representing current opcode, to simplify macros)
@@ -83,13 +138,13 @@ extern "C" uint32_t __fastcall Rotl32(int sa, uint32_t data);
 #define FM          ((op >> 17) & 0xff)
 
 // fast R*-field register addressing
-#define RRD         Gekko::Gekko->regs.gpr[RD]
-#define RRS         Gekko::Gekko->regs.gpr[RS]
-#define RRA         Gekko::Gekko->regs.gpr[RA]
-#define RRB         Gekko::Gekko->regs.gpr[RB]
-#define RRC         Gekko::Gekko->regs.gpr[RC]
-
-#define FPRU(n) (Gekko->regs.fpr[n].uval)
-#define FPRD(n) (Gekko->regs.fpr[n].dbl)
-#define PS0(n)  (Gekko->regs.fpr[n].dbl)
-#define PS1(n)  (Gekko->regs.ps1[n].dbl)
+#define RRD         core->regs.gpr[RD]
+#define RRS         core->regs.gpr[RS]
+#define RRA         core->regs.gpr[RA]
+#define RRB         core->regs.gpr[RB]
+#define RRC         core->regs.gpr[RC]
+
+#define FPRU(n) (core->regs.fpr[n].ps0.uval)
+#define FPRD(n) (core->regs.fpr[n].ps0.dbl)
+#define PS0(n)  (core->regs.fpr[n].ps0.dbl)
+#define PS1(n)  (core->regs.fpr[n].ps1.dbl)
@@ -12,20 +12,20 @@ namespace Gekko
     // rd = 0x000000 || MEM(ea, 1)
     OP(LBZ)
     {
-        if (RA) Gekko->ReadByte(RRA + SIMM, &RRD);
-        else Gekko->ReadByte(SIMM, &RRD);
-        if (Gekko->exception) return;
-        Gekko->regs.pc += 4;
+        if (RA) core->ReadByte(RRA + SIMM, &RRD);
+        else core->ReadByte(SIMM, &RRD);
+        if (core->exception) return;
+        core->regs.pc += 4;
     }
 
     // ea = (ra | 0) + rb
     // rd = 0x000000 || MEM(ea, 1)
     OP(LBZX)
     {
-        if (RA) Gekko->ReadByte(RRA + RRB, &RRD);
-        else Gekko->ReadByte(RRB, &RRD);
-        if (Gekko->exception) return;
-        Gekko->regs.pc += 4;
+        if (RA) core->ReadByte(RRA + RRB, &RRD);
+        else core->ReadByte(RRB, &RRD);
+        if (core->exception) return;
+        core->regs.pc += 4;
     }
 
     // ea = ra + SIMM
@@ -34,10 +34,10 @@ namespace Gekko
     OP(LBZU)
     {
         uint32_t ea = RRA + SIMM;
-        Gekko->ReadByte(ea, &RRD);
-        if (Gekko->exception) return;
+        core->ReadByte(ea, &RRD);
+        if (core->exception) return;
         RRA = ea;
-        Gekko->regs.pc += 4;
+        core->regs.pc += 4;
     }
 
     // ea = ra + rb
@@ -46,30 +46,30 @@ namespace Gekko
     OP(LBZUX)
     {
         uint32_t ea = RRA + RRB;
-        Gekko->ReadByte(ea, &RRD);
-        if (Gekko->exception) return;
+        core->ReadByte(ea, &RRD);
+        if (core->exception) return;
         RRA = ea;
-        Gekko->regs.pc += 4;
+        core->regs.pc += 4;
     }
 
     // ea = (ra | 0) + SIMM
     // rd = 0x0000 || MEM(ea, 2)
     OP(LHZ)
     {
-        if (RA) Gekko->ReadHalf(RRA + SIMM, &RRD);
-        else Gekko->ReadHalf(SIMM, &RRD);
-        if (Gekko->exception) return;
-        Gekko->regs.pc += 4;
+        if (RA) core->ReadHalf(RRA + SIMM, &RRD);
+        else core->ReadHalf(SIMM, &RRD);
+        if (core->exception) return;
+        core->regs.pc += 4;
     }
 
     // ea = (ra | 0) + rb
     // rd = 0x0000 || MEM(ea, 2)
     OP(LHZX)
     {
-        if (RA) Gekko->ReadHalf(RRA + RRB, &RRD);
-        else Gekko->ReadHalf(RRB, &RRD);
-        if (Gekko->exception) return;
-        Gekko->regs.pc += 4;
+        if (RA) core->ReadHalf(RRA + RRB, &RRD);
+        else core->ReadHalf(RRB, &RRD);
+        if (core->exception) return;
+        core->regs.pc += 4;
     }
 
     // ea = ra + SIMM
@@ -78,10 +78,10 @@ namespace Gekko
     OP(LHZU)
     {
         uint32_t ea = RRA + SIMM;
-        Gekko->ReadHalf(ea, &RRD);
-        if (Gekko->exception) return;
+        core->ReadHalf(ea, &RRD);
+        if (core->exception) return;
         RRA = ea;
-        Gekko->regs.pc += 4;
+        core->regs.pc += 4;
     }
 
     // ea = ra + rb
@@ -90,30 +90,30 @@ namespace Gekko
     OP(LHZUX)
     {
         uint32_t ea = RRA + RRB;
-        Gekko->ReadHalf(ea, &RRD);
-        if (Gekko->exception) return;
+        core->ReadHalf(ea, &RRD);
+        if (core->exception) return;
         RRA = ea;
-        Gekko->regs.pc += 4;
+        core->regs.pc += 4;
     }
 
     // ea = (ra | 0) + SIMM
     // rd = (signed)MEM(ea, 2)
     OP(LHA)
     {
-        if (RA) Gekko->ReadHalfS(RRA + SIMM, &RRD);
-        else Gekko->ReadHalfS(SIMM, &RRD);
-        if (Gekko->exception) return;
-        Gekko->regs.pc += 4;
+        if (RA) core->ReadHalfS(RRA + SIMM, &RRD);
+        else core->ReadHalfS(SIMM, &RRD);
+        if (core->exception) return;
+        core->regs.pc += 4;
     }
 
     // ea = (ra | 0) + rb
     // rd = (signed)MEM(ea, 2)
     OP(LHAX)
     {
-        if (RA) Gekko->ReadHalfS(RRA + RRB, &RRD);
-        else Gekko->ReadHalfS(RRB, &RRD);
-        if (Gekko->exception) return;
-        Gekko->regs.pc += 4;
+        if (RA) core->ReadHalfS(RRA + RRB, &RRD);
+        else core->ReadHalfS(RRB, &RRD);
+        if (core->exception) return;
+        core->regs.pc += 4;
     }
 
     // ea = ra + SIMM
@@ -122,10 +122,10 @@ namespace Gekko
     OP(LHAU)
     {
         uint32_t ea = RRA + SIMM;
-        Gekko->ReadHalfS(ea, &RRD);
-        if (Gekko->exception) return;
+        core->ReadHalfS(ea, &RRD);
+        if (core->exception) return;
         RRA = ea;
-        Gekko->regs.pc += 4;
+        core->regs.pc += 4;
     }
 
     // ea = ra + rb
@@ -134,30 +134,30 @@ namespace Gekko
     OP(LHAUX)
     {
         uint32_t ea = RRA + RRB;
-        Gekko->ReadHalfS(ea, &RRD);
-        if (Gekko->exception) return;
+        core->ReadHalfS(ea, &RRD);
+        if (core->exception) return;
         RRA = ea;
-        Gekko->regs.pc += 4;
+        core->regs.pc += 4;
     }
 
     // ea = (ra | 0) + SIMM
     // rd = MEM(ea, 4)
     OP(LWZ)
     {
-        if (RA) Gekko->ReadWord(RRA + SIMM, &RRD);
-        else Gekko->ReadWord(SIMM, &RRD);
-        if (Gekko->exception) return;
-        Gekko->regs.pc += 4;
+        if (RA) core->ReadWord(RRA + SIMM, &RRD);
+        else core->ReadWord(SIMM, &RRD);
+        if (core->exception) return;
+        core->regs.pc += 4;
     }
 
     // ea = (ra | 0) + rb
     // rd = MEM(ea, 4)
     OP(LWZX)
     {
-        if (RA) Gekko->ReadWord(RRA + RRB, &RRD);
-        else Gekko->ReadWord(RRB, &RRD);
-        if (Gekko->exception) return;
-        Gekko->regs.pc += 4;
+        if (RA) core->ReadWord(RRA + RRB, &RRD);
+        else core->ReadWord(RRB, &RRD);
+        if (core->exception) return;
+        core->regs.pc += 4;
     }
 
     // ea = ra + SIMM
@@ -166,10 +166,10 @@ namespace Gekko
     OP(LWZU)
     {
         uint32_t ea = RRA + SIMM;
-        Gekko->ReadWord(ea, &RRD);
-        if (Gekko->exception) return;
+        core->ReadWord(ea, &RRD);
+        if (core->exception) return;
         RRA = ea;
-        Gekko->regs.pc += 4;
+        core->regs.pc += 4;
     }
 
     // ea = ra + rb
@@ -178,10 +178,10 @@ namespace Gekko
     OP(LWZUX)
     {
         uint32_t ea = RRA + RRB;
-        Gekko->ReadWord(ea, &RRD);
-        if (Gekko->exception) return;
+        core->ReadWord(ea, &RRD);
+        if (core->exception) return;
         RRA = ea;
-        Gekko->regs.pc += 4;
+        core->regs.pc += 4;
     }
 
     // ---------------------------------------------------------------------------
@@ -191,20 +191,20 @@ namespace Gekko
     // MEM(ea, 1) = rs[24-31]
     OP(STB)
     {
-        if (RA) Gekko->WriteByte(RRA + SIMM, RRS);
-        else Gekko->WriteByte(SIMM, RRS);
-        if (Gekko->exception) return;
-        Gekko->regs.pc += 4;
+        if (RA) core->WriteByte(RRA + SIMM, RRS);
+        else core->WriteByte(SIMM, RRS);
+        if (core->exception) return;
+        core->regs.pc += 4;
     }
 
     // ea = (ra | 0) + rb
     // MEM(ea, 1) = rs[24-31]
     OP(STBX)
     {
-        if (RA) Gekko->WriteByte(RRA + RRB, RRS);
-        else Gekko->WriteByte(RRB, RRS);
-        if (Gekko->exception) return;
-        Gekko->regs.pc += 4;
+        if (RA) core->WriteByte(RRA + RRB, RRS);
+        else core->WriteByte(RRB, RRS);
+        if (core->exception) return;
+        core->regs.pc += 4;
     }
 
     // ea = ra + SIMM
@@ -213,10 +213,10 @@ namespace Gekko
     OP(STBU)
     {
         uint32_t ea = RRA + SIMM;
-        Gekko->WriteByte(ea, RRS);
-        if (Gekko->exception) return;
+        core->WriteByte(ea, RRS);
+        if (core->exception) return;
         RRA = ea;
-        Gekko->regs.pc += 4;
+        core->regs.pc += 4;
     }
 
     // ea = ra + rb
@@ -225,30 +225,30 @@ namespace Gekko
     OP(STBUX)
     {
         uint32_t ea = RRA + RRB;
-        Gekko->WriteByte(ea, RRS);
-        if (Gekko->exception) return;
+        core->WriteByte(ea, RRS);
+        if (core->exception) return;
         RRA = ea;
-        Gekko->regs.pc += 4;
+        core->regs.pc += 4;
     }
 
     // ea = (ra | 0) + SIMM
     // MEM(ea, 2) = rs[16-31]
     OP(STH)
     {
-        if (RA) Gekko->WriteHalf(RRA + SIMM, RRS);
-        else Gekko->WriteHalf(SIMM, RRS);
-        if (Gekko->exception) return;
-        Gekko->regs.pc += 4;
+        if (RA) core->WriteHalf(RRA + SIMM, RRS);
+        else core->WriteHalf(SIMM, RRS);
+        if (core->exception) return;
+        core->regs.pc += 4;
     }
 
     // ea = (ra | 0) + rb
     // MEM(ea, 2) = rs[16-31]
     OP(STHX)
     {
-        if (RA) Gekko->WriteHalf(RRA + RRB, RRS);
-        else Gekko->WriteHalf(RRB, RRS);
-        if (Gekko->exception) return;
-        Gekko->regs.pc += 4;
+        if (RA) core->WriteHalf(RRA + RRB, RRS);
+        else core->WriteHalf(RRB, RRS);
+        if (core->exception) return;
+        core->regs.pc += 4;
     }
 
     // ea = ra + SIMM
@@ -257,10 +257,10 @@ namespace Gekko
     OP(STHU)
     {
         uint32_t ea = RRA + SIMM;
-        Gekko->WriteHalf(ea, RRS);
-        if (Gekko->exception) return;
+        core->WriteHalf(ea, RRS);
+        if (core->exception) return;
         RRA = ea;
-        Gekko->regs.pc += 4;
+        core->regs.pc += 4;
     }
 
     // ea = ra + rb
@@ -269,30 +269,30 @@ namespace Gekko
     OP(STHUX)
     {
         uint32_t ea = RRA + RRB;
-        Gekko->WriteHalf(ea, RRS);
-        if (Gekko->exception) return;
+        core->WriteHalf(ea, RRS);
+        if (core->exception) return;
         RRA = ea;
-        Gekko->regs.pc += 4;
+        core->regs.pc += 4;
     }
 
     // ea = (ra | 0) + SIMM
     // MEM(ea, 4) = rs
     OP(STW)
     {
-        if (RA) Gekko->WriteWord(RRA + SIMM, RRS);
-        else Gekko->WriteWord(SIMM, RRS);
-        if (Gekko->exception) return;
-        Gekko->regs.pc += 4;
+        if (RA) core->WriteWord(RRA + SIMM, RRS);
+        else core->WriteWord(SIMM, RRS);
+        if (core->exception) return;
+        core->regs.pc += 4;
     }
 
     // ea = (ra | 0) + rb
     // MEM(ea, 4) = rs
     OP(STWX)
     {
-        if (RA) Gekko->WriteWord(RRA + RRB, RRS);
-        else Gekko->WriteWord(RRB, RRS);
-        if (Gekko->exception) return;
-        Gekko->regs.pc += 4;
+        if (RA) core->WriteWord(RRA + RRB, RRS);
+        else core->WriteWord(RRB, RRS);
+        if (core->exception) return;
+        core->regs.pc += 4;
     }
 
     // ea = ra + SIMM
@@ -301,10 +301,10 @@ namespace Gekko
     OP(STWU)
     {
         uint32_t ea = RRA + SIMM;
-        Gekko->WriteWord(ea, RRS);
-        if (Gekko->exception) return;
+        core->WriteWord(ea, RRS);
+        if (core->exception) return;
         RRA = ea;
-        Gekko->regs.pc += 4;
+        core->regs.pc += 4;
     }
 
     // ea = ra + rb
@@ -313,10 +313,10 @@ namespace Gekko
     OP(STWUX)
     {
         uint32_t ea = RRA + RRB;
-        Gekko->WriteWord(ea, RRS);
-        if (Gekko->exception) return;
+        core->WriteWord(ea, RRS);
+        if (core->exception) return;
         RRA = ea;
-        Gekko->regs.pc += 4;
+        core->regs.pc += 4;
     }
 
     // ---------------------------------------------------------------------------
@@ -327,11 +327,11 @@ namespace Gekko
     OP(LHBRX)
     {
         uint32_t val;
-        if (RA) Gekko->ReadHalf(RRA + RRB, &val);
-        else Gekko->ReadHalf(RRB, &val);
-        if (Gekko->exception) return;
+        if (RA) core->ReadHalf(RRA + RRB, &val);
+        else core->ReadHalf(RRB, &val);
+        if (core->exception) return;
         RRD = _byteswap_ushort((uint16_t)val);
-        Gekko->regs.pc += 4;
+        core->regs.pc += 4;
     }
 
     // ea = (ra | 0) + rb
@@ -339,31 +339,31 @@ namespace Gekko
     OP(LWBRX)
     {
         uint32_t val;
-        if (RA) Gekko->ReadWord(RRA + RRB, &val);
-        else Gekko->ReadWord(RRB, &val);
-        if (Gekko->exception) return;
+        if (RA) core->ReadWord(RRA + RRB, &val);
+        else core->ReadWord(RRB, &val);
+        if (core->exception) return;
         RRD = _byteswap_ulong(val);
-        Gekko->regs.pc += 4;
+        core->regs.pc += 4;
     }
 
     // ea = (ra | 0) + rb
     // MEM(ea, 2) = rs[24-31] || rs[16-23]
     OP(STHBRX)
     {
-        if (RA) Gekko->WriteHalf(RRA + RRB, _byteswap_ushort((uint16_t)RRS));
-        else Gekko->WriteHalf(RRB, _byteswap_ushort((uint16_t)RRS));
-        if (Gekko->exception) return;
-        Gekko->regs.pc += 4;
+        if (RA) core->WriteHalf(RRA + RRB, _byteswap_ushort((uint16_t)RRS));
+        else core->WriteHalf(RRB, _byteswap_ushort((uint16_t)RRS));
+        if (core->exception) return;
+        core->regs.pc += 4;
     }
 
     // ea = (ra | 0) + rb
     // MEM(ea, 4) = rs[24-31] || rs[16-23] || rs[8-15] || rs[0-7]
     OP(STWBRX)
     {
-        if (RA) Gekko->WriteWord(RRA + RRB, _byteswap_ulong(RRS));
-        else Gekko->WriteWord(RRB, _byteswap_ulong(RRS));
-        if (Gekko->exception) return;
-        Gekko->regs.pc += 4;
+        if (RA) core->WriteWord(RRA + RRB, _byteswap_ulong(RRS));
+        else core->WriteWord(RRB, _byteswap_ulong(RRS));
+        if (core->exception) return;
+        core->regs.pc += 4;
     }
 
     // ea = (ra | 0) + SIMM
@@ -380,10 +380,10 @@ namespace Gekko
 
         for (int r = RD; r < 32; r++, ea += 4)
         {
-            Gekko->ReadWord(ea, &Gekko->regs.gpr[r]);
-            if (Gekko->exception) return;
+            core->ReadWord(ea, &core->regs.gpr[r]);
+            if (core->exception) return;
         }
-        Gekko->regs.pc += 4;
+        core->regs.pc += 4;
     }
 
     // ea = (ra | 0) + SIMM
@@ -400,10 +400,10 @@ namespace Gekko
 
         for (int r = RS; r < 32; r++, ea += 4)
         {
-            Gekko->WriteWord(ea, Gekko->regs.gpr[r]);
-            if (Gekko->exception) return;
+            core->WriteWord(ea, core->regs.gpr[r]);
+            if (core->exception) return;
         }
-        Gekko->regs.pc += 4;
+        core->regs.pc += 4;
     }
 
     // ea = (ra | 0)
@@ -430,13 +430,13 @@ namespace Gekko
             if (i == 0)
             {
                 i = 4;
-                Gekko->regs.gpr[rd] = r;
+                core->regs.gpr[rd] = r;
                 rd++;
                 rd %= 32;
                 r = 0;
             }
-            Gekko->ReadByte(ea, &val);
-            if (Gekko->exception) return;
+            core->ReadByte(ea, &val);
+            if (core->exception) return;
             r <<= 8;
             r |= (uint8_t)val;
             ea++;
@@ -449,8 +449,8 @@ namespace Gekko
             r <<= 8;
             i--;
         }
-        Gekko->regs.gpr[rd] = r;
-        Gekko->regs.pc += 4;
+        core->regs.gpr[rd] = r;
+        core->regs.pc += 4;
     }
 
     // ea = (ra | 0)
@@ -474,19 +474,19 @@ namespace Gekko
         {
             if (i == 0)
             {
-                r = Gekko->regs.gpr[rs];
+                r = core->regs.gpr[rs];
                 rs++;
                 rs %= 32;
                 i = 4;
             }
-            Gekko->WriteByte(ea, r >> 24);
-            if (Gekko->exception) return;
+            core->WriteByte(ea, r >> 24);
+            if (core->exception) return;
             r <<= 8;
             ea++;
             i--;
             n--;
         }
-        Gekko->regs.pc += 4;
+        core->regs.pc += 4;
     }
 
     // ea = (ra | 0) + rb
@@ -498,11 +498,11 @@ namespace Gekko
         int WIMG;
         uint32_t ea = RRB;
         if (RA) ea += RRA;
-        Gekko->interp->RESERVE = true;
-        Gekko->interp->RESERVE_ADDR = Gekko->EffectiveToPhysical(ea, Gekko::MmuAccess::Read, WIMG);
-        Gekko->ReadWord(ea, &RRD);
-        if (Gekko->exception) return;
-        Gekko->regs.pc += 4;
+        core->interp->RESERVE = true;
+        core->interp->RESERVE_ADDR = core->EffectiveToPhysical(ea, Gekko::MmuAccess::Read, WIMG);
+        core->ReadWord(ea, &RRD);
+        if (core->exception) return;
+        core->regs.pc += 4;
     }
 
     // ea = (ra | 0) + rb
@@ -518,18 +518,18 @@ namespace Gekko
         uint32_t ea = RRB;
         if (RA) ea += RRA;
 
-        Gekko->regs.cr &= 0x0fffffff;
+        core->regs.cr &= 0x0fffffff;
 
-        if (Gekko->interp->RESERVE)
+        if (core->interp->RESERVE)
         {
-            Gekko->WriteWord(ea, RRS);
-            if (Gekko->exception) return;
+            core->WriteWord(ea, RRS);
+            if (core->exception) return;
             SET_CR0_EQ;
-            Gekko->interp->RESERVE = false;
+            core->interp->RESERVE = false;
         }
 
         if (IS_XER_SO) SET_CR0_SO;
-        Gekko->regs.pc += 4;
+        core->regs.pc += 4;
     }
 
 }
@@ -8,286 +8,264 @@ namespace Gekko
     #define GEKKO_PSW   (op & 0x8000)
     #define GEKKO_PSI   ((op >> 12) & 7)
 
-    #define LD_SCALE(n) ((Gekko->regs.spr[(int)SPR::GQRs + n] >> 24) & 0x3f)
-    #define LD_TYPE(n)  (GEKKO_QUANT_TYPE)((Gekko->regs.spr[(int)SPR::GQRs + n] >> 16) & 7)
-    #define ST_SCALE(n) ((Gekko->regs.spr[(int)SPR::GQRs + n] >>  8) & 0x3f)
-    #define ST_TYPE(n)  (GEKKO_QUANT_TYPE)((Gekko->regs.spr[(int)SPR::GQRs + n]      ) & 7)
+    #define LD_SCALE(n) ((core->regs.spr[(int)SPR::GQRs + n] >> 24) & 0x3f)
+    #define LD_TYPE(n)  (GEKKO_QUANT_TYPE)((core->regs.spr[(int)SPR::GQRs + n] >> 16) & 7)
+    #define ST_SCALE(n) ((core->regs.spr[(int)SPR::GQRs + n] >>  8) & 0x3f)
+    #define ST_TYPE(n)  (GEKKO_QUANT_TYPE)((core->regs.spr[(int)SPR::GQRs + n]      ) & 7)
+
+    // The load/store and conversion code is instantiated for each quantization type,
+    // and the instruction picks the instance from a table by the GQR type field.
+    // The scale factor is taken from the precomputed ldScale/stScale tables once per instruction.
+    // Reserved types are treated as single float.
+
+    template <GEKKO_QUANT_TYPE type>
+    constexpr uint32_t QuantSize()
+    {
+        return (type == GEKKO_QUANT_TYPE::U8 || type == GEKKO_QUANT_TYPE::S8) ? 1 :
+            ((type == GEKKO_QUANT_TYPE::U16 || type == GEKKO_QUANT_TYPE::S16) ? 2 : 4);
+    }
 
     // INT -> float (F = I * 2 ** -S)
-    float Interpreter::dequantize(uint32_t data, GEKKO_QUANT_TYPE type, uint8_t scale)
+    template <GEKKO_QUANT_TYPE type>
+    static inline float Dequantize(uint32_t data, float scale)
     {
         float flt;
 
-        switch (type)
-        {
-            case GEKKO_QUANT_TYPE::U8: flt = (float)(uint8_t)data; break;
-            case GEKKO_QUANT_TYPE::U16: flt = (float)(uint16_t)data; break;
-            case GEKKO_QUANT_TYPE::S8: 
-                if (data & 0x80) data |= 0xffffff00;
-                flt = (float)(int8_t)data; break;
-            case GEKKO_QUANT_TYPE::S16: 
-                if (data & 0x8000) data |= 0xffff0000;
-                flt = (float)(int16_t)data; break;
-            case GEKKO_QUANT_TYPE::SINGLE_FLOAT:
-            default: flt = *((float*)&data); break;
-        }
+        if constexpr (type == GEKKO_QUANT_TYPE::U8) flt = (float)(uint8_t)data;
+        else if constexpr (type == GEKKO_QUANT_TYPE::U16) flt = (float)(uint16_t)data;
+        else if constexpr (type == GEKKO_QUANT_TYPE::S8) flt = (float)(int8_t)data;
+        else if constexpr (type == GEKKO_QUANT_TYPE::S16) flt = (float)(int16_t)data;
+        else flt = *((float*)&data);
 
-        return flt * Gekko->interp->ldScale[scale];
+        return flt * scale;
     }
 
     // float -> INT (I = ROUND(F * 2 ** S))
-    uint32_t Interpreter::quantize(float data, GEKKO_QUANT_TYPE type, uint8_t scale)
+    template <GEKKO_QUANT_TYPE type>
+    static inline uint32_t Quantize(float data, float scale)
     {
         uint32_t uval;
 
-        data *= Gekko->interp->stScale[scale];
+        data *= scale;
 
-        switch (type)
+        if constexpr (type == GEKKO_QUANT_TYPE::U8)
+        {
+            if (data < 0) data = 0;
+            if (data > 255) data = 255;
+            uval = (uint8_t)(uint32_t)data;
+        }
+        else if constexpr (type == GEKKO_QUANT_TYPE::U16)
+        {
+            if (data < 0) data = 0;
+            if (data > 65535) data = 65535;
+            uval = (uint16_t)(uint32_t)data;
+        }
+        else if constexpr (type == GEKKO_QUANT_TYPE::S8)
+        {
+            if (data < -128) data = -128;
+            if (data > 127) data = 127;
+            uval = (uint32_t)(int32_t)(int8_t)(int32_t)data;
+        }
+        else if constexpr (type == GEKKO_QUANT_TYPE::S16)
         {
-            case GEKKO_QUANT_TYPE::U8:
-                if (data < 0) data = 0;
-                if (data > 255) data = 255;
-                uval = (uint8_t)(uint32_t)data; break;
-            case GEKKO_QUANT_TYPE::U16:
-                if (data < 0) data = 0;
-                if (data > 65535) data = 65535;
-                uval = (uint16_t)(uint32_t)data; break;
-            case GEKKO_QUANT_TYPE::S8:
-                if (data < -128) data = -128;
-                if (data > 127) data = 127;
-                uval = (int8_t)(uint8_t)(int32_t)(uint32_t)data; break;
-            case GEKKO_QUANT_TYPE::S16:
-                if (data < -32768) data = -32768;
-                if (data > 32767) data = 32767;
-                uval = (int16_t)(uint16_t)(int32_t)(uint32_t)data; break;
-            case GEKKO_QUANT_TYPE::SINGLE_FLOAT:
-            default: *((float*)&uval) = data; break;
+            if (data < -32768) data = -32768;
+            if (data > 32767) data = 32767;
+            uval = (uint32_t)(int32_t)(int16_t)(int32_t)data;
         }
+        else *((float*)&uval) = data;
 
         return uval;
     }
 
+    template <GEKKO_QUANT_TYPE type>
+    static inline void ReadQuant(GekkoCore* core, uint32_t ea, uint32_t* data)
+    {
+        if constexpr (QuantSize<type>() == 1) core->ReadByte(ea, data);
+        else if constexpr (QuantSize<type>() == 2) core->ReadHalf(ea, data);
+        else core->ReadWord(ea, data);
+    }
+
+    template <GEKKO_QUANT_TYPE type>
+    static inline void WriteQuant(GekkoCore* core, uint32_t ea, uint32_t data)
+    {
+        if constexpr (QuantSize<type>() == 1) core->WriteByte(ea, data);
+        else if constexpr (QuantSize<type>() == 2) core->WriteHalf(ea, data);
+        else core->WriteWord(ea, data);
+    }
+
+    // Return false if the memory access raised an exception. The register is not modified by a failed load.
+
+    template <GEKKO_QUANT_TYPE type>
+    static bool PSQLoad(GekkoCore* core, uint32_t ea, size_t d, float scale, bool single)
+    {
+        uint32_t data0, data1;
+
+        ReadQuant<type>(core, ea, &data0);
+        if (core->exception) return false;
+
+        if (single)
+        {
+            PS0(d) = (double)Dequantize<type>(data0, scale);
+            PS1(d) = 1.0f;
+            return true;
+        }
+
+        ReadQuant<type>(core, ea + QuantSize<type>(), &data1);
+        if (core->exception) return false;
+
+        PS0(d) = (double)Dequantize<type>(data0, scale);
+        PS1(d) = (double)Dequantize<type>(data1, scale);
+        return true;
+    }
+
+    template <GEKKO_QUANT_TYPE type>
+    static bool PSQStore(GekkoCore* core, uint32_t ea, size_t s, float scale, bool single)
+    {
+        WriteQuant<type>(core, ea, Quantize<type>((float)PS0(s), scale));
+        if (core->exception) return false;
+
+        if (!single)
+        {
+            WriteQuant<type>(core, ea + QuantSize<type>(), Quantize<type>((float)PS1(s), scale));
+            if (core->exception) return false;
+        }
+        return true;
+    }
+
+    typedef bool (*PSQHandler)(GekkoCore* core, uint32_t ea, size_t reg, float scale, bool single);
+
+    static const PSQHandler psqLoad[8] = {
+        PSQLoad<GEKKO_QUANT_TYPE::SINGLE_FLOAT>,
+        PSQLoad<GEKKO_QUANT_TYPE::SINGLE_FLOAT>,
+        PSQLoad<GEKKO_QUANT_TYPE::SINGLE_FLOAT>,
+        PSQLoad<GEKKO_QUANT_TYPE::SINGLE_FLOAT>,
+        PSQLoad<GEKKO_QUANT_TYPE::U8>,
+        PSQLoad<GEKKO_QUANT_TYPE::U16>,
+        PSQLoad<GEKKO_QUANT_TYPE::S8>,
+        PSQLoad<GEKKO_QUANT_TYPE::S16>,
+    };
+
+    static const PSQHandler psqStore[8] = {
+        PSQStore<GEKKO_QUANT_TYPE::SINGLE_FLOAT>,
+        PSQStore<GEKKO_QUANT_TYPE::SINGLE_FLOAT>,
+        PSQStore<GEKKO_QUANT_TYPE::SINGLE_FLOAT>,
+        PSQStore<GEKKO_QUANT_TYPE::SINGLE_FLOAT>,
+        PSQStore<GEKKO_QUANT_TYPE::U8>,
+        PSQStore<GEKKO_QUANT_TYPE::U16>,
+        PSQStore<GEKKO_QUANT_TYPE::S8>,
+        PSQStore<GEKKO_QUANT_TYPE::S16>,
+    };
+
+    // Load/store through the GQR selected by the instruction
+    static inline bool PSQLoadGqr(GekkoCore* core, uint32_t ea, size_t d, int gqr, bool single)
+    {
+        return psqLoad[(size_t)LD_TYPE(gqr)](core, ea, d, core->interp->ldScale[LD_SCALE(gqr)], single);
+    }
+
+    static inline bool PSQStoreGqr(GekkoCore* core, uint32_t ea, size_t s, int gqr, bool single)
+    {
+        return psqStore[(size_t)ST_TYPE(gqr)](core, ea, s, core->interp->stScale[ST_SCALE(gqr)], single);
+    }
+
     // ---------------------------------------------------------------------------
     // loads
 
     OP(PSQ_L)
     {
-        if ((Gekko->regs.spr[(int)SPR::HID2] & HID2_PSE) == 0 ||
-            (Gekko->regs.spr[(int)SPR::HID2] & HID2_LSQE) == 0)
+        if ((core->regs.spr[(int)SPR::HID2] & HID2_PSE) == 0 ||
+            (core->regs.spr[(int)SPR::HID2] & HID2_LSQE) == 0)
         {
-            Gekko->PrCause = PrivilegedCause::IllegalInstruction;
-            Gekko->Exception(Exception::PROGRAM);
+            core->PrCause = PrivilegedCause::IllegalInstruction;
+            core->Exception(Exception::PROGRAM);
             return;
         }
 
-        if (Gekko->regs.msr & MSR_FP)
+        if (core->regs.msr & MSR_FP)
         {
-            uint32_t EA = op & 0xfff, data0, data1;
-            int32_t d = RD;
-            uint8_t scale = (uint8_t)LD_SCALE(GEKKO_PSI);
-            GEKKO_QUANT_TYPE type = LD_TYPE(GEKKO_PSI);
+            uint32_t EA = op & 0xfff;
 
             if (EA & 0x800) EA |= 0xfffff000;
             if (RA) EA += RRA;
 
-            if (GEKKO_PSW)
-            {
-                if ((type == GEKKO_QUANT_TYPE::U8) || (type == GEKKO_QUANT_TYPE::S8)) Gekko->ReadByte(EA, &data0);
-                else if ((type == GEKKO_QUANT_TYPE::U16) || (type == GEKKO_QUANT_TYPE::S16)) Gekko->ReadHalf(EA, &data0);
-                else Gekko->ReadWord(EA, &data0);
+            if (!PSQLoadGqr(core, EA, RD, GEKKO_PSI, GEKKO_PSW != 0)) return;
 
-                if (Gekko->exception) return;
-
-                PS0(d) = (double)dequantize(data0, type, scale);
-                PS1(d) = 1.0f;
-            }
-            else
-            {
-                if ((type == GEKKO_QUANT_TYPE::U8) || (type == GEKKO_QUANT_TYPE::S8)) Gekko->ReadByte(EA, &data0);
-                else if ((type == GEKKO_QUANT_TYPE::U16) || (type == GEKKO_QUANT_TYPE::S16)) Gekko->ReadHalf(EA, &data0);
-                else Gekko->ReadWord(EA, &data0);
-
-                if (Gekko->exception) return;
-
-                if ((type == GEKKO_QUANT_TYPE::U8) || (type == GEKKO_QUANT_TYPE::S8)) Gekko->ReadByte(EA + 1, &data1);
-                else if ((type == GEKKO_QUANT_TYPE::U16) || (type == GEKKO_QUANT_TYPE::S16)) Gekko->ReadHalf(EA + 2, &data1);
-                else Gekko->ReadWord(EA + 4, &data1);
-
-                if (Gekko->exception) return;
-
-                PS0(d) = (double)dequantize(data0, type, scale);
-                PS1(d) = (double)dequantize(data1, type, scale);
-            }
-
-            Gekko->regs.pc += 4;
+            core->regs.pc += 4;
         }
-        else Gekko->Exception(Gekko::Exception::FPUNAVAIL);
+        else core->Exception(Gekko::Exception::FPUNAVAIL);
     }
 
     OP(PSQ_LU)
     {
-        if ((Gekko->regs.spr[(int)SPR::HID2] & HID2_PSE) == 0 ||
-            (Gekko->regs.spr[(int)SPR::HID2] & HID2_LSQE) == 0 || 
+        if ((core->regs.spr[(int)SPR::HID2] & HID2_PSE) == 0 ||
+            (core->regs.spr[(int)SPR::HID2] & HID2_LSQE) == 0 || 
             RA == 0)
         {
-            Gekko->PrCause = PrivilegedCause::IllegalInstruction;
-            Gekko->Exception(Exception::PROGRAM);
+            core->PrCause = PrivilegedCause::IllegalInstruction;
+            core->Exception(Exception::PROGRAM);
             return;
         }
 
-        if (Gekko->regs.msr & MSR_FP)
+        if (core->regs.msr & MSR_FP)
         {
-            uint32_t EA = op & 0xfff, data0, data1;
-            int32_t d = RD;
-            uint8_t scale = (uint8_t)LD_SCALE(GEKKO_PSI);
-            GEKKO_QUANT_TYPE type = LD_TYPE(GEKKO_PSI);
+            uint32_t EA = op & 0xfff;
 
             if (EA & 0x800) EA |= 0xfffff000;
             EA += RRA;
 
-            if (GEKKO_PSW)
-            {
-                if ((type == GEKKO_QUANT_TYPE::U8) || (type == GEKKO_QUANT_TYPE::S8)) Gekko->ReadByte(EA, &data0);
-                else if ((type == GEKKO_QUANT_TYPE::U16) || (type == GEKKO_QUANT_TYPE::S16)) Gekko->ReadHalf(EA, &data0);
-                else Gekko->ReadWord(EA, &data0);
-
-                if (Gekko->exception) return;
-
-                PS0(d) = (double)dequantize(data0, type, scale);
-                PS1(d) = 1.0f;
-            }
-            else
-            {
-                if ((type == GEKKO_QUANT_TYPE::U8) || (type == GEKKO_QUANT_TYPE::S8)) Gekko->ReadByte(EA, &data0);
-                else if ((type == GEKKO_QUANT_TYPE::U16) || (type == GEKKO_QUANT_TYPE::S16)) Gekko->ReadHalf(EA, &data0);
-                else Gekko->ReadWord(EA, &data0);
-
-                if (Gekko->exception) return;
-
-                if ((type == GEKKO_QUANT_TYPE::U8) || (type == GEKKO_QUANT_TYPE::S8)) Gekko->ReadByte(EA + 1, &data1);
-                else if ((type == GEKKO_QUANT_TYPE::U16) || (type == GEKKO_QUANT_TYPE::S16)) Gekko->ReadHalf(EA + 2, &data1);
-                else Gekko->ReadWord(EA + 4, &data1);
-
-                if (Gekko->exception) return;
-
-                PS0(d) = (double)dequantize(data0, type, scale);
-                PS1(d) = (double)dequantize(data1, type, scale);
-            }
+            if (!PSQLoadGqr(core, EA, RD, GEKKO_PSI, GEKKO_PSW != 0)) return;
 
             RRA = EA;
-            Gekko->regs.pc += 4;
+            core->regs.pc += 4;
         }
-        else Gekko->Exception(Gekko::Exception::FPUNAVAIL);
+        else core->Exception(Gekko::Exception::FPUNAVAIL);
     }
 
     OP(PSQ_LUX)
     {
-        if ((Gekko->regs.spr[(int)SPR::HID2] & HID2_PSE) == 0 ||
-            (Gekko->regs.spr[(int)SPR::HID2] & HID2_LSQE) == 0 || 
+        if ((core->regs.spr[(int)SPR::HID2] & HID2_PSE) == 0 ||
+            (core->regs.spr[(int)SPR::HID2] & HID2_LSQE) == 0 || 
             RA == 0)
         {
-            Gekko->PrCause = PrivilegedCause::IllegalInstruction;
-            Gekko->Exception(Exception::PROGRAM);
+            core->PrCause = PrivilegedCause::IllegalInstruction;
+            core->Exception(Exception::PROGRAM);
             return;
         }
 
-        if (Gekko->regs.msr & MSR_FP)
+        if (core->regs.msr & MSR_FP)
         {
-            int i = (op >> 7) & 7;
-            uint32_t EA = RRB, data0, data1;
-            int32_t d = RD;
-            uint8_t scale = (uint8_t)LD_SCALE(i);
-            GEKKO_QUANT_TYPE type = LD_TYPE(i);
+            uint32_t EA = RRB;
 
             EA += RRA;
 
-            if (op & 0x400 /* W */)
-            {
-                if ((type == GEKKO_QUANT_TYPE::U8) || (type == GEKKO_QUANT_TYPE::S8)) Gekko->ReadByte(EA, &data0);
-                else if ((type == GEKKO_QUANT_TYPE::U16) || (type == GEKKO_QUANT_TYPE::S16)) Gekko->ReadHalf(EA, &data0);
-                else Gekko->ReadWord(EA, &data0);
-
-                if (Gekko->exception) return;
-
-                PS0(d) = (double)dequantize(data0, type, scale);
-                PS1(d) = 1.0f;
-            }
-            else
-            {
-                if ((type == GEKKO_QUANT_TYPE::U8) || (type == GEKKO_QUANT_TYPE::S8)) Gekko->ReadByte(EA, &data0);
-                else if ((type == GEKKO_QUANT_TYPE::U16) || (type == GEKKO_QUANT_TYPE::S16)) Gekko->ReadHalf(EA, &data0);
-                else Gekko->ReadWord(EA, &data0);
-
-                if (Gekko->exception) return;
-
-                if ((type == GEKKO_QUANT_TYPE::U8) || (type == GEKKO_QUANT_TYPE::S8)) Gekko->ReadByte(EA + 1, &data1);
-                else if ((type == GEKKO_QUANT_TYPE::U16) || (type == GEKKO_QUANT_TYPE::S16)) Gekko->ReadHalf(EA + 2, &data1);
-                else Gekko->ReadWord(EA + 4, &data1);
-
-                if (Gekko->exception) return;
-
-                PS0(d) = (double)dequantize(data0, type, scale);
-                PS1(d) = (double)dequantize(data1, type, scale);
-            }
+            if (!PSQLoadGqr(core, EA, RD, (op >> 7) & 7, (op & 0x400 /* W */) != 0)) return;
 
             RRA = EA;
-            Gekko->regs.pc += 4;
+            core->regs.pc += 4;
         }
-        else Gekko->Exception(Gekko::Exception::FPUNAVAIL);
+        else core->Exception(Gekko::Exception::FPUNAVAIL);
     }
 
     OP(PSQ_LX)
     {
-        if ((Gekko->regs.spr[(int)SPR::HID2] & HID2_PSE) == 0 ||
-            (Gekko->regs.spr[(int)SPR::HID2] & HID2_LSQE) == 0)
+        if ((core->regs.spr[(int)SPR::HID2] & HID2_PSE) == 0 ||
+            (core->regs.spr[(int)SPR::HID2] & HID2_LSQE) == 0)
         {
-            Gekko->PrCause = PrivilegedCause::IllegalInstruction;
-            Gekko->Exception(Exception::PROGRAM);
+            core->PrCause = PrivilegedCause::IllegalInstruction;
+            core->Exception(Exception::PROGRAM);
             return;
         }
 
-        if (Gekko->regs.msr & MSR_FP)
+        if (core->regs.msr & MSR_FP)
         {
-            int i = (op >> 7) & 7;
-            uint32_t EA = RRB, data0, data1;
-            int32_t d = RD;
-            uint8_t scale = (uint8_t)LD_SCALE(i);
-            GEKKO_QUANT_TYPE type = LD_TYPE(i);
+            uint32_t EA = RRB;
 
             if (RA) EA += RRA;
 
-            if (op & 0x400 /* W */)
-            {
-                if ((type == GEKKO_QUANT_TYPE::U8) || (type == GEKKO_QUANT_TYPE::S8)) Gekko->ReadByte(EA, &data0);
-                else if ((type == GEKKO_QUANT_TYPE::U16) || (type == GEKKO_QUANT_TYPE::S16)) Gekko->ReadHalf(EA, &data0);
-                else Gekko->ReadWord(EA, &data0);
-
-                if (Gekko->exception) return;
-
-                PS0(d) = (double)dequantize(data0, type, scale);
-                PS1(d) = 1.0f;
-            }
-            else
-            {
-                if ((type == GEKKO_QUANT_TYPE::U8) || (type == GEKKO_QUANT_TYPE::S8)) Gekko->ReadByte(EA, &data0);
-                else if ((type == GEKKO_QUANT_TYPE::U16) || (type == GEKKO_QUANT_TYPE::S16)) Gekko->ReadHalf(EA, &data0);
-                else Gekko->ReadWord(EA, &data0);
-
-                if (Gekko->exception) return;
-
-                if ((type == GEKKO_QUANT_TYPE::U8) || (type == GEKKO_QUANT_TYPE::S8)) Gekko->ReadByte(EA + 1, &data1);
-                else if ((type == GEKKO_QUANT_TYPE::U16) || (type == GEKKO_QUANT_TYPE::S16)) Gekko->ReadHalf(EA + 2, &data1);
-                else Gekko->ReadWord(EA + 4, &data1);
+            if (!PSQLoadGqr(core, EA, RD, (op >> 7) & 7, (op & 0x400 /* W */) != 0)) return;
 
-                if (Gekko->exception) return;
-
-                PS0(d) = (double)dequantize(data0, type, scale);
-                PS1(d) = (double)dequantize(data1, type, scale);
-            }
-
-            Gekko->regs.pc += 4;
+            core->regs.pc += 4;
         }
-        else Gekko->Exception(Gekko::Exception::FPUNAVAIL);
+        else core->Exception(Gekko::Exception::FPUNAVAIL);
     }
 
     // ---------------------------------------------------------------------------
@@ -295,190 +273,100 @@ namespace Gekko
 
     OP(PSQ_ST)
     {
-        if ((Gekko->regs.spr[(int)SPR::HID2] & HID2_PSE) == 0 ||
-            (Gekko->regs.spr[(int)SPR::HID2] & HID2_LSQE) == 0)
+        if ((core->regs.spr[(int)SPR::HID2] & HID2_PSE) == 0 ||
+            (core->regs.spr[(int)SPR::HID2] & HID2_LSQE) == 0)
         {
-            Gekko->PrCause = PrivilegedCause::IllegalInstruction;
-            Gekko->Exception(Exception::PROGRAM);
+            core->PrCause = PrivilegedCause::IllegalInstruction;
+            core->Exception(Exception::PROGRAM);
             return;
         }
 
-        if (Gekko->regs.msr & MSR_FP)
+        if (core->regs.msr & MSR_FP)
         {
             uint32_t EA = op & 0xfff;
-            int32_t d = RS;
-            uint8_t scale = (uint8_t)ST_SCALE(GEKKO_PSI);
-            GEKKO_QUANT_TYPE type = ST_TYPE(GEKKO_PSI);
 
             if (EA & 0x800) EA |= 0xfffff000;
             if (RA) EA += RRA;
 
-            if (GEKKO_PSW)
-            {
-                if ((type == GEKKO_QUANT_TYPE::U8) || (type == GEKKO_QUANT_TYPE::S8)) Gekko->WriteByte(EA, quantize((float)PS0(d), type, scale));
-                else if ((type == GEKKO_QUANT_TYPE::U16) || (type == GEKKO_QUANT_TYPE::S16)) Gekko->WriteHalf(EA, quantize((float)PS0(d), type, scale));
-                else Gekko->WriteWord(EA, quantize((float)PS0(d), type, scale));
-            }
-            else
-            {
-                if ((type == GEKKO_QUANT_TYPE::U8) || (type == GEKKO_QUANT_TYPE::S8)) Gekko->WriteByte(EA, quantize((float)PS0(d), type, scale));
-                else if ((type == GEKKO_QUANT_TYPE::U16) || (type == GEKKO_QUANT_TYPE::S16)) Gekko->WriteHalf(EA, quantize((float)PS0(d), type, scale));
-                else Gekko->WriteWord(EA, quantize((float)PS0(d), type, scale));
-
-                if (Gekko->exception) return;
-
-                if ((type == GEKKO_QUANT_TYPE::U8) || (type == GEKKO_QUANT_TYPE::S8)) Gekko->WriteByte(EA + 1, quantize((float)PS1(d), type, scale));
-                else if ((type == GEKKO_QUANT_TYPE::U16) || (type == GEKKO_QUANT_TYPE::S16)) Gekko->WriteHalf(EA + 2, quantize((float)PS1(d), type, scale));
-                else Gekko->WriteWord(EA + 4, quantize((float)PS1(d), type, scale));
-            }
-
-            if (Gekko->exception) return;
+            if (!PSQStoreGqr(core, EA, RS, GEKKO_PSI, GEKKO_PSW != 0)) return;
 
-            Gekko->regs.pc += 4;
+            core->regs.pc += 4;
         }
-        else Gekko->Exception(Gekko::Exception::FPUNAVAIL);
+        else core->Exception(Gekko::Exception::FPUNAVAIL);
     }
 
     OP(PSQ_STU)
     {
-        if ((Gekko->regs.spr[(int)SPR::HID2] & HID2_PSE) == 0 ||
-            (Gekko->regs.spr[(int)SPR::HID2] & HID2_LSQE) == 0 ||
+        if ((core->regs.spr[(int)SPR::HID2] & HID2_PSE) == 0 ||
+            (core->regs.spr[(int)SPR::HID2] & HID2_LSQE) == 0 ||
              RA == 0)
         {
-            Gekko->PrCause = PrivilegedCause::IllegalInstruction;
-            Gekko->Exception(Exception::PROGRAM);
+            core->PrCause = PrivilegedCause::IllegalInstruction;
+            core->Exception(Exception::PROGRAM);
             return;
         }
 
-        if (Gekko->regs.msr & MSR_FP)
+        if (core->regs.msr & MSR_FP)
         {
             uint32_t EA = op & 0xfff;
-            int32_t d = RS;
-            uint8_t scale = (uint8_t)ST_SCALE(GEKKO_PSI);
-            GEKKO_QUANT_TYPE type = ST_TYPE(GEKKO_PSI);
 
             if (EA & 0x800) EA |= 0xfffff000;
             EA += RRA;
 
-            if (GEKKO_PSW)
-            {
-                if ((type == GEKKO_QUANT_TYPE::U8) || (type == GEKKO_QUANT_TYPE::S8)) Gekko->WriteByte(EA, quantize((float)PS0(d), type, scale));
-                else if ((type == GEKKO_QUANT_TYPE::U16) || (type == GEKKO_QUANT_TYPE::S16)) Gekko->WriteHalf(EA, quantize((float)PS0(d), type, scale));
-                else Gekko->WriteWord(EA, quantize((float)PS0(d), type, scale));
-            }
-            else
-            {
-                if ((type == GEKKO_QUANT_TYPE::U8) || (type == GEKKO_QUANT_TYPE::S8)) Gekko->WriteByte(EA, quantize((float)PS0(d), type, scale));
-                else if ((type == GEKKO_QUANT_TYPE::U16) || (type == GEKKO_QUANT_TYPE::S16)) Gekko->WriteHalf(EA, quantize((float)PS0(d), type, scale));
-                else Gekko->WriteWord(EA, quantize((float)PS0(d), type, scale));
-
-                if (Gekko->exception) return;
-
-                if ((type == GEKKO_QUANT_TYPE::U8) || (type == GEKKO_QUANT_TYPE::S8)) Gekko->WriteByte(EA + 1, quantize((float)PS1(d), type, scale));
-                else if ((type == GEKKO_QUANT_TYPE::U16) || (type == GEKKO_QUANT_TYPE::S16)) Gekko->WriteHalf(EA + 2, quantize((float)PS1(d), type, scale));
-                else Gekko->WriteWord(EA + 4, quantize((float)PS1(d), type, scale));
-            }
-
-            if (Gekko->exception) return;
+            if (!PSQStoreGqr(core, EA, RS, GEKKO_PSI, GEKKO_PSW != 0)) return;
 
             RRA = EA;
-            Gekko->regs.pc += 4;
+            core->regs.pc += 4;
         }
-        else Gekko->Exception(Gekko::Exception::FPUNAVAIL);
+        else core->Exception(Gekko::Exception::FPUNAVAIL);
     }
 
     OP(PSQ_STUX)
     {
-        if ((Gekko->regs.spr[(int)SPR::HID2] & HID2_PSE) == 0 ||
-            (Gekko->regs.spr[(int)SPR::HID2] & HID2_LSQE) == 0 ||
+        if ((core->regs.spr[(int)SPR::HID2] & HID2_PSE) == 0 ||
+            (core->regs.spr[(int)SPR::HID2] & HID2_LSQE) == 0 ||
             RA == 0)
         {
-            Gekko->PrCause = PrivilegedCause::IllegalInstruction;
-            Gekko->Exception(Exception::PROGRAM);
+            core->PrCause = PrivilegedCause::IllegalInstruction;
+            core->Exception(Exception::PROGRAM);
             return;
         }
 
-        if (Gekko->regs.msr & MSR_FP)
+        if (core->regs.msr & MSR_FP)
         {
-            int i = (op >> 7) & 7;
             uint32_t EA = RRB;
-            int32_t d = RS;
-            uint8_t scale = (uint8_t)ST_SCALE(i);
-            GEKKO_QUANT_TYPE type = ST_TYPE(i);
 
             EA += RRA;
 
-            if (op & 0x400)
-            {
-                if ((type == GEKKO_QUANT_TYPE::U8) || (type == GEKKO_QUANT_TYPE::S8)) Gekko->WriteByte(EA, quantize((float)PS0(d), type, scale));
-                else if ((type == GEKKO_QUANT_TYPE::U16) || (type == GEKKO_QUANT_TYPE::S16)) Gekko->WriteHalf(EA, quantize((float)PS0(d), type, scale));
-                else Gekko->WriteWord(EA, quantize((float)PS0(d), type, scale));
-            }
-            else
-            {
-                if ((type == GEKKO_QUANT_TYPE::U8) || (type == GEKKO_QUANT_TYPE::S8)) Gekko->WriteByte(EA, quantize((float)PS0(d), type, scale));
-                else if ((type == GEKKO_QUANT_TYPE::U16) || (type == GEKKO_QUANT_TYPE::S16)) Gekko->WriteHalf(EA, quantize((float)PS0(d), type, scale));
-                else Gekko->WriteWord(EA, quantize((float)PS0(d), type, scale));
-
-                if (Gekko->exception) return;
-
-                if ((type == GEKKO_QUANT_TYPE::U8) || (type == GEKKO_QUANT_TYPE::S8)) Gekko->WriteByte(EA + 1, quantize((float)PS1(d), type, scale));
-                else if ((type == GEKKO_QUANT_TYPE::U16) || (type == GEKKO_QUANT_TYPE::S16)) Gekko->WriteHalf(EA + 2, quantize((float)PS1(d), type, scale));
-                else Gekko->WriteWord(EA + 4, quantize((float)PS1(d), type, scale));
-            }
-
-            if (Gekko->exception) return;
+            if (!PSQStoreGqr(core, EA, RS, (op >> 7) & 7, (op & 0x400 /* W */) != 0)) return;
 
             RRA = EA;
-            Gekko->regs.pc += 4;
+            core->regs.pc += 4;
         }
-        else Gekko->Exception(Gekko::Exception::FPUNAVAIL);
+        else core->Exception(Gekko::Exception::FPUNAVAIL);
     }
 
     OP(PSQ_STX)
     {
-        if ((Gekko->regs.spr[(int)SPR::HID2] & HID2_PSE) == 0 ||
-            (Gekko->regs.spr[(int)SPR::HID2] & HID2_LSQE) == 0)
+        if ((core->regs.spr[(int)SPR::HID2] & HID2_PSE) == 0 ||
+            (core->regs.spr[(int)SPR::HID2] & HID2_LSQE) == 0)
         {
-            Gekko->PrCause = PrivilegedCause::IllegalInstruction;
-            Gekko->Exception(Exception::PROGRAM);
+            core->PrCause = PrivilegedCause::IllegalInstruction;
+            core->Exception(Exception::PROGRAM);
             return;
         }
 
-        if (Gekko->regs.msr & MSR_FP)
+        if (core->regs.msr & MSR_FP)
         {
-            int i = (op >> 7) & 7;
             uint32_t EA = RRB;
-            int32_t d = RS;
-            uint8_t scale = (uint8_t)ST_SCALE(i);
-            GEKKO_QUANT_TYPE type = ST_TYPE(i);
 
             if (RA) EA += RRA;
 
-            if (op & 0x400)
-            {
-                if ((type == GEKKO_QUANT_TYPE::U8) || (type == GEKKO_QUANT_TYPE::S8)) Gekko->WriteByte(EA, quantize((float)PS0(d), type, scale));
-                else if ((type == GEKKO_QUANT_TYPE::U16) || (type == GEKKO_QUANT_TYPE::S16)) Gekko->WriteHalf(EA, quantize((float)PS0(d), type, scale));
-                else Gekko->WriteWord(EA, quantize((float)PS0(d), type, scale));
-            }
-            else
-            {
-                if ((type == GEKKO_QUANT_TYPE::U8) || (type == GEKKO_QUANT_TYPE::S8)) Gekko->WriteByte(EA, quantize((float)PS0(d), type, scale));
-                else if ((type == GEKKO_QUANT_TYPE::U16) || (type == GEKKO_QUANT_TYPE::S16)) Gekko->WriteHalf(EA, quantize((float)PS0(d), type, scale));
-                else Gekko->WriteWord(EA, quantize((float)PS0(d), type, scale));
-
-                if (Gekko->exception) return;
-
-                if ((type == GEKKO_QUANT_TYPE::U8) || (type == GEKKO_QUANT_TYPE::S8)) Gekko->WriteByte(EA + 1, quantize((float)PS1(d), type, scale));
-                else if ((type == GEKKO_QUANT_TYPE::U16) || (type == GEKKO_QUANT_TYPE::S16)) Gekko->WriteHalf(EA + 2, quantize((float)PS1(d), type, scale));
-                else Gekko->WriteWord(EA + 4, quantize((float)PS1(d), type, scale));
-            }
-
-            if (Gekko->exception) return;
+            if (!PSQStoreGqr(core, EA, RS, (op >> 7) & 7, (op & 0x400 /* W */) != 0)) return;
 
-            Gekko->regs.pc += 4;
+            core->regs.pc += 4;
         }
-        else Gekko->Exception(Gekko::Exception::FPUNAVAIL);
+        else core->Exception(Gekko::Exception::FPUNAVAIL);
     }
 
 }
@@ -1,18 +1,49 @@
 // Paired Single Instructions
 #include "../pch.h"
 #include "InterpreterPrivate.h"
+#include <emmintrin.h>
+
+// Both halves of a paired-single register are adjacent (see PSREG), so each instruction works on the pair as one SSE2 vector:
+// lane 0 is ps0, lane 1 is ps1. The arithmetic is the same IEEE double arithmetic as before, just two lanes at once.
 
 namespace Gekko
 {
+    static inline __m128d PSLoad(GekkoCore* core, size_t n)
+    {
+        return _mm_load_pd(&core->regs.fpr[n].ps0.dbl);
+    }
+
+    static inline void PSStore(GekkoCore* core, size_t n, __m128d value)
+    {
+        _mm_store_pd(&core->regs.fpr[n].ps0.dbl, value);
+    }
+
+    // {ps0, ps0}
+    static inline __m128d PSSplat0(GekkoCore* core, size_t n)
+    {
+        return _mm_set1_pd(core->regs.fpr[n].ps0.dbl);
+    }
+
+    // {ps1, ps1}
+    static inline __m128d PSSplat1(GekkoCore* core, size_t n)
+    {
+        return _mm_set1_pd(core->regs.fpr[n].ps1.dbl);
+    }
+
+    // Flip the sign bits (same as unary minus, NaNs included)
+    static inline __m128d PSNeg(__m128d value)
+    {
+        return _mm_xor_pd(value, _mm_set1_pd(-0.0));
+    }
+
     OP(PS_ADD)
     {
-        if (Gekko->regs.msr & MSR_FP)
+        if (core->regs.msr & MSR_FP)
         {
-            PS0(RD) = PS0(RA) + PS0(RB);
-            PS1(RD) = PS1(RA) + PS1(RB);
-            Gekko->regs.pc += 4;
+            PSStore(core, RD, _mm_add_pd(PSLoad(core, RA), PSLoad(core, RB)));
+            core->regs.pc += 4;
         }
-        else Gekko->Exception(Gekko::Exception::FPUNAVAIL);
+        else core->Exception(Gekko::Exception::FPUNAVAIL);
     }
 
     OP(PS_ADDD)
@@ -22,13 +53,12 @@ namespace Gekko
 
     OP(PS_SUB)
     {
-        if (Gekko->regs.msr & MSR_FP)
+        if (core->regs.msr & MSR_FP)
         {
-            PS0(RD) = PS0(RA) - PS0(RB);
-            PS1(RD) = PS1(RA) - PS1(RB);
-            Gekko->regs.pc += 4;
+            PSStore(core, RD, _mm_sub_pd(PSLoad(core, RA), PSLoad(core, RB)));
+            core->regs.pc += 4;
         }
-        else Gekko->Exception(Gekko::Exception::FPUNAVAIL);
+        else core->Exception(Gekko::Exception::FPUNAVAIL);
     }
 
     OP(PS_SUBD)
@@ -38,13 +68,12 @@ namespace Gekko
 
     OP(PS_MUL)
     {
-        if (Gekko->regs.msr & MSR_FP)
+        if (core->regs.msr & MSR_FP)
         {
-            PS0(RD) = PS0(RA) * PS0(RC);
-            PS1(RD) = PS1(RA) * PS1(RC);
-            Gekko->regs.pc += 4;
+            PSStore(core, RD, _mm_mul_pd(PSLoad(core, RA), PSLoad(core, RC)));
+            core->regs.pc += 4;
         }
-        else Gekko->Exception(Gekko::Exception::FPUNAVAIL);
+        else core->Exception(Gekko::Exception::FPUNAVAIL);
     }
 
     OP(PS_MULD)
@@ -54,13 +83,12 @@ namespace Gekko
 
     OP(PS_DIV)
     {
-        if (Gekko->regs.msr & MSR_FP)
+        if (core->regs.msr & MSR_FP)
         {
-            PS0(RD) = PS0(RA) / PS0(RB);
-            PS1(RD) = PS1(RA) / PS1(RB);
-            Gekko->regs.pc += 4;
+            PSStore(core, RD, _mm_div_pd(PSLoad(core, RA), PSLoad(core, RB)));
+            core->regs.pc += 4;
         }
-        else Gekko->Exception(Gekko::Exception::FPUNAVAIL);
+        else core->Exception(Gekko::Exception::FPUNAVAIL);
     }
 
     OP(PS_DIVD)
@@ -70,13 +98,12 @@ namespace Gekko
 
     OP(PS_RES)
     {
-        if (Gekko->regs.msr & MSR_FP)
+        if (core->regs.msr & MSR_FP)
         {
-            PS0(RD) = 1.0f / PS0(RB);
-            PS1(RD) = 1.0f / PS1(RB);
-            Gekko->regs.pc += 4;
+            PSStore(core, RD, _mm_div_pd(_mm_set1_pd(1.0), PSLoad(core, RB)));
+            core->regs.pc += 4;
         }
-        else Gekko->Exception(Gekko::Exception::FPUNAVAIL);
+        else core->Exception(Gekko::Exception::FPUNAVAIL);
     }
 
     OP(PS_RESD)
@@ -86,13 +113,12 @@ namespace Gekko
 
     OP(PS_RSQRTE)
     {
-        if (Gekko->regs.msr & MSR_FP)
+        if (core->regs.msr & MSR_FP)
         {
-            PS0(RD) = 1.0f / sqrt(PS0(RB));
-            PS1(RD) = 1.0f / sqrt(PS1(RB));
-            Gekko->regs.pc += 4;
+            PSStore(core, RD, _mm_div_pd(_mm_set1_pd(1.0), _mm_sqrt_pd(PSLoad(core, RB))));
+            core->regs.pc += 4;
         }
-        else Gekko->Exception(Gekko::Exception::FPUNAVAIL);
+        else core->Exception(Gekko::Exception::FPUNAVAIL);
     }
 
     OP(PS_RSQRTED)
@@ -102,13 +128,13 @@ namespace Gekko
 
     OP(PS_SEL)
     {
-        if (Gekko->regs.msr & MSR_FP)
+        if (core->regs.msr & MSR_FP)
         {
-            PS0(RD) = (PS0(RA) >= 0.0) ? (PS0(RC)) : (PS0(RB));
-            PS1(RD) = (PS1(RA) >= 0.0) ? (PS1(RC)) : (PS1(RB));
-            Gekko->regs.pc += 4;
+            __m128d mask = _mm_cmpge_pd(PSLoad(core, RA), _mm_setzero_pd());
+            PSStore(core, RD, _mm_or_pd(_mm_and_pd(mask, PSLoad(core, RC)), _mm_andnot_pd(mask, PSLoad(core, RB))));
+            core->regs.pc += 4;
         }
-        else Gekko->Exception(Gekko::Exception::FPUNAVAIL);
+        else core->Exception(Gekko::Exception::FPUNAVAIL);
     }
 
     OP(PS_SELD)
@@ -118,15 +144,12 @@ namespace Gekko
 
     OP(PS_MULS0)
     {
-        if (Gekko->regs.msr & MSR_FP)
+        if (core->regs.msr & MSR_FP)
         {
-            double m0 = PS0(RA) * PS0(RC);
-            double m1 = PS1(RA) * PS0(RC);
-            PS0(RD) = m0;
-            PS1(RD) = m1;
-            Gekko->regs.pc += 4;
+            PSStore(core, RD, _mm_mul_pd(PSLoad(core, RA), PSSplat0(core, RC)));
+            core->regs.pc += 4;
         }
-        else Gekko->Exception(Gekko::Exception::FPUNAVAIL);
+        else core->Exception(Gekko::Exception::FPUNAVAIL);
     }
 
     OP(PS_MULS0D)
@@ -136,15 +159,12 @@ namespace Gekko
 
     OP(PS_MULS1)
     {
-        if (Gekko->regs.msr & MSR_FP)
+        if (core->regs.msr & MSR_FP)
         {
-            double m0 = PS0(RA) * PS1(RC);
-            double m1 = PS1(RA) * PS1(RC);
-            PS0(RD) = m0;
-            PS1(RD) = m1;
-            Gekko->regs.pc += 4;
+            PSStore(core, RD, _mm_mul_pd(PSLoad(core, RA), PSSplat1(core, RC)));
+            core->regs.pc += 4;
         }
-        else Gekko->Exception(Gekko::Exception::FPUNAVAIL);
+        else core->Exception(Gekko::Exception::FPUNAVAIL);
     }
 
     OP(PS_MULS1D)
@@ -154,15 +174,13 @@ namespace Gekko
 
     OP(PS_SUM0)
     {
-        if (Gekko->regs.msr & MSR_FP)
+        if (core->regs.msr & MSR_FP)
         {
-            double s0 = PS0(RA) + PS1(RB);
-            double s1 = PS1(RC);
-            PS0(RD) = s0;
-            PS1(RD) = s1;
-            Gekko->regs.pc += 4;
+            __m128d sum = _mm_add_sd(PSLoad(core, RA), PSSplat1(core, RB));
+            PSStore(core, RD, _mm_move_sd(PSLoad(core, RC), sum));
+            core->regs.pc += 4;
         }
-        else Gekko->Exception(Gekko::Exception::FPUNAVAIL);
+        else core->Exception(Gekko::Exception::FPUNAVAIL);
     }
 
     OP(PS_SUM0D)
@@ -172,15 +190,13 @@ namespace Gekko
 
     OP(PS_SUM1)
     {
-        if (Gekko->regs.msr & MSR_FP)
+        if (core->regs.msr & MSR_FP)
         {
-            double s0 = PS0(RC);
-            double s1 = PS0(RA) + PS1(RB);
-            PS0(RD) = s0;
-            PS1(RD) = s1;
-            Gekko->regs.pc += 4;
+            __m128d sum = _mm_add_sd(PSLoad(core, RA), PSSplat1(core, RB));
+            PSStore(core, RD, _mm_unpacklo_pd(PSLoad(core, RC), sum));
+            core->regs.pc += 4;
         }
-        else Gekko->Exception(Gekko::Exception::FPUNAVAIL);
+        else core->Exception(Gekko::Exception::FPUNAVAIL);
     }
 
     OP(PS_SUM1D)
@@ -190,19 +206,12 @@ namespace Gekko
 
     OP(PS_MADD)
     {
-        if (Gekko->regs.msr & MSR_FP)
+        if (core->regs.msr & MSR_FP)
         {
-            double a = PS0(RA);
-            double b = PS0(RB);
-            double c = PS0(RC);
-            PS0(RD) = (a * c) + b;
-            a = PS1(RA);
-            b = PS1(RB);
-            c = PS1(RC);
-            PS1(RD) = (a * c) + b;
-            Gekko->regs.pc += 4;
+            PSStore(core, RD, _mm_add_pd(_mm_mul_pd(PSLoad(core, RA), PSLoad(core, RC)), PSLoad(core, RB)));
+            core->regs.pc += 4;
         }
-        else Gekko->Exception(Gekko::Exception::FPUNAVAIL);
+        else core->Exception(Gekko::Exception::FPUNAVAIL);
     }
 
     OP(PS_MADDD)
@@ -212,19 +221,12 @@ namespace Gekko
 
     OP(PS_MSUB)
     {
-        if (Gekko->regs.msr & MSR_FP)
+        if (core->regs.msr & MSR_FP)
         {
-            double a = PS0(RA);
-            double b = PS0(RB);
-            double c = PS0(RC);
-            PS0(RD) = (a * c) - b;
-            a = PS1(RA);
-            b = PS1(RB);
-            c = PS1(RC);
-            PS1(RD) = (a * c) - b;
-            Gekko->regs.pc += 4;
+            PSStore(core, RD, _mm_sub_pd(_mm_mul_pd(PSLoad(core, RA), PSLoad(core, RC)), PSLoad(core, RB)));
+            core->regs.pc += 4;
         }
-        else Gekko->Exception(Gekko::Exception::FPUNAVAIL);
+        else core->Exception(Gekko::Exception::FPUNAVAIL);
     }
 
     OP(PS_MSUBD)
@@ -234,19 +236,12 @@ namespace Gekko
 
     OP(PS_NMADD)
     {
-        if (Gekko->regs.msr & MSR_FP)
+        if (core->regs.msr & MSR_FP)
         {
-            double a = PS0(RA);
-            double b = PS0(RB);
-            double c = PS0(RC);
-            PS0(RD) = -((a * c) + b);
-            a = PS1(RA);
-            b = PS1(RB);
-            c = PS1(RC);
-            PS1(RD) = -((a * c) + b);
-            Gekko->regs.pc += 4;
+            PSStore(core, RD, PSNeg(_mm_add_pd(_mm_mul_pd(PSLoad(core, RA), PSLoad(core, RC)), PSLoad(core, RB))));
+            core->regs.pc += 4;
         }
-        else Gekko->Exception(Gekko::Exception::FPUNAVAIL);
+        else core->Exception(Gekko::Exception::FPUNAVAIL);
     }
 
     OP(PS_NMADDD)
@@ -256,19 +251,12 @@ namespace Gekko
 
     OP(PS_NMSUB)
     {
-        if (Gekko->regs.msr & MSR_FP)
+        if (core->regs.msr & MSR_FP)
         {
-            double a = PS0(RA);
-            double b = PS0(RB);
-            double c = PS0(RC);
-            PS0(RD) = -((a * c) - b);
-            a = PS1(RA);
-            b = PS1(RB);
-            c = PS1(RC);
-            PS1(RD) = -((a * c) - b);
-            Gekko->regs.pc += 4;
+            PSStore(core, RD, PSNeg(_mm_sub_pd(_mm_mul_pd(PSLoad(core, RA), PSLoad(core, RC)), PSLoad(core, RB))));
+            core->regs.pc += 4;
         }
-        else Gekko->Exception(Gekko::Exception::FPUNAVAIL);
+        else core->Exception(Gekko::Exception::FPUNAVAIL);
     }
 
     OP(PS_NMSUBD)
@@ -278,15 +266,12 @@ namespace Gekko
 
     OP(PS_MADDS0)
     {
-        if (Gekko->regs.msr & MSR_FP)
+        if (core->regs.msr & MSR_FP)
         {
-            double s0 = (PS0(RA) * PS0(RC)) + PS0(RB);
-            double s1 = (PS1(RA) * PS0(RC)) + PS1(RB);
-            PS0(RD) = s0;
-            PS1(RD) = s1;
-            Gekko->regs.pc += 4;
+            PSStore(core, RD, _mm_add_pd(_mm_mul_pd(PSLoad(core, RA), PSSplat0(core, RC)), PSLoad(core, RB)));
+            core->regs.pc += 4;
         }
-        else Gekko->Exception(Gekko::Exception::FPUNAVAIL);
+        else core->Exception(Gekko::Exception::FPUNAVAIL);
     }
 
     OP(PS_MADDS0D)
@@ -296,15 +281,12 @@ namespace Gekko
 
     OP(PS_MADDS1)
     {
-        if (Gekko->regs.msr & MSR_FP)
+        if (core->regs.msr & MSR_FP)
         {
-            double s0 = (PS0(RA) * PS1(RC)) + PS0(RB);
-            double s1 = (PS1(RA) * PS1(RC)) + PS1(RB);
-            PS0(RD) = s0;
-            PS1(RD) = s1;
-            Gekko->regs.pc += 4;
+            PSStore(core, RD, _mm_add_pd(_mm_mul_pd(PSLoad(core, RA), PSSplat1(core, RC)), PSLoad(core, RB)));
+            core->regs.pc += 4;
         }
-        else Gekko->Exception(Gekko::Exception::FPUNAVAIL);
+        else core->Exception(Gekko::Exception::FPUNAVAIL);
     }
 
     OP(PS_MADDS1D)
@@ -314,7 +296,7 @@ namespace Gekko
 
     OP(PS_CMPU0)
     {
-        if (Gekko->regs.msr & MSR_FP)
+        if (core->regs.msr & MSR_FP)
         {
             int n = CRFD;
             double a = PS0(RA), b = PS0(RB);
@@ -330,14 +312,14 @@ namespace Gekko
             else c = 2;
 
             SET_CRF(n, c);
-            Gekko->regs.pc += 4;
+            core->regs.pc += 4;
         }
-        else Gekko->Exception(Gekko::Exception::FPUNAVAIL);
+        else core->Exception(Gekko::Exception::FPUNAVAIL);
     }
 
     OP(PS_CMPU1)
     {
-        if (Gekko->regs.msr & MSR_FP)
+        if (core->regs.msr & MSR_FP)
         {
             int n = CRFD;
             double a = PS1(RA), b = PS1(RB);
@@ -353,14 +335,14 @@ namespace Gekko
             else c = 2;
 
             SET_CRF(n, c);
-            Gekko->regs.pc += 4;
+            core->regs.pc += 4;
         }
-        else Gekko->Exception(Gekko::Exception::FPUNAVAIL);
+        else core->Exception(Gekko::Exception::FPUNAVAIL);
     }
 
     OP(PS_CMPO0)
     {
-        if (Gekko->regs.msr & MSR_FP)
+        if (core->regs.msr & MSR_FP)
         {
             int n = CRFD;
             double a = PS0(RA), b = PS0(RB);
@@ -376,14 +358,14 @@ namespace Gekko
             else c = 2;
 
             SET_CRF(n, c);
-            Gekko->regs.pc += 4;
+            core->regs.pc += 4;
         }
-        else Gekko->Exception(Gekko::Exception::FPUNAVAIL);
+        else core->Exception(Gekko::Exception::FPUNAVAIL);
     }
 
     OP(PS_CMPO1)
     {
-        if (Gekko->regs.msr & MSR_FP)
+        if (core->regs.msr & MSR_FP)
         {
             int n = CRFD;
             double a = PS1(RA), b = PS1(RB);
@@ -399,20 +381,19 @@ namespace Gekko
             else c = 2;
 
             SET_CRF(n, c);
-            Gekko->regs.pc += 4;
+            core->regs.pc += 4;
         }
-        else Gekko->Exception(Gekko::Exception::FPUNAVAIL);
+        else core->Exception(Gekko::Exception::FPUNAVAIL);
     }
 
     OP(PS_MR)
     {
-        if (Gekko->regs.msr & MSR_FP)
+        if (core->regs.msr & MSR_FP)
         {
-            double p0 = PS0(RB), p1 = PS1(RB);
-            PS0(RD) = p0, PS1(RD) = p1;
-            Gekko->regs.pc += 4;
+            PSStore(core, RD, PSLoad(core, RB));
+            core->regs.pc += 4;
         }
-        else Gekko->Exception(Gekko::Exception::FPUNAVAIL);
+        else core->Exception(Gekko::Exception::FPUNAVAIL);
     }
 
     OP(PS_MRD)
@@ -422,13 +403,12 @@ namespace Gekko
 
     OP(PS_NEG)
     {
-        if (Gekko->regs.msr & MSR_FP)
+        if (core->regs.msr & MSR_FP)
         {
-            PS0(RD) = -PS0(RB);
-            PS1(RD) = -PS1(RB);
-            Gekko->regs.pc += 4;
+            PSStore(core, RD, PSNeg(PSLoad(core, RB)));
+            core->regs.pc += 4;
         }
-        else Gekko->Exception(Gekko::Exception::FPUNAVAIL);
+        else core->Exception(Gekko::Exception::FPUNAVAIL);
     }
 
     OP(PS_NEGD)
@@ -458,15 +438,12 @@ namespace Gekko
 
     OP(PS_MERGE00)
     {
-        if (Gekko->regs.msr & MSR_FP)
+        if (core->regs.msr & MSR_FP)
         {
-            double a = PS0(RA);
-            double b = PS0(RB);
-            PS0(RD) = a;
-            PS1(RD) = b;
-            Gekko->regs.pc += 4;
+            PSStore(core, RD, _mm_unpacklo_pd(PSLoad(core, RA), PSLoad(core, RB)));
+            core->regs.pc += 4;
         }
-        else Gekko->Exception(Gekko::Exception::FPUNAVAIL);
+        else core->Exception(Gekko::Exception::FPUNAVAIL);
     }
 
     OP(PS_MERGE00D)
@@ -476,15 +453,12 @@ namespace Gekko
 
     OP(PS_MERGE01)
     {
-        if (Gekko->regs.msr & MSR_FP)
+        if (core->regs.msr & MSR_FP)
         {
-            double a = PS0(RA);
-            double b = PS1(RB);
-            PS0(RD) = a;
-            PS1(RD) = b;
-            Gekko->regs.pc += 4;
+            PSStore(core, RD, _mm_move_sd(PSLoad(core, RB), PSLoad(core, RA)));
+            core->regs.pc += 4;
         }
-        else Gekko->Exception(Gekko::Exception::FPUNAVAIL);
+        else core->Exception(Gekko::Exception::FPUNAVAIL);
     }
 
     OP(PS_MERGE01D)
@@ -494,15 +468,12 @@ namespace Gekko
 
     OP(PS_MERGE10)
     {
-        if (Gekko->regs.msr & MSR_FP)
+        if (core->regs.msr & MSR_FP)
         {
-            double a = PS1(RA);
-            double b = PS0(RB);
-            PS0(RD) = a;
-            PS1(RD) = b;
-            Gekko->regs.pc += 4;
+            PSStore(core, RD, _mm_shuffle_pd(PSLoad(core, RA), PSLoad(core, RB), 1));
+            core->regs.pc += 4;
         }
-        else Gekko->Exception(Gekko::Exception::FPUNAVAIL);
+        else core->Exception(Gekko::Exception::FPUNAVAIL);
     }
 
     OP(PS_MERGE10D)
@@ -512,15 +483,12 @@ namespace Gekko
 
     OP(PS_MERGE11)
     {
-        if (Gekko->regs.msr & MSR_FP)
+        if (core->regs.msr & MSR_FP)
         {
-            double a = PS1(RA);
-            double b = PS1(RB);
-            PS0(RD) = a;
-            PS1(RD) = b;
-            Gekko->regs.pc += 4;
+            PSStore(core, RD, _mm_unpackhi_pd(PSLoad(core, RA), PSLoad(core, RB)));
+            core->regs.pc += 4;
         }
-        else Gekko->Exception(Gekko::Exception::FPUNAVAIL);
+        else core->Exception(Gekko::Exception::FPUNAVAIL);
     }
 
     OP(PS_MERGE11D)
@@ -12,12 +12,12 @@ namespace Gekko
     // CR0 (if .)
     OP(RLWINM)
     {
-        uint32_t m = Gekko->interp->rotmask[MB][ME];
+        uint32_t m = core->interp->rotmask[MB][ME];
         uint32_t r = Rotl32(SH, RRS);
         uint32_t res = r & m;
         RRA = res;
         if (op & 1) COMPUTE_CR0(res);
-        Gekko->regs.pc += 4;
+        core->regs.pc += 4;
     }
 
     // n = rb[27-31]
@@ -26,12 +26,12 @@ namespace Gekko
     // ra = r & m
     OP(RLWNM)
     {
-        uint32_t m = Gekko->interp->rotmask[MB][ME];
+        uint32_t m = core->interp->rotmask[MB][ME];
         uint32_t r = Rotl32(RRB & 0x1f, RRS);
         uint32_t res = r & m;
         RRA = res;
         if (op & 1) COMPUTE_CR0(res);
-        Gekko->regs.pc += 4;
+        core->regs.pc += 4;
     }
 
     // n = SH
@@ -41,12 +41,12 @@ namespace Gekko
     // CR0 (if .)
     OP(RLWIMI)
     {
-        uint32_t m = Gekko->interp->rotmask[MB][ME];
+        uint32_t m = core->interp->rotmask[MB][ME];
         uint32_t r = Rotl32(SH, RRS);
         uint32_t res = (r & m) | (RRA & ~m);
         RRA = res;
         if (op & 1) COMPUTE_CR0(res);
-        Gekko->regs.pc += 4;
+        core->regs.pc += 4;
     }
 
 }
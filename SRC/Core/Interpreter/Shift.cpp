@@ -18,7 +18,7 @@ namespace Gekko
 
         if (n & 0x20) RRA = 0;
         else RRA = RRS << (n & 0x1f);
-        Gekko->regs.pc += 4;
+        core->regs.pc += 4;
     }
 
     // n = rb[27-31]
@@ -39,7 +39,7 @@ namespace Gekko
 
         RRA = res;
         COMPUTE_CR0(res);
-        Gekko->regs.pc += 4;
+        core->regs.pc += 4;
     }
 
     // n = rb[27-31]
@@ -55,7 +55,7 @@ namespace Gekko
 
         if (n & 0x20) RRA = 0;
         else RRA = RRS >> (n & 0x1f);
-        Gekko->regs.pc += 4;
+        core->regs.pc += 4;
     }
 
     // n = rb[27-31]
@@ -76,7 +76,7 @@ namespace Gekko
 
         RRA = res;
         COMPUTE_CR0(res);
-        Gekko->regs.pc += 4;
+        core->regs.pc += 4;
     }
 
     // n = SH
@@ -103,7 +103,7 @@ namespace Gekko
         }
 
         RRA = res;
-        Gekko->regs.pc += 4;
+        core->regs.pc += 4;
     }
 
     // n = SH
@@ -132,7 +132,7 @@ namespace Gekko
 
         RRA = res;
         COMPUTE_CR0(res);
-        Gekko->regs.pc += 4;
+        core->regs.pc += 4;
     }
 
     // n = rb[27-31]
@@ -175,7 +175,7 @@ namespace Gekko
         }
 
         RRA = res;
-        Gekko->regs.pc += 4;
+        core->regs.pc += 4;
     }
 
     // n = rb[27-31]
@@ -220,7 +220,7 @@ namespace Gekko
 
         RRA = res;
         COMPUTE_CR0(res);
-        Gekko->regs.pc += 4;
+        core->regs.pc += 4;
     }
 
 }
@@ -16,13 +16,13 @@ namespace Gekko
             (((uint32_t)a > (uint32_t)b) && (to & 0x01)))
         {
             // pseudo-branch (to resume from next instruction after 'rfi')
-            Gekko->regs.pc += 4;
-            Gekko->PrCause = PrivilegedCause::Trap;
-            Gekko->Exception(Gekko::Exception::PROGRAM);
+            core->regs.pc += 4;
+            core->PrCause = PrivilegedCause::Trap;
+            core->Exception(Gekko::Exception::PROGRAM);
         }
         else
         {
-            Gekko->regs.pc += 4;
+            core->regs.pc += 4;
         }
     }
 
@@ -38,13 +38,13 @@ namespace Gekko
             (((uint32_t)a > (uint32_t)b) && (to & 0x01)))
         {
             // pseudo-branch (to resume from next instruction after 'rfi')
-            Gekko->regs.pc += 4;
-            Gekko->PrCause = PrivilegedCause::Trap;
-            Gekko->Exception(Gekko::Exception::PROGRAM);
+            core->regs.pc += 4;
+            core->PrCause = PrivilegedCause::Trap;
+            core->Exception(Gekko::Exception::PROGRAM);
         }
         else
         {
-            Gekko->regs.pc += 4;
+            core->regs.pc += 4;
         }
     }
 
@@ -52,16 +52,16 @@ namespace Gekko
     OP(SC)
     {
         // pseudo-branch (to resume from next instruction after 'rfi')
-        Gekko->regs.pc += 4;
-        Gekko->Exception(Gekko::Exception::SYSCALL);
+        core->regs.pc += 4;
+        core->Exception(Gekko::Exception::SYSCALL);
     }
 
     // return from exception
     OP(RFI)
     {
-        Gekko->regs.msr &= ~(0x87C0FF73 | 0x00040000);
-        Gekko->regs.msr |= Gekko->regs.spr[(int)SPR::SRR1] & 0x87C0FF73;
-        Gekko->regs.pc = Gekko->regs.spr[(int)SPR::SRR0] & ~3;
+        core->regs.msr &= ~(0x87C0FF73 | 0x00040000);
+        core->regs.msr |= core->regs.spr[(int)SPR::SRR1] & 0x87C0FF73;
+        core->regs.pc = core->regs.spr[(int)SPR::SRR0] & ~3;
     }
 
     // ---------------------------------------------------------------------------
@@ -79,10 +79,10 @@ namespace Gekko
             {
                 a = (d >> (i << 2)) & 0xf;
                 m = (0xf << (i << 2));
-                Gekko->regs.cr = (Gekko->regs.cr & ~m) | (a << (i << 2));
+                core->regs.cr = (core->regs.cr & ~m) | (a << (i << 2));
             }
         }
-        Gekko->regs.pc += 4;
+        core->regs.pc += 4;
     }
 
     // CR[4 * crfD .. 4 * crfd + 3] = XER[0-3]
@@ -90,45 +90,45 @@ namespace Gekko
     OP(MCRXR)
     {
         uint32_t mask = 0xf0000000 >> (4 * CRFD);
-        Gekko->regs.cr &= ~mask;
-        Gekko->regs.cr |= (Gekko->regs.spr[(int)SPR::XER] & 0xf0000000) >> (4 * CRFD);
-        Gekko->regs.spr[(int)SPR::XER] &= ~0xf0000000;
-        Gekko->regs.pc += 4;
+        core->regs.cr &= ~mask;
+        core->regs.cr |= (core->regs.spr[(int)SPR::XER] & 0xf0000000) >> (4 * CRFD);
+        core->regs.spr[(int)SPR::XER] &= ~0xf0000000;
+        core->regs.pc += 4;
     }
 
     // rd = cr
     OP(MFCR)
     {
-        RRD = Gekko->regs.cr;
-        Gekko->regs.pc += 4;
+        RRD = core->regs.cr;
+        core->regs.pc += 4;
     }
 
     // msr = rs
     OP(MTMSR)
     {
-        if (Gekko->regs.msr & MSR_PR)
+        if (core->regs.msr & MSR_PR)
         {
-            Gekko->PrCause = PrivilegedCause::Privileged;
-            Gekko->Exception(Exception::PROGRAM);
+            core->PrCause = PrivilegedCause::Privileged;
+            core->Exception(Exception::PROGRAM);
             return;
         }
 
-        Gekko->regs.msr = RRS;
-        Gekko->regs.pc += 4;
+        core->regs.msr = RRS;
+        core->regs.pc += 4;
     }
 
     // rd = msr
     OP(MFMSR)
     {
-        if (Gekko->regs.msr & MSR_PR)
+        if (core->regs.msr & MSR_PR)
         {
-            Gekko->PrCause = PrivilegedCause::Privileged;
-            Gekko->Exception(Exception::PROGRAM);
+            core->PrCause = PrivilegedCause::Privileged;
+            core->Exception(Exception::PROGRAM);
             return;
         }
 
-        RRD = Gekko->regs.msr;
-        Gekko->regs.pc += 4;
+        RRD = core->regs.msr;
+        core->regs.pc += 4;
     }
 
     // We do not support access rights to SPRs, since all applications on the emulated system are executed with OEA rights.
@@ -148,50 +148,57 @@ namespace Gekko
                 "DBAT2U", "DBAT2L", "DBAT3U", "DBAT3L"
             };
 
-            bool msr_ir = (Gekko->regs.msr & MSR_IR) ? true : false;
-            bool msr_dr = (Gekko->regs.msr & MSR_DR) ? true : false;
+            bool msr_ir = (core->regs.msr & MSR_IR) ? true : false;
+            bool msr_dr = (core->regs.msr & MSR_DR) ? true : false;
 
             DBReport2(DbgChannel::CPU, "%s <- %08X (IR:%i DR:%i pc:%08X)\n",
-                bat[spr - 528], RRS, msr_ir, msr_dr, Gekko->regs.pc);
+                bat[spr - 528], RRS, msr_ir, msr_dr, core->regs.pc);
         }
         else switch (spr)
         {
             // decrementer
             case (int)SPR::DEC:
                 //DBReport2(DbgChannel::CPU, "set decrementer (OS alarm) to %08X\n", RRS);
-                break;
+                // Account the old value, then start a new timer slice from the new one
+                core->SyncTimers();
+                core->regs.spr[spr] = RRS;
+                core->SyncTimers();
+                core->regs.pc += 4;
+                return;
 
             // page table base
             case (int)SPR::SDR1:
             {
-                bool msr_ir = (Gekko->regs.msr & MSR_IR) ? true : false;
-                bool msr_dr = (Gekko->regs.msr & MSR_DR) ? true : false;
+                bool msr_ir = (core->regs.msr & MSR_IR) ? true : false;
+                bool msr_dr = (core->regs.msr & MSR_DR) ? true : false;
 
                 DBReport2(DbgChannel::CPU, "SDR <- %08X (IR:%i DR:%i pc:%08X)\n",
-                    RRS, msr_ir, msr_dr, Gekko->regs.pc);
+                    RRS, msr_ir, msr_dr, core->regs.pc);
             }
             break;
 
             case (int)SPR::TBL:
-                Gekko->regs.tb.Part.l = RRS;
-                DBReport2(DbgChannel::CPU, "Set TBL: 0x%08X\n", Gekko->regs.tb.Part.l);
+                core->SyncTimers();
+                core->regs.tb.Part.l = RRS;
+                DBReport2(DbgChannel::CPU, "Set TBL: 0x%08X\n", core->regs.tb.Part.l);
                 break;
             case (int)SPR::TBU:
-                Gekko->regs.tb.Part.u = RRS;
-                DBReport2(DbgChannel::CPU, "Set TBU: 0x%08X\n", Gekko->regs.tb.Part.u);
+                core->SyncTimers();
+                core->regs.tb.Part.u = RRS;
+                DBReport2(DbgChannel::CPU, "Set TBU: 0x%08X\n", core->regs.tb.Part.u);
                 break;
 
             // write gathering buffer
             case (int)SPR::WPAR:
                 // A mtspr to WPAR invalidates the data.
-                Gekko->gatherBuffer.Reset();
+                core->gatherBuffer.Reset();
                 break;
 
             case (int)SPR::HID0:
             {
                 uint32_t bits = RRS;
-                Gekko->cache.Enable((bits & HID0_DCE) ? true : false);
-                Gekko->cache.Freeze((bits & HID0_DLOCK) ? true : false);
+                core->cache.Enable((bits & HID0_DCE) ? true : false);
+                core->cache.Freeze((bits & HID0_DLOCK) ? true : false);
                 if (bits & HID0_DCFI)
                 {
                     bits &= ~HID0_DCFI;
@@ -204,26 +211,27 @@ namespace Gekko
                 if (bits & HID0_ICFI)
                 {
                     bits &= ~HID0_ICFI;
-                    Gekko->jitc->Reset();
+                    core->jitc->Reset();
+                    core->interp->InvalidateCachedAll();
 
                     DBReport2(DbgChannel::CPU, "Instruction Cache Flash Invalidate\n");
                 }
 
-                Gekko->regs.spr[spr] = bits;
-                Gekko->regs.pc += 4;
+                core->regs.spr[spr] = bits;
+                core->regs.pc += 4;
                 return;
             }
             break;
 
             case (int)SPR::HID1:
                 // Read only
-                Gekko->regs.pc += 4;
+                core->regs.pc += 4;
                 return;
 
             case (int)SPR::HID2:
             {
                 uint32_t bits = RRS;
-                Gekko->cache.LockedEnable((bits & HID2_LCE) ? true : false);
+                core->cache.LockedEnable((bits & HID2_LCE) ? true : false);
             }
             break;
 
@@ -234,19 +242,19 @@ namespace Gekko
                 break;
             case (int)SPR::DMAL:
             {
-                Gekko->regs.spr[spr] = RRS;
+                core->regs.spr[spr] = RRS;
                 //DBReport2(DbgChannel::CPU, "DMAL: 0x%08X\n", RRS);
-                if (Gekko->regs.spr[(int)SPR::DMAL] & GEKKO_DMAL_DMA_T)
+                if (core->regs.spr[(int)SPR::DMAL] & GEKKO_DMAL_DMA_T)
                 {
-                    uint32_t maddr = Gekko->regs.spr[(int)SPR::DMAU] & GEKKO_DMAU_MEM_ADDR;
-                    uint32_t lcaddr = Gekko->regs.spr[(int)SPR::DMAL] & GEKKO_DMAL_LC_ADDR;
-                    size_t length = ((Gekko->regs.spr[(int)SPR::DMAU] & GEKKO_DMAU_DMA_LEN_U) << GEKKO_DMA_LEN_SHIFT) |
-                        ((Gekko->regs.spr[(int)SPR::DMAL] >> GEKKO_DMA_LEN_SHIFT) & GEKKO_DMAL_DMA_LEN_L);
+                    uint32_t maddr = core->regs.spr[(int)SPR::DMAU] & GEKKO_DMAU_MEM_ADDR;
+                    uint32_t lcaddr = core->regs.spr[(int)SPR::DMAL] & GEKKO_DMAL_LC_ADDR;
+                    size_t length = ((core->regs.spr[(int)SPR::DMAU] & GEKKO_DMAU_DMA_LEN_U) << GEKKO_DMA_LEN_SHIFT) |
+                        ((core->regs.spr[(int)SPR::DMAL] >> GEKKO_DMA_LEN_SHIFT) & GEKKO_DMAL_DMA_LEN_L);
                     if (length == 0) length = 128;
-                    if (Gekko->cache.IsLockedEnable())
+                    if (core->cache.IsLockedEnable())
                     {
-                        Gekko->cache.LockedCacheDma(
-                            (Gekko->regs.spr[(int)SPR::DMAL] & GEKKO_DMAL_DMA_LD) ? true : false,
+                        core->cache.LockedCacheDma(
+                            (core->regs.spr[(int)SPR::DMAL] & GEKKO_DMAL_DMA_LD) ? true : false,
                             maddr,
                             lcaddr,
                             length);
@@ -255,8 +263,8 @@ namespace Gekko
 
                 // It makes no sense to implement such a small Queue. We make all transactions instant.
 
-                Gekko->regs.spr[spr] &= ~(GEKKO_DMAL_DMA_T | GEKKO_DMAL_DMA_F);
-                Gekko->regs.pc += 4;
+                core->regs.spr[spr] &= ~(GEKKO_DMAL_DMA_T | GEKKO_DMAL_DMA_F);
+                core->regs.pc += 4;
                 return;
             }
             break;
@@ -273,17 +281,17 @@ namespace Gekko
             case (int)SPR::GQR6:
             case (int)SPR::GQR7:
             {
-                if (Gekko->regs.spr[spr] != RRS)
+                if (core->regs.spr[spr] != RRS)
                 {
-                    Gekko->jitc->Reset();
+                    core->jitc->Reset();
                 }
             }
             break;
         }
 
         // default
-        Gekko->regs.spr[spr] = RRS;
-        Gekko->regs.pc += 4;
+        core->regs.spr[spr] = RRS;
+        core->regs.pc += 4;
     }
 
     // rd = spr
@@ -295,7 +303,7 @@ namespace Gekko
         switch (spr)
         {
             case (int)SPR::WPAR:
-                value = (Gekko->regs.spr[spr] & ~0x1f) | (Gekko->gatherBuffer.NotEmpty() ? 1 : 0);
+                value = (core->regs.spr[spr] & ~0x1f) | (core->gatherBuffer.NotEmpty() ? 1 : 0);
                 break;
 
             case (int)SPR::HID1:
@@ -303,13 +311,18 @@ namespace Gekko
                 value = 0x8000'0000;
                 break;
 
+            case (int)SPR::DEC:
+                core->SyncTimers();
+                value = core->regs.spr[spr];
+                break;
+
             default:
-                value = Gekko->regs.spr[spr];
+                value = core->regs.spr[spr];
                 break;
         }
 
         RRD = value;
-        Gekko->regs.pc += 4;
+        core->regs.pc += 4;
     }
 
     // rd = tbr
@@ -317,72 +330,74 @@ namespace Gekko
     {
         int tbr = (RB << 5) | RA;
 
+        core->SyncTimers();
+
         if (tbr == 268)
         {
-            RRD = Gekko->regs.tb.Part.l;
+            RRD = core->regs.tb.Part.l;
         }
         else if (tbr == 269)
         {
-            RRD = Gekko->regs.tb.Part.u;
+            RRD = core->regs.tb.Part.u;
         }
 
-        Gekko->regs.pc += 4;
+        core->regs.pc += 4;
     }
 
     // sr[a] = rs
     OP(MTSR)
     {
-        if (Gekko->regs.msr & MSR_PR)
+        if (core->regs.msr & MSR_PR)
         {
-            Gekko->PrCause = PrivilegedCause::Privileged;
-            Gekko->Exception(Exception::PROGRAM);
+            core->PrCause = PrivilegedCause::Privileged;
+            core->Exception(Exception::PROGRAM);
             return;
         }
 
-        Gekko->regs.sr[RA & 0xf] = RRS;
-        Gekko->regs.pc += 4;
+        core->regs.sr[RA & 0xf] = RRS;
+        core->regs.pc += 4;
     }
 
     // sr[rb] = rs
     OP(MTSRIN)
     {
-        if (Gekko->regs.msr & MSR_PR)
+        if (core->regs.msr & MSR_PR)
         {
-            Gekko->PrCause = PrivilegedCause::Privileged;
-            Gekko->Exception(Exception::PROGRAM);
+            core->PrCause = PrivilegedCause::Privileged;
+            core->Exception(Exception::PROGRAM);
             return;
         }
 
-        Gekko->regs.sr[RRB & 0xf] = RRS;
-        Gekko->regs.pc += 4;
+        core->regs.sr[RRB & 0xf] = RRS;
+        core->regs.pc += 4;
     }
 
     // rd = sr[a]
     OP(MFSR)
     {
-        if (Gekko->regs.msr & MSR_PR)
+        if (core->regs.msr & MSR_PR)
         {
-            Gekko->PrCause = PrivilegedCause::Privileged;
-            Gekko->Exception(Exception::PROGRAM);
+            core->PrCause = PrivilegedCause::Privileged;
+            core->Exception(Exception::PROGRAM);
             return;
         }
 
-        RRD = Gekko->regs.sr[RA & 0xf];
-        Gekko->regs.pc += 4;
+        RRD = core->regs.sr[RA & 0xf];
+        core->regs.pc += 4;
     }
 
     // rd = sr[rb]
     OP(MFSRIN)
     {
-        if (Gekko->regs.msr & MSR_PR)
+        if (core->regs.msr & MSR_PR)
         {
-            Gekko->PrCause = PrivilegedCause::Privileged;
-            Gekko->Exception(Exception::PROGRAM);
+            core->PrCause = PrivilegedCause::Privileged;
+            core->Exception(Exception::PROGRAM);
             return;
         }
 
-        RRD = Gekko->regs.sr[RRB & 0xf];
-        Gekko->regs.pc += 4;
+        RRD = core->regs.sr[RRB & 0xf];
+        core->regs.pc += 4;
     }
 
     // ---------------------------------------------------------------------------
@@ -390,30 +405,30 @@ namespace Gekko
 
     OP(EIEIO)
     {
-        Gekko->regs.pc += 4;
+        core->regs.pc += 4;
     }
 
     OP(SYNC)
     {
-        Gekko->regs.pc += 4;
+        core->regs.pc += 4;
     }
 
     // instruction synchronize. Dolwin interpreter is not super-scalar. :)
     OP(ISYNC)
     {
-        Gekko->regs.pc += 4;
+        core->regs.pc += 4;
     }
 
     OP(TLBSYNC)
     {
-        Gekko->regs.pc += 4;
+        core->regs.pc += 4;
     }
 
     OP(TLBIE)
     {
-        Gekko->dtlb.Invalidate(RRB);
-        Gekko->itlb.Invalidate(RRB);
-        Gekko->regs.pc += 4;
+        core->dtlb.Invalidate(RRB);
+        core->itlb.Invalidate(RRB);
+        core->regs.pc += 4;
     }
 
     // ---------------------------------------------------------------------------
@@ -423,36 +438,36 @@ namespace Gekko
     {
         int WIMG;
 
-        if (Gekko->regs.spr[(int)Gekko::SPR::HID0] & HID0_NOOPTI)
+        if (core->regs.spr[(int)Gekko::SPR::HID0] & HID0_NOOPTI)
             return;
 
         uint32_t ea = RA ? RRA + RRB : RRB;
 
-        uint32_t pa = Gekko->EffectiveToPhysical(ea, MmuAccess::Read, WIMG);
+        uint32_t pa = core->EffectiveToPhysical(ea, MmuAccess::Read, WIMG);
         if (pa != Gekko::BadAddress)
         {
-            Gekko->cache.Touch(pa);
+            core->cache.Touch(pa);
         }
-        Gekko->regs.pc += 4;
+        core->regs.pc += 4;
     }
 
     OP(DCBTST)
     {
         int WIMG;
 
-        if (Gekko->regs.spr[(int)Gekko::SPR::HID0] & HID0_NOOPTI)
+        if (core->regs.spr[(int)Gekko::SPR::HID0] & HID0_NOOPTI)
             return;
 
         uint32_t ea = RA ? RRA + RRB : RRB;
 
         // TouchForStore is also made architecturally as a Read operation so that the MMU does not set the "Changed" bit for PTE.
 
-        uint32_t pa = Gekko->EffectiveToPhysical(ea, MmuAccess::Read, WIMG);
+        uint32_t pa = core->EffectiveToPhysical(ea, MmuAccess::Read, WIMG);
         if (pa != Gekko::BadAddress)
         {
-            Gekko->cache.TouchForStore(pa);
+            core->cache.TouchForStore(pa);
         }
-        Gekko->regs.pc += 4;
+        core->regs.pc += 4;
     }
 
     OP(DCBZ)
@@ -460,18 +475,18 @@ namespace Gekko
         int WIMG;
         uint32_t ea = RA ? RRA + RRB : RRB;
 
-        uint32_t pa = Gekko->EffectiveToPhysical(ea, MmuAccess::Write, WIMG);
+        uint32_t pa = core->EffectiveToPhysical(ea, MmuAccess::Write, WIMG);
         if (pa != Gekko::BadAddress)
         {
-            Gekko->cache.Zero(pa);
+            core->cache.Zero(pa);
         }
         else
         {
-            Gekko->regs.spr[(int)Gekko::SPR::DAR] = ea;
-            Gekko->Exception(Exception::DSI);
+            core->regs.spr[(int)Gekko::SPR::DAR] = ea;
+            core->Exception(Exception::DSI);
             return;
         }
-        Gekko->regs.pc += 4;
+        core->regs.pc += 4;
     }
 
     // DCBZ_L is used for the alien Locked Cache address mapping mechanism.
@@ -482,27 +497,27 @@ namespace Gekko
     {
         int WIMG;
 
-        if (!Gekko->cache.IsLockedEnable())
+        if (!core->cache.IsLockedEnable())
         {
-            Gekko->PrCause = PrivilegedCause::IllegalInstruction;
-            Gekko->Exception(Exception::PROGRAM);
+            core->PrCause = PrivilegedCause::IllegalInstruction;
+            core->Exception(Exception::PROGRAM);
             return;
         }
 
         uint32_t ea = RA ? RRA + RRB : RRB;
 
-        uint32_t pa = Gekko->EffectiveToPhysical(ea, MmuAccess::Write, WIMG);
+        uint32_t pa = core->EffectiveToPhysical(ea, MmuAccess::Write, WIMG);
         if (pa != Gekko::BadAddress)
         {
-            Gekko->cache.ZeroLocked(pa);
+            core->cache.ZeroLocked(pa);
         }
         else
         {
-            Gekko->regs.spr[(int)Gekko::SPR::DAR] = ea;
-            Gekko->Exception(Exception::DSI);
+            core->regs.spr[(int)Gekko::SPR::DAR] = ea;
+            core->Exception(Exception::DSI);
             return;
         }
-        Gekko->regs.pc += 4;
+        core->regs.pc += 4;
     }
 
     OP(DCBST)
@@ -510,18 +525,18 @@ namespace Gekko
         int WIMG;
         uint32_t ea = RA ? RRA + RRB : RRB;
 
-        uint32_t pa = Gekko->EffectiveToPhysical(ea, MmuAccess::Read, WIMG);
+        uint32_t pa = core->EffectiveToPhysical(ea, MmuAccess::Read, WIMG);
         if (pa != Gekko::BadAddress)
         {
-            Gekko->cache.Store(pa);
+            core->cache.Store(pa);
         }
         else
         {
-            Gekko->regs.spr[(int)Gekko::SPR::DAR] = ea;
-            Gekko->Exception(Exception::DSI);
+            core->regs.spr[(int)Gekko::SPR::DAR] = ea;
+            core->Exception(Exception::DSI);
             return;
         }
-        Gekko->regs.pc += 4;
+        core->regs.pc += 4;
     }
 
     OP(DCBF)
@@ -529,18 +544,18 @@ namespace Gekko
         int WIMG;
         uint32_t ea = RA ? RRA + RRB : RRB;
 
-        uint32_t pa = Gekko->EffectiveToPhysical(ea, MmuAccess::Read, WIMG);
+        uint32_t pa = core->EffectiveToPhysical(ea, MmuAccess::Read, WIMG);
         if (pa != Gekko::BadAddress)
         {
-            Gekko->cache.Flush(pa);
+            core->cache.Flush(pa);
         }
         else
         {
-            Gekko->regs.spr[(int)Gekko::SPR::DAR] = ea;
-            Gekko->Exception(Exception::DSI);
+            core->regs.spr[(int)Gekko::SPR::DAR] = ea;
+            core->Exception(Exception::DSI);
             return;
         }
-        Gekko->regs.pc += 4;
+        core->regs.pc += 4;
     }
 
     OP(DCBI)
@@ -548,36 +563,44 @@ namespace Gekko
         int WIMG;
         uint32_t ea = RA ? RRA + RRB : RRB;
 
-        if (Gekko->regs.msr & MSR_PR)
+        if (core->regs.msr & MSR_PR)
         {
-            Gekko->PrCause = PrivilegedCause::Privileged;
-            Gekko->Exception(Exception::PROGRAM);
+            core->PrCause = PrivilegedCause::Privileged;
+            core->Exception(Exception::PROGRAM);
             return;
         }
 
-        uint32_t pa = Gekko->EffectiveToPhysical(ea, MmuAccess::Write, WIMG);
+        uint32_t pa = core->EffectiveToPhysical(ea, MmuAccess::Write, WIMG);
         if (pa != Gekko::BadAddress)
         {
-            Gekko->cache.Invalidate(pa);
+            core->cache.Invalidate(pa);
         }
         else
         {
-            Gekko->regs.spr[(int)Gekko::SPR::DAR] = ea;
-            Gekko->Exception(Exception::DSI);
+            core->regs.spr[(int)Gekko::SPR::DAR] = ea;
+            core->Exception(Exception::DSI);
             return;
         }
-        Gekko->regs.pc += 4;
+        core->regs.pc += 4;
     }
     
-    // Used as a hint to JITC so that it can invalidate the compiled code at this address.
+    // Used as a hint to JITC and the cached interpreter so that they can invalidate the code at this address.
 
     OP(ICBI)
     {
         uint32_t address = RA ? RRA + RRB : RRB;
         address &= ~0x1f;
 
-        Gekko->jitc->Invalidate(address, 32);
-        Gekko->regs.pc += 4;
+        core->jitc->Invalidate(address, 32);
+
+        int WIMG;
+        uint32_t pa = core->EffectiveToPhysical(address, MmuAccess::Read, WIMG);
+        if (pa != Gekko::BadAddress)
+        {
+            core->interp->InvalidateCached(pa, 32);
+        }
+
+        core->regs.pc += 4;
     }
 
 }
@@ -6,48 +6,42 @@ namespace Gekko
 {
     // opcode tables
 
-    void (*bx[4])(uint32_t);
-    void (*c_1[64])(uint32_t);
-    void (*c_19[2048])(uint32_t);
-    void (*c_31[2048])(uint32_t);
-    void (*c_59[64])(uint32_t);
-    void (*c_63[2048])(uint32_t);
-    void (*c_4[2048])(uint32_t);
+    void (*bx[4])(GekkoCore* core, uint32_t op);
+    void (*c_1[64])(GekkoCore* core, uint32_t op);
+    void (*c_19[2048])(GekkoCore* core, uint32_t op);
+    void (*c_31[2048])(GekkoCore* core, uint32_t op);
+    void (*c_59[64])(GekkoCore* core, uint32_t op);
+    void (*c_63[2048])(GekkoCore* core, uint32_t op);
+    void (*c_4[2048])(GekkoCore* core, uint32_t op);
 
     // not implemented opcode
     OP(NI)
     {
         DBHalt("** CPU ERROR **\n"
             "unimplemented opcode : %08X <%08X> (%i, %i)\n",
-            Gekko->regs.pc, op, op >> 26, op & 0x7ff);
+            core->regs.pc, op, op >> 26, op & 0x7ff);
 
-        Gekko->PrCause = PrivilegedCause::IllegalInstruction;
-        Gekko->Exception(Exception::PROGRAM);
+        core->PrCause = PrivilegedCause::IllegalInstruction;
+        core->Exception(Exception::PROGRAM);
     }
 
     // switch to extension opcode table
-    OP(OP19) { c_19[op & 0x7ff](op); }
-    OP(OP31) { c_31[op & 0x7ff](op); }
-    OP(OP59) { c_59[op & 0x3f](op); }
-    OP(OP63) { c_63[op & 0x7ff](op); }
-    OP(OP4) { c_4[op & 0x7ff](op); }
+    OP(OP19) { c_19[op & 0x7ff](core, op); }
+    OP(OP31) { c_31[op & 0x7ff](core, op); }
+    OP(OP59) { c_59[op & 0x3f](core, op); }
+    OP(OP63) { c_63[op & 0x7ff](core, op); }
+    OP(OP4) { c_4[op & 0x7ff](core, op); }
 
-    // high level call
+    // high level call (see GekkoCore::AddHleCall)
     OP(HL)
     {
-        // Dolwin module base should be specified as 0x400000 in project properties
-        void (*pcall)() = (void (*)())((void*)(uint64_t)op);
-
-        if (op == 0)
+        if (!core->ExecuteHleCall(op))
         {
             DBHalt(
                 "Something goes wrong in interpreter, \n"
                 "program is trying to execute NULL opcode.\n\n"
-                "pc:%08X", Gekko->regs.pc);
-            return;
+                "pc:%08X", core->regs.pc);
         }
-
-        pcall();
     }
 
     // setup extension tables
@@ -26,6 +26,9 @@ namespace Gekko
 
 	CodeSegment* Jitc::CompileSegment(uint32_t addr)
 	{
+		Debug::PerfTimer timer(Debug::PerfCounter::JitcCompileTime);
+		Debug::PerfAdd(Debug::PerfCounter::JitcCompiles);
+
 		AnalyzeInfo info = { 0 };
 		CodeSegment* segment = new CodeSegment();
 
@@ -67,7 +70,8 @@ namespace Gekko
 			addr += 4;
 			segment->size += 4;
 
-			if (info.flow)
+			// A high level call may change pc (see GekkoCore::ExecuteHleCall)
+			if (info.flow || (instr >> 26) == 0)
 				break;
 		}
 
@@ -127,6 +131,7 @@ namespace Gekko
 
 				delete it->second;
 				it->second = nullptr;
+				Debug::PerfAdd(Debug::PerfCounter::JitcInvalidations);
 			}
 		}
 		segments.clear();
@@ -147,6 +152,7 @@ namespace Gekko
 					{
 						delete it->second;
 						it->second = nullptr;
+						Debug::PerfAdd(Debug::PerfCounter::JitcInvalidations);
 						continue;
 					}
 				}
@@ -157,6 +163,7 @@ namespace Gekko
 					{
 						delete it->second;
 						it->second = nullptr;
+						Debug::PerfAdd(Debug::PerfCounter::JitcInvalidations);
 						continue;
 					}
 				}
@@ -195,9 +202,9 @@ namespace Gekko
 		core->exception = false;
 	}
 
-	bool Jitc::ExecuteInterpeterFallback()
+	bool Jitc::ExecuteInterpeterFallback(GekkoCore* core)
 	{
-		return Gekko->interp->ExecuteInterpeterFallback();
+		return core->interp->ExecuteInterpeterFallback();
 	}
 
 	void Jitc::Reset()
@@ -205,10 +212,11 @@ namespace Gekko
 		InvalidateAll();
 	}
 
-	void Jitc::Tick()
+	void Jitc::Tick(GekkoCore* core)
 	{
-		Gekko->Tick();
-		Gekko->ops++;
+		core->Tick();
+		core->ops++;
+		Debug::PerfAdd(Debug::PerfCounter::GekkoJitcInstructions);
 	}
 
 	void Jitc::CompileInstr(AnalyzeInfo* info, CodeSegment* seg)
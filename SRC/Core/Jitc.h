@@ -43,8 +43,10 @@ namespace Gekko
 		void AddPc(CodeSegment* seg);
 		void CallTick(CodeSegment* seg);
 
-		typedef void(__fastcall* LoadDelegate)(uint32_t addr, uint32_t* reg);
-		typedef void(__fastcall* StoreDelegate)(uint32_t addr, uint32_t* reg);
+		typedef void(__fastcall* LoadDelegate)(uint32_t addr, uint32_t* reg, GekkoCore* core);
+		typedef void(__fastcall* StoreDelegate)(uint32_t addr, uint32_t* reg, GekkoCore* core);
+
+		void CallAccessor(CodeSegment* seg, LoadDelegate proc);
 
 		void FallbackStub(AnalyzeInfo* info, CodeSegment* seg);
 
@@ -70,18 +72,19 @@ namespace Gekko
 		void PSQLoad(AnalyzeInfo* info, CodeSegment* seg);
 
 		// These methods require __fastacall, as they are called from recompiled code.
-
-		static void __fastcall ReadByte(uint32_t addr, uint32_t* reg) { Gekko->ReadByte(addr, reg); }
-		static void __fastcall WriteByte(uint32_t addr, uint32_t data) { Gekko->WriteByte(addr, data); }
-		static void __fastcall ReadHalf(uint32_t addr, uint32_t* reg) { Gekko->ReadHalf(addr, reg); }
-		static void __fastcall WriteHalf(uint32_t addr, uint32_t data) { Gekko->WriteHalf(addr, data); }
-		static void __fastcall ReadWord(uint32_t addr, uint32_t* reg) { Gekko->ReadWord(addr, reg); }
-		static void __fastcall WriteWord(uint32_t addr, uint32_t data) { Gekko->WriteWord(addr, data); }
-		static void __fastcall ReadDouble(uint32_t addr, uint64_t* reg) { Gekko->ReadDouble(addr, reg); }
-		static void __fastcall WriteDouble(uint32_t addr, uint64_t* data) { Gekko->WriteDouble(addr, data); }
-
-		static bool ExecuteInterpeterFallback();
-		static void Tick();
+		// The parent core is passed by the recompiled code as the last argument, so that several cores can coexist.
+
+		static void __fastcall ReadByte(uint32_t addr, uint32_t* reg, GekkoCore* core) { core->ReadByte(addr, reg); }
+		static void __fastcall WriteByte(uint32_t addr, uint32_t data, GekkoCore* core) { core->WriteByte(addr, data); }
+		static void __fastcall ReadHalf(uint32_t addr, uint32_t* reg, GekkoCore* core) { core->ReadHalf(addr, reg); }
+		static void __fastcall WriteHalf(uint32_t addr, uint32_t data, GekkoCore* core) { core->WriteHalf(addr, data); }
+		static void __fastcall ReadWord(uint32_t addr, uint32_t* reg, GekkoCore* core) { core->ReadWord(addr, reg); }
+		static void __fastcall WriteWord(uint32_t addr, uint32_t data, GekkoCore* core) { core->WriteWord(addr, data); }
+		static void __fastcall ReadDouble(uint32_t addr, uint64_t* reg, GekkoCore* core) { core->ReadDouble(addr, reg); }
+		static void __fastcall WriteDouble(uint32_t addr, uint64_t* data, GekkoCore* core) { core->WriteDouble(addr, data); }
+
+		static bool ExecuteInterpeterFallback(GekkoCore* core);
+		static void Tick(GekkoCore* core);
 
 		// This segment is not involved in invalidation, so as not to disrupt the code.
 		CodeSegment* currentSegment = nullptr;
@@ -78,15 +78,36 @@ namespace Gekko
 	{
 		// Call core->Tick
 
-		//0:  48 b8 cd ab 78 56 34    movabs rax,0x12345678abcd
+		//0:  48 b9 cd ab 78 56 34    movabs rcx,0x12345678abcd  (core)
 		//7:  12 00 00
-		//17: ff d0                   call   rax
+		//a:  48 b8 cd ab 78 56 34    movabs rax,0x12345678abcd
+		//11: 12 00 00
+		//14: ff d0                   call   rax
 
 		uint64_t fnPtr = (uint64_t)Jitc::Tick;
 
+		seg->Write16(0xb948);
+		seg->Write64((uint64_t)core);
 		seg->Write16(0xb848);
 		seg->Write64(fnPtr);
 		seg->Write16(0xd0ff);
 	}
 
+	void Jitc::CallAccessor(CodeSegment* seg, LoadDelegate proc)
+	{
+		// Call memory accessor. ecx/rdx are already loaded by the caller, the core goes in r8.
+
+		//0:  49 b8 cd ab 78 56 34    movabs r8,0x12345678abcd  (core)
+		//7:  12 00 00
+		//a:  48 b8 cd ab 78 56 34    movabs rax,0x12345678abcd
+		//11: 12 00 00
+		//14: ff d0                   call   rax
+
+		seg->Write16(0xb849);
+		seg->Write64((uint64_t)core);
+		seg->Write16(0xb848);
+		seg->Write64((uint64_t)proc);
+		seg->Write16(0xd0ff);
+	}
+
 }
@@ -9,12 +9,16 @@ namespace Gekko
 
 		// Call ExecuteInterpeterFallback
 
-		//0:  48 b8 cd ab 78 56 34    movabs rax,0x12345678abcd  (ExecuteInterpeterFallback)
+		//0:  48 b9 cd ab 78 56 34    movabs rcx,0x12345678abcd  (core)
 		//7:  12 00 00
-		//17: ff d0                   call   rax
+		//a:  48 b8 cd ab 78 56 34    movabs rax,0x12345678abcd  (ExecuteInterpeterFallback)
+		//11: 12 00 00
+		//14: ff d0                   call   rax
 
 		uint64_t fnPtr = (uint64_t)Jitc::ExecuteInterpeterFallback;
 
+		seg->Write16(0xb948);
+		seg->Write64((uint64_t)core);
 		seg->Write16(0xb848);
 		seg->Write64(fnPtr);
 		seg->Write16(0xd0ff);
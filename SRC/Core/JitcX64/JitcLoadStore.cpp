@@ -9,6 +9,7 @@ namespace Gekko
 		// if (RA)
 		//		add		ecx, dword ptr [rsi + 4 *ra]
 		// lea rdx, [rsi + 4 * rd]
+		// mov r8, core
 		// mov rax, Jitc::ReadByte
 		// call rax
 		// mov rax, offset GekkoCore->exception
@@ -44,9 +45,7 @@ namespace Gekko
 		seg->Write16(0x568d);
 		seg->Write8(info->paramBits[0] << 2);
 
-		seg->Write16(0xb848);
-		seg->Write64((uint64_t)loadProc);
-		seg->Write16(0xd0ff);
+		CallAccessor(seg, loadProc);
 
 		// if (exception) return;
 
@@ -13,8 +13,8 @@ namespace Gekko
 	#define ST_SCALE(n) ((core->regs.spr[(int)SPR::GQRs + n] >>  8) & 0x3f)
 	#define ST_TYPE(n)  (GEKKO_QUANT_TYPE)((core->regs.spr[(int)SPR::GQRs + n]      ) & 7)
 
-	#define PS0(n)  (core->regs.fpr[n].dbl)
-	#define PS1(n)  (core->regs.ps1[n].dbl)
+	#define PS0(n)  (core->regs.fpr[n].ps0.dbl)
+	#define PS1(n)  (core->regs.fpr[n].ps1.dbl)
 
 	void Jitc::Dequantize(CodeSegment* seg, void *psReg, GEKKO_QUANT_TYPE type, uint8_t scale, bool secondReg)
 	{
@@ -60,9 +60,7 @@ namespace Gekko
 
 				// ReadByte (ecx, &temp);
 				
-				seg->Write16(0xb848);
-				seg->Write64((uint64_t)Jitc::ReadByte);
-				seg->Write16(0xd0ff);
+				CallAccessor(seg, Jitc::ReadByte);
 
 				// flt = (float)(uint8_t)temp;
 
@@ -86,9 +84,7 @@ namespace Gekko
 
 				// ReadByte (ecx, &temp);
 
-				seg->Write16(0xb848);
-				seg->Write64((uint64_t)Jitc::ReadByte);
-				seg->Write16(0xd0ff);
+				CallAccessor(seg, Jitc::ReadByte);
 
 				// flt = (float)(int8_t)temp;
 
@@ -112,9 +108,7 @@ namespace Gekko
 
 				// ReadHalf (ecx, &temp);
 
-				seg->Write16(0xb848);
-				seg->Write64((uint64_t)Jitc::ReadHalf);
-				seg->Write16(0xd0ff);
+				CallAccessor(seg, Jitc::ReadHalf);
 
 				// flt = (float)(uint16_t)temp;
 
@@ -138,9 +132,7 @@ namespace Gekko
 
 				// ReadHalf (ecx, &temp);
 
-				seg->Write16(0xb848);
-				seg->Write64((uint64_t)Jitc::ReadHalf);
-				seg->Write16(0xd0ff);
+				CallAccessor(seg, Jitc::ReadHalf);
 
 				// flt = (float)(int16_t)temp;
 
@@ -158,9 +150,7 @@ namespace Gekko
 
 				// ReadWord (ecx, &temp);
 
-				seg->Write16(0xb848);
-				seg->Write64((uint64_t)Jitc::ReadWord);
-				seg->Write16(0xd0ff);
+				CallAccessor(seg, Jitc::ReadWord);
 
 				// mov rdx, offset temp
 				seg->Write16(0xba48);
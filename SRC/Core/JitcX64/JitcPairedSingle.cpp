@@ -5,8 +5,8 @@
 
 namespace Gekko
 {
-    #define PS0(n)  (core->regs.fpr[n].dbl)
-    #define PS1(n)  (core->regs.ps1[n].dbl)
+    #define PS0(n)  (core->regs.fpr[n].ps0.dbl)
+    #define PS1(n)  (core->regs.fpr[n].ps1.dbl)
 	
     void Jitc::PsAdd(AnalyzeInfo* info, CodeSegment* seg)
     {
@@ -8,6 +8,8 @@ namespace Gekko
     // Centralized hub which attracts all memory access requests from the interpreter or recompiler 
     // (as well as those who they pretend, for example HLE or Debugger).
 
+    // The RAM pages written for the snapshots are marked by MIWrite*, not here: a cached store reaches RAM later, by the cache cast-out.
+
     void __fastcall GekkoCore::ReadByte(uint32_t addr, uint32_t *reg)
     {
         int WIMG;
@@ -49,11 +51,11 @@ namespace Gekko
             return;
         }
     
-        if (Gekko::Gekko->regs.spr[(int)Gekko::SPR::HID2] & HID2_WPE)
+        if (regs.spr[(int)SPR::HID2] & HID2_WPE)
         {
-            if ((pa & ~0x1f) == (Gekko::Gekko->regs.spr[(int)Gekko::SPR::WPAR] & ~0x1f))
+            if ((pa & ~0x1f) == (regs.spr[(int)SPR::WPAR] & ~0x1f))
             {
-                Gekko::Gekko->gatherBuffer.Write8((uint8_t)data);
+                gatherBuffer.Write8((uint8_t)data);
                 return;
             }
         }
@@ -121,11 +123,11 @@ namespace Gekko
             return;
         }
 
-        if (Gekko::Gekko->regs.spr[(int)Gekko::SPR::HID2] & HID2_WPE)
+        if (regs.spr[(int)SPR::HID2] & HID2_WPE)
         {
-            if ((pa & ~0x1f) == (Gekko::Gekko->regs.spr[(int)Gekko::SPR::WPAR] & ~0x1f))
+            if ((pa & ~0x1f) == (regs.spr[(int)SPR::WPAR] & ~0x1f))
             {
-                Gekko::Gekko->gatherBuffer.Write16((uint16_t)data);
+                gatherBuffer.Write16((uint16_t)data);
                 return;
             }
         }
@@ -187,11 +189,11 @@ namespace Gekko
             return;
         }
 
-        if (Gekko::Gekko->regs.spr[(int)Gekko::SPR::HID2] & HID2_WPE)
+        if (regs.spr[(int)SPR::HID2] & HID2_WPE)
         {
-            if ((pa & ~0x1f) == (Gekko::Gekko->regs.spr[(int)Gekko::SPR::WPAR] & ~0x1f))
+            if ((pa & ~0x1f) == (regs.spr[(int)SPR::WPAR] & ~0x1f))
             {
-                Gekko::Gekko->gatherBuffer.Write32(data);
+                gatherBuffer.Write32(data);
                 return;
             }
         }
@@ -255,11 +257,11 @@ namespace Gekko
             return;
         }
 
-        if (Gekko::Gekko->regs.spr[(int)Gekko::SPR::HID2] & HID2_WPE)
+        if (regs.spr[(int)SPR::HID2] & HID2_WPE)
         {
-            if ((pa & ~0x1f) == (Gekko::Gekko->regs.spr[(int)Gekko::SPR::WPAR] & ~0x1f))
+            if ((pa & ~0x1f) == (regs.spr[(int)SPR::WPAR] & ~0x1f))
             {
-                Gekko::Gekko->gatherBuffer.Write64(*data);
+                gatherBuffer.Write64(*data);
                 return;
             }
         }
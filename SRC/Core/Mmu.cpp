@@ -46,9 +46,12 @@ namespace Gekko
 
         if (tlb->Exists(ea, pa, WIMG))
         {
+            Debug::PerfAdd(Debug::PerfCounter::TlbHits);
             return pa;
         }
 
+        Debug::PerfAdd(Debug::PerfCounter::TlbMisses);
+
         // First, try the block translation, if it doesnt work, try the Page Table.
 
         if (!BlockAddressTranslation(ea, pa, type, WIMG))
@@ -10,6 +10,7 @@
 
 #include "../Common/Spinlock.h"
 #include "../Common/Jdi.h"
+#include "../Common/PerfCounters.h"
 
 #include "Gekko.h"
 #include "GekkoAnalyzer.h"
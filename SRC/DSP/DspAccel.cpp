@@ -25,13 +25,13 @@ namespace DSP
 				// Refresh pred/scale
 				if ((Accel.CurrAddress.addr & 0xF) == 0 && ((Accel.Fmt >> 2) & 3) == 0)
 				{
-					Accel.AdpcmPds = *(uint8_t*)(aram.mem + (Accel.CurrAddress.addr & 0x07ff'ffff) / 2);
+					Accel.AdpcmPds = *(uint8_t*)(aram->mem + (Accel.CurrAddress.addr & 0x07ff'ffff) / 2);
 					Accel.CurrAddress.addr += 2;
 				}
 
 				// TODO: Check currAddr == endAddr after Pred/Scale update.
 
-				tempByte = *(uint8_t*)(aram.mem + (Accel.CurrAddress.addr & 0x07ff'ffff) / 2);
+				tempByte = *(uint8_t*)(aram->mem + (Accel.CurrAddress.addr & 0x07ff'ffff) / 2);
 				if ((Accel.CurrAddress.addr & 1) == 0)
 				{
 					val = tempByte >> 4;		// High nibble
@@ -43,11 +43,11 @@ namespace DSP
 				break;
 
 			case 1:
-				val = *(uint8_t*)(aram.mem + (Accel.CurrAddress.addr & 0x07ff'ffff));
+				val = *(uint8_t*)(aram->mem + (Accel.CurrAddress.addr & 0x07ff'ffff));
 				break;
 
 			case 2:
-				val = _byteswap_ushort(*(uint16_t*)(aram.mem + 2 * (uint64_t)(Accel.CurrAddress.addr & 0x07ff'ffff)));
+				val = _byteswap_ushort(*(uint16_t*)(aram->mem + 2 * (uint64_t)(Accel.CurrAddress.addr & 0x07ff'ffff)));
 				break;
 
 			default:
@@ -87,6 +87,40 @@ namespace DSP
 			DBHalt("DSP: Accelerator is not configured to read\n");
 		}
 
+		// 4-bit ADPCM fast path: take the next sample decoded ahead
+		if (!raw && (Accel.Fmt & 0xF) == 0 && ((Accel.Fmt >> 4) & 3) != 3)
+		{
+			if (Accel.aheadPtr >= Accel.aheadCount)
+			{
+				DecodeAdpcmAhead();
+			}
+
+			auto& sample = Accel.ahead[Accel.aheadPtr++];
+
+			Accel.AdpcmPds = sample.pds;
+			Accel.AdpcmYn1 = sample.yn1;
+			Accel.AdpcmYn2 = sample.yn2;
+			Accel.CurrAddress.addr = sample.addr;
+
+			if (sample.overflow)
+			{
+				if (logAccel)
+				{
+					DBReport2(DbgChannel::DSP, "Accelerator Overflow while read\n");
+				}
+
+				if (regs.sr.ge && regs.sr.acie)
+				{
+					Accel.pendingOverflow = true;
+					Accel.overflowVector = ((Accel.Fmt >> 3) & 3) == 0 ? DspException::ADP_OVF : DspException::ACR_OVF;
+				}
+			}
+
+			return sample.out;
+		}
+
+		AccelInvalidate();
+
 		val = AccelFetch();
 
 		// Issue ADPCM Decoder
@@ -108,9 +142,12 @@ namespace DSP
 			DBHalt("DSP: Accelerator is not configured to write\n");
 		}
 
+		AccelInvalidate();
+
 		// Write mode is always 16-bit
 
-		*(uint16_t*)(aram.mem + 2 * (uint64_t)(Accel.CurrAddress.addr & 0x07ff'ffff)) = _byteswap_ushort(data);
+		*(uint16_t*)(aram->mem + 2 * (uint64_t)(Accel.CurrAddress.addr & 0x07ff'ffff)) = _byteswap_ushort(data);
+		aram->dirty.Mark(2 * (size_t)(Accel.CurrAddress.addr & 0x07ff'ffff), sizeof(uint16_t));
 		Accel.CurrAddress.addr++;
 
 		if ((Accel.CurrAddress.addr & 0x07ff'ffff) >= (Accel.EndAddress.addr & 0x07FF'FFFF))
@@ -133,6 +170,7 @@ namespace DSP
 	void DspCore::ResetAccel()
 	{
 		Accel.pendingOverflow = false;
+		AccelInvalidate();
 	}
 
 }
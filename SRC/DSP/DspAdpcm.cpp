@@ -64,4 +64,87 @@ namespace DSP
 
 		return (uint16_t)out;
 	}
+
+	// Decode 4-bit ADPCM samples starting from the current accelerator address up to the end of the current 8-byte frame
+	// (or up to the end address wrap), in the same way as AccelFetch + DecodeAdpcm would do it sample by sample.
+	// The accelerator registers are not touched, AccelReadData applies the saved state when the sample is consumed.
+
+	void DspCore::DecodeAdpcmAhead()
+	{
+		uint32_t addr = Accel.CurrAddress.addr;
+		uint32_t endAddr = Accel.EndAddress.addr & 0x07ff'ffff;
+		int outputMode = (Accel.Fmt >> 4) & 3;
+		uint16_t pds = Accel.AdpcmPds;
+		int32_t yn1 = (int16_t)Accel.AdpcmYn1;
+		int32_t yn2 = (int16_t)Accel.AdpcmYn2;
+		int32_t coef1 = 0, coef2 = 0, gain = 0;
+		bool refresh = true;
+		int count = 0;
+
+		while (count < (int)_countof(Accel.ahead))
+		{
+			// Refresh pred/scale at the frame start
+			if ((addr & 0xF) == 0)
+			{
+				pds = aram->mem[(addr & 0x07ff'ffff) / 2];
+				addr += 2;
+				refresh = true;
+			}
+
+			if (refresh)
+			{
+				int pred = (pds >> 4) & 7;
+				coef1 = (int16_t)Accel.AdpcmCoef[2 * pred];
+				coef2 = (int16_t)Accel.AdpcmCoef[2 * pred + 1];
+				gain = (int16_t)(1 << (pds & 0xf));
+				refresh = false;
+			}
+
+			uint8_t byte = aram->mem[(addr & 0x07ff'ffff) / 2];
+			int nibble = (addr & 1) == 0 ? byte >> 4 : byte & 0xf;
+			addr++;
+
+			// Each product fits in 32 bits, only the sum needs 64
+			int32_t xn = ((nibble ^ 8) - 8) << 11;
+			int64_t yn = (int64_t)(yn1 * coef1) + (int64_t)(yn2 * coef2) + (int64_t)(xn * gain);
+
+			yn2 = yn1;
+			yn1 = (int16_t)(yn >> 11);
+
+			auto& sample = Accel.ahead[count++];
+
+			switch (outputMode)
+			{
+				case 0:
+					sample.out = (uint16_t)max(-0x8000, min(yn >> 11, 0x7FFF));
+					break;
+				case 1:
+					sample.out = (uint16_t)yn;
+					break;
+				case 2:
+					sample.out = (uint16_t)(yn >> 16);
+					break;
+			}
+
+			sample.pds = pds;
+			sample.yn1 = (uint16_t)yn1;
+			sample.yn2 = (uint16_t)yn2;
+			sample.overflow = (addr & 0x07ff'ffff) >= endAddr;
+
+			if (sample.overflow)
+			{
+				addr = Accel.StartAddress.addr;
+			}
+
+			sample.addr = addr;
+
+			if (sample.overflow || (addr & 0xF) == 0)
+			{
+				break;
+			}
+		}
+
+		Accel.aheadCount = count;
+		Accel.aheadPtr = 0;
+	}
 }
@@ -60,11 +60,23 @@ namespace DSP
 
 		while (true)
 		{
+			core->dspThread->ParkPoint();
+
 			// Do DSP actions
 			core->Update();
 		}
 	}
 
+	void DspCore::Park()
+	{
+		dspThread->Park();
+	}
+
+	void DspCore::Unpark()
+	{
+		dspThread->Unpark();
+	}
+
 	void DspCore::Exception(DspException id)
 	{
 		if (logDspInterrupts)
@@ -216,10 +228,53 @@ namespace DSP
 			}
 
 			interp->ExecuteInstr();
+			Debug::PerfAdd(Debug::PerfCounter::DspInstructions);
 			savedGekkoTicks = ticks;
 		}
 	}
 
+	void DspCore::DoState(StateStream& state)
+	{
+		bool running = IsRunning();
+
+		state.BeginSection('DSP ', 1);
+
+		state.Do(regs.ar);
+		state.Do(regs.ix);
+		state.Do(regs.lm);
+		for (int i = 0; i < _countof(regs.st); i++)
+		{
+			state.Do(regs.st[i]);
+		}
+		state.Do(regs.ac);
+		state.Do(regs.ax);
+		state.Do(regs.prod);
+		state.Do(regs.bank);
+		state.Do(regs.sr);
+		state.Do(regs.pc);
+
+		state.Do(iram);
+		state.Do(dram);
+
+		state.Do(DspToCpuMailbox);
+		state.Do(CpuToDspMailbox);
+		state.Do(DmaRegs);
+		state.Do(Accel);
+
+		state.Do(pendingInterrupt);
+		state.Do(pendingInterruptDelay);
+		state.Do(pendingSoftReset);
+		state.Do(savedGekkoTicks);
+		state.Do(running);
+
+		state.EndSection();
+
+		if (state.IsLoading() && !state.Failed())
+		{
+			running ? Run() : Suspend();
+		}
+	}
+
 	#pragma region "Debug"
 
 	void DspCore::AddBreakpoint(DspAddress imemAddress)
@@ -331,7 +386,7 @@ namespace DSP
 		auto it = canaries.find(imemAddress);
 		if (it != canaries.end())
 		{
-			DBReport2(DbgChannel::DSP, it->second.c_str());
+			DBReport2(DbgChannel::DSP, "%s", it->second.c_str());
 			canariesSpinLock.Unlock();
 			return true;
 		}
@@ -785,6 +840,13 @@ namespace DSP
 	{
 		if (addr >= IFX_START_ADDRESS)
 		{
+			// Any write to the accelerator or decoder registers drops the samples decoded ahead
+			if ((addr >= (DspAddress)DspHardwareRegs::ADPCM_A00 && addr <= (DspAddress)DspHardwareRegs::ADPCM_A71) ||
+				(addr >= (DspAddress)DspHardwareRegs::ACFMT && addr <= (DspAddress)DspHardwareRegs::ACGAN))
+			{
+				AccelInvalidate();
+			}
+
 			switch (addr)
 			{
 				case (DspAddress)DspHardwareRegs::DSMAH:
@@ -1092,15 +1154,16 @@ namespace DSP
 			return;
 		}
 
-		if (DmaRegs.mmemAddr.bits < mi.ramSize)
+		if (DmaRegs.mmemAddr.bits < mi->ramSize)
 		{
 			if (DmaRegs.control.Dsp2Mmem)
 			{
-				memcpy(&mi.ram[DmaRegs.mmemAddr.bits], ptr, DmaRegs.blockSize);
+				memcpy(&mi->ram[DmaRegs.mmemAddr.bits], ptr, DmaRegs.blockSize);
+				mi->dirty.Mark(DmaRegs.mmemAddr.bits, DmaRegs.blockSize);
 			}
 			else
 			{
-				memcpy(ptr, &mi.ram[DmaRegs.mmemAddr.bits], DmaRegs.blockSize);
+				memcpy(ptr, &mi->ram[DmaRegs.mmemAddr.bits], DmaRegs.blockSize);
 			}
 		}
 
@@ -8,6 +8,7 @@
 #include <string>
 #include <atomic>
 #include "../Common/Thread.h"
+#include "../Common/StateStream.h"
 
 namespace DSP
 {
@@ -315,6 +316,20 @@ namespace DSP
 			
 			bool pendingOverflow;
 			DspException overflowVector;
+
+			// 4-bit ADPCM samples decoded ahead up to the end of the current frame.
+			// Each entry keeps the decoder registers as they must look after the sample is read by the DSP.
+			struct
+			{
+				uint16_t out;
+				uint16_t yn1;
+				uint16_t yn2;
+				uint16_t pds;
+				uint32_t addr;				// CurrAddress after fetch
+				bool overflow;				// Wrapped to StartAddress after this sample
+			} ahead[16];
+			int aheadCount;
+			int aheadPtr;
 		} Accel;
 
 		void ResetIfx();
@@ -323,7 +338,9 @@ namespace DSP
 		uint16_t AccelFetch();
 		void AccelWriteData(uint16_t data);
 		void ResetAccel();
+		void AccelInvalidate() { Accel.aheadCount = Accel.aheadPtr = 0; }
 		uint16_t DecodeAdpcm(uint16_t nibble);
+		void DecodeAdpcmAhead();
 
 		bool pendingInterrupt = false;
 		int pendingInterruptDelay = 2;
@@ -372,8 +389,15 @@ namespace DSP
 		bool IsRunning() { return dspThread->IsRunning(); }
 		void Suspend();
 
+		// Stop the DSP thread between updates, while the state is saved or loaded
+		void Park();
+		void Unpark();
+
 		void Update();
 
+		// Registers, memories and the interface state. On load the DSP is resumed or halted as saved.
+		void DoState(StateStream& state);
+
 		// Debug methods
 
 		void AddBreakpoint(DspAddress imemAddress);
@@ -9,6 +9,7 @@
 #include "../Common/Spinlock.h"
 #include "../Common/Json.h"
 #include "../Common/Jdi.h"
+#include "../Common/PerfCounters.h"
 
 #include "../Core/Gekko.h"				// For TimeBase
 #include "../Hardware/Hardware.h"
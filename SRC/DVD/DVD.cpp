@@ -2,7 +2,7 @@
 #include "pch.h"
 #include "../UI/UserFile.h"
 
-DVDControl dvd;
+InstanceRef<DVDControl, &Instance::dvd> dvd;
 
 namespace DVD
 {
@@ -53,24 +53,24 @@ namespace DVD
     {
         Unmount();
 
-        dvd.mountedSdk = new MountDolphinSdk(path);
-        assert(dvd.mountedSdk);
-        if (!dvd.mountedSdk->Mounted())
+        dvd->mountedSdk = new MountDolphinSdk(path);
+        assert(dvd->mountedSdk);
+        if (!dvd->mountedSdk->Mounted())
         {
-            delete dvd.mountedSdk;
-            dvd.mountedSdk = nullptr;
+            delete dvd->mountedSdk;
+            dvd->mountedSdk = nullptr;
             return false;
         }
 
         // init filesystem
         if (!dvd_fs_init())
         {
-            delete dvd.mountedSdk;
-            dvd.mountedSdk = nullptr;
+            delete dvd->mountedSdk;
+            dvd->mountedSdk = nullptr;
             return false;
         }
 
-        dvd.mountedSdk->Seek(0);
+        dvd->mountedSdk->Seek(0);
 
         return true;
     }
@@ -93,41 +93,41 @@ namespace DVD
     {
         GCMMountFile(nullptr);
 
-        if (dvd.mountedSdk)
+        if (dvd->mountedSdk)
         {
-            delete dvd.mountedSdk;
-            dvd.mountedSdk = nullptr;
+            delete dvd->mountedSdk;
+            dvd->mountedSdk = nullptr;
         }
     }
 
     bool IsMounted()
     {
-        return (dvd.mountedImage || dvd.mountedSdk != nullptr);
+        return (dvd->mountedImage || dvd->mountedSdk != nullptr);
     }
 
     // dvd operations on current mounted dvd
 
     void Seek(int position)
     {
-        if (dvd.mountedImage)
+        if (dvd->mountedImage)
         {
             GCMSeek(position);
         }
-        else if (dvd.mountedSdk)
+        else if (dvd->mountedSdk)
         {
-            dvd.mountedSdk->Seek(position);
+            dvd->mountedSdk->Seek(position);
         }
     }
 
     int GetSeek()
     {
-        if (dvd.mountedImage)
+        if (dvd->mountedImage)
         {
-            return dvd.seekval;
+            return dvd->seekval;
         }
-        else if (dvd.mountedSdk)
+        else if (dvd->mountedSdk)
         {
-            return dvd.mountedSdk->GetSeek();
+            return dvd->mountedSdk->GetSeek();
         }
         else return 0;
     }
@@ -137,13 +137,13 @@ namespace DVD
         if (length == 0)
             return true;
 
-        if (dvd.mountedImage)
+        if (dvd->mountedImage)
         {
             return GCMRead((uint8_t*)buffer, length);
         }
-        else if (dvd.mountedSdk)
+        else if (dvd->mountedSdk)
         {
-            return dvd.mountedSdk->Read((uint8_t*)buffer, length);
+            return dvd->mountedSdk->Read((uint8_t*)buffer, length);
         }
         else
         {
@@ -155,7 +155,7 @@ namespace DVD
 
     long OpenFile(std::string_view dvdfile)
     {
-        if (dvd.mountedImage || dvd.mountedSdk)
+        if (dvd->mountedImage || dvd->mountedSdk)
         {
             // call DVD filesystem open
             return dvd_open(dvdfile.data());
@@ -170,16 +170,11 @@ namespace DVD
     void InitSubsystem()
     {
         Debug::Hub.AddNode(DDU_JDI_JSON, DvdCommandsReflector);
-
-        DDU = new DduCore;
-        assert(DDU);
     }
 
     void ShutdownSubsystem()
     {
-        Unmount();
         Debug::Hub.RemoveNode(DDU_JDI_JSON);
-        delete DDU;
     }
 
 }
@@ -3,6 +3,8 @@
 #pragma once
 
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 // DVD interface
 
@@ -49,9 +51,21 @@ struct DVDControl
     int   seekval;        // current DVD position
 
     DVD::MountDolphinSdk* mountedSdk;
+
+    // filesystem
+    DVDBB2      bb2;
+    DVDFileEntry* FstStart;         // Loaded FST (byte-swapped as little-endian)
+    uint32_t    fstSize;            // Size of loaded FST in bytes (not greater DVD_FST_MAX_SIZE)
+    char*       FstStringStart;     // Strings(name) table
+
+    // FST index, built once by dvd_fs_init. Names are stored lower-cased, since the DVD library compares them case-insensitive.
+    std::unordered_map<std::string, int> FstPathIndex;      // Full path ("/dir/file") -> entry
+    std::vector<std::unordered_map<std::string, int>> FstDirChilds;     // Child name -> entry, per directory
+    std::vector<int> FstDirSlot;    // Entry -> FstDirChilds slot (-1 for files)
+    bool        FstIndexValid;      // false: FST has case-colliding names, use the original walk
 };
 
-extern DVDControl dvd;             // share with other modules
+extern InstanceRef<DVDControl, &Instance::dvd> dvd;             // share with other modules
 
 // DDU Core
 #include "DduCore.h"
@@ -22,21 +22,21 @@ namespace DVD
 		Json::Value* output = new Json::Value();
 		output->type = Json::ValueType::Array;
 
-		if (dvd.mountedImage)
+		if (dvd->mountedImage)
 		{
-			DBReport("Mounted as disk image: %s\n", Debug::Hub.TcharToString(dvd.gcm_filename).c_str());
-			DBReport("GCM Size: 0x%08X bytes\n", dvd.gcm_size);
+			DBReport("Mounted as disk image: %s\n", Debug::Hub.TcharToString(dvd->gcm_filename).c_str());
+			DBReport("GCM Size: 0x%08X bytes\n", dvd->gcm_size);
 			DBReport("Current seek position: 0x%08X\n", GetSeek());
 
-			output->AddString(nullptr, dvd.gcm_filename);
+			output->AddString(nullptr, dvd->gcm_filename);
 			output->AddInt(nullptr, GetSeek());
 		}
-		else if (dvd.mountedSdk != nullptr)
+		else if (dvd->mountedSdk != nullptr)
 		{
-			DBReport("Mounted as SDK directory: %s\n", Debug::Hub.TcharToString(dvd.mountedSdk->GetDirectory()).c_str());
+			DBReport("Mounted as SDK directory: %s\n", Debug::Hub.TcharToString(dvd->mountedSdk->GetDirectory()).c_str());
 			DBReport("Current seek position: 0x%08X\n", GetSeek());
 
-			output->AddString(nullptr, dvd.mountedSdk->GetDirectory());
+			output->AddString(nullptr, dvd->mountedSdk->GetDirectory());
 			output->AddInt(nullptr, GetSeek());
 		}
 		else
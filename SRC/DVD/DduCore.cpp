@@ -2,7 +2,7 @@
 
 namespace DVD
 {
-	DduCore * DDU;
+	InstanceRef<DduCore, &Instance::ddu> DDU;
 
 	DduCore::DduCore()
 	{
@@ -153,15 +153,12 @@ namespace DVD
 							(commandBuffer[11]);
 
 						SetDvdAudioSampleRate(sampleRate);
-						DvdAudioInitDecoder();
+						DvdAudioInitDecoder(&adpcmState);
 						streamEnabledByDduCommand = true;
 
 						// Invalidate streaming cache
 						streamingCachePtr = streamCacheSize;
 
-						// Invalidate PCM buffer
-						pcmPlaybackCounter = sizeof(pcmPlaybackBuffer);
-
 						if (log)
 						{
 							DBReport2(DbgChannel::DVD, "DVD Streaming setup: stream start 0x%08X, counter: %i\n",
@@ -170,7 +167,7 @@ namespace DVD
 					}
 					else
 					{
-						DvdAudioInitDecoder();
+						DvdAudioInitDecoder(&adpcmState);
 
 						if (log)
 						{
@@ -251,6 +248,8 @@ namespace DVD
 
 		while (true)
 		{
+			core->dduThread->ParkPoint();
+
 			// Wait Gekko ticks
 			if (!core->transferRateNoLimit)
 			{
@@ -268,6 +267,9 @@ namespace DVD
 			// Until break or transfer completed
 			while (core->ddBusBusy)
 			{
+				// Without the rate limit the whole transfer is done here, the thread is parked between the bytes
+				core->dduThread->ParkPoint();
+
 				if (core->busDir == DduBusDirection::HostToDdu)
 				{
 					switch (core->state)
@@ -304,6 +306,7 @@ namespace DVD
 								Seek(core->seekVal);
 								size_t bytes = min(dataCacheSize, core->transactionSize);
 								bool readResult = Read(core->dataCache, bytes);
+								Debug::PerfAdd(Debug::PerfCounter::DvdBytes, bytes);
 								core->seekVal += (uint32_t)bytes;
 								core->transactionSize -= bytes;
 
@@ -355,6 +358,18 @@ namespace DVD
 		}
 	}
 
+	void DduCore::Park()
+	{
+		dduThread->Park();
+		dvdAudioThread->Park();
+	}
+
+	void DduCore::Unpark()
+	{
+		dduThread->Unpark();
+		dvdAudioThread->Unpark();
+	}
+
 	// Enabling AISCLK forces the DDU to issue samples out even if there are none (zeros goes to output).
 	void DduCore::EnableAudioStreamClock(bool enable)
 	{
@@ -370,20 +385,22 @@ namespace DVD
 
 	void DduCore::DvdAudioThreadProc(void* Parameter)
 	{
-		uint16_t sample[2] = { 0, 0 };
 		DduCore* core = (DduCore*)Parameter;
 
 		while (true)
 		{
+			core->dvdAudioThread->ParkPoint();
+
 			// If AISCLK is enabled but streaming is not enabled by the DDU command, DVD Audio will output only zeros.
 
-			// If its time to send sample
+			// If its time to send next batch of samples
 			int64_t ticks = Gekko::Gekko->GetTicks();
 			if (ticks < core->nextGekkoTicksToSample)
 			{
 				continue;
 			}
-			core->nextGekkoTicksToSample = ticks + core->TicksPerSample();
+
+			size_t frames = streamBatchFrames;
 
 			// Invalidate cache
 			if (core->streamEnabledByDduCommand)
@@ -415,41 +432,38 @@ namespace DVD
 
 			if (core->streamEnabledByDduCommand)
 			{
-				if (core->pcmPlaybackCounter >= sizeof(core->pcmPlaybackBuffer))
-				{
-					// Decode next ADPCM chunk
-					DvdAudioDecode(&core->streamingCache[core->streamingCachePtr], core->pcmPlaybackBuffer);
+				// Do not decode past the streaming cache and past the stream end
+				frames = min(frames, (streamCacheSize - core->streamingCachePtr) / DvdAudioFrameSize);
+				frames = min(frames, (size_t)max(1, (core->streamCount + (int32_t)DvdAudioFrameSize - 1) / (int32_t)DvdAudioFrameSize));
 
-					if (core->decodedStreamDump && core->decodedStreamFile)
-					{
-						fwrite(core->pcmPlaybackBuffer, 1, sizeof(core->pcmPlaybackBuffer), core->decodedStreamFile);
-					}
+				// Decode next ADPCM chunk
+				DvdAudioDecodeFrames(&core->adpcmState, &core->streamingCache[core->streamingCachePtr], frames, core->pcmPlaybackBuffer);
 
-					core->streamingCachePtr += 32;
-					core->streamSeekVal += 32;
-					core->streamCount -= 32;
-					core->pcmPlaybackCounter = 0;
+				if (core->decodedStreamDump && core->decodedStreamFile)
+				{
+					fwrite(core->pcmPlaybackBuffer, 1, frames * DvdAudioFrameSamples * 2 * sizeof(uint16_t), core->decodedStreamFile);
 				}
 
-				uint8_t* rawPtr = (uint8_t *)core->pcmPlaybackBuffer + core->pcmPlaybackCounter;
-				sample[0] = *(uint16_t *)rawPtr;
-				sample[1] = *(uint16_t *)(rawPtr + 2);
-				core->pcmPlaybackCounter += 4;
+				core->streamingCachePtr += (int)(frames * DvdAudioFrameSize);
+				core->streamSeekVal += (uint32_t)(frames * DvdAudioFrameSize);
+				core->streamCount -= (int32_t)(frames * DvdAudioFrameSize);
 			}
 			else
 			{
-				sample[0] = 0;
-				sample[1] = 0;
+				memset(core->pcmPlaybackBuffer, 0, frames * DvdAudioFrameSamples * 2 * sizeof(uint16_t));
 			}
 
-			// Send sample
+			// Send samples. AI counts them one by one (AISCNT), so AISINT is raised at the right sample of the batch.
+
+			size_t samples = frames * DvdAudioFrameSamples;
 
 			if (core->streamCallback)
 			{
-				core->streamCallback(sample[0], sample[1]);
+				core->streamCallback(core->pcmPlaybackBuffer, samples);
 			}
 
-			core->stats.sampleCounter++;
+			core->stats.sampleCounter += samples;
+			core->nextGekkoTicksToSample = ticks + core->TicksPerSample() * samples;
 
 			if (core->streamEnabledByDduCommand)
 			{
@@ -505,6 +519,57 @@ namespace DVD
 		streamEnabledByDduCommand = false;
 	}
 
+	void DduCore::DoState(StateStream& state)
+	{
+		bool dataRunning = dduThread->IsRunning();
+		bool audioRunning = dvdAudioThread->IsRunning();
+
+		state.BeginSection('DDU ', 3);
+
+		state.Do(coverStatus);
+		state.Do(errorState);
+		state.Do(errorCode);
+
+		state.Do(ddBusBusy);
+		state.Do(savedGekkoTicks);
+		state.Do(busDir);
+		state.Do(commandBuffer);
+		state.Do(commandPtr);
+		state.Do(immediateBuffer);
+		state.Do(immediateBufferPtr);
+		state.Do(dataCachePtr);
+		if (dataCachePtr < dataCacheSize)
+		{
+			state.Do(dataCache, dataCacheSize);
+		}
+		state.Do(this->state);
+		state.Do(seekVal);
+		state.Do(transactionSize);
+
+		state.Do(streamSeekVal);
+		state.Do(streamCount);
+		state.Do(sampleRate);
+		state.Do(nextGekkoTicksToSample);
+		state.Do(streamEnabledByDduCommand);
+		state.Do(streamingCachePtr);
+		if (streamingCachePtr < streamCacheSize)
+		{
+			state.Do(streamingCache, streamCacheSize);
+		}
+		state.Do(adpcmState);
+
+		state.Do(dataRunning);
+		state.Do(audioRunning);
+
+		state.EndSection();
+
+		if (state.IsLoading() && !state.Failed())
+		{
+			dataRunning ? dduThread->Resume() : dduThread->Suspend();
+			audioRunning ? dvdAudioThread->Resume() : dvdAudioThread->Suspend();
+		}
+	}
+
 	void DduCore::Break()
 	{
 		// Abort data transfer
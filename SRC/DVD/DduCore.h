@@ -4,6 +4,8 @@
 #pragma once
 
 #include "../Common/Thread.h"
+#include "../Common/StateStream.h"
+#include "DvdAdpcmDecode.h"
 
 namespace DVD
 {
@@ -28,7 +30,7 @@ namespace DVD
 	typedef void (*DduCallback)();
 	typedef uint8_t (*HostToDduCallback)();
 	typedef void (*DduToHostCallback)(uint8_t data);
-	typedef void (*DduStreamCallback)(uint16_t l, uint16_t r);
+	typedef void (*DduStreamCallback)(uint16_t* pcm, size_t samples);	// Interleaved LR samples
 
 	struct DduStats
 	{
@@ -107,8 +109,9 @@ namespace DVD
 		static const size_t streamCacheSize = 32 * 1024;
 		uint8_t* streamingCache = nullptr;		// The stream cache is used to store raw ADPCM data (undecoded)
 		int streamingCachePtr = 0;
-		uint16_t pcmPlaybackBuffer[2 * 28] = { 0 };
-		size_t pcmPlaybackCounter = 0;
+		static const size_t streamBatchFrames = 4;		// ADPCM frames decoded and sent to the host at once
+		DvdAdpcmState adpcmState = { 0 };
+		uint16_t pcmPlaybackBuffer[2 * DvdAudioFrameSamples * streamBatchFrames] = { 0 };
 		FILE* adpcmStreamFile = nullptr;
 		bool adpcmStreamDump = false;
 		FILE* decodedStreamFile = nullptr;
@@ -183,6 +186,13 @@ namespace DVD
 
 #pragma endregion "Streaming Audio interface"
 
+		// Bus, command and streaming state. The read caches are saved only while in use.
+		void DoState(StateStream& state);
+
+		// Stop the data and audio threads between updates, while the state is saved or loaded
+		void Park();
+		void Unpark();
+
 		// Stats
 		DduStats stats = { 0 };
 		void ResetStats()
@@ -191,5 +201,5 @@ namespace DVD
 		}
 	};
 
-	extern DduCore * DDU;
+	extern InstanceRef<DduCore, &Instance::ddu> DDU;
 }
@@ -1,96 +1,100 @@
 #include "pch.h"
 
-int32_t YnLeft[2], YnRight[2];
-
-typedef int Nibble;
-
-void DvdAudioInitDecoder()
+void DvdAudioInitDecoder(DvdAdpcmState* state)
 {
-	YnLeft[0] = YnLeft[1] = 0;
-	YnRight[0] = YnRight[1] = 0;
+	state->ynLeft[0] = state->ynLeft[1] = 0;
+	state->ynRight[0] = state->ynRight[1] = 0;
 }
 
-int32_t MulSomething(Nibble arg_0, int32_t yn1, int32_t yn2)
-{
-    int16_t a1 = 0;
-    int16_t a2 = 0;
-
-    switch (arg_0)
-    {
-        case 0:
-            a1 = 0;
-            a2 = 0;
-            break;
-        case 1:
-            a1 = 60;
-            a2 = 0;
-            break;
-        case 2:
-            a1 = 115;
-            a2 = -52;
-            break;
-        case 3:
-            a1 = 98;
-            a2 = -55;
-            break;
-    }
-
-    int32_t ps1 = (int32_t)a1 * yn1;
-    int32_t ps2 = (int32_t)a2 * yn2;
-
-    int32_t var_C = (ps1 + ps2 + 32) >> 6;
-    return max(-0x200000, min(var_C, 0x1FFFFF) );
-}
+// Per channel: yn = ((nibble << 12) >> shift) << 6 + clamp21((a1 * yn1 + a2 * yn2 + 32) >> 6), pcm = clamp16(yn >> 6).
+// The predictor recurrence is serial for each channel, so only the nibble scaling is done with SSE2 for the whole frame,
+// then both channels run the recurrence interleaved, with the filter coefficients fetched once per frame.
 
-int16_t Shifts1(Nibble arg_0, Nibble arg_4)
+// Filter coefficients (a1, a2) by filter index from the frame header. Indices 4-15 behave as 0.
+static const int32_t DtkFilterCoef[16][2] =
 {
-    int16_t var_4 = (int16_t)arg_0 << 12;
-    return var_4 >> arg_4;
-}
-
-int32_t Shifts2(int16_t arg_0, int32_t arg_4)
+	{ 0, 0 }, { 60, 0 }, { 115, -52 }, { 98, -55 },
+	{ 0, 0 }, { 0, 0 }, { 0, 0 }, { 0, 0 },
+	{ 0, 0 }, { 0, 0 }, { 0, 0 }, { 0, 0 },
+	{ 0, 0 }, { 0, 0 }, { 0, 0 }, { 0, 0 },
+};
+
+// Sign-extend and scale all nibbles of the frame. Frame bytes are expanded as a whole (including 4 header bytes), data starts from index 4.
+static void DvdAudioScaleNibbles(const uint8_t frame[32], int16_t left[32], int16_t right[32])
 {
-    return ((int32_t)arg_0 << 6) + arg_4;
+	__m128i zero = _mm_setzero_si128();
+	__m128i shiftLeft = _mm_cvtsi32_si128(frame[0] & 0xF);
+	__m128i shiftRight = _mm_cvtsi32_si128(frame[1] & 0xF);
+
+	for (int i = 0; i < 2; i++)
+	{
+		__m128i bytes = _mm_loadu_si128((const __m128i*)(frame + 16 * i));
+		__m128i words[2] = { _mm_unpacklo_epi8(bytes, zero), _mm_unpackhi_epi8(bytes, zero) };
+
+		for (int n = 0; n < 2; n++)
+		{
+			// Low nibble: left channel, high nibble: right channel. Shift by 12 places the nibble sign in bit 15.
+			__m128i lo = _mm_slli_epi16(words[n], 12);
+			__m128i hi = _mm_slli_epi16(_mm_srli_epi16(words[n], 4), 12);
+			_mm_storeu_si128((__m128i*)(left + 16 * i + 8 * n), _mm_sra_epi16(lo, shiftLeft));
+			_mm_storeu_si128((__m128i*)(right + 16 * i + 8 * n), _mm_sra_epi16(hi, shiftRight));
+		}
+	}
 }
 
-// Clamp
-uint16_t Clamp(int32_t arg_0)
+static inline int32_t DvdAudioPredict(const int32_t coef[2], int32_t yn[2])
 {
-    int32_t var_8 = arg_0 >> 6;
-    return (uint16_t)max(-0x8000, min(var_8, 0x7FFF));
+	int32_t p = (coef[0] * yn[0] + coef[1] * yn[1] + 32) >> 6;
+	return max(-0x200000, min(p, 0x1FFFFF));
 }
 
-uint16_t DecodeSample(Nibble arg_0, uint8_t arg_4, int Yn[2])
+void DvdAudioDecodeFrames(DvdAdpcmState* state, const uint8_t* adpcmBuffer, size_t frames, uint16_t* pcmBuffer)
 {
-    uint16_t res;
-
-    Nibble var_4 = arg_4 >> 4;
-    Nibble var_8 = arg_4 & 0xF;
-
-    int32_t var_18 = MulSomething(var_4, Yn[0], Yn[1]);
-    int16_t var_C = Shifts1(arg_0, var_8);
-    int32_t var_14 = Shifts2(var_C, var_18);
-    res = Clamp(var_14);
-
-    Yn[1] = Yn[0];
-    Yn[0] = var_14;
-
-    return res;
+	alignas(16) int16_t scaledLeft[32];
+	alignas(16) int16_t scaledRight[32];
+
+	int32_t ynLeft[2] = { state->ynLeft[0], state->ynLeft[1] };
+	int32_t ynRight[2] = { state->ynRight[0], state->ynRight[1] };
+
+	while (frames--)
+	{
+		const uint8_t* frame = adpcmBuffer;
+		adpcmBuffer += DvdAudioFrameSize;
+
+		if (!(frame[0] == frame[2] && frame[1] == frame[3]))
+		{
+			memset(pcmBuffer, 0, 2 * DvdAudioFrameSamples * sizeof(uint16_t));
+			pcmBuffer += 2 * DvdAudioFrameSamples;
+			continue;
+		}
+
+		DvdAudioScaleNibbles(frame, scaledLeft, scaledRight);
+
+		const int32_t* coefLeft = DtkFilterCoef[frame[0] >> 4];
+		const int32_t* coefRight = DtkFilterCoef[frame[1] >> 4];
+
+		for (int i = 4; i < 32; i++)
+		{
+			int32_t l = ((int32_t)scaledLeft[i] << 6) + DvdAudioPredict(coefLeft, ynLeft);
+			int32_t r = ((int32_t)scaledRight[i] << 6) + DvdAudioPredict(coefRight, ynRight);
+
+			ynLeft[1] = ynLeft[0];
+			ynLeft[0] = l;
+			ynRight[1] = ynRight[0];
+			ynRight[0] = r;
+
+			*pcmBuffer++ = (uint16_t)max(-0x8000, min(l >> 6, 0x7FFF));
+			*pcmBuffer++ = (uint16_t)max(-0x8000, min(r >> 6, 0x7FFF));
+		}
+	}
+
+	state->ynLeft[0] = ynLeft[0];
+	state->ynLeft[1] = ynLeft[1];
+	state->ynRight[0] = ynRight[0];
+	state->ynRight[1] = ynRight[1];
 }
 
-void DvdAudioDecode(uint8_t adpcmBuffer[32], uint16_t pcmBuffer[2 * 28])
+void DvdAudioDecode(DvdAdpcmState* state, uint8_t adpcmBuffer[32], uint16_t pcmBuffer[2 * 28])
 {
-    uint8_t* adpcmData = &adpcmBuffer[4];
-
-    if (!(adpcmBuffer[0] == adpcmBuffer[2] && adpcmBuffer[1] == adpcmBuffer[3]))
-    {
-        memset(pcmBuffer, 0, sizeof(pcmBuffer));
-        return;
-    }
-
-    for (int i = 0; i < 28; i++)
-    {
-        pcmBuffer[2 * i] = DecodeSample(adpcmData[i] & 0xF, adpcmBuffer[0], YnLeft);
-        pcmBuffer[2 * i + 1] = DecodeSample(adpcmData[i] >> 4, adpcmBuffer[1], YnRight);
-    }
+	DvdAudioDecodeFrames(state, adpcmBuffer, 1, pcmBuffer);
 }
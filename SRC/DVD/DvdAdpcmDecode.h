@@ -2,5 +2,18 @@
 
 #pragma once
 
-void DvdAudioInitDecoder();
-void DvdAudioDecode(uint8_t adpcmBuffer[32], uint16_t pcmBuffer[2 * 28]);
+static const size_t DvdAudioFrameSize = 32;			// ADPCM frame size in bytes (4 bytes header + 28 bytes data)
+static const size_t DvdAudioFrameSamples = 28;		// LR samples per ADPCM frame
+
+// Predictor history of a stream (each DDU has its own)
+struct DvdAdpcmState
+{
+	int32_t ynLeft[2];
+	int32_t ynRight[2];
+};
+
+void DvdAudioInitDecoder(DvdAdpcmState* state);
+void DvdAudioDecode(DvdAdpcmState* state, uint8_t adpcmBuffer[32], uint16_t pcmBuffer[2 * 28]);
+
+// Decode a sequence of ADPCM frames. pcmBuffer receives frames * DvdAudioFrameSamples LR samples.
+void DvdAudioDecodeFrames(DvdAdpcmState* state, const uint8_t* adpcmBuffer, size_t frames, uint16_t* pcmBuffer);
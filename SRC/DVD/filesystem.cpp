@@ -1,11 +1,7 @@
 // DVD filesystem access.
 #include "pch.h"
 
-// local data
-static DVDBB2           bb2;
-static DVDFileEntry* FstStart;            // Loaded FST (byte-swapped as little-endian)
-static uint32_t         fstSize;        // Size of loaded FST in bytes (not greater DVD_FST_MAX_SIZE)
-static char* FstStringStart;          // Strings(name) table
+// The loaded FST and its index are in DVDControl
 
 #define FSTOFS(lo, hi) (((uint32_t)hi << 16) | lo)
 
@@ -55,6 +51,104 @@ static char *fst_prepare(DVDFileEntry *root)
     return nameTablePtr;
 }
 
+static void fst_index_clear()
+{
+    dvd->FstPathIndex.clear();
+    dvd->FstDirChilds.clear();
+    dvd->FstDirSlot.clear();
+    dvd->FstIndexValid = false;
+}
+
+// Get lower-cased name of FST entry. false if the name is out of the FST bounds.
+static bool fst_entry_name(int entry, std::string& name)
+{
+    uint32_t nameOffset = FSTOFS(dvd->FstStart[entry].nameOffsetLo, dvd->FstStart[entry].nameOffsetHi) & 0xFFFFFF;
+    char* ptr = &dvd->FstStringStart[nameOffset];
+    char* end = (char*)dvd->FstStart + dvd->fstSize;
+
+    name.clear();
+    while (ptr < end && *ptr)
+    {
+        name.push_back((char)_tolower(*ptr++));
+    }
+    return ptr < end;
+}
+
+// Walk the FST directory tree once and fill the path/child tables.
+static bool fst_build_index()
+{
+    fst_index_clear();
+
+    int numEntries = (int)dvd->FstStart[0].nextOffset;
+    if ((size_t)numEntries * sizeof(DVDFileEntry) > dvd->fstSize)
+    {
+        return false;
+    }
+
+    dvd->FstDirSlot.assign(numEntries, -1);
+
+    struct DirWalk
+    {
+        int entry;
+        std::string path;       // With trailing '/'
+    };
+
+    std::vector<DirWalk> stack;
+    stack.push_back({ 0, "/" });
+    dvd->FstDirSlot[0] = 0;
+    dvd->FstDirChilds.emplace_back();
+    dvd->FstPathIndex["/"] = 0;
+
+    bool collisions = false;
+    std::string name;
+
+    while (!stack.empty())
+    {
+        DirWalk dir = stack.back();
+        stack.pop_back();
+
+        int slot = dvd->FstDirSlot[dir.entry];
+        int end = (int)dvd->FstStart[dir.entry].nextOffset;
+
+        for (int entry = dir.entry + 1; entry < end; )
+        {
+            if (!fst_entry_name(entry, name))
+            {
+                return false;
+            }
+
+            if (!dvd->FstDirChilds[slot].emplace(name, entry).second)
+            {
+                collisions = true;
+            }
+
+            std::string path = dir.path + name;
+            dvd->FstPathIndex.emplace(path, entry);
+
+            if (dvd->FstStart[entry].isDir)
+            {
+                int next = (int)dvd->FstStart[entry].nextOffset;
+                if (next <= entry || next > end)
+                {
+                    return false;       // Bad FST
+                }
+
+                dvd->FstDirSlot[entry] = (int)dvd->FstDirChilds.size();
+                dvd->FstDirChilds.emplace_back();
+                stack.push_back({ entry, path + "/" });
+                entry = next;
+            }
+            else
+            {
+                entry++;
+            }
+        }
+    }
+
+    dvd->FstIndexValid = !collisions;
+    return true;
+}
+
 // initialize filesystem
 bool dvd_fs_init()
 {
@@ -90,37 +184,47 @@ bool dvd_fs_init()
 
     // load tables
     DVD::Seek(DVD_BB2_OFFSET);
-    DVD::Read(&bb2, sizeof(DVDBB2));
-    SwapArea((uint32_t *)&bb2, sizeof(DVDBB2));
+    DVD::Read(&dvd->bb2, sizeof(DVDBB2));
+    SwapArea((uint32_t *)&dvd->bb2, sizeof(DVDBB2));
 
     // delete previous FST
-    if(FstStart)
+    fst_index_clear();
+    if(dvd->FstStart)
     {
-        free(FstStart);
-        FstStart = NULL;
-        fstSize = 0;
+        free(dvd->FstStart);
+        dvd->FstStart = NULL;
+        dvd->fstSize = 0;
     }
 
     // create new FST
-    fstSize = bb2.FSTLength;
-    if(fstSize > DVD_FST_MAX_SIZE)
+    dvd->fstSize = dvd->bb2.FSTLength;
+    if(dvd->fstSize > DVD_FST_MAX_SIZE)
     {
         return false;
     }
-    FstStart = (DVDFileEntry *)malloc(fstSize);
-    if(FstStart == NULL)
+    dvd->FstStart = (DVDFileEntry *)malloc(dvd->fstSize);
+    if(dvd->FstStart == NULL)
     {
         return false;
     }
-    DVD::Seek(bb2.FSTPosition);
-    DVD::Read(FstStart, fstSize);
+    DVD::Seek(dvd->bb2.FSTPosition);
+    DVD::Read(dvd->FstStart, dvd->fstSize);
         
     // swap bytes in FST and find offset of string table
-    FstStringStart = fst_prepare(FstStart);
-    if(!FstStringStart)
+    dvd->FstStringStart = fst_prepare(dvd->FstStart);
+    if(!dvd->FstStringStart)
     {
-        free(FstStart);
-        FstStart = NULL;
+        free(dvd->FstStart);
+        dvd->FstStart = NULL;
+        return false;
+    }
+
+    // build path index
+    if (!fst_build_index())
+    {
+        fst_index_clear();
+        free(dvd->FstStart);
+        dvd->FstStart = NULL;
         return false;
     }
 
@@ -158,13 +262,13 @@ static int DVDConvertPathToEntrynum(const char* _path)
             {
                 if (path[2] == '/')
                 {
-                    entry = FstStart[entry].parentOffset;
+                    entry = dvd->FstStart[entry].parentOffset;
                     path += 3;
                     continue;   // Loop1
                 }
                 if (path[2] == 0)
                 {
-                    return FstStart[entry].parentOffset;
+                    return dvd->FstStart[entry].parentOffset;
                 }
             }
             else
@@ -203,15 +307,15 @@ static int DVDConvertPathToEntrynum(const char* _path)
         // Loop2
         while (true)
         {
-            if ((int)FstStart[prevEntry].nextOffset <= entry)   // Walk forward only
+            if ((int)dvd->FstStart[prevEntry].nextOffset <= entry)   // Walk forward only
                 return -1;      // Bad FST
 
             // Loop2 - Group 1  -- Compare names
-            if (FstStart[entry].isDir || afterNameCharNZ == false /* after-name is 0 */)
+            if (dvd->FstStart[entry].isDir || afterNameCharNZ == false /* after-name is 0 */)
             {
                 char* r21 = path;      // r21 -- current pathPtr to inner loop
-                int nameOffset = (FstStart[entry].nameOffsetHi << 16) | FstStart[entry].nameOffsetLo;
-                char* r20 = &FstStringStart[nameOffset & 0xFFFFFF];     // r20 -- ptr to current entry name
+                int nameOffset = (dvd->FstStart[entry].nameOffsetHi << 16) | dvd->FstStart[entry].nameOffsetLo;
+                char* r20 = &dvd->FstStringStart[nameOffset & 0xFFFFFF];     // r20 -- ptr to current entry name
 
                 bool same;
                 while (true)
@@ -239,22 +343,148 @@ static int DVDConvertPathToEntrynum(const char* _path)
             }
 
             // Walk next directory/file at same level
-            entry = FstStart[entry].isDir ? FstStart[entry].nextOffset : (entry + 1);
+            entry = dvd->FstStart[entry].isDir ? dvd->FstStart[entry].nextOffset : (entry + 1);
 
         }   // Loop2
 
     }   // Loop1
 }
 
+// Same as DVDConvertPathToEntrynum, but every path element is resolved by the hashed child table of its directory.
+// <0: Bad path
+static int DVDConvertPathToEntrynumIndexed(const char* path)
+{
+    int entry = 0;
+    std::string name;
+
+    while (true)
+    {
+        if (path[0] == 0)
+            return entry;
+
+        if (path[0] == '/')
+        {
+            entry = 0;
+            path++;
+            continue;
+        }
+
+        if (path[0] == '.')
+        {
+            if (path[1] == '.')
+            {
+                if (path[2] == '/')
+                {
+                    entry = dvd->FstStart[entry].parentOffset;
+                    path += 3;
+                    continue;
+                }
+                if (path[2] == 0)
+                {
+                    return dvd->FstStart[entry].parentOffset;
+                }
+            }
+            else
+            {
+                if (path[1] == '/')
+                {
+                    path += 2;
+                    continue;
+                }
+                if (path[1] == 0)
+                {
+                    return entry;
+                }
+            }
+        }
+
+        name.clear();
+        while (!(path[0] == 0 || path[0] == '/'))
+        {
+            name.push_back((char)_tolower(*path++));
+        }
+
+        int slot = dvd->FstDirSlot[entry];
+        if (slot < 0)
+            return -1;
+
+        auto it = dvd->FstDirChilds[slot].find(name);
+        if (it == dvd->FstDirChilds[slot].end())
+            return -1;
+
+        entry = it->second;
+
+        if (path[0] == 0)
+            return entry;
+
+        // Only directories can be followed by '/'
+        if (!dvd->FstStart[entry].isDir)
+            return -1;
+        path++;
+    }
+}
+
+// Fast path for absolute paths without "." and ".." elements: single lookup of the whole path.
+// <0: Not found in the index (use the element-wise walk)
+static int FstLookupFullPath(const char* path)
+{
+    std::string key;
+    for (const char* ptr = path; *ptr; ptr++)
+    {
+        if (ptr[0] == '.' && ptr[-1] == '/' &&
+            (ptr[1] == '/' || ptr[1] == 0 || (ptr[1] == '.' && (ptr[2] == '/' || ptr[2] == 0))))
+        {
+            return -1;
+        }
+        key.push_back((char)_tolower(*ptr));
+    }
+
+    // Trailing slash is allowed for directories
+    if (key.size() > 1 && key.back() == '/')
+    {
+        key.pop_back();
+        auto it = dvd->FstPathIndex.find(key);
+        if (it == dvd->FstPathIndex.end() || !dvd->FstStart[it->second].isDir)
+            return -1;
+        return it->second;
+    }
+
+    auto it = dvd->FstPathIndex.find(key);
+    return (it != dvd->FstPathIndex.end()) ? it->second : -1;
+}
+
 // convert DVD file name into file position on the disk
 // 0, if file not found
 int dvd_open(const char *path)
 {
-    int entry = DVDConvertPathToEntrynum(path);
+    if (dvd->FstStart == nullptr)
+    {
+        return 0;
+    }
+
+    int entry;
+
+    if (dvd->FstIndexValid)
+    {
+        entry = -1;
+        if (path[0] == '/' && path[1] != '/')
+        {
+            entry = FstLookupFullPath(path);
+        }
+        if (entry < 0)
+        {
+            entry = DVDConvertPathToEntrynumIndexed(path);
+        }
+    }
+    else
+    {
+        entry = DVDConvertPathToEntrynum(path);
+    }
+
     if (entry < 0)
     {
         return 0;
     }
 
-    return (int)FstStart[entry].fileOffset;
+    return (int)dvd->FstStart[entry].fileOffset;
 }
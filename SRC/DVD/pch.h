@@ -9,8 +9,13 @@
 #include <tchar.h>
 #include <windows.h>
 #include <filesystem>
+#include <intrin.h>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 #include "../Common/Jdi.h"
+#include "../Common/PerfCounters.h"
 
 #include "../Debugger/Debugger.h"
 #include "../Core/Gekko.h"
@@ -121,14 +121,20 @@ namespace Debug
             return nullptr;
         }
 
-        int period = 5;
+        int interval = 1000;
         if (args.size() > 2)
         {
-            period = atoi(args[2].c_str());
-            period = min(2, max(period, 50));
+            interval = atoi(args[2].c_str());
+            interval = max(10, min(interval, 1000000));
         }
 
-        profiler = new SamplingProfiler(args[1].c_str(), period);
+        int depth = 1;
+        if (args.size() > 3)
+        {
+            depth = atoi(args[3].c_str());
+        }
+
+        profiler = new SamplingProfiler(args[1].c_str(), interval, depth);
         assert(profiler);
 
         DBReport("Profiler started.\n");
@@ -152,11 +158,71 @@ namespace Debug
         return nullptr;
     }
 
+    // Make the report again (for example, after loading another map)
+    static Json::Value* MakeProfileReport(std::vector<std::string>& args)
+    {
+        Debug::ProfileReport::Generate(args[1].c_str());
+        return nullptr;
+    }
+
+    static const char* channelNames[] = {
+        "Void", "Norm", "Info", "Error", "Header",
+        "CP", "PE", "VI", "GP", "PI", "CPU", "MI", "DSP", "DI", "AR", "AI", "AIS", "SI", "EXI", "MC", "DVD", "AX",
+        "Loader", "HLE",
+    };
+
+    // Enable or disable debug output channels
+    static Json::Value* LogChannel(std::vector<std::string>& args)
+    {
+        uint32_t mask = DBGetUserChannelMask();
+        const size_t numChannels = sizeof(channelNames) / sizeof(channelNames[0]);
+
+        if (args.size() < 3)
+        {
+            for (size_t i = 1; i < numChannels; i++)
+            {
+                DBReport("%-8s %s%s\n", channelNames[i], (mask & (1 << i)) ? "on" : "off",
+                    (DOLWIN_DB_CHANNELS & (1 << i)) ? "" : " (not compiled)");
+            }
+            return nullptr;
+        }
+
+        bool enable = atoi(args[2].c_str()) != 0;
+        uint32_t bits = 0;
+
+        if (!_stricmp(args[1].c_str(), "all"))
+        {
+            bits = ~DBChannelBit(DbgChannel::Void);
+        }
+        else
+        {
+            for (size_t i = 1; i < numChannels; i++)
+            {
+                if (!_stricmp(args[1].c_str(), channelNames[i]))
+                {
+                    bits = 1 << i;
+                    break;
+                }
+            }
+        }
+
+        if (bits == 0)
+        {
+            DBReport("Unknown channel: %s\n", args[1].c_str());
+            return nullptr;
+        }
+
+        DBSetUserChannelMask(enable ? (mask | bits) : (mask & ~bits));
+        return nullptr;
+    }
+
 	void Reflector()
 	{
         Debug::Hub.AddCmd("script", cmd_script);
         Debug::Hub.AddCmd("echo", cmd_echo);
         Debug::Hub.AddCmd("StartProfiler", StartProfiler);
         Debug::Hub.AddCmd("StopProfiler", StopProfiler);
+        Debug::Hub.AddCmd("ProfileReport", MakeProfileReport);
+        Debug::Hub.AddCmd("LogChannel", LogChannel);
 	}
 }
@@ -12,22 +12,22 @@ static void JustEventLog(DbgChannel chan, const char* text, ...)
 {
     if (Debug::Log != nullptr)
     {
-        char    buf[0x1000];
         va_list arg;
 
         va_start(arg, text);
-        int size = vsprintf_s(buf, sizeof(buf) - 1, text, arg);
+        Debug::Log->AddReport(chan, text, arg);
         va_end(arg);
-
-        std::vector<uint8_t> data(buf, buf + size);
-        Debug::Log->Add(chan, Debug::EventType::DebugReport, data);
     }
 }
 
 // message output
 void (*DBHalt)(const char *text, ...)   = dummy;
 void (*DBReport)(const char* text, ...) = dummy;
-void (*DBReport2)(DbgChannel chan, const char *text, ...) = JustEventLog;
+void (*DBReport2Proc)(DbgChannel chan, const char *text, ...) = JustEventLog;
+
+uint32_t DBChannelMask = 0;
+static uint32_t userChannelMask = ~DBChannelBit(DbgChannel::Void);
+static bool consoleListening = false;
 
 static HANDLE consoleThreadHandle = INVALID_HANDLE_VALUE;
 static DWORD consoleThreadId;
@@ -140,10 +140,9 @@ static void db_report2(DbgChannel chan, const char* text, ...)
 
     con_print(col, "%s%s", prefix, buf);
 
-    if (Debug::Log != nullptr)
+    if (Debug::Log != nullptr && size >= 0)
     {
-        std::vector<uint8_t> data(buf, buf + size);
-        Debug::Log->Add(chan, Debug::EventType::DebugReport, data);
+        Debug::Log->Add(chan, Debug::EventType::DebugReport, buf, size);
     }
 }
 
@@ -163,7 +162,9 @@ static DWORD WINAPI DBThreadProc(LPVOID lpParameter)
 {
     DBHalt = con_error;
     DBReport = db_report;
-    DBReport2 = db_report2;
+    DBReport2Proc = db_report2;
+    consoleListening = true;
+    DBUpdateChannelMask();
     con_open();
 
     con.update |= CON_UPDATE_ALL;
@@ -173,11 +174,37 @@ static DWORD WINAPI DBThreadProc(LPVOID lpParameter)
 
     DBHalt = dummy;
     DBReport = dummy;
-    DBReport2 = JustEventLog;
+    DBReport2Proc = JustEventLog;
+    consoleListening = false;
+    DBUpdateChannelMask();
 
     return 0;
 }
 
+// The console shows all channels, the event log only the channels of the hardware subsystems.
+void DBUpdateChannelMask()
+{
+    uint32_t listeners = 0;
+
+    if (consoleListening)
+        listeners = ~DBChannelBit(DbgChannel::Void);
+    else if (Debug::Log != nullptr)
+        listeners = Debug::EventLog::ChannelMask();
+
+    DBChannelMask = listeners & userChannelMask;
+}
+
+void DBSetUserChannelMask(uint32_t mask)
+{
+    userChannelMask = mask;
+    DBUpdateChannelMask();
+}
+
+uint32_t DBGetUserChannelMask()
+{
+    return userChannelMask;
+}
+
 // Open debugger window
 void DBOpen()
 {
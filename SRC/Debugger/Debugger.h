@@ -41,7 +41,30 @@ extern  void (*DBHalt)(const char *text, ...);
 
 // do debugger output
 extern  void (*DBReport)(const char* text, ...);
-extern  void (*DBReport2)(DbgChannel chan, const char *text, ...);
+extern  void (*DBReport2Proc)(DbgChannel chan, const char *text, ...);
+
+// Channel filter.
+// DBReport2 tests the channel mask before the arguments are evaluated, so a message nobody listens to costs one test of a global variable.
+// DBChannelMask has a bit for each channel that goes somewhere (debugger console, event log) and is not disabled by the user.
+// Channels missing in DOLWIN_DB_CHANNELS (set it in the project preprocessor definitions) are removed from the build altogether.
+
+#ifndef DOLWIN_DB_CHANNELS
+#define DOLWIN_DB_CHANNELS 0xffffffff
+#endif
+
+extern  uint32_t DBChannelMask;
+
+#define DBChannelBit(chan) (1u << (uint32_t)(chan))
+#define DBChannelEnabled(chan) ((DOLWIN_DB_CHANNELS & DBChannelBit(chan)) != 0 && (DBChannelMask & DBChannelBit(chan)) != 0)
+
+// The format must be a string literal: the event log keeps the format pointer and formats the text later, so a temporary
+// buffer would dangle (and user text would be taken as format). Pass text as "%s" argument, it is copied.
+// The empty literal in front of the format makes a non-literal format a compile error.
+#define DBReport2(chan, format, ...) do { if (DBChannelEnabled(chan)) DBReport2Proc(chan, "" format, ##__VA_ARGS__); } while (0)
+
+void    DBUpdateChannelMask();              // call after a listener is added or removed
+void    DBSetUserChannelMask(uint32_t mask);
+uint32_t DBGetUserChannelMask();
 
 void    DBOpen();                           // open debugger window in its own thread
 void    DBClose();                          // close debugger completely
@@ -1,157 +1,638 @@
 // Event log support
 
+// Events are written as fixed-size binary records to the ring of the calling thread, without locks and without memory allocation.
+// DBReport2 messages are not formatted when they are logged: the record keeps the format pointer and the packed arguments
+// (integers, pointers and doubles as 8 bytes, strings copied with the terminating zero). The text is made by replaying
+// the format over the packed arguments when the history is exported.
+
 #include "pch.h"
 
 namespace Debug
 {
 	EventLog* Log;
 
-	EventLog::EventLog()
+	static const uint8_t SlotFirst = 1;		// First slot of a record
+	static const uint8_t SlotNext = 2;		// Continuation of the record
+
+	static std::atomic<uint64_t> nextLogId = 1;
+
+	struct ThreadRing
 	{
-		rootObj = eventHistory.root.AddObject(nullptr);
-		assert(rootObj);
+		uint64_t logId;
+		EventRing* ring;
+	};
 
-		subsystems = rootObj->AddObject("subsystems");
-		assert(subsystems);
+	static thread_local ThreadRing threadRing = { 0, nullptr };
+
+	#pragma region "Format Arguments"
+
+	enum class ArgKind
+	{
+		None = 0,		// %%
+		Int32,
+		Long,
+		Int64,
+		Char,
+		Double,
+		Pointer,
+		String,
+		WideString,
+		Unknown,
+	};
+
+	// One printf conversion
+	struct FormatSpec
+	{
+		const char* lengthStart;	// Flags, width and precision are between '%' and the length modifier
+		const char* end;			// Past the conversion character
+		int stars;					// Width and precision given by arguments
+		char length[3];				// Length modifier to use when formatting the packed value
+		char conv;
+		ArgKind kind;
+	};
+
+	static const char* ParseSpec(const char* p, FormatSpec& spec)
+	{
+		spec.stars = 0;
+		spec.length[0] = 0;
+		spec.kind = ArgKind::Unknown;
+
+		p++;	// %
+
+		while (*p && strchr("-+ #0", *p))
+			p++;
+
+		if (*p == '*')
+		{
+			spec.stars++;
+			p++;
+		}
+		else while (*p >= '0' && *p <= '9')
+			p++;
+
+		if (*p == '.')
+		{
+			p++;
+			if (*p == '*')
+			{
+				spec.stars++;
+				p++;
+			}
+			else while (*p >= '0' && *p <= '9')
+				p++;
+		}
+
+		spec.lengthStart = p;
+
+		bool half = false, halfHalf = false, isLong = false, wide64 = false, wideChar = false;
+
+		if (p[0] == 'h' && p[1] == 'h') { halfHalf = true; p += 2; }
+		else if (p[0] == 'h') { half = true; p++; }
+		else if (p[0] == 'l' && p[1] == 'l') { wide64 = true; p += 2; }
+		else if (p[0] == 'l') { isLong = wideChar = true; p++; }
+		else if (p[0] == 'w') { wideChar = true; p++; }
+		else if (p[0] == 'L') { p++; }
+		else if (p[0] == 'z' || p[0] == 'j' || p[0] == 't') { wide64 = true; p++; }
+		else if (p[0] == 'I' && p[1] == '6' && p[2] == '4') { wide64 = true; p += 3; }
+		else if (p[0] == 'I' && p[1] == '3' && p[2] == '2') { p += 3; }
+		else if (p[0] == 'I') { wide64 = sizeof(void*) == 8; p++; }
+
+		spec.conv = *p;
+		if (*p)
+			p++;
+		spec.end = p;
+
+		switch (spec.conv)
+		{
+			case '%':
+				spec.kind = ArgKind::None;
+				break;
+
+			case 'd': case 'i': case 'u': case 'o': case 'x': case 'X':
+				if (wide64)
+				{
+					spec.kind = ArgKind::Int64;
+					strcpy(spec.length, "ll");
+				}
+				else if (isLong)
+				{
+					spec.kind = ArgKind::Long;
+					strcpy(spec.length, "l");
+				}
+				else
+				{
+					spec.kind = ArgKind::Int32;
+					strcpy(spec.length, halfHalf ? "hh" : (half ? "h" : ""));
+				}
+				break;
+
+			case 'c':
+			case 'C':
+				spec.kind = ArgKind::Char;
+				spec.conv = 'c';
+				break;
+
+			case 'e': case 'E': case 'f': case 'F': case 'g': case 'G': case 'a': case 'A':
+				spec.kind = ArgKind::Double;
+				break;
+
+			case 's':
+				spec.kind = wideChar ? ArgKind::WideString : ArgKind::String;
+				break;
+			case 'S':
+				spec.kind = ArgKind::WideString;
+				spec.conv = 's';
+				break;
+
+			case 'p':
+			case 'n':
+				spec.kind = ArgKind::Pointer;
+				break;
+		}
+
+		return p;
 	}
 
-	EventLog::~EventLog()
+	// Packed arguments of one message
+
+	struct ArgPacker
+	{
+		uint8_t* data;
+		size_t size = 0;
+		size_t maxSize;
+
+		ArgPacker(uint8_t* buf, size_t bufSize) : data(buf), maxSize(bufSize) {}
+
+		bool PutValue(uint64_t value)
+		{
+			if (size + sizeof(value) > maxSize)
+				return false;
+			memcpy(&data[size], &value, sizeof(value));
+			size += sizeof(value);
+			return true;
+		}
+
+		bool PutDouble(double value)
+		{
+			uint64_t bits;
+			memcpy(&bits, &value, sizeof(bits));
+			return PutValue(bits);
+		}
+
+		// Too long strings are truncated
+		bool PutString(const char* str)
+		{
+			if (size >= maxSize)
+				return false;
+			if (str == nullptr)
+				str = "(null)";
+			while (*str && size < maxSize - 1)
+				data[size++] = *str++;
+			data[size++] = 0;
+			return true;
+		}
+
+		bool PutWideString(const wchar_t* str)
+		{
+			if (size >= maxSize)
+				return false;
+			if (str == nullptr)
+				str = L"(null)";
+			while (*str && size < maxSize - 1)
+			{
+				data[size++] = *str < 0x80 ? (uint8_t)*str : '?';
+				str++;
+			}
+			data[size++] = 0;
+			return true;
+		}
+	};
+
+	template <typename T>
+	static void AppendFormatted(std::string& text, const char* spec, int stars, const int* star, T value)
+	{
+		char buf[0x1000];
+		int size;
+
+		switch (stars)
+		{
+			case 0:
+				size = snprintf(buf, sizeof(buf), spec, value);
+				break;
+			case 1:
+				size = snprintf(buf, sizeof(buf), spec, star[0], value);
+				break;
+			default:
+				size = snprintf(buf, sizeof(buf), spec, star[0], star[1], value);
+				break;
+		}
+
+		if (size > 0)
+		{
+			text.append(buf, (std::min)((size_t)size, sizeof(buf) - 1));
+		}
+	}
+
+	// Replay the format over the packed arguments. Formatting stops where the arguments were truncated.
+	static void FormatReport(const char* format, const uint8_t* data, size_t size, std::string& text)
+	{
+		size_t pos = 0;
+		const char* p = format;
+
+		auto GetValue = [&](uint64_t& value)
+		{
+			if (pos + sizeof(value) > size)
+				return false;
+			memcpy(&value, &data[pos], sizeof(value));
+			pos += sizeof(value);
+			return true;
+		};
+
+		while (*p)
+		{
+			const char* percent = strchr(p, '%');
+			if (!percent)
+			{
+				text.append(p);
+				break;
+			}
+			text.append(p, percent - p);
+
+			FormatSpec spec;
+			p = ParseSpec(percent, spec);
+
+			if (spec.kind == ArgKind::None)
+			{
+				text.push_back('%');
+				continue;
+			}
+			if (spec.kind == ArgKind::Unknown)
+				break;
+
+			int star[2] = { 0, 0 };
+			uint64_t value = 0;
+			bool ok = true;
+
+			for (int i = 0; i < spec.stars; i++)
+			{
+				ok &= GetValue(value);
+				star[i] = (int)value;
+			}
+			if (!ok)
+				break;
+
+			std::string specText = "%";
+			specText.append(percent + 1, spec.lengthStart - percent - 1);
+			specText.append(spec.length);
+			specText.push_back(spec.conv);
+
+			if (spec.kind == ArgKind::String || spec.kind == ArgKind::WideString)
+			{
+				if (pos >= size)
+					break;
+				const char* str = (const char*)&data[pos];
+				pos += strnlen(str, size - pos) + 1;
+				AppendFormatted(text, specText.c_str(), spec.stars, star, str);
+				continue;
+			}
+
+			if (!GetValue(value))
+				break;
+
+			switch (spec.kind)
+			{
+				case ArgKind::Int32:
+				case ArgKind::Char:
+					AppendFormatted(text, specText.c_str(), spec.stars, star, (int)value);
+					break;
+				case ArgKind::Long:
+					AppendFormatted(text, specText.c_str(), spec.stars, star, (long)value);
+					break;
+				case ArgKind::Int64:
+					AppendFormatted(text, specText.c_str(), spec.stars, star, (long long)value);
+					break;
+				case ArgKind::Double:
+				{
+					double d;
+					memcpy(&d, &value, sizeof(d));
+					AppendFormatted(text, specText.c_str(), spec.stars, star, d);
+					break;
+				}
+				case ArgKind::Pointer:
+					if (spec.conv == 'p')
+					{
+						AppendFormatted(text, specText.c_str(), spec.stars, star, (void*)(uintptr_t)value);
+					}
+					break;
+			}
+		}
+	}
+
+	#pragma endregion "Format Arguments"
+
+	EventRing::EventRing()
+	{
+		slots = new EventSlot[slotCount];
+		memset(slots, 0, slotCount * sizeof(EventSlot));
+	}
+
+	EventRing::~EventRing()
+	{
+		delete[] slots;
+	}
+
+	EventLog::EventLog()
 	{
-		// The memory will be cleared along with json root (eventHistory).
+		id = nextLogId++;
 	}
 
-	Json::Value* EventLog::GetSubsystem(DbgChannel chan)
+	EventLog::~EventLog()
 	{
-		Json::Value* out = nullptr;
+		for (auto ring : rings)
+		{
+			delete ring;
+		}
+	}
 
+	const char* EventLog::GetSubsystemName(DbgChannel chan)
+	{
 		switch (chan)
 		{
-            case DbgChannel::CP:
-				out = subsystems->ByName("CP");
-				if (!out)
-					out = subsystems->AddObject("CP");
-                break;
-            case DbgChannel::PE:
-				out = subsystems->ByName("PE");
-				if (!out)
-					out = subsystems->AddObject("PE");
-                break;
-            case DbgChannel::VI:
-				out = subsystems->ByName("VI");
-				if (!out)
-					out = subsystems->AddObject("VI");
-                break;
-            case DbgChannel::GP:
-				out = subsystems->ByName("GP");
-				if (!out)
-					out = subsystems->AddObject("GP");
-                break;
-            case DbgChannel::PI:
-				out = subsystems->ByName("PI");
-				if (!out)
-					out = subsystems->AddObject("PI");
-                break;
-            case DbgChannel::CPU:
-				out = subsystems->ByName("CPU");
-				if (!out)
-					out = subsystems->AddObject("CPU");
-                break;
-            case DbgChannel::MI:
-				out = subsystems->ByName("MI");
-				if (!out)
-					out = subsystems->AddObject("MI");
-                break;
-            case DbgChannel::DSP:
-				out = subsystems->ByName("DSP");
-				if (!out)
-					out = subsystems->AddObject("DSP");
-                break;
-            case DbgChannel::DI:
-				out = subsystems->ByName("DI");
-				if (!out)
-					out = subsystems->AddObject("DI");
-                break;
-            case DbgChannel::AR:
-				out = subsystems->ByName("AR");
-				if (!out)
-					out = subsystems->AddObject("AR");
-                break;
-            case DbgChannel::AI:
-				out = subsystems->ByName("AI");
-				if (!out)
-					out = subsystems->AddObject("AI");
-                break;
-            case DbgChannel::AIS:
-				out = subsystems->ByName("AIStream");
-				if (!out)
-					out = subsystems->AddObject("AIStream");
-                break;
-            case DbgChannel::SI:
-				out = subsystems->ByName("SI");
-				if (!out)
-					out = subsystems->AddObject("SI");
-                break;
-            case DbgChannel::EXI:
-				out = subsystems->ByName("EXI");
-				if (!out)
-					out = subsystems->AddObject("EXI");
-                break;
-            case DbgChannel::MC:
-				out = subsystems->ByName("MemCards");
-				if (!out)
-					out = subsystems->AddObject("MemCards");
-                break;
-            case DbgChannel::DVD:
-				out = subsystems->ByName("DVD");
-				if (!out)
-					out = subsystems->AddObject("DVD");
-                break;
-            case DbgChannel::AX:
-				out = subsystems->ByName("AudioDAC");
-				if (!out)
-					out = subsystems->AddObject("AudioDAC");
-                break;
-		}
-
-		return out;
+			case DbgChannel::CP: return "CP";
+			case DbgChannel::PE: return "PE";
+			case DbgChannel::VI: return "VI";
+			case DbgChannel::GP: return "GP";
+			case DbgChannel::PI: return "PI";
+			case DbgChannel::CPU: return "CPU";
+			case DbgChannel::MI: return "MI";
+			case DbgChannel::DSP: return "DSP";
+			case DbgChannel::DI: return "DI";
+			case DbgChannel::AR: return "AR";
+			case DbgChannel::AI: return "AI";
+			case DbgChannel::AIS: return "AIStream";
+			case DbgChannel::SI: return "SI";
+			case DbgChannel::EXI: return "EXI";
+			case DbgChannel::MC: return "MemCards";
+			case DbgChannel::DVD: return "DVD";
+			case DbgChannel::AX: return "AudioDAC";
+		}
+
+		return nullptr;
 	}
 
-	void EventLog::Add(DbgChannel chan, EventType type, std::vector<uint8_t>& arbitraryData)
+	uint32_t EventLog::ChannelMask()
 	{
-		char entryName[0x100] = { 0, };
+		uint32_t mask = 0;
+
+		for (uint32_t chan = 0; chan < 32; chan++)
+		{
+			if (GetSubsystemName((DbgChannel)chan))
+				mask |= 1u << chan;
+		}
 
-		eventLock.Lock();
+		return mask;
+	}
 
-		Json::Value* subsystem = GetSubsystem(chan);
-		if (!subsystem)
+	// The ring is created when the thread logs for the first time and lives as long as the log.
+	EventRing* EventLog::GetRing()
+	{
+		if (threadRing.logId != id)
 		{
-			eventLock.Unlock();
-			return;
+			EventRing* ring = new EventRing();
+
+			ringsLock.Lock();
+			rings.push_back(ring);
+			ringsLock.Unlock();
+
+			threadRing.logId = id;
+			threadRing.ring = ring;
 		}
 
-		sprintf_s(entryName, sizeof(entryName) - 1, "%lld", Gekko::Gekko->GetTicks());
+		return threadRing.ring;
+	}
+
+	void EventLog::Write(DbgChannel chan, EventType type, const char* format, const uint8_t* data, size_t size)
+	{
+		EventRing* ring = GetRing();
+		uint64_t timestamp = Gekko::Gekko->GetTicks();
+		uint64_t seq = ring->writeSeq.load(std::memory_order_relaxed);
+		uint8_t flags = SlotFirst;
+		size_t done = 0;
+
+		size = (std::min)(size, maxRecordSize);
+
+		do
+		{
+			EventSlot& slot = ring->slots[seq & (EventRing::slotCount - 1)];
+			size_t chunk = (std::min)(size - done, sizeof(slot.payload));
+
+			slot.timestamp = timestamp;
+			slot.format = format;
+			slot.channel = (uint8_t)chan;
+			slot.type = (uint8_t)type;
+			slot.flags = flags;
+			slot.size = (uint8_t)chunk;
+			memcpy(slot.payload, data + done, chunk);
+
+			done += chunk;
+			flags = SlotNext;
+			seq++;
+
+		} while (done < size);
+
+		ring->writeSeq.store(seq, std::memory_order_release);
+	}
+
+	void EventLog::Add(DbgChannel chan, EventType type, const void* arbitraryData, size_t size)
+	{
+		if (!GetSubsystemName(chan))
+			return;
+
+		Write(chan, type, nullptr, (const uint8_t*)arbitraryData, size);
+	}
 
-		Json::Value * entry = subsystem->AddObject(entryName);
-		assert(entry);
+	void EventLog::AddReport(DbgChannel chan, const char* format, va_list args)
+	{
+		if (!GetSubsystemName(chan))
+			return;
 
-		Json::Value* typeVal = entry->AddInt("type", (int)type);
-		assert(typeVal);
-		Json::Value* data = entry->AddArray("data");
-		assert(data);
+		// Text without conversions is saved as is, so it does not have to be a literal.
 
-		for (size_t i = 0; i < arbitraryData.size(); i++)
+		if (!strchr(format, '%'))
 		{
-			data->AddInt(nullptr, arbitraryData.data()[i]);
+			Write(chan, EventType::DebugReport, nullptr, (const uint8_t*)format, strnlen(format, maxRecordSize));
+			return;
 		}
 
-		eventLock.Unlock();
+		uint8_t buf[maxRecordSize];
+		ArgPacker packer(buf, sizeof(buf));
+		const char* p = format;
+
+		while ((p = strchr(p, '%')) != nullptr)
+		{
+			FormatSpec spec;
+			p = ParseSpec(p, spec);
+
+			bool ok = true;
+
+			for (int i = 0; i < spec.stars; i++)
+			{
+				ok &= packer.PutValue((uint64_t)(int64_t)va_arg(args, int));
+			}
+
+			switch (spec.kind)
+			{
+				case ArgKind::Int32:
+				case ArgKind::Char:
+					ok &= packer.PutValue((uint64_t)(int64_t)va_arg(args, int));
+					break;
+				case ArgKind::Long:
+					ok &= packer.PutValue((uint64_t)(int64_t)va_arg(args, long));
+					break;
+				case ArgKind::Int64:
+					ok &= packer.PutValue((uint64_t)va_arg(args, long long));
+					break;
+				case ArgKind::Double:
+					ok &= packer.PutDouble(va_arg(args, double));
+					break;
+				case ArgKind::Pointer:
+					ok &= packer.PutValue((uint64_t)(uintptr_t)va_arg(args, void*));
+					break;
+				case ArgKind::String:
+					ok &= packer.PutString(va_arg(args, const char*));
+					break;
+				case ArgKind::WideString:
+					ok &= packer.PutWideString(va_arg(args, const wchar_t*));
+					break;
+				case ArgKind::Unknown:
+					ok = false;
+					break;
+			}
+
+			if (!ok)
+				break;
+		}
+
+		Write(chan, EventType::DebugReport, format, buf, packer.size);
 	}
 
 	void EventLog::ToString(std::string & jsonText)
 	{
-		size_t actualTextSize = 0;
-		eventHistory.GetSerializedTextSize((void *)jsonText.data(), -1, actualTextSize);
-		jsonText.resize(actualTextSize);
-		eventHistory.Serialize((void*)jsonText.data(), actualTextSize, actualTextSize);
+		struct Record
+		{
+			uint64_t timestamp;
+			const char* format;
+			DbgChannel channel;
+			EventType type;
+			std::vector<uint8_t> data;
+		};
+
+		std::vector<Record> records;
+
+		ringsLock.Lock();
+		std::vector<EventRing*> threadRings = rings;
+		ringsLock.Unlock();
+
+		// Collect the records of all threads
+
+		std::vector<EventSlot> copy(EventRing::slotCount);
+
+		for (auto ring : threadRings)
+		{
+			uint64_t head = ring->writeSeq.load(std::memory_order_acquire);
+			uint64_t base = head > EventRing::slotCount ? head - EventRing::slotCount : 0;
+
+			for (uint64_t seq = base; seq < head; seq++)
+			{
+				copy[seq - base] = ring->slots[seq & (EventRing::slotCount - 1)];
+			}
+
+			std::atomic_thread_fence(std::memory_order_acquire);
+			uint64_t head2 = ring->writeSeq.load(std::memory_order_relaxed);
+
+			// The producer writes a whole record before publishing it, so the oldest maxRecordSlots after head2
+			// could be overwritten while they were copied.
+
+			uint64_t valid = head2 + maxRecordSlots > EventRing::slotCount ? head2 + maxRecordSlots - EventRing::slotCount : 0;
+
+			Record* record = nullptr;
+
+			for (uint64_t seq = (std::max)(base, valid); seq < head; seq++)
+			{
+				EventSlot& slot = copy[seq - base];
+
+				if (slot.flags & SlotFirst)
+				{
+					records.emplace_back();
+					record = &records.back();
+					record->timestamp = slot.timestamp;
+					record->format = slot.format;
+					record->channel = (DbgChannel)slot.channel;
+					record->type = (EventType)slot.type;
+				}
+				else if (!(slot.flags & SlotNext) || record == nullptr)
+				{
+					continue;		// Tail of the record overwritten by the ring
+				}
+
+				record->data.insert(record->data.end(), slot.payload, slot.payload + slot.size);
+			}
+		}
+
+		std::stable_sort(records.begin(), records.end(),
+			[](const Record& a, const Record& b) { return a.timestamp < b.timestamp; });
+
+		// Convert to Json
+
+		Json eventHistory;
+		Json::Value* rootObj = eventHistory.root.AddObject(nullptr);
+		assert(rootObj);
+		Json::Value* subsystems = rootObj->AddObject("subsystems");
+		assert(subsystems);
+
+		std::string text;
+
+		for (auto& record : records)
+		{
+			const char* name = GetSubsystemName(record.channel);
+			if (!name)
+				continue;
+
+			Json::Value* subsystem = subsystems->ByName(name);
+			if (!subsystem)
+				subsystem = subsystems->AddObject(name);
+
+			char entryName[0x100] = { 0, };
+			sprintf_s(entryName, sizeof(entryName) - 1, "%lld", record.timestamp);
+
+			Json::Value* entry = subsystem->AddObject(entryName);
+			assert(entry);
+
+			Json::Value* typeVal = entry->AddInt("type", (int)record.type);
+			assert(typeVal);
+			Json::Value* data = entry->AddArray("data");
+			assert(data);
+
+			if (record.format)
+			{
+				text.clear();
+				FormatReport(record.format, record.data.data(), record.data.size(), text);
+
+				for (size_t i = 0; i < text.size(); i++)
+				{
+					data->AddInt(nullptr, (uint8_t)text[i]);
+				}
+			}
+			else
+			{
+				for (size_t i = 0; i < record.data.size(); i++)
+				{
+					data->AddInt(nullptr, record.data[i]);
+				}
+			}
+		}
+
+		jsonText.clear();
+		eventHistory.Serialize(jsonText);
 	}
 }
@@ -7,11 +7,15 @@
 #include "../Common/Json.h"
 #include "../Common/Spinlock.h"
 #include "Debugger.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdarg>
+#include <string>
 #include <vector>
 
 namespace Debug
 {
-	// As new types from different subsystems are added, this enumeration runs the risk of being too de-encapsulated, 
+	// As new types from different subsystems are added, this enumeration runs the risk of being too de-encapsulated,
 	// but since Event Log is virtually used by all subsystems, this is normal.
 
 	enum class EventType : size_t
@@ -22,22 +26,61 @@ namespace Debug
 
 	};
 
+	// Binary event record. Records that do not fit in one slot continue in the next slots of the same ring.
+	struct EventSlot
+	{
+		uint64_t timestamp;			// Gekko ticks
+		const char* format;			// DBReport2 format string (payload = packed arguments) or nullptr (payload = raw data)
+		uint8_t channel;			// DbgChannel
+		uint8_t type;				// EventType
+		uint8_t flags;
+		uint8_t size;				// Payload bytes used in this slot
+		uint8_t payload[108];
+	};
+
+	static_assert(sizeof(EventSlot) == 128, "EventSlot must be 128 bytes");
+
+	// Ring of one producer thread. Slots are overwritten when the ring wraps around.
+	// The exporter copies the slots without any lock and then checks against the write counter which of them were not overwritten meanwhile.
+	struct EventRing
+	{
+		static const size_t slotCount = 0x4000;
+		EventSlot* slots = nullptr;
+		std::atomic<uint64_t> writeSeq = 0;		// Free-running, published after the whole record is written
+
+		EventRing();
+		~EventRing();
+	};
+
 	class EventLog
 	{
-		Json eventHistory;
-		Json::Value* rootObj;
-		Json::Value* subsystems;
-		// All enumerated collections are protected by a lock.
-		SpinLock eventLock;
+		static const size_t maxRecordSize = 0x1000;
+		static const size_t maxRecordSlots = (maxRecordSize + sizeof(EventSlot::payload) - 1) / sizeof(EventSlot::payload);
+
+		// Each thread that logs gets its own ring. The lock is only taken when a thread logs for the first time and on export.
+		std::vector<EventRing*> rings;
+		SpinLock ringsLock;
+		uint64_t id;			// Tells apart the thread-local ring caches of different EventLog instances
 
-		Json::Value* GetSubsystem(DbgChannel chan);
+		EventRing* GetRing();
+		void Write(DbgChannel chan, EventType type, const char* format, const uint8_t* data, size_t size);
+
+		static const char* GetSubsystemName(DbgChannel chan);
 
 	public:
 		EventLog();
 		~EventLog();
 
 		/// @brief Add an event to the history.
-		void Add(DbgChannel chan, EventType type, std::vector<uint8_t>& arbitraryData);
+		void Add(DbgChannel chan, EventType type, const void* arbitraryData, size_t size);
+		void Add(DbgChannel chan, EventType type, std::vector<uint8_t>& arbitraryData) { Add(chan, type, arbitraryData.data(), arbitraryData.size()); }
+
+		/// @brief Add a debug message. Only the arguments are saved, the message is formatted when the history is exported,
+		/// so the format must be a string literal (or otherwise live as long as the log).
+		void AddReport(DbgChannel chan, const char* format, va_list args);
+
+		/// @brief Channels saved in the history (bit mask by DbgChannel).
+		static uint32_t ChannelMask();
 
 		/// @brief Get event history as serialized Json text. Then you can save the text to a file or transfer it to the utility to display the history.
 		void ToString(std::string & jsonText);
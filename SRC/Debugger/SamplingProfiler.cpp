@@ -1,62 +1,312 @@
+// Sampling Profiler.
+
+// Samples are taken by a hook from the Gekko timer update at a fixed interval of emulated time and are written
+// to a preallocated buffer. Nothing is formatted or symbolized until the profiler is stopped.
+
 #include "pch.h"
 
 namespace Debug
 {
-	void SamplingProfiler::ThreadProc(void* Parameter)
+	static const char ProfileMagic[8] = { 'D', 'O', 'L', 'W', 'P', 'R', 'O', 'F' };
+	static const uint32_t ProfileVersion = 1;
+
+	void SamplingProfiler::SampleHook(void* context, Gekko::GekkoCore* core)
 	{
-		SamplingProfiler* profiler = (SamplingProfiler *)Parameter;
+		SamplingProfiler* profiler = (SamplingProfiler *)context;
 
-		while (true)
+		uint32_t frames[MaxStackDepth];
+		size_t depth = profiler->WalkStack(core, frames);
+
+		if (profiler->used + 3 + depth > bufferWords)
 		{
-			uint64_t ticks = Gekko::Gekko->GetTicks();
-			if (ticks >= (profiler->savedGekkoTbr + profiler->pollingInterval))
-			{
-				profiler->savedGekkoTbr = ticks;
+			profiler->dropped++;
+			return;
+		}
 
-				profiler->sampleData->AddUInt64(nullptr, ticks);
-				profiler->sampleData->AddUInt32(nullptr, Gekko::Gekko->regs.pc);
-			}
+		uint64_t ticks = core->GetTicks();
+		uint32_t* sample = &profiler->buffer[profiler->used];
+
+		sample[0] = (uint32_t)ticks;
+		sample[1] = (uint32_t)(ticks >> 32);
+		sample[2] = (uint32_t)depth;
+		memcpy(&sample[3], frames, depth * sizeof(uint32_t));
+
+		profiler->used += 3 + depth;
+		profiler->samples++;
+	}
+
+	// The MMU does not throw exceptions and the memory is read directly, so walking a broken stack is harmless.
+	bool SamplingProfiler::ReadStackWord(Gekko::GekkoCore* core, uint32_t ea, uint32_t& value)
+	{
+		int WIMG;
+
+		if (ea & 3)
+			return false;
+
+		uint32_t pa = core->EffectiveToPhysical(ea, Gekko::MmuAccess::Read, WIMG);
+		if (pa == Gekko::BadAddress)
+			return false;
+
+		uint8_t* ptr = MITranslatePhysicalAddress(pa, sizeof(uint32_t));
+		if (ptr == nullptr)
+			return false;
+
+		value = _byteswap_ulong(*(uint32_t*)ptr);
+		return true;
+	}
+
+	// EABI frame: [sp] is the back chain (caller's sp), [caller's sp + 4] is where the function saved its LR.
+	size_t SamplingProfiler::WalkStack(Gekko::GekkoCore* core, uint32_t* frames)
+	{
+		size_t depth = 0;
+
+		frames[depth++] = core->regs.pc;
+		if (depth >= maxDepth)
+			return depth;
+
+		// A leaf function does not save LR, so take it from the register. The reporter drops it if it turns out to be stale.
+		frames[depth++] = core->regs.spr[(int)Gekko::SPR::LR];
+
+		uint32_t sp = core->regs.gpr[1];
+
+		while (depth < maxDepth)
+		{
+			uint32_t backChain, lr;
+
+			if (!ReadStackWord(core, sp, backChain))
+				break;
+			if (backChain <= sp || backChain == 0xffff'ffff)
+				break;		// The stack grows down
+			if (!ReadStackWord(core, backChain + 4, lr) || lr == 0)
+				break;
+
+			frames[depth++] = lr;
+			sp = backChain;
 		}
+
+		return depth;
 	}
 
-	SamplingProfiler::SamplingProfiler(const char* jsonFileName, int periodMs)
+	void SamplingProfiler::InstallHook(void* context)
 	{
-		strcpy_s(filename, sizeof(filename) - 1, jsonFileName);
+		SamplingProfiler* profiler = (SamplingProfiler*)context;
+		Gekko::Gekko->SetSampleHook(SampleHook, profiler, profiler->interval);
+	}
 
-		pollingInterval = periodMs * Gekko::Gekko->OneMillisecond();
-		savedGekkoTbr = Gekko::Gekko->GetTicks();
+	void SamplingProfiler::RemoveHook(void* context)
+	{
+		Gekko::Gekko->SetSampleHook(nullptr, nullptr, 0);
+	}
 
-		json = new Json();
-		assert(json);
+	SamplingProfiler::SamplingProfiler(const char* sampleFileName, int intervalUs, int stackDepth)
+	{
+		strcpy_s(filename, sizeof(filename) - 1, sampleFileName);
 
-		rootObj = json->root.AddObject(nullptr);
-		assert(rootObj);
+		interval = (uint64_t)intervalUs * Gekko::Gekko->OneSecond() / 1000000;
+		maxDepth = min(max(stackDepth, 1), (int)MaxStackDepth);
 
-		sampleData = rootObj->AddArray("sampleData");
-		assert(sampleData);
+		buffer = new uint32_t[bufferWords];
+		assert(buffer);
 
-		thread = new Thread(ThreadProc, false, this, "SamplingProfiler");
-		assert(thread);
+		Gekko::Gekko->RunAtSafePoint(InstallHook, this);
 	}
 
 	SamplingProfiler::~SamplingProfiler()
 	{
-		delete thread;
+		// The hook is not running after this, the buffer can be used
+		Gekko::Gekko->RunAtSafePoint(RemoveHook, nullptr);
+
+		ProfileHeader header = { 0 };
+		memcpy(header.magic, ProfileMagic, sizeof(header.magic));
+		header.version = ProfileVersion;
+		header.maxDepth = (uint32_t)maxDepth;
+		header.interval = interval;
+		header.oneSecond = Gekko::Gekko->OneSecond();
+		header.samples = samples;
+		header.dropped = dropped;
+
+		std::vector<uint8_t> data(sizeof(header) + used * sizeof(uint32_t));
+		memcpy(data.data(), &header, sizeof(header));
+		memcpy(data.data() + sizeof(header), buffer, used * sizeof(uint32_t));
+		UI::FileSave(filename, data);
+
+		ProfileReport::Generate(filename, &header, buffer, used);
+
+		delete[] buffer;
+	}
+
+	#pragma region "Report"
+
+	struct FunctionStats
+	{
+		uint64_t self = 0;			// PC was in the function
+		uint64_t total = 0;			// Function was somewhere in the stack
+		uint64_t lastSample = UINT64_MAX;
+	};
 
-		size_t textSize = 0;
+	// Unknown code is grouped by 32-byte segments.
+	static const std::string& Symbolize(uint32_t address, std::unordered_map<uint32_t, std::string>& cache)
+	{
+		auto it = cache.find(address);
+		if (it != cache.end())
+			return it->second;
 
-		json->GetSerializedTextSize(nullptr, -1, textSize);
-		
-		uint8_t* jsonText = new uint8_t[2 * textSize];
-		assert(jsonText);
+		size_t offset = 0;
+		char* name = SYMGetNearestName(address, offset);
+		char text[0x20];
 
-		json->Serialize(jsonText, 2 * textSize, textSize);
+		if (name == nullptr)
+		{
+			sprintf_s(text, sizeof(text) - 1, "%08X", address & ~0x1f);
+			name = text;
+		}
 
-		auto buffer = std::vector<uint8_t>(jsonText, jsonText + textSize);
-		UI::FileSave(filename, buffer);
+		return cache.emplace(address, name).first->second;
+	}
 
-		delete[] jsonText;
-		delete json;
+	static bool SaveText(std::string& filename, std::string& text)
+	{
+		std::vector<uint8_t> data(text.begin(), text.end());
+		return UI::FileSave(filename, data);
 	}
 
+	bool ProfileReport::Generate(const char* sampleFileName)
+	{
+		auto data = UI::FileLoad(sampleFileName);
+
+		if (data.size() < sizeof(ProfileHeader) || memcmp(data.data(), ProfileMagic, sizeof(ProfileMagic)) != 0)
+		{
+			DBReport("Not a profiler sample file: %s\n", sampleFileName);
+			return false;
+		}
+
+		ProfileHeader* header = (ProfileHeader*)data.data();
+		if (header->version != ProfileVersion)
+		{
+			DBReport("Unsupported sample file version: %i\n", header->version);
+			return false;
+		}
+
+		size_t words = (data.size() - sizeof(ProfileHeader)) / sizeof(uint32_t);
+		std::vector<uint32_t> samples(words);
+		memcpy(samples.data(), data.data() + sizeof(ProfileHeader), words * sizeof(uint32_t));
+
+		return Generate(sampleFileName, header, samples.data(), words);
+	}
+
+	bool ProfileReport::Generate(const char* sampleFileName, const ProfileHeader* header, const uint32_t* data, size_t words)
+	{
+		std::unordered_map<uint32_t, std::string> symbols;
+		std::unordered_map<std::string, FunctionStats> functions;
+		std::map<std::string, uint64_t> folded;
+		std::vector<const std::string*> stack;
+		uint64_t sampleCount = 0;
+		uint64_t firstTicks = 0, lastTicks = 0;
+
+		for (size_t pos = 0; pos + 3 <= words; )
+		{
+			uint64_t ticks = (uint64_t)data[pos] | ((uint64_t)data[pos + 1] << 32);
+			size_t depth = data[pos + 2];
+			const uint32_t* frames = &data[pos + 3];
+
+			if (depth == 0 || pos + 3 + depth > words)
+				break;
+			pos += 3 + depth;
+
+			if (sampleCount == 0)
+				firstTicks = ticks;
+			lastTicks = ticks;
+
+			stack.clear();
+
+			for (size_t i = 0; i < depth; i++)
+			{
+				const std::string& name = Symbolize(frames[i], symbols);
+
+				// LR is stale if the function already saved it (equals the next frame) or has called something since (points into the function itself).
+				if (i == 1 && ((depth > 2 && frames[1] == frames[2]) || name == *stack[0]))
+					continue;
+
+				stack.push_back(&name);
+			}
+
+			// Flat profile
+
+			functions[*stack[0]].self++;
+
+			for (auto name : stack)
+			{
+				FunctionStats& stats = functions[*name];
+				if (stats.lastSample != sampleCount)
+				{
+					stats.lastSample = sampleCount;		// Count recursion once
+					stats.total++;
+				}
+			}
+
+			// Folded stack, the outermost caller first
+
+			std::string line;
+			for (auto it = stack.rbegin(); it != stack.rend(); ++it)
+			{
+				if (!line.empty())
+					line.push_back(';');
+				for (char c : **it)
+					line.push_back((c == ';' || c == ' ') ? '_' : c);
+			}
+			folded[line]++;
+
+			sampleCount++;
+		}
+
+		// Flat profile, sorted by self samples
+
+		std::vector<std::pair<std::string, FunctionStats>> sorted(functions.begin(), functions.end());
+		std::sort(sorted.begin(), sorted.end(),
+			[](auto& a, auto& b) { return a.second.self != b.second.self ? a.second.self > b.second.self : a.second.total > b.second.total; });
+
+		std::string text;
+		char line[0x400];
+
+		double seconds = header->oneSecond ? (double)(lastTicks - firstTicks) / header->oneSecond : 0;
+		sprintf_s(line, sizeof(line) - 1, "Samples: %lld (dropped: %lld), interval: %lld ticks, max depth: %i, emulated time: %.3f s\n\n",
+			sampleCount, header->dropped, header->interval, header->maxDepth, seconds);
+		text += line;
+		sprintf_s(line, sizeof(line) - 1, "%8s %10s %8s %10s  %s\n", "Self %", "Self", "Total %", "Total", "Function");
+		text += line;
+
+		for (auto& entry : sorted)
+		{
+			double total = sampleCount ? (double)sampleCount : 1;
+			sprintf_s(line, sizeof(line) - 1, "%8.2f %10lld %8.2f %10lld  %s\n",
+				100.0 * entry.second.self / total, entry.second.self,
+				100.0 * entry.second.total / total, entry.second.total,
+				entry.first.c_str());
+			text += line;
+		}
+
+		std::string flatName = std::string(sampleFileName) + ".txt";
+		bool ok = SaveText(flatName, text);
+
+		// Folded stacks
+
+		text.clear();
+		for (auto& entry : folded)
+		{
+			text += entry.first;
+			sprintf_s(line, sizeof(line) - 1, " %lld\n", entry.second);
+			text += line;
+		}
+
+		std::string foldedName = std::string(sampleFileName) + ".folded";
+		ok &= SaveText(foldedName, text);
+
+		DBReport("Profile: %lld samples, %zi functions. Saved %s and %s\n",
+			sampleCount, sorted.size(), flatName.c_str(), foldedName.c_str());
+
+		return ok;
+	}
+
+	#pragma endregion "Report"
+
 }
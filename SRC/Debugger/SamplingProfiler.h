@@ -3,26 +3,69 @@
 
 #pragma once
 
+#include <algorithm>
+#include <atomic>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
 namespace Debug
 {
+	// Sample file header. The samples follow as 32-bit words: TBR low, TBR high, depth, frames[depth].
+	// frames[0] is PC, frames[1] is LR, the rest are the return addresses found by the back chain of the guest stack.
+
+	struct ProfileHeader
+	{
+		char magic[8];				// DOLWPROF
+		uint32_t version;
+		uint32_t maxDepth;
+		uint64_t interval;			// Gekko ticks between samples
+		uint64_t oneSecond;			// Gekko ticks per second
+		uint64_t samples;
+		uint64_t dropped;			// Samples lost because the buffer was full
+	};
 
 	class SamplingProfiler
 	{
+		static const size_t bufferWords = 16 * 1024 * 1024;		// 64 MB, about an hour of 1 ms samples with short stacks
+
 		char filename[0x1000] = { 0, };
 
-		Thread* thread = nullptr;
-		static void ThreadProc(void* Parameter);
+		uint64_t interval = 0;
+		size_t maxDepth = 1;
+
+		uint32_t* buffer = nullptr;
+		size_t used = 0;
+		uint64_t samples = 0;
+		uint64_t dropped = 0;
+
+		// The hook runs on the Gekko thread, so it is installed and removed there (at the safe point)
+		static void InstallHook(void* context);
+		static void RemoveHook(void* context);
 
-		uint64_t pollingInterval = 100;			// Program Counter polling frequency
-		uint64_t savedGekkoTbr = 0;
+		static void SampleHook(void* context, Gekko::GekkoCore* core);
+		size_t WalkStack(Gekko::GekkoCore* core, uint32_t* frames);
+		static bool ReadStackWord(Gekko::GekkoCore* core, uint32_t ea, uint32_t& value);
+
+	public:
+		static const size_t MaxStackDepth = 64;
+
+		SamplingProfiler(const char* sampleFileName, int intervalUs, int stackDepth);
+		~SamplingProfiler();		// Saves the samples and generates the report
+	};
+
+	// Offline reporter. Symbolizes the samples with the loaded map and writes <file>.txt (flat profile)
+	// and <file>.folded (folded stacks for flamegraph.pl).
+
+	class ProfileReport
+	{
+		static bool Generate(const char* sampleFileName, const ProfileHeader* header, const uint32_t* data, size_t words);
 
-		Json* json = nullptr;
-		Json::Value* rootObj = nullptr;
-		Json::Value* sampleData = nullptr;
+		friend class SamplingProfiler;
 
 	public:
-		SamplingProfiler(const char* jsonFileName, int periodMs);
-		~SamplingProfiler();
+		static bool Generate(const char* sampleFileName);
 	};
 
 }
@@ -129,7 +129,7 @@ Json::Value* cmd_blr(std::vector<std::string>& args)
     }
     else
     {
-        if(emu.loaded) return nullptr;
+        if(emu->loaded) return nullptr;
 
         int WIMG;
         uint32_t ea = con.disa_cursor;
@@ -140,24 +140,26 @@ Json::Value* cmd_blr(std::vector<std::string>& args)
         }
         if(pa == Gekko::BadAddress) return nullptr;
 
-        uint32_t op = _byteswap_ulong(*(uint32_t*)(&mi.ram[pa]));
+        uint32_t op = _byteswap_ulong(*(uint32_t*)(&mi->ram[pa]));
         if(op == 0x4e800020) return nullptr;
 
         int ofs = 0;
         if(args.size() >= 2)           // value, to simulate "return X"
         {
             uint32_t iVal = strtoul(args[1].c_str(), NULL, 0) & 0xffff;
-            mi.ram[pa+0] = 0x38;
-            mi.ram[pa+1] = 0;
-            mi.ram[pa+2] = (uint8_t)(iVal >> 8);
-            mi.ram[pa+3] = (uint8_t)iVal;
+            mi->ram[pa+0] = 0x38;
+            mi->ram[pa+1] = 0;
+            mi->ram[pa+2] = (uint8_t)(iVal >> 8);
+            mi->ram[pa+3] = (uint8_t)iVal;
             ofs = 4;
         }
         
-        mi.ram[pa+ofs+0] = 0x4e;   // BLR
-        mi.ram[pa+ofs+1] = 0x80;
-        mi.ram[pa+ofs+2] = 0;
-        mi.ram[pa+ofs+3] = 0x20;
+        mi->ram[pa+ofs+0] = 0x4e;   // BLR
+        mi->ram[pa+ofs+1] = 0x80;
+        mi->ram[pa+ofs+2] = 0;
+        mi->ram[pa+ofs+3] = 0x20;
+        mi->dirty.Mark(pa, ofs + 4);
+        Gekko::Gekko->InvalidateCodeAtSafePoint(ea, ofs + 4);
 
         con.update |= (CON_UPDATE_DISA | CON_UPDATE_DATA);
     }
@@ -275,7 +277,7 @@ Json::Value* cmd_disa(std::vector<std::string>& args)
     }
     else
     {
-        if(!emu.loaded)
+        if(!emu->loaded)
         {
             DBReport("not loaded\n");
             return nullptr;
@@ -416,7 +418,7 @@ Json::Value* cmd_lr(std::vector<std::string>& args)
         PPCD_CB disa;
         uint32_t sp;
 
-        if(!emu.loaded || !Gekko::Gekko->regs.gpr[1])
+        if(!emu->loaded || !Gekko::Gekko->regs.gpr[1])
         {
             DBReport("not running, or no calls.\n");
             return nullptr;
@@ -485,7 +487,7 @@ static uint32_t get_nop(uint32_t ea)
 
 Json::Value* cmd_nop(std::vector<std::string>& args)
 {
-    if(!emu.loaded) return nullptr;
+    if(!emu->loaded) return nullptr;
 
     uint32_t ea = con.disa_cursor;
     uint32_t pa = Gekko::BadAddress;
@@ -496,9 +498,11 @@ Json::Value* cmd_nop(std::vector<std::string>& args)
     }
     if(pa == Gekko::BadAddress) return nullptr;
     
-    uint32_t old = _byteswap_ulong(*(uint32_t*)(&mi.ram[pa]));
-    mi.ram[pa] = 0x60;
-    mi.ram[pa+1] = mi.ram[pa+2] = mi.ram[pa+3] = 0;
+    uint32_t old = _byteswap_ulong(*(uint32_t*)(&mi->ram[pa]));
+    mi->ram[pa] = 0x60;
+    mi->ram[pa+1] = mi->ram[pa+2] = mi->ram[pa+3] = 0;
+    mi->dirty.Mark(pa, 4);
+    Gekko::Gekko->InvalidateCodeAtSafePoint(ea, 4);
     add_nop(ea, old);
 
     con.update |= (CON_UPDATE_DISA | CON_UPDATE_DATA);
@@ -507,7 +511,7 @@ Json::Value* cmd_nop(std::vector<std::string>& args)
 
 Json::Value* cmd_denop(std::vector<std::string>& args)
 {
-    if(!emu.loaded) return nullptr;
+    if(!emu->loaded) return nullptr;
 
     uint32_t ea = con.disa_cursor;
     uint32_t pa = Gekko::BadAddress;
@@ -520,10 +524,12 @@ Json::Value* cmd_denop(std::vector<std::string>& args)
 
     uint32_t old = get_nop(ea);
     if(old == 0) return nullptr;
-    mi.ram[pa+0] = (uint8_t)(old >> 24);
-    mi.ram[pa+1] = (uint8_t)(old >> 16);
-    mi.ram[pa+2] = (uint8_t)(old >>  8);
-    mi.ram[pa+3] = (uint8_t)(old >>  0);
+    mi->ram[pa+0] = (uint8_t)(old >> 24);
+    mi->ram[pa+1] = (uint8_t)(old >> 16);
+    mi->ram[pa+2] = (uint8_t)(old >>  8);
+    mi->ram[pa+3] = (uint8_t)(old >>  0);
+    mi->dirty.Mark(pa, 4);
+    Gekko::Gekko->InvalidateCodeAtSafePoint(ea, 4);
 
     con.update |= (CON_UPDATE_DISA | CON_UPDATE_DATA);
     return nullptr;
@@ -704,7 +710,7 @@ Json::Value* cmd_tree (std::vector<std::string>& args)
     }
     else
     {
-        if(!emu.loaded)
+        if(!emu->loaded)
         {
             DBReport("not loaded\n");
             return nullptr;
@@ -14,13 +14,13 @@ static const char *hexbyte(uint32_t addr)
         pa = Gekko::Gekko->EffectiveToPhysical(addr, Gekko::MmuAccess::Read, WIMG);
     }
 
-    if (mi.ram)
+    if (mi->ram)
     {
         if (pa != Gekko::BadAddress)
         {
             if (pa < RAMSIZE)
             {
-                sprintf_s (buf, sizeof(buf), "%02X", mi.ram[pa]);
+                sprintf_s (buf, sizeof(buf), "%02X", mi->ram[pa]);
                 return buf;
             }
         }
@@ -42,11 +42,11 @@ static const char *charbyte(uint32_t addr)
         pa = Gekko::Gekko->EffectiveToPhysical(addr, Gekko::MmuAccess::Read, WIMG);
     }
 
-    if (mi.ram && pa != Gekko::BadAddress)
+    if (mi->ram && pa != Gekko::BadAddress)
     {
         if (pa < RAMSIZE)
         {
-            uint8_t data = mi.ram[pa];
+            uint8_t data = mi->ram[pa];
             if ((data >= 32) && (data <= 255)) sprintf_s(buf, sizeof(buf), "%c\0", data);
             return buf;
         }
@@ -1,10 +1,10 @@
 // registers view
 #include "pch.h"
 
-#define FPRU(n) (Gekko::Gekko->regs.fpr[n].uval)
-#define FPRD(n) (Gekko::Gekko->regs.fpr[n].dbl)
-#define PS0(n)  (Gekko::Gekko->regs.fpr[n].dbl)
-#define PS1(n)  (Gekko::Gekko->regs.ps1[n].dbl)
+#define FPRU(n) (Gekko::Gekko->regs.fpr[n].ps0.uval)
+#define FPRD(n) (Gekko::Gekko->regs.fpr[n].ps0.dbl)
+#define PS0(n)  (Gekko::Gekko->regs.fpr[n].ps0.dbl)
+#define PS1(n)  (Gekko::Gekko->regs.fpr[n].ps1.dbl)
 
 // register memory
 static uint32_t gpr_old[32];
@@ -24,8 +24,8 @@ void con_memorize_cpu_regs()
     for(int i=0; i<32; i++)
     {
         gpr_old[i] = Gekko::Gekko->regs.gpr[i];
-        ps0_old[i].uval = Gekko::Gekko->regs.fpr[i].uval;
-        ps1_old[i].uval = Gekko::Gekko->regs.ps1[i].uval;
+        ps0_old[i].uval = Gekko::Gekko->regs.fpr[i].ps0.uval;
+        ps1_old[i].uval = Gekko::Gekko->regs.fpr[i].ps1.uval;
     }
 }
 
@@ -99,7 +99,7 @@ static void con_print_fpreg(int x, int y, int num)
 {
     ULARGE_INTEGER li;
 
-    if(Gekko::Gekko->regs.fpr[num].uval != ps0_old[num].uval)
+    if(Gekko::Gekko->regs.fpr[num].ps0.uval != ps0_old[num].uval)
     {
         if(FPRD(num) >= 0.0) con_printf_at(x, y, "\x1%cf%-2i  \x1%c%e", ConColor::CYAN, num, ConColor::GREEN, FPRD(num));
         else con_printf_at(x, y, "\x1%cf%-2i \x1%c%e", ConColor::CYAN, num, ConColor::GREEN, FPRD(num));
@@ -107,7 +107,7 @@ static void con_print_fpreg(int x, int y, int num)
         li.QuadPart = FPRU(num);
         con_printf_at(x + 20, y, "\x1%c%.8X %.8X", ConColor::GREEN, li.HighPart, li.LowPart);
 
-        ps0_old[num].uval = Gekko::Gekko->regs.fpr[num].uval;
+        ps0_old[num].uval = Gekko::Gekko->regs.fpr[num].ps0.uval;
     }
     else
     {
@@ -121,12 +121,12 @@ static void con_print_fpreg(int x, int y, int num)
 
 static void con_print_ps(int x, int y, int num)
 {
-    if(Gekko::Gekko->regs.fpr[num].uval != ps0_old[num].uval)
+    if(Gekko::Gekko->regs.fpr[num].ps0.uval != ps0_old[num].uval)
     {
         if(PS0(num) >= 0.0f) con_printf_at(x, y, "\x1%cps%-2i  \x1%c%.4e", ConColor::CYAN, num, ConColor::GREEN, PS0(num));
         else con_printf_at(x, y, "\x1%cps%-2i \x1%c%.4e", ConColor::CYAN, num, ConColor::GREEN, PS0(num));
         
-        ps0_old[num].uval = Gekko::Gekko->regs.fpr[num].uval;
+        ps0_old[num].uval = Gekko::Gekko->regs.fpr[num].ps0.uval;
     }
     else
     {
@@ -134,12 +134,12 @@ static void con_print_ps(int x, int y, int num)
         else con_printf_at(x, y, "\x1%cps%-2i \x1%c%.4e", ConColor::CYAN, num, ConColor::NORM, PS0(num));
     }
 
-    if(Gekko::Gekko->regs.ps1[num].uval != ps1_old[num].uval)
+    if(Gekko::Gekko->regs.fpr[num].ps1.uval != ps1_old[num].uval)
     {
         if(PS1(num) >= 0.0f) con_printf_at(x + 18, y, "\x1%c %.4e", ConColor::GREEN, PS1(num));
         else con_printf_at(x + 18, y, "\x1%c%.4e", ConColor::GREEN, PS1(num));
         
-        ps1_old[num].uval = Gekko::Gekko->regs.ps1[num].uval;
+        ps1_old[num].uval = Gekko::Gekko->regs.fpr[num].ps1.uval;
     }
     else
     {
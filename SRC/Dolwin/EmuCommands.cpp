@@ -100,13 +100,13 @@ static Json::Value* GetLoadedInternal(std::vector<std::string>& args)
 {
 	UNREFERENCED_PARAMETER(args);
 
-	if (!emu.loaded)
+	if (!emu->loaded)
 		return nullptr;
 
 	Json::Value* output = new Json::Value();
 	output->type = Json::ValueType::Object;
 
-	output->AddString("loaded", ldat.currentFile.c_str());
+	output->AddString("loaded", ldat->currentFile.c_str());
 
 	return output;
 }
@@ -137,7 +137,7 @@ static Json::Value* cmd_unload(std::vector<std::string>& args)
 {
 	UNREFERENCED_PARAMETER(args);
 
-	if (emu.loaded)
+	if (emu->loaded)
 	{
 		EMUClose();
 	}
@@ -149,7 +149,7 @@ static Json::Value* cmd_dop(std::vector<std::string>& args)
 {
 	UNREFERENCED_PARAMETER(args);
 
-	if (ldat.patches.size() == 0)
+	if (ldat->patches.size() == 0)
 	{
 		//DBReport("no patch data loaded.\n");
 		return nullptr;
@@ -162,7 +162,7 @@ static Json::Value* cmd_plist(std::vector<std::string>& args)
 {
 	UNREFERENCED_PARAMETER(args);
 
-	if (ldat.patches.size() == 0)
+	if (ldat->patches.size() == 0)
 	{
 		DBReport("no patch data loaded.\n");
 		return nullptr;
@@ -170,7 +170,7 @@ static Json::Value* cmd_plist(std::vector<std::string>& args)
 
 	DBReport("i----addr-----data-------------s-f-\n");
 	int count = 0;
-	for (auto it = ldat.patches.begin(); it != ldat.patches.end(); ++it)
+	for (auto it = ldat->patches.begin(); it != ldat->patches.end(); ++it)
 	{
 		Patch* p = *it;
 		uint8_t* data = (uint8_t*)&p->data;
@@ -221,7 +221,7 @@ static Json::Value* IsLoadedInternal(std::vector<std::string>& args)
 	Json::Value* output = new Json::Value();
 	output->type = Json::ValueType::Bool;
 
-	output->value.AsBool = emu.loaded;
+	output->value.AsBool = emu->loaded;
 	
 	return output;
 }
@@ -237,6 +237,197 @@ static Json::Value* GetVersionInternal(std::vector<std::string>& args)
 	return output;
 }
 
+static Debug::PerfCsvDump* perfCsv = nullptr;
+
+// Show the performance counters and return them as Json object
+static Json::Value* cmd_PerfCounters(std::vector<std::string>& args)
+{
+	if (args.size() > 1 && args[1] == "reset")
+	{
+		Debug::PerfCounters::Reset();
+		DBReport("Performance counters reset\n");
+		return nullptr;
+	}
+
+	Json::Value* output = Debug::PerfCounters::ToJson();
+
+	for (auto child : output->children)
+	{
+		DBReport("%-30s %lld\n", child->name, child->value.AsInt);
+	}
+
+	return output;
+}
+
+static Json::Value* cmd_PerfCsv(std::vector<std::string>& args)
+{
+	if (perfCsv)
+	{
+		delete perfCsv;
+		perfCsv = nullptr;
+		DBReport("Performance counters dump stopped\n");
+	}
+
+	if (args[1] == "off")
+	{
+		return nullptr;
+	}
+
+	int periodMs = args.size() > 2 ? atoi(args[2].c_str()) : 1000;
+
+	perfCsv = new Debug::PerfCsvDump(args[1].c_str(), periodMs);
+	if (!perfCsv->IsOpen())
+	{
+		DBReport2(DbgChannel::Error, "Failed to create file: %s\n", args[1].c_str());
+		delete perfCsv;
+		perfCsv = nullptr;
+		return nullptr;
+	}
+
+	DBReport("Performance counters are dumped to %s every %i ms\n", args[1].c_str(), periodMs);
+	return nullptr;
+}
+
+// Snapshots kept in memory by the Snapshot command
+static std::vector<std::shared_ptr<Snapshot>> snapshots;
+
+static Json::Value* cmd_SaveState(std::vector<std::string>& args)
+{
+	if (!emu->loaded)
+	{
+		DBReport2(DbgChannel::Error, "Not loaded\n");
+		return nullptr;
+	}
+
+	// Only the pages written since the last snapshot are copied here, the worker merges them with the older ones into the file
+	std::shared_ptr<Snapshot> snapshot = Snapshot::Capture(false);
+	SnapshotWorker::Post(snapshot, args[1]);
+	return nullptr;
+}
+
+static Json::Value* cmd_LoadState(std::vector<std::string>& args)
+{
+	if (!emu->loaded)
+	{
+		DBReport2(DbgChannel::Error, "Not loaded\n");
+		return nullptr;
+	}
+
+	// The file may still be written by the worker
+	SnapshotWorker::Flush();
+
+	std::shared_ptr<Snapshot> snapshot = Snapshot::LoadFile(args[1].c_str());
+	if (snapshot && Snapshot::Restore(snapshot))
+	{
+		DBReport("Loaded state: %s\n", args[1].c_str());
+	}
+	return nullptr;
+}
+
+// Take a snapshot in memory and return its number
+static Json::Value* cmd_Snapshot(std::vector<std::string>& args)
+{
+	if (args.size() > 1 && args[1] == "clear")
+	{
+		snapshots.clear();
+		DBReport("Snapshots cleared\n");
+		return nullptr;
+	}
+
+	if (!emu->loaded)
+	{
+		DBReport2(DbgChannel::Error, "Not loaded\n");
+		return nullptr;
+	}
+
+	bool full = args.size() > 1 && args[1] == "full";
+	bool compress = args.size() > 1 && args.back() == "lz4";
+
+	std::shared_ptr<Snapshot> snapshot = Snapshot::Capture(full);
+	snapshots.push_back(snapshot);
+
+	DBReport("Snapshot %zi: %s, %zi KB\n", snapshots.size() - 1, snapshot->IsFull() ? "full" : "incremental", snapshot->Size() / 1024);
+
+	if (compress)
+	{
+		SnapshotWorker::Post(snapshot, "");
+	}
+
+	Json::Value* output = new Json::Value();
+	output->type = Json::ValueType::Int;
+	output->value.AsInt = (int64_t)snapshots.size() - 1;
+	return output;
+}
+
+static Json::Value* cmd_RestoreSnapshot(std::vector<std::string>& args)
+{
+	if (!emu->loaded || snapshots.empty())
+	{
+		DBReport2(DbgChannel::Error, "No snapshots\n");
+		return nullptr;
+	}
+
+	size_t n = args.size() > 1 ? (size_t)atoi(args[1].c_str()) : snapshots.size() - 1;
+	if (n >= snapshots.size())
+	{
+		DBReport2(DbgChannel::Error, "No such snapshot: %zi\n", n);
+		return nullptr;
+	}
+
+	auto started = std::chrono::steady_clock::now();
+
+	if (Snapshot::Restore(snapshots[n]))
+	{
+		auto us = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - started).count();
+		DBReport("Snapshot %zi restored in %lld us\n", n, (long long)us);
+	}
+	return nullptr;
+}
+
+// Rewind buffer control. Without parameters shows the state of the buffer and returns it as Json object.
+static Json::Value* cmd_Rewind(std::vector<std::string>& args)
+{
+	if (args.size() > 1 && args[1] == "on")
+	{
+		int frames = args.size() > 2 ? atoi(args[2].c_str()) : 5;
+		int keyframes = args.size() > 3 ? atoi(args[3].c_str()) : 60;
+		int megabytes = args.size() > 4 ? atoi(args[4].c_str()) : 256;
+
+		Rewind::Start(frames, keyframes, (size_t)max(megabytes, 1));
+		DBReport("Rewind: snapshot every %i frames, keyframe every %i snapshots, %i MB\n", frames, keyframes, megabytes);
+		return nullptr;
+	}
+	else if (args.size() > 1 && args[1] == "off")
+	{
+		Rewind::Stop();
+		DBReport("Rewind off\n");
+		return nullptr;
+	}
+	else if (args.size() > 1 && args[1] == "back")
+	{
+		size_t steps = args.size() > 2 ? (size_t)atoi(args[2].c_str()) : 1;
+		if (!Rewind::StepBack(steps))
+		{
+			DBReport2(DbgChannel::Error, "Nothing to rewind\n");
+		}
+		return nullptr;
+	}
+
+	size_t count = Rewind::Count();
+	size_t size = Rewind::Size();
+	int64_t ms = emu->loaded ? Rewind::Duration() / Gekko::Gekko->OneMillisecond() : 0;
+
+	DBReport("Rewind %s: %zi snapshots, %zi KB, %lld ms\n", Rewind::IsEnabled() ? "on" : "off", count, size / 1024, (long long)ms);
+
+	Json::Value* output = new Json::Value();
+	output->type = Json::ValueType::Object;
+	output->AddBool("enabled", Rewind::IsEnabled());
+	output->AddUInt64("snapshots", count);
+	output->AddUInt64("bytes", size);
+	output->AddUInt64("ms", (uint64_t)ms);
+	return output;
+}
+
 void EmuReflector()
 {
 	Debug::Hub.AddCmd("FileLoad", EmuFileLoad);
@@ -254,4 +445,11 @@ void EmuReflector()
 	Debug::Hub.AddCmd("reset", cmd_reset);
 	Debug::Hub.AddCmd("IsLoaded", IsLoadedInternal);
 	Debug::Hub.AddCmd("GetVersion", GetVersionInternal);
+	Debug::Hub.AddCmd("PerfCounters", cmd_PerfCounters);
+	Debug::Hub.AddCmd("PerfCsv", cmd_PerfCsv);
+	Debug::Hub.AddCmd("SaveState", cmd_SaveState);
+	Debug::Hub.AddCmd("LoadState", cmd_LoadState);
+	Debug::Hub.AddCmd("Snapshot", cmd_Snapshot);
+	Debug::Hub.AddCmd("RestoreSnapshot", cmd_RestoreSnapshot);
+	Debug::Hub.AddCmd("Rewind", cmd_Rewind);
 }
@@ -2,18 +2,26 @@
 #include "pch.h"
 
 /* Emulator state */
-Emulator emu;
+InstanceRef<Emulator, &Instance::emu> emu;
 
 void EMUGetHwConfig(HWConfig * config)
 {
+    config->headless = Instance::Get()->headless;
+
     config->ramsize = RAMSIZE;
-    config->hwndMain = wnd.hMainWindow;
+    config->hwndMain = config->headless ? NULL : wnd.hMainWindow;
 
     config->vi_log = GetConfigBool(USER_VI_LOG, USER_HW);
     config->vi_xfb = GetConfigBool(USER_VI_XFB, USER_HW);
 
     config->videoEncoderFuse = 0;
 
+    config->aramChunkedDma = GetConfigBool(USER_ARAM_CHUNKED, USER_HW);
+
+    config->audioSink = GetConfigInt(USER_AUDIO_SINK, USER_HW);
+    config->audioRate = GetConfigInt(USER_AUDIO_RATE, USER_HW);
+    _tcscpy_s (config->audioWavFilename, _countof(config->audioWavFilename) - 1, GetConfigString(USER_AUDIO_WAV, USER_HW).data());
+
     config->rswhack = GetConfigBool(USER_PI_RSWHACK, USER_HW);
     config->consoleVer = GetConfigInt(USER_CONSOLE, USER_HW);
 
@@ -37,14 +45,21 @@ void EMUGetHwConfig(HWConfig * config)
 // this function calls every time, after user loading new file
 void EMUOpen()
 {
-    if (emu.loaded)
+    if (emu->loaded)
         return;
 
-    Debug::Log = new Debug::EventLog();
-    assert(Debug::Log);
+    bool headless = Instance::Get()->headless;
+
+    if (!headless)
+    {
+        Debug::Log = new Debug::EventLog();
+        assert(Debug::Log);
+        DBUpdateChannelMask();
+    }
 
     // open other sub-systems
     Gekko::Gekko->Reset();
+    Gekko::Gekko->EnableCachedInterpreter(GetConfigBool(USER_CACHED_INTERPRETER, USER_CORE));
     HWConfig* hwconfig = new HWConfig;
     memset(hwconfig, 0, sizeof(HWConfig));
     EMUGetHwConfig(hwconfig);
@@ -53,29 +68,38 @@ void EMUOpen()
     delete hwconfig;
 
     ReloadFile();   // PC will be set here
-    HLEOpen();
+
+    // The symbol map is shared, it describes the title of the main instance
+    if (!headless)
+    {
+        HLEOpen();
+    }
 
     // There is Fuse on the motherboard, which determines the video encoder mode. 
     // Some games test it in VIConfigure and try to set the mode according to Fuse. But the program code does not allow this (example - Zelda PAL Version)
     // https://www.ifixit.com/Guide/Nintendo+GameCube+Regional+Modification+Selector+Switch/35482
-    if (ldat.dvd)
+    if (ldat->dvd)
     {
         char id[4] = { 0 };
 
-        id[0] = (char)ldat.gameID[0];
-        id[1] = (char)ldat.gameID[1];
-        id[2] = (char)ldat.gameID[2];
-        id[3] = (char)ldat.gameID[3];
+        id[0] = (char)ldat->gameID[0];
+        id[1] = (char)ldat->gameID[1];
+        id[2] = (char)ldat->gameID[2];
+        id[3] = (char)ldat->gameID[3];
 
         DVD::Region region = DVD::RegionById(id);
         VISetEncoderFuse(DVD::IsNtsc(region) ? 0 : 1);
     }
 
-    OnMainWindowOpened();
+    emu->loaded = true;
 
-    emu.loaded = true;
+    if (!headless)
+    {
+        OnMainWindowOpened();
+        Rewind::Open();
+    }
 
-    if (!emu.doldebug)
+    if (!emu->doldebug)
     {
         Gekko::Gekko->Run();
     }
@@ -84,23 +108,39 @@ void EMUOpen()
 // this function calls every time, after user stops emulation
 void EMUClose()
 {
-    if (!emu.loaded)
+    if (!emu->loaded)
         return;
 
-    HLEClose();
+    bool headless = Instance::Get()->headless;
+
+    if (!headless)
+    {
+        Rewind::Close();
+    }
 
     Gekko::Gekko->Suspend();
+    if (!headless)
+    {
+        HLEClose();
+    }
+    Snapshot::Reset();
 
     delete Flipper::HW;
     Flipper::HW = nullptr;
 
-    // take care about user interface
-    OnMainWindowClosed();
-
-    delete Debug::Log;
-    Debug::Log = nullptr;
+    if (!headless)
+    {
+        // take care about user interface
+        OnMainWindowClosed();
+
+        // Stop the logging before the log is gone
+        Debug::EventLog* log = Debug::Log;
+        Debug::Log = nullptr;
+        DBUpdateChannelMask();
+        delete log;
+    }
 
-    emu.loaded = false;
+    emu->loaded = false;
 }
 
 // reset emulator
@@ -110,22 +150,97 @@ void EMUReset()
     EMUOpen();
 }
 
+// The devices are opened later by EMUOpen, on a thread of the instance
+Instance* EMUCreateInstance(bool headless)
+{
+    Instance* instance = new Instance();
+    assert(instance);
+
+    instance->headless = headless;
+
+    instance->mi = new MIControl();
+    instance->aram = new ARControl();
+    instance->di = new DIControl();
+    instance->si = new SIControl();
+    instance->exi = new EIControl();
+    instance->mc = new MCControl();
+    instance->ai = new AIControl();
+    instance->pi = new PIControl();
+    instance->vi = new VIControl();
+    instance->fifo = new FifoControl();
+    instance->dvd = new DVDControl();
+    instance->hle = new HLEControl();
+    instance->ldat = new LoaderData();
+    instance->emu = new Emulator();
+
+    // The threads of the core and the drive are created for the instance
+    Instance* current = Instance::Current;
+    Instance::Current = instance;
+
+    instance->gekko = new Gekko::GekkoCore;
+    assert(instance->gekko);
+    instance->ddu = new DVD::DduCore;
+    assert(instance->ddu);
+
+    Instance::Current = current;
+
+    return instance;
+}
+
+void EMUDestroyInstance(Instance* instance)
+{
+    Instance* current = Instance::Current;
+    Instance::Current = instance;
+
+    EMUClose();
+    DVD::Unmount();
+
+    delete instance->ddu;
+    delete instance->gekko;
+
+    Instance::Current = current;
+
+    delete instance->mi;
+    delete instance->aram;
+    delete instance->di;
+    delete instance->si;
+    delete instance->exi;
+    delete instance->mc;
+    delete instance->ai;
+    delete instance->pi;
+    delete instance->vi;
+    delete instance->fifo;
+    delete instance->dvd;
+    delete instance->hle;
+    delete instance->ldat;
+    delete instance->emu;
+
+    delete instance;
+}
+
 void EMUCtor()
 {
-    Gekko::Gekko = new Gekko::GekkoCore;
-    assert(Gekko::Gekko);
     Debug::Hub.AddNode(EMU_JDI_JSON, EmuReflector);
     DSP::DspCore::InitSubsystem();
     DVD::InitSubsystem();
     HLEInit();
+    SnapshotWorker::Start();
+
+    // The UI thread and the threads created by it work with the main instance
+    Instance::Main = EMUCreateInstance(false);
+    Instance::Current = Instance::Main;
 }
 
 void EMUDtor()
 {
     Debug::Hub.RemoveNode(EMU_JDI_JSON);
+    SnapshotWorker::Stop();
+
+    EMUDestroyInstance(Instance::Main);
+    Instance::Main = nullptr;
+    Instance::Current = nullptr;
+
     DSP::DspCore::ShutdownSubsystem();
     DVD::ShutdownSubsystem();
-    delete Gekko::Gekko;
-    Gekko::Gekko = nullptr;
     HLEShutdown();
 }
@@ -11,6 +11,11 @@ void    EMUOpen();          // [START]
 void    EMUClose();         // [STOP]
 void    EMUReset();         // Reset
 
+// Several consoles can run in one process. EMUCtor creates the main instance, which has the main window and the debugger.
+// The other instances are headless (see Instance.h). EMUOpen, EMUClose and EMUReset work with the instance of the calling thread (Instance::Current).
+Instance* EMUCreateInstance(bool headless);
+void    EMUDestroyInstance(Instance* instance);
+
 // all important data is placed here
 typedef struct Emulator
 {
@@ -18,6 +23,6 @@ typedef struct Emulator
     bool    doldebug;       // debugger active
 } Emulator;
 
-extern  Emulator emu;
+extern  InstanceRef<Emulator, &Instance::emu> emu;
 
 #include "EmuCommands.h"
@@ -7,7 +7,7 @@
 #include "pch.h"
 
 /* All loader variables are placed here */
-LoaderData ldat;
+InstanceRef<LoaderData, &Instance::ldat> ldat;
 
 /* ---------------------------------------------------------------------------  */
 /* DOL loader                                                                   */
@@ -63,10 +63,11 @@ uint32_t LoadDOL(std::wstring_view dolname)
     {
         if(dh.textOffset[i])    /* If offset is 0, then section is empty */
         {
-            char* addr = (char*)&mi.ram[dh.textAddress[i] & RAMMASK];
+            char* addr = (char*)&mi->ram[dh.textAddress[i] & RAMMASK];
 
             dol.seekg(dh.textOffset[i]);
             dol.read(addr, dh.textSize[i]);
+            ldat->textSections.push_back({ dh.textAddress[i], dh.textSize[i] });
 
             DBReport2(DbgChannel::Loader,
                 "   text section %08X->%08X, size %i b\n",
@@ -81,7 +82,7 @@ uint32_t LoadDOL(std::wstring_view dolname)
     {
         if (dh.dataOffset[i])    /* If offset is 0, then section is empty */
         {
-            char* addr = (char*)&mi.ram[dh.dataAddress[i] & RAMMASK];
+            char* addr = (char*)&mi->ram[dh.dataAddress[i] & RAMMASK];
 
             dol.seekg(dh.dataOffset[i]);
             dol.read(addr, dh.dataSize[i]);
@@ -127,8 +128,9 @@ uint32_t LoadDOLFromMemory(DolHeader *dol, uint32_t ofs)
     {
         if(dol->textOffset[i])  // if offset is 0, then section is empty
         {
-            uint8_t*addr = &mi.ram[dol->textAddress[i] & RAMMASK];
+            uint8_t*addr = &mi->ram[dol->textAddress[i] & RAMMASK];
             memcpy(addr, ADDPTR(dol, dol->textOffset[i]), dol->textSize[i]);
+            ldat->textSections.push_back({ dol->textAddress[i], dol->textSize[i] });
 
             DBReport2(DbgChannel::Loader,
                 "   text section %08X->%08X, size %i b\n",
@@ -143,7 +145,7 @@ uint32_t LoadDOLFromMemory(DolHeader *dol, uint32_t ofs)
     {
         if(dol->dataOffset[i])  // if offset is 0, then section is empty
         {
-            uint8_t *addr = &mi.ram[dol->dataAddress[i] & RAMMASK];
+            uint8_t *addr = &mi->ram[dol->dataAddress[i] & RAMMASK];
             memcpy(addr, ADDPTR(dol, dol->dataOffset[i]), dol->dataSize[i]);
 
             DBReport2(DbgChannel::Loader,
@@ -309,7 +311,7 @@ uint32_t LoadELF(std::wstring_view elfname)
                 vend = vaddr + size;
 
                 file.seekg(Elf_SwapOff(phdr.p_offset));
-                file.read((char*)&mi.ram[vaddr & RAMMASK], vend - vaddr);
+                file.read((char*)&mi->ram[vaddr & RAMMASK], vend - vaddr);
                 //fread(&mi.ram[vaddr & RAMMASK], vend - vaddr, 1, f);
             }
         }
@@ -355,7 +357,7 @@ uint32_t LoadBIN(std::wstring_view binname)
         fsize = RAMSIZE - org;
     }
 
-    file.read((char*)&mi.ram[org], fsize);
+    file.read((char*)&mi->ram[org], fsize);
     file.close();
 
     DBReport2(DbgChannel::Loader, "Loaded binary file at %08X (0x%08X)\n\n", org, fsize);
@@ -376,8 +378,8 @@ bool LoadPatch(TCHAR * patchname, bool add)
     // since "enable" flag is loaded only here, it is not important
     // to load it in standalone patch Init routine. simply if there are
     // no patch files loaded, there is nothing to apply.
-    ldat.enablePatch = GetConfigBool(USER_PATCH, USER_LOADER);
-    if(!ldat.enablePatch) return true;
+    ldat->enablePatch = GetConfigBool(USER_PATCH, USER_LOADER);
+    if(!ldat->enablePatch) return true;
 
     // count patchnum
     size_t patchNum = UI::FileSize(patchname) / sizeof(Patch);
@@ -401,7 +403,7 @@ bool LoadPatch(TCHAR * patchname, bool add)
     {
         if(patchNum == 0) return true;  // nothing to add
 
-        size_t oldPatchCount = ldat.patches.size();
+        size_t oldPatchCount = ldat->patches.size();
 
         auto buffer = UI::FileLoad(patchname);
         auto patches = (Patch*)buffer.data();
@@ -411,7 +413,7 @@ bool LoadPatch(TCHAR * patchname, bool add)
             Patch* next = new Patch;
             *next = patches[i];
 
-            ldat.patches.push_back(next);
+            ldat->patches.push_back(next);
         }
 
         free(patches);
@@ -427,7 +429,7 @@ bool LoadPatch(TCHAR * patchname, bool add)
             Patch* next = new Patch;
             *next = patches[i];
 
-            ldat.patches.push_back(next);
+            ldat->patches.push_back(next);
         }
 
         ApplyPatches(true);
@@ -441,14 +443,14 @@ bool LoadPatch(TCHAR * patchname, bool add)
 void ApplyPatches(bool load, int32_t a, int32_t b)
 {
     // allowed ?
-    if(!ldat.enablePatch) return;
+    if(!ldat->enablePatch) return;
 
     // b = MAX ?
-    if(b==-1) b = (int32_t)ldat.patches.size() - 1;
+    if(b==-1) b = (int32_t)ldat->patches.size() - 1;
     
     for(int32_t i=a; i<=b; i++)     // i = [a; b]
     {
-        Patch * p = ldat.patches[i];
+        Patch * p = ldat->patches[i];
         if(p->freeze || load)
         {
             uint32_t ea = _byteswap_ulong(p->effectiveAddress);
@@ -460,7 +462,9 @@ void ApplyPatches(bool load, int32_t a, int32_t b)
             }
             if(pa == Gekko::BadAddress) continue;
 
-            uint8_t * ptr = (uint8_t *)&mi.ram[pa], * data = (uint8_t *)(&(p->data));
+            uint8_t * ptr = (uint8_t *)&mi->ram[pa], * data = (uint8_t *)(&(p->data));
+            uint8_t before[sizeof(uint64_t)];
+            memcpy(before, ptr, sizeof(before));
             switch(p->dataSize)
             {
                 case PATCH_SIZE_8:
@@ -495,16 +499,23 @@ void ApplyPatches(bool load, int32_t a, int32_t b)
                               ptr[0], ptr[1], ptr[2], ptr[3], ptr[4], ptr[5], ptr[6], ptr[7] );
                     break;
             }
+            mi->dirty.Mark(pa, sizeof(uint64_t));
+
+            // The patch may be code. Frozen patches are written every frame, so only a change is invalidated.
+            if (memcmp(before, ptr, sizeof(before)) != 0)
+            {
+                Gekko::Gekko->InvalidateCodeAtSafePoint(ea, sizeof(uint64_t));
+            }
         }
     }
 }
 
 void UnloadPatch()
 {
-    while (!ldat.patches.empty())
+    while (!ldat->patches.empty())
     {
-        Patch* patch = ldat.patches.back();
-        ldat.patches.pop_back();
+        Patch* patch = ldat->patches.back();
+        ldat->patches.pop_back();
         delete patch;
     }
 }
@@ -518,16 +529,16 @@ static void AutoloadMap()
     auto mapname = std::wstring();
     TCHAR drive[MAX_PATH], dir[MAX_PATH], name[_MAX_PATH], ext[_MAX_EXT];
 
-    _tsplitpath_s(ldat.currentFile.data(),
+    _tsplitpath_s(ldat->currentFile.data(),
         drive, _countof(drive) - 1,
         dir, _countof(dir) - 1,
         name, _countof(name) - 1,
         ext, _countof(ext) - 1);
 
     // Step 1: try to load map from Data directory
-    if (ldat.dvd)
+    if (ldat->dvd)
     {
-        mapname = fmt::format(L".\\Data\\{:s}.map", ldat.gameID);
+        mapname = fmt::format(L".\\Data\\{:s}.map", ldat->gameID);
     }
     else
     {
@@ -538,9 +549,9 @@ static void AutoloadMap()
     if (format != MAP_FORMAT::BAD) return;
  
     // Step 2: try to load map from file directory
-    if (ldat.dvd)
+    if (ldat->dvd)
     {
-        mapname = fmt::format(L"{:s}{:s}{:s}.map", drive, dir, ldat.gameID);
+        mapname = fmt::format(L"{:s}{:s}{:s}.map", drive, dir, ldat->gameID);
     }
     else
     {
@@ -556,9 +567,9 @@ static void AutoloadMap()
     // Step 3: make new map (find symbols)
     if(GetConfigBool(USER_MAKEMAP, USER_LOADER))
     {
-        if (ldat.dvd)
+        if (ldat->dvd)
         {
-            mapname = fmt::format(L".\\Data\\{:s}.map", ldat.gameID);
+            mapname = fmt::format(L".\\Data\\{:s}.map", ldat->gameID);
         }
         else
         {
@@ -567,9 +578,31 @@ static void AutoloadMap()
         
         auto str = Util::convert<char>(mapname);
         DBReport2(DbgChannel::Loader, "Making new MAP file: %s\n\n", str.c_str());
-        MAPInit(mapname.data());
-        MAPAddRange(0x80000000, 0x80000000 | RAMSIZE);  // user can wait for once :O)
-        MAPFinish();
+
+        // Signatures are preferred. The code sections are known only for DOL files, otherwise the whole RAM is scanned.
+        SignatureDB signatures;
+        if (signatures.Load(SIGNATURES_FILE))
+        {
+            std::vector<SignatureRange> ranges;
+            for (auto& section : ldat->textSections)
+            {
+                ranges.push_back({ section.first, section.second });
+            }
+            if (ranges.empty())
+            {
+                ranges.push_back({ 0x80000000, RAMSIZE });
+            }
+
+            std::vector<SignatureMatch> matches;
+            signatures.Identify(ranges, matches);
+            signatures.SaveMatches(matches, mapname.data());
+        }
+        else
+        {
+            MAPInit(mapname.data());
+            MAPAddRange(0x80000000, 0x80000000 | RAMSIZE);  // user can wait for once :O)
+            MAPFinish();
+        }
         LoadMAP(mapname.data());
     }
 }
@@ -580,16 +613,16 @@ static void AutoloadPatch()
     auto patch = std::wstring();
     TCHAR drive[MAX_PATH], dir[MAX_PATH], name[_MAX_PATH], ext[_MAX_EXT];
 
-    _tsplitpath_s(ldat.currentFile.data(),
+    _tsplitpath_s(ldat->currentFile.data(),
         drive, _countof(drive) - 1,
         dir, _countof(dir) - 1,
         name, _countof(name) - 1,
         ext, _countof(ext) - 1);
 
     // Step 1: try to load patch from Data directory
-    if (ldat.dvd)
+    if (ldat->dvd)
     {
-        patch = fmt::format(L".\\Data\\{:s}.patch", ldat.gameID);
+        patch = fmt::format(L".\\Data\\{:s}.patch", ldat->gameID);
     }
     else
     {
@@ -600,9 +633,9 @@ static void AutoloadPatch()
     if(ok) return;
 
     // Step 2: try to load patch from file directory
-    if (ldat.dvd)
+    if (ldat->dvd)
     {
-        patch = fmt::format(L"{:s}{:s}{:s}.patch", drive, dir, ldat.gameID);
+        patch = fmt::format(L"{:s}{:s}{:s}.patch", drive, dir, ldat->gameID);
     }
     else
     {
@@ -633,19 +666,19 @@ static bool SetGameIDAndTitle(std::wstring_view filename)
     diskIdTchar[4] = 0;
 
     auto title = std::string_view((char*)bnr->comments[0].longTitle);
-    ldat.currentFileName = Util::convert<wchar_t, char>(title);
+    ldat->currentFileName = Util::convert<wchar_t, char>(title);
 
     /* Convert SJIS Title to Unicode */
 
     if (DVD::RegionById(diskID) == DVD::Region::JPN)
     {
         size_t size, chars;
-        uint16_t* widePtr = SjisToUnicode(ldat.currentFileName.data(), &size, &chars);
+        uint16_t* widePtr = SjisToUnicode(ldat->currentFileName.data(), &size, &chars);
         uint16_t* unicodePtr;
 
         if (widePtr)
         {
-            auto tcharPtr = ldat.currentFileName.data();
+            auto tcharPtr = ldat->currentFileName.data();
             unicodePtr = widePtr;
 
             while (*unicodePtr)
@@ -659,7 +692,7 @@ static bool SetGameIDAndTitle(std::wstring_view filename)
     }
 
     /* Set GameID. */
-    ldat.gameID = fmt::sprintf(L"%.4s%02X", diskIdTchar, DVDBannerChecksum(bnr));
+    ldat->gameID = fmt::sprintf(L"%.4s%02X", diskIdTchar, DVDBannerChecksum(bnr));
     return true;
 }
 
@@ -670,16 +703,24 @@ static void DoLoadFile(std::wstring_view filename)
     bool bootrom = false;
     ULONGLONG s_time = GetTickCount64();
 
+    // The window, the recent files and the symbol map belong to the main instance
+    bool headless = Instance::Get()->headless;
+
     /* Loading progress */
     auto statusText = fmt::format(L"Loading {:s}", filename);
-    SetStatusText(STATUS_ENUM::Progress, statusText);
+    if (!headless)
+    {
+        SetStatusText(STATUS_ENUM::Progress, statusText);
+    }
+
+    ldat->textSections.clear();
 
     // load file
     if (filename == L"Bootrom")
     {
         entryPoint = BOOTROM_START_ADDRESS + 0x100;
-        ldat.gameID[0] = 0;
-        ldat.dvd = false;
+        ldat->gameID[0] = 0;
+        ldat->dvd = false;
         bootrom = true;
     }
     else
@@ -689,35 +730,35 @@ static void DoLoadFile(std::wstring_view filename)
         if (!_tcsicmp(extension, _T(".dol")))
         {
             entryPoint = LoadDOL(filename);
-            ldat.gameID[0] = 0;
-            ldat.dvd = false;
+            ldat->gameID[0] = 0;
+            ldat->dvd = false;
         }
         else if (!_tcsicmp(extension, _T(".elf")))
         {
             entryPoint = LoadELF(filename);
-            ldat.gameID[0] = 0;
-            ldat.dvd = false;
+            ldat->gameID[0] = 0;
+            ldat->dvd = false;
         }
         else if (!_tcsicmp(extension, _T(".bin")))
         {
             entryPoint = LoadBIN(filename);
-            ldat.gameID[0] = 0;
-            ldat.dvd = false;
+            ldat->gameID[0] = 0;
+            ldat->dvd = false;
         }
         else if (!_tcsicmp(extension, _T(".iso")))
         {
             DVD::MountFile(filename);
-            ldat.dvd = SetGameIDAndTitle(filename);
+            ldat->dvd = SetGameIDAndTitle(filename);
         }
         else if (!_tcsicmp(extension, _T(".gcm")))
         {
             DVD::MountFile(filename);
-            ldat.dvd = SetGameIDAndTitle(filename);
+            ldat->dvd = SetGameIDAndTitle(filename);
         }
     }
 
     /* File load success? */
-    if(entryPoint == 0 && !ldat.dvd)
+    if(entryPoint == 0 && !ldat->dvd)
     {
         UI::DolwinError( _T("Cannot load file!"),
                       _T("\'%s\'\n"),
@@ -736,16 +777,16 @@ static void DoLoadFile(std::wstring_view filename)
         _stprintf_s(fullPath, _countof(fullPath) - 1, _T("%s%s"), drive, dir);
         
         // Set title to loaded executables
-        if (!ldat.dvd)
+        if (!ldat->dvd)
         {
-            ldat.currentFileName = name;
+            ldat->currentFileName = name;
         }
         else
         {
             // Title set before (SetGameIDAndTitle)
         }
 
-        if (!bootrom)
+        if (!bootrom && !headless)
         {
             // add new recent entry
             AddRecentFile(filename);
@@ -760,12 +801,12 @@ static void DoLoadFile(std::wstring_view filename)
     {
         HWConfig* config = new HWConfig;
         EMUGetHwConfig(config);
-        BootROM(ldat.dvd, false, config->consoleVer);
+        BootROM(ldat->dvd, false, config->consoleVer);
         Sleep(10);
     }
 
     // autoload map file
-    if (!bootrom)
+    if (!bootrom && !headless)
     {
         AutoloadMap();
     }
@@ -776,33 +817,42 @@ static void DoLoadFile(std::wstring_view filename)
 
     // show boot time
     ULONGLONG e_time = GetTickCount64();
-    ldat.boottime = (float)(e_time - s_time) / 1000.0f;
-    statusText = fmt::format(L"Boot time {:.2f} sec", ldat.boottime);
+    ldat->boottime = (float)(e_time - s_time) / 1000.0f;
+    statusText = fmt::format(L"Boot time {:.2f} sec", ldat->boottime);
     
-    SetStatusText(STATUS_ENUM::Progress, statusText);
+    if (!headless)
+    {
+        SetStatusText(STATUS_ENUM::Progress, statusText);
+    }
 
     // set entrypoint (for DVD, PC will set in apploader)
-    if(!ldat.dvd) Gekko::Gekko->regs.pc = entryPoint;
+    if(!ldat->dvd) Gekko::Gekko->regs.pc = entryPoint;
 }
 
 // set next file to load
 void LoadFile(std::wstring_view filename)
 {
-    ldat.currentFile = filename;
-    SetConfigString(USER_LASTFILE, ldat.currentFile, USER_UI);
+    ldat->currentFile = filename;
+    if (!Instance::Get()->headless)
+    {
+        SetConfigString(USER_LASTFILE, ldat->currentFile, USER_UI);
+    }
 }
 
 void LoadFile(std::string_view filename)
 {
     char* ansiPtr = (char*)filename.data();
-    TCHAR* tcharPtr = ldat.currentFile.data();
+    TCHAR* tcharPtr = ldat->currentFile.data();
     while (*ansiPtr)
     {
         *tcharPtr++ = *ansiPtr++;
     }
     *tcharPtr++ = 0;
     
-    SetConfigString(USER_LASTFILE, ldat.currentFile, USER_UI);
+    if (!Instance::Get()->headless)
+    {
+        SetConfigString(USER_LASTFILE, ldat->currentFile, USER_UI);
+    }
 }
 
 // reload last file
@@ -814,10 +864,10 @@ void ReloadFile()
         "-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-\n\n"
     );
 
-    if(!ldat.currentFile.empty())
+    if(!ldat->currentFile.empty())
     {
-        auto str = Util::convert<char>(ldat.currentFile);
+        auto str = Util::convert<char>(ldat->currentFile);
         DBReport2(DbgChannel::Loader, "Loading file: \"%s\"\n\n", str.c_str());
-        DoLoadFile(ldat.currentFile);
+        DoLoadFile(ldat->currentFile);
     }
 }
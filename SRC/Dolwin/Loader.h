@@ -181,6 +181,7 @@ struct LoaderData
     bool                enablePatch;        // true: allow patches
     bool                dvd;
     std::vector<Patch*> patches;            // patches 
+    std::vector<std::pair<uint32_t, uint32_t>> textSections;    // DOL code sections (address, size), scanned for signatures
 };
 
-extern LoaderData ldat;
+extern InstanceRef<LoaderData, &Instance::ldat> ldat;
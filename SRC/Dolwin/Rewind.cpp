@@ -0,0 +1,206 @@
+// Rewind buffer.
+
+#include "pch.h"
+
+std::deque<std::shared_ptr<Snapshot>> Rewind::ring;
+SpinLock Rewind::lock;
+std::atomic<bool> Rewind::enabled = false;
+std::atomic<bool> Rewind::active = false;
+std::atomic<bool> Rewind::inHook = false;
+std::atomic<int> Rewind::frameInterval = 5;
+std::atomic<int> Rewind::keyframeInterval = 60;
+std::atomic<size_t> Rewind::budget = 256 * 1024 * 1024;
+std::atomic<bool> Rewind::resetCounters = true;
+int Rewind::frameCounter = 0;
+int Rewind::sinceKeyframe = 0;
+
+void Rewind::Start(int frames, int keyframes, size_t megabytes)
+{
+	frameInterval = max(frames, 1);
+	keyframeInterval = max(keyframes, 1);
+	budget = max(megabytes, (size_t)1) * 1024 * 1024;
+
+	resetCounters = true;
+	enabled = true;
+
+	if (emu->loaded)
+	{
+		active = true;
+		VISetFrameHook(FrameHook, nullptr);
+	}
+}
+
+void Rewind::Stop()
+{
+	Close();
+	enabled = false;
+}
+
+void Rewind::Open()
+{
+	if (enabled)
+	{
+		resetCounters = true;
+		active = true;
+		VISetFrameHook(FrameHook, nullptr);
+	}
+}
+
+void Rewind::Close()
+{
+	// The HW thread may be in the hook, it finishes while Gekko is still running.
+	// The hook checks `active` after setting `inHook`, so it either sees the flag cleared or is waited for here.
+	active = false;
+	VISetFrameHook(nullptr, nullptr);
+
+	while (inHook)
+	{
+		Sleep(1);
+	}
+
+	std::deque<std::shared_ptr<Snapshot>> dropped;
+
+	lock.Lock();
+	dropped.swap(ring);
+	lock.Unlock();
+}
+
+void Rewind::FrameHook(void* context)
+{
+	inHook = true;
+
+	if (resetCounters.exchange(false))
+	{
+		frameCounter = 0;
+		sinceKeyframe = keyframeInterval;		// The first snapshot is a keyframe
+	}
+
+	if (!active || ++frameCounter < frameInterval)
+	{
+		inHook = false;
+		return;
+	}
+
+	frameCounter = 0;
+
+	std::shared_ptr<Snapshot> snapshot = Snapshot::Capture(false);
+	if (!snapshot)
+	{
+		inHook = false;
+		return;
+	}
+
+	bool keyframe = ++sinceKeyframe >= keyframeInterval;
+	if (keyframe)
+	{
+		sinceKeyframe = 0;
+	}
+	SnapshotWorker::Post(snapshot, "", keyframe);
+
+	lock.Lock();
+	ring.push_back(snapshot);
+	lock.Unlock();
+
+	Trim();
+
+	inHook = false;
+}
+
+// Drop the oldest snapshots up to the next keyframe, while the ring is over budget. A group is dropped only when the keyframe after it is already flattened.
+void Rewind::Trim()
+{
+	std::vector<std::shared_ptr<Snapshot>> dropped;
+
+	lock.Lock();
+
+	size_t total = 0;
+	for (auto& snapshot : ring)
+	{
+		total += snapshot->Size();
+	}
+
+	while (total > budget)
+	{
+		size_t next = 1;
+		while (next < ring.size() && !ring[next]->IsFull())
+		{
+			next++;
+		}
+		if (next >= ring.size())
+		{
+			break;
+		}
+
+		for (size_t i = 0; i < next; i++)
+		{
+			total -= min(total, ring.front()->Size());
+			dropped.push_back(ring.front());
+			ring.pop_front();
+		}
+	}
+
+	lock.Unlock();
+
+	// The memory is freed here, not under the lock
+}
+
+bool Rewind::StepBack(size_t steps)
+{
+	lock.Lock();
+	if (ring.empty())
+	{
+		lock.Unlock();
+		return false;
+	}
+	steps = min(max(steps, (size_t)1), ring.size());
+	std::shared_ptr<Snapshot> target = ring[ring.size() - steps];
+	lock.Unlock();
+
+	if (!Snapshot::Restore(target))
+	{
+		return false;
+	}
+
+	std::vector<std::shared_ptr<Snapshot>> dropped;
+
+	lock.Lock();
+	while (!ring.empty() && ring.back() != target)
+	{
+		dropped.push_back(ring.back());
+		ring.pop_back();
+	}
+	lock.Unlock();
+
+	// The counters are reset by the hook, the next snapshot is a keyframe
+	resetCounters = true;
+	return true;
+}
+
+size_t Rewind::Count()
+{
+	lock.Lock();
+	size_t count = ring.size();
+	lock.Unlock();
+	return count;
+}
+
+size_t Rewind::Size()
+{
+	size_t total = 0;
+
+	lock.Lock();
+	for (auto& snapshot : ring)
+	{
+		total += snapshot->Size();
+	}
+	lock.Unlock();
+	return total;
+}
+
+int64_t Rewind::Duration()
+{
+	lock.Lock();
+	int64_t ticks = ring.empty() ? 0 : ring.back()->GetTicks() - ring.front()->GetTicks();
+	lock.Unlock();
+	return ticks;
+}
@@ -0,0 +1,47 @@
+// Rewind buffer.
+// Description in Docs\EMU\SaveStates.md
+
+#pragma once
+
+#include <atomic>
+#include <deque>
+#include <memory>
+
+// A ring of snapshots taken every few emulated frames (VI hook on the HW thread).
+// The snapshots are incremental, so the emulation thread only copies the pages written since the previous one.
+// Every keyframeInterval-th snapshot is flattened by the worker into a full one, after that the older ones can be dropped.
+
+class Rewind
+{
+	static std::deque<std::shared_ptr<Snapshot>> ring;		// Oldest first
+	static SpinLock lock;
+
+	static std::atomic<bool> enabled;
+	static std::atomic<bool> active;			// The hook is installed (enabled and the emulator is loaded)
+	static std::atomic<bool> inHook;
+	static std::atomic<int> frameInterval;		// Emulated frames between snapshots
+	static std::atomic<int> keyframeInterval;	// Snapshots between keyframes
+	static std::atomic<size_t> budget;			// Bytes
+	static std::atomic<bool> resetCounters;		// Set by the other threads, the counters are reset by the hook
+	static int frameCounter;			// Touched only by the hook (HW thread)
+	static int sinceKeyframe;
+
+	static void FrameHook(void* context);
+	static void Trim();
+
+public:
+	static void Start(int frames, int keyframes, size_t megabytes);
+	static void Stop();
+
+	// Called by the emulator when it is started and stopped. The snapshots of the previous run are dropped.
+	static void Open();
+	static void Close();
+
+	// Restore the snapshot taken `steps` snapshots ago (1: the last one). The newer snapshots are dropped.
+	static bool StepBack(size_t steps);
+
+	static bool IsEnabled() { return enabled; }
+	static size_t Count();
+	static size_t Size();
+	static int64_t Duration();			// Gekko ticks between the oldest and the newest snapshot
+};
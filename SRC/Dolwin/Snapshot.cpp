@@ -0,0 +1,601 @@
+// Savestates.
+
+#include "pch.h"
+
+#pragma region "SnapshotPages"
+
+void SnapshotPages::Capture(uint8_t* memory, DirtyPages& dirty, bool full)
+{
+	index.clear();
+	offset.clear();
+	data.clear();
+	compressed = false;
+
+	// Each flag is cleared before its page is copied, so a page written meanwhile is taken again by the next snapshot
+	size_t count = dirty.Count();
+	for (size_t page = 0; page < count; page++)
+	{
+		if (dirty.TestAndClear(page) || full)
+		{
+			index.push_back((uint32_t)page);
+		}
+	}
+
+	data.resize(index.size() << DirtyPages::PageShift);
+	offset.resize(index.size() + 1);
+
+	for (size_t i = 0; i < index.size(); i++)
+	{
+		offset[i] = (uint32_t)(i << DirtyPages::PageShift);
+		memcpy(data.data() + offset[i], memory + ((size_t)index[i] << DirtyPages::PageShift), DirtyPages::PageSize);
+	}
+	offset[index.size()] = (uint32_t)data.size();
+}
+
+void SnapshotPages::Compress(SpinLock& lock)
+{
+	if (compressed)
+	{
+		return;
+	}
+
+	std::vector<uint32_t> newOffset(index.size() + 1);
+	std::vector<uint8_t> newData;
+	std::vector<uint8_t> packed(Lz4::CompressBound(DirtyPages::PageSize));
+
+	newData.reserve(data.size() / 2);
+
+	for (size_t i = 0; i < index.size(); i++)
+	{
+		const uint8_t* page = data.data() + offset[i];
+		size_t size = Lz4::Compress(page, DirtyPages::PageSize, packed.data(), packed.size());
+
+		newOffset[i] = (uint32_t)newData.size();
+		if (size == 0 || size >= DirtyPages::PageSize)
+		{
+			newData.insert(newData.end(), page, page + DirtyPages::PageSize);
+		}
+		else
+		{
+			newData.insert(newData.end(), packed.data(), packed.data() + size);
+		}
+	}
+	newOffset[index.size()] = (uint32_t)newData.size();
+	newData.shrink_to_fit();
+
+	lock.Lock();
+	offset.swap(newOffset);
+	data.swap(newData);
+	compressed = true;
+	lock.Unlock();
+}
+
+bool SnapshotPages::Restore(uint8_t* memory, std::vector<uint8_t>& done)
+{
+	for (size_t i = 0; i < index.size(); i++)
+	{
+		size_t page = index[i];
+		if (page >= done.size())
+		{
+			return false;
+		}
+		if (done[page])
+		{
+			continue;
+		}
+
+		uint8_t* dest = memory + (page << DirtyPages::PageShift);
+		size_t size = offset[i + 1] - offset[i];
+
+		if (size == DirtyPages::PageSize)
+		{
+			memcpy(dest, data.data() + offset[i], DirtyPages::PageSize);
+		}
+		else if (!Lz4::Decompress(data.data() + offset[i], size, dest, DirtyPages::PageSize))
+		{
+			return false;
+		}
+
+		done[page] = 1;
+	}
+
+	return true;
+}
+
+#pragma endregion "SnapshotPages"
+
+#pragma region "Snapshot"
+
+// Last() is only accessed at the Gekko safe point (RunAtSafePoint serializes the callers)
+
+struct SnapshotSafePointJob
+{
+	std::shared_ptr<Snapshot> snapshot;
+	bool full;
+	bool result;
+};
+
+// The order of the devices is a part of the format (SnapshotVersion).
+static void SnapshotDoDevices(StateStream& state)
+{
+	Gekko::Gekko->DoState(state);
+	Flipper::HW->DoState(state);
+	DVD::DDU->DoState(state);
+}
+
+// The device threads are stopped between their updates, so their state is not torn and memory is not written by DMA meanwhile.
+// This is done by the calling thread, not at the safe point: the rewind buffer runs on the HW thread, which parks itself when the hook returns.
+static void SnapshotParkDevices()
+{
+	Flipper::HW->Park();
+	DVD::DDU->Park();
+}
+
+static void SnapshotUnparkDevices()
+{
+	DVD::DDU->Unpark();
+	Flipper::HW->Unpark();
+}
+
+void Snapshot::CaptureAtSafePoint(void* context)
+{
+	SnapshotSafePointJob* job = (SnapshotSafePointJob*)context;
+	Debug::PerfTimer timer(Debug::PerfCounter::SnapshotTime);
+	Debug::PerfAdd(Debug::PerfCounter::Snapshots);
+
+	std::shared_ptr<Snapshot> snapshot = std::make_shared<Snapshot>();
+
+	bool full = job->full || Last() == nullptr;
+
+	// Saving the devices may mark pages (the gather buffer is flushed), so the pages go after.
+	StateStream state(snapshot->devices, StateStream::Mode::Save);
+	SnapshotDoDevices(state);
+
+	snapshot->parent = full ? nullptr : Last();
+	snapshot->ticks = Gekko::Gekko->GetTicks();
+	snapshot->ramSize = mi->ramSize;
+	snapshot->aramSize = ARAMSIZE;
+	snapshot->ram.Capture(mi->ram, mi->dirty, full);
+	snapshot->aram.Capture(::aram->mem, ::aram->dirty, full);
+
+	Last() = snapshot;
+	job->snapshot = snapshot;
+}
+
+void Snapshot::RestoreAtSafePoint(void* context)
+{
+	SnapshotSafePointJob* job = (SnapshotSafePointJob*)context;
+
+	job->result = job->snapshot->RestoreInternal();
+
+	if (job->result)
+	{
+		Last() = job->snapshot;
+	}
+}
+
+bool Snapshot::RestoreInternal()
+{
+	if (ramSize != mi->ramSize || aramSize != ARAMSIZE)
+	{
+		DBReport2(DbgChannel::Error, "Snapshot memory size does not match\n");
+		return false;
+	}
+
+	// Keep the current device state, in case the snapshot does not fit this build
+	std::vector<uint8_t> backup;
+	StateStream save(backup, StateStream::Mode::Save);
+	SnapshotDoDevices(save);
+
+	StateStream load(devices, StateStream::Mode::Load);
+	SnapshotDoDevices(load);
+	if (load.Failed())
+	{
+		DBReport2(DbgChannel::Error, "Snapshot device state is rejected\n");
+		StateStream restore(backup, StateStream::Mode::Load);
+		SnapshotDoDevices(restore);
+		return false;
+	}
+
+	// The pages of the loaded files are checked by LoadFile, the snapshots in memory cannot be damaged.
+	std::vector<uint8_t> ramDone(mi->dirty.Count(), 0);
+	std::vector<uint8_t> aramDone(::aram->dirty.Count(), 0);
+	bool pagesOk = true;
+
+	// The worker may flatten a snapshot meanwhile, so the parent is taken under the lock and held until its pages are written
+	std::shared_ptr<Snapshot> next;
+
+	for (Snapshot* snapshot = this; snapshot != nullptr && pagesOk; snapshot = next.get())
+	{
+		snapshot->lock.Lock();
+		pagesOk = snapshot->ram.Restore(mi->ram, ramDone) && snapshot->aram.Restore(::aram->mem, aramDone);
+		std::shared_ptr<Snapshot> parentRef = snapshot->parent;
+		snapshot->lock.Unlock();
+
+		next = parentRef;
+	}
+
+	mi->dirty.Clear();
+	::aram->dirty.Clear();
+
+	if (!pagesOk)
+	{
+		DBReport2(DbgChannel::Error, "Snapshot pages are damaged\n");
+		mi->dirty.SetAll();
+		::aram->dirty.SetAll();
+		Last() = nullptr;
+	}
+
+	return pagesOk;
+}
+
+std::shared_ptr<Snapshot> Snapshot::Capture(bool full)
+{
+	SnapshotSafePointJob job;
+	job.full = full;
+
+	SnapshotParkDevices();
+	Gekko::Gekko->RunAtSafePoint(CaptureAtSafePoint, &job);
+	SnapshotUnparkDevices();
+
+	return job.snapshot;
+}
+
+bool Snapshot::Restore(std::shared_ptr<Snapshot> snapshot)
+{
+	SnapshotSafePointJob job;
+	job.snapshot = snapshot;
+	job.result = false;
+
+	SnapshotParkDevices();
+	Gekko::Gekko->RunAtSafePoint(RestoreAtSafePoint, &job);
+	SnapshotUnparkDevices();
+
+	return job.result;
+}
+
+void Snapshot::ResetAtSafePoint(void* context)
+{
+	Last() = nullptr;
+}
+
+void Snapshot::Reset()
+{
+	Gekko::Gekko->RunAtSafePoint(ResetAtSafePoint, nullptr);
+}
+
+void Snapshot::Compress()
+{
+	ram.Compress(lock);
+	aram.Compress(lock);
+}
+
+bool Snapshot::IsFull()
+{
+	lock.Lock();
+	bool full = parent == nullptr;
+	lock.Unlock();
+	return full;
+}
+
+size_t Snapshot::Size()
+{
+	lock.Lock();
+	size_t size = devices.size() + ram.Size() + aram.Size();
+	lock.Unlock();
+	return size;
+}
+
+bool Snapshot::MergePages(bool auxMemory, SnapshotPages& merged)
+{
+	size_t pageCount = (auxMemory ? aramSize : ramSize) >> DirtyPages::PageShift;
+	std::vector<std::pair<SnapshotPages*, uint32_t>> newest(pageCount, { nullptr, 0 });
+
+	// Only the worker changes the chain, and it is the one merging it, so the chain is read without the locks.
+	for (Snapshot* snapshot = this; snapshot != nullptr; snapshot = snapshot->parent.get())
+	{
+		SnapshotPages* pages = auxMemory ? &snapshot->aram : &snapshot->ram;
+		for (size_t i = 0; i < pages->index.size(); i++)
+		{
+			uint32_t page = pages->index[i];
+			if (page < pageCount && newest[page].first == nullptr)
+			{
+				newest[page] = { pages, (uint32_t)i };
+			}
+		}
+	}
+
+	std::vector<uint8_t> packed(Lz4::CompressBound(DirtyPages::PageSize));
+
+	merged.index.resize(pageCount);
+	merged.offset.resize(pageCount + 1);
+	merged.data.clear();
+	merged.compressed = true;
+
+	for (size_t page = 0; page < pageCount; page++)
+	{
+		SnapshotPages* pages = newest[page].first;
+		if (pages == nullptr)
+		{
+			return false;
+		}
+
+		uint32_t i = newest[page].second;
+		const uint8_t* ptr = pages->data.data() + pages->offset[i];
+		size_t size = pages->offset[i + 1] - pages->offset[i];
+
+		if (size == DirtyPages::PageSize)
+		{
+			size_t packedSize = Lz4::Compress(ptr, size, packed.data(), packed.size());
+			if (packedSize != 0 && packedSize < DirtyPages::PageSize)
+			{
+				ptr = packed.data();
+				size = packedSize;
+			}
+		}
+
+		merged.index[page] = (uint32_t)page;
+		merged.offset[page] = (uint32_t)merged.data.size();
+		merged.data.insert(merged.data.end(), ptr, ptr + size);
+	}
+	merged.offset[pageCount] = (uint32_t)merged.data.size();
+
+	return true;
+}
+
+void Snapshot::Flatten()
+{
+	SnapshotPages newRam, newAram;
+
+	if (parent == nullptr || !MergePages(false, newRam) || !MergePages(true, newAram))
+	{
+		return;
+	}
+
+	std::shared_ptr<Snapshot> oldParent;
+
+	lock.Lock();
+	ram = std::move(newRam);
+	aram = std::move(newAram);
+	oldParent.swap(parent);
+	lock.Unlock();
+
+	// The older snapshots are freed here (if nobody else refers to them), not under the lock
+}
+
+bool Snapshot::SaveFile(const char* filename)
+{
+	SnapshotPages mergedRam, mergedAram;
+
+	if (!MergePages(false, mergedRam) || !MergePages(true, mergedAram))
+	{
+		return false;
+	}
+
+	FILE* f = nullptr;
+	fopen_s(&f, filename, "wb");
+	if (!f)
+	{
+		return false;
+	}
+
+	SnapshotHeader header = { 0 };
+	memcpy(header.magic, "DOLWSTAT", sizeof(header.magic));
+	header.version = SnapshotVersion;
+	header.flags = SnapshotCompressed;
+	header.ticks = ticks;
+	header.ramSize = (uint32_t)ramSize;
+	header.aramSize = (uint32_t)aramSize;
+	header.devicesSize = devices.size();
+
+	bool ok = fwrite(&header, sizeof(header), 1, f) == 1;
+	ok = ok && (devices.empty() || fwrite(devices.data(), devices.size(), 1, f) == 1);
+
+	// Each page: 32-bit size, data. A page of PageSize bytes is not compressed.
+	for (SnapshotPages* pages : { &mergedRam, &mergedAram })
+	{
+		for (size_t i = 0; i < pages->index.size() && ok; i++)
+		{
+			uint32_t size = pages->offset[i + 1] - pages->offset[i];
+			ok = fwrite(&size, sizeof(size), 1, f) == 1 && fwrite(pages->data.data() + pages->offset[i], size, 1, f) == 1;
+		}
+	}
+
+	fclose(f);
+	return ok;
+}
+
+std::shared_ptr<Snapshot> Snapshot::LoadFile(const char* filename)
+{
+	FILE* f = nullptr;
+	fopen_s(&f, filename, "rb");
+	if (!f)
+	{
+		DBReport2(DbgChannel::Error, "Failed to open: %s\n", filename);
+		return nullptr;
+	}
+
+	std::shared_ptr<Snapshot> snapshot = std::make_shared<Snapshot>();
+	SnapshotHeader header = { 0 };
+	bool ok = fread(&header, sizeof(header), 1, f) == 1;
+
+	if (!ok || memcmp(header.magic, "DOLWSTAT", sizeof(header.magic)) != 0 || header.version != SnapshotVersion)
+	{
+		DBReport2(DbgChannel::Error, "Not a savestate, or made by another version: %s\n", filename);
+		fclose(f);
+		return nullptr;
+	}
+
+	snapshot->ticks = header.ticks;
+	snapshot->ramSize = header.ramSize;
+	snapshot->aramSize = header.aramSize;
+
+	// The device state is a few MB at most
+	ok = header.devicesSize < 0x10000000;
+	if (ok && header.devicesSize != 0)
+	{
+		snapshot->devices.resize((size_t)header.devicesSize);
+		ok = fread(snapshot->devices.data(), snapshot->devices.size(), 1, f) == 1;
+	}
+
+	// Decompress each page once, so that the restore cannot fail halfway
+	std::vector<uint8_t> page(DirtyPages::PageSize);
+
+	for (int mem = 0; mem < 2 && ok; mem++)
+	{
+		SnapshotPages* pages = mem == 0 ? &snapshot->ram : &snapshot->aram;
+		size_t pageCount = (mem == 0 ? header.ramSize : header.aramSize) >> DirtyPages::PageShift;
+
+		pages->index.resize(pageCount);
+		pages->offset.resize(pageCount + 1);
+		pages->compressed = true;
+
+		for (size_t i = 0; i < pageCount && ok; i++)
+		{
+			uint32_t size = 0;
+			ok = fread(&size, sizeof(size), 1, f) == 1 && size != 0 && size <= DirtyPages::PageSize;
+			if (!ok)
+			{
+				break;
+			}
+
+			pages->index[i] = (uint32_t)i;
+			pages->offset[i] = (uint32_t)pages->data.size();
+			pages->data.resize(pages->data.size() + size);
+
+			uint8_t* ptr = pages->data.data() + pages->offset[i];
+			ok = fread(ptr, size, 1, f) == 1;
+			if (ok && size != DirtyPages::PageSize)
+			{
+				ok = Lz4::Decompress(ptr, size, page.data(), page.size());
+			}
+		}
+		pages->offset[pageCount] = (uint32_t)pages->data.size();
+	}
+
+	fclose(f);
+
+	if (!ok)
+	{
+		DBReport2(DbgChannel::Error, "Savestate is damaged: %s\n", filename);
+		return nullptr;
+	}
+
+	return snapshot;
+}
+
+#pragma endregion "Snapshot"
+
+#pragma region "SnapshotWorker"
+
+std::vector<SnapshotWorker::Job> SnapshotWorker::jobs;
+SpinLock SnapshotWorker::lock;
+Thread* SnapshotWorker::thread = nullptr;
+std::atomic<bool> SnapshotWorker::busy = false;
+std::atomic<bool> SnapshotWorker::stopRequested = false;
+std::atomic<bool> SnapshotWorker::stopped = false;
+
+void SnapshotWorker::Start()
+{
+	if (thread)
+	{
+		return;
+	}
+
+	stopRequested = false;
+	stopped = false;
+	thread = new Thread(WorkerThreadProc, false, nullptr, "SnapshotWorker");
+	assert(thread);
+}
+
+void SnapshotWorker::Stop()
+{
+	if (!thread)
+	{
+		return;
+	}
+
+	// The thread finishes by itself, so a file is never left half-written.
+	stopRequested = true;
+	while (!stopped)
+	{
+		Sleep(1);
+	}
+	delete thread;
+	thread = nullptr;
+}
+
+void SnapshotWorker::Post(std::shared_ptr<Snapshot> snapshot, const std::string& filename, bool flatten)
+{
+	Job job;
+	job.snapshot = snapshot;
+	job.filename = filename;
+	job.flatten = flatten;
+
+	lock.Lock();
+	jobs.push_back(job);
+	lock.Unlock();
+}
+
+void SnapshotWorker::Flush()
+{
+	while (true)
+	{
+		lock.Lock();
+		bool idle = jobs.empty() && !busy;
+		lock.Unlock();
+
+		if (idle || !thread)
+		{
+			break;
+		}
+		Sleep(1);
+	}
+}
+
+void SnapshotWorker::WorkerThreadProc(void* param)
+{
+	while (true)
+	{
+		lock.Lock();
+		if (jobs.empty())
+		{
+			lock.Unlock();
+			if (stopRequested)
+			{
+				break;
+			}
+			Sleep(1);
+			continue;
+		}
+		Job job = jobs.front();
+		jobs.erase(jobs.begin());
+		busy = true;
+		lock.Unlock();
+
+		job.snapshot->Compress();
+
+		if (job.flatten)
+		{
+			job.snapshot->Flatten();
+		}
+
+		if (!job.filename.empty())
+		{
+			if (job.snapshot->SaveFile(job.filename.c_str()))
+			{
+				DBReport("Saved state: %s\n", job.filename.c_str());
+			}
+			else
+			{
+				DBReport2(DbgChannel::Error, "Failed to save state: %s\n", job.filename.c_str());
+			}
+		}
+
+		busy = false;
+	}
+
+	stopped = true;
+}
+
+#pragma endregion "SnapshotWorker"
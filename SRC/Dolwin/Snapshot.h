@@ -0,0 +1,132 @@
+// Savestates.
+// Description in Docs\EMU\SaveStates.md
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Savestate file header. The device state follows (devicesSize bytes), then all pages of RAM and ARAM (Snapshot::SaveFile).
+
+struct SnapshotHeader
+{
+	char magic[8];				// DOLWSTAT
+	uint32_t version;
+	uint32_t flags;				// SnapshotFlags
+	int64_t ticks;				// Gekko TBR
+	uint32_t ramSize;
+	uint32_t aramSize;
+	uint64_t devicesSize;
+};
+
+static const uint32_t SnapshotVersion = 1;
+
+enum SnapshotFlags : uint32_t
+{
+	SnapshotCompressed = 1,		// Pages are compressed by LZ4
+};
+
+// The pages of one memory (RAM or ARAM) saved by the snapshot, in ascending order.
+// A page that did not get smaller by compression is kept as is, so the stored size tells which one it is.
+
+class SnapshotPages
+{
+	std::vector<uint32_t> index;		// Page numbers
+	std::vector<uint32_t> offset;		// Offset of each page in data, plus the end
+	std::vector<uint8_t> data;
+	bool compressed = false;
+
+	friend class Snapshot;
+
+public:
+	void Capture(uint8_t* memory, DirtyPages& dirty, bool full);
+	// Only the worker calls it. The new pages are swapped in under the lock of the snapshot, so the restore can read the old ones meanwhile.
+	void Compress(SpinLock& lock);
+
+	// Writes the pages that are not written yet (done[page] == 0). The snapshot chain is walked from the newest, so the newest copy wins.
+	bool Restore(uint8_t* memory, std::vector<uint8_t>& done);
+
+	size_t Count() { return index.size(); }
+	size_t Size() { return data.size() + (index.size() + offset.size()) * sizeof(uint32_t); }
+};
+
+// The state of the emulated machine at some moment.
+// A full snapshot has all memory pages, an incremental one has only the pages written since its parent and refers to it.
+
+class Snapshot
+{
+	std::shared_ptr<Snapshot> parent;
+	int64_t ticks = 0;
+	size_t ramSize = 0;
+	size_t aramSize = 0;
+	std::vector<uint8_t> devices;			// Gekko, Flipper, DSP and DVD (StateStream)
+	SnapshotPages ram;
+	SnapshotPages aram;
+
+	SpinLock lock;							// Compression by the worker replaces the pages
+
+	// The snapshot the emulated memory was compared against last time (captured or restored).
+	// The dirty pages are the difference with it, so all snapshots must be captured and restored through this class. Each instance has its own.
+	static std::shared_ptr<Snapshot>& Last() { return Instance::Get()->lastSnapshot; }
+
+	static void CaptureAtSafePoint(void* context);
+	static void RestoreAtSafePoint(void* context);
+	static void ResetAtSafePoint(void* context);
+
+	bool RestoreInternal();
+	bool MergePages(bool auxMemory, SnapshotPages& merged);
+
+public:
+	// Takes the snapshot between Gekko instructions. Costs one copy of the dirty pages (all pages for a full snapshot).
+	static std::shared_ptr<Snapshot> Capture(bool full);
+
+	// Returns false if the device state was rejected, the emulator state stays as before then.
+	static bool Restore(std::shared_ptr<Snapshot> snapshot);
+
+	// Forget the last snapshot (the emulator was stopped or reset). The next incremental capture becomes full.
+	static void Reset();
+
+	// LZ4 both memories. Called by the worker, the snapshot can be restored meanwhile.
+	void Compress();
+
+	// Merge the pages of the parents, so the snapshot becomes full and the parents can be freed. Called by the worker.
+	void Flatten();
+
+	// The file always has all pages: an incremental snapshot is merged with its parents.
+	bool SaveFile(const char* filename);
+	static std::shared_ptr<Snapshot> LoadFile(const char* filename);
+
+	int64_t GetTicks() { return ticks; }
+	bool IsFull();
+	size_t Size();			// Bytes used by the snapshot itself (without the parents)
+};
+
+// Compresses snapshots and writes savestate files in background, so the emulation thread only pays for copying the pages.
+
+class SnapshotWorker
+{
+	struct Job
+	{
+		std::shared_ptr<Snapshot> snapshot;
+		std::string filename;			// Empty: only compress
+		bool flatten;
+	};
+
+	static std::vector<Job> jobs;
+	static SpinLock lock;
+	static Thread* thread;
+	static std::atomic<bool> busy;			// A job is taken from the queue and not finished yet
+	static std::atomic<bool> stopRequested;
+	static std::atomic<bool> stopped;
+
+	static void WorkerThreadProc(void* param);
+
+public:
+	static void Start();
+	static void Stop();			// Finishes the queued jobs
+
+	static void Post(std::shared_ptr<Snapshot> snapshot, const std::string& filename, bool flatten = false);
+	static void Flush();		// Wait until the queue is empty
+};
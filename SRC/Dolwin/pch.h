@@ -29,6 +29,9 @@
 #include "../Common/Spinlock.h"
 #include "../Common/Jdi.h"
 #include "../Common/String.h"
+#include "../Common/PerfCounters.h"
+#include "../Common/StateStream.h"
+#include "../Common/Lz4.h"
 #include "../Core/Gekko.h"
 #include "../Core/Interpreter.h"
 #include "../HighLevel/HighLevel.h"
@@ -40,6 +43,8 @@
 
 #include "Loader.h"
 #include "Emulator.h"
+#include "Snapshot.h"
+#include "Rewind.h"
 
 #include "../../ThirdParty/fmt/fmt/format.h"
 #include "../../ThirdParty/fmt/fmt/printf.h"
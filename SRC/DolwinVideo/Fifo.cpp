@@ -847,6 +847,7 @@ static void GxCommand(GX::FifoProcessor * fifo)
             static   Vertex   quad[4];
             unsigned vatnum = cmd & 7;
             unsigned vtxnum = fifo->Read16();
+            Debug::PerfAdd(Debug::PerfCounter::Vertices, vtxnum);
             usevat = vatnum;
             //DBReport2(DbgChannel::GP, "OP_CMD_DRAW_QUAD: vtxnum: %i\n", vtxnum);
                                                         /*/
@@ -884,6 +885,7 @@ static void GxCommand(GX::FifoProcessor * fifo)
             static   Vertex   tri[3];
             unsigned vatnum = cmd & 7;
             unsigned vtxnum = fifo->Read16();
+            Debug::PerfAdd(Debug::PerfCounter::Vertices, vtxnum);
             usevat = vatnum;
             //DBReport2(DbgChannel::GP, "OP_CMD_DRAW_TRIANGLE: vtxnum: %i\n", vtxnum);
                                                         /*/
@@ -921,6 +923,7 @@ static void GxCommand(GX::FifoProcessor * fifo)
             unsigned c = 2, order[3] = { 0, 1, 2 }, tmp;
             unsigned vatnum = cmd & 7;
             unsigned vtxnum = fifo->Read16();
+            Debug::PerfAdd(Debug::PerfCounter::Vertices, vtxnum);
             usevat = vatnum;
             //DBReport2(DbgChannel::GP, "OP_CMD_DRAW_STRIP: vtxnum: %i\n", vtxnum);
                                                         /*/
@@ -973,6 +976,7 @@ static void GxCommand(GX::FifoProcessor * fifo)
             unsigned c = 2, order[2] = { 1, 2 }, tmp;
             unsigned vatnum = cmd & 7;
             unsigned vtxnum = fifo->Read16();
+            Debug::PerfAdd(Debug::PerfCounter::Vertices, vtxnum);
             usevat = vatnum;
             //DBReport2(DbgChannel::GP, "OP_CMD_DRAW_FAN: vtxnum: %i\n", vtxnum);
                                                         /*/
@@ -1024,6 +1028,7 @@ static void GxCommand(GX::FifoProcessor * fifo)
             static   Vertex   v[2];
             unsigned vatnum = cmd & 7;
             unsigned vtxnum = fifo->Read16();
+            Debug::PerfAdd(Debug::PerfCounter::Vertices, vtxnum);
             usevat = vatnum;
             //DBReport2(DbgChannel::GP, "OP_CMD_DRAW_LINE: vtxnum: %i\n", vtxnum);
                                                         /*/
@@ -1061,6 +1066,7 @@ static void GxCommand(GX::FifoProcessor * fifo)
             unsigned c = 1, order[2] = { 0, 1 }, tmp;
             unsigned vatnum = cmd & 7;
             unsigned vtxnum = fifo->Read16();
+            Debug::PerfAdd(Debug::PerfCounter::Vertices, vtxnum);
             usevat = vatnum;
             //DBReport2(DbgChannel::GP, "OP_CMD_DRAW_LINESTRIP: vtxnum: %i\n", vtxnum);
                                                         /*/
@@ -1108,6 +1114,7 @@ static void GxCommand(GX::FifoProcessor * fifo)
             static  Vertex  p;
             unsigned vatnum = cmd & 7;
             unsigned vtxnum = fifo->Read16();
+            Debug::PerfAdd(Debug::PerfCounter::Vertices, vtxnum);
             usevat = vatnum;
             //DBReport2(DbgChannel::GP, "OP_CMD_DRAW_POINT: vtxnum: %i\n", vtxnum);
                                                         /*/
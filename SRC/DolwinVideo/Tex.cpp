@@ -265,7 +265,10 @@ void LoadTexture(uint32_t addr, int id, int fmt, int width, int height)
     tcache[n].rgbaData = rgbabuf;
     texbuf = tcache[n].rgbaData;
 
-    // convert texture
+    // convert texture (the timer also covers the upload)
+    Debug::PerfAdd(Debug::PerfCounter::TextureDecodes);
+    Debug::PerfTimer decodeTimer(Debug::PerfCounter::TextureDecodeTime);
+
     switch(fmt)
     {
         // "intensity 4". 2 texels per byte, grayscale 0..15
@@ -37,4 +37,5 @@
 #include "Tev.h"
 #include "GPRegs.h"
 
+#include "../Common/PerfCounters.h"
 #include "../Debugger/Debugger.h"
@@ -32,14 +32,14 @@
 /*/
 
 // AI state (registers and other data)
-AIControl ai;
+InstanceRef<AIControl, &Instance::ai> ai;
 
 // ---------------------------------------------------------------------------
 // AIDCR
 
 static void write_aidcr(uint32_t addr, uint32_t data)
 {
-    if (ai.log)
+    if (ai->log)
     {
         DBReport2(DbgChannel::AI, "AIDCR: 0x%04X (RESETMOD:%i, DSPINTMSK:%i, DSPINT:%i, ARINTMSK:%i, ARINT:%i, AIINTMSK:%i, AIINT:%i, HALT:%i, DINT:%i, RES:%i\n", 
             data,
@@ -140,7 +140,7 @@ void AIDINT()
     if(AIDCR & AIDCR_AIINTMSK)
     {
         PIAssertInt(PI_INTERRUPT_DSP);
-        if (ai.log)
+        if (ai->log)
         {
             DBReport2(DbgChannel::AI, "AIDINT");
         }
@@ -151,19 +151,19 @@ void AIDINT()
 static int64_t AIGetTime(size_t dmaBytes, long rate)
 {
     size_t samples = dmaBytes / 4;    // left+right, 16-bit
-    return samples * (ai.one_second / rate);
+    return samples * (ai->one_second / rate);
 }
 
 static void AIStartDMA()
 {
-    ai.dcnt = ai.len & ~AID_EN;
-    ai.dmaTime = Gekko::Gekko->GetTicks() + AIGetTime(32, ai.dmaRate);
-    ai.currentDmaAddr = (ai.madr_hi << 16) | ai.madr_lo;
-    if (ai.log)
+    ai->dcnt = ai->len & ~AID_EN;
+    ai->dmaTime = Gekko::Gekko->GetTicks() + AIGetTime(32, ai->dmaRate);
+    ai->currentDmaAddr = (ai->madr_hi << 16) | ai->madr_lo;
+    if (ai->log)
     {
-        DBReport2(DbgChannel::AI, "DMA started: %08X, %i bytes\n", ai.currentDmaAddr, ai.dcnt * 32);
+        DBReport2(DbgChannel::AI, "DMA started: %08X, %i bytes\n", ai->currentDmaAddr, ai->dcnt * 32);
     }
-    ai.audioThread->Resume();
+    ai->audioThread->Resume();
 }
 
 // Simulate AI FIFO
@@ -173,27 +173,27 @@ static void AIFeedMixer()
 
     BeginProfileSfx();
 
-    if (ai.dcnt == 0 || (ai.len & AID_EN) == 0)
+    if (ai->dcnt == 0 || (ai->len & AID_EN) == 0)
     {
-        Flipper::HW->Mixer->PushBytes(Flipper::AxChannel::AudioDma, ai.zeroes, bytes);
+        Flipper::HW->Mixer->PushBytes(Flipper::AxChannel::AudioDma, ai->zeroes, bytes);
     }
     else
     {
-        Flipper::HW->Mixer->PushBytes(Flipper::AxChannel::AudioDma, &mi.ram[ai.currentDmaAddr & RAMMASK], bytes);
-        ai.currentDmaAddr += bytes;
-        ai.dcnt--;
+        Flipper::HW->Mixer->PushBytes(Flipper::AxChannel::AudioDma, &mi->ram[ai->currentDmaAddr & RAMMASK], bytes);
+        ai->currentDmaAddr += bytes;
+        ai->dcnt--;
     }
 
     EndProfileSfx();
 
-    ai.dmaTime = Gekko::Gekko->GetTicks() + AIGetTime(bytes, ai.dmaRate);
+    ai->dmaTime = Gekko::Gekko->GetTicks() + AIGetTime(bytes, ai->dmaRate);
 }
 
 static void AIStopDMA()
 {
-    ai.dmaTime = -1;
-    ai.dcnt = 0;
-    if (ai.log)
+    ai->dmaTime = -1;
+    ai->dcnt = 0;
+    if (ai->log)
     {
         DBReport2(DbgChannel::AI, "DMA stopped\n");
     }
@@ -202,7 +202,7 @@ static void AIStopDMA()
 static void AISetDMASampleRate(Flipper::AudioSampleRate rate)
 {
     Flipper::HW->Mixer->SetSampleRate(Flipper::AxChannel::AudioDma, rate);
-    if (ai.log)
+    if (ai->log)
     {
         DBReport2(DbgChannel::AI, "DMA sample rate: %i\n", rate == Flipper::AudioSampleRate::Rate_32000 ? 32000 : 48000);
     }
@@ -221,7 +221,7 @@ static void AISetDvdAudioSampleRate(Flipper::AudioSampleRate rate)
         DVD::DDU->SetDvdAudioSampleRate(DVD::DvdAudioSampleRate::Rate_32000);
     }
 
-    if (ai.log)
+    if (ai->log)
     {
         DBReport2(DbgChannel::AIS, "DVD Audio sample rate: %i\n", rate == Flipper::AudioSampleRate::Rate_32000 ? 32000 : 48000);
     }
@@ -233,16 +233,16 @@ static void AISetDvdAudioSampleRate(Flipper::AudioSampleRate rate)
 
 static void write_dmah(uint32_t addr, uint32_t data)
 {
-    ai.madr_hi = (uint16_t)data & 0x3FF;
+    ai->madr_hi = (uint16_t)data & 0x3FF;
 }
 
 static void write_dmal(uint32_t addr, uint32_t data)
 {
-    ai.madr_lo = (uint16_t)data & ~0x1F;
+    ai->madr_lo = (uint16_t)data & ~0x1F;
 }
 
-static void read_dmah(uint32_t addr, uint32_t *reg) { *reg = ai.madr_hi & 0x3FF; }
-static void read_dmal(uint32_t addr, uint32_t *reg) { *reg = ai.madr_lo & ~0x1F; }
+static void read_dmah(uint32_t addr, uint32_t *reg) { *reg = ai->madr_hi & 0x3FF; }
+static void read_dmal(uint32_t addr, uint32_t *reg) { *reg = ai->madr_lo & ~0x1F; }
 
 //
 // dma length / control
@@ -250,10 +250,10 @@ static void read_dmal(uint32_t addr, uint32_t *reg) { *reg = ai.madr_lo & ~0x1F;
 
 static void write_len(uint32_t addr, uint32_t data)
 {
-    ai.len = (uint16_t)data;
+    ai->len = (uint16_t)data;
 
     // start/stop audio dma transfer
-    if(ai.len & AID_EN)
+    if(ai->len & AID_EN)
     {
         AIStartDMA();
         if (!Flipper::HW->Mixer->IsEnabled(Flipper::AxChannel::AudioDma))
@@ -272,7 +272,7 @@ static void write_len(uint32_t addr, uint32_t data)
 }
 static void read_len(uint32_t addr, uint32_t *reg)
 {
-    *reg = ai.len;
+    *reg = ai->len;
 }
 
 //
@@ -281,7 +281,7 @@ static void read_len(uint32_t addr, uint32_t *reg)
 
 static void read_dcnt(uint32_t addr, uint32_t *reg)
 {
-    *reg = ai.dcnt & 0x7FFF;
+    *reg = ai->dcnt & 0x7FFF;
 }
 
 // ---------------------------------------------------------------------------
@@ -291,13 +291,13 @@ static void read_dcnt(uint32_t addr, uint32_t *reg)
 void AISINT()
 {
     // only if AIINT is validated
-    if((ai.cr & AICR_AIINTVLD) == 0)
+    if((ai->cr & AICR_AIINTVLD) == 0)
     {
-        ai.cr |= AICR_AIINT;
-        if(ai.cr & AICR_AIINTMSK)
+        ai->cr |= AICR_AIINT;
+        if(ai->cr & AICR_AIINTMSK)
         {
             PIAssertInt(PI_INTERRUPT_AI);
-            if (ai.log)
+            if (ai->log)
             {
                 DBReport2(DbgChannel::AIS, "AISINT\n");
             }
@@ -308,29 +308,29 @@ void AISINT()
 // AI control register
 static void write_cr(uint32_t addr, uint32_t data)
 {
-    ai.cr = data & 0x7F;
+    ai->cr = data & 0x7F;
 
     // clear stream interrupt
-    if(ai.cr & AICR_AIINT)
+    if(ai->cr & AICR_AIINT)
     {
-        ai.cr &= ~AICR_AIINT;
+        ai->cr &= ~AICR_AIINT;
         PIClearInt(PI_INTERRUPT_AI);
     }
 
     // enable sample counter
-    if (ai.cr & AICR_PSTAT)
+    if (ai->cr & AICR_PSTAT)
     {
-        if (ai.log)
+        if (ai->log)
         {
             DBReport2(DbgChannel::AIS, "start streaming clock\n");
         }
         DVD::DDU->EnableAudioStreamClock(true);
         Flipper::HW->Mixer->Enable(Flipper::AxChannel::DvdAudio, true);
-        ai.streamFifoPtr = 0;
+        ai->streamFifoPtr = 0;
     }
     else
     {
-        if (ai.log)
+        if (ai->log)
         {
             DBReport2(DbgChannel::AIS, "stop streaming clock\n");
         }
@@ -339,62 +339,62 @@ static void write_cr(uint32_t addr, uint32_t data)
     }
 
     // reset sample counter
-    if(ai.cr & AICR_SCRESET)
+    if(ai->cr & AICR_SCRESET)
     {
-        if (ai.log)
+        if (ai->log)
         {
             DBReport2(DbgChannel::AIS, "reset sample counter\n");
         }
-        ai.scnt = 0;
-        ai.cr &= ~AICR_SCRESET;
+        ai->scnt = 0;
+        ai->cr &= ~AICR_SCRESET;
     }
 
     // set DMA sample rate
-    if (ai.cr & AICR_DFR)
+    if (ai->cr & AICR_DFR)
     {
-        ai.dmaRate = 32000;
+        ai->dmaRate = 32000;
         AISetDMASampleRate(Flipper::AudioSampleRate::Rate_32000);
     }
     else
     {
-        ai.dmaRate = 48000;
+        ai->dmaRate = 48000;
         AISetDMASampleRate(Flipper::AudioSampleRate::Rate_48000);
     }
 
     // set DVD Audio sample rate
-    if (ai.cr & AICR_AFR) AISetDvdAudioSampleRate(Flipper::AudioSampleRate::Rate_48000);
+    if (ai->cr & AICR_AFR) AISetDvdAudioSampleRate(Flipper::AudioSampleRate::Rate_48000);
     else AISetDvdAudioSampleRate(Flipper::AudioSampleRate::Rate_32000);
 }
 static void read_cr(uint32_t addr, uint32_t *reg)
 {
-    *reg = ai.cr;
+    *reg = ai->cr;
 }
 
 // stream samples counter
 static void read_scnt(uint32_t addr, uint32_t *reg)
 {
-    *reg = ai.scnt;
+    *reg = ai->scnt;
 }
 
 // interrupt trigger
 static void write_it(uint32_t addr, uint32_t data)
 {
-    if (ai.log)
+    if (ai->log)
     {
         DBReport2(DbgChannel::AIS, "set trigger to : 0x%08X\n", data);
     }
-    ai.it = data;
+    ai->it = data;
 }
-static void read_it(uint32_t addr, uint32_t *reg)     { *reg = ai.it; }
+static void read_it(uint32_t addr, uint32_t *reg)     { *reg = ai->it; }
 
 // stream volume register
 static void write_vr(uint32_t addr, uint32_t data)
 {
-    ai.vr = (uint16_t)data;
+    ai->vr = (uint16_t)data;
 }
 static void read_vr(uint32_t addr, uint32_t *reg)
 {
-    *reg = ai.vr;
+    *reg = ai->vr;
 }
 
 // ---------------------------------------------------------------------------
@@ -413,7 +413,7 @@ static void write_in_mbox_l(uint32_t addr, uint32_t data) { DBHalt("Processor is
 
 void DSPAssertInt()
 {
-    if (ai.log)
+    if (ai->log)
     {
         DBReport2(DbgChannel::AI, "DSPAssertInt\n");
     }
@@ -450,40 +450,51 @@ static uint16_t AdjustVolume(uint16_t sampleValue, int volume)
     return (uint16_t)(adjusted * (float)0xFFFF);
 }
 
-// Called from DDU Core when DVD Audio decodes the next sample
-static void AIStreamCallback(uint16_t l, uint16_t r)
+// Called from DDU Core when DVD Audio decodes the next batch of samples (interleaved LR)
+static void AIStreamCallback(uint16_t* pcm, size_t samples)
 {
-    // Check FIFO overflow
-    if (ai.streamFifoPtr >= sizeof(ai.streamFifo))
-    {
-        ai.streamFifoPtr = 0;
-        // Feed mixer
-        Flipper::HW->Mixer->PushBytes(Flipper::AxChannel::DvdAudio, ai.streamFifo, sizeof(ai.streamFifo));
-    }
-
-    // Adjust volume and swap endianess
-    int leftVolume = (uint8_t)ai.vr;
-    int rightVolume = (uint8_t)(ai.vr >> 8);
-    l = _byteswap_ushort(l);
-    r = _byteswap_ushort(r);
+    // Adjust volume
+    int leftVolume = (uint8_t)ai->vr;
+    int rightVolume = (uint8_t)(ai->vr >> 8);
     //l = AdjustVolume(l, leftVolume);
     //r = AdjustVolume(r, rightVolume);
 
-    // Put sample in FIFO
-    uint16_t* ptr = (uint16_t *)&ai.streamFifo[ai.streamFifoPtr];
+    size_t count = samples;
 
-    ptr[0] = l;
-    ptr[1] = r;
+    while (count != 0)
+    {
+        // Check FIFO overflow
+        if (ai->streamFifoPtr >= sizeof(ai->streamFifo))
+        {
+            ai->streamFifoPtr = 0;
+            // Feed mixer
+            Flipper::HW->Mixer->PushBytes(Flipper::AxChannel::DvdAudio, ai->streamFifo, sizeof(ai->streamFifo));
+        }
+
+        // Put as many samples in FIFO as fit, swap endianess
+        size_t n = min(count, (sizeof(ai->streamFifo) - ai->streamFifoPtr) / 4);
+        uint16_t* ptr = (uint16_t *)&ai->streamFifo[ai->streamFifoPtr];
+
+        for (size_t i = 0; i < 2 * n; i++)
+        {
+            ptr[i] = _byteswap_ushort(pcm[i]);
+        }
 
-    ai.streamFifoPtr += 4;
+        pcm += 2 * n;
+        count -= n;
+        ai->streamFifoPtr += 4 * n;
+    }
 
-    // update stream sample counter
-    if (ai.cr & AICR_PSTAT)
+    // update stream sample counter. Counted per sample, so AISINT is raised when AISCNT crosses AIIT inside the batch.
+    if (ai->cr & AICR_PSTAT)
     {
-        ai.scnt++;
-        if (ai.scnt >= ai.it)
+        for (size_t i = 0; i < samples; i++)
         {
-            AISINT();
+            ai->scnt++;
+            if (ai->scnt >= ai->it)
+            {
+                AISINT();
+            }
         }
     }
 }
@@ -493,31 +504,33 @@ static void AIUpdate(void *Parameter)
 {
     while (true)
     {
-        if ((uint64_t)Gekko::Gekko->GetTicks() >= ai.dmaTime)
+        ai->audioThread->ParkPoint();
+
+        if ((uint64_t)Gekko::Gekko->GetTicks() >= ai->dmaTime)
         {
-            if (ai.dcnt == 0)
+            if (ai->dcnt == 0)
             {
-                if (ai.len & AID_EN)
+                if (ai->len & AID_EN)
                 {
                     // Restart Dma and signal AID_INT
-                    ai.currentDmaAddr = (ai.madr_hi << 16) | ai.madr_lo;
-                    ai.dcnt = ai.len & ~AID_EN;
+                    ai->currentDmaAddr = (ai->madr_hi << 16) | ai->madr_lo;
+                    ai->dcnt = ai->len & ~AID_EN;
                     AIDINT();
                 }
                 else
                 {
-                    ai.audioThread->Suspend();
+                    ai->audioThread->Suspend();
                 }
             }
             else
             {
-                if (ai.len & AID_EN)
+                if (ai->len & AID_EN)
                 {
                     AIFeedMixer();
                 }
                 else
                 {
-                    ai.audioThread->Suspend();
+                    ai->audioThread->Suspend();
                 }
             }
         }
@@ -529,17 +542,17 @@ void AIOpen(HWConfig* config)
     DBReport2(DbgChannel::AI, "Audio interface (DMA, DVD Streaming and DSP)\n");
 
     // clear regs
-    memset(&ai, 0, sizeof(AIControl));
+    memset(ai.Get(), 0, sizeof(AIControl));
     
     DVD::DDU->SetStreamCallback(AIStreamCallback);
 
-    ai.audioThread = new Thread(AIUpdate, true, nullptr, "AI");
-    assert(ai.audioThread);
+    ai->audioThread = new Thread(AIUpdate, true, nullptr, "AI");
+    assert(ai->audioThread);
 
-    ai.one_second = Gekko::Gekko->OneSecond();
-    ai.dmaRate = ai.cr & AICR_DFR ? 32000 : 48000;
-    ai.dmaTime = Gekko::Gekko->GetTicks() + AIGetTime(32, ai.dmaRate);
-    ai.log = false;
+    ai->one_second = Gekko::Gekko->OneSecond();
+    ai->dmaRate = ai->cr & AICR_DFR ? 32000 : 48000;
+    ai->dmaTime = Gekko::Gekko->GetTicks() + AIGetTime(32, ai->dmaRate);
+    ai->log = false;
     AIStopDMA();
 
     // set register traps
@@ -564,7 +577,38 @@ void AIOpen(HWConfig* config)
 void AIClose()
 {
     AIStopDMA();
-    delete ai.audioThread;
-    ai.audioThread = nullptr;
+    delete ai->audioThread;
+    ai->audioThread = nullptr;
     DVD::DDU->SetStreamCallback(nullptr);
 }
+
+void AIDoState(StateStream& state)
+{
+    uint16_t dcr = ai->dcr;
+    bool dmaRunning = ai->audioThread->IsRunning();
+
+    state.BeginSection('AI  ', 1);
+    state.Do(dcr);
+    state.Do(ai->madr_hi);
+    state.Do(ai->madr_lo);
+    state.Do(ai->len);
+    state.Do(ai->dcnt);
+    state.Do(ai->cr);
+    state.Do(ai->vr);
+    state.Do(ai->scnt);
+    state.Do(ai->it);
+    state.Do(ai->currentDmaAddr);
+    state.Do(ai->dmaRate);
+    state.Do(ai->dmaTime);
+    state.Do(ai->streamFifo);
+    state.Do(ai->streamFifoPtr);
+    state.Do(dmaRunning);
+    state.EndSection();
+
+    if (state.IsLoading() && !state.Failed())
+    {
+        ai->dcr = dcr;
+        if (dmaRunning) ai->audioThread->Resume();
+        else ai->audioThread->Suspend();
+    }
+}
@@ -41,7 +41,7 @@
 #define AICR_AFR            (1 << 1)        // AIS sample rate. 0 - 32000, 1 - 48000
 #define AICR_PSTAT          (1 << 0)        // This bit enables the DDU AISLR clock
 
-#define AIDCR               ai.dcr
+#define AIDCR               ai->dcr
 
 // ---------------------------------------------------------------------------
 // hardware API
@@ -79,10 +79,11 @@ struct AIControl
     uint8_t     zeroes[32];
 };
 
-extern  AIControl ai;
+extern  InstanceRef<AIControl, &Instance::ai> ai;
 
 void    AIOpen(HWConfig * config);
 void    AIClose();
+void    AIDoState(StateStream& state);
 
 // Used by DspCore
 
@@ -23,7 +23,7 @@
 
 --------------------------------------------------------------------------- */
 
-ARControl aram;
+InstanceRef<ARControl, &Instance::aram> aram;
 
 // ---------------------------------------------------------------------------
 
@@ -32,7 +32,7 @@ static void ARINT()
     AIDCR |= AIDCR_ARINT;
     if(AIDCR & AIDCR_ARINTMSK)
     {
-        if (aram.log)
+        if (aram->log)
         {
             DBReport2(DbgChannel::AR, "ARINT\n");
         }
@@ -40,62 +40,84 @@ static void ARINT()
     }
 }
 
-static void ARAMDmaThread(void* Parameter)
+// Copy part of the current DMA transfer
+static void ARTransfer(uint32_t offset, uint32_t bytes)
 {
-    while (true)
+    uint32_t araddr = aram->dmaAraddr + offset;
+    uint32_t mmaddr = (aram->dmaMmaddr + offset) & RAMMASK;
+
+    // Do not go out of memory buffers
+    if (araddr >= ARAMSIZE || mmaddr >= mi->ramSize)
+        return;
+    bytes = min(bytes, ARAMSIZE - araddr);
+    bytes = min(bytes, (uint32_t)mi->ramSize - mmaddr);
+
+    if (aram->dmaType == RAM_TO_ARAM)
+    {
+        memcpy(&ARAM[araddr], &mi->ram[mmaddr], bytes);
+        aram->dirty.Mark(araddr, bytes);
+    }
+    else
     {
-        if (Gekko::Gekko->GetTicks() < aram.gekkoTicks)
-            continue;
-        aram.gekkoTicks = Gekko::Gekko->GetTicks() + aram.gekkoTicksPerSlice;
+        memcpy(&mi->ram[mmaddr], &ARAM[araddr], bytes);
+        mi->dirty.Mark(mmaddr, bytes);
+    }
+}
 
-        int type = aram.cnt >> 31;
-        uint32_t cnt = aram.cnt & 0x3FF'FFE0;
+// Called from HW update. Finish DMA when its time has come (and advance it in chunked mode).
+void ARUpdate()
+{
+    if (!aram->dmaActive)
+        return;
 
-        // blast data
-        if (type == RAM_TO_ARAM)
-        {
-            memcpy(&ARAM[aram.araddr], &mi.ram[aram.mmaddr], 32);
-        }
-        else
-        {
-            memcpy(&mi.ram[aram.mmaddr], &ARAM[aram.araddr], 32);
-        }
+    int64_t ticks = Gekko::Gekko->GetTicks();
 
-        aram.araddr += 32;
-        aram.mmaddr += 32;
-        cnt -= 32;
-        aram.cnt = cnt | (type << 31);
+    if (aram->chunked)
+    {
+        // How many bytes should be transferred by now
+        uint32_t slices = (uint32_t)min((int64_t)aram->dmaCount / 32, (ticks - aram->dmaStartTicks) / (int64_t)aram->gekkoTicksPerSlice);
+        uint32_t done = slices * 32;
 
-        if ((aram.cnt & ~0x8000'0000) == 0)
+        if (done > aram->dmaDone)
         {
-            AIDCR &= ~AIDCR_ARDMA;
-            ARINT();                    // invoke aram TC interrupt
-            //if (aram.dspRunningBeforeAramDma)
-            //{
-            //    Flipper::HW->DSP->Run();
-            //}
-            aram.dmaThread->Suspend();
+            ARTransfer(aram->dmaDone, done - aram->dmaDone);
+            aram->dmaDone = done;
+
+            aram->araddr = aram->dmaAraddr + done;
+            aram->mmaddr = aram->dmaMmaddr + done;
+            aram->cnt = (aram->dmaCount - done) | (aram->dmaType << 31);
         }
     }
+
+    if (ticks < aram->dmaCompleteTicks)
+        return;
+
+    aram->araddr = aram->dmaAraddr + aram->dmaCount;
+    aram->mmaddr = aram->dmaMmaddr + aram->dmaCount;
+    aram->cnt = aram->dmaType << 31;
+    aram->dmaActive = false;
+
+    AIDCR &= ~AIDCR_ARDMA;
+    ARINT();                    // invoke aram TC interrupt
 }
 
 static void ARDMA()
 {
-    int type = aram.cnt >> 31;
-    int cnt = aram.cnt & 0x3FF'FFE0;
-    bool specialAramDspDma = aram.mmaddr == 0x0100'0000 && aram.araddr == 0;
+    int type = aram->cnt >> 31;
+    int cnt = aram->cnt & 0x3FF'FFE0;
+    bool specialAramDspDma = aram->mmaddr == 0x0100'0000 && aram.araddr == 0;
 
     // inform developer about aram transfers
-    if (aram.log)
+    if (aram->log)
     {
         if (type == RAM_TO_ARAM)
         {
             if (!specialAramDspDma)
             {
-                DBReport2(DbgChannel::AR, "RAM copy %08X -> %08X (%i)", aram.mmaddr, aram.araddr, cnt);
+                DBReport2(DbgChannel::AR, "RAM copy %08X -> %08X (%i)", aram->mmaddr, aram->araddr, cnt);
             }
         }
-        else DBReport2(DbgChannel::AR, "ARAM copy %08X -> %08X (%i)", aram.araddr, aram.mmaddr, cnt);
+        else DBReport2(DbgChannel::AR, "ARAM copy %08X -> %08X (%i)", aram->araddr, aram->mmaddr, cnt);
     }
 
     // Special ARAM DMA (DSP Init)
@@ -106,14 +128,14 @@ static void ARDMA()
         cnt *= 4;
 
         // Special ARAM DMA to IRAM
-        memcpy(Flipper::HW->DSP->iram, &mi.ram[aram.mmaddr], cnt);
+        memcpy(Flipper::HW->DSP->iram, &mi->ram[aram->mmaddr], cnt);
 
-        if (aram.log)
+        if (aram->log)
         {
             DBReport2(DbgChannel::DSP, "MMEM -> IRAM transfer %d bytes.\n", cnt);
         }
 
-        aram.cnt &= 0x80000000;     // clear dma counter
+        aram->cnt &= 0x80000000;     // clear dma counter
         ARINT();                    // invoke aram TC interrupt
         return;
     }
@@ -121,29 +143,39 @@ static void ARDMA()
     // ARAM driver is trying to check for expansion
     // by reading ARAM on high addresses
     // we are not allowing to read expansion
-    if(aram.araddr >= ARAMSIZE)
+    if(aram->araddr >= ARAMSIZE)
     {
         if(type == ARAM_TO_RAM)
         {
-            memset(&mi.ram[aram.mmaddr], 0, cnt);
+            memset(&mi->ram[aram->mmaddr], 0, cnt);
+            mi->dirty.Mark(aram->mmaddr, cnt);
 
-            aram.cnt &= 0x80000000;     // clear dma counter
+            aram->cnt &= 0x80000000;     // clear dma counter
             ARINT();                    // invoke aram TC interrupt
         }
         return;
     }
 
-    // For other cases - delegate job to thread
+    // For other cases - copy the data at once (or in chunks, as the time goes) and assert ARINT at the DMA completion time
 
-    assert(!aram.dmaThread->IsRunning());
+    assert(!aram->dmaActive);
     AIDCR |= AIDCR_ARDMA;
-    aram.gekkoTicks = Gekko::Gekko->GetTicks() + aram.gekkoTicksPerSlice;
-    aram.dspRunningBeforeAramDma = Flipper::HW->DSP->IsRunning();
-    //if (aram.dspRunningBeforeAramDma)
-    //{
-    //    Flipper::HW->DSP->Suspend();
-    //}
-    aram.dmaThread->Resume();
+
+    aram->dmaType = type;
+    aram->dmaMmaddr = aram->mmaddr;
+    aram->dmaAraddr = aram->araddr;
+    aram->dmaCount = cnt;
+    aram->dmaDone = 0;
+    aram->dmaStartTicks = Gekko::Gekko->GetTicks();
+    aram->dmaCompleteTicks = aram->dmaStartTicks + (int64_t)(cnt / 32) * aram->gekkoTicksPerSlice;
+
+    if (!aram->chunked)
+    {
+        ARTransfer(0, cnt);
+        aram->dmaDone = cnt;
+    }
+
+    aram->dmaActive = true;
 }
 
 // ---------------------------------------------------------------------------
@@ -153,33 +185,33 @@ static void ARDMA()
 
 static void ar_write_maddr_h(uint32_t addr, uint32_t data)
 {
-    aram.mmaddr &= 0x0000ffff;
-    aram.mmaddr |= ((data & 0x3ff) << 16);
+    aram->mmaddr &= 0x0000ffff;
+    aram->mmaddr |= ((data & 0x3ff) << 16);
 }
-static void ar_read_maddr_h(uint32_t addr, uint32_t *reg) { *reg = (aram.mmaddr >> 16) & 0x3FF; }
+static void ar_read_maddr_h(uint32_t addr, uint32_t *reg) { *reg = (aram->mmaddr >> 16) & 0x3FF; }
 
 static void ar_write_maddr_l(uint32_t addr, uint32_t data)
 {
-    aram.mmaddr &= 0xffff0000;
-    aram.mmaddr |= ((data & ~0x1F) & 0xffff);
+    aram->mmaddr &= 0xffff0000;
+    aram->mmaddr |= ((data & ~0x1F) & 0xffff);
 }
-static void ar_read_maddr_l(uint32_t addr, uint32_t *reg) { *reg = (uint16_t)aram.mmaddr & ~0x1F; }
+static void ar_read_maddr_l(uint32_t addr, uint32_t *reg) { *reg = (uint16_t)aram->mmaddr & ~0x1F; }
 
 // ARAM pointer
 
 static void ar_write_araddr_h(uint32_t addr, uint32_t data)
 {
-    aram.araddr &= 0x0000ffff;
-    aram.araddr |= ((data & 0x3FF) << 16);
+    aram->araddr &= 0x0000ffff;
+    aram->araddr |= ((data & 0x3FF) << 16);
 }
-static void ar_read_araddr_h(uint32_t addr, uint32_t *reg) { *reg = (aram.araddr >> 16) & 0x3FF; }
+static void ar_read_araddr_h(uint32_t addr, uint32_t *reg) { *reg = (aram->araddr >> 16) & 0x3FF; }
 
 static void ar_write_araddr_l(uint32_t addr, uint32_t data)
 {
-    aram.araddr &= 0xffff0000;
-    aram.araddr |= ((data & ~0x1F) & 0xffff);
+    aram->araddr &= 0xffff0000;
+    aram->araddr |= ((data & ~0x1F) & 0xffff);
 }
-static void ar_read_araddr_l(uint32_t addr, uint32_t *reg) { *reg = (uint16_t)aram.araddr & ~0x1F; }
+static void ar_read_araddr_l(uint32_t addr, uint32_t *reg) { *reg = (uint16_t)aram->araddr & ~0x1F; }
 
 //
 // byte count register
@@ -187,18 +219,18 @@ static void ar_read_araddr_l(uint32_t addr, uint32_t *reg) { *reg = (uint16_t)ar
 
 static void ar_write_cnt_h(uint32_t addr, uint32_t data)
 {
-    aram.cnt &= 0x0000ffff;
-    aram.cnt |= ((data & 0x83FF) << 16);
+    aram->cnt &= 0x0000ffff;
+    aram->cnt |= ((data & 0x83FF) << 16);
 }
-static void ar_read_cnt_h(uint32_t addr, uint32_t *reg) { *reg = (aram.cnt >> 16) & 0x83FF; }
+static void ar_read_cnt_h(uint32_t addr, uint32_t *reg) { *reg = (aram->cnt >> 16) & 0x83FF; }
 
 static void ar_write_cnt_l(uint32_t addr, uint32_t data)
 {
-    aram.cnt &= 0xffff0000;
-    aram.cnt |= ((data & ~0x1F) & 0xffff);
+    aram->cnt &= 0xffff0000;
+    aram->cnt |= ((data & ~0x1F) & 0xffff);
     ARDMA();
 }
-static void ar_read_cnt_l(uint32_t addr, uint32_t *reg) { *reg = (uint16_t)aram.cnt & ~0x1F; }
+static void ar_read_cnt_l(uint32_t addr, uint32_t *reg) { *reg = (uint16_t)aram->cnt & ~0x1F; }
 
 //
 // hacks
@@ -207,30 +239,30 @@ static void ar_read_cnt_l(uint32_t addr, uint32_t *reg) { *reg = (uint16_t)aram.
 static void no_read(uint32_t addr, uint32_t *reg)  { *reg = 0; }
 static void no_write(uint32_t addr, uint32_t data) {}
 
-static void ar_hack_size_r(uint32_t addr, uint32_t *reg) { *reg = aram.size; }
-static void ar_hack_size_w(uint32_t addr, uint32_t data) { aram.size = (uint16_t)data; }
+static void ar_hack_size_r(uint32_t addr, uint32_t *reg) { *reg = aram->size; }
+static void ar_hack_size_w(uint32_t addr, uint32_t data) { aram->size = (uint16_t)data; }
 static void ar_hack_mode(uint32_t addr, uint32_t *reg)   { *reg = 1; }
 
 // ---------------------------------------------------------------------------
 // 32-bit ARAM registers
 
-static void ar_write_maddr(uint32_t addr, uint32_t data)   { aram.mmaddr = data & 0x03FF'FFE0; }
-static void ar_read_maddr(uint32_t addr, uint32_t *reg)    { *reg = aram.mmaddr; }
+static void ar_write_maddr(uint32_t addr, uint32_t data)   { aram->mmaddr = data & 0x03FF'FFE0; }
+static void ar_read_maddr(uint32_t addr, uint32_t *reg)    { *reg = aram->mmaddr; }
 
-static void ar_write_araddr(uint32_t addr, uint32_t data)  { aram.araddr = data & 0x03FF'FFE0; }
-static void ar_read_araddr(uint32_t addr, uint32_t *reg)   { *reg = aram.araddr; }
+static void ar_write_araddr(uint32_t addr, uint32_t data)  { aram->araddr = data & 0x03FF'FFE0; }
+static void ar_read_araddr(uint32_t addr, uint32_t *reg)   { *reg = aram->araddr; }
 
 static void ar_write_cnt(uint32_t addr, uint32_t data)
 {
-    aram.cnt = data & 0x83FF'FFE0;
+    aram->cnt = data & 0x83FF'FFE0;
     ARDMA();
 }
-static void ar_read_cnt(uint32_t addr, uint32_t *reg)      { *reg = aram.cnt & 0x83FF'FFE0; }
+static void ar_read_cnt(uint32_t addr, uint32_t *reg)      { *reg = aram->cnt & 0x83FF'FFE0; }
 
 // ---------------------------------------------------------------------------
 // init
 
-void AROpen()
+void AROpen(HWConfig* config)
 {
     DBReport2(DbgChannel::AR, "Aux. memory (ARAM) driver\n");
 
@@ -240,11 +272,14 @@ void AROpen()
 
     // clear ARAM data
     memset(ARAM, 0, ARAMSIZE);
+    aram->dirty.Resize(ARAMSIZE);
 
     // clear registers
-    aram.mmaddr = aram.araddr = aram.cnt = 0;
-    aram.gekkoTicksPerSlice = 1;
-    aram.log = false;
+    aram->mmaddr = aram->araddr = aram->cnt = 0;
+    aram->gekkoTicksPerSlice = 1;
+    aram->dmaActive = false;
+    aram->chunked = config->aramChunkedDma;
+    aram->log = false;
 
     // set traps to aram registers
     MISetTrap(16, AR_DMA_MMADDR_H, ar_read_maddr_h, ar_write_maddr_h);
@@ -262,15 +297,11 @@ void AROpen()
     MISetTrap(16, AR_SIZE   , ar_hack_size_r, ar_hack_size_w);
     MISetTrap(16, AR_MODE   , ar_hack_mode  , no_write);
     MISetTrap(16, AR_REFRESH, no_read       , no_write);
-
-    aram.dmaThread = new Thread(ARAMDmaThread, true, nullptr, "ARAMDmaThread");
-    assert(aram.dmaThread);
 }
 
 void ARClose()
 {
-    delete aram.dmaThread;
-    aram.dmaThread = nullptr;
+    aram->dmaActive = false;
 
     // destroy ARAM
     if(ARAM)
@@ -279,3 +310,22 @@ void ARClose()
         ARAM = nullptr;
     }
 }
+
+// ARAM contents are not here, they are saved by pages (see Snapshot)
+void ARDoState(StateStream& state)
+{
+    state.BeginSection('AR  ', 1);
+    state.Do(aram->mmaddr);
+    state.Do(aram->araddr);
+    state.Do(aram->cnt);
+    state.Do(aram->size);
+    state.Do(aram->dmaActive);
+    state.Do(aram->dmaType);
+    state.Do(aram->dmaMmaddr);
+    state.Do(aram->dmaAraddr);
+    state.Do(aram->dmaCount);
+    state.Do(aram->dmaDone);
+    state.Do(aram->dmaStartTicks);
+    state.Do(aram->dmaCompleteTicks);
+    state.EndSection();
+}
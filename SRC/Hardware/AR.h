@@ -1,7 +1,7 @@
 #pragma once
 
 #define ARAMSIZE        (16 * 1024 * 1024)  // 16 mb
-#define ARAM            aram.mem
+#define ARAM            aram->mem
 
 // aram dma transfer type (CNT bit31)
 #define RAM_TO_ARAM     0
@@ -33,14 +33,25 @@ struct ARControl
     volatile uint32_t    mmaddr, araddr;     // DMA address
     volatile uint32_t    cnt;                // count + transfer type (bit31)
     uint16_t    size;               // "AR_SIZE" (0x5012) register
-    Thread* dmaThread;
-    int64_t gekkoTicks;
-    size_t gekkoTicksPerSlice;
-    bool dspRunningBeforeAramDma;
+
+    // DMA is performed at once, ARINT is asserted by ARUpdate when Gekko ticks reach the completion time.
+    volatile bool dmaActive;        // DMA in progress
+    int     dmaType;
+    uint32_t dmaMmaddr, dmaAraddr;  // Start addresses
+    uint32_t dmaCount;              // Total bytes
+    uint32_t dmaDone;               // Bytes already transferred (chunked mode)
+    int64_t dmaStartTicks;
+    int64_t dmaCompleteTicks;
+    size_t  gekkoTicksPerSlice;     // Gekko ticks to transfer 32 bytes
+    bool    chunked;                // Transfer data and update DMA registers progressively, for titles polling partial DMA progress
     bool log;
+
+    DirtyPages dirty;               // ARAM pages written since the last snapshot
 };
 
-void    AROpen();
+void    AROpen(HWConfig* config);
 void    ARClose();
+void    ARUpdate();
+void    ARDoState(StateStream& state);
 
-extern  ARControl aram;
+extern  InstanceRef<ARControl, &Instance::aram> aram;
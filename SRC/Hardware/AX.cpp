@@ -1,332 +1,443 @@
-// Audio mixer (DirectSound)
+// Audio mixer (platform-neutral core)
 #include "pch.h"
 
 namespace Flipper
 {
-	AudioRing::AudioRing(AudioMixer* parentInst)
-	{
-		HRESULT hr = DS_OK;
-		mixer = parentInst;
+	#pragma region "AudioResampler"
 
-		ringBuffer = new uint8_t[ringSize + 0x10];
-		assert(ringBuffer);
-		memset(ringBuffer, 0, ringSize);
+	static const float PI = 3.14159265358979f;
 
-		ringWritePtr = 0;
-		ringReadPtr = 0;
+	AudioResampler::AudioResampler()
+	{
+		filter.resize(phases * taps);
+		inLeft.resize(inputSize + taps);
+		inRight.resize(inputSize + taps);
+		SetRates(48000, 48000);
+	}
 
-		WAVEFORMATEX waveFmt = { 0 };
+	// Build filter bank: Blackman-windowed sinc, cut at 0.45 of the lower rate.
+	void AudioResampler::SetRates(uint32_t inRate, uint32_t outRate)
+	{
+		bypass = inRate == outRate;
+		step = ((uint64_t)inRate << 32) / outRate;
 
-		waveFmt.wFormatTag = WAVE_FORMAT_PCM;
-		waveFmt.nChannels = 2;
-		waveFmt.wBitsPerSample = 16;
-		waveFmt.nSamplesPerSec = 44100;
-		waveFmt.nBlockAlign = (waveFmt.wBitsPerSample / 8) * waveFmt.nChannels;
-		waveFmt.nAvgBytesPerSec = waveFmt.nSamplesPerSec * waveFmt.nBlockAlign;
-		waveFmt.cbSize = 0;
+		float cutoff = 0.45f * (float)(std::min)(inRate, outRate) / (float)inRate;
+		float halfSpan = (float)(taps / 2);
 
-		DSBUFFERDESC desc = { 0 };
+		for (size_t p = 0; p < phases; p++)
+		{
+			float frac = (float)p / (float)phases;
+			float* h = &filter[p * taps];
+			float sum = 0.0f;
 
-		desc.dwSize = sizeof(DSBUFFERDESC);
-		desc.dwFlags = DSBCAPS_CTRLPOSITIONNOTIFY | DSBCAPS_CTRLFREQUENCY | DSBCAPS_CTRLVOLUME;
-		desc.dwBufferBytes = ringSize;
-		desc.lpwfxFormat = &waveFmt;
-		desc.guid3DAlgorithm = GUID_NULL;
+			for (size_t k = 0; k < taps; k++)
+			{
+				float x = (float)k - (halfSpan - 1.0f) - frac;
+				float sinc = (x == 0.0f) ? 1.0f : sinf(2.0f * PI * cutoff * x) / (2.0f * PI * cutoff * x);
+				float w = 0.42f + 0.5f * cosf(PI * x / halfSpan) + 0.08f * cosf(2.0f * PI * x / halfSpan);
+				h[k] = sinc * w;
+				sum += h[k];
+			}
 
-		hr = mixer->lpds->CreateSoundBuffer(&desc, &DSBuffer, NULL);
-		assert(hr == DS_OK);
+			// Unity gain for every phase
+			for (size_t k = 0; k < taps; k++)
+			{
+				h[k] /= sum;
+			}
+		}
 
-		hr = DSBuffer->SetVolume(DSBVOLUME_MAX);
-		assert(hr == DS_OK);
+		Reset();
 	}
 
-	AudioRing::~AudioRing()
+	void AudioResampler::Reset()
 	{
-		delete[] ringBuffer;
-
-		if (DSBuffer)
-		{
-			DSBuffer->Stop();
-			DSBuffer->Release();
-		}
+		// Start with the history filled by silence, so that the filter is primed from the first output frame.
+		inFrames = bypass ? 0 : taps - 1;
+		std::fill(inLeft.begin(), inLeft.end(), 0.0f);
+		std::fill(inRight.begin(), inRight.end(), 0.0f);
+		pos = 0;
 	}
 
-	// Get distance between Wrptr and Rdptr
-	size_t AudioRing::CurrentSize()
+	void AudioResampler::Feed(const int16_t* frames, size_t count)
 	{
-		if (ringWritePtr >= ringReadPtr)
-		{
-			return ringWritePtr - ringReadPtr;
-		}
-		else
+		count = (std::min)(count, FreeInput());
+
+		float* left = &inLeft[inFrames];
+		float* right = &inRight[inFrames];
+		const float scale = 1.0f / 32768.0f;
+
+		for (size_t i = 0; i < count; i++)
 		{
-			return ringWritePtr + (ringSize - ringReadPtr);
+			left[i] = (float)frames[2 * i] * scale;
+			right[i] = (float)frames[2 * i + 1] * scale;
 		}
+
+		inFrames += count;
 	}
 
-	uint8_t AudioRing::FetchByte()
+	static inline float HorizontalSum(__m128 v)
 	{
-		uint8_t byte = ringBuffer[ringReadPtr++];
-		if (ringReadPtr >= ringSize)
-		{
-			ringReadPtr = 0;
-		}
-		return byte;
+		__m128 hi = _mm_movehl_ps(v, v);
+		v = _mm_add_ps(v, hi);
+		hi = _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 1, 1, 1));
+		return _mm_cvtss_f32(_mm_add_ss(v, hi));
 	}
 
-	void AudioRing::WaitBufferOverflow(void)
+	size_t AudioResampler::Produce(float* out, size_t maxFrames)
 	{
-		HRESULT hr = DS_OK;
-		DWORD dwWriteCursor, dwPlayCursor;
+		size_t produced = 0;
 
-		hr = DSBuffer->GetCurrentPosition(&dwPlayCursor, &dwWriteCursor);
-		assert(hr == DS_OK);
-
-		if (dwPlayCursor < dwWriteCursor)
+		if (bypass)
 		{
-			while (dwPlayCursor < dwWriteCursor)
+			produced = (std::min)(maxFrames, inFrames);
+			for (size_t i = 0; i < produced; i++)
 			{
-				hr = DSBuffer->GetCurrentPosition(&dwPlayCursor, &dwWriteCursor);
-				assert(hr == DS_OK);
+				out[2 * i] = inLeft[i];
+				out[2 * i + 1] = inRight[i];
 			}
+			pos = (uint64_t)produced << 32;
 		}
-	}
+		else
+		{
+			while (produced < maxFrames)
+			{
+				size_t i = (size_t)(pos >> 32);
+				if (i + taps > inFrames)
+					break;
 
-	void AudioRing::EmitSound()
-	{
-		HRESULT hr = DS_OK;
+				const float* h = &filter[((pos >> (32 - phaseBits)) & (phases - 1)) * taps];
+				const float* l = &inLeft[i];
+				const float* r = &inRight[i];
 
-		if (!enabled)
-			return;
+				__m128 accLeft = _mm_setzero_ps();
+				__m128 accRight = _mm_setzero_ps();
 
-		// Wait
+				for (size_t k = 0; k < taps; k += 4)
+				{
+					__m128 coef = _mm_loadu_ps(h + k);
+					accLeft = _mm_add_ps(accLeft, _mm_mul_ps(coef, _mm_loadu_ps(l + k)));
+					accRight = _mm_add_ps(accRight, _mm_mul_ps(coef, _mm_loadu_ps(r + k)));
+				}
 
-		//WaitBufferOverflow();
+				out[2 * produced] = HorizontalSum(accLeft);
+				out[2 * produced + 1] = HorizontalSum(accRight);
+				produced++;
+				pos += step;
+			}
+		}
 
-		// Lock and load
+		// Drop consumed input
+		size_t used = (std::min)((size_t)(pos >> 32), inFrames);
+		if (used)
+		{
+			memmove(&inLeft[0], &inLeft[used], (inFrames - used) * sizeof(float));
+			memmove(&inRight[0], &inRight[used], (inFrames - used) * sizeof(float));
+			inFrames -= used;
+			pos -= (uint64_t)used << 32;
+		}
 
-		PVOID part1 = nullptr;
-		DWORD part1Size = 0;
-		PVOID part2 = nullptr;
-		DWORD part2Size = 0;
+		return produced;
+	}
 
-		hr = DSBuffer->Lock(0, (DWORD)(frameSize * framesPerEmit), &part1, &part1Size, &part2, &part2Size,
-			DSBLOCK_FROMWRITECURSOR );
-		assert(hr == DS_OK);
+	#pragma endregion "AudioResampler"
 
-		uint8_t* ptr = (uint8_t *)part1;
-		size_t lockedBufferSize = part1Size;
+	#pragma region "WavAudioSink"
 
-		size_t byteCount = frameSize * framesPerEmit;
-		while (byteCount--)
+	WavAudioSink::WavAudioSink(const std::string& filename, uint32_t rate)
+	{
+		sampleRate = rate;
+		fopen_s(&file, filename.c_str(), "wb");
+		if (file)
 		{
-			*ptr++ = FetchByte();
-			lockedBufferSize--;
-			if (lockedBufferSize == 0)
-			{
-				ptr = (uint8_t *)part2;
-				lockedBufferSize = part2Size;
-				if (!ptr)
-					break;
-			}
+			WriteHeader();
 		}
+		else
+		{
+			DBReport2(DbgChannel::AX, "Cannot create %s\n", filename.c_str());
+		}
+	}
 
-		hr = DSBuffer->Unlock(part1, part1Size, part2, part2Size);
-		assert(hr == DS_OK);
+	WavAudioSink::~WavAudioSink()
+	{
+		if (file)
+		{
+			// Update chunk sizes
+			fseek(file, 0, SEEK_SET);
+			WriteHeader();
+			fclose(file);
+		}
 	}
 
-	void AudioRing::Enable(bool enable)
+	void WavAudioSink::WriteHeader()
 	{
-		HRESULT hr = DS_OK;
+		uint8_t header[44];
+
+		auto put32 = [&](size_t ofs, uint32_t value) { memcpy(&header[ofs], &value, 4); };
+		auto put16 = [&](size_t ofs, uint16_t value) { memcpy(&header[ofs], &value, 2); };
+
+		memcpy(&header[0], "RIFF", 4);
+		put32(4, (uint32_t)(36 + dataSize));
+		memcpy(&header[8], "WAVEfmt ", 8);
+		put32(16, 16);
+		put16(20, 1);					// PCM
+		put16(22, 2);					// Stereo
+		put32(24, sampleRate);
+		put32(28, sampleRate * 4);		// Bytes per second
+		put16(32, 4);					// Block align
+		put16(34, 16);					// Bits per sample
+		memcpy(&header[36], "data", 4);
+		put32(40, (uint32_t)dataSize);
+
+		fwrite(header, 1, sizeof(header), file);
+	}
 
-		if (enable)
+	void WavAudioSink::Write(const int16_t* frames, size_t count)
+	{
+		if (file)
 		{
-			hr = DSBuffer->Play(0, 0, bufferMode);
-			assert(hr == DS_OK);
+			fwrite(frames, 4, count, file);
+			dataSize += count * 4;
+		}
+	}
 
-			enabled = true;
+	#pragma endregion "WavAudioSink"
 
-			ringReadPtr = ringWritePtr = 0;
+	#pragma region "AudioMixer"
+
+	AudioMixer::AudioMixer(HWConfig *config)
+	{
+		outputRate = config->audioRate ? config->audioRate : 48000;
+
+		// Headless instances are not heard
+		switch (config->headless ? AudioSinkType::Null : (AudioSinkType)config->audioSink)
+		{
+			case AudioSinkType::Null:
+				sink = new NullAudioSink(outputRate);
+				break;
+			case AudioSinkType::WavFile:
+				sink = new WavAudioSink(Util::convert<char>(std::wstring(config->audioWavFilename)), outputRate);
+				break;
+			default:
+#ifdef _WINDOWS
+				sink = new DirectSoundSink(config->hwndMain, outputRate);
+#else
+				sink = new NullAudioSink(outputRate);
+#endif
+				break;
 		}
-		else
+		assert(sink);
+
+		for (auto& ch : channels)
 		{
-			hr = DSBuffer->Stop();
-			assert(hr == DS_OK);
+			ch.out.resize(2 * 2 * chunkFrames);
+		}
 
-			hr = DSBuffer->SetCurrentPosition(0);
-			assert(hr == DS_OK);
+		mixBuffer.resize(2 * chunkFrames);
+		pcmBuffer.resize(2 * chunkFrames);
 
-			enabled = false;
-		}
+		mixerThread = new Thread(MixerThreadProc, false, this, "AudioMixer");
+		assert(mixerThread);
 	}
 
-	void AudioRing::SetSampleRate(AudioSampleRate value)
+	AudioMixer::~AudioMixer()
 	{
-		HRESULT hr = DSBuffer->SetFrequency(value == AudioSampleRate::Rate_32000 ? 32000 : 48000);
-		assert(hr == DS_OK);
+		delete mixerThread;
+		delete sink;
 	}
 
-	void AudioRing::PushBytes(uint8_t* sampleData, size_t sampleDataSize)
+	void AudioMixer::MixerThreadProc(void* Parameter)
 	{
-		while (sampleDataSize != 0)
+		AudioMixer* mixer = (AudioMixer*)Parameter;
+
+		while (true)
 		{
-			ringBuffer[ringWritePtr + 1] = *sampleData++;
-			ringBuffer[ringWritePtr] = *sampleData++;
-			ringWritePtr += 2;
-			sampleDataSize -= 2;
-			if (ringWritePtr >= ringSize)
+			if (!mixer->Mix())
 			{
-				ringWritePtr = 0;
+				std::this_thread::sleep_for(std::chrono::milliseconds(1));
 			}
 		}
+	}
+
+	// Move everything available from the ring through the resampler, up to the channel output capacity.
+	void AudioMixer::FillChannel(Channel& ch)
+	{
+		int16_t temp[2 * 0x100];
+		size_t outCapacity = ch.out.size() / 2;
 
-		if (CurrentSize() >= frameSize * framesPerEmit && enabled)
+		while (ch.outFrames < outCapacity)
 		{
-			EmitSound();
+			size_t inFrames = (std::min)(ch.resampler.FreeInput(), _countof(temp) / 2);
+			inFrames = ch.ring.Pop(temp, 2 * inFrames) / 2;
+			ch.resampler.Feed(temp, inFrames);
 
-			frameCounter += framesPerEmit;
+			size_t produced = ch.resampler.Produce(&ch.out[2 * ch.outFrames], outCapacity - ch.outFrames);
+			ch.outFrames += produced;
 
-			//DumpRing();
-			//DumpDSBuffer();
-			//exit(0);
+			if (inFrames == 0 && produced == 0)
+				break;
 		}
 	}
 
-	void AudioRing::DumpDSBuffer()
+	// Mix one chunk of output frames, if there is enough data and space in the sink. Called only from the mixer thread.
+	bool AudioMixer::Mix()
 	{
-		HRESULT hr = DS_OK;
+		if (sink->GetFreeFrames() < chunkFrames)
+			return false;
 
-		char filename[0x100] = { 0, };
-		sprintf_s(filename, sizeof(filename), "Data\\AXDSBuffer_%04i.bin", (int)frameCounter);
+		bool anyEnabled = false;
+		bool allReady = true;
+		bool anyFull = false;
 
-		hr = DSBuffer->Stop();
-		assert(hr == DS_OK);
-
-		DWORD readCursor = 0;
-		DWORD writeCursor = 0;
+		for (auto& ch : channels)
+		{
+			if (ch.flush.exchange(false))
+			{
+				ch.ring.Flush();
+				ch.resampler.Reset();
+				ch.outFrames = 0;
+			}
 
-		hr = DSBuffer->GetCurrentPosition(&readCursor, &writeCursor);
-		assert(hr == DS_OK);
+			if (!ch.enabled)
+			{
+				ch.ring.Flush();
+				ch.outFrames = 0;
+				continue;
+			}
 
-		DBReport2(DbgChannel::AX, "frame: %i, readCursor: %i, writeCursor: %i\n", frameCounter, readCursor, writeCursor);
+			uint32_t rate = ch.sampleRate;
+			if (rate != ch.resamplerRate)
+			{
+				ch.resampler.SetRates(rate, outputRate);
+				ch.resamplerRate = rate;
+			}
 
-		PVOID part1 = nullptr;
-		DWORD part1Size = 0;
-		PVOID part2 = nullptr;
-		DWORD part2Size = 0;
+			FillChannel(ch);
 
-		hr = DSBuffer->Lock(0, 0, &part1, &part1Size, &part2, &part2Size, DSBLOCK_ENTIREBUFFER);
-		assert(hr == DS_OK);
-		
-		auto part1_buff = std::vector<uint8_t>();
-		part1_buff.assign((uint8_t*)part1, (uint8_t*)part1 + part1Size);
+			anyEnabled = true;
+			if (ch.outFrames < chunkFrames)
+				allReady = false;
+			if (ch.outFrames == ch.out.size() / 2)
+				anyFull = true;
+		}
 
-		UI::FileSave(filename, part1_buff);
-		DBReport2(DbgChannel::AX, "DSBuffer dumped to: %s\n", filename);
+		if (!anyEnabled)
+		{
+			if (!sink->IsRealtime())
+				return false;
 
-		hr = DSBuffer->Unlock(part1, part1Size, part2, part2Size);
-		assert(hr == DS_OK);
+			std::fill(pcmBuffer.begin(), pcmBuffer.end(), 0);
+			sink->Write(pcmBuffer.data(), chunkFrames);
+			framesOut += chunkFrames;
+			return true;
+		}
 
-		hr = DSBuffer->Play(0, 0, bufferMode);
-		assert(hr == DS_OK);
-	}
+		// Wait for all channels, but don't let the fastest one overflow because of a starving one.
+		if (!allReady && !anyFull)
+			return false;
 
-	void AudioRing::DumpRing()
-	{
-		char filename[0x100] = { 0, };
-		sprintf_s(filename, sizeof(filename), "Data\\AXRing_%04i.bin", (int)frameCounter);
-
-		DBReport2(DbgChannel::AX, "frame: %i, readPtr: %i, writePtr: %i\n", frameCounter, ringReadPtr, ringWritePtr);
-		
-		auto ringBuff = std::vector<uint8_t>();
-		ringBuff.assign(ringBuffer, ringBuffer + ringSize);
-		
-		UI::FileSave(filename, ringBuff);
-		DBReport2(DbgChannel::AX, "Ring dumped to: %s\n", filename);
-	}
+		std::fill(mixBuffer.begin(), mixBuffer.end(), 0.0f);
 
-	AudioMixer::AudioMixer(HWConfig *config)
-	{
-		HRESULT hr = DirectSoundCreate8(NULL, &lpds, NULL);
-		assert(hr == DS_OK);
-		assert(lpds);
-
-		hr = lpds->SetCooperativeLevel(config->hwndMain, DSSCL_PRIORITY);
-		assert(hr == DS_OK);
-
-		// Create primary buffer
-		DSBUFFERDESC bufferDesc = { 0 };
-		WAVEFORMATEX waveFormat = { 0 };
-
-		// Setup the primary buffer description.
-		bufferDesc.dwSize = sizeof(DSBUFFERDESC);
-		bufferDesc.dwFlags = DSBCAPS_PRIMARYBUFFER | DSBCAPS_CTRLVOLUME;
-		bufferDesc.dwBufferBytes = 0;
-		bufferDesc.dwReserved = 0;
-		bufferDesc.lpwfxFormat = NULL;
-		bufferDesc.guid3DAlgorithm = GUID_NULL;
-
-		hr = lpds->CreateSoundBuffer(&bufferDesc, &PrimaryBuffer, NULL);
-		assert(hr == DS_OK);
-
-		// Setup the format of the primary sound bufffer.
-		waveFormat.wFormatTag = WAVE_FORMAT_PCM;
-		waveFormat.nSamplesPerSec = 44100;
-		waveFormat.wBitsPerSample = 16;
-		waveFormat.nChannels = 2;
-		waveFormat.nBlockAlign = (waveFormat.wBitsPerSample / 8) * waveFormat.nChannels;
-		waveFormat.nAvgBytesPerSec = waveFormat.nSamplesPerSec * waveFormat.nBlockAlign;
-		waveFormat.cbSize = 0;
-
-		hr = PrimaryBuffer->SetFormat(&waveFormat);
-		assert(hr == DS_OK);
-
-		// Create rings
-		Sources = new AudioRing * [numSources];
-		assert(Sources);
-
-		for (int i = 0; i < numSources; i++)
+		for (auto& ch : channels)
 		{
-			Sources[i] = new AudioRing(this);
-			assert(Sources[i]);
+			if (!ch.enabled)
+				continue;
 
-			// Set default sample rate
-			Sources[i]->SetSampleRate(AudioSampleRate::Rate_48000);
-			Sources[i]->Enable(false);
+			size_t n = (std::min)(ch.outFrames, chunkFrames);
+			for (size_t i = 0; i < 2 * n; i++)
+			{
+				mixBuffer[i] += ch.out[i];
+			}
+
+			if (n < chunkFrames)
+			{
+				ch.underruns++;
+				Debug::PerfAdd(Debug::PerfCounter::AudioUnderruns);
+			}
+
+			memmove(&ch.out[0], &ch.out[2 * n], (ch.outFrames - n) * 2 * sizeof(float));
+			ch.outFrames -= n;
 		}
-	}
 
-	AudioMixer::~AudioMixer()
-	{
-		// Release rings
-		for (int i = 0; i < numSources; i++)
+		// Convert to 16-bit with saturation
+		const __m128 scale = _mm_set1_ps(32767.0f);
+		for (size_t i = 0; i < 2 * chunkFrames; i += 8)
 		{
-			delete Sources[i];
+			__m128i lo = _mm_cvtps_epi32(_mm_mul_ps(_mm_loadu_ps(&mixBuffer[i]), scale));
+			__m128i hi = _mm_cvtps_epi32(_mm_mul_ps(_mm_loadu_ps(&mixBuffer[i + 4]), scale));
+			_mm_storeu_si128((__m128i*)&pcmBuffer[i], _mm_packs_epi32(lo, hi));
 		}
-		delete [] Sources;
 
-		PrimaryBuffer->Release();
-		lpds->Release();
+		sink->Write(pcmBuffer.data(), chunkFrames);
+		framesOut += chunkFrames;
+		return true;
 	}
 
 	void AudioMixer::Enable(AxChannel channel, bool enable)
 	{
-		Sources[(int)channel]->Enable(enable);
+		Channel& ch = channels[(int)channel];
+
+		if (enable && !ch.enabled)
+		{
+			ch.flush = true;
+		}
+		ch.enabled = enable;
 	}
 
 	bool AudioMixer::IsEnabled(AxChannel channel)
 	{
-		return Sources[(int)channel]->IsEnabled();
+		return channels[(int)channel].enabled;
 	}
 
 	void AudioMixer::SetSampleRate(AxChannel channel, AudioSampleRate value)
 	{
-		Sources[(int)channel]->SetSampleRate(value);
+		channels[(int)channel].sampleRate = (value == AudioSampleRate::Rate_32000) ? 32000 : 48000;
 	}
 
 	void AudioMixer::PushBytes(AxChannel channel, uint8_t* sampleData, size_t sampleDataSize)
 	{
-		Sources[(int)channel]->PushBytes(sampleData, sampleDataSize);
+		Channel& ch = channels[(int)channel];
+
+		if (!ch.enabled)
+			return;
+
+		int16_t temp[0x200];
+		size_t samples = sampleDataSize / 2;
+
+		while (samples != 0)
+		{
+			size_t n = (std::min)(samples, _countof(temp));
+
+			// Samples are big-endian
+			for (size_t i = 0; i < n; i++)
+			{
+				temp[i] = (int16_t)((sampleData[0] << 8) | sampleData[1]);
+				sampleData += 2;
+			}
+
+			size_t pushed = ch.ring.Push(temp, n);
+			if (pushed != n)
+			{
+				ch.overflows += n - pushed;
+				Debug::PerfAdd(Debug::PerfCounter::AudioOverflows, n - pushed);
+			}
+
+			samples -= n;
+		}
+	}
+
+	AudioMixerStats AudioMixer::GetStats()
+	{
+		AudioMixerStats stats = { 0 };
+
+		stats.framesOut = framesOut;
+		for (auto& ch : channels)
+		{
+			stats.underruns += ch.underruns;
+			stats.overflows += ch.overflows;
+		}
+
+		return stats;
 	}
 
+	#pragma endregion "AudioMixer"
 }
@@ -1,9 +1,15 @@
 // AX audio mixer.
-// To add sound to your OS, you need to implement this small interface.
+// The mixer core is platform-neutral. Each AxChannel is fed through a lock-free single-producer/single-consumer ring,
+// the mixer thread resamples all channels to the output rate, mixes them and writes the result to the AudioSink.
+// To add sound to your OS, you need to implement the small AudioSink interface.
 
 #pragma once
 
-#include <dsound.h>
+#include <atomic>
+#include <string>
+#include <vector>
+
+#include "../Common/Thread.h"
 
 namespace Flipper
 {
@@ -20,63 +26,186 @@ namespace Flipper
 		Max,
 	};
 
-	class AudioMixer;
+	enum class AudioSinkType
+	{
+		Default = 0,		// DirectSound on Windows, Null elsewhere
+		Null,
+		WavFile,
+	};
+
+	// Lock-free ring for one producer thread and one consumer thread.
+	// Read/write positions are free-running counters, the size must be a power of two.
 
-	class AudioRing
+	template <typename T, size_t Size>
+	class SpscRing
 	{
-		AudioMixer* mixer;
+		static_assert((Size & (Size - 1)) == 0, "SpscRing size must be a power of two");
+
+		std::vector<T> buffer;
+		std::atomic<size_t> writePos = 0;
+		std::atomic<size_t> readPos = 0;
+
+	public:
+		SpscRing() : buffer(Size) {}
+
+		size_t Available() { return writePos.load(std::memory_order_acquire) - readPos.load(std::memory_order_relaxed); }
+		size_t Free() { return Size - (writePos.load(std::memory_order_relaxed) - readPos.load(std::memory_order_acquire)); }
+
+		// Producer side. Returns the number of elements actually written.
+		size_t Push(const T* data, size_t count)
+		{
+			size_t wr = writePos.load(std::memory_order_relaxed);
+			count = (std::min)(count, Size - (wr - readPos.load(std::memory_order_acquire)));
+
+			size_t first = (std::min)(count, Size - (wr & (Size - 1)));
+			memcpy(&buffer[wr & (Size - 1)], data, first * sizeof(T));
+			memcpy(&buffer[0], data + first, (count - first) * sizeof(T));
+
+			writePos.store(wr + count, std::memory_order_release);
+			return count;
+		}
+
+		// Consumer side. Returns the number of elements actually read.
+		size_t Pop(T* data, size_t count)
+		{
+			size_t rd = readPos.load(std::memory_order_relaxed);
+			count = (std::min)(count, writePos.load(std::memory_order_acquire) - rd);
+
+			size_t first = (std::min)(count, Size - (rd & (Size - 1)));
+			memcpy(data, &buffer[rd & (Size - 1)], first * sizeof(T));
+			memcpy(data + first, &buffer[0], (count - first) * sizeof(T));
+
+			readPos.store(rd + count, std::memory_order_release);
+			return count;
+		}
+
+		// Consumer side. Drop everything queued.
+		void Flush()
+		{
+			readPos.store(writePos.load(std::memory_order_acquire), std::memory_order_release);
+		}
+	};
 
-		// Accumulate frameSize bytes in the circular buffer.
-		// When we have accumulated, lock the DirectSound buffer and emit frameSize bytes there.
+	// Stereo polyphase windowed-sinc resampler.
+	// Input: interleaved 16-bit LR frames, output: interleaved float LR frames (1.0 = full scale).
 
-		// The frameSize size is not very large and not very small.
-		// It should not be longer than 1 PAL / NTSC video frame, but not less than 1/3 video frame.
+	class AudioResampler
+	{
+		static const size_t taps = 16;
+		static const int phaseBits = 8;
+		static const size_t phases = 1 << phaseBits;
+		static const size_t inputSize = 0x1000;		// Input frames buffered by the resampler
+
+		std::vector<float> filter;		// [phases][taps]
+		std::vector<float> inLeft;		// Deinterleaved input
+		std::vector<float> inRight;
+		size_t inFrames = 0;
+		uint64_t pos = 0;				// Position of the next output frame in the input buffer (32.32)
+		uint64_t step = 1ULL << 32;		// Input frames per output frame (32.32)
+		bool bypass = true;				// Same input and output rate
 
-		static const size_t maxFrames = 16;
-		static const size_t frameSize = 0x1000;				// Audio frame size
-		static const size_t ringSize = maxFrames * frameSize;
-		uint8_t* ringBuffer = nullptr;
-		size_t ringWritePtr = 0;
-		size_t ringReadPtr = 0;
+	public:
+		AudioResampler();
 
-		size_t CurrentSize();
-		uint8_t FetchByte();
-		void EmitSound();
+		void SetRates(uint32_t inRate, uint32_t outRate);
+		void Reset();
 
-		LPDIRECTSOUNDBUFFER DSBuffer = nullptr;
+		size_t FreeInput() { return inputSize - inFrames; }
+		void Feed(const int16_t* frames, size_t count);
+		size_t Produce(float* out, size_t maxFrames);
+	};
 
-		bool enabled = false;
+	// Audio output device
 
-		size_t frameCounter = 0;
+	class AudioSink
+	{
+	public:
+		virtual ~AudioSink() {}
 
-		void DumpDSBuffer();
-		void DumpRing();
+		virtual uint32_t GetSampleRate() = 0;
 
-		void WaitBufferOverflow(void);
+		// Realtime sinks consume samples at their own pace and are fed with silence when nothing is playing.
+		virtual bool IsRealtime() = 0;
 
-		size_t framesPerEmit = maxFrames / 2;
+		// Number of stereo frames that can be written right now without blocking.
+		virtual size_t GetFreeFrames() = 0;
 
-		int bufferMode = DSBPLAY_LOOPING;
+		// Interleaved LR 16-bit frames.
+		virtual void Write(const int16_t* frames, size_t count) = 0;
+	};
+
+	// Discards everything. Used for headless runs.
+	class NullAudioSink : public AudioSink
+	{
+		uint32_t sampleRate;
 
 	public:
-		AudioRing(AudioMixer * parentInst);
-		~AudioRing();
+		NullAudioSink(uint32_t rate) : sampleRate(rate) {}
 
-		void Enable(bool enable);
-		bool IsEnabled() { return enabled; }
-		void SetSampleRate(AudioSampleRate value);
-		void PushBytes(uint8_t* sampleData, size_t sampleDataSize);
+		uint32_t GetSampleRate() override { return sampleRate; }
+		bool IsRealtime() override { return false; }
+		size_t GetFreeFrames() override { return SIZE_MAX; }
+		void Write(const int16_t* frames, size_t count) override {}
 	};
 
-	class AudioMixer
+	// Writes the mixer output to a 16-bit stereo WAV file.
+	class WavAudioSink : public AudioSink
 	{
-		friend AudioRing;
+		FILE* file = nullptr;
+		uint32_t sampleRate;
+		size_t dataSize = 0;
 
-		AudioRing** Sources = nullptr;
-		static const size_t numSources = 2;
+		void WriteHeader();
 
-		LPDIRECTSOUND8 lpds = nullptr;
-		LPDIRECTSOUNDBUFFER PrimaryBuffer = nullptr;
+	public:
+		WavAudioSink(const std::string& filename, uint32_t rate);
+		~WavAudioSink();
+
+		uint32_t GetSampleRate() override { return sampleRate; }
+		bool IsRealtime() override { return false; }
+		size_t GetFreeFrames() override { return SIZE_MAX; }
+		void Write(const int16_t* frames, size_t count) override;
+	};
+
+	struct AudioMixerStats
+	{
+		int64_t framesOut;				// Frames written to the sink
+		int64_t underruns;				// Channel had not enough samples and was padded with silence
+		int64_t overflows;				// Samples dropped by the producer because of a full ring
+	};
+
+	class AudioMixer
+	{
+		static const size_t ringFrames = 0x4000;
+		static const size_t chunkFrames = 0x200;		// Output frames mixed at once
+
+		struct Channel
+		{
+			SpscRing<int16_t, 2 * ringFrames> ring;		// Interleaved LR samples
+			AudioResampler resampler;
+			std::vector<float> out;			// Resampled frames waiting for mix
+			size_t outFrames = 0;
+			std::atomic<bool> enabled = false;
+			std::atomic<bool> flush = false;
+			std::atomic<uint32_t> sampleRate = 48000;
+			uint32_t resamplerRate = 0;
+			std::atomic<int64_t> overflows = 0;
+			int64_t underruns = 0;
+		};
+
+		Channel channels[(size_t)AxChannel::Max];
+
+		AudioSink* sink = nullptr;
+		uint32_t outputRate = 48000;
+
+		Thread* mixerThread = nullptr;
+		static void MixerThreadProc(void* Parameter);
+		bool Mix();
+		void FillChannel(Channel& ch);
+
+		std::vector<float> mixBuffer;
+		std::vector<int16_t> pcmBuffer;
+		int64_t framesOut = 0;
 
 	public:
 		AudioMixer(HWConfig* config);
@@ -87,6 +216,9 @@ namespace Flipper
 
 		void SetSampleRate(AxChannel channel, AudioSampleRate value);
 
+		// Feed big-endian 16-bit LR samples. Each channel must be fed from one thread only.
 		void PushBytes(AxChannel channel, uint8_t* sampleData, size_t sampleDataSize);
+
+		AudioMixerStats GetStats();
 	};
 }
@@ -0,0 +1,156 @@
+// DirectSound audio sink for AX mixer.
+#include "pch.h"
+
+namespace Flipper
+{
+	DirectSoundSink::DirectSoundSink(HWND hwnd, uint32_t rate)
+	{
+		HRESULT hr = DS_OK;
+		sampleRate = rate;
+
+		hr = DirectSoundCreate8(NULL, &lpds, NULL);
+		assert(hr == DS_OK);
+		assert(lpds);
+
+		hr = lpds->SetCooperativeLevel(hwnd, DSSCL_PRIORITY);
+		assert(hr == DS_OK);
+
+		WAVEFORMATEX waveFmt = { 0 };
+
+		waveFmt.wFormatTag = WAVE_FORMAT_PCM;
+		waveFmt.nChannels = 2;
+		waveFmt.wBitsPerSample = 16;
+		waveFmt.nSamplesPerSec = sampleRate;
+		waveFmt.nBlockAlign = (waveFmt.wBitsPerSample / 8) * waveFmt.nChannels;
+		waveFmt.nAvgBytesPerSec = waveFmt.nSamplesPerSec * waveFmt.nBlockAlign;
+		waveFmt.cbSize = 0;
+
+		// Create primary buffer
+
+		DSBUFFERDESC bufferDesc = { 0 };
+
+		bufferDesc.dwSize = sizeof(DSBUFFERDESC);
+		bufferDesc.dwFlags = DSBCAPS_PRIMARYBUFFER | DSBCAPS_CTRLVOLUME;
+		bufferDesc.dwBufferBytes = 0;
+		bufferDesc.lpwfxFormat = NULL;
+		bufferDesc.guid3DAlgorithm = GUID_NULL;
+
+		hr = lpds->CreateSoundBuffer(&bufferDesc, &PrimaryBuffer, NULL);
+		assert(hr == DS_OK);
+
+		hr = PrimaryBuffer->SetFormat(&waveFmt);
+		assert(hr == DS_OK);
+
+		// Create secondary (looping) buffer. Resampling is done by the mixer, the buffer plays at the output rate.
+
+		DSBUFFERDESC desc = { 0 };
+
+		desc.dwSize = sizeof(DSBUFFERDESC);
+		desc.dwFlags = DSBCAPS_GETCURRENTPOSITION2 | DSBCAPS_GLOBALFOCUS | DSBCAPS_CTRLVOLUME;
+		desc.dwBufferBytes = (DWORD)bufferSize;
+		desc.lpwfxFormat = &waveFmt;
+		desc.guid3DAlgorithm = GUID_NULL;
+
+		hr = lpds->CreateSoundBuffer(&desc, &DSBuffer, NULL);
+		assert(hr == DS_OK);
+
+		hr = DSBuffer->SetVolume(DSBVOLUME_MAX);
+		assert(hr == DS_OK);
+
+		// Start with silence
+
+		PVOID part1 = nullptr;
+		DWORD part1Size = 0;
+		PVOID part2 = nullptr;
+		DWORD part2Size = 0;
+
+		hr = DSBuffer->Lock(0, 0, &part1, &part1Size, &part2, &part2Size, DSBLOCK_ENTIREBUFFER);
+		assert(hr == DS_OK);
+		memset(part1, 0, part1Size);
+		hr = DSBuffer->Unlock(part1, part1Size, part2, part2Size);
+		assert(hr == DS_OK);
+
+		hr = DSBuffer->Play(0, 0, DSBPLAY_LOOPING);
+		assert(hr == DS_OK);
+	}
+
+	DirectSoundSink::~DirectSoundSink()
+	{
+		if (DSBuffer)
+		{
+			DSBuffer->Stop();
+			DSBuffer->Release();
+		}
+		if (PrimaryBuffer)
+		{
+			PrimaryBuffer->Release();
+		}
+		if (lpds)
+		{
+			lpds->Release();
+		}
+	}
+
+	size_t DirectSoundSink::GetFreeFrames()
+	{
+		DWORD playCursor = 0;
+		DWORD writeCursor = 0;
+
+		HRESULT hr = DSBuffer->GetCurrentPosition(&playCursor, &writeCursor);
+		assert(hr == DS_OK);
+
+		size_t played = (playCursor + bufferSize - lastPlayCursor) % bufferSize;
+		lastPlayCursor = playCursor;
+
+		if (played >= pending)
+		{
+			// Starved (or just started): continue from the position where it is safe to write.
+			writeOffset = writeCursor;
+			pending = (writeCursor + bufferSize - playCursor) % bufferSize;
+		}
+		else
+		{
+			pending -= played;
+		}
+
+		size_t freeFrames = (bufferSize - pending) / 4;
+		return freeFrames > guardFrames ? freeFrames - guardFrames : 0;
+	}
+
+	void DirectSoundSink::Write(const int16_t* frames, size_t count)
+	{
+		PVOID part[2] = { nullptr, nullptr };
+		DWORD partSize[2] = { 0, 0 };
+
+		size_t dataSize = count * 4;
+
+		HRESULT hr = DSBuffer->Lock((DWORD)writeOffset, (DWORD)(dataSize + guardFrames * 4),
+			&part[0], &partSize[0], &part[1], &partSize[1], 0);
+		if (hr != DS_OK)
+		{
+			return;
+		}
+
+		// Data followed by silence
+		const uint8_t* src = (const uint8_t*)frames;
+		size_t dataLeft = dataSize;
+
+		for (int i = 0; i < 2; i++)
+		{
+			if (!part[i])
+				break;
+
+			size_t n = (std::min)((size_t)partSize[i], dataLeft);
+			memcpy(part[i], src, n);
+			memset((uint8_t*)part[i] + n, 0, partSize[i] - n);
+			src += n;
+			dataLeft -= n;
+		}
+
+		hr = DSBuffer->Unlock(part[0], partSize[0], part[1], partSize[1]);
+		assert(hr == DS_OK);
+
+		writeOffset = (writeOffset + dataSize) % bufferSize;
+		pending += dataSize;
+	}
+}
@@ -0,0 +1,37 @@
+// DirectSound audio sink for AX mixer.
+
+#pragma once
+
+#include <dsound.h>
+
+namespace Flipper
+{
+	class DirectSoundSink : public AudioSink
+	{
+		LPDIRECTSOUND8 lpds = nullptr;
+		LPDIRECTSOUNDBUFFER PrimaryBuffer = nullptr;
+		LPDIRECTSOUNDBUFFER DSBuffer = nullptr;
+
+		uint32_t sampleRate;
+
+		// Looping secondary buffer. The region right after the written data is kept silent,
+		// so that a starving mixer produces a pause instead of replaying stale samples.
+
+		static const size_t bufferFrames = 0x2000;
+		static const size_t guardFrames = 0x400;
+		static const size_t bufferSize = bufferFrames * 4;
+
+		size_t writeOffset = 0;			// Where the next Write goes (bytes)
+		size_t pending = 0;				// Written but not yet played (bytes)
+		size_t lastPlayCursor = 0;
+
+	public:
+		DirectSoundSink(HWND hwnd, uint32_t rate);
+		~DirectSoundSink();
+
+		uint32_t GetSampleRate() override { return sampleRate; }
+		bool IsRealtime() override { return true; }
+		size_t GetFreeFrames() override;
+		void Write(const int16_t* frames, size_t count) override;
+	};
+}
@@ -148,13 +148,15 @@ struct FifoControl
     PERegs      pe;     // pixel engine registers
     size_t      done_num;   // number of drawdone (PE_FINISH) events
     bool        log;
+    bool        headless;   // the commands are consumed without drawing (see Instance::headless)
     Thread*     thread;     // CP FIFO thread
     size_t      tickPerFifo;
     int64_t     updateTbrValue;
 };
 
-extern  FifoControl fifo;
+extern  InstanceRef<FifoControl, &Instance::fifo> fifo;
 
 void    CPOpen(HWConfig* config);
 void    CPClose();
 void    DumpCPFIFO();
+void    CPDoState(StateStream& state);
@@ -2,7 +2,7 @@
 #include "pch.h"
 
 // DI state (registers and other data)
-DIControl di;
+InstanceRef<DIControl, &Instance::di> di;
 
 static uint8_t DIHostToDduCallbackCommand();
 static uint8_t DIHostToDduCallbackData();
@@ -46,6 +46,8 @@ static void DIErrorCallback()
 
     DVD::DDU->SetTransferCallbacks(DIHostToDduCallbackCommand, DIDduToHostCallback);
 
+    di->dataPhase = false;
+
     EndProfileDVD();
 }
 
@@ -66,6 +68,8 @@ static void DIBreak()
 
     DVD::DDU->SetTransferCallbacks(DIHostToDduCallbackCommand, DIDduToHostCallback);
 
+    di->dataPhase = false;
+
     EndProfileDVD();
 }
 
@@ -82,6 +86,8 @@ static void DITransferComplete()
 
     DVD::DDU->SetTransferCallbacks(DIHostToDduCallbackCommand, DIDduToHostCallback);
 
+    di->dataPhase = false;
+
     EndProfileDVD();
 }
 
@@ -91,27 +97,29 @@ static uint8_t DIHostToDduCallbackCommand()
 
     // DI Imm Write Command (DILEN ignored)
 
-    if (di.hostToDduByteCounter < sizeof(di.cmdbuf))
+    if (di->hostToDduByteCounter < sizeof(di->cmdbuf))
     {
-        data = di.cmdbuf[di.hostToDduByteCounter++];
+        data = di->cmdbuf[di->hostToDduByteCounter++];
     }
 
-    if (di.hostToDduByteCounter >= sizeof(di.cmdbuf))
+    if (di->hostToDduByteCounter >= sizeof(di->cmdbuf))
     {
         // Dont stop DDU Bus clock
 
         // Issue transfer data
 
         DVD::DDU->SetTransferCallbacks(DIHostToDduCallbackData, DIDduToHostCallback);
+
+        di->dataPhase = true;
         DVD::DDU->StartTransfer(DICR & DI_CR_RW ? DVD::DduBusDirection::HostToDdu : DVD::DduBusDirection::DduToHost);
 
         if (DICR & DI_CR_RW)
         {
-            di.hostToDduByteCounter = 32;       // A special value that overloads the FIFO before reading the first byte from the DDU side.
+            di->hostToDduByteCounter = 32;       // A special value that overloads the FIFO before reading the first byte from the DDU side.
         }
         else
         {
-            di.dduToHostByteCounter = 0;
+            di->dduToHostByteCounter = 0;
         }
     }
 
@@ -126,14 +134,14 @@ static uint8_t DIHostToDduCallbackData()
     {
         // DI Dma Write
 
-        if (di.hostToDduByteCounter >= 32)
+        if (di->hostToDduByteCounter >= 32)
         {
-            di.hostToDduByteCounter = 0;
+            di->hostToDduByteCounter = 0;
 
             if (DILEN)
             {
                 uint32_t dimar = DIMAR & DI_DIMAR_MASK;
-                MIReadBurst(dimar, di.dmaFifo);
+                MIReadBurst(dimar, di->dmaFifo);
                 DIMAR += 32;
                 DILEN -= 32;
             }
@@ -153,17 +161,17 @@ static uint8_t DIHostToDduCallbackData()
             }
         }
 
-        data = di.dmaFifo[di.hostToDduByteCounter];
-        di.hostToDduByteCounter++;
+        data = di->dmaFifo[di->hostToDduByteCounter];
+        di->hostToDduByteCounter++;
     }
     else
     {
-        if (di.hostToDduByteCounter < sizeof(di.immbuf))
+        if (di->hostToDduByteCounter < sizeof(di->immbuf))
         {
-            data = di.immbuf[di.hostToDduByteCounter++];
+            data = di->immbuf[di->hostToDduByteCounter++];
         }
 
-        if (di.hostToDduByteCounter >= sizeof(di.immbuf))
+        if (di->hostToDduByteCounter >= sizeof(di->immbuf))
         {
             DVD::DDU->TransferComplete();        // Stop DDU Bus clock
             DITransferComplete();
@@ -179,11 +187,11 @@ static void DIDduToHostCallback(uint8_t data)
     {
         // DI Dma Read
 
-        di.dmaFifo[di.dduToHostByteCounter] = data;
-        di.dduToHostByteCounter++;
-        if (di.dduToHostByteCounter >= 32)
+        di->dmaFifo[di->dduToHostByteCounter] = data;
+        di->dduToHostByteCounter++;
+        if (di->dduToHostByteCounter >= 32)
         {
-            di.dduToHostByteCounter = 0;
+            di->dduToHostByteCounter = 0;
 
             if (DISR & DI_SR_BRK)
             {
@@ -195,7 +203,7 @@ static void DIDduToHostCallback(uint8_t data)
             if (DILEN)
             {
                 uint32_t dimar = DIMAR & DI_DIMAR_MASK;
-                MIWriteBurst(dimar, di.dmaFifo);
+                MIWriteBurst(dimar, di->dmaFifo);
                 DIMAR += 32;
                 DILEN -= 32;
             }
@@ -211,15 +219,15 @@ static void DIDduToHostCallback(uint8_t data)
     {
         // DI Imm Read (DILEN ignored)
 
-        if (di.dduToHostByteCounter < sizeof(di.immbuf))
+        if (di->dduToHostByteCounter < sizeof(di->immbuf))
         {
-            di.immbuf[di.dduToHostByteCounter] = data;
-            di.dduToHostByteCounter++;
+            di->immbuf[di->dduToHostByteCounter] = data;
+            di->dduToHostByteCounter++;
         }
 
-        if (di.dduToHostByteCounter >= sizeof(di.immbuf))
+        if (di->dduToHostByteCounter >= sizeof(di->immbuf))
         {
-            di.dduToHostByteCounter = 0;
+            di->dduToHostByteCounter = 0;
             DVD::DDU->TransferComplete();    // Stop DDU Bus clock
             DITransferComplete();
         }
@@ -279,8 +287,9 @@ static void write_cr(uint32_t addr, uint32_t data)
     {
         // Issue command
 
-        di.hostToDduByteCounter = 0;
+        di->hostToDduByteCounter = 0;
         DVD::DDU->SetTransferCallbacks(DIHostToDduCallbackCommand, DIDduToHostCallback);
+        di->dataPhase = false;
         DVD::DDU->StartTransfer(DVD::DduBusDirection::HostToDdu);
 
         BeginProfileDVD();
@@ -327,13 +336,13 @@ static void write_len(uint32_t addr, uint32_t data) { DILEN = data; }
 
 static void DISetCommandBuffer(int n, uint32_t value)
 {
-    volatile uint8_t* ptr = &di.cmdbuf[n * 4];
+    volatile uint8_t* ptr = &di->cmdbuf[n * 4];
     *(uint32_t*)ptr = _byteswap_ulong(value);
 }
 
 static uint32_t DIGetCommandBuffer(int n)
 {
-    volatile uint8_t* ptr = &di.cmdbuf[n * 4];
+    volatile uint8_t* ptr = &di->cmdbuf[n * 4];
     return _byteswap_ulong(*(uint32_t*)ptr);
 }
 
@@ -344,8 +353,8 @@ static void read_cmdbuf1(uint32_t addr, uint32_t *reg)  { *reg = DIGetCommandBuf
 static void write_cmdbuf1(uint32_t addr, uint32_t data) { DISetCommandBuffer(1, data); }
 static void read_cmdbuf2(uint32_t addr, uint32_t *reg)  { *reg = DIGetCommandBuffer(2); }
 static void write_cmdbuf2(uint32_t addr, uint32_t data) { DISetCommandBuffer(2, data); }
-static void read_immbuf(uint32_t addr, uint32_t *reg)   { *reg = _byteswap_ulong(*(uint32_t *)di.immbuf); }
-static void write_immbuf(uint32_t addr, uint32_t data)  { *(uint32_t*)di.immbuf = _byteswap_ulong(data); }
+static void read_immbuf(uint32_t addr, uint32_t *reg)   { *reg = _byteswap_ulong(*(uint32_t *)di->immbuf); }
+static void write_immbuf(uint32_t addr, uint32_t data)  { *(uint32_t*)di->immbuf = _byteswap_ulong(data); }
 
 // register is read only.
 // currently, bit 0 is used for ROM scramble disable (which ROM?), bits 1-7 are reserved
@@ -362,15 +371,16 @@ void DIOpen()
     // Current DVD is set by Loader, or when disk is swapped by UI.
 
     // clear registers
-    memset(&di, 0, sizeof(DIControl));
+    memset(di.Get(), 0, sizeof(DIControl));
 
-    di.log = true;
+    di->log = true;
 
     // Register DDU callbacks
     DVD::DDU->SetCoverOpenCallback(DIOpenCover);
     DVD::DDU->SetCoverCloseCallback(DICloseCover);
     DVD::DDU->SetErrorCallback(DIErrorCallback);
     DVD::DDU->SetTransferCallbacks(DIHostToDduCallbackCommand, DIDduToHostCallback);
+    di->dataPhase = false;
 
     // set 32-bit register traps
     MISetTrap(32, DI_SR     , read_sr      , write_sr);
@@ -394,8 +404,31 @@ void DIClose()
     DVD::DDU->SetErrorCallback(nullptr);
     DVD::DDU->SetTransferCallbacks(nullptr, nullptr);
 
-    di.dduToHostByteCounter = 0;
-    di.hostToDduByteCounter = 32;
+    di->dduToHostByteCounter = 0;
+    di->hostToDduByteCounter = 32;
 
     EndProfileDVD();
 }
+
+void DIDoState(StateStream& state)
+{
+    state.BeginSection('DI  ', 1);
+    state.Do(di->sr);
+    state.Do(di->cvr);
+    state.Do(di->cr);
+    state.Do(di->mar);
+    state.Do(di->len);
+    state.Do(di->cmdbuf);
+    state.Do(di->immbuf);
+    state.Do(di->cfg);
+    state.Do(di->dmaFifo);
+    state.Do(di->dduToHostByteCounter);
+    state.Do(di->hostToDduByteCounter);
+    state.Do(di->dataPhase);
+    state.EndSection();
+
+    if (state.IsLoading())
+    {
+        DVD::DDU->SetTransferCallbacks(di->dataPhase ? DIHostToDduCallbackData : DIHostToDduCallbackCommand, DIDduToHostCallback);
+    }
+}
@@ -12,11 +12,11 @@
 #define DI_IMMBUF        0x0C006020     // Immediate Data Buffer
 #define DI_CFG           0x0C006024     // Configuration Register
 
-#define DISR             di.sr
-#define DICVR            di.cvr
-#define DIMAR            di.mar
-#define DILEN            di.len
-#define DICR             di.cr
+#define DISR             di->sr
+#define DICVR            di->cvr
+#define DIMAR            di->mar
+#define DILEN            di->len
+#define DICR             di->cr
 
 // DI Status Register mask
 #define DI_SR_BRKINT     (1 << 6)
@@ -54,11 +54,13 @@ struct DIControl
 
     int             dduToHostByteCounter;
     int             hostToDduByteCounter;
+    bool            dataPhase;      // DDU transfers the data (command was sent)
 
     bool            log;
 };
 
-extern  DIControl di;
+extern  InstanceRef<DIControl, &Instance::di> di;
 
 void    DIOpen();
 void    DIClose();
+void    DIDoState(StateStream& state);
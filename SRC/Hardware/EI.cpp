@@ -59,7 +59,7 @@
 --------------------------------------------------------------------------- */
 
 // SI state (registers and other data)
-EIControl exi;
+InstanceRef<EIControl, &Instance::exi> exi;
 
 // bootrom copyright message (at offset 0). PAL only, NTSC has garbage.
 // can be used by apps to detect PAL/NTSC cube.
@@ -92,9 +92,9 @@ void EXIUpdateInterrupts()
 {
     if( // match interrupt with its mask
         (
-         (exi.regs[0].csr & (exi.regs[0].csr << 1) & EXI_CSR_INTERRUPTS) ||
-         (exi.regs[1].csr & (exi.regs[1].csr << 1) & EXI_CSR_INTERRUPTS) ||
-         (exi.regs[2].csr & (exi.regs[2].csr << 1) & EXI_CSR_INTERRUPTS)
+         (exi->regs[0].csr & (exi->regs[0].csr << 1) & EXI_CSR_INTERRUPTS) ||
+         (exi->regs[1].csr & (exi->regs[1].csr << 1) & EXI_CSR_INTERRUPTS) ||
+         (exi->regs[2].csr & (exi->regs[2].csr << 1) & EXI_CSR_INTERRUPTS)
         )
     )
     {
@@ -114,25 +114,25 @@ void EXIUpdateInterrupts()
 
 void EXIAttach(int chan)
 {
-    if(exi.log) DBReport2(DbgChannel::EXI, "attaching device at channel %i\n", chan);
+    if(exi->log) DBReport2(DbgChannel::EXI, "attaching device at channel %i\n", chan);
 
     // set attach flag
-    exi.regs[chan].csr |= EXI_CSR_EXT;
+    exi->regs[chan].csr |= EXI_CSR_EXT;
 
     // assert attach interrupt
-    exi.regs[chan].csr |= EXI_CSR_EXTINT;
+    exi->regs[chan].csr |= EXI_CSR_EXTINT;
     EXIUpdateInterrupts();
 }
 
 void EXIDetach(int chan)
 {
-    if(exi.log) DBReport2(DbgChannel::EXI, "detaching device at channel %i\n", chan);
+    if(exi->log) DBReport2(DbgChannel::EXI, "detaching device at channel %i\n", chan);
 
     // clear attach flag
-    exi.regs[chan].csr &= ~EXI_CSR_EXT;
+    exi->regs[chan].csr &= ~EXI_CSR_EXT;
 
     // assert detach interrupt
-    exi.regs[chan].csr |= EXI_CSR_EXTINT;
+    exi->regs[chan].csr |= EXI_CSR_EXTINT;
     EXIUpdateInterrupts();
 }
 
@@ -176,7 +176,7 @@ static void SRAMSave(SRAM *s)
 // use to get updated RTC
 void RTCUpdate()
 {
-    exi.rtcVal = 0;// (uint32_t)time(NULL) - MAGIC_VALUE;
+    exi->rtcVal = 0;// (uint32_t)time(NULL) - MAGIC_VALUE;
 }
 
 //
@@ -246,9 +246,9 @@ static char * uartf(char *buf)
 void UnknownTransfer()
 {
     // dont do nothing on the exi transfer
-    if(exi.log)
+    if(exi->log)
     {
-        DBReport2(DbgChannel::EXI, "unknown transfer (channel:%i, device:%i)\n", exi.chan, exi.sel);
+        DBReport2(DbgChannel::EXI, "unknown transfer (channel:%i, device:%i)\n", exi->chan, exi->sel);
     }
 }
 
@@ -256,106 +256,107 @@ void UnknownTransfer()
 void MXTransfer()
 {
     uint32_t ofs;
-    BOOL dma = (exi.regs[0].cr & EXI_CR_DMA) ? (1) : (0);
+    BOOL dma = (exi->regs[0].cr & EXI_CR_DMA) ? (1) : (0);
 
     // read or write ?
-    switch(EXI_CR_RW(exi.regs[0].cr))
+    switch(EXI_CR_RW(exi->regs[0].cr))
     {
         case 0:                 // read
         {
             if(dma)             // dma
             {
-                ofs = exi.mxaddr & 0x7fffffff;
+                ofs = exi->mxaddr & 0x7fffffff;
+                mi->dirty.Mark(exi->regs[0].madr & RAMMASK, exi->regs[0].len);
                 if(ofs == 0x20000100)
                 {
-                    if(exi.regs[0].len > sizeof(SRAM))
+                    if(exi->regs[0].len > sizeof(SRAM))
                     {
                         DBReport2(DbgChannel::EXI, "wrong input buffer size for SRAM read dma\n");
                         return;
                     }
-                    memcpy(&mi.ram[exi.regs[0].madr & RAMMASK], &exi.sram, sizeof(SRAM));
+                    memcpy(&mi->ram[exi->regs[0].madr & RAMMASK], &exi->sram, sizeof(SRAM));
                     return;
                 }
                 if((ofs >= 0x001fcf00) && (ofs < (0x001fcf00 + ANSI_SIZE)))
                 {
-                    if (mi.BootromPresent)
+                    if (mi->BootromPresent)
                     {
                         memcpy(
-                            &mi.ram[exi.regs[0].madr & RAMMASK],
-                            &mi.bootrom[ofs],
-                            exi.regs[0].len
+                            &mi->ram[exi->regs[0].madr & RAMMASK],
+                            &mi->bootrom[ofs],
+                            exi->regs[0].len
                         );
                     }
                     else
                     {
-                        assert(exi.ansiFont);
+                        assert(exi->ansiFont);
                         memcpy(
-                            &mi.ram[exi.regs[0].madr & RAMMASK],
-                            &exi.ansiFont[ofs - 0x001fcf00],
-                            exi.regs[0].len
+                            &mi->ram[exi->regs[0].madr & RAMMASK],
+                            &exi->ansiFont[ofs - 0x001fcf00],
+                            exi->regs[0].len
                         );
                     }
-                    if(exi.log) DBReport2(DbgChannel::EXI, "ansi font copy to %08X (%i)\n",
-                                          exi.regs[0].madr | 0x80000000, exi.regs[0].len );
+                    if(exi->log) DBReport2(DbgChannel::EXI, "ansi font copy to %08X (%i)\n",
+                                          exi->regs[0].madr | 0x80000000, exi->regs[0].len );
                     return;
                 }
                 if((ofs >= 0x001aff00) && (ofs < (0x001aff00 + SJIS_SIZE)))
                 {
-                    if (mi.BootromPresent)
+                    if (mi->BootromPresent)
                     {
                         memcpy(
-                            &mi.ram[exi.regs[0].madr & RAMMASK],
-                            &mi.bootrom[ofs],
-                            exi.regs[0].len
+                            &mi->ram[exi->regs[0].madr & RAMMASK],
+                            &mi->bootrom[ofs],
+                            exi->regs[0].len
                         );
                     }
                     else
                     {
-                        assert(exi.sjisFont);
+                        assert(exi->sjisFont);
                         memcpy(
-                            &mi.ram[exi.regs[0].madr & RAMMASK],
-                            &exi.sjisFont[ofs - 0x001aff00],
-                            exi.regs[0].len
+                            &mi->ram[exi->regs[0].madr & RAMMASK],
+                            &exi->sjisFont[ofs - 0x001aff00],
+                            exi->regs[0].len
                         );
                     }
-                    if(exi.log) DBReport2(DbgChannel::EXI, "sjis font copy to %08X (%i)\n",
-                                          exi.regs[0].madr | 0x80000000, exi.regs[0].len );
+                    if(exi->log) DBReport2(DbgChannel::EXI, "sjis font copy to %08X (%i)\n",
+                                          exi->regs[0].madr | 0x80000000, exi->regs[0].len );
                     return;
                 }
 
                 // Bootrom reads
 
-                if (ofs < mi.bootromSize && mi.BootromPresent)
+                if (ofs < mi->bootromSize && mi->BootromPresent)
                 {
                     memcpy(
-                        &mi.ram[exi.regs[0].madr & RAMMASK],
-                        &mi.bootrom[ofs],
-                        exi.regs[0].len
+                        &mi->ram[exi->regs[0].madr & RAMMASK],
+                        &mi->bootrom[ofs],
+                        exi->regs[0].len
                     );
-                    if(exi.log) DBReport2(DbgChannel::EXI, "bootrom copy to %08X (%i)\n",
-                                          exi.regs[0].madr | 0x80000000, exi.regs[0].len );
+                    if(exi->log) DBReport2(DbgChannel::EXI, "bootrom copy to %08X (%i)\n",
+                                          exi->regs[0].madr | 0x80000000, exi->regs[0].len );
                     return;
                 }
 
                 if(ofs)
                 {
-                    if(exi.log) DBReport2(DbgChannel::EXI, "unknown MX chip dma read\n");
+                    if(exi->log) DBReport2(DbgChannel::EXI, "unknown MX chip dma read\n");
                 }
             }
             else                // immediate access
             {
-                ofs = exi.mxaddr & 0x7fffffff;
+                ofs = exi->mxaddr & 0x7fffffff;
                 if(ofs == 0x20000000)
                 {
                     RTCUpdate();
-                    exi.regs[0].data = exi.rtcVal;
+                    exi->regs[0].data = exi->rtcVal;
                     return;
                 }
                 else if((ofs >= 0x20000100) && (ofs < (0x20000100 + (sizeof(SRAM) << 6))))
                 {
-                    int len = EXI_CR_TLEN(exi.regs[0].cr);
-                    uint8_t * sofs = (uint8_t *)&exi.sram + ((ofs >> 6) & 0xff) - 4;
-                    uint8_t * rofs = (uint8_t *)&exi.regs[0].data;
+                    int len = EXI_CR_TLEN(exi->regs[0].cr);
+                    uint8_t * sofs = (uint8_t *)&exi->sram + ((ofs >> 6) & 0xff) - 4;
+                    uint8_t * rofs = (uint8_t *)&exi->regs[0].data;
                     switch(len)
                     {
                         case 0:         // byte
@@ -363,36 +364,36 @@ void MXTransfer()
                             rofs[2] = 
                             rofs[3] = 0;
                             rofs[3] = sofs[0];
-                            exi.mxaddr += 1 << 6;
+                            exi->mxaddr += 1 << 6;
                             break;
                         case 1:         // hword
                             rofs[0] =
                             rofs[1] = 0;
                             rofs[2] = sofs[1];
                             rofs[3] = sofs[0];
-                            exi.mxaddr += 2 << 6;
+                            exi->mxaddr += 2 << 6;
                             break;
                         case 2:         // triplet
                             rofs[0] = 0;
                             rofs[1] = sofs[2];
                             rofs[2] = sofs[1];
                             rofs[3] = sofs[0];
-                            exi.mxaddr += 3 << 6;
+                            exi->mxaddr += 3 << 6;
                             break;
                         case 3:         // word
                             rofs[0] = sofs[3];
                             rofs[1] = sofs[2];
                             rofs[2] = sofs[1];
                             rofs[3] = sofs[0];
-                            exi.mxaddr += 4 << 6;
+                            exi->mxaddr += 4 << 6;
                             break;
                     }
-                    if(exi.log) DBReport2(DbgChannel::EXI, "immediate read SRAM (ofs:%i, len:%i)\n", ((ofs >> 6) & 0xff) - 4, len+1);
+                    if(exi->log) DBReport2(DbgChannel::EXI, "immediate read SRAM (ofs:%i, len:%i)\n", ((ofs >> 6) & 0xff) - 4, len+1);
                     return;
                 }
                 else if(ofs == 0x20010000)
                 {
-                    exi.regs[0].data = 0x03000000;
+                    exi->regs[0].data = 0x03000000;
                     return;
                 }
                 else UI::DolwinQuestion(_T("EXI Module"), _T("Unknown MX chip read immediate from %08X"), ofs);
@@ -409,28 +410,28 @@ void MXTransfer()
             }
             else                // immediate access
             {
-                if(exi.firstImm)
+                if(exi->firstImm)
                 {
-                    exi.firstImm = FALSE;
-                    exi.mxaddr = exi.regs[0].data;
-                    if(exi.mxaddr < 0x20000000) exi.mxaddr >>= 6;
+                    exi->firstImm = FALSE;
+                    exi->mxaddr = exi->regs[0].data;
+                    if(exi->mxaddr < 0x20000000) exi->mxaddr >>= 6;
                 }
                 else
                 {
-                    uint32_t bytes = (EXI_CR_TLEN(exi.regs[0].cr) + 1);
-                    uint32_t data = _byteswap_ulong(exi.regs[0].data);
+                    uint32_t bytes = (EXI_CR_TLEN(exi->regs[0].cr) + 1);
+                    uint32_t data = _byteswap_ulong(exi->regs[0].data);
 
-                    ofs = exi.mxaddr & 0x7fffffff;
+                    ofs = exi->mxaddr & 0x7fffffff;
                     if((ofs >= 0x20000100) && (ofs <= 0x20001000))
                     {
                         // SRAM immediate writes
                         uint32_t pos = (((ofs - 256) >> 6) & 0x3F);
 
-                        if(exi.log) DBReport2(DbgChannel::EXI, "SRAM write immediate pos %d data %08x bytes %08x\n",
-                                              pos, exi.regs[0].data, bytes );
+                        if(exi->log) DBReport2(DbgChannel::EXI, "SRAM write immediate pos %d data %08x bytes %08x\n",
+                                              pos, exi->regs[0].data, bytes );
 
-                        memcpy(((uint8_t *)&exi.sram) + pos, &data, bytes);
-                        exi.mxaddr += (bytes << 6);
+                        memcpy(((uint8_t *)&exi->sram) + pos, &data, bytes);
+                        exi->mxaddr += (bytes << 6);
                     }
                     else if((ofs >= 0x20010000) && (ofs < 0x20010100))
                     {
@@ -438,14 +439,14 @@ void MXTransfer()
                         uint8_t *buf = (uint8_t *)&data;
                         for(uint32_t n=0; n<bytes; n++)
                         {
-                            exi.uart[exi.upos++] = buf[n];
+                            exi->uart[exi->upos++] = buf[n];
 
                             // output UART buffer after de-select
                             if(buf[n] == 13)
                             {
-                                exi.uart[exi.upos] = 0;
-                                exi.upos = 0;
-                                if(exi.osReport) DBReport2(DbgChannel::Info, "%s", uartf(exi.uart));
+                                exi->uart[exi->upos] = 0;
+                                exi->upos = 0;
+                                if(exi->osReport) DBReport2(DbgChannel::Info, "%s", uartf(exi->uart));
                             }
                         }
                     }
@@ -457,7 +458,7 @@ void MXTransfer()
 
         default:
         {
-            if(EXI_CR_RW(exi.regs[0].cr))
+            if(EXI_CR_RW(exi->regs[0].cr))
             {
                 DBReport2(DbgChannel::EXI, "unknown EXI transfer mode for MX chip\n");
             }
@@ -469,39 +470,39 @@ void MXTransfer()
 void ADTransfer()
 {
     // read or write ?
-    switch(EXI_CR_RW(exi.regs[2].cr))
+    switch(EXI_CR_RW(exi->regs[2].cr))
     {
         case 0:                 // read
         {
-            if(exi.ad16_cmd == 0) exi.regs[2].data = 0x04120000;
-            else if(exi.ad16_cmd == 0xa2000000) exi.regs[2].data = exi.ad16 << 16;
+            if(exi->ad16_cmd == 0) exi->regs[2].data = 0x04120000;
+            else if(exi->ad16_cmd == 0xa2000000) exi->regs[2].data = exi->ad16 << 16;
             else DBReport2(DbgChannel::EXI, "unknown AD16 command\n");
             return;
         }
 
         case 1:                 // write
         {
-            if(exi.firstImm)
+            if(exi->firstImm)
             {
-                exi.firstImm = FALSE;
-                exi.ad16_cmd = exi.regs[2].data;
+                exi->firstImm = FALSE;
+                exi->ad16_cmd = exi->regs[2].data;
             }
             else
             {
-                if(exi.ad16_cmd != 0xa0000000)
+                if(exi->ad16_cmd != 0xa0000000)
                 {
-                    DBReport2(DbgChannel::EXI, "unknown AD command (%08X)\n", exi.ad16_cmd);
+                    DBReport2(DbgChannel::EXI, "unknown AD command (%08X)\n", exi->ad16_cmd);
                     return;
                 }
-                exi.ad16 = exi.regs[2].data >> 16;
-                if(exi.log) DBReport2(DbgChannel::EXI, "AD16 set to %04X\n", exi.ad16);
+                exi->ad16 = exi->regs[2].data >> 16;
+                if(exi->log) DBReport2(DbgChannel::EXI, "AD16 set to %04X\n", exi->ad16);
             }
             return;
         }
 
         default:
         {
-            if(EXI_CR_RW(exi.regs[2].cr))
+            if(EXI_CR_RW(exi->regs[2].cr))
             {
                 DBReport2(DbgChannel::EXI, "unknown EXI transfer mode for AD16\n");
             }
@@ -519,42 +520,42 @@ void ADTransfer()
 static void exi_select(int chan)
 {
     // set flag
-    exi.firstImm = TRUE;
+    exi->firstImm = TRUE;
 
-    if(exi.regs[chan].csr & EXI_CSR_CS0B)
+    if(exi->regs[chan].csr & EXI_CSR_CS0B)
     {
-        exi.sel = 0;
+        exi->sel = 0;
         return;
     }
-    if(exi.regs[chan].csr & EXI_CSR_CS1B)
+    if(exi->regs[chan].csr & EXI_CSR_CS1B)
     {
-        exi.sel = 1;
+        exi->sel = 1;
         return;
     }
-    if(exi.regs[chan].csr & EXI_CSR_CS2B)
+    if(exi->regs[chan].csr & EXI_CSR_CS2B)
     {
-        exi.sel = 2;
+        exi->sel = 2;
         return;
     }
 
     // no device selected
-    exi.sel = -1;
+    exi->sel = -1;
 }
 
 static void write_csr(int chan, uint32_t data)
 {
     // clear interrupts 
-    exi.regs[chan].csr &= ~(data & EXI_CSR_INTERRUPTS); 
+    exi->regs[chan].csr &= ~(data & EXI_CSR_INTERRUPTS); 
 
     // update register and do select
-    exi.regs[chan].csr = (exi.regs[chan].csr & EXI_CSR_READONLY) | (data & ~EXI_CSR_READONLY);
+    exi->regs[chan].csr = (exi->regs[chan].csr & EXI_CSR_READONLY) | (data & ~EXI_CSR_READONLY);
     exi_select(chan);
     EXIUpdateInterrupts();
 }
 
-static void exi0_read_csr(uint32_t addr, uint32_t *reg)  { *reg = exi.regs[0].csr; }
-static void exi1_read_csr(uint32_t addr, uint32_t *reg)  { *reg = exi.regs[1].csr; }
-static void exi2_read_csr(uint32_t addr, uint32_t *reg)  { *reg = exi.regs[2].csr; }
+static void exi0_read_csr(uint32_t addr, uint32_t *reg)  { *reg = exi->regs[0].csr; }
+static void exi1_read_csr(uint32_t addr, uint32_t *reg)  { *reg = exi->regs[1].csr; }
+static void exi2_read_csr(uint32_t addr, uint32_t *reg)  { *reg = exi->regs[2].csr; }
 static void exi0_write_csr(uint32_t addr, uint32_t data) { write_csr(0, data); }
 static void exi1_write_csr(uint32_t addr, uint32_t data) { write_csr(1, data); }
 static void exi2_write_csr(uint32_t addr, uint32_t data) { write_csr(2, data); }
@@ -563,23 +564,23 @@ static void exi2_write_csr(uint32_t addr, uint32_t data) { write_csr(2, data); }
 // memory address for EXI DMA
 //
 
-static void exi0_read_madr(uint32_t addr, uint32_t *reg)  { *reg = exi.regs[0].madr; }
-static void exi1_read_madr(uint32_t addr, uint32_t *reg)  { *reg = exi.regs[1].madr; }
-static void exi2_read_madr(uint32_t addr, uint32_t *reg)  { *reg = exi.regs[2].madr; }
-static void exi0_write_madr(uint32_t addr, uint32_t data) { exi.regs[0].madr = data; }
-static void exi1_write_madr(uint32_t addr, uint32_t data) { exi.regs[1].madr = data; }
-static void exi2_write_madr(uint32_t addr, uint32_t data) { exi.regs[2].madr = data; }
+static void exi0_read_madr(uint32_t addr, uint32_t *reg)  { *reg = exi->regs[0].madr; }
+static void exi1_read_madr(uint32_t addr, uint32_t *reg)  { *reg = exi->regs[1].madr; }
+static void exi2_read_madr(uint32_t addr, uint32_t *reg)  { *reg = exi->regs[2].madr; }
+static void exi0_write_madr(uint32_t addr, uint32_t data) { exi->regs[0].madr = data; }
+static void exi1_write_madr(uint32_t addr, uint32_t data) { exi->regs[1].madr = data; }
+static void exi2_write_madr(uint32_t addr, uint32_t data) { exi->regs[2].madr = data; }
 
 //
 // data length for DMA
 //
 
-static void exi0_read_len(uint32_t addr, uint32_t *reg)  { *reg = exi.regs[0].len; }
-static void exi1_read_len(uint32_t addr, uint32_t *reg)  { *reg = exi.regs[1].len; }
-static void exi2_read_len(uint32_t addr, uint32_t *reg)  { *reg = exi.regs[2].len; }
-static void exi0_write_len(uint32_t addr, uint32_t data) { exi.regs[0].len = data; }
-static void exi1_write_len(uint32_t addr, uint32_t data) { exi.regs[1].len = data; }
-static void exi2_write_len(uint32_t addr, uint32_t data) { exi.regs[2].len = data; }
+static void exi0_read_len(uint32_t addr, uint32_t *reg)  { *reg = exi->regs[0].len; }
+static void exi1_read_len(uint32_t addr, uint32_t *reg)  { *reg = exi->regs[1].len; }
+static void exi2_read_len(uint32_t addr, uint32_t *reg)  { *reg = exi->regs[2].len; }
+static void exi0_write_len(uint32_t addr, uint32_t data) { exi->regs[0].len = data; }
+static void exi1_write_len(uint32_t addr, uint32_t data) { exi->regs[1].len = data; }
+static void exi2_write_len(uint32_t addr, uint32_t data) { exi->regs[2].len = data; }
 
 //
 // EXI control 
@@ -587,19 +588,19 @@ static void exi2_write_len(uint32_t addr, uint32_t data) { exi.regs[2].len = dat
 
 static void exi_write_cr(int chan, uint32_t data)
 {
-    EXIRegs *regs = &exi.regs[chan];
+    EXIRegs *regs = &exi->regs[chan];
     regs->cr = data;
 
     if(regs->cr & EXI_CR_TSTART)
     {
-        if(exi.sel == -1)
+        if(exi->sel == -1)
         {
             DBReport2(DbgChannel::EXI, "device should be selected before transfer\n");
             return;
         }
 
         // start transfer
-        EXITransfer[exi.chan = chan][exi.sel]();
+        EXITransfer[exi->chan = chan][exi->sel]();
 
         // complete transfer
         regs->cr &= ~EXI_CR_TSTART;
@@ -610,9 +611,9 @@ static void exi_write_cr(int chan, uint32_t data)
     }
 }
 
-static void exi0_read_cr(uint32_t addr, uint32_t *reg)  { *reg = exi.regs[0].cr; }
-static void exi1_read_cr(uint32_t addr, uint32_t *reg)  { *reg = exi.regs[1].cr; }
-static void exi2_read_cr(uint32_t addr, uint32_t *reg)  { *reg = exi.regs[2].cr; }
+static void exi0_read_cr(uint32_t addr, uint32_t *reg)  { *reg = exi->regs[0].cr; }
+static void exi1_read_cr(uint32_t addr, uint32_t *reg)  { *reg = exi->regs[1].cr; }
+static void exi2_read_cr(uint32_t addr, uint32_t *reg)  { *reg = exi->regs[2].cr; }
 static void exi0_write_cr(uint32_t addr, uint32_t data) { exi_write_cr(0, data); }
 static void exi1_write_cr(uint32_t addr, uint32_t data) { exi_write_cr(1, data); }
 static void exi2_write_cr(uint32_t addr, uint32_t data) { exi_write_cr(2, data); }
@@ -621,12 +622,12 @@ static void exi2_write_cr(uint32_t addr, uint32_t data) { exi_write_cr(2, data);
 // EXI immediate data
 //
 
-static void exi0_read_data(uint32_t addr, uint32_t *reg)  { *reg = exi.regs[0].data; }
-static void exi1_read_data(uint32_t addr, uint32_t *reg)  { *reg = exi.regs[1].data; }
-static void exi2_read_data(uint32_t addr, uint32_t *reg)  { *reg = exi.regs[2].data; }
-static void exi0_write_data(uint32_t addr, uint32_t data) { exi.regs[0].data = data; }
-static void exi1_write_data(uint32_t addr, uint32_t data) { exi.regs[1].data = data; }
-static void exi2_write_data(uint32_t addr, uint32_t data) { exi.regs[2].data = data; }
+static void exi0_read_data(uint32_t addr, uint32_t *reg)  { *reg = exi->regs[0].data; }
+static void exi1_read_data(uint32_t addr, uint32_t *reg)  { *reg = exi->regs[1].data; }
+static void exi2_read_data(uint32_t addr, uint32_t *reg)  { *reg = exi->regs[2].data; }
+static void exi0_write_data(uint32_t addr, uint32_t data) { exi->regs[0].data = data; }
+static void exi1_write_data(uint32_t addr, uint32_t data) { exi->regs[1].data = data; }
+static void exi2_write_data(uint32_t addr, uint32_t data) { exi->regs[2].data = data; }
 
 // ---------------------------------------------------------------------------
 // init
@@ -636,20 +637,21 @@ void EIOpen(HWConfig * config)
     DBReport2(DbgChannel::EXI, "External devices interface bus\n");
 
     // clear registers
-    memset(&exi, 0, sizeof(EIControl));
+    memset(exi.Get(), 0, sizeof(EIControl));
 
     // load user variables
-    exi.log = config->exi_log;
-    exi.osReport = config->exi_osReport;
+    exi->log = config->exi_log;
+    exi->osReport = config->exi_osReport;
+    exi->headless = config->headless;
     
     // reset devices
-    exi.sel = -1;           // deselect MX device
-    SRAMLoad(&exi.sram);    // load sram
+    exi->sel = -1;           // deselect MX device
+    SRAMLoad(&exi->sram);    // load sram
     RTCUpdate();
-    if (!mi.BootromPresent)
+    if (!mi->BootromPresent)
     {
-        FontLoad(&exi.ansiFont, ANSI_SIZE, config->ansiFilename);
-        FontLoad(&exi.sjisFont, SJIS_SIZE, config->sjisFilename);
+        FontLoad(&exi->ansiFont, ANSI_SIZE, config->ansiFilename);
+        FontLoad(&exi->sjisFont, SJIS_SIZE, config->sjisFilename);
     }
 
     // set traps for EXI channel 0 registers
@@ -673,8 +675,11 @@ void EIOpen(HWConfig * config)
     MISetTrap(32, EXI2_CR  , exi2_read_cr  , exi2_write_cr)  ;
     MISetTrap(32, EXI2_DATA, exi2_read_data, exi2_write_data);
 
-    // open memory cards
-    MCOpen(config);
+    // open memory cards (they are inserted in the main instance)
+    if (!exi->headless)
+    {
+        MCOpen(config);
+    }
 
     // open broad band adapter
 }
@@ -682,14 +687,39 @@ void EIOpen(HWConfig * config)
 void EIClose()
 {
     // close memory cards
-    MCClose();
+    if (!exi->headless)
+    {
+        MCClose();
+    }
 
     // close broad band adapter
 
     // unload fonts
-    FontUnload(&exi.ansiFont);
-    FontUnload(&exi.sjisFont);
+    FontUnload(&exi->ansiFont);
+    FontUnload(&exi->sjisFont);
 
-    // sync sram
-    SRAMSave(&exi.sram);
+    // sync sram (the file belongs to the main instance)
+    if (!exi->headless)
+    {
+        SRAMSave(&exi->sram);
+    }
+}
+
+// Memory cards and the fonts are not part of the state
+void EIDoState(StateStream& state)
+{
+    state.BeginSection('EXI ', 1);
+    state.Do(exi->regs);
+    state.Do(exi->sram);
+    state.Do(exi->rtcVal);
+    state.Do(exi->ad16);
+    state.Do(exi->uart);
+    state.Do(exi->upos);
+    state.Do(exi->chan);
+    state.Do(exi->sel);
+    state.Do(exi->ad16_cmd);
+    state.Do(exi->firstImm);
+    state.Do(exi->mxaddr);
+    state.Do(exi->uartNE);
+    state.EndSection();
 }
@@ -99,9 +99,10 @@ struct EIControl
 
     bool        log;            // allow log EXI activities
     bool        osReport;       // allow UART debugger output (log not affecting this)
+    bool        headless;       // no memcards, SRAM is not saved (see Instance::headless)
 };
 
-extern  EIControl exi;
+extern  InstanceRef<EIControl, &Instance::exi> exi;
 
 void    RTCUpdate();
 
@@ -112,3 +113,4 @@ void    EXIDetach(int chan);    // disconnect device
 
 void    EIOpen(HWConfig* config);
 void    EIClose();
+void    EIDoState(StateStream& state);
@@ -4,28 +4,40 @@
 
 void GXFifoWriteBurst(uint8_t data[32])
 {
-    // PI FIFO
+    memcpy(GXFifoWritePointer(), data, 32);
+    GXFifoCommitBurst();
+}
+
+uint8_t* GXFifoWritePointer()
+{
+    return &mi->ram[(pi->wrptr & ~PI_WRPTR_WRAP) & RAMMASK];
+}
+
+void GXFifoCommitBurst()
+{
+    Debug::PerfAdd(Debug::PerfCounter::FifoBytes, 32);
+    mi->dirty.Mark((pi->wrptr & ~PI_WRPTR_WRAP) & RAMMASK);
 
-    pi.wrptr &= ~PI_WRPTR_WRAP;
+    // PI FIFO
 
-    memcpy(&mi.ram[pi.wrptr & RAMMASK], data, 32);
-    pi.wrptr += 32;
+    pi->wrptr &= ~PI_WRPTR_WRAP;
+    pi->wrptr += 32;
 
-    if (pi.wrptr == pi.top)
+    if (pi->wrptr == pi->top)
     {
-        pi.wrptr = pi.base;
-        pi.wrptr |= PI_WRPTR_WRAP;
+        pi->wrptr = pi->base;
+        pi->wrptr |= PI_WRPTR_WRAP;
     }
     
     // CP FIFO
 
-    if (fifo.cp.cr & CP_CR_WPINC)
+    if (fifo->cp.cr & CP_CR_WPINC)
     {
-        fifo.cp.wrptr += 32;
+        fifo->cp.wrptr += 32;
 
-        if (fifo.cp.wrptr == fifo.cp.top)
+        if (fifo->cp.wrptr == fifo->cp.top)
         {
-            fifo.cp.wrptr = fifo.cp.base;
+            fifo->cp.wrptr = fifo->cp.base;
         }
 
         // All other work is done by CPThread.
@@ -5,3 +5,7 @@
 #define GX_FIFO         0x0C008000
 
 void GXFifoWriteBurst(uint8_t data[32]);
+
+// Gather pipe fast path: the burst is assembled directly at the PI FIFO write pointer in RAM and then committed.
+uint8_t* GXFifoWritePointer();
+void GXFifoCommitBurst();
@@ -4,7 +4,7 @@
 
 namespace Flipper
 {
-    Flipper* HW;
+    InstanceRef<Flipper, &Instance::hw> HW;
 
     // This thread acts as the HWUpdate of Dolwin 0.10.
     // Previously, an HWUpdate call occurred after each Gekko instruction (or so).
@@ -16,6 +16,8 @@ namespace Flipper
 
         while (true)
         {
+            flipper->hwUpdateThread->ParkPoint();
+
             int64_t ticks = Gekko::Gekko->GetTicks();
             if (ticks < flipper->hwUpdateTbrValue)
             {
@@ -42,10 +44,10 @@ namespace Flipper
         VIOpen(config); // video (TV)
         CPOpen(config); // fifo
         AIOpen(config); // audio (AID and AIS)
-        AROpen();       // aux. memory (ARAM)
+        AROpen(config); // aux. memory (ARAM)
         EIOpen(config); // expansion interface (EXI)
         DIOpen();       // disk
-        SIOpen();       // GC controllers
+        SIOpen(config); // GC controllers
         PIOpen(config); // interrupts, console regs
 
         DSP = new DSP::DspCore(config);
@@ -53,20 +55,30 @@ namespace Flipper
 
         DBReport("\n");
 
-        GXOpen(mi.ram, wnd.hMainWindow);
-        PADOpen(wnd.hMainWindow);
+        // The video backend, pads and the debugger are attached to the main instance
+        headless = config->headless;
+        if (!headless)
+        {
+            GXOpen(mi->ram, wnd.hMainWindow);
+            PADOpen(wnd.hMainWindow);
 
-        Debug::Hub.AddNode(HW_JDI_JSON, hw_init_handlers);
+            Debug::Hub.AddNode(HW_JDI_JSON, hw_init_handlers);
+        }
 
-        hwUpdateThread = new Thread(HwUpdateThread, false, this, "HW");
+        // Started after the pointer is set, the thread uses it
+        hwUpdateThread = new Thread(HwUpdateThread, true, this, "HW");
         assert(hwUpdateThread);
+        hwUpdateThread->Resume();
     }
 
     Flipper::~Flipper()
     {
         delete hwUpdateThread;
 
-        Debug::Hub.RemoveNode(HW_JDI_JSON);
+        if (!headless)
+        {
+            Debug::Hub.RemoveNode(HW_JDI_JSON);
+        }
 
         delete DSP;
 
@@ -78,9 +90,12 @@ namespace Flipper
         DIClose();      // release streaming buffer
         MIClose();
 
-        PADClose();
         delete Mixer;
-        GXClose();
+        if (!headless)
+        {
+            PADClose();
+            GXClose();
+        }
     }
 
     void Flipper::Update()
@@ -88,6 +103,44 @@ namespace Flipper
         // update joypads and video
         VIUpdate();
         SIPoll();
+
+        // ARAM DMA completion
+        ARUpdate();
+    }
+
+    // The thread that saves the state (the rewind buffer is called by the HW thread) is not parked
+    void Flipper::Park()
+    {
+        hwUpdateThread->Park();
+        fifo->thread->Park();
+        ai->audioThread->Park();
+        DSP->Park();
+    }
+
+    void Flipper::Unpark()
+    {
+        DSP->Unpark();
+        ai->audioThread->Unpark();
+        fifo->thread->Unpark();
+        hwUpdateThread->Unpark();
+    }
+
+    void Flipper::DoState(StateStream& state)
+    {
+        state.BeginSection('HW  ', 1);
+        state.Do(hwUpdateTbrValue);
+        state.EndSection();
+
+        VIDoState(state);
+        CPDoState(state);
+        AIDoState(state);
+        ARDoState(state);
+        EIDoState(state);
+        DIDoState(state);
+        SIDoState(state);
+        PIDoState(state);
+
+        DSP->DoState(state);
     }
 
 }
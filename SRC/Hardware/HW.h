@@ -15,6 +15,7 @@ namespace Flipper
 		static void HwUpdateThread(void* Parameter);
 
 		int64_t hwUpdateTbrValue = 0;
+		bool headless = false;		// See Instance::headless
 
 		Thread* hwUpdateThread = nullptr;
 		static const size_t ticksToHwUpdate = 100;
@@ -27,7 +28,14 @@ namespace Flipper
 		~Flipper();
 
 		void Update();
+
+		// Registers and internal state of all Flipper devices (memory contents are saved by the snapshot pages)
+		void DoState(StateStream& state);
+
+		// Stop the device threads (HW, CP, AI, DSP) between updates, while the state is saved or loaded
+		void Park();
+		void Unpark();
 	};
 
-	extern Flipper* HW;
+	extern InstanceRef<Flipper, &Instance::hw> HW;
 }
@@ -5,9 +5,14 @@
 // Config from Ui
 
 #include <Windows.h>
+#include "../Common/StateStream.h"
+#include "../Common/Instance.h"
 
 struct HWConfig
 {
+    // No video, pad and sound output, no memcards (see Instance::headless)
+    bool        headless;
+
     // MI
     size_t      ramsize;
 
@@ -17,6 +22,14 @@ struct HWConfig
     bool        vi_xfb;
     int         videoEncoderFuse;       // 1 - PAL, 0 - NTSC
 
+    // AX
+    int         audioSink;          // See Flipper::AudioSinkType
+    uint32_t    audioRate;          // Output sample rate (0: default)
+    TCHAR       audioWavFilename[0x1000];
+
+    // AR
+    bool        aramChunkedDma;
+
     // PI
     uint32_t    consoleVer;
     bool        rswhack;
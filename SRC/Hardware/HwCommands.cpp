@@ -9,7 +9,7 @@ namespace Flipper
 		uint32_t address = (uint32_t)strtoul(args[2].c_str(), nullptr, 0) & RAMMASK;
 		auto data = UI::FileLoad(args[1].c_str());
 
-		if (address >= mi.ramSize || (address + data.size()) >= mi.ramSize)
+		if (address >= mi->ramSize || (address + data.size()) >= mi->ramSize)
 		{
 			DBReport("Address out of range!\n");
 			return nullptr;
@@ -21,7 +21,11 @@ namespace Flipper
 			return nullptr;
 		}
 
-		std::memcpy(&mi.ram[address], data.data(), data.size());
+		std::memcpy(&mi->ram[address], data.data(), data.size());
+		mi->dirty.Mark(address, data.size());
+
+		// The binary may be code (cached segment address)
+		Gekko::Gekko->InvalidateCodeAtSafePoint(0x8000'0000 | address, data.size());
 		return nullptr;
 	}
 
@@ -31,13 +35,13 @@ namespace Flipper
 		uint32_t address = (uint32_t)strtoul(args[2].c_str(), nullptr, 0) & RAMMASK;
 		uint32_t dataSize = (uint32_t)strtoul(args[3].c_str(), nullptr, 0);
 
-		if (address >= mi.ramSize || (address + dataSize) >= mi.ramSize)
+		if (address >= mi->ramSize || (address + dataSize) >= mi->ramSize)
 		{
 			DBReport("Address out of range!\n");
 			return nullptr;
 		}
 
-		auto ptr = &mi.ram[address];
+		auto ptr = &mi->ram[address];
 		auto buffer = std::vector<uint8_t>();
 		buffer.assign(ptr, ptr + dataSize);
 
@@ -66,7 +70,8 @@ namespace Flipper
 			return nullptr;
 		}
 
-		std::memcpy(&aram.mem[address], data.data(), data.size());
+		std::memcpy(&aram->mem[address], data.data(), data.size());
+		aram->dirty.Mark(address, data.size());
 		return nullptr;
 	}
 
@@ -82,7 +87,7 @@ namespace Flipper
 			return nullptr;
 		}
 
-		auto ptr = &aram.mem[address];
+		auto ptr = &aram->mem[address];
 		auto buffer = std::vector<uint8_t>();
 		buffer.assign(ptr, ptr + dataSize);
 
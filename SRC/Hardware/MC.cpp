@@ -145,11 +145,7 @@ const uint32_t Memcard_ValidSizes[Num_Memcard_ValidSizes] = {
     0x01000000  //16777216 bytes , // Memory Card 2043
 };
 
-bool Memcard_Connected[2] = { false, false };
-bool SyncSave = false;
-bool MCOpened = false;
-
-Memcard memcard[2];
+InstanceRef<MCControl, &Instance::mc> mc;
 
 static uint32_t MCCalculateOffset (uint32_t mc_address) {
 	if (mc_address & MEMCARD_BA_EXTRABYTES)
@@ -160,7 +156,7 @@ static uint32_t MCCalculateOffset (uint32_t mc_address) {
 }
 
 static void MCSyncSave (Memcard * memcard, uint32_t offset , uint32_t size) {
-    if (SyncSave == TRUE) // Bad idea!!
+    if (mc->SyncSave == TRUE) // Bad idea!!
     {
         if (fseek(memcard->file, offset, SEEK_SET) != 0) {
             DBHalt("MC :: Error at seeking the memcard file.\n");
@@ -200,7 +196,7 @@ static void MCPageProgramProc (Memcard * memcard){
     uint8_t *abuf;
     uint32_t size;
     if (exi->cr & EXI_CR_DMA) {
-        abuf = &mi.ram[exi->madr & RAMMASK];
+        abuf = &mi->ram[exi->madr & RAMMASK];
         size = exi->len;
     }
     else {
@@ -238,8 +234,9 @@ static void MCReadArrayProc (Memcard * memcard){
     uint32_t size;
 
     if (exi->cr & EXI_CR_DMA) {
-        abuf = &mi.ram[exi->madr & RAMMASK];
+        abuf = &mi->ram[exi->madr & RAMMASK];
         size = exi->len;
+        mi->dirty.Mark(exi->madr & RAMMASK, size);
     }
     else {
         abuf = (uint8_t *)&exi->data;
@@ -344,12 +341,12 @@ void MCTransfer () {
     Memcard *auxmc;
     EXIRegs *auxexi;
 
-    if ((exi.regs[MEMCARD_SLOTA].cr & EXI_CR_TSTART) &&
-		(exi.regs[MEMCARD_SLOTA].csr & EXI_CSR_CS0B))
-        auxmc = &memcard[MEMCARD_SLOTA];
-    else if ((exi.regs[MEMCARD_SLOTB].cr & EXI_CR_TSTART) &&
-			 (exi.regs[MEMCARD_SLOTB].csr & EXI_CSR_CS0B))
-        auxmc = &memcard[MEMCARD_SLOTB];
+    if ((exi->regs[MEMCARD_SLOTA].cr & EXI_CR_TSTART) &&
+		(exi->regs[MEMCARD_SLOTA].csr & EXI_CSR_CS0B))
+        auxmc = &mc->memcard[MEMCARD_SLOTA];
+    else if ((exi->regs[MEMCARD_SLOTB].cr & EXI_CR_TSTART) &&
+			 (exi->regs[MEMCARD_SLOTB].csr & EXI_CSR_CS0B))
+        auxmc = &mc->memcard[MEMCARD_SLOTB];
     else return;
 
     if (auxmc->connected == FALSE) return;
@@ -431,7 +428,7 @@ void MCTransfer () {
 bool    MCIsConnected(int cardnum) {
     // Invalid memcard number
     assert((cardnum == MEMCARD_SLOTA) || (cardnum == MEMCARD_SLOTB));
-    return memcard[cardnum].connected;
+    return mc->memcard[cardnum].connected;
 }
 
 /*
@@ -495,10 +492,10 @@ void    MCUseFile(int cardnum, const TCHAR *path, bool connect) {
 
     // Invalid memcard number
     assert((cardnum == MEMCARD_SLOTA) || (cardnum == MEMCARD_SLOTB));
-    if (memcard[cardnum].connected == TRUE) MCDisconnect(cardnum);
+    if (mc->memcard[cardnum].connected == TRUE) MCDisconnect(cardnum);
 
-    memset(memcard[cardnum].filename, 0, sizeof (memcard[cardnum].filename));
-    _tcscpy_s(memcard[cardnum].filename, _countof(memcard[cardnum].filename) - 1, path);
+    memset(mc->memcard[cardnum].filename, 0, sizeof (mc->memcard[cardnum].filename));
+    _tcscpy_s(mc->memcard[cardnum].filename, _countof(mc->memcard[cardnum].filename) - 1, path);
 
     if (connect == true) MCConnect(cardnum);
 }
@@ -512,23 +509,23 @@ void MCOpen (HWConfig * config)
 {
     DBReport2 (DbgChannel::MC, "Memory cards\n");
 
-    MCOpened = TRUE;
+    mc->MCOpened = TRUE;
     memset(memcard, 0 , 2 * sizeof (Memcard));
-    memcard[MEMCARD_SLOTA].Command = MEMCARD_COMMAND_UNDEFINED;
-    memcard[MEMCARD_SLOTB].Command = MEMCARD_COMMAND_UNDEFINED;
-    memcard[MEMCARD_SLOTA].ready = TRUE;
-    memcard[MEMCARD_SLOTB].ready = TRUE;
-    memcard[MEMCARD_SLOTA].exi = &exi.regs[MEMCARD_SLOTA];
-    memcard[MEMCARD_SLOTB].exi = &exi.regs[MEMCARD_SLOTB];
+    mc->memcard[MEMCARD_SLOTA].Command = MEMCARD_COMMAND_UNDEFINED;
+    mc->memcard[MEMCARD_SLOTB].Command = MEMCARD_COMMAND_UNDEFINED;
+    mc->memcard[MEMCARD_SLOTA].ready = TRUE;
+    mc->memcard[MEMCARD_SLOTB].ready = TRUE;
+    mc->memcard[MEMCARD_SLOTA].exi = &exi->regs[MEMCARD_SLOTA];
+    mc->memcard[MEMCARD_SLOTB].exi = &exi->regs[MEMCARD_SLOTB];
 
     /* load settings */
-    Memcard_Connected[MEMCARD_SLOTA] = config->MemcardA_Connected;
-    Memcard_Connected[MEMCARD_SLOTB] = config->MemcardB_Connected;
-    _tcscpy_s(memcard[MEMCARD_SLOTA].filename, _countof(memcard[MEMCARD_SLOTA].filename) - 1, config->MemcardA_Filename);
-    _tcscpy_s(memcard[MEMCARD_SLOTB].filename, _countof(memcard[MEMCARD_SLOTB].filename) - 1, config->MemcardB_Filename);
-    SyncSave = config->Memcard_SyncSave;
+    mc->Memcard_Connected[MEMCARD_SLOTA] = config->MemcardA_Connected;
+    mc->Memcard_Connected[MEMCARD_SLOTB] = config->MemcardB_Connected;
+    _tcscpy_s(mc->memcard[MEMCARD_SLOTA].filename, _countof(mc->memcard[MEMCARD_SLOTA].filename) - 1, config->MemcardA_Filename);
+    _tcscpy_s(mc->memcard[MEMCARD_SLOTB].filename, _countof(mc->memcard[MEMCARD_SLOTB].filename) - 1, config->MemcardB_Filename);
+    mc->SyncSave = config->Memcard_SyncSave;
 
-    if (memcard[MEMCARD_SLOTA].filename[0] == 0) {
+    if (mc->memcard[MEMCARD_SLOTA].filename[0] == 0) {
         /* there is no info in the registry. use a default memcard */
 
         const TCHAR * filename = _T(".\\Data\\MemCardA.mci");
@@ -540,16 +537,16 @@ void MCOpen (HWConfig * config)
             /* if default memcard doesn't exist, create it */
             if (MCCreateMemcardFile(filename, MEMCARD_ID_64) == TRUE) {
                 MCUseFile(MEMCARD_SLOTA, filename, FALSE);
-                Memcard_Connected[MEMCARD_SLOTA] = TRUE;
+                mc->Memcard_Connected[MEMCARD_SLOTA] = TRUE;
             }
         }
         else {
             fclose(fileptr);
             MCUseFile(MEMCARD_SLOTA, filename, FALSE);
-            Memcard_Connected[MEMCARD_SLOTA] = TRUE;
+            mc->Memcard_Connected[MEMCARD_SLOTA] = TRUE;
         }
     }
-    if (memcard[MEMCARD_SLOTB].filename[0] == 0) {
+    if (mc->memcard[MEMCARD_SLOTB].filename[0] == 0) {
         /* there is no info in the registry. use a default memcard */
 
         const TCHAR * filename = _T(".\\Data\\MemCardB.mci");
@@ -561,13 +558,13 @@ void MCOpen (HWConfig * config)
             /* if default memcard doesn't exist, create it */
             if (MCCreateMemcardFile(filename, MEMCARD_ID_64) == TRUE) {
                 MCUseFile(MEMCARD_SLOTB, filename, FALSE);
-                Memcard_Connected[MEMCARD_SLOTB] = TRUE;
+                mc->Memcard_Connected[MEMCARD_SLOTB] = TRUE;
             }
         }
         else {
             fclose(fileptr);
             MCUseFile(MEMCARD_SLOTB, filename, FALSE);
-            Memcard_Connected[MEMCARD_SLOTB] = TRUE;
+            mc->Memcard_Connected[MEMCARD_SLOTB] = TRUE;
         }
     }
 
@@ -578,37 +575,37 @@ void MCOpen (HWConfig * config)
  * Disconnects both Memcard. Closes the memcard system and saves the current settings
  */ 
 void MCClose () {
-    MCOpened = false;
+    mc->MCOpened = false;
     MCDisconnect();
 }
 
 /* 
  * Connects the choosen memcard
  * 
- * cardnum = -1 for both (based on the Memcard_Connected setting)
+ * cardnum = -1 for both (based on the mc->Memcard_Connected setting)
  */
 bool MCConnect (int cardnum) {
     bool ret = true;
     int i;
     switch (cardnum) {
     case -1:
-        if (Memcard_Connected[MEMCARD_SLOTA] /*== TRUE*/)   ret = MCConnect(MEMCARD_SLOTA);
-        if (Memcard_Connected[MEMCARD_SLOTB] /*== TRUE*/)   ret = ret && MCConnect(MEMCARD_SLOTB);
+        if (mc->Memcard_Connected[MEMCARD_SLOTA] /*== TRUE*/)   ret = MCConnect(MEMCARD_SLOTA);
+        if (mc->Memcard_Connected[MEMCARD_SLOTB] /*== TRUE*/)   ret = ret && MCConnect(MEMCARD_SLOTB);
         return ret;
         break;
     case MEMCARD_SLOTA:
     case MEMCARD_SLOTB:
-        if (memcard[cardnum].connected /*== TRUE*/) MCDisconnect(cardnum) ;
+        if (mc->memcard[cardnum].connected /*== TRUE*/) MCDisconnect(cardnum) ;
 
-        size_t memcardSize = UI::FileSize(memcard[cardnum].filename);
+        size_t memcardSize = UI::FileSize(mc->memcard[cardnum].filename);
 
-        memcard[cardnum].file = nullptr;
-        _tfopen_s (&memcard[cardnum].file, memcard[cardnum].filename, _T("r+b"));
-        if (memcard[cardnum].file == NULL) {
+        mc->memcard[cardnum].file = nullptr;
+        _tfopen_s (&mc->memcard[cardnum].file, mc->memcard[cardnum].filename, _T("r+b"));
+        if (mc->memcard[cardnum].file == NULL) {
             static char slt[2] = { 'A', 'B' };
 
             // TODO: redirect user to memcard configure dialog ?
-            auto str = Util::convert<char>(UI::FileShortName(memcard[cardnum].filename));
+            auto str = Util::convert<char>(UI::FileShortName(mc->memcard[cardnum].filename));
             UI::DolwinReport(
                 L"Couldnt open memcard (slot %c),\n"
                 L"location : %s\n\n"
@@ -623,46 +620,46 @@ bool MCConnect (int cardnum) {
         if (i >= Num_Memcard_ValidSizes) {
 //          DBReport(YEL "memcard file doesnt have a valid size\n");
             MessageBox (NULL, _T("memcard file doesnt have a valid size"), _T("Memcard Error"), 0);
-            fclose(memcard[cardnum].file);
-            memcard[cardnum].file = NULL;
+            fclose(mc->memcard[cardnum].file);
+            mc->memcard[cardnum].file = NULL;
             return FALSE;
         }
 
-        memcard[cardnum].size = (uint32_t)memcardSize;
-        memcard[cardnum].data = (uint8_t *)malloc(memcard[cardnum].size);
+        mc->memcard[cardnum].size = (uint32_t)memcardSize;
+        mc->memcard[cardnum].data = (uint8_t *)malloc(mc->memcard[cardnum].size);
 
-        if (memcard[cardnum].data == NULL) {
+        if (mc->memcard[cardnum].data == NULL) {
 //          DBReport(YEL "couldnt allocate enough memory for memcard\n");
             MessageBox (NULL, _T("couldnt allocate enough memory for memcard"), _T("Memcard Error"), 0);
-            fclose(memcard[cardnum].file);
-            memcard[cardnum].file = NULL;
+            fclose(mc->memcard[cardnum].file);
+            mc->memcard[cardnum].file = NULL;
             return FALSE;
         }
 
-        if (fseek(memcard[cardnum].file, 0, SEEK_SET) != 0) {
+        if (fseek(mc->memcard[cardnum].file, 0, SEEK_SET) != 0) {
 //          DBReport(YEL "error at locating file cursor\n");
             MessageBox (NULL , _T("error at locating file cursor"), _T("Memcard Error"), 0);
-            free (memcard[cardnum].data);
-            memcard[cardnum].data = NULL;
-            fclose(memcard[cardnum].file);
-            memcard[cardnum].file = NULL;
+            free (mc->memcard[cardnum].data);
+            mc->memcard[cardnum].data = NULL;
+            fclose(mc->memcard[cardnum].file);
+            mc->memcard[cardnum].file = NULL;
             return FALSE;
         }
 
-        if (fread(memcard[cardnum].data, memcard[cardnum].size, 1, memcard[cardnum].file) != 1) {
+        if (fread(mc->memcard[cardnum].data, mc->memcard[cardnum].size, 1, mc->memcard[cardnum].file) != 1) {
 //          DBReport(YEL "error at reading the memcard file\n");
             MessageBox (NULL, _T("error at reading the memcard file"), _T("Memcard Error"), 0);
-            free (memcard[cardnum].data);
-            memcard[cardnum].data = NULL;
-            fclose(memcard[cardnum].file);
-            memcard[cardnum].file = NULL;
+            free (mc->memcard[cardnum].data);
+            mc->memcard[cardnum].data = NULL;
+            fclose(mc->memcard[cardnum].file);
+            mc->memcard[cardnum].file = NULL;
             return FALSE;
         }
 
         /* if nothing fails... */
-        memcard[cardnum].ID = ((uint16_t)0xC2) << 8 | (uint16_t)0x42; // Datel's code just for now
-        memcard[cardnum].status = MEMCARD_STATUS_READY;
-        memcard[cardnum].connected = TRUE;
+        mc->memcard[cardnum].ID = ((uint16_t)0xC2) << 8 | (uint16_t)0x42; // Datel's code just for now
+        mc->memcard[cardnum].status = MEMCARD_STATUS_READY;
+        mc->memcard[cardnum].connected = TRUE;
         EXIAttach(cardnum);        // connect device
 
         return TRUE;
@@ -683,32 +680,32 @@ bool MCDisconnect (int cardnum) {
         break;
     case MEMCARD_SLOTA:
     case MEMCARD_SLOTB:
-        if (!memcard[cardnum].connected) break ;
+        if (!mc->memcard[cardnum].connected) break ;
 
-        if (fseek(memcard[cardnum].file, 0, SEEK_SET) != 0)
+        if (fseek(mc->memcard[cardnum].file, 0, SEEK_SET) != 0)
         {
             ret = FALSE;
         }
         else
         {
             /* write to the file */
-            if (fwrite(memcard[cardnum].data, memcard[cardnum].size, 1, memcard[cardnum].file) != 1)
+            if (fwrite(mc->memcard[cardnum].data, mc->memcard[cardnum].size, 1, mc->memcard[cardnum].file) != 1)
             {
                 ret = FALSE;
             }
 
         }
         /* close the file */
-        fclose(memcard[cardnum].file);
+        fclose(mc->memcard[cardnum].file);
 
-        free(memcard[cardnum].data);
+        free(mc->memcard[cardnum].data);
 
-        memcard[cardnum].ID = 0;
-        memcard[cardnum].size = 0;
-        memcard[cardnum].file = NULL;
-        memcard[cardnum].data = NULL;
-        memcard[cardnum].status = 0;
-        memcard[cardnum].connected = FALSE;
+        mc->memcard[cardnum].ID = 0;
+        mc->memcard[cardnum].size = 0;
+        mc->memcard[cardnum].file = NULL;
+        mc->memcard[cardnum].data = NULL;
+        mc->memcard[cardnum].status = 0;
+        mc->memcard[cardnum].connected = FALSE;
         EXIDetach(cardnum);        // disconnect device
 
         break;
@@ -85,20 +85,25 @@ struct MCCommand {
 #define Num_Memcard_ValidSizes 6
 extern const uint32_t Memcard_ValidSizes[Num_Memcard_ValidSizes];
 
-/* defines if the memcard should be tried to connect, (not if the memcard is actually connected!!) */
-extern bool Memcard_Connected[2];
-
-/*
- * if SyncSave is TRUE, all write operations on the memcard will be instantaneusly saved to disk
- * if not, the memcard will only be saved to disk when it is disconnected
- */
-extern bool SyncSave;
-
-/* Memcards vars */
-extern Memcard memcard[2];
+struct MCControl
+{
+    /* defines if the memcard should be tried to connect, (not if the memcard is actually connected!!) */
+    bool Memcard_Connected[2];
+
+    /*
+     * if SyncSave is TRUE, all write operations on the memcard will be instantaneusly saved to disk
+     * if not, the memcard will only be saved to disk when it is disconnected
+     */
+    bool SyncSave;
+
+    /* Memcards vars */
+    Memcard memcard[2];
+
+    /* defines if the Memcard system has been opened */
+    bool MCOpened;
+};
 
-/* defines if the Memcard system has been opened */
-extern bool MCOpened;
+extern InstanceRef<MCControl, &Instance::mc> mc;
 
 /***************************************************************/
 
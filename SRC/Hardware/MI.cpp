@@ -4,25 +4,41 @@
 // MI is implemented only for HW2 consoles! it is not back-compatible.
 #include "pch.h"
 
-// hardware traps tables.
-void (*hw_read8[0x10000])(uint32_t, uint32_t*);
-void (*hw_write8[0x10000])(uint32_t, uint32_t);
-void (*hw_read16[0x10000])(uint32_t, uint32_t*);
-void (*hw_write16[0x10000])(uint32_t, uint32_t);
-void (*hw_read32[0x10000])(uint32_t, uint32_t*);
-void (*hw_write32[0x10000])(uint32_t, uint32_t);
-
 // stubs for MI registers
 static void no_write(uint32_t addr, uint32_t data) {}
 static void no_read(uint32_t addr, uint32_t *reg)  { *reg = 0; }
 
-MIControl mi;
+InstanceRef<MIControl, &Instance::mi> mi;
+
+// Count the register access for the device that owns the 1 KB block
+static inline void MICountMmio(uint32_t pa)
+{
+    Debug::PerfCounter counter;
+
+    switch ((pa >> 10) & 0x3f)
+    {
+        case 0x00: counter = Debug::PerfCounter::MmioCP; break;
+        case 0x04: counter = Debug::PerfCounter::MmioPE; break;
+        case 0x08: counter = Debug::PerfCounter::MmioVI; break;
+        case 0x0C: counter = Debug::PerfCounter::MmioPI; break;
+        case 0x10: counter = Debug::PerfCounter::MmioMI; break;
+        case 0x14: counter = Debug::PerfCounter::MmioDSP; break;
+        case 0x18: counter = Debug::PerfCounter::MmioDI; break;
+        case 0x19: counter = Debug::PerfCounter::MmioSI; break;
+        case 0x1A: counter = Debug::PerfCounter::MmioEXI; break;
+        case 0x1B: counter = Debug::PerfCounter::MmioAI; break;
+        case 0x20: counter = Debug::PerfCounter::MmioGX; break;
+        default: counter = Debug::PerfCounter::MmioOther; break;
+    }
+
+    Debug::PerfAdd(counter);
+}
 
 void MIReadByte(uint32_t pa, uint32_t* reg)
 {
     uint8_t* ptr;
 
-    if (mi.ram == nullptr)
+    if (mi->ram == nullptr)
     {
         *reg = 0;
         return;
@@ -30,9 +46,9 @@ void MIReadByte(uint32_t pa, uint32_t* reg)
 
     if (pa >= BOOTROM_START_ADDRESS)
     {
-        if (mi.BootromPresent)
+        if (mi->BootromPresent)
         {
-            ptr = &mi.bootrom[pa - BOOTROM_START_ADDRESS];
+            ptr = &mi->bootrom[pa - BOOTROM_START_ADDRESS];
             *reg = (uint32_t)*ptr;
         }
         else
@@ -45,7 +61,8 @@ void MIReadByte(uint32_t pa, uint32_t* reg)
     // hardware trap
     if (pa >= HW_BASE)
     {
-        hw_read8[pa & 0xffff](pa, reg);
+        MICountMmio(pa);
+        mi->hw_read8[pa & 0xffff](pa, reg);
         return;
     }
 
@@ -57,9 +74,9 @@ void MIReadByte(uint32_t pa, uint32_t* reg)
     }
 
     // bus load byte
-    if (pa < mi.ramSize)
+    if (pa < mi->ramSize)
     {
-        ptr = &mi.ram[pa];
+        ptr = &mi->ram[pa];
         *reg = (uint32_t)*ptr;
     }
     else
@@ -72,7 +89,7 @@ void MIWriteByte(uint32_t pa, uint32_t data)
 {
     uint8_t* ptr;
 
-    if (mi.ram == nullptr)
+    if (mi->ram == nullptr)
     {
         return;
     }
@@ -85,7 +102,8 @@ void MIWriteByte(uint32_t pa, uint32_t data)
     // hardware trap
     if (pa >= HW_BASE)
     {
-        hw_write8[pa & 0xffff](pa, (uint8_t)data);
+        MICountMmio(pa);
+        mi->hw_write8[pa & 0xffff](pa, (uint8_t)data);
         return;
     }
 
@@ -97,10 +115,11 @@ void MIWriteByte(uint32_t pa, uint32_t data)
     }
 
     // bus store byte
-    if (pa < mi.ramSize)
+    if (pa < mi->ramSize)
     {
-        ptr = &mi.ram[pa];
+        ptr = &mi->ram[pa];
         *ptr = (uint8_t)data;
+        mi->dirty.Mark(pa);
     }
 }
 
@@ -108,7 +127,7 @@ void MIReadHalf(uint32_t pa, uint32_t* reg)
 {
     uint8_t* ptr;
 
-    if (mi.ram == nullptr)
+    if (mi->ram == nullptr)
     {
         *reg = 0;
         return;
@@ -116,9 +135,9 @@ void MIReadHalf(uint32_t pa, uint32_t* reg)
 
     if (pa >= BOOTROM_START_ADDRESS)
     {
-        if (mi.BootromPresent)
+        if (mi->BootromPresent)
         {
-            ptr = &mi.bootrom[pa - BOOTROM_START_ADDRESS];
+            ptr = &mi->bootrom[pa - BOOTROM_START_ADDRESS];
             *reg = (uint32_t)_byteswap_ushort(*(uint16_t*)ptr);
         }
         else
@@ -131,7 +150,8 @@ void MIReadHalf(uint32_t pa, uint32_t* reg)
     // hardware trap
     if (pa >= HW_BASE)
     {
-        hw_read16[pa & 0xfffe](pa, reg);
+        MICountMmio(pa);
+        mi->hw_read16[pa & 0xfffe](pa, reg);
         return;
     }
 
@@ -143,9 +163,9 @@ void MIReadHalf(uint32_t pa, uint32_t* reg)
     }
 
     // bus load halfword
-    if (pa < mi.ramSize)
+    if (pa < mi->ramSize)
     {
-        ptr = &mi.ram[pa];
+        ptr = &mi->ram[pa];
         *reg = (uint32_t)_byteswap_ushort(*(uint16_t*)ptr);
     }
     else
@@ -158,7 +178,7 @@ void MIWriteHalf(uint32_t pa, uint32_t data)
 {
     uint8_t* ptr;
 
-    if (mi.ram == nullptr)
+    if (mi->ram == nullptr)
     {
         return;
     }
@@ -171,7 +191,8 @@ void MIWriteHalf(uint32_t pa, uint32_t data)
     // hardware trap
     if (pa >= HW_BASE)
     {
-        hw_write16[pa & 0xfffe](pa, data);
+        MICountMmio(pa);
+        mi->hw_write16[pa & 0xfffe](pa, data);
         return;
     }
 
@@ -183,10 +204,11 @@ void MIWriteHalf(uint32_t pa, uint32_t data)
     }
 
     // bus store halfword
-    if (pa < mi.ramSize)
+    if (pa < mi->ramSize)
     {
-        ptr = &mi.ram[pa];
+        ptr = &mi->ram[pa];
         *(uint16_t*)ptr = _byteswap_ushort((uint16_t)data);
+        mi->dirty.Mark(pa, sizeof(uint16_t));
     }
 }
 
@@ -194,25 +216,25 @@ void MIReadWord(uint32_t pa, uint32_t* reg)
 {
     uint8_t* ptr;
 
-    if (mi.ram == nullptr)
+    if (mi->ram == nullptr)
     {
         *reg = 0;
         return;
     }
 
     // bus load word
-    if (pa < mi.ramSize)
+    if (pa < mi->ramSize)
     {
-        ptr = &mi.ram[pa];
+        ptr = &mi->ram[pa];
         *reg = _byteswap_ulong(*(uint32_t*)ptr);
         return;
     }
 
     if (pa >= BOOTROM_START_ADDRESS)
     {
-        if (mi.BootromPresent)
+        if (mi->BootromPresent)
         {
-            ptr = &mi.bootrom[pa - BOOTROM_START_ADDRESS];
+            ptr = &mi->bootrom[pa - BOOTROM_START_ADDRESS];
             *reg = _byteswap_ulong(*(uint32_t*)ptr);
         }
         else
@@ -225,7 +247,8 @@ void MIReadWord(uint32_t pa, uint32_t* reg)
     // hardware trap
     if (pa >= HW_BASE)
     {
-        hw_read32[pa & 0xfffc](pa, reg);
+        MICountMmio(pa);
+        mi->hw_read32[pa & 0xfffc](pa, reg);
         return;
     }
 
@@ -243,7 +266,7 @@ void MIWriteWord(uint32_t pa, uint32_t data)
 {
     uint8_t* ptr;
 
-    if (mi.ram == nullptr)
+    if (mi->ram == nullptr)
     {
         return;
     }
@@ -256,7 +279,8 @@ void MIWriteWord(uint32_t pa, uint32_t data)
     // hardware trap
     if (pa >= HW_BASE)
     {
-        hw_write32[pa & 0xfffc](pa, data);
+        MICountMmio(pa);
+        mi->hw_write32[pa & 0xfffc](pa, data);
         return;
     }
 
@@ -268,10 +292,11 @@ void MIWriteWord(uint32_t pa, uint32_t data)
     }
 
     // bus store word
-    if (pa < mi.ramSize)
+    if (pa < mi->ramSize)
     {
-        ptr = &mi.ram[pa];
+        ptr = &mi->ram[pa];
         *(uint32_t*)ptr = _byteswap_ulong(data);
+        mi->dirty.Mark(pa, sizeof(uint32_t));
     }
 }
 
@@ -287,13 +312,13 @@ void MIReadDouble(uint32_t pa, uint64_t* reg)
         assert(true);
     }
 
-    if (pa >= RAMSIZE || mi.ram == nullptr)
+    if (pa >= RAMSIZE || mi->ram == nullptr)
     {
         *reg = 0;
         return;
     }
 
-    uint8_t* buf = &mi.ram[pa];
+    uint8_t* buf = &mi->ram[pa];
 
     // bus load doubleword
     *reg = _byteswap_uint64(*(uint64_t*)buf);
@@ -306,15 +331,16 @@ void MIWriteDouble(uint32_t pa, uint64_t* data)
         return;
     }
 
-    if (pa >= RAMSIZE || mi.ram == nullptr)
+    if (pa >= RAMSIZE || mi->ram == nullptr)
     {
         return;
     }
 
-    uint8_t* buf = &mi.ram[pa];
+    uint8_t* buf = &mi->ram[pa];
 
     // bus store doubleword
     *(uint64_t*)buf = _byteswap_uint64 (*data);
+    mi->dirty.Mark(pa, sizeof(uint64_t));
 }
 
 void MIReadBurst(uint32_t phys_addr, uint8_t burstData[32])
@@ -322,7 +348,7 @@ void MIReadBurst(uint32_t phys_addr, uint8_t burstData[32])
     if ((phys_addr + 32) > RAMSIZE)
         return;
 
-    memcpy(burstData, &mi.ram[phys_addr], 32);
+    memcpy(burstData, &mi->ram[phys_addr], 32);
 }
 
 void MIWriteBurst(uint32_t phys_addr, uint8_t burstData[32])
@@ -336,7 +362,8 @@ void MIWriteBurst(uint32_t phys_addr, uint8_t burstData[32])
     if ((phys_addr + 32) > RAMSIZE)
         return;
 
-    memcpy(&mi.ram[phys_addr], burstData, 32);
+    memcpy(&mi->ram[phys_addr], burstData, 32);
+    mi->dirty.Mark(phys_addr);
 }
 
 // ---------------------------------------------------------------------------
@@ -384,8 +411,8 @@ static void MISetTrap8(
     if (rdTrap == NULL) rdTrap = def_hw_read8;
     if (wrTrap == NULL) wrTrap = def_hw_write8;
 
-    hw_read8[addr & 0xffff] = rdTrap;
-    hw_write8[addr & 0xffff] = wrTrap;
+    mi->hw_read8[addr & 0xffff] = rdTrap;
+    mi->hw_write8[addr & 0xffff] = wrTrap;
 }
 
 static void MISetTrap16(
@@ -396,8 +423,8 @@ static void MISetTrap16(
     if (rdTrap == NULL) rdTrap = def_hw_read16;
     if (wrTrap == NULL) wrTrap = def_hw_write16;
 
-    hw_read16[addr & 0xfffe] = rdTrap;
-    hw_write16[addr & 0xfffe] = wrTrap;
+    mi->hw_read16[addr & 0xfffe] = rdTrap;
+    mi->hw_write16[addr & 0xfffe] = wrTrap;
 }
 
 static void MISetTrap32(
@@ -408,8 +435,8 @@ static void MISetTrap32(
     if (rdTrap == NULL) rdTrap = def_hw_read32;
     if (wrTrap == NULL) wrTrap = def_hw_write32;
 
-    hw_read32[addr & 0xfffc] = rdTrap;
-    hw_write32[addr & 0xfffc] = wrTrap;
+    mi->hw_read32[addr & 0xfffc] = rdTrap;
+    mi->hw_write32[addr & 0xfffc] = wrTrap;
 }
 
 // wrapper
@@ -485,8 +512,8 @@ static void MIClearTraps()
 
 void LoadBootrom(HWConfig* config)
 {
-    mi.BootromPresent = false;
-    mi.bootromSize = BOOTROM_SIZE;
+    mi->BootromPresent = false;
+    mi->bootromSize = BOOTROM_SIZE;
 
     // Load bootrom image
 
@@ -503,12 +530,12 @@ void LoadBootrom(HWConfig* config)
         return;
     }
 
-    mi.bootrom = bootrom.data();
+    mi->bootrom = bootrom.data();
 
-    if (bootrom.size() != mi.bootromSize)
+    if (bootrom.size() != mi->bootromSize)
     {
-        free(mi.bootrom);
-        mi.bootrom = nullptr;
+        free(mi->bootrom);
+        mi->bootrom = nullptr;
         return;
     }
 
@@ -518,12 +545,12 @@ void LoadBootrom(HWConfig* config)
     uint8_t zeroStride[strideSize] = { 0 };
 
     size_t beginOffset = 0x100;
-    size_t endOffset = mi.bootromSize - strideSize;
+    size_t endOffset = mi->bootromSize - strideSize;
     size_t offset = beginOffset;
 
     while (offset < endOffset)
     {
-        if (!memcmp(&mi.bootrom[offset], zeroStride, sizeof(zeroStride)))
+        if (!memcmp(&mi->bootrom[offset], zeroStride, sizeof(zeroStride)))
         {
             break;
         }
@@ -535,20 +562,20 @@ void LoadBootrom(HWConfig* config)
     {
         // Empty cacheline not found, something wrong with the image
 
-        free(mi.bootrom);
-        mi.bootrom = nullptr;
+        free(mi->bootrom);
+        mi->bootrom = nullptr;
         return;
     }
 
     // Descramble
 
-    IPLDescrambler(&mi.bootrom[beginOffset], (offset - beginOffset));
-    mi.BootromPresent = true;
+    IPLDescrambler(&mi->bootrom[beginOffset], (offset - beginOffset));
+    mi->BootromPresent = true;
 
     // Show version
 
     DBReport2(DbgChannel::MI, "Loaded and descrambled valid Bootrom\n");
-    DBReport("%s", (char*)mi.bootrom);
+    DBReport("%s", (char*)mi->bootrom);
 }
 
 void MIOpen(HWConfig * config)
@@ -562,11 +589,12 @@ void MIOpen(HWConfig * config)
     // clear all traps
     MIClearTraps();
 
-    mi.ramSize = config->ramsize;
-    mi.ram = (uint8_t *)malloc(mi.ramSize);
-    assert(mi.ram);
+    mi->ramSize = config->ramsize;
+    mi->ram = (uint8_t *)malloc(mi->ramSize);
+    assert(mi->ram);
 
-    memset(mi.ram, 0, mi.ramSize);
+    memset(mi->ram, 0, mi->ramSize);
+    mi->dirty.Resize(mi->ramSize);
 
     for(uint32_t ofs=0; ofs<=0x28; ofs+=2)
     {
@@ -578,16 +606,16 @@ void MIOpen(HWConfig * config)
 
 void MIClose()
 {
-    if (mi.ram)
+    if (mi->ram)
     {
-        free(mi.ram);
-        mi.ram = nullptr;
+        free(mi->ram);
+        mi->ram = nullptr;
     }
 
-    if (mi.bootrom)
+    if (mi->bootrom)
     {
-        free(mi.bootrom);
-        mi.bootrom = nullptr;
+        free(mi->bootrom);
+        mi->bootrom = nullptr;
     }
 
     MIClearTraps();
@@ -595,12 +623,12 @@ void MIClose()
 
 uint8_t* MITranslatePhysicalAddress(uint32_t physAddr, size_t bytes)
 {
-    if (!mi.ram || bytes == 0)
+    if (!mi->ram || bytes == 0)
         return nullptr;
 
     if (physAddr < (RAMSIZE - bytes))
     {
-        return &mi.ram[physAddr];
+        return &mi->ram[physAddr];
     }
     
     return nullptr;
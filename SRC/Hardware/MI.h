@@ -75,9 +75,18 @@ struct MIControl
 
     bool    BootromPresent;     ///< loaded and descrambled valid bootrom
 
+    DirtyPages dirty;           ///< RAM pages written since the last snapshot
+
+    // hardware traps tables.
+    void (*hw_read8[0x10000])(uint32_t, uint32_t*);
+    void (*hw_write8[0x10000])(uint32_t, uint32_t);
+    void (*hw_read16[0x10000])(uint32_t, uint32_t*);
+    void (*hw_write16[0x10000])(uint32_t, uint32_t);
+    void (*hw_read32[0x10000])(uint32_t, uint32_t*);
+    void (*hw_write32[0x10000])(uint32_t, uint32_t);
 };
 
-extern	MIControl mi;
+extern	InstanceRef<MIControl, &Instance::mi> mi;
 
 void    MISetTrap(
     uint32_t type,                                       // 8, 16 or 32
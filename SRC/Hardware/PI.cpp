@@ -2,7 +2,7 @@
 #include "pch.h"
 
 // PI state (registers and other data)
-PIControl pi;
+InstanceRef<PIControl, &Instance::pi> pi;
 
 // ---------------------------------------------------------------------------
 // interrupts
@@ -46,16 +46,16 @@ static void printOut(uint32_t mask, const char *fix)
 // assert interrupt
 void PIAssertInt(uint32_t mask)
 {
-    pi.intsr |= mask;
-    if(pi.intmr & mask)
+    pi->intsr |= mask;
+    if(pi->intmr & mask)
     {
-        if (pi.log)
+        if (pi->log)
         {
             printOut(mask, "asserted");
         }
     }
 
-    if (pi.intsr & pi.intmr)
+    if (pi->intsr & pi->intmr)
     {
         Gekko::Gekko->AssertInterrupt();
     }
@@ -68,16 +68,16 @@ void PIAssertInt(uint32_t mask)
 // clear interrupt
 void PIClearInt(uint32_t mask)
 { 
-    if(pi.intsr & mask)
+    if(pi->intsr & mask)
     {
-        if (pi.log)
+        if (pi->log)
         {
             printOut(mask, "cleared");
         }
     }
-    pi.intsr &= ~mask;
+    pi->intsr &= ~mask;
 
-    if (pi.intsr & pi.intmr)
+    if (pi->intsr & pi->intmr)
     {
         Gekko::Gekko->AssertInterrupt();
     }
@@ -92,7 +92,7 @@ void PIClearInt(uint32_t mask)
 
 static void read_intsr(uint32_t addr, uint32_t *reg)
 {
-    *reg = pi.intsr | ((pi.rswhack & 1) << 16);
+    *reg = pi->intsr | ((pi->rswhack & 1) << 16);
 }
 
 // writes turns them off ?
@@ -103,20 +103,20 @@ static void write_intsr(uint32_t addr, uint32_t data)
 
 static void read_intmr(uint32_t addr, uint32_t *reg)
 {
-    *reg = pi.intmr;
+    *reg = pi->intmr;
 }
 
 static void write_intmr(uint32_t addr, uint32_t data)
 {
-    pi.intmr = data;
+    pi->intmr = data;
 
     // print out list of masked interrupts
-    if(pi.intmr && pi.log)
+    if(pi->intmr && pi->log)
     {
         char buf[256], *p = buf;
         for(uint32_t m=1; m<=PI_INTERRUPT_HSP; m<<=1)
         {
-            if(pi.intmr & m) p += sprintf_s(p, sizeof(buf) - (p-buf), "%s ", intdesc(m));
+            if(pi->intmr & m) p += sprintf_s(p, sizeof(buf) - (p-buf), "%s ", intdesc(m));
         }
         *p = 0;
 
@@ -130,7 +130,7 @@ static void write_intmr(uint32_t addr, uint32_t data)
 
 static void read_mbrev(uint32_t addr, uint32_t *reg)
 {
-    uint32_t ver = pi.consoleVer;
+    uint32_t ver = pi->consoleVer;
 
     // bootrom using this register in following way :
     //
@@ -167,21 +167,21 @@ static void read_reset(uint32_t addr, uint32_t *reg)
 // PI fifo (CPU)
 //
 
-static void read_pi_base(uint32_t addr, uint32_t *reg)   { *reg = pi.base & ~0x1f; }
-static void write_pi_base(uint32_t addr, uint32_t data)  { pi.base = data & ~0x1f; }
-static void read_pi_top(uint32_t addr, uint32_t *reg)    { *reg = pi.top & ~0x1f; }
-static void write_pi_top(uint32_t addr, uint32_t data)   { pi.top = data & ~0x1f; }
-static void read_pi_wrptr(uint32_t addr, uint32_t *reg)  { *reg = pi.wrptr & ~0x1f; }
-static void write_pi_wrptr(uint32_t addr, uint32_t data) { pi.wrptr = data & ~0x1f; }
+static void read_pi_base(uint32_t addr, uint32_t *reg)   { *reg = pi->base & ~0x1f; }
+static void write_pi_base(uint32_t addr, uint32_t data)  { pi->base = data & ~0x1f; }
+static void read_pi_top(uint32_t addr, uint32_t *reg)    { *reg = pi->top & ~0x1f; }
+static void write_pi_top(uint32_t addr, uint32_t data)   { pi->top = data & ~0x1f; }
+static void read_pi_wrptr(uint32_t addr, uint32_t *reg)  { *reg = pi->wrptr & ~0x1f; }
+static void write_pi_wrptr(uint32_t addr, uint32_t data) { pi->wrptr = data & ~0x1f; }
 
 // show PI fifo configuration
 void DumpPIFIFO()
 {
     DBReport("PI fifo configuration");
-    DBReport("   base :0x%08X", pi.base);
-    DBReport("   top  :0x%08X", pi.top);
-    DBReport("   wrptr:0x%08X", pi.wrptr);
-    DBReport("   wrap :%i", (pi.wrptr & PI_WRPTR_WRAP) ? (1) : (0));
+    DBReport("   base :0x%08X", pi->base);
+    DBReport("   top  :0x%08X", pi->top);
+    DBReport("   wrptr:0x%08X", pi->wrptr);
+    DBReport("   wrap :%i", (pi->wrptr & PI_WRPTR_WRAP) ? (1) : (0));
 }
 
 // ---------------------------------------------------------------------------
@@ -191,12 +191,12 @@ void PIOpen(HWConfig* config)
 {
     DBReport2(DbgChannel::PI, "Processor interface (interrupts)\n");
 
-    pi.rswhack = config->rswhack;
-    pi.consoleVer = config->consoleVer;
-    pi.log = false;
+    pi->rswhack = config->rswhack;
+    pi->consoleVer = config->consoleVer;
+    pi->log = false;
 
     // clear interrupt registers
-    pi.intsr = pi.intmr = 0;
+    pi->intsr = pi->intmr = 0;
 
     // set interrupt registers hooks
     MISetTrap(32, PI_INTSR   , read_intsr, write_intsr);
@@ -210,3 +210,14 @@ void PIOpen(HWConfig* config)
     MISetTrap(32, PI_TOP  , read_pi_top  , write_pi_top);
     MISetTrap(32, PI_WRPTR, read_pi_wrptr, write_pi_wrptr);
 }
+
+void PIDoState(StateStream& state)
+{
+    state.BeginSection('PI  ', 1);
+    state.Do(pi->intsr);
+    state.Do(pi->intmr);
+    state.Do(pi->base);
+    state.Do(pi->top);
+    state.Do(pi->wrptr);
+    state.EndSection();
+}
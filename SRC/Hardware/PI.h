@@ -46,9 +46,10 @@ struct PIControl
     volatile uint32_t    wrptr;          // also WRAP bit
 };
 
-extern  PIControl pi;
+extern  InstanceRef<PIControl, &Instance::pi> pi;
 
 void    PIAssertInt(uint32_t mask);  // set interrupt(s)
 void    PIClearInt(uint32_t mask);   // clear interrupt(s)
 void    PIOpen(HWConfig * config);
 void    DumpPIFIFO();
+void    PIDoState(StateStream& state);
@@ -2,7 +2,7 @@
 #include "pch.h"
 
 // SI state (registers and other data)
-SIControl si;
+InstanceRef<SIControl, &Instance::si> si;
 
 // IMPORTANT : transfer will never be aborted by communication error, 
 // so all ERROR bits/status in SI regs are not used in emulator.
@@ -26,6 +26,19 @@ SIControl si;
 // Note : digital L and R are only set when its analog key is pressed all the way down;
 // Dolwin plugin is only supporting the fact, that L/R are pressed.
 
+// ---------------------------------------------------------------------------
+// PAD access (the pads are attached to the main instance, there are no controllers in a headless one)
+
+static long SIReadPad(long padnum, PADState* state)
+{
+    return si->headless ? 0 : PADReadButtons(padnum, state);
+}
+
+static long SISetRumble(long padnum, long cmd)
+{
+    return si->headless ? 0 : PADSetRumble(padnum, cmd);
+}
+
 // ---------------------------------------------------------------------------
 // dispatch command
 
@@ -101,72 +114,72 @@ static void SIClearInterrupt()
 
 static void si_wr_out0(uint32_t addr, uint32_t data)       // write
 {
-    si.shdw[0] = data;
+    si->shdw[0] = data;
     SI_SR_REG |= SI_SR_WRST0;
 
     // control motor
-    if(data == 0x00400000) PADSetRumble(0, PAD_MOTOR_STOP);
-    else if(data == 0x00400001) PADSetRumble(0, PAD_MOTOR_RUMBLE);
-    else if(data == 0x00400002) PADSetRumble(0, PAD_MOTOR_STOP_HARD);
+    if(data == 0x00400000) SISetRumble(0, PAD_MOTOR_STOP);
+    else if(data == 0x00400001) SISetRumble(0, PAD_MOTOR_RUMBLE);
+    else if(data == 0x00400002) SISetRumble(0, PAD_MOTOR_STOP_HARD);
 }
 
 static void si_rd_out0(uint32_t addr, uint32_t *reg)       // read
 {
-    *reg = si.out[0];
+    *reg = si->out[0];
 }
 
 /* ******* CHAN 1 ******* */
 
 static void si_wr_out1(uint32_t addr, uint32_t data)       // write
 {
-    si.shdw[1] = data;
+    si->shdw[1] = data;
     SI_SR_REG |= SI_SR_WRST1;
 
     // control motor
-    if(data == 0x00400000) PADSetRumble(1, PAD_MOTOR_STOP);
-    else if(data == 0x00400001) PADSetRumble(1, PAD_MOTOR_RUMBLE);
-    else if(data == 0x00400002) PADSetRumble(1, PAD_MOTOR_STOP_HARD);
+    if(data == 0x00400000) SISetRumble(1, PAD_MOTOR_STOP);
+    else if(data == 0x00400001) SISetRumble(1, PAD_MOTOR_RUMBLE);
+    else if(data == 0x00400002) SISetRumble(1, PAD_MOTOR_STOP_HARD);
 }
 
 static void si_rd_out1(uint32_t addr, uint32_t *reg)       // read
 {
-    *reg = si.out[1];
+    *reg = si->out[1];
 }
 
 /* ******* CHAN 2 ******* */
 
 static void si_wr_out2(uint32_t addr, uint32_t data)       // write
 {
-    si.shdw[2] = data;
+    si->shdw[2] = data;
     SI_SR_REG |= SI_SR_WRST2;
 
     // control motor
-    if(data == 0x00400000) PADSetRumble(2, PAD_MOTOR_STOP);
-    else if(data == 0x00400001) PADSetRumble(2, PAD_MOTOR_RUMBLE);
-    else if(data == 0x00400002) PADSetRumble(2, PAD_MOTOR_STOP_HARD);
+    if(data == 0x00400000) SISetRumble(2, PAD_MOTOR_STOP);
+    else if(data == 0x00400001) SISetRumble(2, PAD_MOTOR_RUMBLE);
+    else if(data == 0x00400002) SISetRumble(2, PAD_MOTOR_STOP_HARD);
 }
 
 static void si_rd_out2(uint32_t addr, uint32_t *reg)       // read
 {
-    *reg = si.out[2];
+    *reg = si->out[2];
 }
 
 /* ******* CHAN 3 ******* */
 
 static void si_wr_out3(uint32_t addr, uint32_t data)       // write
 {
-    si.shdw[3] = data;
+    si->shdw[3] = data;
     SI_SR_REG |= SI_SR_WRST3;
 
     // control motor
-    if(data == 0x00400000) PADSetRumble(3, PAD_MOTOR_STOP);
-    else if(data == 0x00400001) PADSetRumble(3, PAD_MOTOR_RUMBLE);
-    else if(data == 0x00400002) PADSetRumble(3, PAD_MOTOR_STOP_HARD);
+    if(data == 0x00400000) SISetRumble(3, PAD_MOTOR_STOP);
+    else if(data == 0x00400001) SISetRumble(3, PAD_MOTOR_RUMBLE);
+    else if(data == 0x00400002) SISetRumble(3, PAD_MOTOR_STOP_HARD);
 }
 
 static void si_rd_out3(uint32_t addr, uint32_t *reg)       // read
 {
-    *reg = si.out[3];
+    *reg = si->out[3];
 }
 
 //
@@ -181,9 +194,9 @@ static void si_inh0(uint32_t addr, uint32_t *reg)          // high
     uint32_t res;
 
     // return swapped joypad values
-    res  = (uint8_t)si.pad[0].stickY;
-    res |= (uint8_t)si.pad[0].stickX << 8;
-    res |= si.pad[0].button << 16;
+    res  = (uint8_t)si->pad[0].stickY;
+    res |= (uint8_t)si->pad[0].stickX << 8;
+    res |= si->pad[0].button << 16;
 
     // clear RDST mask and interrupt
     SI_SR_REG &= ~SI_SR_RDST0;
@@ -205,10 +218,10 @@ static void si_inl0(uint32_t addr, uint32_t *reg)          // low
     uint32_t res;
 
     // return swapped joypad values
-    res  = (uint8_t)si.pad[0].triggerRight;
-    res |= (uint8_t)si.pad[0].triggerLeft << 8;
-    res |= (uint8_t)si.pad[0].substickY << 16;
-    res |= (uint8_t)si.pad[0].substickX << 24;
+    res  = (uint8_t)si->pad[0].triggerRight;
+    res |= (uint8_t)si->pad[0].triggerLeft << 8;
+    res |= (uint8_t)si->pad[0].substickY << 16;
+    res |= (uint8_t)si->pad[0].substickX << 24;
 
     *reg = res;
 }
@@ -220,9 +233,9 @@ static void si_inh1(uint32_t addr, uint32_t *reg)          // high
     uint32_t res;
 
     // return swapped joypad values
-    res  = (uint8_t)si.pad[1].stickY;
-    res |= (uint8_t)si.pad[1].stickX << 8;
-    res |= si.pad[1].button << 16;
+    res  = (uint8_t)si->pad[1].stickY;
+    res |= (uint8_t)si->pad[1].stickX << 8;
+    res |= si->pad[1].button << 16;
 
     // clear RDST mask and interrupt
     SI_SR_REG &= ~SI_SR_RDST1;
@@ -244,10 +257,10 @@ static void si_inl1(uint32_t addr, uint32_t *reg)          // low
     uint32_t res;
 
     // return swapped joypad values
-    res  = (uint8_t)si.pad[1].triggerRight;
-    res |= (uint8_t)si.pad[1].triggerLeft << 8;
-    res |= (uint8_t)si.pad[1].substickY << 16;
-    res |= (uint8_t)si.pad[1].substickX << 24;
+    res  = (uint8_t)si->pad[1].triggerRight;
+    res |= (uint8_t)si->pad[1].triggerLeft << 8;
+    res |= (uint8_t)si->pad[1].substickY << 16;
+    res |= (uint8_t)si->pad[1].substickX << 24;
 
     *reg = res;
 }
@@ -259,9 +272,9 @@ static void si_inh2(uint32_t addr, uint32_t *reg)          // high
     uint32_t res;
 
     // return swapped joypad values
-    res  = (uint8_t)si.pad[2].stickY;
-    res |= (uint8_t)si.pad[2].stickX << 8;
-    res |= si.pad[2].button << 16;
+    res  = (uint8_t)si->pad[2].stickY;
+    res |= (uint8_t)si->pad[2].stickX << 8;
+    res |= si->pad[2].button << 16;
 
     // clear RDST mask and interrupt
     SI_SR_REG &= ~SI_SR_RDST2;
@@ -283,10 +296,10 @@ static void si_inl2(uint32_t addr, uint32_t *reg)          // low
     uint32_t res;
 
     // return swapped joypad values
-    res  = (uint8_t)si.pad[2].triggerRight;
-    res |= (uint8_t)si.pad[2].triggerLeft << 8;
-    res |= (uint8_t)si.pad[2].substickY << 16;
-    res |= (uint8_t)si.pad[2].substickX << 24;
+    res  = (uint8_t)si->pad[2].triggerRight;
+    res |= (uint8_t)si->pad[2].triggerLeft << 8;
+    res |= (uint8_t)si->pad[2].substickY << 16;
+    res |= (uint8_t)si->pad[2].substickX << 24;
 
     *reg = res;
 }
@@ -298,9 +311,9 @@ static void si_inh3(uint32_t addr, uint32_t *reg)          // high
     uint32_t res;
 
     // return swapped joypad values
-    res  = (uint8_t)si.pad[3].stickY;
-    res |= (uint8_t)si.pad[3].stickX << 8;
-    res |= si.pad[3].button << 16;
+    res  = (uint8_t)si->pad[3].stickY;
+    res |= (uint8_t)si->pad[3].stickX << 8;
+    res |= si->pad[3].button << 16;
 
     // clear RDST mask and interrupt
     SI_SR_REG &= ~SI_SR_RDST3;
@@ -322,10 +335,10 @@ static void si_inl3(uint32_t addr, uint32_t *reg)          // low
     uint32_t res;
 
     // return swapped joypad values
-    res  = (uint8_t)si.pad[3].triggerRight;
-    res |= (uint8_t)si.pad[3].triggerLeft << 8;
-    res |= (uint8_t)si.pad[3].substickY << 16;
-    res |= (uint8_t)si.pad[3].substickX << 24;
+    res  = (uint8_t)si->pad[3].triggerRight;
+    res |= (uint8_t)si->pad[3].triggerLeft << 8;
+    res |= (uint8_t)si->pad[3].substickY << 16;
+    res |= (uint8_t)si->pad[3].substickX << 24;
 
     *reg = res;
 }
@@ -339,10 +352,10 @@ static void write_sicom(uint32_t addr, uint32_t data)
     unsigned ofs = addr & 0x7f;
     uint8_t      *out = (uint8_t *)&data;
 
-    si.combuf[ofs+0] = out[3];
-    si.combuf[ofs+1] = out[2];
-    si.combuf[ofs+2] = out[1];
-    si.combuf[ofs+3] = out[0];
+    si->combuf[ofs+0] = out[3];
+    si->combuf[ofs+1] = out[2];
+    si->combuf[ofs+2] = out[1];
+    si->combuf[ofs+3] = out[0];
 }
 
 static void read_sicom(uint32_t addr, uint32_t *reg)
@@ -350,10 +363,10 @@ static void read_sicom(uint32_t addr, uint32_t *reg)
     unsigned ofs = addr & 0x7f;
     uint8_t      *in  = (uint8_t *)reg;
 
-    in[0] = si.combuf[ofs+3];
-    in[1] = si.combuf[ofs+2];
-    in[2] = si.combuf[ofs+1];
-    in[3] = si.combuf[ofs+0];
+    in[0] = si->combuf[ofs+3];
+    in[1] = si->combuf[ofs+2];
+    in[2] = si->combuf[ofs+1];
+    in[3] = si->combuf[ofs+0];
 }
 
 // ---------------------------------------------------------------------------
@@ -403,7 +416,7 @@ static void write_commcsr(uint32_t addr, uint32_t data)
         if(outlen == 0) outlen = 128;
 
         // make actual transfer
-        SICommand(chan, si.combuf);
+        SICommand(chan, si->combuf);
 
         // complete transfer
         SI_COMCSR_REG &= ~SI_COMCSR_TSTART;
@@ -433,13 +446,13 @@ static void write_sisr(uint32_t addr, uint32_t data)
     // copy shadow command registers
     if(data & SI_SR_WR)
     {
-        si.out[0] = si.shdw[0];
+        si->out[0] = si->shdw[0];
         SI_SR_REG &= ~SI_SR_WRST0;
-        si.out[1] = si.shdw[1];
+        si->out[1] = si->shdw[1];
         SI_SR_REG &= ~SI_SR_WRST1;
-        si.out[2] = si.shdw[2];
+        si->out[2] = si->shdw[2];
         SI_SR_REG &= ~SI_SR_WRST2;
-        si.out[3] = si.shdw[3];
+        si->out[3] = si->shdw[3];
         SI_SR_REG &= ~SI_SR_WRST3;
     }
 }
@@ -453,8 +466,8 @@ static void read_sisr(uint32_t addr, uint32_t *reg)
 // EXI clock lock reg (dummy)
 //
 
-static void write_exilk(uint32_t addr, uint32_t data) { si.exilk = data; }
-static void read_exilk(uint32_t addr, uint32_t *reg)  { *reg = si.exilk; }
+static void write_exilk(uint32_t addr, uint32_t data) { si->exilk = data; }
+static void read_exilk(uint32_t addr, uint32_t *reg)  { *reg = si->exilk; }
 
 //
 // stubs for fake mode
@@ -473,17 +486,17 @@ static void no_read(uint32_t addr, uint32_t *reg)
 void SIPoll()
 {
     int64_t ticks = Gekko::Gekko->GetTicks();
-    if (ticks < si.pollingTime)
+    if (ticks < si->pollingTime)
     {
         return;
     }
-    si.pollingTime = ticks + SI_POLLING_INTERVAL;
+    si->pollingTime = ticks + SI_POLLING_INTERVAL;
 
     if(SI_POLL_REG & SI_POLL_EN0)
     {
         // update pad input buffer
         bool connected = false;
-        connected = PADReadButtons(0, &si.pad[0]);
+        connected = SIReadPad(0, &si->pad[0]);
 
         // set RDST flag
         if(connected)
@@ -497,7 +510,7 @@ void SIPoll()
     {
         // update pad input buffer
         bool connected = false;
-        connected = PADReadButtons(1, &si.pad[1]);
+        connected = SIReadPad(1, &si->pad[1]);
 
         // set RDST flag
         if(connected)
@@ -511,7 +524,7 @@ void SIPoll()
     {
         // update pad input buffer
         bool connected = false;
-        connected = PADReadButtons(2, &si.pad[2]);
+        connected = SIReadPad(2, &si->pad[2]);
 
         // set RDST flag
         if(connected)
@@ -525,7 +538,7 @@ void SIPoll()
     {
         // update pad input buffer
         bool connected = false;
-        connected = PADReadButtons(3, &si.pad[3]);
+        connected = SIReadPad(3, &si->pad[3]);
 
         // set RDST flag
         if(connected)
@@ -546,21 +559,23 @@ void SIPoll()
 // ---------------------------------------------------------------------------
 // init
 
-void SIOpen()
+void SIOpen(HWConfig* config)
 {
     DBReport2(DbgChannel::SI, "Serial interface driver\n");
 
     // clear all registers
-    memset(&si, 0, sizeof(SIControl));
+    memset(si.Get(), 0, sizeof(SIControl));
+
+    si->headless = config->headless;
 
-    si.pollingTime = Gekko::Gekko->GetTicks() + SI_POLLING_INTERVAL;
+    si->pollingTime = Gekko::Gekko->GetTicks() + SI_POLLING_INTERVAL;
 
     // these values are actually written when IPL boots
     // meaning is unknown (some pad command) and no need to be known
-    si.out[0] = 
-    si.out[1] = 
-    si.out[2] = 
-    si.out[3] = 0x00400300; // continue polling ?
+    si->out[0] = 
+    si->out[1] = 
+    si->out[2] = 
+    si->out[3] = 0x00400300; // continue polling ?
 
     // enable polling (for homebrewn), IPL enabling it
     SI_POLL_REG |= (SI_POLL_EN0 | SI_POLL_EN1 | SI_POLL_EN2 | SI_POLL_EN3);
@@ -570,7 +585,7 @@ void SIOpen()
 
     // set rumble flags
     for(int i=0; i<4; i++)
-        si.rumble[i] = PADSetRumble(i, PAD_MOTOR_STOP);
+        si->rumble[i] = SISetRumble(i, PAD_MOTOR_STOP);
 
     // joypads in/out command buffer
     MISetTrap(32, SI_CHAN0_OUTBUF, si_rd_out0, si_wr_out0);
@@ -598,3 +613,18 @@ void SIOpen()
         MISetTrap(32, SI_COMBUF | ofs, read_sicom, write_sicom);
     }
 }
+
+// PAD state is polled from the host, so it is not saved
+void SIDoState(StateStream& state)
+{
+    state.BeginSection('SI  ', 1);
+    state.Do(si->out);
+    state.Do(si->shdw);
+    state.Do(si->poll);
+    state.Do(si->comcsr);
+    state.Do(si->sr);
+    state.Do(si->exilk);
+    state.Do(si->combuf);
+    state.Do(si->pollingTime);
+    state.EndSection();
+}
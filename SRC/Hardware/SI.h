@@ -23,9 +23,9 @@
 #define SI_EXILK            0x0C00643C      // EXI Clock Lock (unused)
 #define SI_COMBUF           0x0C006480      // Communication Buffer (128 bytes)
 
-#define SI_POLL_REG         si.poll
-#define SI_COMCSR_REG       si.comcsr
-#define SI_SR_REG           si.sr
+#define SI_POLL_REG         si->poll
+#define SI_COMCSR_REG       si->comcsr
+#define SI_SR_REG           si->sr
 
 // SI Poll Register mask
 #define SI_POLL_X(reg)          ((reg >>16) & 0x3ff)
@@ -94,10 +94,12 @@ struct SIControl
     bool                rumble[4];      // rumble support flags for every controller
                                         // filled when SI is inited, by checking PADSetRumble
     bool                log;            // do debugger log output
+    bool                headless;       // no pads (see Instance::headless)
     int64_t             pollingTime;    // Saved Gekko TBR for polling
 };
 
-extern  SIControl si;
+extern  InstanceRef<SIControl, &Instance::si> si;
 
 void    SIPoll();
-void    SIOpen();
+void    SIOpen(HWConfig* config);
+void    SIDoState(StateStream& state);
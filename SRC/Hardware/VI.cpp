@@ -47,7 +47,7 @@
 --------------------------------------------------------------------------- */
 
 // VI state (registers and other data)
-VIControl vi;
+InstanceRef<VIControl, &Instance::vi> vi;
 
 // ---------------------------------------------------------------------------
 // drawing of XFB
@@ -96,21 +96,21 @@ void YUVBlit(uint8_t *yuvbuf, RGBQUAD *dib)
 // reset VI timing
 static void vi_set_timing()
 {
-    uint16_t reg  = vi.disp_cr;
-    vi.inter = (reg & VI_CR_NIN) ? 0 : 1;
-    vi.mode  = VI_CR_FMT(reg);
-    if(vi.mode == 2) vi.mode = VI_NTSC_LIKE; // MPAL same as NTSC
-    vi.vtime = Gekko::Gekko->GetTicks();
+    uint16_t reg  = vi->disp_cr;
+    vi->inter = (reg & VI_CR_NIN) ? 0 : 1;
+    vi->mode  = VI_CR_FMT(reg);
+    if(vi->mode == 2) vi->mode = VI_NTSC_LIKE; // MPAL same as NTSC
+    vi->vtime = Gekko::Gekko->GetTicks();
 
-    switch(vi.mode)
+    switch(vi->mode)
     {
         case VI_NTSC_LIKE:
-            vi.one_frame = vi.one_second / 30;
-            vi.vcount = (vi.inter) ? VI_NTSC_INTER : VI_NTSC_NON_INTER;
+            vi->one_frame = vi->one_second / 30;
+            vi->vcount = (vi->inter) ? VI_NTSC_INTER : VI_NTSC_NON_INTER;
             break;
         case VI_PAL_LIKE:
-            vi.one_frame = vi.one_second / 25;
-            vi.vcount = (vi.inter) ? VI_PAL_INTER : VI_PAL_NON_INTER;
+            vi->one_frame = vi->one_second / 25;
+            vi->vcount = (vi->inter) ? VI_PAL_INTER : VI_PAL_NON_INTER;
             break;
     }
 }
@@ -118,26 +118,27 @@ static void vi_set_timing()
 // step line counter(s), update GUI and poll controller
 void VIUpdate()
 {
-    if((Gekko::Gekko->GetTicks() - vi.vtime) >= (vi.one_frame / vi.vcount))
+    if((Gekko::Gekko->GetTicks() - vi->vtime) >= (vi->one_frame / vi->vcount))
     {
-        vi.vtime = Gekko::Gekko->GetTicks();
+        vi->vtime = Gekko::Gekko->GetTicks();
 
-        uint32_t currentBeamPos = VI_POS_VCT(vi.pos);
-        uint32_t triggerBeamPos = VI_INT_VCT(vi.int0);
+        uint32_t currentBeamPos = VI_POS_VCT(vi->pos);
+        uint32_t triggerBeamPos = VI_INT_VCT(vi->int0);
 
         // generate VIINT ?
         currentBeamPos++;
         if(currentBeamPos == triggerBeamPos)
         {
-            vi.int0 |= VI_INT_INT;
-            if(vi.int0 & VI_INT_ENB)
+            vi->int0 |= VI_INT_INT;
+            if(vi->int0 & VI_INT_ENB)
             {
                 PIAssertInt(PI_INTERRUPT_VI);
             }
         }
 
         // vertical counter
-        if (currentBeamPos >= vi.vcount)
+        bool wrapped = currentBeamPos >= vi->vcount;
+        if (wrapped)
         {
             currentBeamPos = 1;
 
@@ -145,15 +146,22 @@ void VIUpdate()
             Debug::Hub.ExecuteFast("dop");
 
             // draw XFB
-            if (vi.xfb)
+            if (vi->xfb)
             {
-                YUVBlit(vi.xfbbuf, vi.gfxbuf);
-                vi.frames++;
+                YUVBlit(vi->xfbbuf, vi->gfxbuf);
+                vi->frames++;
             }
         }
 
-        vi.pos &= ~0x07ff0000;
-        vi.pos |= (currentBeamPos & 0x7ff) << 16;
+        vi->pos &= ~0x07ff0000;
+        vi->pos |= (currentBeamPos & 0x7ff) << 16;
+
+        // After the beam position is updated, so a snapshot taken by the hook has the VI state of the new frame
+        VIFrameHook hook = vi->frameHook;
+        if (hook && wrapped)
+        {
+            hook(vi->frameHookContext);
+        }
     }
 }
 
@@ -177,32 +185,32 @@ static void vi_read16(uint32_t addr, uint32_t *reg)
     switch(addr & 0x7f)
     {
         case 0x02:      // display control
-            *reg = vi.disp_cr & ~1;
-            *reg |= vi.videoEncoderFuse & 1;
+            *reg = vi->disp_cr & ~1;
+            *reg |= vi->videoEncoderFuse & 1;
             return;
         case 0x1C:      // video buffer hi (TOP)
-            *reg = vi.tfbl >> 16;
+            *reg = vi->tfbl >> 16;
             return;
         case 0x1E:      // video buffer low (TOP)
-            *reg = (uint16_t)vi.tfbl;
+            *reg = (uint16_t)vi->tfbl;
             return;
         case 0x24:      // video buffer hi (BOTTOM)
-            *reg = vi.bfbl >> 16;
+            *reg = vi->bfbl >> 16;
             return;
         case 0x26:      // video buffer low (BOTTOM)
-            *reg = (uint16_t)vi.bfbl;
+            *reg = (uint16_t)vi->bfbl;
             return;
         case 0x2C:      // beam position hi
-            *reg = vi.pos >> 16;
+            *reg = vi->pos >> 16;
             return;
         case 0x2E:      // beam position low
-            *reg = (uint16_t)vi.pos;
+            *reg = (uint16_t)vi->pos;
             return;
         case 0x30:      // int0 control hi
-            *reg = vi.int0 >> 16;
+            *reg = vi->int0 >> 16;
             return;
         case 0x32:      // int0 control low
-            *reg = (uint16_t)vi.int0;
+            *reg = (uint16_t)vi->int0;
             return;
     }
     *reg = 0;
@@ -213,72 +221,72 @@ static void vi_write16(uint32_t addr, uint32_t data)
     switch(addr & 0x7f)
     {
         case 0x02:      // display control
-            vi.disp_cr = (uint16_t)data;
+            vi->disp_cr = (uint16_t)data;
             vi_set_timing();
             return;
         case 0x1C:      // video buffer hi (TOP)
-            vi.tfbl &= 0x0000ffff;
-            vi.tfbl |= data << 16;
-            if (vi.log)
+            vi->tfbl &= 0x0000ffff;
+            vi->tfbl |= data << 16;
+            if (vi->log)
             {
-                DBReport2(DbgChannel::VI, "TFBL set to %08X (xof=%i)\n", vi.tfbl, (vi.tfbl >> 24) & 0xf);
+                DBReport2(DbgChannel::VI, "TFBL set to %08X (xof=%i)\n", vi->tfbl, (vi->tfbl >> 24) & 0xf);
             }
-            vi.tfbl &= 0xffffff;
-            if(vi.tfbl >= mi.ramSize) vi.xfbbuf = NULL;
-            else vi.xfbbuf = &mi.ram[vi.tfbl & RAMMASK];
+            vi->tfbl &= 0xffffff;
+            if(vi->tfbl >= mi->ramSize) vi->xfbbuf = NULL;
+            else vi->xfbbuf = &mi->ram[vi->tfbl & RAMMASK];
             return;
         case 0x1E:      // video buffer low (TOP)
-            vi.tfbl &= 0xffff0000;
-            vi.tfbl |= (uint16_t)data;
-            if (vi.log)
+            vi->tfbl &= 0xffff0000;
+            vi->tfbl |= (uint16_t)data;
+            if (vi->log)
             {
-                DBReport2(DbgChannel::VI, "TFBL set to %08X (xof=%i)\n", vi.tfbl, (vi.tfbl >> 24) & 0xf);
+                DBReport2(DbgChannel::VI, "TFBL set to %08X (xof=%i)\n", vi->tfbl, (vi->tfbl >> 24) & 0xf);
             }
-            vi.tfbl &= 0xffffff;
-            if(vi.tfbl >= mi.ramSize) vi.xfbbuf = NULL;
-            else vi.xfbbuf = &mi.ram[vi.tfbl & RAMMASK];
+            vi->tfbl &= 0xffffff;
+            if(vi->tfbl >= mi->ramSize) vi->xfbbuf = NULL;
+            else vi->xfbbuf = &mi->ram[vi->tfbl & RAMMASK];
             return;
         case 0x24:      // video buffer hi (BOTTOM)
-            vi.bfbl &= 0x0000ffff;
-            vi.bfbl |= data << 16;
-            vi.bfbl &= 0xffffff;
-            if (vi.log)
+            vi->bfbl &= 0x0000ffff;
+            vi->bfbl |= data << 16;
+            vi->bfbl &= 0xffffff;
+            if (vi->log)
             {
-                DBReport2(DbgChannel::VI, "BFBL set to %08X\n", vi.bfbl);
+                DBReport2(DbgChannel::VI, "BFBL set to %08X\n", vi->bfbl);
             }
             //if(vi.bfbl >= RAMSIZE) vi.xfbbuf = NULL;
             //else vi.xfbbuf = &RAM[vi.bfbl];
             return;
         case 0x26:      // video buffer low (BOTTOM)
-            vi.bfbl &= 0xffff0000;
-            vi.bfbl |= (uint16_t)data;
-            vi.bfbl &= 0xffffff;
-            if (vi.log)
+            vi->bfbl &= 0xffff0000;
+            vi->bfbl |= (uint16_t)data;
+            vi->bfbl &= 0xffffff;
+            if (vi->log)
             {
-                DBReport2(DbgChannel::VI, "BFBL set to %08X\n", vi.bfbl);
+                DBReport2(DbgChannel::VI, "BFBL set to %08X\n", vi->bfbl);
             }
             //if(vi.bfbl >= RAMSIZE) vi.xfbbuf = NULL;
             //else vi.xfbbuf = &RAM[vi.bfbl];
             return;
         case 0x2C:      // beam position hi
-            vi.pos &= 0x0000ffff;
-            vi.pos |= data << 16;
+            vi->pos &= 0x0000ffff;
+            vi->pos |= data << 16;
             return;
         case 0x2E:      // beam position low
-            vi.pos &= 0xffff0000;
-            vi.pos |= (uint16_t)data;
+            vi->pos &= 0xffff0000;
+            vi->pos |= (uint16_t)data;
             return;
         case 0x30:      // int0 control hi
-            vi.int0 &= 0x0000ffff;
-            vi.int0 |= data << 16;
-            if((vi.int0 & VI_INT_INT) == 0)
+            vi->int0 &= 0x0000ffff;
+            vi->int0 |= data << 16;
+            if((vi->int0 & VI_INT_INT) == 0)
             {
                 PIClearInt(PI_INTERRUPT_VI);
             }
             return;
         case 0x32:      // int0 control low
-            vi.int0 &= 0xffff0000;
-            vi.int0 |= (uint16_t)data;
+            vi->int0 &= 0xffff0000;
+            vi->int0 |= (uint16_t)data;
             return;
     }
 }
@@ -288,20 +296,20 @@ static void vi_read32(uint32_t addr, uint32_t *reg)
     switch(addr & 0x7f)
     {
         case 0x00:      // display control
-            *reg = (uint32_t)(vi.disp_cr & ~1);
-            *reg |= vi.videoEncoderFuse & 1;
+            *reg = (uint32_t)(vi->disp_cr & ~1);
+            *reg |= vi->videoEncoderFuse & 1;
             return;
         case 0x1C:      // video buffer (TOP)
-            *reg = vi.tfbl;
+            *reg = vi->tfbl;
             return;
         case 0x24:      // video buffer (BOTTOM)
-            *reg = vi.bfbl;
+            *reg = vi->bfbl;
             return;
         case 0x2C:      // beam position
-            *reg = vi.pos;
+            *reg = vi->pos;
             return;
         case 0x30:      // int0 control
-            *reg = vi.int0;
+            *reg = vi->int0;
             return;
     }
     *reg = 0;
@@ -312,33 +320,33 @@ static void vi_write32(uint32_t addr, uint32_t data)
     switch(addr & 0x7f)
     {
         case 0x00:      // display control
-            vi.disp_cr = (uint16_t)data;
+            vi->disp_cr = (uint16_t)data;
             vi_set_timing();
             return;
         case 0x1C:      // video buffer (TOP)
-            vi.tfbl = data & 0xffffff;
-            if (vi.log)
+            vi->tfbl = data & 0xffffff;
+            if (vi->log)
             {
-                DBReport2(DbgChannel::VI, "TFBL set to %08X (xof=%i)\n", vi.tfbl, (data >> 24) & 0xf);
+                DBReport2(DbgChannel::VI, "TFBL set to %08X (xof=%i)\n", vi->tfbl, (data >> 24) & 0xf);
             }
-            if(vi.tfbl >= mi.ramSize) vi.xfbbuf = NULL;
-            else vi.xfbbuf = &mi.ram[vi.tfbl & RAMMASK];
+            if(vi->tfbl >= mi->ramSize) vi->xfbbuf = NULL;
+            else vi->xfbbuf = &mi->ram[vi->tfbl & RAMMASK];
             return;
         case 0x24:      // video buffer (BOTTOM)
-            vi.bfbl = data & 0xffffff;
-            if (vi.log)
+            vi->bfbl = data & 0xffffff;
+            if (vi->log)
             {
-                DBReport2(DbgChannel::VI, "BFBL set to %08X\n", vi.bfbl);
+                DBReport2(DbgChannel::VI, "BFBL set to %08X\n", vi->bfbl);
             }
             //if(vi.bfbl >= RAMSIZE) vi.xfbbuf = NULL;
             //else vi.xfbbuf = &RAM[vi.bfbl];
             return;
         case 0x2C:      // beam position
-            vi.pos = data;
+            vi->pos = data;
             return;
         case 0x30:      // int0 control
-            vi.int0 = data;
-            if((vi.int0 & VI_INT_INT) == 0)
+            vi->int0 = data;
+            if((vi->int0 & VI_INT_INT) == 0)
             {
                 PIClearInt(PI_INTERRUPT_VI);
             }
@@ -349,13 +357,13 @@ static void vi_write32(uint32_t addr, uint32_t data)
 // show VI info
 void VIStats()
 {
-    uint32_t currentBeamPos = VI_POS_VCT(vi.pos);
-    uint32_t triggerBeamPos = VI_INT_VCT(vi.int0);
+    uint32_t currentBeamPos = VI_POS_VCT(vi->pos);
+    uint32_t triggerBeamPos = VI_INT_VCT(vi->int0);
 
-    DBReport( "    VI interrupt : [%i x x x]\n", vi.int0 >> 31);
-    DBReport( "    VI int mask  : [%i x x x]\n", (vi.int0 >> 28) & 1);
+    DBReport( "    VI interrupt : [%i x x x]\n", vi->int0 >> 31);
+    DBReport( "    VI int mask  : [%i x x x]\n", (vi->int0 >> 28) & 1);
     DBReport( "    VI int pos   : %i == %i, x == x, x == x, x == x (line)\n", currentBeamPos, triggerBeamPos);
-    DBReport( "    VI XFB       : T%08X B%08X (phys), enabled: %i\n", vi.tfbl, vi.bfbl, vi.xfb);
+    DBReport( "    VI XFB       : T%08X B%08X (phys), enabled: %i\n", vi->tfbl, vi->bfbl, vi->xfb);
 }
 
 // ---------------------------------------------------------------------------
@@ -365,32 +373,37 @@ void VIOpen(HWConfig * config)
 {
     DBReport2(DbgChannel::VI, "Video-out hardware interface\n");
 
-    // clear VI regs
-    memset(&vi, 0, sizeof(VIControl));
+    // clear VI regs, the frame hook is kept
+    VIFrameHook frameHook = vi->frameHook;
+    void* frameHookContext = vi->frameHookContext;
+    memset(vi.Get(), 0, sizeof(VIControl));
+    vi->frameHook = frameHook;
+    vi->frameHookContext = frameHookContext;
 
-    vi.hwndMain = config->hwndMain;
-    vi.one_second = Gekko::Gekko->OneSecond();
+    vi->hwndMain = config->hwndMain;
+    vi->headless = config->headless;
+    vi->one_second = Gekko::Gekko->OneSecond();
 
     // read VI settings
-    vi.log = config->vi_log;
-    vi.xfb = config->vi_xfb;
-    vi.videoEncoderFuse = config->videoEncoderFuse;
+    vi->log = config->vi_log;
+    vi->xfb = config->vi_xfb && !vi->headless;
+    vi->videoEncoderFuse = config->videoEncoderFuse;
 
     // reset VI timing
     vi_set_timing();
 
     // XFB is not yet specified
-    vi.gfxbuf = NULL;
-    vi.xfbbuf = NULL;
+    vi->gfxbuf = NULL;
+    vi->xfbbuf = NULL;
 
     // open GDI (if need)
-    if(vi.xfb)
+    if(vi->xfb)
     {
-        bool res = GDIOpen(vi.hwndMain, 640, 480, &vi.gfxbuf);
+        bool res = GDIOpen(vi->hwndMain, 640, 480, &vi->gfxbuf);
         if(!res)
         {
             UI::DolwinReport(_T("VI cant startup GDI"));
-            vi.xfb = false;
+            vi->xfb = false;
         }
     }
 
@@ -408,10 +421,43 @@ void VIClose()
     // XFB can be enabled during emulation,
     // so we must be sure, that GDI is closed
     // even if XFB wasn't enabled, before start
-    GDIClose(vi.hwndMain);
+    if (!vi->headless)
+    {
+        GDIClose(vi->hwndMain);
+    }
 }
 
 void VISetEncoderFuse(int value)
 {
-    vi.videoEncoderFuse = value;
+    vi->videoEncoderFuse = value;
+}
+
+void VISetFrameHook(VIFrameHook hook, void* context)
+{
+    vi->frameHookContext = context;
+    vi->frameHook = hook;
+}
+
+void VIDoState(StateStream& state)
+{
+    state.BeginSection('VI  ', 1);
+    state.Do(vi->disp_cr);
+    state.Do(vi->tfbl);
+    state.Do(vi->bfbl);
+    state.Do(vi->pos);
+    state.Do(vi->int0);
+    state.Do(vi->mode);
+    state.Do(vi->inter);
+    state.Do(vi->vcount);
+    state.Do(vi->vtime);
+    state.Do(vi->one_frame);
+    state.Do(vi->frames);
+    state.EndSection();
+
+    // XFB pointer is translated from TFBL, same as by the register write
+    if (state.IsLoading())
+    {
+        if(vi->tfbl >= mi->ramSize) vi->xfbbuf = NULL;
+        else vi->xfbbuf = &mi->ram[vi->tfbl & RAMMASK];
+    }
 }
@@ -74,6 +74,8 @@
 // ---------------------------------------------------------------------------
 // hardware API
 
+typedef void (*VIFrameHook)(void* context);
+
 // VI state (registers and other data)
 struct VIControl
 {
@@ -100,9 +102,13 @@ struct VIControl
     int64_t     one_second;     // one CPU second in timer ticks
 
     int         videoEncoderFuse;
+    bool        headless;       // no GDI output (see Instance::headless)
+
+    VIFrameHook frameHook;      // kept by VIOpen
+    void*       frameHookContext;
 };
 
-extern  VIControl vi;
+extern  InstanceRef<VIControl, &Instance::vi> vi;
 
 void    VIUpdate();
 void    VIStats();
@@ -110,3 +116,7 @@ void    VIOpen(HWConfig* config);
 void    VIClose();
 
 void    VISetEncoderFuse(int value);
+
+// Called by the HW thread when the vertical counter wraps (once per frame). Pass nullptr to remove the hook.
+void    VISetFrameHook(VIFrameHook hook, void* context);
+void    VIDoState(StateStream& state);
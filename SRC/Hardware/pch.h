@@ -12,11 +12,14 @@
 #include <codecvt>
 #include <sys/stat.h>
 #include <algorithm>
+#include <chrono>
+#include <thread>
 #include <Windows.h>
 
 #include "../Common/Spinlock.h"
 #include "../Common/Jdi.h"
 #include "../Common/String.h"
+#include "../Common/PerfCounters.h"
 
 #include "Hardware.h"
 #include "HwCommands.h"
@@ -33,4 +36,7 @@
 #include "../HighLevel/TimeFormat.h"
 
 #include "AX.h"
+#ifdef _WINDOWS
+#include "AXDirectSound.h"
+#endif
 #include "FIFO.h"
@@ -38,7 +38,7 @@ static void ReadFST()
 
     // load FST into memory
     DVD::Seek(fstOffs);
-    DVD::Read(&mi.ram[ArenaHi & RAMMASK], fstSize);
+    DVD::Read(&mi->ram[ArenaHi & RAMMASK], fstSize);
 
     // save fst configuration in lomem
     Gekko::Gekko->WriteWord(0x80000038, ArenaHi);
@@ -79,7 +79,7 @@ static void BootApploader()
 
     // load apploader image
     DVD::Seek(0x2460);
-    DVD::Read(&mi.ram[0x81200000 & RAMMASK], appSize);
+    DVD::Read(&mi->ram[0x81200000 & RAMMASK], appSize);
 
     // set parameters for apploader entrypoint
     Gekko::Gekko->regs.gpr[3] = 0x81300004;            // save apploader _prolog offset
@@ -133,7 +133,7 @@ static void BootApploader()
         if(size)
         {
             DVD::Seek(offs);
-            DVD::Read(&mi.ram[addr & RAMMASK], size);
+            DVD::Read(&mi->ram[addr & RAMMASK], size);
 
             DBReport2(DbgChannel::HLE, "apploader read : offs : %08X size : %08X addr : %08X\n",
                       offs, size, addr );
@@ -166,9 +166,9 @@ static void __SyncTime(bool rtc)
 
     DBReport2(DbgChannel::HLE, "updating timer value..\n");
 
-    int32_t counterBias = (int32_t)_byteswap_ulong(exi.sram.counterBias);
-    int32_t rtcValue = exi.rtcVal + counterBias;
-    DBReport2(DbgChannel::HLE, "counter bias: %i, real-time clock: %i\n", counterBias, exi.rtcVal);
+    int32_t counterBias = (int32_t)_byteswap_ulong(exi->sram.counterBias);
+    int32_t rtcValue = exi->rtcVal + counterBias;
+    DBReport2(DbgChannel::HLE, "counter bias: %i, real-time clock: %i\n", counterBias, exi->rtcVal);
 
     int64_t newTime = (int64_t)rtcValue * CPU_TIMER_CLOCK;
     int64_t systemTime;
@@ -223,7 +223,7 @@ void BootROM(bool dvd, bool rtc, uint32_t consoleVer)
 
     // install default syscall. not important for Dolphin OS,
     // but should be installed to avoid crash on SC opcode.
-    memcpy( &mi.ram[(int)Gekko::Exception::SYSCALL],
+    memcpy( &mi->ram[(int)Gekko::Exception::SYSCALL],
             default_syscall, 
             sizeof(default_syscall) );
 
@@ -236,10 +236,10 @@ void BootROM(bool dvd, bool rtc, uint32_t consoleVer)
     {
         // read disk ID information to 0x80000000
         DVD::Seek(0);
-        DVD::Read(mi.ram, 32);
+        DVD::Read(mi->ram, 32);
 
         // additional PAL/NTSC selection hack for old VIConfigure()
-        char *id = (char *)mi.ram;
+        char *id = (char *)mi->ram;
         if(id[3] == 'P') Gekko::Gekko->WriteWord(0x800000CC, 1);   // set to PAL
         else Gekko::Gekko->WriteWord(0x800000CC, 0);
 
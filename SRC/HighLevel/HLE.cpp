@@ -1,7 +1,7 @@
 // high level initialization code
 #include "pch.h"
 
-HLEControl hle;
+InstanceRef<HLEControl, &Instance::hle> hle;
 
 // ---------------------------------------------------------------------------
 
@@ -45,58 +45,229 @@ static const char *ostraps[] = {
 };
 
 // HLE Calls
+// The native replacements, which are not exact (or not checked enough) are disabled by default. They can be enabled by HleEnable command.
 static struct OSCalls
 {
-    char    *name;
+    const char  *name;
     void    (*call)();
+    bool    enabled;
 } oscalls[] = {
 
-/*/
-
     // Interrupt handling
-    { "OSDisableInterrupts"     , OSDisableInterrupts       },
-    { "OSEnableInterrupts"      , OSEnableInterrupts        },
-    { "OSRestoreInterrupts"     , OSRestoreInterrupts       },
+    { "OSDisableInterrupts"     , OSDisableInterrupts       , false },
+    { "OSEnableInterrupts"      , OSEnableInterrupts        , false },
+    { "OSRestoreInterrupts"     , OSRestoreInterrupts       , false },
 
     // Context API
     // its working, but we need better recognition for OSLoadContext
     // minimal set: OSSaveContext, OSLoadContext, __OSContextInit.
-    { "OSSetCurrentContext"     , OSSetCurrentContext       },
-    { "OSGetCurrentContext"     , OSGetCurrentContext       },
-    { "OSSaveContext"           , OSSaveContext             },
-    //{ "OSLoadContext"           , OSLoadContext             },
-    { "OSClearContext"          , OSClearContext            },
-    { "OSInitContext"           , OSInitContext             },
-    { "OSLoadFPUContext"        , OSLoadFPUContext          },
-    { "OSSaveFPUContext"        , OSSaveFPUContext          },
-    { "OSFillFPUContext"        , OSFillFPUContext          },
-    { "__OSContextInit"         , __OSContextInit           },
+    { "OSSetCurrentContext"     , OSSetCurrentContext       , false },
+    { "OSGetCurrentContext"     , OSGetCurrentContext       , false },
+    { "OSSaveContext"           , OSSaveContext             , false },
+    { "OSLoadContext"           , OSLoadContext             , false },
+    { "OSClearContext"          , OSClearContext            , false },
+    { "OSInitContext"           , OSInitContext             , false },
+    { "OSLoadFPUContext"        , OSLoadFPUContext          , false },
+    { "OSSaveFPUContext"        , OSSaveFPUContext          , false },
+    { "OSFillFPUContext"        , OSFillFPUContext          , false },
+    { "__OSContextInit"         , __OSContextInit           , false },
 
     // Std C
-    { "memset"                  , HLE_memset                },
-    { "memcpy"                  , HLE_memcpy                },
-
-    { "cos"                     , HLE_cos                   },
-    { "sin"                     , HLE_sin                   },
-    { "modf"                    , HLE_modf                  },
-    { "frexp"                   , HLE_frexp                 },
-    { "ldexp"                   , HLE_ldexp                 },
-    { "floor"                   , HLE_floor                 },
-    { "ceil"                    , HLE_ceil                  },
-/*/
+    { "memset"                  , HLE_memset                , true  },
+    { "memcpy"                  , HLE_memcpy                , true  },
+
+    { "cos"                     , HLE_cos                   , false },
+    { "sin"                     , HLE_sin                   , false },
+    { "modf"                    , HLE_modf                  , false },
+    { "frexp"                   , HLE_frexp                 , false },
+    { "ldexp"                   , HLE_ldexp                 , false },
+    { "floor"                   , HLE_floor                 , false },
+    { "ceil"                    , HLE_ceil                  , false },
 
     // Terminator
-    { NULL                      , NULL                      }
+    { NULL                      , NULL                      , false }
 };
 
 // ---------------------------------------------------------------------------
 
-// wrapper
-void HLESetCall(const char * name, void (*call)())
+// Patch the entry point of the function. The patch is applied or removed only when Gekko is suspended or at a safe point.
+static void HLEApply(HLEPatch& patch)
+{
+    if (patch.address != 0 || !patch.enabled)
+        return;
+
+    uint32_t address = SYMAddress(patch.name.c_str());
+    if (address == 0)
+        return;
+
+    // if first opcode is 'BLR', then just leave it
+    uint32_t original[2];
+    Gekko::Gekko->ReadWord(address, &original[0]);
+    if (original[0] == 0x4e800020)
+        return;
+    Gekko::Gekko->ReadWord(address + 4, &original[1]);
+
+    // 000: high-level opcode. The patch keeps its opcode (and calls counter) when it is switched off and on.
+    if (patch.opcode == 0)
+    {
+        patch.opcode = Gekko::Gekko->AddHleCall(patch.call);
+    }
+    patch.original[0] = original[0];
+    patch.original[1] = original[1];
+    patch.address = address;
+
+    Gekko::Gekko->WriteWord(address, patch.opcode);
+
+    // return to caller
+    if (patch.name == "OSLoadContext")
+    {
+        Gekko::Gekko->WriteWord(address + 4, 0x4c000064);   // rfi
+    }
+    else
+    {
+        Gekko::Gekko->WriteWord(address + 4, 0x4e800020);   // blr
+    }
+
+    Gekko::Gekko->InvalidateCode(address, 8);
+
+    DBReport2(DbgChannel::HLE, "patched API call: %08X %s\n", address, patch.name.c_str());
+}
+
+// Put the original instructions back, if the program did not load other code over the patch meanwhile.
+static void HLERestore(HLEPatch& patch)
+{
+    if (patch.address == 0)
+        return;
+
+    uint32_t op;
+    Gekko::Gekko->ReadWord(patch.address, &op);
+    if (op == patch.opcode)
+    {
+        Gekko::Gekko->WriteWord(patch.address, patch.original[0]);
+        Gekko::Gekko->WriteWord(patch.address + 4, patch.original[1]);
+        Gekko::Gekko->InvalidateCode(patch.address, 8);
+
+        DBReport2(DbgChannel::HLE, "restored API call: %08X %s\n", patch.address, patch.name.c_str());
+    }
+
+    patch.address = 0;
+}
+
+void HLESetCall(const char * name, void (*call)(), bool enabled)
 {
     SYMSetHighlevel(name, call);
+
+    HLEPatch patch;
+    patch.name = name;
+    patch.call = call;
+    patch.enabled = enabled;
+    patch.address = 0;
+    patch.opcode = 0;
+    patch.original[0] = patch.original[1] = 0;
+
+    hle->patches.push_back(patch);
+    HLEApply(hle->patches.back());
 }
 
+struct HLEEnableJob
+{
+    const char* name;
+    bool enable;
+    bool found;
+};
+
+static void HLEEnableAtSafePoint(void* context)
+{
+    HLEEnableJob* job = (HLEEnableJob*)context;
+
+    for (auto& patch : hle->patches)
+    {
+        if (strcmp(job->name, "*") && _stricmp(job->name, patch.name.c_str()))
+            continue;
+
+        job->found = true;
+        patch.enabled = job->enable;
+
+        // Re-applying also picks up symbols added after the emulation was started
+        HLERestore(patch);
+        HLEApply(patch);
+    }
+}
+
+// Switch the replacement on or off ("*" for all). Returns false, if there is no such replacement.
+bool HLEEnable(const char* name, bool enable)
+{
+    HLEEnableJob job = { name, enable, false };
+    Gekko::Gekko->RunAtSafePoint(HLEEnableAtSafePoint, &job);
+    return job.found;
+}
+
+uint64_t HLEGetCallCount(HLEPatch& patch)
+{
+    return patch.opcode ? Gekko::Gekko->GetHleCallCount(patch.opcode) : 0;
+}
+
+// ---------------------------------------------------------------------------
+
+uint8_t* HLETranslate(uint32_t ea, size_t size, bool write)
+{
+    if (Gekko::Gekko->cache.IsEnabled())
+        return nullptr;
+
+    int WIMG;
+    Gekko::MmuAccess type = write ? Gekko::MmuAccess::Write : Gekko::MmuAccess::Read;
+    uint32_t pa = Gekko::Gekko->EffectiveToPhysical(ea, type, WIMG);
+    if (pa == Gekko::BadAddress || (size_t)pa + size > mi->ramSize)
+        return nullptr;
+
+    // The pages must be contiguous in RAM
+    for (size_t offset = 0x1000 - (ea & 0xfff); offset < size; offset += 0x1000)
+    {
+        if (Gekko::Gekko->EffectiveToPhysical(ea + (uint32_t)offset, type, WIMG) != pa + offset)
+            return nullptr;
+    }
+
+    if (write)
+    {
+        mi->dirty.Mark(pa, size);
+    }
+    return &mi->ram[pa];
+}
+
+void HLEReadMemory(uint32_t ea, void* dst, size_t size)
+{
+    uint8_t* ptr = HLETranslate(ea, size, false);
+    if (ptr)
+    {
+        memcpy(dst, ptr, size);
+        return;
+    }
+
+    for (size_t i = 0; i < size; i++)
+    {
+        uint32_t value;
+        Gekko::Gekko->ReadByte(ea + (uint32_t)i, &value);
+        ((uint8_t*)dst)[i] = (uint8_t)value;
+    }
+}
+
+void HLEWriteMemory(uint32_t ea, const void* src, size_t size)
+{
+    uint8_t* ptr = HLETranslate(ea, size, true);
+    if (ptr)
+    {
+        memcpy(ptr, src, size);
+        return;
+    }
+
+    for (size_t i = 0; i < size; i++)
+    {
+        Gekko::Gekko->WriteByte(ea + (uint32_t)i, ((const uint8_t*)src)[i]);
+    }
+}
+
+// ---------------------------------------------------------------------------
+
 void HLEInit()
 {
     Debug::Hub.AddNode(HLE_JDI_JSON, HLE::JdiReflector);
@@ -135,17 +306,20 @@ void HLEOpen()
     } n = 0;
     while(oscalls[n].name)
     {
-        HLESetCall(oscalls[n].name, oscalls[n].call);
+        HLESetCall(oscalls[n].name, oscalls[n].call, oscalls[n].enabled);
         n++;
     }
 
     // Geometry library
-    //MTXOpen();
+    MTXOpen();
 }
 
+// Called when Gekko is suspended
 void HLEClose()
 {
     SYMKill();
+    hle->patches.clear();
+    Gekko::Gekko->ClearHleCalls();
 }
 
 void HLEExecuteCallback(uint32_t entryPoint)
@@ -1,18 +1,52 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
 void    os_ignore();
 void    os_ret0();
 void    os_ret1();
 void    os_trap();
 
+// Native replacement of a guest function.
+// The first two instructions of the function are replaced by a high level opcode (GekkoCore::AddHleCall) and blr,
+// the original instructions are kept, so the replacement can be switched off while the emulation is running.
+struct HLEPatch
+{
+    std::string name;
+    void        (*call)();
+    bool        enabled;
+    uint32_t    address;        // effective address of the patched symbol (0: not patched)
+    uint32_t    opcode;         // high level opcode
+    uint32_t    original[2];    // the instructions replaced by the patch
+};
+
 // HLE state variables
 struct HLEControl
 {
     // current loaded map file
     TCHAR       mapfile[0x1000];
+
+    std::vector<HLEPatch> patches;
+
+    // internal OS vars
+    uint32_t    __OSPhysicalContext;    // OS_PHYSICAL_CONTEXT
+    uint32_t    __OSCurrentContext;     // OS_CURRENT_CONTEXT
+
+    uint32_t    __OSDefaultThread;      // OS_DEFAULT_THREAD
 };
 
-extern  HLEControl hle;
+extern  InstanceRef<HLEControl, &Instance::hle> hle;
+
+void    HLESetCall(const char *name, void (*call)(), bool enabled=true);
+bool    HLEEnable(const char *name, bool enable);
+uint64_t HLEGetCallCount(HLEPatch& patch);
 
-void    HLESetCall(const char *name, void (*call)());
+// Access to the guest memory for HLE calls. RAM is accessed directly when the range is translated and is not in the emulated data cache,
+// otherwise through the Gekko memory interface. The data is in the guest byte order.
+void    HLEReadMemory(uint32_t ea, void* dst, size_t size);
+void    HLEWriteMemory(uint32_t ea, const void* src, size_t size);
+uint8_t* HLETranslate(uint32_t ea, size_t size, bool write);
 void    HLEInit();
 void    HLEShutdown();
 void    HLEOpen();
@@ -7,6 +7,7 @@
 #include "MapLoader.h"      // *.map file loader
 #include "MapSaver.h"       // save current symbols in *.map file
 #include "MapMaker.h"       // OS calls search engine
+#include "Signatures.h"     // SDK functions identification by signatures
 #include "Bootrom.h"        // bootrom simulation
 #include "OS.h"             // Dolphin OS
 #include "Stdc.h"           // std C runtime library calls
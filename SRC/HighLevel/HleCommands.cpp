@@ -29,6 +29,7 @@ namespace HLE
         {
             DBReport2(DbgChannel::HLE, "New symbol: %08X %s\n", address, args[2].c_str());
             SYMAddNew(address, args[2].c_str());
+            SYMFinalize();
         }
         else DBReport2(DbgChannel::HLE, "Wrong address!\n");
 
@@ -76,21 +77,21 @@ namespace HLE
     static Json::Value* UnloadMap(std::vector<std::string>& args)
     {
         SYMKill();
-        hle.mapfile[0] = 0;
+        hle->mapfile[0] = 0;
         return nullptr;
     }
 
     static Json::Value* LoadMap(std::vector<std::string>& args)
     {
         SYMKill();
-        hle.mapfile[0] = 0;
+        hle->mapfile[0] = 0;
         LoadMAP(args[1].c_str(), false);
         return nullptr;
     }
 
     static Json::Value* AddMap(std::vector<std::string>& args)
     {
-        if (hle.mapfile[0] == 0)
+        if (hle->mapfile[0] == 0)
         {
             LoadMAP(args[1].c_str(), false);
         }
@@ -164,6 +165,116 @@ namespace HLE
         return output;
     }
 
+    static Json::Value* HleList(std::vector<std::string>& args)
+    {
+        const char* filter = args.size() >= 2 ? args[1].c_str() : "*";
+        size_t len = strlen(filter);
+
+        Json::Value* output = new Json::Value();
+        output->type = Json::ValueType::Array;
+
+        DBReport("<address> calls      on  name\n\n");
+
+        for (auto& patch : hle->patches)
+        {
+            if (*filter != '*' && _strnicmp(filter, patch.name.c_str(), len))
+                continue;
+
+            uint64_t calls = HLEGetCallCount(patch);
+
+            if (patch.address)
+            {
+                DBReport("<%08X> %-10llu %-3s %s\n", patch.address, calls, patch.enabled ? "on" : "off", patch.name.c_str());
+            }
+            else
+            {
+                DBReport("<--------> %-10llu %-3s %s\n", calls, patch.enabled ? "on" : "off", patch.name.c_str());
+            }
+
+            Json::Value* item = output->AddObject(nullptr);
+            item->AddAnsiString("name", patch.name.c_str());
+            item->AddBool("enabled", patch.enabled);
+            item->AddUInt32("address", patch.address);
+            item->AddUInt64("calls", calls);
+        }
+
+        return output;
+    }
+
+    static Json::Value* HleEnable(std::vector<std::string>& args)
+    {
+        bool enable = atoi(args[2].c_str()) != 0;
+
+        if (!HLEEnable(args[1].c_str(), enable))
+        {
+            DBReport("No such HLE call: %s\n", args[1].c_str());
+        }
+        return nullptr;
+    }
+
+    // The signatures are added to the file (a signature with the same name is replaced)
+    static Json::Value* MakeSignatures(std::vector<std::string>& args)
+    {
+        if (!IsLoaded())
+            return nullptr;
+
+        std::basic_string<TCHAR> filename(args[1].begin(), args[1].end());
+
+        SignatureDB signatures;
+        signatures.Load(filename.c_str());
+        size_t added = signatures.AddSymbols();
+
+        if (signatures.Save(filename.c_str()))
+        {
+            DBReport("%zi signatures made, %zi in %s\n", added, signatures.Count(), args[1].c_str());
+        }
+        else
+        {
+            DBReport("Cannot write %s\n", args[1].c_str());
+        }
+        return nullptr;
+    }
+
+    static Json::Value* FindSignatures(std::vector<std::string>& args)
+    {
+        if (!IsLoaded())
+            return nullptr;
+
+        std::basic_string<TCHAR> filename = SIGNATURES_FILE;
+        if (args.size() >= 2)
+        {
+            filename.assign(args[1].begin(), args[1].end());
+        }
+
+        SignatureDB signatures;
+        if (!signatures.Load(filename.c_str()))
+        {
+            DBReport("Cannot load signatures\n");
+            return nullptr;
+        }
+
+        std::vector<SignatureRange> ranges = { { 0x80000000, RAMSIZE } };
+        std::vector<SignatureMatch> matches;
+        signatures.Identify(ranges, matches);
+        signatures.ApplyMatches(matches);
+
+        Json::Value* output = new Json::Value();
+        output->type = Json::ValueType::Array;
+
+        for (auto& match : matches)
+        {
+            const char* name = signatures.Get(match.signature).name.c_str();
+            DBReport("<%08X> %s\n", match.address, name);
+
+            Json::Value* item = output->AddObject(nullptr);
+            item->AddAnsiString("name", name);
+            item->AddUInt32("address", match.address);
+        }
+        DBReport("%zi functions identified\n", matches.size());
+
+        return output;
+    }
+
 	void JdiReflector()
 	{
         Debug::Hub.AddCmd("syms", cmd_syms);
@@ -178,5 +289,9 @@ namespace HLE
         Debug::Hub.AddCmd("NameByAddress", NameByAddress);
         Debug::Hub.AddCmd("OSTime", OSTimeInternal);
         Debug::Hub.AddCmd("GetNearestName", GetNearestNameInternal);
+        Debug::Hub.AddCmd("HleList", HleList);
+        Debug::Hub.AddCmd("HleEnable", HleEnable);
+        Debug::Hub.AddCmd("MakeSignatures", MakeSignatures);
+        Debug::Hub.AddCmd("FindSignatures", FindSignatures);
 	}
 }
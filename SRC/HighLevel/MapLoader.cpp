@@ -132,14 +132,14 @@ MAP_FORMAT LoadMAP(const TCHAR *mapname, bool add)
     }
 
     // copy name for MAP saver (with SaveMAP "this" parameter)
-    _tcscpy(hle.mapfile, mapname);
+    _tcscpy(hle->mapfile, mapname);
 
     // try to open
     _tfopen_s(&f, mapname, _T("r"));
     if(!f)
     {
         DBReport2(DbgChannel::HLE, "Cannot %s MAP: %s\n", (add) ? "add" : "load", Debug::Hub.TcharToString((TCHAR*)mapname).c_str());
-        hle.mapfile[0] = 0;
+        hle->mapfile[0] = 0;
         return MAP_FORMAT::BAD;
     }
 
@@ -152,9 +152,11 @@ MAP_FORMAT LoadMAP(const TCHAR *mapname, bool add)
     else if(!strncmp(sign, "Archive member", 14)) format = LoadMapGCC(mapname);
     else format = LoadMapRAW(mapname);
 
+    SYMFinalize();
+
     if(format == MAP_FORMAT::BAD)
     {
-        hle.mapfile[0] = 0;
+        hle->mapfile[0] = 0;
     }
     return format;
 }
@@ -43,7 +43,7 @@ static uint32_t MAPFuncChecksum (uint32_t offsetStart, uint32_t offsetEnd)
     uint32_t opcode, auxop, op, op2, op3;
 
     for (offset = offsetStart; offset <= offsetEnd; offset+=4) {
-        opcode = _byteswap_ulong(*((uint32_t *)&mi.ram[offset & RAMMASK]));
+        opcode = _byteswap_ulong(*((uint32_t *)&mi->ram[offset & RAMMASK]));
         op = opcode & 0xFC000000; 
         op2 = 0;
         op3 = 0;
@@ -195,7 +195,7 @@ void MAPAddRange (uint32_t offsetStart, uint32_t offsetEnd)
     MAPAddMark (offsetStart, FALSE);
     while(offsetStart < offsetEnd) {
 
-        opcode = _byteswap_ulong(*((uint32_t *)&mi.ram[offsetStart & RAMMASK]));
+        opcode = _byteswap_ulong(*((uint32_t *)&mi->ram[offsetStart & RAMMASK]));
         op = opcode >> 26, op2 = 0;
 
         switch (op) {
@@ -61,12 +61,12 @@ static void SaveMAP2(const TCHAR *mapname)
 
     if(!mapname)
     {
-        if(hle.mapfile[0] == 0)
+        if(hle->mapfile[0] == 0)
         {
             DBReport2(DbgChannel::Error, "No map file loaded! Symbols will be saved to default map\n");
             mapname = DEFAULT_MAP;
         }
-        else mapname = hle.mapfile;
+        else mapname = hle->mapfile;
     }
 
     DBReport2(DbgChannel::HLE, "Saving/updating map: %s ...\n\n", mapname);
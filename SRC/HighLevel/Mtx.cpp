@@ -1,6 +1,7 @@
 // DolphinSDK Vector/Matrix math library emulation.
 
 // The modern x64 SSE optimizer should optimize such code pretty well, without any ritual squats.
+// The hot ones (concatenation, matrix-vector products) are written with SSE2 intrinsics anyway, to swap the bytes on the fly.
 
 #include "pch.h"
 
@@ -21,7 +22,7 @@ typedef struct MatrixF
     float     data[3][4];
 } MatrixF, *MatrixFPtr;
 
-#define MTX(mx)  mx->data
+#define MTX(mx)  (mx)->data
 
 static void print_mtx(MatrixPtr ptr)
 {
@@ -39,15 +40,30 @@ static void print_mtx(MatrixPtr ptr)
     Gekko::GekkoCore::SwapArea((uint32_t *)ptr, 3*4*4);
 }
 
+// Guest floats are big-endian. SSE2 has no byte shuffle, so the bytes are swapped by shifts.
+static inline __m128i SwapVector(__m128i v)
+{
+    v = _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+    v = _mm_shufflelo_epi16(v, _MM_SHUFFLE(2, 3, 0, 1));
+    return _mm_shufflehi_epi16(v, _MM_SHUFFLE(2, 3, 0, 1));
+}
+
+static inline __m128 LoadSwapped(const uint32_t* src)
+{
+    return _mm_castsi128_ps(SwapVector(_mm_loadu_si128((const __m128i*)src)));
+}
+
+static inline void StoreSwapped(uint32_t* dst, __m128 value)
+{
+    _mm_storeu_si128((__m128i*)dst, SwapVector(_mm_castps_si128(value)));
+}
+
 /* ---------------------------------------------------------------------------
     Init layer
 --------------------------------------------------------------------------- */
 
 void MTXOpen()
 {
-    BOOL flag = false;//GetConfigInt(USER_HLE_MTX, USER_HLE_MTX_DEFAULT);
-    if(flag == FALSE) return;
-
     DBReport2( DbgChannel::HLE, "Geometry library install\n");
 
     HLESetCall("C_MTXIdentity",             C_MTXIdentity);
@@ -60,123 +76,136 @@ void MTXOpen()
     HLESetCall("C_MTXTranspose",            C_MTXTranspose);
     HLESetCall("PSMTXTranspose",            C_MTXTranspose);
 
-    DBReport("\n");
+    HLESetCall("C_MTXMultVec",              C_MTXMultVec);
+    HLESetCall("PSMTXMultVec",              C_MTXMultVec);
+    HLESetCall("C_MTXMultVecArray",         C_MTXMultVecArray);
+    HLESetCall("PSMTXMultVecArray",         C_MTXMultVecArray);
 }
 
 /* ---------------------------------------------------------------------------
     General stuff
 --------------------------------------------------------------------------- */
 
-static Matrix tmpMatrix[4];
+// The matrices are read in a local copy before the result is written, so the source and the destination may be the same.
 
 void C_MTXIdentity(void)
 {
-    MatrixPtr m = (MatrixPtr)(&mi.ram[PARAM(0) & RAMMASK]);
+    Matrix m;
 
-    MTX(m)[0][0] = ONE;  MTX(m)[0][1] = ZERO; MTX(m)[0][2] = ZERO; MTX(m)[0][3] = ZERO;
-    MTX(m)[1][0] = ZERO; MTX(m)[1][1] = ONE;  MTX(m)[1][2] = ZERO; MTX(m)[1][3] = ZERO;
-    MTX(m)[2][0] = ZERO; MTX(m)[2][1] = ZERO; MTX(m)[2][2] = ONE;  MTX(m)[2][3] = ZERO;
+    MTX(&m)[0][0] = ONE;  MTX(&m)[0][1] = ZERO; MTX(&m)[0][2] = ZERO; MTX(&m)[0][3] = ZERO;
+    MTX(&m)[1][0] = ZERO; MTX(&m)[1][1] = ONE;  MTX(&m)[1][2] = ZERO; MTX(&m)[1][3] = ZERO;
+    MTX(&m)[2][0] = ZERO; MTX(&m)[2][1] = ZERO; MTX(&m)[2][2] = ONE;  MTX(&m)[2][3] = ZERO;
+
+    HLEWriteMemory(PARAM(0), &m, sizeof(Matrix));
 }
 
 void C_MTXCopy(void)
 {
-    MatrixPtr src = (MatrixPtr)(&mi.ram[PARAM(0) & RAMMASK]);
-    MatrixPtr dst = (MatrixPtr)(&mi.ram[PARAM(1) & RAMMASK]);
-
-    if(src == dst) return;
+    Matrix m;
 
-    MTX(dst)[0][0] = MTX(src)[0][0]; MTX(dst)[0][1] = MTX(src)[0][1]; MTX(dst)[0][2] = MTX(src)[0][2]; MTX(dst)[0][3] = MTX(src)[0][3];
-    MTX(dst)[1][0] = MTX(src)[1][0]; MTX(dst)[1][1] = MTX(src)[1][1]; MTX(dst)[1][2] = MTX(src)[1][2]; MTX(dst)[1][3] = MTX(src)[1][3];
-    MTX(dst)[2][0] = MTX(src)[2][0]; MTX(dst)[2][1] = MTX(src)[2][1]; MTX(dst)[2][2] = MTX(src)[2][2]; MTX(dst)[2][3] = MTX(src)[2][3];
+    if(PARAM(0) == PARAM(1)) return;
 
-    //print_mtx((MatrixPtr)src, "src C");
-    //print_mtx((MatrixPtr)dst, "dst C");
+    HLEReadMemory(PARAM(0), &m, sizeof(Matrix));
+    HLEWriteMemory(PARAM(1), &m, sizeof(Matrix));
 }
 
+// ab = a x b. The fourth row of both matrices is (0, 0, 0, 1).
 void C_MTXConcat(void)
 {
-    MatrixFPtr a = (MatrixFPtr)(&mi.ram[PARAM(0) & RAMMASK]);
-    MatrixFPtr b = (MatrixFPtr)(&mi.ram[PARAM(1) & RAMMASK]);
-    MatrixFPtr axb = (MatrixFPtr)(&mi.ram[PARAM(2) & RAMMASK]);
-    MatrixFPtr t = (MatrixFPtr)(&tmpMatrix[0]), m;
+    Matrix a, b, ab;
 
-    if( (axb == a) || (axb == b) ) m = t;
-    else m = axb;
+    HLEReadMemory(PARAM(0), &a, sizeof(Matrix));
+    HLEReadMemory(PARAM(1), &b, sizeof(Matrix));
 
-    //print_mtx((MatrixPtr)a, "a C");
-    //print_mtx((MatrixPtr)b, "b C");
+    __m128 b0 = LoadSwapped(MTX(&b)[0]);
+    __m128 b1 = LoadSwapped(MTX(&b)[1]);
+    __m128 b2 = LoadSwapped(MTX(&b)[2]);
+    __m128 wMask = _mm_castsi128_ps(_mm_setr_epi32(0, 0, 0, -1));
 
-    Gekko::GekkoCore::SwapArea((uint32_t *)a, 3*4*4);
-    Gekko::GekkoCore::SwapArea((uint32_t *)b, 3*4*4);
+    for (int i = 0; i < 3; i++)
+    {
+        __m128 row = LoadSwapped(MTX(&a)[i]);
 
-    // m = a x b
-    MTX(m)[0][0] = MTX(a)[0][0]*MTX(b)[0][0] + MTX(a)[0][1]*MTX(b)[1][0] + MTX(a)[0][2]*MTX(b)[2][0];
-    MTX(m)[0][1] = MTX(a)[0][0]*MTX(b)[0][1] + MTX(a)[0][1]*MTX(b)[1][1] + MTX(a)[0][2]*MTX(b)[2][1];
-    MTX(m)[0][2] = MTX(a)[0][0]*MTX(b)[0][2] + MTX(a)[0][1]*MTX(b)[1][2] + MTX(a)[0][2]*MTX(b)[2][2];
-    MTX(m)[0][3] = MTX(a)[0][0]*MTX(b)[0][3] + MTX(a)[0][1]*MTX(b)[1][3] + MTX(a)[0][2]*MTX(b)[2][3] + MTX(a)[0][3];
+        __m128 m = _mm_mul_ps(_mm_shuffle_ps(row, row, _MM_SHUFFLE(0, 0, 0, 0)), b0);
+        m = _mm_add_ps(m, _mm_mul_ps(_mm_shuffle_ps(row, row, _MM_SHUFFLE(1, 1, 1, 1)), b1));
+        m = _mm_add_ps(m, _mm_mul_ps(_mm_shuffle_ps(row, row, _MM_SHUFFLE(2, 2, 2, 2)), b2));
+        m = _mm_add_ps(m, _mm_and_ps(row, wMask));      // translation
 
-    MTX(m)[1][0] = MTX(a)[1][0]*MTX(b)[0][0] + MTX(a)[1][1]*MTX(b)[1][0] + MTX(a)[1][2]*MTX(b)[2][0];
-    MTX(m)[1][1] = MTX(a)[1][0]*MTX(b)[0][1] + MTX(a)[1][1]*MTX(b)[1][1] + MTX(a)[1][2]*MTX(b)[2][1];
-    MTX(m)[1][2] = MTX(a)[1][0]*MTX(b)[0][2] + MTX(a)[1][1]*MTX(b)[1][2] + MTX(a)[1][2]*MTX(b)[2][2];
-    MTX(m)[1][3] = MTX(a)[1][0]*MTX(b)[0][3] + MTX(a)[1][1]*MTX(b)[1][3] + MTX(a)[1][2]*MTX(b)[2][3] + MTX(a)[1][3];
+        StoreSwapped(MTX(&ab)[i], m);
+    }
 
-    MTX(m)[2][0] = MTX(a)[2][0]*MTX(b)[0][0] + MTX(a)[2][1]*MTX(b)[1][0] + MTX(a)[2][2]*MTX(b)[2][0];
-    MTX(m)[2][1] = MTX(a)[2][0]*MTX(b)[0][1] + MTX(a)[2][1]*MTX(b)[1][1] + MTX(a)[2][2]*MTX(b)[2][1];
-    MTX(m)[2][2] = MTX(a)[2][0]*MTX(b)[0][2] + MTX(a)[2][1]*MTX(b)[1][2] + MTX(a)[2][2]*MTX(b)[2][2];
-    MTX(m)[2][3] = MTX(a)[2][0]*MTX(b)[0][3] + MTX(a)[2][1]*MTX(b)[1][3] + MTX(a)[2][2]*MTX(b)[2][3] + MTX(a)[2][3];
+    //print_mtx(&ab);
 
-    // restore A and B
-    Gekko::GekkoCore::SwapArea((uint32_t *)a, 3*4*4);
-    Gekko::GekkoCore::SwapArea((uint32_t *)b, 3*4*4);
-    Gekko::GekkoCore::SwapArea((uint32_t *)m, 3*4*4);
+    HLEWriteMemory(PARAM(2), &ab, sizeof(Matrix));
+}
 
-    //print_mtx((MatrixPtr)m, "m C");
+void C_MTXTranspose(void)
+{
+    Matrix src, m;
 
-    // overwrite a (b)
-    if(m == t)
-    {
-        MatrixPtr src = (MatrixPtr)t, dst = (MatrixPtr)axb;
-        if(src != dst)
-        {
-            MTX(dst)[0][0] = MTX(src)[0][0]; MTX(dst)[0][1] = MTX(src)[0][1]; MTX(dst)[0][2] = MTX(src)[0][2]; MTX(dst)[0][3] = MTX(src)[0][3];
-            MTX(dst)[1][0] = MTX(src)[1][0]; MTX(dst)[1][1] = MTX(src)[1][1]; MTX(dst)[1][2] = MTX(src)[1][2]; MTX(dst)[1][3] = MTX(src)[1][3];
-            MTX(dst)[2][0] = MTX(src)[2][0]; MTX(dst)[2][1] = MTX(src)[2][1]; MTX(dst)[2][2] = MTX(src)[2][2]; MTX(dst)[2][3] = MTX(src)[2][3];
-        }
-    }
+    HLEReadMemory(PARAM(0), &src, sizeof(Matrix));
+
+    MTX(&m)[0][0] = MTX(&src)[0][0]; MTX(&m)[0][1] = MTX(&src)[1][0]; MTX(&m)[0][2] = MTX(&src)[2][0]; MTX(&m)[0][3] = ZERO;
+    MTX(&m)[1][0] = MTX(&src)[0][1]; MTX(&m)[1][1] = MTX(&src)[1][1]; MTX(&m)[1][2] = MTX(&src)[2][1]; MTX(&m)[1][3] = ZERO;
+    MTX(&m)[2][0] = MTX(&src)[0][2]; MTX(&m)[2][1] = MTX(&src)[1][2]; MTX(&m)[2][2] = MTX(&src)[2][2]; MTX(&m)[2][3] = ZERO;
+
+    HLEWriteMemory(PARAM(1), &m, sizeof(Matrix));
 }
 
-void C_MTXTranspose(void)
+void C_MTXInverse(void)
 {
-    MatrixPtr src = (MatrixPtr)(&mi.ram[PARAM(0) & RAMMASK]);
-    MatrixPtr xPose = (MatrixPtr)(&mi.ram[PARAM(1) & RAMMASK]);
-    MatrixPtr t = (&tmpMatrix[0]), m;
+}
 
-    if(src == xPose) m = t;
-    else m = xPose;
+void C_MTXInvXpose(void)
+{
+}
 
-    MTX(m)[0][0] = MTX(src)[0][0]; MTX(m)[0][1] = MTX(src)[1][0]; MTX(m)[0][2] = MTX(src)[2][0]; MTX(m)[0][3] = ZERO;
-    MTX(m)[1][0] = MTX(src)[0][1]; MTX(m)[1][1] = MTX(src)[1][1]; MTX(m)[1][2] = MTX(src)[2][1]; MTX(m)[1][3] = ZERO;
-    MTX(m)[2][0] = MTX(src)[0][2]; MTX(m)[2][1] = MTX(src)[1][2]; MTX(m)[2][2] = MTX(src)[2][2]; MTX(m)[2][3] = ZERO;
+/* ---------------------------------------------------------------------------
+    Matrix-vector
+--------------------------------------------------------------------------- */
 
-    //print_mtx((MatrixPtr)m, "m C");
+// dst = m x (x, y, z, 1). The matrix is transposed once, then each vector takes three multiplications.
+static void MultVecArray(uint32_t eaMtx, uint32_t eaSrc, uint32_t eaDst, uint32_t count)
+{
+    Matrix m;
+
+    HLEReadMemory(eaMtx, &m, sizeof(Matrix));
+
+    __m128 c0 = LoadSwapped(MTX(&m)[0]);
+    __m128 c1 = LoadSwapped(MTX(&m)[1]);
+    __m128 c2 = LoadSwapped(MTX(&m)[2]);
+    __m128 c3 = _mm_setzero_ps();
+    _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
 
-    // overwrite
-    if(m == t)
+    size_t size = (size_t)count * 3 * sizeof(float);
+    uint8_t* src = HLETranslate(eaSrc, size, false);
+    uint8_t* dst = HLETranslate(eaDst, size, true);
+
+    for (uint32_t i = 0; i < count; i++)
     {
-        MatrixPtr src = t, dst = xPose;
-        if(src != dst)
-        {
-            MTX(dst)[0][0] = MTX(src)[0][0]; MTX(dst)[0][1] = MTX(src)[0][1]; MTX(dst)[0][2] = MTX(src)[0][2]; MTX(dst)[0][3] = MTX(src)[0][3];
-            MTX(dst)[1][0] = MTX(src)[1][0]; MTX(dst)[1][1] = MTX(src)[1][1]; MTX(dst)[1][2] = MTX(src)[1][2]; MTX(dst)[1][3] = MTX(src)[1][3];
-            MTX(dst)[2][0] = MTX(src)[2][0]; MTX(dst)[2][1] = MTX(src)[2][1]; MTX(dst)[2][2] = MTX(src)[2][2]; MTX(dst)[2][3] = MTX(src)[2][3];
-        }
+        uint32_t vec[4];
+
+        if (src) memcpy(vec, src + i * 12, 12);
+        else HLEReadMemory(eaSrc + i * 12, vec, 12);
+        vec[3] = ZERO;
+
+        __m128 v = LoadSwapped(vec);
+        __m128 r = _mm_add_ps(_mm_mul_ps(_mm_shuffle_ps(v, v, _MM_SHUFFLE(0, 0, 0, 0)), c0), c3);
+        r = _mm_add_ps(r, _mm_mul_ps(_mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 1, 1, 1)), c1));
+        r = _mm_add_ps(r, _mm_mul_ps(_mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 2, 2, 2)), c2));
+        StoreSwapped(vec, r);
+
+        if (dst) memcpy(dst + i * 12, vec, 12);
+        else HLEWriteMemory(eaDst + i * 12, vec, 12);
     }
 }
 
-void C_MTXInverse(void)
+void C_MTXMultVec(void)
 {
+    MultVecArray(PARAM(0), PARAM(1), PARAM(2), 1);
 }
 
-void C_MTXInvXpose(void)
+void C_MTXMultVecArray(void)
 {
+    MultVecArray(PARAM(0), PARAM(1), PARAM(2), PARAM(3));
 }
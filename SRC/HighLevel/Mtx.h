@@ -34,6 +34,10 @@ void    MTXMultVecSR        ( Mtx m, VecPtr src, VecPtr dst );
 void    MTXMultVecArraySR   ( Mtx m, VecPtr srcBase, VecPtr dstBase, u32 count );
 /*/
 
+// C version
+void    C_MTXMultVec        (void);
+void    C_MTXMultVecArray   (void);
+
 /* ---------------------------------------------------------------------------
     Affine matrix math
 --------------------------------------------------------------------------- */
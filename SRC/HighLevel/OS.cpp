@@ -5,11 +5,7 @@
 #define RET_VAL     Gekko::Gekko->regs.gpr[3]
 #define SWAP        _byteswap_ulong
 
-// internal OS vars
-static  uint32_t     __OSPhysicalContext;    // OS_PHYSICAL_CONTEXT
-static  uint32_t     __OSCurrentContext;     // OS_CURRENT_CONTEXT
-
-static  uint32_t     __OSDefaultThread;      // OS_DEFAULT_THREAD
+// internal OS vars are in HLEControl
 
 /* ---------------------------------------------------------------------------
     Context API, based on Dolphin OS reversing of OSContext module
@@ -35,14 +31,15 @@ static void swap_double(void *srcPtr)
 
 void OSSetCurrentContext(void)
 {
-    __OSCurrentContext  = PARAM(0);
-    __OSPhysicalContext = __OSCurrentContext & RAMMASK; // simple translation
-    Gekko::Gekko->WriteWord(OS_CURRENT_CONTEXT, __OSCurrentContext);
-    Gekko::Gekko->WriteWord(OS_PHYSICAL_CONTEXT, __OSPhysicalContext);
+    hle->__OSCurrentContext  = PARAM(0);
+    hle->__OSPhysicalContext = hle->__OSCurrentContext & RAMMASK; // simple translation
+    Gekko::Gekko->WriteWord(OS_CURRENT_CONTEXT, hle->__OSCurrentContext);
+    Gekko::Gekko->WriteWord(OS_PHYSICAL_CONTEXT, hle->__OSPhysicalContext);
 
-    OSContext *c = (OSContext *)(&mi.ram[__OSPhysicalContext]);
+    OSContext *c = (OSContext *)(&mi->ram[hle->__OSPhysicalContext]);
+    mi->dirty.Mark(hle->__OSPhysicalContext, sizeof(OSContext));
 
-    if(__OSCurrentContext == __OSDefaultThread/*context*/)
+    if(hle->__OSCurrentContext == hle->__OSDefaultThread/*context*/)
     {
         c->srr[1] |= SWAP(MSR_FP);
     }
@@ -61,14 +58,15 @@ void OSSetCurrentContext(void)
 
 void OSGetCurrentContext(void)
 {
-    RET_VAL = __OSCurrentContext;
+    RET_VAL = hle->__OSCurrentContext;
 }
 
 void OSSaveContext(void)
 {
     int i;
 
-    OSContext * c = (OSContext *)(&mi.ram[PARAM(0) & RAMMASK]);
+    OSContext * c = (OSContext *)(&mi->ram[PARAM(0) & RAMMASK]);
+    mi->dirty.Mark(PARAM(0) & RAMMASK, sizeof(OSContext));
 
     // always save FP/PS context
     OSSaveFPUContext();
@@ -98,10 +96,10 @@ void OSSaveContext(void)
 }
 
 // OSLoadContext return is patched as RFI (not usual BLR)
-// see Symbols.cpp, SYMSetHighlevel, line 97
+// see HLE.cpp, HLEApply
 void OSLoadContext(void)
 {
-    OSContext * c = (OSContext *)(&mi.ram[PARAM(0) & RAMMASK]);
+    OSContext * c = (OSContext *)(&mi->ram[PARAM(0) & RAMMASK]);
 
     // thread switch on OSDisableInterrupts is omitted, because
     // interrupts are generated only at branch opcodes;
@@ -125,6 +123,7 @@ void OSLoadContext(void)
     {
         state &= ~OS_CONTEXT_STATE_EXC;
         c->state = (state >> 8) | (state << 8);
+        mi->dirty.Mark(PARAM(0) & RAMMASK, sizeof(OSContext));
         for(int i=5; i<32; i++)
             Gekko::Gekko->regs.gpr[i] = SWAP(c->gpr[i]);
     }
@@ -151,15 +150,16 @@ void OSLoadContext(void)
 
 void OSClearContext(void)
 {
-    OSContext * c = (OSContext *)(&mi.ram[PARAM(0) & RAMMASK]);
+    OSContext * c = (OSContext *)(&mi->ram[PARAM(0) & RAMMASK]);
+    mi->dirty.Mark(PARAM(0) & RAMMASK, sizeof(OSContext));
 
     c->mode = 0;
     c->state = 0;
 
-    if(PARAM(0) == __OSDefaultThread/*context*/) 
+    if(PARAM(0) == hle->__OSDefaultThread/*context*/) 
     {
-        __OSDefaultThread = NULL;
-        Gekko::Gekko->WriteWord(OS_DEFAULT_THREAD, __OSDefaultThread);
+        hle->__OSDefaultThread = NULL;
+        Gekko::Gekko->WriteWord(OS_DEFAULT_THREAD, hle->__OSDefaultThread);
     }
 }
 
@@ -167,7 +167,8 @@ void OSInitContext(void)
 {
     int i;
 
-    OSContext * c = (OSContext *)(&mi.ram[PARAM(0) & RAMMASK]);
+    OSContext * c = (OSContext *)(&mi->ram[PARAM(0) & RAMMASK]);
+    mi->dirty.Mark(PARAM(0) & RAMMASK, sizeof(OSContext));
 
     c->srr[0] = SWAP(PARAM(1));
     c->gpr[1] = SWAP(PARAM(2));
@@ -190,7 +191,7 @@ void OSInitContext(void)
 void OSLoadFPUContext(void)
 {
     PARAM(1) = PARAM(0);
-    OSContext * c = (OSContext *)(&mi.ram[PARAM(1) & RAMMASK]);
+    OSContext * c = (OSContext *)(&mi->ram[PARAM(1) & RAMMASK]);
 
     //u16 state = (c->state >> 8) | (c->state << 8);
     //if(! (state & OS_CONTEXT_STATE_FPSAVED) )
@@ -201,11 +202,11 @@ void OSLoadFPUContext(void)
         {
             if(Gekko::Gekko->regs.spr[(int)Gekko::SPR::HID2] & HID2_PSE)
             {
-                Gekko::Gekko->regs.ps1[i].uval = *(uint64_t *)(&c->psr[i]);
-                swap_double(&Gekko::Gekko->regs.ps1[i].uval);
+                Gekko::Gekko->regs.fpr[i].ps1.uval = *(uint64_t *)(&c->psr[i]);
+                swap_double(&Gekko::Gekko->regs.fpr[i].ps1.uval);
             }
-            Gekko::Gekko->regs.fpr[i].uval = *(uint64_t *)(&c->fpr[i]);
-            swap_double(&Gekko::Gekko->regs.fpr[i].uval);
+            Gekko::Gekko->regs.fpr[i].ps0.uval = *(uint64_t *)(&c->fpr[i]);
+            swap_double(&Gekko::Gekko->regs.fpr[i].ps0.uval);
         }
     }
 }
@@ -213,18 +214,19 @@ void OSLoadFPUContext(void)
 void OSSaveFPUContext(void)
 {
     PARAM(2) = PARAM(0);
-    OSContext * c = (OSContext *)(&mi.ram[PARAM(2) & RAMMASK]);
+    OSContext * c = (OSContext *)(&mi->ram[PARAM(2) & RAMMASK]);
+    mi->dirty.Mark(PARAM(2) & RAMMASK, sizeof(OSContext));
 
     //c->state |= (OS_CONTEXT_STATE_FPSAVED >> 8) | (OS_CONTEXT_STATE_FPSAVED << 8);
     c->fpscr = SWAP(Gekko::Gekko->regs.fpscr);
 
     for(int i=0; i<32; i++)
     {
-        *(uint64_t *)(&c->fpr[i]) = Gekko::Gekko->regs.fpr[i].uval;
+        *(uint64_t *)(&c->fpr[i]) = Gekko::Gekko->regs.fpr[i].ps0.uval;
         swap_double(&c->fpr[i]);
         if(Gekko::Gekko->regs.spr[(int)Gekko::SPR::HID2] & HID2_PSE)
         {
-            *(uint64_t *)(&c->psr[i]) = Gekko::Gekko->regs.ps1[i].uval;
+            *(uint64_t *)(&c->psr[i]) = Gekko::Gekko->regs.fpr[i].ps1.uval;
             swap_double(&c->psr[i]);
         }
     }
@@ -232,18 +234,19 @@ void OSSaveFPUContext(void)
 
 void OSFillFPUContext(void)
 {
-    OSContext * c = (OSContext *)(&mi.ram[PARAM(0) & RAMMASK]);
+    OSContext * c = (OSContext *)(&mi->ram[PARAM(0) & RAMMASK]);
+    mi->dirty.Mark(PARAM(0) & RAMMASK, sizeof(OSContext));
     
     Gekko::Gekko->regs.msr |= MSR_FP;
     c->fpscr = SWAP(Gekko::Gekko->regs.fpscr);
 
     for(int i=0; i<32; i++)
     {
-        *(uint64_t *)(&c->fpr[i]) = Gekko::Gekko->regs.fpr[i].uval;
+        *(uint64_t *)(&c->fpr[i]) = Gekko::Gekko->regs.fpr[i].ps0.uval;
         swap_double(&c->fpr[i]);
         if(Gekko::Gekko->regs.spr[(int)Gekko::SPR::HID2] & HID2_PSE)
         {
-            *(uint64_t *)(&c->psr[i]) = Gekko::Gekko->regs.ps1[i].uval;
+            *(uint64_t *)(&c->psr[i]) = Gekko::Gekko->regs.fpr[i].ps1.uval;
             swap_double(&c->psr[i]);
         }
     }
@@ -254,8 +257,8 @@ void __OSContextInit(void)
     DBReport2(DbgChannel::HLE, "HLE OS context driver installed.\n");
     DBReport2(DbgChannel::HLE, "Note: FP-Unavail is NOT used and FPRs are always saved.\n\n");
 
-    __OSDefaultThread = NULL;
-    Gekko::Gekko->WriteWord(OS_DEFAULT_THREAD, __OSDefaultThread);
+    hle->__OSDefaultThread = NULL;
+    Gekko::Gekko->WriteWord(OS_DEFAULT_THREAD, hle->__OSDefaultThread);
     Gekko::Gekko->regs.msr |= (MSR_FP | MSR_RI);
 }
 
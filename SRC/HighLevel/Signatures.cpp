@@ -0,0 +1,450 @@
+// Identification of the SDK functions by signatures.
+#include "pch.h"
+
+static const uint32_t AmbiguousMatch = UINT32_MAX;
+static const uint32_t ScanChunkSize = 0x40000;      // Parallel scan unit, bytes
+
+static inline uint32_t CodeWord(uint32_t pa)
+{
+    return _byteswap_ulong(*(uint32_t*)&mi->ram[pa]);
+}
+
+static inline uint64_t PrefixKey(uint32_t w0, uint32_t w1)
+{
+    return ((uint64_t)w0 << 32) | w1;
+}
+
+// blr, bctr, rfi or b
+static bool IsFunctionEnd(uint32_t op)
+{
+    return op == 0x4e80'0020 || op == 0x4e80'0420 || op == 0x4c00'0064 || (op & 0xfc00'0001) == 0x4800'0000;
+}
+
+/* ---------------------------------------------------------------------------
+    Database
+--------------------------------------------------------------------------- */
+
+bool SignatureDB::Load(const TCHAR* filename)
+{
+    auto file = std::ifstream(filename);
+    if (!file.is_open())
+        return false;
+
+    std::string line;
+    while (std::getline(file, line))
+    {
+        size_t comment = line.find('#');
+        if (comment != std::string::npos)
+        {
+            line.resize(comment);
+        }
+
+        std::istringstream tokens(line);
+        std::string name, token;
+        if (!(tokens >> name))
+            continue;
+
+        std::vector<SignatureWord> words;
+        while (tokens >> token)
+        {
+            char* end;
+            SignatureWord word;
+            word.value = strtoul(token.c_str(), &end, 16);
+            word.mask = (*end == '/') ? strtoul(end + 1, nullptr, 16) : 0xffff'ffff;
+            word.value &= word.mask;
+            words.push_back(word);
+        }
+
+        if (words.size() >= MinWords)
+        {
+            Add(name, words);
+        }
+    }
+
+    DBReport2(DbgChannel::HLE, "Signatures loaded: %s (%zi)\n", Debug::Hub.TcharToString((TCHAR*)filename).c_str(), signatures.size());
+    return true;
+}
+
+bool SignatureDB::Save(const TCHAR* filename)
+{
+    FILE* f = nullptr;
+    _tfopen_s(&f, filename, _T("w"));
+    if (!f)
+        return false;
+
+    fprintf(f, "# Dolwin signatures: name, then instructions (value or value/mask)\n");
+
+    for (auto& signature : signatures)
+    {
+        fprintf(f, "%s", signature.name.c_str());
+        for (auto& word : signature.words)
+        {
+            if (word.mask == 0xffff'ffff) fprintf(f, " %08X", word.value);
+            else fprintf(f, " %08X/%08X", word.value, word.mask);
+        }
+        fprintf(f, "\n");
+    }
+
+    fclose(f);
+    return true;
+}
+
+void SignatureDB::Add(const std::string& name, const std::vector<SignatureWord>& words)
+{
+    auto it = byName.find(name);
+    if (it != byName.end())
+    {
+        signatures[it->second].words = words;
+    }
+    else
+    {
+        byName[name] = (uint32_t)signatures.size();
+        signatures.push_back({ name, words });
+    }
+    indexed = false;
+}
+
+// Relocations are masked:
+// - b/bl target
+// - lis (the upper half of an address)
+// - the offset of addi/ori/load/store, when the base is r2/r13 (small data areas) or a register loaded by lis in this function
+void SignatureDB::MakeSignature(const uint32_t* code, size_t count, std::vector<SignatureWord>& words)
+{
+    uint32_t lisRegs = 0;
+
+    words.clear();
+
+    for (size_t i = 0; i < count; i++)
+    {
+        uint32_t op = code[i];
+        uint32_t primary = op >> 26;
+        uint32_t rd = (op >> 21) & 0x1f;
+        uint32_t ra = (op >> 16) & 0x1f;
+        uint32_t mask = 0xffff'ffff;
+
+        bool relocatedBase = ra == 2 || ra == 13 || ((lisRegs >> ra) & 1);
+
+        switch (primary)
+        {
+            case 18:                                    // b, bl, ba, bla
+                mask = 0xfc00'0003;
+                break;
+
+            case 15:                                    // addis (lis)
+                mask = 0xffff'0000;
+                lisRegs |= 1 << rd;
+                break;
+
+            case 24:                                    // ori rA, rS, UIMM (the source is in the rD field)
+                if ((lisRegs >> rd) & 1)
+                    mask = 0xffff'0000;
+                break;
+
+            case 14:                                    // addi
+                if (ra != 0 && relocatedBase)
+                    mask = 0xffff'0000;
+                break;
+
+            case 56: case 57: case 60: case 61:         // psq_l, psq_lu, psq_st, psq_stu (12-bit offset)
+                if (relocatedBase)
+                    mask = 0xffff'f000;
+                break;
+
+            default:
+                if (primary >= 32 && primary <= 55 && relocatedBase)  // loads and stores
+                    mask = 0xffff'0000;
+                break;
+        }
+
+        words.push_back({ op & mask, mask });
+    }
+}
+
+size_t SignatureDB::AddSymbols()
+{
+    // The symbol table is sorted by address and has one symbol per address (see SYMFinalize)
+    const SYM* symbols = sym.symbols.data();
+    size_t symbolCount = sym.sortedCount;
+
+    // Entry points patched by HLE, their first two instructions are taken from the patch
+    std::unordered_map<uint32_t, const HLEPatch*> patched;
+    for (auto& patch : hle->patches)
+    {
+        if (patch.address != 0)
+        {
+            patched[patch.address] = &patch;
+        }
+    }
+
+    size_t added = 0;
+    std::vector<uint32_t> code;
+    std::vector<SignatureWord> words;
+
+    for (size_t i = 0; i + 1 < symbolCount; i++)
+    {
+        uint32_t pa = symbols[i].eaddr & RAMMASK;
+        size_t size = (symbols[i + 1].eaddr - symbols[i].eaddr) / 4;
+        size_t count = min(size, MaxWords);
+        char* name = symbols[i].savedName;
+
+        // Names made by the checksum map maker
+        if (name[0] == '[' || count < MinWords || pa + count * 4 > mi->ramSize)
+            continue;
+
+        code.resize(count);
+        for (size_t n = 0; n < count; n++)
+        {
+            code[n] = CodeWord(pa + (uint32_t)(n * 4));
+        }
+
+        auto patch = patched.find(symbols[i].eaddr);
+        if (patch != patched.end() && code[0] == patch->second->opcode)
+        {
+            code[0] = patch->second->original[0];
+            code[1] = patch->second->original[1];
+        }
+
+        // The next symbol may be far away (padding, or functions without symbols). A whole function ends by the last return or jump.
+        if (size <= MaxWords)
+        {
+            while (count > 0 && !IsFunctionEnd(code[count - 1]))
+            {
+                count--;
+            }
+            if (count < MinWords)
+                continue;
+        }
+
+        // Primary opcode 0 is not a valid instruction (data, or an HLE call placed by other means)
+        bool isCode = true;
+        for (size_t n = 0; n < count; n++)
+        {
+            if ((code[n] >> 26) == 0)
+            {
+                isCode = false;
+                break;
+            }
+        }
+        if (!isCode)
+            continue;
+
+        MakeSignature(code.data(), count, words);
+        Add(name, words);
+        added++;
+    }
+
+    return added;
+}
+
+void SignatureDB::BuildIndex()
+{
+    groups.clear();
+
+    for (uint32_t i = 0; i < (uint32_t)signatures.size(); i++)
+    {
+        auto& words = signatures[i].words;
+
+        PrefixGroup* group = nullptr;
+        for (auto& g : groups)
+        {
+            if (g.mask[0] == words[0].mask && g.mask[1] == words[1].mask)
+            {
+                group = &g;
+                break;
+            }
+        }
+        if (!group)
+        {
+            groups.push_back(PrefixGroup());
+            group = &groups.back();
+            group->mask[0] = words[0].mask;
+            group->mask[1] = words[1].mask;
+        }
+
+        group->table[PrefixKey(words[0].value, words[1].value)].push_back(i);
+    }
+
+    indexed = true;
+}
+
+/* ---------------------------------------------------------------------------
+    Scanner
+--------------------------------------------------------------------------- */
+
+// The range gives the start addresses, a function may go beyond its end.
+void SignatureDB::ScanRange(SignatureRange range, std::vector<SignatureMatch>& matches)
+{
+    uint32_t segment = range.address & ~RAMMASK;
+    uint32_t start = range.address & RAMMASK & ~3;
+    uint32_t end = (uint32_t)min((size_t)start + range.size, mi->ramSize);
+
+    for (uint32_t pa = start; pa < end && pa + 8 <= mi->ramSize; pa += 4)
+    {
+        uint32_t w0 = CodeWord(pa);
+        uint32_t w1 = CodeWord(pa + 4);
+
+        uint32_t best = AmbiguousMatch;
+        size_t bestCount = 0;
+        bool ambiguous = false;
+
+        for (auto& group : groups)
+        {
+            auto it = group.table.find(PrefixKey(w0 & group.mask[0], w1 & group.mask[1]));
+            if (it == group.table.end())
+                continue;
+
+            for (uint32_t index : it->second)
+            {
+                auto& words = signatures[index].words;
+                size_t count = words.size();
+
+                if (count < bestCount || pa + count * 4 > mi->ramSize)
+                    continue;
+
+                size_t n = 2;
+                while (n < count && (CodeWord(pa + (uint32_t)(n * 4)) & words[n].mask) == words[n].value)
+                {
+                    n++;
+                }
+                if (n != count)
+                    continue;
+
+                // Names are unique in the database, so the same length means another function
+                ambiguous = count == bestCount;
+                best = index;
+                bestCount = count;
+            }
+        }
+
+        if (bestCount != 0)
+        {
+            matches.push_back({ segment | pa, (uint32_t)(bestCount * 4), ambiguous ? AmbiguousMatch : best });
+            pa += (uint32_t)(bestCount - 1) * 4;
+        }
+    }
+}
+
+struct SignatureScanJob
+{
+    SignatureDB* db;
+    std::vector<SignatureRange> chunks;
+    std::atomic<size_t> next;
+    std::vector<SignatureMatch> matches;
+    SpinLock lock;
+};
+
+void SignatureDB::ScanThreadProc(void* param)
+{
+    SignatureScanJob* job = (SignatureScanJob*)param;
+    std::vector<SignatureMatch> matches;
+
+    size_t index;
+    while ((index = job->next++) < job->chunks.size())
+    {
+        job->db->ScanRange(job->chunks[index], matches);
+    }
+
+    job->lock.Lock();
+    job->matches.insert(job->matches.end(), matches.begin(), matches.end());
+    job->lock.Unlock();
+}
+
+void SignatureDB::Identify(std::vector<SignatureRange>& ranges, std::vector<SignatureMatch>& matches)
+{
+    matches.clear();
+    if (signatures.empty())
+        return;
+
+    if (!indexed)
+    {
+        BuildIndex();
+    }
+
+    SignatureScanJob job;
+    job.db = this;
+    job.next = 0;
+
+    for (auto& range : ranges)
+    {
+        for (uint32_t offset = 0; offset < range.size; offset += ScanChunkSize)
+        {
+            job.chunks.push_back({ range.address + offset, min(ScanChunkSize, range.size - offset) });
+        }
+    }
+
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    int threadCount = (int)min((size_t)max(info.dwNumberOfProcessors, (DWORD)1), job.chunks.size());
+
+    std::vector<Thread*> threads;
+    for (int i = 0; i < threadCount; i++)
+    {
+        threads.push_back(new Thread(ScanThreadProc, false, &job, "SignatureScan"));
+    }
+
+    // The workers free their memory on exit, so they are joined, not terminated in the middle of it
+    for (auto thread : threads)
+    {
+        thread->Join();
+        delete thread;
+    }
+
+    // A function that crosses the chunk boundary may also be matched by a shorter signature in the next chunk
+    std::sort(job.matches.begin(), job.matches.end(), [](const SignatureMatch& a, const SignatureMatch& b) { return a.address < b.address; });
+
+    std::vector<SignatureMatch> sorted;
+    uint32_t prevEnd = 0;
+    for (auto& match : job.matches)
+    {
+        if (!sorted.empty() && match.address < prevEnd)
+            continue;
+        sorted.push_back(match);
+        prevEnd = match.address + match.size;
+    }
+
+    std::vector<uint32_t> found(signatures.size(), 0);
+    for (auto& match : sorted)
+    {
+        if (match.signature != AmbiguousMatch)
+            found[match.signature]++;
+    }
+
+    size_t dropped = 0;
+    for (auto& match : sorted)
+    {
+        if (match.signature == AmbiguousMatch || found[match.signature] != 1)
+        {
+            dropped++;
+            continue;
+        }
+        matches.push_back(match);
+    }
+
+    DBReport2(DbgChannel::HLE, "Signatures: %zi functions identified, %zi ambiguous matches dropped\n", matches.size(), dropped);
+}
+
+void SignatureDB::ApplyMatches(std::vector<SignatureMatch>& matches)
+{
+    for (auto& match : matches)
+    {
+        SYMAddNew(match.address, signatures[match.signature].name.c_str());
+    }
+
+    SYMFinalize();
+}
+
+bool SignatureDB::SaveMatches(std::vector<SignatureMatch>& matches, const TCHAR* mapname)
+{
+    FILE* map = nullptr;
+    _tfopen_s(&map, mapname, _T("w"));
+    if (!map)
+        return false;
+
+    for (auto& match : matches)
+    {
+        fprintf(map, "%08X %s\n", match.address, signatures[match.signature].name.c_str());
+    }
+
+    fclose(map);
+    return true;
+}
@@ -0,0 +1,89 @@
+// Identification of the SDK functions by signatures (for the games without a map).
+// Description in HighLevel\Readme.md
+
+#pragma once
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// One instruction of the signature. The bits outside of the mask are relocations: branch targets,
+// offsets from the small data area registers and the lower halves of the lis/addi pairs.
+struct SignatureWord
+{
+    uint32_t value;
+    uint32_t mask;
+};
+
+struct Signature
+{
+    std::string name;
+    std::vector<SignatureWord> words;
+};
+
+struct SignatureMatch
+{
+    uint32_t address;
+    uint32_t size;              // bytes
+    uint32_t signature;         // index in the database
+};
+
+// A range of the emulated memory to scan (effective address, size in bytes)
+struct SignatureRange
+{
+    uint32_t address;
+    uint32_t size;
+};
+
+// The signatures are grouped by the masks of their first two instructions (there are only a few different ones),
+// each group is a hash table of the masked prefix. So the scanner does one lookup per group at each address
+// and compares the whole signature only for the candidates.
+
+class SignatureDB
+{
+    std::vector<Signature> signatures;
+    std::unordered_map<std::string, uint32_t> byName;
+
+    struct PrefixGroup
+    {
+        uint32_t mask[2];
+        std::unordered_map<uint64_t, std::vector<uint32_t>> table;
+    };
+    std::vector<PrefixGroup> groups;
+    bool indexed = false;
+
+    void BuildIndex();
+    void ScanRange(SignatureRange range, std::vector<SignatureMatch>& matches);
+
+    static void ScanThreadProc(void* param);
+
+public:
+    static const size_t MinWords = 4;       // Shorter functions (stubs) are not unique
+    static const size_t MaxWords = 64;
+
+    // Text file, one signature per line: name, then the instructions in hex, masked ones as value/mask. # starts a comment.
+    bool Load(const TCHAR* filename);
+    bool Save(const TCHAR* filename);
+
+    // A signature with the same name is replaced
+    void Add(const std::string& name, const std::vector<SignatureWord>& words);
+
+    // Make the signature of the code (instructions in host byte order). The relocations are masked.
+    static void MakeSignature(const uint32_t* code, size_t count, std::vector<SignatureWord>& words);
+
+    // Make signatures of the current symbols. The function ends at the next symbol. The functions patched by HLE are
+    // taken with their original instructions. Returns the number of signatures added.
+    size_t AddSymbols();
+
+    // Scan the ranges in parallel. The matches are sorted by address. A function matched by several signatures,
+    // or a signature matched at several addresses, is dropped: HLE should never patch a wrong function.
+    void Identify(std::vector<SignatureRange>& ranges, std::vector<SignatureMatch>& matches);
+
+    void ApplyMatches(std::vector<SignatureMatch>& matches);                            // Add to the symbols
+    bool SaveMatches(std::vector<SignatureMatch>& matches, const TCHAR* mapname);      // Write a map (RAW format)
+
+    size_t Count() { return signatures.size(); }
+    Signature& Get(uint32_t index) { return signatures[index]; }
+};
+
+#define SIGNATURES_FILE _T(".\\Data\\Signatures.txt")
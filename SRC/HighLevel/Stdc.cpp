@@ -4,7 +4,7 @@
 #define PARAM(n)    Gekko::Gekko->regs.gpr[3+n]
 #define RET_VAL     Gekko::Gekko->regs.gpr[3]
 #define SWAP        _byteswap_ulong
-#define FPRD(n)     Gekko::Gekko->regs.fpr[n].dbl
+#define FPRD(n)     Gekko::Gekko->regs.fpr[n].ps0.dbl
 
 // fast longlong swap, invented by org
 static void swap_double(void* srcPtr)
@@ -24,39 +24,64 @@ static void swap_double(void* srcPtr)
     Memory operations
 --------------------------------------------------------------------------- */
 
-// void *memcpy( void *dest, const void *src, size_t count);
+// void *memcpy( void *dest, const void *src, size_t count );
+// The runtime memcpy copies overlapping ranges correctly, so memmove is used.
 void HLE_memcpy()
 {
-    int WIMG;
     uint32_t eaDest = PARAM(0), eaSrc = PARAM(1), cnt = PARAM(2);
-    uint32_t paDest = Gekko::Gekko->EffectiveToPhysical(eaDest, Gekko::MmuAccess::Read, WIMG);
-    uint32_t paSrc = Gekko::Gekko->EffectiveToPhysical(eaSrc, Gekko::MmuAccess::Read, WIMG);
-
-    assert( paDest != Gekko::BadAddress);
-    assert( paSrc != Gekko::BadAddress);
-    assert( (paDest + cnt) < RAMSIZE);
-    assert( (paSrc + cnt) < RAMSIZE);
 
 //  DBReport( GREEN "memcpy(0x%08X, 0x%08X, %i(%s))\n", 
 //            eaDest, eaSrc, cnt, FileSmartSize(cnt) );
 
-    memcpy(&mi.ram[paDest], &mi.ram[paSrc], cnt);
+    uint8_t* dest = HLETranslate(eaDest, cnt, true);
+    uint8_t* src = HLETranslate(eaSrc, cnt, false);
+
+    if (dest && src)
+    {
+        memmove(dest, src, cnt);
+        return;
+    }
+
+    // Slow path: locked cache, data cache emulation, or the range is not contiguous in RAM
+    uint32_t value;
+    if (eaDest > eaSrc)
+    {
+        for (uint32_t i = cnt; i-- != 0; )
+        {
+            Gekko::Gekko->ReadByte(eaSrc + i, &value);
+            Gekko::Gekko->WriteByte(eaDest + i, value);
+        }
+    }
+    else
+    {
+        for (uint32_t i = 0; i < cnt; i++)
+        {
+            Gekko::Gekko->ReadByte(eaSrc + i, &value);
+            Gekko::Gekko->WriteByte(eaDest + i, value);
+        }
+    }
 }
 
-// void *memset( void *dest, int c, size_t count);
+// void *memset( void *dest, int c, size_t count );
 void HLE_memset()
 {
-    int WIMG;
     uint32_t eaDest = PARAM(0), c = PARAM(1), cnt = PARAM(2);
-    uint32_t paDest = Gekko::Gekko->EffectiveToPhysical(eaDest, Gekko::MmuAccess::Read, WIMG);
-
-    assert(paDest != Gekko::BadAddress);
-    assert( (paDest + cnt) < RAMSIZE);
 
-//  DBReport( GREEN "memcpy(0x%08X, %i(%c), %i(%s))\n", 
+//  DBReport( GREEN "memset(0x%08X, %i(%c), %i(%s))\n", 
 //            eaDest, c, cnt, FileSmartSize(cnt) );
 
-    memset(&mi.ram[paDest], c, cnt);
+    uint8_t* dest = HLETranslate(eaDest, cnt, true);
+
+    if (dest)
+    {
+        memset(dest, (uint8_t)c, cnt);
+        return;
+    }
+
+    for (uint32_t i = 0; i < cnt; i++)
+    {
+        Gekko::Gekko->WriteByte(eaDest + i, (uint8_t)c);
+    }
 }
 
 /* ---------------------------------------------------------------------------
@@ -84,20 +109,22 @@ void HLE_cos()
 void HLE_modf()
 {
     int WIMG;
-    double * intptr = (double *)(&mi.ram[Gekko::Gekko->EffectiveToPhysical(PARAM(0), Gekko::MmuAccess::Read, WIMG)]);
+    double * intptr = (double *)(&mi->ram[Gekko::Gekko->EffectiveToPhysical(PARAM(0), Gekko::MmuAccess::Read, WIMG)]);
     
     FPRD(1) = modf(FPRD(1), intptr);
     swap_double(intptr);
+    mi->dirty.Mark((uint8_t*)intptr - mi->ram, sizeof(double));
 }
 
 // double frexp(double x, int * expptr)
 void HLE_frexp()
 {
     int WIMG;
-    uint32_t * expptr = (uint32_t *)(&mi.ram[Gekko::Gekko->EffectiveToPhysical(PARAM(0), Gekko::MmuAccess::Read, WIMG)]);
+    uint32_t * expptr = (uint32_t *)(&mi->ram[Gekko::Gekko->EffectiveToPhysical(PARAM(0), Gekko::MmuAccess::Read, WIMG)]);
     
     FPRD(1) = frexp(FPRD(1), (int *)expptr);
     *expptr = SWAP(*expptr);
+    mi->dirty.Mark((uint8_t*)expptr - mi->ram, sizeof(uint32_t));
 }
 
 // double ldexp(double x, int exp)
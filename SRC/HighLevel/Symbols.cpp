@@ -11,17 +11,78 @@ static SYMControl *work = &sym; // current workspace (in use)
 
 // ---------------------------------------------------------------------------
 
-// find first occurency of symbol in list
-static SYM * symfind(const char *symName)
+static const size_t poolBlockSize = 0x10000;
+
+// save string in the pool of the workspace. Pool blocks are never moved, so the names can be referenced directly.
+static char * strsave(SYMControl *ctl, const char *str)
 {
-    for (auto it = work->symmap.begin(); it != work->symmap.end(); ++it)
+    size_t len = strlen(str) + 1;
+
+    if (ctl->pool.empty() || ctl->poolUsed + len > poolBlockSize)
     {
-        if (!strcmp(it->second->savedName, symName))
+        ctl->pool.push_back(std::make_unique<char[]>(len > poolBlockSize ? len : poolBlockSize));
+        ctl->poolUsed = 0;
+    }
+
+    char *saved = ctl->pool.back().get() + ctl->poolUsed;
+    memcpy(saved, str, len);
+    ctl->poolUsed += len;
+    return saved;
+}
+
+// merge newly added symbols into the sorted part.
+// if several symbols were added at the same address, the last one wins (its name is dropped from the name index).
+static void symmerge(SYMControl *ctl)
+{
+    auto& symbols = ctl->symbols;
+
+    if (ctl->sortedCount == symbols.size())
+        return;
+
+    auto byAddress = [](const SYM& a, const SYM& b) { return a.eaddr < b.eaddr; };
+
+    std::stable_sort(symbols.begin() + ctl->sortedCount, symbols.end(), byAddress);
+    std::inplace_merge(symbols.begin(), symbols.begin() + ctl->sortedCount, symbols.end(), byAddress);
+
+    size_t out = 0;
+    for (size_t i = 0; i < symbols.size(); i++)
+    {
+        if (i + 1 < symbols.size() && symbols[i + 1].eaddr == symbols[i].eaddr)
         {
-            return it->second;
+            ctl->byName.erase(symbols[i].savedName);
+            continue;
         }
+        symbols[out++] = symbols[i];
     }
-    return nullptr;
+
+    symbols.resize(out);
+    ctl->sortedCount = out;
+}
+
+// find symbol by exact address. lookups see only the merged symbols (see SYMFinalize).
+static const SYM * symbyaddr(const SYMControl *ctl, uint32_t addr)
+{
+    auto end = ctl->symbols.begin() + ctl->sortedCount;
+    auto it = std::lower_bound(ctl->symbols.begin(), end, addr,
+        [](const SYM& a, uint32_t ea) { return a.eaddr < ea; });
+
+    if (it == end || it->eaddr != addr)
+        return nullptr;
+    return &*it;
+}
+
+// find symbol by name
+static const SYM * symfind(const SYMControl *ctl, const char *symName)
+{
+    auto it = ctl->byName.find(symName);
+    if (it == ctl->byName.end())
+        return nullptr;
+
+    // the name could be of a symbol not merged yet
+    const SYM *symbol = symbyaddr(ctl, it->second);
+    if (symbol == nullptr || strcmp(symbol->savedName, symName) != 0)
+        return nullptr;
+    return symbol;
 }
 
 void SYMSetWorkspace(SYMControl *useIt)
@@ -35,22 +96,13 @@ void SYMCompareWorkspaces (
     void (*DiffCallback)(uint32_t ea, char * name)
 )
 {
-    for (auto sourceId = source->symmap.begin(); sourceId != source->symmap.end(); ++sourceId)
+    for (size_t i = 0; i < source->sortedCount; i++)
     {
-        bool found = false;
-
-        for (auto destIt = dest->symmap.begin(); destIt != dest->symmap.end(); ++destIt)
-        {
-            if (!strcmp(sourceId->second->savedName, destIt->second->savedName))
-            {
-                found = true;
-                break;
-            }
-        }
+        const SYM& symbol = source->symbols[i];
 
-        if (!found)
+        if (symfind(dest, symbol.savedName) == nullptr)
         {
-            DiffCallback(sourceId->second->eaddr, sourceId->second->savedName);
+            DiffCallback(symbol.eaddr, symbol.savedName);
         }
     }
 }
@@ -60,7 +112,7 @@ void SYMCompareWorkspaces (
 uint32_t SYMAddress(const char *symName)
 {
     // try to find specified symbol
-    SYM *symbol = symfind(symName);
+    const SYM *symbol = symfind(work, symName);
 
     if(symbol) return symbol->eaddr;
     else return 0;
@@ -70,42 +122,31 @@ uint32_t SYMAddress(const char *symName)
 // if label is not specified, return NULL
 char * SYMName(uint32_t symAddr)
 {
-    auto it = work->symmap.find(symAddr);
+    const SYM *symbol = symbyaddr(work, symAddr);
 
-    if (it == work->symmap.end())
+    if (symbol == nullptr)
     {
         return nullptr;
     }
 
-    return it->second->savedName;
+    return symbol->savedName;
 }
 
 // Get the symbol closest to the specified address and offset relative to the start of the symbol.
 char* SYMGetNearestName(uint32_t address, size_t& offset)
 {
-    int minDelta = INT_MAX;
-    SYM* nearestSymbol = nullptr;
-
     offset = 0;
 
-    for (auto it = work->symmap.begin(); it != work->symmap.end(); ++it)
-    {
-        if (address >= it->first)
-        {
-            int delta = address - it->first;
-            if (delta < minDelta)
-            {
-                minDelta = delta;
-                nearestSymbol = it->second;
-            }
-        }
-    }
+    // first symbol above the address, the nearest one is just before it
+    auto it = std::upper_bound(work->symbols.begin(), work->symbols.begin() + work->sortedCount, address,
+        [](uint32_t ea, const SYM& a) { return ea < a.eaddr; });
 
-    if (nearestSymbol == nullptr)
+    if (it == work->symbols.begin())
         return nullptr;
 
-    offset = address - nearestSymbol->eaddr;
-    return nearestSymbol->savedName;
+    --it;
+    offset = address - it->eaddr;
+    return it->savedName;
 }
 
 // associate high-level call with symbol
@@ -113,96 +154,54 @@ char* SYMGetNearestName(uint32_t address, size_t& offset)
 void SYMSetHighlevel(const char *symName, void (*routine)())
 {
     // try to find specified symbol
-    SYM *symbol = symfind(symName);
-
-    // check address
-    // High-level call is too high in memory.
-    assert(((uint64_t)routine & ~0x03ffffff) == 0);
+    SYM *symbol = (SYM *)symfind(work, symName);
 
-    // leave, if symbol is not found. add otherwise.
+    // leave, if symbol is not found. the entry point is patched by HLE (see HLEApply).
     if(symbol)
     {
         symbol->routine = routine;      // overwrite
-
-        // if first opcode is 'BLR', then just leave it
-        uint32_t op;
-        Gekko::Gekko->ReadWord(symbol->eaddr, &op);
-        if(op != 0x4e800020)
-        {
-            Gekko::Gekko->WriteWord(
-                symbol->eaddr,          // add patch
-                (uint32_t)((uint64_t)routine & 0x03ffffff)  // 000: high-level opcode
-            );
-            if(!_stricmp(symName, "OSLoadContext"))
-            {
-                Gekko::Gekko->WriteWord(
-                    symbol->eaddr + 4,  // return to caller
-                    0x4c000064          // rfi
-                );
-            }
-            else
-            {
-                Gekko::Gekko->WriteWord(
-                    symbol->eaddr + 4,  // return to caller
-                    0x4e800020          // blr
-                );
-            }
-        }
-        DBReport2(DbgChannel::HLE, "patched API call: %08X %s\n", symbol->eaddr, symName);
     }
 }
 
-// save string in memory
-static char * strsave(const char *str)
-{
-    size_t len = strlen(str) + 1;
-    char *saved = new char[len];
-    assert(saved);
-    strcpy(saved, str);
-    return saved;
-}
-
-// add new symbol
+// add new symbol. it is visible to the lookups after SYMFinalize.
+// the name stays with the address where it was added first. a new name at the same address replaces the old one.
 void SYMAddNew(uint32_t addr, const char *name)
 {
-    SYM* symbol = symfind(name);
+    auto it = work->byName.find(name);
 
-    if (symbol != nullptr)
+    if (it != work->byName.end())
     {
-        // Replace name
-        if (symbol->savedName)
-        {
-            delete[] symbol->savedName;
-            symbol->savedName = nullptr;
-        }
-        symbol->savedName = strsave(name);
+        // The name could have been replaced at its address by a symbol added after it
+        symmerge(work);
+        if (work->byName.find(name) != work->byName.end())
+            return;
     }
-    else
-    {
-        // Add new
-        SYM* sym = new SYM;
 
-        sym->eaddr = addr;
-        sym->savedName = strsave(name);
-        sym->routine = nullptr;
+    SYM symbol;
 
-        work->symmap[addr] = sym;
-    }
+    symbol.eaddr = addr;
+    symbol.savedName = strsave(work, name);
+    symbol.routine = nullptr;
+
+    work->symbols.push_back(symbol);
+    work->byName[symbol.savedName] = addr;
+}
+
+// Merge the symbols added since the last call into the lookup table.
+// Called once after a batch of SYMAddNew (map loading, signature matches), so the lookups never modify the table.
+void SYMFinalize()
+{
+    symmerge(work);
 }
 
 // Remove all symbols
 void SYMKill()
 {
-    for (auto it = work->symmap.begin(); it != work->symmap.end(); ++it)
-    {
-        if (it->second->savedName)
-        {
-            delete[] it->second->savedName;
-        }
-        delete it->second;
-    }
-
-    work->symmap.clear();
+    work->symbols.clear();
+    work->sortedCount = 0;
+    work->byName.clear();
+    work->pool.clear();
+    work->poolUsed = 0;
 }
 
 // list symbols, matching first occurence of "str".
@@ -212,12 +211,13 @@ void SYMList(const char *str)
     size_t len = strlen(str), cnt = 0;
     DBReport("<address> symbol\n\n");
 
-    for (auto it = work->symmap.begin(); it != work->symmap.end(); ++it)
+    for (size_t i = 0; i < work->sortedCount; i++)
     {
-        SYM* symbol = it->second;
-        if (((*str == '*') || !_strnicmp(str, symbol->savedName, len)))
+        const SYM& symbol = work->symbols[i];
+
+        if (((*str == '*') || !_strnicmp(str, symbol.savedName, len)))
         {
-            DBReport("<%08X> %s\n", symbol->eaddr, symbol->savedName);
+            DBReport("<%08X> %s\n", symbol.eaddr, symbol.savedName);
             cnt++;
         }
     }
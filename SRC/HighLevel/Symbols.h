@@ -1,25 +1,36 @@
 #pragma once
 
-#include <map>
+#include <algorithm>
+#include <memory>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
 
 // symbolic entry
 struct SYM
 {
     uint32_t eaddr;             // effective address
-    char*   savedName;          // symbolic description
+    char*   savedName;          // symbolic description (in the string pool)
     void    (*routine)();       // associated high-level call
 };
 
 // all important variables are here
+// Symbols are kept in a flat array sorted by address. New symbols are appended and merged in by SYMFinalize,
+// so loading a map does not pay for sorting on every insert and the lookups do not modify the table. Names live in a string pool and are indexed by a hash table.
 struct SYMControl
 {
-    std::map<uint32_t, SYM*> symmap;
+    std::vector<SYM> symbols;
+    size_t  sortedCount = 0;                                // symbols before this index are sorted and unique by address
+    std::unordered_map<std::string_view, uint32_t> byName;  // name -> address
+    std::vector<std::unique_ptr<char[]>> pool;              // string pool blocks
+    size_t  poolUsed = 0;                                   // bytes used in the last block
 };
 
 extern  SYMControl sym;
 
 // API for emulator
 void    SYMAddNew(uint32_t addr, const char *name);
+void    SYMFinalize();
 void    SYMSetHighlevel(const char *symName, void (*routine)());
 uint32_t SYMAddress(const char *symName);
 char*   SYMName(uint32_t symAddr);
@@ -69,31 +69,17 @@ static void LoadSettings()
 
 static void SaveSettings()
 {
-	uint8_t bogus[0x100] = { 0, };
-	size_t textSize = 0;
-
-	// Calculate Json size
 	if (!SettingsLoaded)
 	{
 		UI::DolwinError(L"Critical Error", L"Settings must be loaded first!");
 		return;
 	}
 
-	try
-	{
-		settings.GetSerializedTextSize(bogus, -1, textSize);
-	}
-	catch (...)
-	{
-		UI::DolwinError(L"Critical Error", L"Settings cannot be saved!");
-		return;
-	}
-
 	/* Serialize and save current settings. */
-	std::vector<uint8_t> text(2 * textSize, 0);
+	std::vector<uint8_t> text;
 	try
 	{
-		settings.Serialize(text.data(), 2 * textSize, textSize);
+		settings.Serialize(text);
 	}
 	catch (...)
 	{
@@ -46,6 +46,9 @@ constexpr auto USER_BINORG	= "BINORG";				// binary file loading offset (physica
 constexpr auto USER_MAKEMAP = "MAKEMAP";			// 1: make map file, if missing (find symbols)
 constexpr auto USER_PATCH	= "PATCH";				// patches allowed, if 1
 
+// Core section variables
+constexpr auto USER_CACHED_INTERPRETER = "CACHED_INTERPRETER";	// 1: interpreter executes basic blocks decoded in advance
+
 // Hardware section variables
 constexpr auto USER_ANSI		= "ANSI";			// bootrom ANSI font
 constexpr auto USER_SJIS		= "SJIS";           // bootrom SJIS font
@@ -53,6 +56,10 @@ constexpr auto USER_CONSOLE		= "CONSOLE";        // console version (see YAGCD)
 constexpr auto USER_EXI_LOG		= "EXI_LOG";        // 1: log EXI activities
 constexpr auto USER_OS_REPORT	= "OS_REPORT";      // 1: allow debugger output (by EXI)
 constexpr auto USER_PI_RSWHACK	= "RSWHACK";		// reset button hack
+constexpr auto USER_ARAM_CHUNKED = "ARAM_CHUNKED";	// 1: ARAM DMA data is transferred progressively (for titles polling DMA progress)
+constexpr auto USER_AUDIO_SINK	= "AUDIO_SINK";		// 0: default (DirectSound), 1: null, 2: WAV file
+constexpr auto USER_AUDIO_RATE	= "AUDIO_RATE";		// audio output sample rate
+constexpr auto USER_AUDIO_WAV	= "AUDIO_WAV";		// WAV file for the audio sink 2
 constexpr auto USER_VI_COUNT	= "VI_COUNT";       // lines count per single frame (0:auto)
 constexpr auto USER_VI_LOG		= "VI_LOG";         // do debugger log output
 constexpr auto USER_VI_XFB		= "VI_XFB";         // enable video frame buffer (GDI)
@@ -15,7 +15,7 @@ namespace UI
         _vstprintf_s(buf, _countof(buf) - 1, fmt.data(), arg);
         va_end(arg);
 
-        if (emu.doldebug)
+        if (emu->doldebug)
         {
             char ansiText[0x1000] = { 0, }, * ansiPtr = ansiText;
 
@@ -102,7 +102,7 @@ static void InitFileSystem()
 {
     /* Set current working directory relative to Dolwin executable */
     auto cwd = std::filesystem::current_path();
-    ldat.cwd = cwd;
+    ldat->cwd = cwd;
     
     /* Make sure, that Dolwin has data directory. */
     _chdir(cwd.string().c_str());
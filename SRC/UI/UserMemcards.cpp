@@ -171,22 +171,22 @@ static INT_PTR CALLBACK MemcardSettingsProc(HWND hwndDlg, UINT uMsg, WPARAM wPar
             else if (um_num == 1)
                 SendMessage(hwndDlg, WM_SETTEXT, (WPARAM)0, lParam = (LPARAM)_T("Memcard B Settings"));
 
-            if (SyncSave)
+            if (mc->SyncSave)
                 CheckRadioButton(hwndDlg, IDC_MEMCARD_SYNCSAVE_FALSE,
                                 IDC_MEMCARD_SYNCSAVE_TRUE, IDC_MEMCARD_SYNCSAVE_TRUE );
             else 
                 CheckRadioButton(hwndDlg, IDC_MEMCARD_SYNCSAVE_FALSE,
                                 IDC_MEMCARD_SYNCSAVE_TRUE, IDC_MEMCARD_SYNCSAVE_FALSE );
 
-            if (emu.loaded) {
+            if (emu->loaded) {
                 EnableWindow(GetDlgItem(hwndDlg, IDC_MEMCARD_SYNCSAVE_FALSE), FALSE);
                 EnableWindow(GetDlgItem(hwndDlg, IDC_MEMCARD_SYNCSAVE_TRUE), FALSE);
             }
 
-            if (Memcard_Connected[um_num])
+            if (mc->Memcard_Connected[um_num])
                 CheckDlgButton(hwndDlg, IDC_MEMCARD_CONNECTED, BST_CHECKED);
 
-            _tcscpy(buf, memcard[um_num].filename);
+            _tcscpy(buf, mc->memcard[um_num].filename);
             filename = _tcsrchr(buf, _T('\\'));
             if (filename == NULL) {
                 SendDlgItemMessage(hwndDlg, IDC_MEMCARD_FILE, WM_SETTEXT,  (WPARAM)0, (LPARAM)(LPCTSTR)buf);
@@ -198,9 +198,9 @@ static INT_PTR CALLBACK MemcardSettingsProc(HWND hwndDlg, UINT uMsg, WPARAM wPar
                 SendDlgItemMessage(hwndDlg, IDC_MEMCARD_PATH, WM_SETTEXT,  (WPARAM)0, (LPARAM)(LPCTSTR)buf);
             }
 
-            if (memcard[um_num].connected) {
+            if (mc->memcard[um_num].connected) {
                 _stprintf_s (buf, _countof(buf) - 1, _T("Size: %d usable blocks (%d Kb)"),
-                    (int)(memcard[um_num].size / Memcard_BlockSize - 5), (int)(memcard[um_num].size / 1024));
+                    (int)(mc->memcard[um_num].size / Memcard_BlockSize - 5), (int)(mc->memcard[um_num].size / 1024));
                 SendDlgItemMessage(hwndDlg, IDC_MEMCARD_SIZEDESC, WM_SETTEXT,  (WPARAM)0, (LPARAM)(LPCTSTR)buf);
             }
             else {
@@ -276,8 +276,8 @@ static INT_PTR CALLBACK MemcardSettingsProc(HWND hwndDlg, UINT uMsg, WPARAM wPar
                     Fnsize = SendDlgItemMessage(hwndDlg, IDC_MEMCARD_FILE, WM_GETTEXTLENGTH,  (WPARAM)0, (LPARAM)0);
                     Pathsize = SendDlgItemMessage(hwndDlg, IDC_MEMCARD_PATH, WM_GETTEXTLENGTH,  (WPARAM)0, (LPARAM)0);
 
-                    if (Fnsize+1 + Pathsize+1 >= sizeof (memcard[um_num].filename)) {
-                        _stprintf_s (buf, _countof(buf) - 1, _T("File full path must be less than %zi characters."), sizeof (memcard[um_num].filename) );
+                    if (Fnsize+1 + Pathsize+1 >= sizeof (mc->memcard[um_num].filename)) {
+                        _stprintf_s (buf, _countof(buf) - 1, _T("File full path must be less than %zi characters."), sizeof (mc->memcard[um_num].filename) );
                         MessageBox(hwndDlg, buf, _T("Invalid filename"), 0);
                         return TRUE;
                     }
@@ -289,47 +289,47 @@ static INT_PTR CALLBACK MemcardSettingsProc(HWND hwndDlg, UINT uMsg, WPARAM wPar
                     _tcscat_s(buf, _countof(buf) - 1, buf2);
                 }
 
-                if (!emu.loaded) {
+                if (!emu->loaded) {
                     if (IsDlgButtonChecked(hwndDlg, IDC_MEMCARD_SYNCSAVE_FALSE) == BST_CHECKED  )
-                        SyncSave = false;
+                        mc->SyncSave = false;
                     else
-                        SyncSave = true;
+                        mc->SyncSave = true;
                 }
                 if (IsDlgButtonChecked(hwndDlg, IDC_MEMCARD_CONNECTED) == BST_CHECKED ) {
                     /* memcard is supposed to be connected */
 
                     if (um_filechanged == TRUE) /* file was changed */
                         MCUseFile(um_num, buf, true);
-                    else if (Memcard_Connected[um_num] == FALSE || memcard[um_num].connected == FALSE )
+                    else if (mc->Memcard_Connected[um_num] == FALSE || mc->memcard[um_num].connected == FALSE )
                             if (MCConnect (um_num) == FALSE)
                                 MessageBox(wnd.hMainWindow, _T("Error while trying to connect the memcards."), _T("Memcard Error"), 0) ;
 
-                    Memcard_Connected[um_num] = true;
+                    mc->Memcard_Connected[um_num] = true;
                 }
                 else {
                     /* memcard is supposed to be disconnected */
 
                     if (um_filechanged == TRUE) /* file was changed */
                         MCUseFile(um_num, buf, false);
-                    else if (Memcard_Connected[um_num] || memcard[um_num].connected )
+                    else if (mc->Memcard_Connected[um_num] || mc->memcard[um_num].connected )
                                 MCDisconnect(um_num);
 
-                    Memcard_Connected[um_num] = false;
+                    mc->Memcard_Connected[um_num] = false;
                 }
 
                 // Writeback settings
 
                 if (um_num == 0)
                 {
-                    SetConfigBool(MemcardA_Connected_Key, Memcard_Connected[0], USER_MEMCARDS);
-                    SetConfigString(MemcardA_Filename_Key, memcard[0].filename, USER_MEMCARDS);
+                    SetConfigBool(MemcardA_Connected_Key, mc->Memcard_Connected[0], USER_MEMCARDS);
+                    SetConfigString(MemcardA_Filename_Key, mc->memcard[0].filename, USER_MEMCARDS);
                 }
                 else
                 {
-                    SetConfigBool(MemcardB_Connected_Key, Memcard_Connected[1], USER_MEMCARDS);
-                    SetConfigString(MemcardB_Filename_Key, memcard[1].filename, USER_MEMCARDS);
+                    SetConfigBool(MemcardB_Connected_Key, mc->Memcard_Connected[1], USER_MEMCARDS);
+                    SetConfigString(MemcardB_Filename_Key, mc->memcard[1].filename, USER_MEMCARDS);
                 }
-                SetConfigBool(Memcard_SyncSave_Key, SyncSave, USER_MEMCARDS);
+                SetConfigBool(Memcard_SyncSave_Key, mc->SyncSave, USER_MEMCARDS);
 
                 EndDialog(hwndDlg, 0);
                 return TRUE;
@@ -349,7 +349,7 @@ void MemcardConfigure(int num, HWND hParent) {
     if ((num != 0) && (num != 1)) return ;
     um_num = num;
 
-    openedBefore = MCOpened;
+    openedBefore = mc->MCOpened;
     if (!openedBefore)
     {
         HWConfig confg = { 0 };
@@ -117,8 +117,8 @@ void UpdateProfiler()
         int64_t diff = cur - startTime;
 
         // frames per second
-        _stprintf_s(buf, _countof(buf) - 1, _T("FPS:%zi"), vi.frames);
-        vi.frames = 0;
+        _stprintf_s(buf, _countof(buf) - 1, _T("FPS:%zi"), vi->frames);
+        vi->frames = 0;
         SetStatusText(STATUS_ENUM::Fps, buf);
 
         // MIPS
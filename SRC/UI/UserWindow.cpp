@@ -355,9 +355,9 @@ static void OnMainWindowCreate(HWND hwnd)
         CheckMenuItem(wnd.hMainMenu, ID_ALLOW_PATCHES, MF_BYCOMMAND | MF_UNCHECKED);
 
     // debugger enabled ?
-    emu.doldebug = GetConfigBool(USER_DOLDEBUG, USER_UI);
+    emu->doldebug = GetConfigBool(USER_DOLDEBUG, USER_UI);
     CheckMenuItem(wnd.hMainMenu, ID_DEBUG_CONSOLE, MF_BYCOMMAND | MF_UNCHECKED);
-    if(emu.doldebug)
+    if(emu->doldebug)
     {
         DBOpen();            
         CheckMenuItem(wnd.hMainMenu, ID_DEBUG_CONSOLE, MF_BYCOMMAND | MF_CHECKED);
@@ -435,20 +435,20 @@ void OnMainWindowOpened()
 
     // set new title for main window
     std::wstring newTitle, gameTitle;
-    if (ldat.dvd)
+    if (ldat->dvd)
     {
-        gameTitle = ldat.currentFileName;
+        gameTitle = ldat->currentFileName;
         newTitle = fmt::format(L"{:s} Running {:s}", APPNAME, gameTitle);
     }
     else
     {
-        if (ldat.currentFileName == L"Bootrom")
+        if (ldat->currentFileName == L"Bootrom")
         {
-            gameTitle = ldat.currentFileName;
+            gameTitle = ldat->currentFileName;
         }
         else
         {
-            gameTitle = fmt::format(L"{:s} demo", ldat.currentFileName);
+            gameTitle = fmt::format(L"{:s} demo", ldat->currentFileName);
         }
         
         newTitle = fmt::format(L"{:s} Running {:s}", APPNAME, gameTitle);
@@ -464,7 +464,7 @@ void OnMainWindowOpened()
 void OnMainWindowClosed()
 {
     // restore current working directory
-    SetCurrentDirectory(ldat.cwd.c_str());
+    SetCurrentDirectory(ldat->cwd.c_str());
 
     // enable selector
     CreateSelector();
@@ -623,7 +623,7 @@ static LRESULT CALLBACK WindowProc(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lP
                 if (name = UI::FileOpenDialog(UI::FileType::Dvd); !name.empty() && DVD::DDU->GetCoverStatus() == DVD::CoverStatus::Open)
                 {
                     /* Same */
-                    if (name == ldat.currentFile)
+                    if (name == ldat->currentFile)
                     {
                         return 0;
                     }
@@ -790,14 +790,14 @@ static LRESULT CALLBACK WindowProc(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lP
                 if (GetConfigBool(USER_PATCH, USER_LOADER))
                 {   /* Off */
                     CheckMenuItem(wnd.hMainMenu, ID_ALLOW_PATCHES, MF_BYCOMMAND | MF_UNCHECKED);
-                    ldat.enablePatch = false;
+                    ldat->enablePatch = false;
                 }
                 else
                 {   /* On */
                     CheckMenuItem(wnd.hMainMenu, ID_ALLOW_PATCHES, MF_BYCOMMAND | MF_CHECKED);
-                    ldat.enablePatch = true;
+                    ldat->enablePatch = true;
                 }
-                SetConfigBool(USER_PATCH, ldat.enablePatch, USER_LOADER);
+                SetConfigBool(USER_PATCH, ldat->enablePatch, USER_LOADER);
                 return 0;
             }
             /* Load patch data */
@@ -833,31 +833,31 @@ static LRESULT CALLBACK WindowProc(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lP
 
                 Sleep(100);
 
-                if (!emu.doldebug)
+                if (!emu->doldebug)
                 {   // open
                     CheckMenuItem(wnd.hMainMenu, ID_DEBUG_CONSOLE, MF_BYCOMMAND | MF_CHECKED);
                     DBOpen();
-                    emu.doldebug = true;
+                    emu->doldebug = true;
                     SetStatusText(STATUS_ENUM::Progress, _T("Debugger opened"));
                 }
                 else
                 {   // close
                     CheckMenuItem(wnd.hMainMenu, ID_DEBUG_CONSOLE, MF_BYCOMMAND | MF_UNCHECKED);
                     DBClose();
-                    emu.doldebug = false;
+                    emu->doldebug = false;
                     SetStatusText(STATUS_ENUM::Progress, _T("Debugger closed"));
                 }
-                SetConfigBool(USER_DOLDEBUG, emu.doldebug, USER_UI);
+                SetConfigBool(USER_DOLDEBUG, emu->doldebug, USER_UI);
                 return 0;
             }
                 // Open/close DSP Debug
             case ID_DSP_DEBUG:
             {
-                if (emu.doldebug)
+                if (emu->doldebug)
                 {
                     CheckMenuItem(wnd.hMainMenu, ID_DEBUG_CONSOLE, MF_BYCOMMAND | MF_UNCHECKED);
                     DBClose();
-                    emu.doldebug = false;
+                    emu->doldebug = false;
                 }
 
                 Sleep(100);